@@ -454,6 +454,7 @@ typedef int pid_t;
 #include "Common/AsyncOperationWorkJobItem.h"
 #include "Common/AsyncWorkJobQueue.h"
 #include "Common/JobQueue.h"
+#include "Common/LockFreeJobQueue.h"
 #include "Common/BatchJobQueue.h"
 
 // FabricConstants
@@ -522,6 +523,7 @@ typedef int pid_t;
 #include "Common/JsonReaderWriter.h"
 #include "Common/JsonReaderHelper.h"
 #include "Common/JsonWriter.h"
+#include "Common/JsonChunkedWriter.h"
 #include "Common/JsonReader.h"
 
 // Cab FDI operations
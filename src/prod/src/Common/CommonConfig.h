@@ -47,6 +47,10 @@ namespace Common
 
         INTERNAL_CONFIG_ENTRY(uint, L"Common", ProcessExitCacheSizeLimit, 1024*1024, Common::ConfigEntryUpgradePolicy::Static, Common::UIntGreaterThan(0));
 
+        // Watch each waited process with a pidfd on the event loops, so that an exit only reaps that process
+        // instead of scanning all waiters. Falls back to scanning on kernels without pidfd_open.
+        INTERNAL_CONFIG_ENTRY(bool, L"Common", ProcessWaitUsePidFd, true, Common::ConfigEntryUpgradePolicy::Static);
+
         // Where to store mutex, lock and other objects, default to "", meaning $HOME/.service.fabric
         INTERNAL_CONFIG_ENTRY(std::wstring, L"Common", ObjectFolder, L"", ConfigEntryUpgradePolicy::Static);
 
@@ -0,0 +1,176 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+using namespace std;
+
+namespace Common
+{
+    class EventLoopTest
+    {
+    protected:
+        struct Pipe
+        {
+            Pipe()
+            {
+                Invariant(pipe2(fds, O_CLOEXEC | O_NONBLOCK) == 0);
+            }
+
+            ~Pipe()
+            {
+                close(fds[0]);
+                close(fds[1]);
+            }
+
+            void Write()
+            {
+                char c = 0;
+                VERIFY_ARE_EQUAL(1, write(fds[1], &c, 1));
+            }
+
+            int fds[2];
+        };
+
+        struct CallbackRecord
+        {
+            CallbackRecord() : onLoopThread(false), calls(0), called(false) {}
+
+            atomic_bool onLoopThread;
+            atomic_int calls;
+            AutoResetEvent called;
+        };
+
+        static EventLoop::FdContext* Register(
+            EventLoop & loop,
+            Pipe & p,
+            bool dispatchEventAsync,
+            bool inlineOnRunToCompletion,
+            CallbackRecord & record)
+        {
+            return loop.RegisterFd(
+                p.fds[0],
+                EPOLLIN,
+                dispatchEventAsync,
+                [&loop, &record] (int fd, uint)
+                {
+                    char c;
+                    while (read(fd, &c, 1) == 1);
+
+                    record.onLoopThread.store(loop.Test_IsLoopThread());
+                    ++record.calls;
+                    record.called.Set();
+                },
+                inlineOnRunToCompletion);
+        }
+
+        static void FireAndWait(EventLoop & loop, EventLoop::FdContext* fdc, Pipe & p, CallbackRecord & record)
+        {
+            VERIFY_IS_TRUE(loop.Activate(fdc).IsSuccess());
+            p.Write();
+            VERIFY_IS_TRUE(record.called.WaitOne(TimeSpan::FromSeconds(30)));
+        }
+
+        static bool WaitForBusyPolling(EventLoop & loop, bool expected, TimeSpan timeout)
+        {
+            auto deadline = Stopwatch::Now() + timeout;
+            while (loop.Test_IsBusyPolling() != expected)
+            {
+                if (Stopwatch::Now() >= deadline)
+                {
+                    return false;
+                }
+
+                Sleep(1);
+            }
+
+            return true;
+        }
+
+        // The loop thread is detached and keeps running after the loop is destroyed, so test loops are leaked
+        static EventLoop & CreateLoop()
+        {
+            return *(new EventLoop());
+        }
+    };
+
+    BOOST_FIXTURE_TEST_SUITE(EventLoopTestSuite, EventLoopTest)
+
+    BOOST_AUTO_TEST_CASE(InlineOnRunToCompletion)
+    {
+        auto & loop = CreateLoop();
+        loop.SetRunToCompletion(TimeSpan::Zero);
+
+        Pipe inlinePipe;
+        CallbackRecord inlineRecord;
+        auto inlineFdc = Register(loop, inlinePipe, true, true, inlineRecord);
+
+        Pipe asyncPipe;
+        CallbackRecord asyncRecord;
+        auto asyncFdc = Register(loop, asyncPipe, true, false, asyncRecord);
+
+        Pipe syncPipe;
+        CallbackRecord syncRecord;
+        auto syncFdc = Register(loop, syncPipe, false, false, syncRecord);
+
+        // Only the registration that asked for it is forced inline, the others keep dispatchEventAsync
+        FireAndWait(loop, inlineFdc, inlinePipe, inlineRecord);
+        VERIFY_IS_TRUE(inlineRecord.onLoopThread.load());
+
+        FireAndWait(loop, asyncFdc, asyncPipe, asyncRecord);
+        VERIFY_IS_FALSE(asyncRecord.onLoopThread.load());
+
+        FireAndWait(loop, syncFdc, syncPipe, syncRecord);
+        VERIFY_IS_TRUE(syncRecord.onLoopThread.load());
+
+        loop.UnregisterFd(inlineFdc, true);
+        loop.UnregisterFd(asyncFdc, true);
+        loop.UnregisterFd(syncFdc, true);
+    }
+
+    BOOST_AUTO_TEST_CASE(DispatchAsyncWithoutRunToCompletion)
+    {
+        auto & loop = CreateLoop();
+
+        Pipe p;
+        CallbackRecord record;
+        auto fdc = Register(loop, p, true, true, record);
+
+        FireAndWait(loop, fdc, p, record);
+        VERIFY_IS_FALSE(record.onLoopThread.load());
+        VERIFY_IS_FALSE(loop.Test_IsBusyPolling());
+
+        loop.UnregisterFd(fdc, true);
+    }
+
+    BOOST_AUTO_TEST_CASE(BusyPollExit)
+    {
+        auto & loop = CreateLoop();
+        loop.SetRunToCompletion(TimeSpan::FromSeconds(1));
+        VERIFY_IS_FALSE(loop.Test_IsBusyPolling());
+
+        Pipe p;
+        CallbackRecord record;
+        auto fdc = Register(loop, p, true, true, record);
+
+        FireAndWait(loop, fdc, p, record);
+        VERIFY_IS_TRUE(WaitForBusyPolling(loop, true, TimeSpan::FromSeconds(1)));
+
+        // The loop goes back to blocking in epoll_wait once the busy poll duration is over
+        VERIFY_IS_TRUE(WaitForBusyPolling(loop, false, TimeSpan::FromSeconds(30)));
+
+        // and still reports events afterwards
+        FireAndWait(loop, fdc, p, record);
+        VERIFY_IS_TRUE(record.onLoopThread.load());
+        VERIFY_ARE_EQUAL(2, record.calls.load());
+
+        loop.UnregisterFd(fdc, true);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+}
@@ -74,6 +74,45 @@ void EventLoopPool::SetSchedParam(int policy, int priority)
     }
 }
 
+void EventLoopPool::SetRunToCompletion(TimeSpan busyPollDuration)
+{
+    vector<int> cpus;
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0)
+    {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &cpuSet))
+            {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+    else
+    {
+        WriteWarning(TracePool, id_, "sched_getaffinity failed: {0}, loop threads are not pinned", errno);
+    }
+
+    WriteInfo(
+        TracePool,
+        id_,
+        "switching to run-to-completion: loops = {0}, cpus = {1}, busyPollDuration = {2}",
+        pool_.size(),
+        cpus.size(),
+        busyPollDuration);
+
+    for (size_t i = 0; i < pool_.size(); ++i)
+    {
+        if (!cpus.empty())
+        {
+            pool_[i]->PinToCpu(cpus[i % cpus.size()]);
+        }
+
+        pool_[i]->SetRunToCompletion(busyPollDuration);
+    }
+}
+
 EventLoop* EventLoopPool::Assign_CallerHoldingLock()
 {
     auto* result = &(*(pool_[assignmentIndex_]));
@@ -113,11 +152,11 @@ class EventLoop::FdContext
 public:
     typedef std::shared_ptr<FdContext> SPtr;
 
-    FdContext(int fd, uint events, Callback const & cb, bool dispatchEventAsync);
+    FdContext(int fd, uint events, Callback const & cb, bool dispatchEventAsync, bool inlineOnRunToCompletion);
 
     int Fd() const;
     uint Events() const;
-    void FireEvent(uint event);
+    void FireEvent(uint event, bool runToCompletion);
     void Close(bool waitForCallback);
 
     void WriteTo(Common::TextWriter & w, Common::FormatOptions const &) const;
@@ -130,11 +169,17 @@ private:
     const uint events_;
     const Callback cb_;
     const bool dispatchEventAsync_;
+    const bool inlineOnRunToCompletion_;
     std::atomic_int cbRunning_ {1};
     ManualResetEvent closedEvent_;
 };
 
-EventLoop::EventLoop() : id_(wformatString("{0}", TextTraceThis)), fdMapSize_(0)
+EventLoop::EventLoop()
+    : id_(wformatString("{0}", TextTraceThis))
+    , fdMapSize_(0)
+    , runToCompletion_(false)
+    , busyPollTicks_(0)
+    , busyPolling_(false)
 {
     Setup();
 }
@@ -175,6 +220,39 @@ void EventLoop::SetSchedParam(int policy, int priority)
     }
 }
 
+void EventLoop::PinToCpu(int cpu)
+{
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+
+    auto retval = pthread_setaffinity_np(tid_, sizeof(cpuSet), &cpuSet);
+    if (retval)
+    {
+        WriteWarning(
+            TraceLoop,
+            id_,
+            "failed to pin loop thread: pthread_t={0:x}, cpu = {1}, error = {2}",
+            tid_,
+            cpu,
+            retval);
+        return;
+    }
+
+    WriteInfo(TraceLoop, id_, "loop thread pinned to cpu {0}", cpu);
+}
+
+void EventLoop::SetRunToCompletion(TimeSpan busyPollDuration)
+{
+    busyPollTicks_.store(busyPollDuration.Ticks);
+    runToCompletion_.store(true);
+}
+
+bool EventLoop::Test_IsLoopThread() const
+{
+    return pthread_equal(pthread_self(), tid_) != 0;
+}
+
 void* EventLoop::PthreadFunc(void *arg)
 {
     ((EventLoop*)arg)->Loop();
@@ -185,9 +263,13 @@ void EventLoop::Loop()
 {
     WriteInfo(TraceLoop, id_, "starting event loop");
 
+    // timeout is 0 while busy polling after events are reported, until busyPollDeadline
+    int timeout = -1;
+    StopwatchTime busyPollDeadline = StopwatchTime::Zero;
+
     for(;;)
     {
-        auto count = epoll_wait(epfd_, reportList_.data(), reportList_.size(), -1);
+        auto count = epoll_wait(epfd_, reportList_.data(), reportList_.size(), timeout);
         if (count < 0)
         {
             if (errno == EINTR) continue;
@@ -196,6 +278,17 @@ void EventLoop::Loop()
             break;
         }
 
+        if ((count == 0) && (timeout == 0))
+        {
+            if (Stopwatch::Now() >= busyPollDeadline)
+            {
+                timeout = -1;
+                busyPolling_.store(false);
+            }
+
+            continue;
+        }
+
         WriteTrace(
             (count == 0)? LogLevel::Info : LogLevel::Noise,
             TraceLoop,
@@ -206,6 +299,8 @@ void EventLoop::Loop()
 
         if (count == 0) break;
 
+        auto runToCompletion = runToCompletion_.load();
+
         for(uint i = 0; i < count; ++i)
         {
             FdContext* fdc = (FdContext*)(reportList_[i].data.ptr);
@@ -231,7 +326,15 @@ void EventLoop::Loop()
                 epoll_ctl(epfd_, EPOLL_CTL_DEL, fdc->Fd(), nullptr);
             }
 
-            fdc->FireEvent(evt);
+            fdc->FireEvent(evt, runToCompletion);
+        }
+
+        auto busyPollTicks = busyPollTicks_.load();
+        if (runToCompletion && (busyPollTicks > 0))
+        {
+            timeout = 0;
+            busyPollDeadline = Stopwatch::Now() + TimeSpan::FromTicks(busyPollTicks);
+            busyPolling_.store(true);
         }
     }
 
@@ -245,9 +348,14 @@ void EventLoop::Cleanup()
     fdMapSize_ = fdMap_.size();
 }
 
-EventLoop::FdContext* EventLoop::RegisterFd(int fd, uint events, bool dispatchEventAsync, Callback const & cb)
+EventLoop::FdContext* EventLoop::RegisterFd(
+    int fd,
+    uint events,
+    bool dispatchEventAsync,
+    Callback const & cb,
+    bool inlineOnRunToCompletion)
 {
-    auto ctx = make_shared<FdContext>(fd, events, cb, dispatchEventAsync);
+    auto ctx = make_shared<FdContext>(fd, events, cb, dispatchEventAsync, inlineOnRunToCompletion);
     {
         AcquireWriteLock grab(lock_);
 
@@ -324,8 +432,12 @@ void EventLoop::UnregisterFd(FdContext* fdc, bool waitForCallback)
         CommonConfig::GetConfig().EventLoopCleanupDelay);
 }
 
-EventLoop::FdContext::FdContext(int fd, uint events, Callback const & cb, bool dispatchEventAsync)
-    : fd_(fd), events_(events | defaultEventMask), cb_(cb), dispatchEventAsync_(dispatchEventAsync)
+EventLoop::FdContext::FdContext(int fd, uint events, Callback const & cb, bool dispatchEventAsync, bool inlineOnRunToCompletion)
+    : fd_(fd)
+    , events_(events | defaultEventMask)
+    , cb_(cb)
+    , dispatchEventAsync_(dispatchEventAsync)
+    , inlineOnRunToCompletion_(inlineOnRunToCompletion)
 {
     WriteInfo(TraceLoop, "FdContext ctor: {0}", *this);
 }
@@ -351,7 +463,7 @@ int EventLoop::FdContext::CallbackRunningDec()
     return after;
 }
 
-void EventLoop::FdContext::FireEvent(uint events)
+void EventLoop::FdContext::FireEvent(uint events, bool runToCompletion)
 {
     auto cbRunning = ++cbRunning_;
     //there are no concurrent ++cbRunning_ calls, as FireEvent is called sequentially after epoll_wait return
@@ -363,7 +475,9 @@ void EventLoop::FdContext::FireEvent(uint events)
         return;
     }
 
-    if (dispatchEventAsync_ || EventLoop::IsFdClosedOrInError(events))
+    // Closed or error events are always dispatched, as their handling may block the loop
+    auto dispatchAsync = (runToCompletion && inlineOnRunToCompletion_) ? false : dispatchEventAsync_;
+    if (dispatchAsync || EventLoop::IsFdClosedOrInError(events))
     {
         Threadpool::Post([events, this] { RunCallback(events); });
         return;
@@ -393,5 +507,11 @@ void EventLoop::FdContext::Close(bool waitForCallback)
 
 void EventLoop::FdContext::WriteTo(Common::TextWriter & w, Common::FormatOptions const &) const
 {
-    w.Write("(fdc={0},fd={1:x}, events={2:x}, dispatchEventAsync={3})", TextTraceThis, fd_, events_, dispatchEventAsync_);
+    w.Write(
+        "(fdc={0},fd={1:x}, events={2:x}, dispatchEventAsync={3}, inlineOnRunToCompletion={4})",
+        TextTraceThis,
+        fd_,
+        events_,
+        dispatchEventAsync_,
+        inlineOnRunToCompletion_);
 }    
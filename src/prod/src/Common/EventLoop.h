@@ -16,7 +16,15 @@ namespace Common
         ~EventLoop();
 
         class FdContext;
-        FdContext* RegisterFd(int fd, uint events, bool dispatchEventAsync, Callback const & cb);
+
+        // inlineOnRunToCompletion: in run-to-completion mode, readiness events of this registration are handled
+        // on the loop thread even if dispatchEventAsync is set. Only for callbacks that never block.
+        FdContext* RegisterFd(
+            int fd,
+            uint events,
+            bool dispatchEventAsync,
+            Callback const & cb,
+            bool inlineOnRunToCompletion = false);
         void UnregisterFd(FdContext* fdc, bool waitForCallback);
 
         Common::ErrorCode Activate(FdContext* fdc);
@@ -25,6 +33,17 @@ namespace Common
 
         void SetSchedParam(int policy, int priority);
 
+        // Pins the loop thread to the given cpu
+        void PinToCpu(int cpu);
+
+        // In run-to-completion mode, readiness of registrations with inlineOnRunToCompletion is handled on the
+        // loop thread, other registrations keep their dispatchEventAsync. After reporting events, the loop keeps
+        // polling without blocking for up to busyPollDuration, so that back-to-back messages don't pay for a wakeup.
+        void SetRunToCompletion(Common::TimeSpan busyPollDuration);
+
+        bool Test_IsLoopThread() const;
+        bool Test_IsBusyPolling() const { return busyPolling_.load(); }
+
     private:
         typedef std::unordered_map<int, std::shared_ptr<FdContext>> FdMap;
 
@@ -40,6 +59,9 @@ namespace Common
         FdMap fdMap_;
         volatile size_t fdMapSize_;
         std::vector<epoll_event> reportList_;
+        std::atomic_bool runToCompletion_;
+        std::atomic<int64> busyPollTicks_;
+        std::atomic_bool busyPolling_;
     };
 
     class EventLoopPool : public Common::TextTraceComponent<Common::TraceTaskCodes::Common>
@@ -54,6 +76,10 @@ namespace Common
 
         void SetSchedParam(int policy, int priority);
 
+        // Pins each loop to one of the cpus the process is allowed to run on and switches
+        // the loops to run-to-completion mode, see EventLoop::SetRunToCompletion
+        void SetRunToCompletion(Common::TimeSpan busyPollDuration);
+
         static EventLoopPool* GetDefault(); 
 
     private:
@@ -15,6 +15,17 @@ namespace Common
 {
     class JobQueueTest
     {
+    protected:
+        struct EnqueueContentionResult
+        {
+            double ItemsPerSecond;
+            int64 AverageLatencyTicks;
+            int64 P99LatencyTicks;
+            int64 MaxLatencyTicks;
+        };
+
+        template <typename TJobQueue>
+        static EnqueueContentionResult RunEnqueueContention(std::wstring const & name, int producerCount, int itemsPerProducer);
     };
 
     class JobRoot : public ComponentRoot
@@ -310,6 +321,110 @@ namespace Common
         }
     };
 
+    //
+    // Enqueues from producerCount threadpool threads at the same time and measures the
+    // enqueue throughput and the latency of each Enqueue call
+    //
+    template <typename TJobQueue>
+    JobQueueTest::EnqueueContentionResult JobQueueTest::RunEnqueueContention(std::wstring const & name, int producerCount, int itemsPerProducer)
+    {
+        shared_ptr<JobRoot> jobRoot = make_shared<JobRoot>();
+        TJobQueue jobQueue(name, *jobRoot);
+
+        LONG totalItems = producerCount * itemsPerProducer;
+        vector<vector<int64>> latencies(producerCount);
+        atomic_long pendingProducers(producerCount);
+        ManualResetEvent producersCompleted(false);
+        ManualResetEvent itemsCompleted(false);
+
+        Stopwatch stopwatch;
+        stopwatch.Start();
+
+        for (int ix = 0; ix < producerCount; ++ix)
+        {
+            Threadpool::Post([&, ix]()
+            {
+                auto & producerLatencies = latencies[ix];
+                producerLatencies.reserve(itemsPerProducer);
+
+                for (int jx = 0; jx < itemsPerProducer; ++jx)
+                {
+                    auto start = Stopwatch::Now();
+
+                    jobQueue.Enqueue(DefaultJobItem<JobRoot>([&](JobRoot & root)
+                    {
+                        if (++root.processedJobs_ == totalItems)
+                        {
+                            itemsCompleted.Set();
+                        }
+                    }));
+
+                    producerLatencies.push_back((Stopwatch::Now() - start).Ticks);
+                }
+
+                if (--pendingProducers == 0)
+                {
+                    producersCompleted.Set();
+                }
+            });
+        }
+
+        VERIFY_IS_TRUE(producersCompleted.WaitOne(TimeSpan::FromMinutes(2)));
+        stopwatch.Stop();
+
+        VERIFY_IS_TRUE(itemsCompleted.WaitOne(TimeSpan::FromMinutes(2)));
+        VERIFY_ARE_EQUAL(totalItems, jobRoot->processedJobs_.load());
+
+        jobQueue.Close();
+
+        // The last item signals itemsCompleted from inside its callback while its worker is still
+        // running the queue loop, so wait for the workers to leave before the queue is destroyed
+        //
+        Stopwatch drainStopwatch;
+        drainStopwatch.Start();
+        while (jobQueue.GetActiveThreads() != 0 && drainStopwatch.Elapsed < TimeSpan::FromMinutes(2))
+        {
+            Sleep(10);
+        }
+
+        VERIFY_ARE_EQUAL(0u, jobQueue.GetActiveThreads());
+
+        vector<int64> all;
+        all.reserve(totalItems);
+        for (auto const & it : latencies)
+        {
+            all.insert(all.end(), it.begin(), it.end());
+        }
+
+        sort(all.begin(), all.end());
+
+        int64 sum = 0;
+        for (auto latency : all)
+        {
+            sum += latency;
+        }
+
+        EnqueueContentionResult result;
+        result.ItemsPerSecond = totalItems / max(stopwatch.Elapsed.TotalMillisecondsAsDouble() / 1000, 0.001);
+        result.AverageLatencyTicks = sum / totalItems;
+        result.P99LatencyTicks = all[(all.size() * 99) / 100];
+        result.MaxLatencyTicks = all.back();
+
+        Trace.WriteInfo(
+            "JobQueueTest",
+            "{0}: producers={1} items={2} elapsed={3}ms throughput={4} items/s latency(ticks) avg={5} p99={6} max={7}",
+            name,
+            producerCount,
+            totalItems,
+            stopwatch.ElapsedMilliseconds,
+            result.ItemsPerSecond,
+            result.AverageLatencyTicks,
+            result.P99LatencyTicks,
+            result.MaxLatencyTicks);
+
+        return result;
+    }
+
     //
     // TEST METHODS
     //
@@ -755,5 +870,167 @@ namespace Common
 
     }
 
+    BOOST_AUTO_TEST_CASE(LockFreeFifoLifoTest)
+    {
+        shared_ptr<JobRoot> jobRoot = make_shared<JobRoot>();
+
+        LockFreeJobQueue<unique_ptr<CommonTimedJobItem<JobRoot>>, JobRoot> jobQueue(
+            L"LockFreeFifoLifoTest",
+            *jobRoot,
+            false, // ForceEnqueue
+            1, // ThreadCount
+            nullptr, // PerformanceCounters
+            5,  // QueueSize
+            Common::DequePolicy::FifoLifo);
+
+        ManualResetEvent jobProcessingStarted;
+        shared_ptr<ManualResetEvent> jobProcessingBlocked = make_shared<ManualResetEvent>();
+
+        int numberOfEnqueuedItems = 0;
+        VERIFY_IS_TRUE(jobQueue.Enqueue(make_unique<JobRoot::TestJobItemWithWait>(*jobRoot, numberOfEnqueuedItems + 1, jobProcessingStarted, jobProcessingBlocked)));
+        numberOfEnqueuedItems++;
+
+        jobProcessingStarted.WaitOne();
+
+        for (int i = 0; i < 10; i++)
+        {
+            if (jobQueue.Enqueue(make_unique<JobRoot::TestJobItemWithWait>(*jobRoot, numberOfEnqueuedItems + 1, jobProcessingStarted)))
+            {
+                numberOfEnqueuedItems++;
+            }
+        }
+
+        VERIFY_ARE_EQUAL(5, jobRoot->queueFullJobs_.load());
+
+        jobProcessingBlocked->Set();
+
+        Sleep(1000 * 10);
+
+        // The queue was full so the items are drained Lifo
+        VERIFY_ARE_EQUAL(jobRoot->ProcessedItems.size(), numberOfEnqueuedItems);
+        VERIFY_ARE_EQUAL(wformatString(jobRoot->ProcessedItems), L"(1 6 5 4 3 2)");
+
+        jobProcessingStarted.Reset();
+        jobProcessingBlocked->Reset();
+
+        VERIFY_IS_TRUE(jobQueue.Enqueue(make_unique<JobRoot::TestJobItemWithWait>(*jobRoot, numberOfEnqueuedItems + 1, jobProcessingStarted, jobProcessingBlocked)));
+        numberOfEnqueuedItems++;
+
+        jobProcessingStarted.WaitOne();
+
+        for (int i = 0; i < 3; i++)
+        {
+            if (jobQueue.Enqueue(make_unique<JobRoot::TestJobItemWithWait>(*jobRoot, numberOfEnqueuedItems + 1, jobProcessingStarted)))
+            {
+                numberOfEnqueuedItems++;
+            }
+        }
+
+        jobProcessingBlocked->Set();
+
+        Sleep(1000 * 10);
+
+        // Back to Fifo once the queue was drained
+        VERIFY_ARE_EQUAL(jobRoot->ProcessedItems.size(), numberOfEnqueuedItems);
+        VERIFY_ARE_EQUAL(wformatString(jobRoot->ProcessedItems), L"(1 6 5 4 3 2 7 8 9 10)");
+
+        jobQueue.Close();
+    }
+
+    BOOST_AUTO_TEST_CASE(LockFreeLifoTest)
+    {
+        shared_ptr<JobRoot> jobRoot = make_shared<JobRoot>();
+
+        LockFreeJobQueue<unique_ptr<CommonTimedJobItem<JobRoot>>, JobRoot> jobQueue(
+            L"LockFreeLifoTest",
+            *jobRoot,
+            false, // ForceEnqueue
+            1, // ThreadCount
+            nullptr, // PerformanceCounters
+            UINT64_MAX,  // QueueSize
+            Common::DequePolicy::Lifo);
+
+        ManualResetEvent jobProcessingStarted;
+        shared_ptr<ManualResetEvent> jobProcessingBlocked = make_shared<ManualResetEvent>();
+
+        VERIFY_IS_TRUE(jobQueue.Enqueue(make_unique<JobRoot::TestJobItemWithWait>(*jobRoot, 1, jobProcessingStarted, jobProcessingBlocked)));
+        jobProcessingStarted.WaitOne();
+
+        for (int i = 2; i <= 5; i++)
+        {
+            VERIFY_IS_TRUE(jobQueue.Enqueue(make_unique<JobRoot::TestJobItemWithWait>(*jobRoot, i, jobProcessingStarted)));
+        }
+
+        VERIFY_ARE_EQUAL(4u, jobQueue.GetQueueLength());
+
+        jobProcessingBlocked->Set();
+
+        Sleep(1000 * 5);
+
+        VERIFY_ARE_EQUAL(wformatString(jobRoot->ProcessedItems), L"(1 5 4 3 2)");
+        VERIFY_ARE_EQUAL(0u, jobQueue.GetQueueLength());
+        VERIFY_ARE_EQUAL(0u, jobQueue.GetActiveThreads());
+
+        jobQueue.Close();
+    }
+
+    BOOST_AUTO_TEST_CASE(LockFreeThrottleTest)
+    {
+        shared_ptr<JobRoot> jobRoot = make_shared<JobRoot>();
+
+        LockFreeJobQueue<DefaultJobItem<JobRoot>, JobRoot> jobQueue(L"LockFreeThrottleTest", *jobRoot);
+
+        jobQueue.SetThrottle(true);
+
+        for (int i = 0; i < 100; i++)
+        {
+            VERIFY_IS_TRUE(jobQueue.Enqueue(DefaultJobItem<JobRoot>([](JobRoot & root) { ++root.processedJobs_; })));
+        }
+
+        Sleep(1000);
+
+        // No thread is started while the queue is throttled
+        VERIFY_ARE_EQUAL(0, jobRoot->processedJobs_.load());
+        VERIFY_ARE_EQUAL(100u, jobQueue.GetQueueLength());
+        VERIFY_ARE_EQUAL(0u, jobQueue.GetActiveThreads());
+
+        jobQueue.SetThrottle(false);
+
+        Sleep(1000 * 5);
+
+        VERIFY_ARE_EQUAL(100, jobRoot->processedJobs_.load());
+        VERIFY_ARE_EQUAL(0u, jobQueue.GetQueueLength());
+        VERIFY_IS_TRUE(jobQueue.Test_HighestActiveThreads <= jobQueue.GetMaxThreads());
+
+        jobQueue.Close();
+
+        // Enqueue fails after close
+        VERIFY_IS_FALSE(jobQueue.Enqueue(DefaultJobItem<JobRoot>([](JobRoot & root) { ++root.processedJobs_; })));
+    }
+
+    BOOST_AUTO_TEST_CASE(EnqueueContentionTest)
+    {
+        int const producerCount = 64;
+        int const itemsPerProducer = 2000;
+
+        auto locked = RunEnqueueContention<JobQueue<DefaultJobItem<JobRoot>, JobRoot>>(
+            L"JobQueue",
+            producerCount,
+            itemsPerProducer);
+
+        auto lockFree = RunEnqueueContention<LockFreeJobQueue<DefaultJobItem<JobRoot>, JobRoot>>(
+            L"LockFreeJobQueue",
+            producerCount,
+            itemsPerProducer);
+
+        Trace.WriteInfo(
+            "JobQueueTest",
+            "EnqueueContentionTest: throughput JobQueue={0} LockFreeJobQueue={1} items/s, p99 latency(ticks) JobQueue={2} LockFreeJobQueue={3}",
+            locked.ItemsPerSecond,
+            lockFree.ItemsPerSecond,
+            locked.P99LatencyTicks,
+            lockFree.P99LatencyTicks);
+    }
+
     BOOST_AUTO_TEST_SUITE_END()
 }
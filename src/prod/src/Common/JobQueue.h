@@ -7,6 +7,152 @@
 
 namespace Common
 {
+    // Dispatches to the optional job item methods for items held by value, unique_ptr or shared_ptr
+    // Shared by JobQueue and LockFreeJobQueue
+    template <typename J, typename R>
+    struct JobQueueJobTraits
+    {
+        static bool ProcessJob(J & item, R & root)
+        {
+            return item.ProcessJob(root);
+        }
+
+        static void SynchronizedProcess(J & item, R & root)
+        {
+            __if_exists(J::SynchronizedProcess)
+            {
+                item.SynchronizedProcess(root);
+            }
+            __if_not_exists(J::SynchronizedProcess)
+            {
+                UNREFERENCED_PARAMETER(item);
+                UNREFERENCED_PARAMETER(root);
+            }
+        }
+
+        static void Close(J & item, R & root)
+        {
+            __if_exists(J::Close)
+            {
+                item.Close(root);
+            }
+            __if_not_exists(J::Close)
+            {
+                UNREFERENCED_PARAMETER(item);
+                UNREFERENCED_PARAMETER(root);
+            }
+        }
+
+        static void UpdatePerfCounter(J &item, JobQueuePerfCounters &perfCounter)
+        {
+            __if_exists(J::UpdatePerfCounter)
+            {
+                item.UpdatePerfCounter(perfCounter);
+            }
+            __if_not_exists(J::UpdatePerfCounter)
+            {
+                UNREFERENCED_PARAMETER(item);
+                UNREFERENCED_PARAMETER(perfCounter);
+            }
+        }
+    };
+
+    template <typename JU, typename R>
+    struct JobQueueJobTraits<std::unique_ptr<JU>, R>
+    {
+        static bool ProcessJob(std::unique_ptr<JU> & item, R & root)
+        {
+            return item->ProcessJob(root);
+        }
+
+        static void SynchronizedProcess(std::unique_ptr<JU> & item, R & root)
+        {
+            __if_exists(JU::SynchronizedProcess)
+            {
+                item->SynchronizedProcess(root);
+            }
+            __if_not_exists(JU::SynchronizedProcess)
+            {
+                UNREFERENCED_PARAMETER(item);
+                UNREFERENCED_PARAMETER(root);
+            }
+        }
+
+        static void Close(std::unique_ptr<JU> & item, R & root)
+        {
+            __if_exists(JU::Close)
+            {
+                item->Close(root);
+            }
+            __if_not_exists(JU::Close)
+            {
+                UNREFERENCED_PARAMETER(item);
+                UNREFERENCED_PARAMETER(root);
+            }
+        }
+
+        static void UpdatePerfCounter(std::unique_ptr<JU> &item, JobQueuePerfCounters &perfCounter)
+        {
+            __if_exists(JU::UpdatePerfCounter)
+            {
+                item->UpdatePerfCounter(perfCounter);
+            }
+            __if_not_exists(JU::UpdatePerfCounter)
+            {
+                UNREFERENCED_PARAMETER(item);
+                UNREFERENCED_PARAMETER(perfCounter);
+            }
+        }
+    };
+
+    template <typename JU, typename R>
+    struct JobQueueJobTraits<std::shared_ptr<JU>, R>
+    {
+        static bool ProcessJob(std::shared_ptr<JU> & item, R & root)
+        {
+            return item->ProcessJob(root);
+        }
+
+        static void SynchronizedProcess(std::shared_ptr<JU> & item, R & root)
+        {
+            __if_exists(JU::SynchronizedProcess)
+            {
+                item->SynchronizedProcess(root);
+            }
+            __if_not_exists(JU::SynchronizedProcess)
+            {
+                UNREFERENCED_PARAMETER(item);
+                UNREFERENCED_PARAMETER(root);
+            }
+        }
+
+        static void Close(std::shared_ptr<JU> & item, R & root)
+        {
+            __if_exists(JU::Close)
+            {
+                item->Close(root);
+            }
+            __if_not_exists(JU::Close)
+            {
+                UNREFERENCED_PARAMETER(item);
+                UNREFERENCED_PARAMETER(root);
+            }
+        }
+
+        static void UpdatePerfCounter(std::shared_ptr<JU> &item, JobQueuePerfCounters &perfCounter)
+        {
+            __if_exists(JU::UpdatePerfCounter)
+            {
+                item->UpdatePerfCounter(perfCounter);
+            }
+            __if_not_exists(JU::UpdatePerfCounter)
+            {
+                UNREFERENCED_PARAMETER(item);
+                UNREFERENCED_PARAMETER(perfCounter);
+            }
+        }
+    };
+
     template <typename T, typename R>
     class JobQueue
     {
@@ -515,148 +661,9 @@ namespace Common
             }
         }
 
-        template <typename J> 
-        struct JobTraits
-        {
-            static bool ProcessJob(J & item, R & root)
-            {
-                return item.ProcessJob(root);
-            }
-
-            static void SynchronizedProcess(J & item, R & root)
-            {
-                __if_exists(J::SynchronizedProcess)
-                {
-                    item.SynchronizedProcess(root);
-                }
-                __if_not_exists(J::SynchronizedProcess)
-                {
-                    UNREFERENCED_PARAMETER(item);
-                    UNREFERENCED_PARAMETER(root);
-                }
-            }
-
-            static void Close(J & item, R & root)
-            {
-                __if_exists(J::Close)
-                {
-                    item.Close(root);
-                }
-                __if_not_exists(J::Close)
-                {
-                    UNREFERENCED_PARAMETER(item);
-                    UNREFERENCED_PARAMETER(root);
-                }
-            }
-
-            static void UpdatePerfCounter(J &item, JobQueuePerfCounters &perfCounter)
-            {
-                __if_exists(J::UpdatePerfCounter)
-                {
-                    item.UpdatePerfCounter(perfCounter);
-                }
-                __if_not_exists(J::UpdatePerfCounter)
-                {
-                    UNREFERENCED_PARAMETER(item);
-                    UNREFERENCED_PARAMETER(perfCounter);
-                }
-            }
-        };
-
-        template <typename JU>
-        struct JobTraits<std::unique_ptr<JU>>
-        {
-            static bool ProcessJob(std::unique_ptr<JU> & item, R & root)
-            {
-                return item->ProcessJob(root);
-            }
-
-            static void SynchronizedProcess(std::unique_ptr<JU> & item, R & root)
-            {
-                __if_exists(JU::SynchronizedProcess)
-                {
-                    item->SynchronizedProcess(root);
-                }
-                __if_not_exists(JU::SynchronizedProcess)
-                {
-                    UNREFERENCED_PARAMETER(item);
-                    UNREFERENCED_PARAMETER(root);
-                }
-            }
-
-            static void Close(std::unique_ptr<JU> & item, R & root)
-            {
-                __if_exists(JU::Close)
-                {
-                    item->Close(root);
-                }
-                __if_not_exists(JU::Close)
-                {
-                    UNREFERENCED_PARAMETER(item);
-                    UNREFERENCED_PARAMETER(root);
-                }
-            }
-
-            static void UpdatePerfCounter(std::unique_ptr<JU> &item, JobQueuePerfCounters &perfCounter)
-            {
-                __if_exists(JU::UpdatePerfCounter)
-                {
-                    item->UpdatePerfCounter(perfCounter);
-                }
-                __if_not_exists(JU::UpdatePerfCounter)
-                {
-                    UNREFERENCED_PARAMETER(item);
-                    UNREFERENCED_PARAMETER(perfCounter);
-                }
-            }
-        };
-
-        template <typename JU>
-        struct JobTraits<std::shared_ptr<JU>>
+        template <typename J>
+        struct JobTraits : public JobQueueJobTraits<J, R>
         {
-            static bool ProcessJob(std::shared_ptr<JU> & item, R & root)
-            {
-                return item->ProcessJob(root);
-            }
-
-            static void SynchronizedProcess(std::shared_ptr<JU> & item, R & root)
-            {
-                __if_exists(JU::SynchronizedProcess)
-                {
-                    item->SynchronizedProcess(root);
-                }
-                __if_not_exists(JU::SynchronizedProcess)
-                {
-                    UNREFERENCED_PARAMETER(item);
-                    UNREFERENCED_PARAMETER(root);
-                }
-            }
-
-            static void Close(std::shared_ptr<JU> & item, R & root)
-            {
-                __if_exists(JU::Close)
-                {
-                    item->Close(root);
-                }
-                __if_not_exists(JU::Close)
-                {
-                    UNREFERENCED_PARAMETER(item);
-                    UNREFERENCED_PARAMETER(root);
-                }
-            }
-
-            static void UpdatePerfCounter(std::shared_ptr<JU> &item, JobQueuePerfCounters &perfCounter)
-            {
-                __if_exists(JU::UpdatePerfCounter)
-                {
-                    item->UpdatePerfCounter(perfCounter);
-                }
-                __if_not_exists(JU::UpdatePerfCounter)
-                {
-                    UNREFERENCED_PARAMETER(item);
-                    UNREFERENCED_PARAMETER(perfCounter);
-                }
-            }
         };
 
         bool OnJobThreadTerminate()
@@ -0,0 +1,279 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+using namespace Common;
+using namespace std;
+
+namespace Common
+{
+    StringLiteral const TraceType("JsonChunkedWriterTest");
+
+    class ChunkedTestItem : public IFabricJsonSerializable
+    {
+    public:
+        ChunkedTestItem()
+            : name_()
+            , status_()
+            , id_(0)
+            , load_(0)
+            , isStateful_(false)
+        {
+        }
+
+        ChunkedTestItem(int index)
+            : name_(wformatString("fabric:/App{0}/Service{1}", index % 100, index))
+            , status_(L"Ready \"primary\"\\secondary/\t")
+            , id_(index)
+            , load_(index * 1.5)
+            , isStateful_(index % 2 == 0)
+        {
+        }
+
+        BEGIN_JSON_SERIALIZABLE_PROPERTIES()
+            SERIALIZABLE_PROPERTY(L"Name", name_)
+            SERIALIZABLE_PROPERTY(L"Status", status_)
+            SERIALIZABLE_PROPERTY(L"Id", (LONG&)id_)
+            SERIALIZABLE_PROPERTY(L"Load", load_)
+            SERIALIZABLE_PROPERTY(L"IsStateful", isStateful_)
+        END_JSON_SERIALIZABLE_PROPERTIES()
+
+        bool operator == (ChunkedTestItem const & other) const
+        {
+            return name_ == other.name_
+                && status_ == other.status_
+                && id_ == other.id_
+                && isStateful_ == other.isStateful_;
+        }
+
+        wstring name_;
+        wstring status_;
+        int id_;
+        double load_;
+        bool isStateful_;
+    };
+
+    class ChunkedTestList : public IFabricJsonSerializable
+    {
+    public:
+        ChunkedTestList() : continuationToken_(), items_() { }
+
+        BEGIN_JSON_SERIALIZABLE_PROPERTIES()
+            SERIALIZABLE_PROPERTY(L"ContinuationToken", continuationToken_)
+            SERIALIZABLE_PROPERTY(L"Items", items_)
+        END_JSON_SERIALIZABLE_PROPERTIES()
+
+        wstring continuationToken_;
+        vector<ChunkedTestItem> items_;
+    };
+
+    class JsonChunkedWriterTest
+    {
+    protected:
+        static void CreateList(size_t count, __out ChunkedTestList & list)
+        {
+            list.continuationToken_ = L"token";
+            list.items_.reserve(count);
+            for (size_t ix = 0; ix < count; ++ix)
+            {
+                list.items_.push_back(ChunkedTestItem(static_cast<int>(ix)));
+            }
+        }
+
+        static ByteBufferUPtr Coalesce(ByteBufferChunkList const & chunks)
+        {
+            auto buffer = make_unique<ByteBuffer>();
+            for (auto const & chunk : chunks)
+            {
+                buffer->insert(buffer->end(), chunk->begin(), chunk->end());
+            }
+
+            return buffer;
+        }
+    };
+
+    BOOST_FIXTURE_TEST_SUITE(JsonChunkedWriterTestSuite, JsonChunkedWriterTest)
+
+    BOOST_AUTO_TEST_CASE(SameOutputAsJsonWriter)
+    {
+        ChunkedTestList list;
+        CreateList(100, list);
+
+        ByteBufferUPtr expected;
+        auto error = JsonHelper::Serialize(list, expected);
+        VERIFY_IS_TRUE(error.IsSuccess());
+
+        ByteBufferChunkList chunks;
+        error = JsonHelper::SerializeChunked(list, chunks);
+        VERIFY_IS_TRUE(error.IsSuccess());
+
+        auto actual = Coalesce(chunks);
+        VERIFY_IS_TRUE(*expected == *actual);
+
+        JsonChunkPool::GetDefault().ReturnChunks(move(chunks));
+    }
+
+    BOOST_AUTO_TEST_CASE(SmallChunksRoundTrip)
+    {
+        JsonChunkPool pool(7, 4);
+
+        ChunkedTestList list;
+        CreateList(50, list);
+
+        ByteBufferChunkList chunks;
+        auto error = JsonHelper::SerializeChunked(list, chunks, JsonSerializerFlags::Default, pool);
+        VERIFY_IS_TRUE(error.IsSuccess());
+        VERIFY_IS_TRUE(chunks.size() > 1);
+
+        for (auto const & chunk : chunks)
+        {
+            VERIFY_IS_TRUE(chunk->size() > 0 && chunk->size() <= 7);
+        }
+
+        ChunkedTestList result;
+        error = JsonHelper::Deserialize(result, Coalesce(chunks));
+        VERIFY_IS_TRUE(error.IsSuccess());
+        VERIFY_IS_TRUE(result.continuationToken_ == list.continuationToken_);
+        VERIFY_IS_TRUE(result.items_ == list.items_);
+
+        pool.ReturnChunks(move(chunks));
+        VERIFY_ARE_EQUAL(4u, pool.PooledChunkCount);
+    }
+
+    BOOST_AUTO_TEST_CASE(GrammarErrors)
+    {
+        JsonChunkedWriter writer;
+        ByteBufferChunkList chunks;
+
+        VERIFY_ARE_EQUAL(JSON_E_PROPERTY_ARRAY_OR_OBJECT_NOT_STARTED, writer.PropertyName(L"a"));
+        VERIFY_ARE_EQUAL(S_OK, writer.ObjectStart());
+        VERIFY_ARE_EQUAL(JSON_E_MISSING_PROPERTY, writer.IntValue(1));
+        VERIFY_ARE_EQUAL(JSON_E_ARRAY_NOT_STARTED, writer.ArrayEnd());
+        VERIFY_ARE_EQUAL(S_OK, writer.PropertyName(L"a"));
+        VERIFY_ARE_EQUAL(JSON_E_PROPERTY_ALREADY_ADDED, writer.PropertyName(L"b"));
+        VERIFY_ARE_EQUAL(S_OK, writer.IntValue(-9223372036854775807LL - 1));
+        VERIFY_ARE_EQUAL(JSON_E_NOT_COMPLETE, writer.TakeChunks(chunks));
+        VERIFY_ARE_EQUAL(S_OK, writer.ObjectEnd());
+        VERIFY_ARE_EQUAL(S_OK, writer.TakeChunks(chunks));
+
+        auto bytes = Coalesce(chunks);
+        string json(reinterpret_cast<char*>(bytes->data()), bytes->size());
+        VERIFY_ARE_EQUAL(string("{\"a\":-9223372036854775808}"), json);
+
+        JsonChunkPool::GetDefault().ReturnChunks(move(chunks));
+    }
+
+    BOOST_AUTO_TEST_CASE(SurrogatePairsAsCesu8LikeJsonWriter)
+    {
+        JsonChunkedWriter writer;
+        ByteBufferChunkList chunks;
+
+        WCHAR value[] = { 0xd83d, 0xde00, L'a', 0 };
+        VERIFY_ARE_EQUAL(S_OK, writer.StringValue(value));
+        VERIFY_ARE_EQUAL(S_OK, writer.TakeChunks(chunks));
+
+        auto bytes = Coalesce(chunks);
+        // Each surrogate is encoded on its own, the same way JsonWriter::AppendChar does
+        //
+        vector<BYTE> expected = { '"', 0xed, 0xa0, 0xbd, 0xed, 0xb8, 0x80, 'a', '"' };
+        VERIFY_IS_TRUE(expected == *bytes);
+
+        JsonChunkPool::GetDefault().ReturnChunks(move(chunks));
+    }
+
+    //
+    // Compares throughput and peak buffer memory of JsonWriter (one growing string copied out by GetBytes)
+    // against JsonChunkedWriter (pooled chunks) for a 100K item query result.
+    //
+    BOOST_AUTO_TEST_CASE(SerializationPerf100K)
+    {
+        size_t const itemCount = 100000;
+
+        ChunkedTestList list;
+        CreateList(itemCount, list);
+
+        // Warm up the chunk pool the same way a busy gateway would be
+        //
+        JsonChunkPool pool(JsonChunkPool::DefaultChunkSize, 1024);
+        {
+            ByteBufferChunkList chunks;
+            VERIFY_IS_TRUE(JsonHelper::SerializeChunked(list, chunks, JsonSerializerFlags::Default, pool).IsSuccess());
+            pool.ReturnChunks(move(chunks));
+        }
+
+        size_t contiguousPeakBytes = 0;
+        size_t contiguousBytes = 0;
+        Stopwatch contiguousStopwatch;
+        {
+            ComPointer<JsonWriter> jsonWriter = make_com<JsonWriter>();
+            JsonWriterVisitor visitor(jsonWriter.GetRawPointer());
+
+            contiguousStopwatch.Start();
+            VERIFY_IS_TRUE(SUCCEEDED(list.ToJson(visitor)));
+
+            ByteBuffer bytes;
+            VERIFY_IS_TRUE(SUCCEEDED(jsonWriter->GetBytes(bytes)));
+            contiguousStopwatch.Stop();
+
+            // The string buffer and the copied out vector are both alive at the end of GetBytes
+            //
+            contiguousBytes = bytes.size();
+            contiguousPeakBytes = bytes.capacity() + bytes.size();
+        }
+
+        size_t chunkedPeakBytes = 0;
+        size_t chunkedBytes = 0;
+        Stopwatch chunkedStopwatch;
+        {
+            ByteBufferChunkList chunks;
+
+            chunkedStopwatch.Start();
+            VERIFY_IS_TRUE(JsonHelper::SerializeChunked(list, chunks, JsonSerializerFlags::Default, pool).IsSuccess());
+            chunkedStopwatch.Stop();
+
+            for (auto const & chunk : chunks)
+            {
+                chunkedBytes += chunk->size();
+                chunkedPeakBytes += chunk->capacity();
+            }
+
+            pool.ReturnChunks(move(chunks));
+        }
+
+        VERIFY_ARE_EQUAL(contiguousBytes, chunkedBytes);
+
+        auto toMBps = [](size_t bytes, Stopwatch const & stopwatch)
+        {
+            auto elapsed = stopwatch.ElapsedMicroseconds;
+            return elapsed > 0 ? static_cast<double>(bytes) / elapsed : 0.0;
+        };
+
+        Trace.WriteInfo(
+            TraceType,
+            "JsonWriter: items={0} bytes={1} elapsed={2}ms throughput={3}MB/s peak={4}",
+            itemCount,
+            contiguousBytes,
+            contiguousStopwatch.ElapsedMilliseconds,
+            toMBps(contiguousBytes, contiguousStopwatch),
+            contiguousPeakBytes);
+
+        Trace.WriteInfo(
+            TraceType,
+            "JsonChunkedWriter: items={0} bytes={1} elapsed={2}ms throughput={3}MB/s peak={4}",
+            itemCount,
+            chunkedBytes,
+            chunkedStopwatch.ElapsedMilliseconds,
+            toMBps(chunkedBytes, chunkedStopwatch),
+            chunkedPeakBytes);
+
+        VERIFY_IS_TRUE(chunkedPeakBytes < contiguousPeakBytes);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+}
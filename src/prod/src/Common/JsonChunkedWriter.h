@@ -0,0 +1,536 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Common
+{
+    typedef std::vector<ByteBufferUPtr> ByteBufferChunkList;
+
+    //-------------------------------------------------------------------------------------------------------------------------------------------
+    // Pool of fixed size buffers used as output chunks by JsonChunkedWriter. Chunks are handed back to the pool
+    // once they have been sent on the wire, so a busy gateway reuses the same set of buffers across responses
+    // instead of growing and copying one contiguous buffer per response.
+    //
+    class JsonChunkPool
+    {
+        DENY_COPY(JsonChunkPool)
+
+    public:
+        static const size_t DefaultChunkSize = 64 * 1024;
+        static const size_t DefaultMaxPooledChunks = 256;
+
+        JsonChunkPool(
+            size_t chunkSize = DefaultChunkSize,
+            size_t maxPooledChunks = DefaultMaxPooledChunks)
+            : chunkSize_(chunkSize)
+            , maxPooledChunks_(maxPooledChunks)
+            , lock_()
+            , chunks_()
+        {
+        }
+
+        static JsonChunkPool & GetDefault()
+        {
+            static JsonChunkPool defaultPool;
+            return defaultPool;
+        }
+
+        __declspec(property(get=get_ChunkSize)) size_t ChunkSize;
+        size_t get_ChunkSize() const { return chunkSize_; }
+
+        __declspec(property(get=get_PooledChunkCount)) size_t PooledChunkCount;
+        size_t get_PooledChunkCount() const
+        {
+            AcquireExclusiveLock grab(lock_);
+            return chunks_.size();
+        }
+
+        //
+        // Returns a buffer with size() == ChunkSize. The contents are undefined.
+        //
+        ByteBufferUPtr TakeChunk()
+        {
+            {
+                AcquireExclusiveLock grab(lock_);
+                if (!chunks_.empty())
+                {
+                    auto chunk = std::move(chunks_.back());
+                    chunks_.pop_back();
+                    return chunk;
+                }
+            }
+
+            return std::make_unique<ByteBuffer>(chunkSize_);
+        }
+
+        void ReturnChunk(ByteBufferUPtr && chunk)
+        {
+            if (!chunk || chunk->capacity() < chunkSize_)
+            {
+                return;
+            }
+
+            // Shrinking never reallocates, and growing back to the chunk size is within capacity
+            //
+            chunk->resize(chunkSize_);
+
+            AcquireExclusiveLock grab(lock_);
+            if (chunks_.size() < maxPooledChunks_)
+            {
+                chunks_.push_back(std::move(chunk));
+            }
+        }
+
+        void ReturnChunks(ByteBufferChunkList && chunks)
+        {
+            for (auto & chunk : chunks)
+            {
+                this->ReturnChunk(std::move(chunk));
+            }
+
+            chunks.clear();
+        }
+
+    private:
+        size_t chunkSize_;
+        size_t maxPooledChunks_;
+        mutable ExclusiveLock lock_;
+        ByteBufferChunkList chunks_;
+    };
+
+    //-------------------------------------------------------------------------------------------------------------------------------------------
+    // JsonChunkedWriter produces the same bytes as JsonWriter, but encodes directly into UTF-8 chunks taken
+    // from a JsonChunkPool instead of appending to one growing std::string that is later copied out by GetBytes.
+    // Like JsonWriter, characters outside the BMP are written as two 3 byte surrogate sequences (CESU-8).
+    //
+    // Completed chunks are accumulated until TakeChunks, so the whole document is still buffered and peak memory
+    // grows with the response size; what is saved is the reallocation of one contiguous buffer and the copy out
+    // of it. Chunks are not sent as they fill because serialization is synchronous and the response APIs send a
+    // body with a known Content-Length.
+    //
+    // This writer is not a COM object. It only implements IJsonWriter so that it can be driven by the existing
+    // JsonWriterVisitor, and is meant to be allocated on the stack for the lifetime of one serialization.
+    //
+    class JsonChunkedWriter : public IJsonWriter
+    {
+        DENY_COPY(JsonChunkedWriter)
+
+    public:
+        explicit JsonChunkedWriter(JsonChunkPool & pool = JsonChunkPool::GetDefault())
+            : pool_(pool)
+            , completedChunks_()
+            , current_()
+            , cursor_(nullptr)
+            , end_(nullptr)
+            , totalBytes_(0)
+            , m_bFirstValue(true)
+            , m_bPropertyAppended(false)
+            , m_stack()
+        {
+        }
+
+        virtual ~JsonChunkedWriter()
+        {
+            pool_.ReturnChunks(std::move(completedChunks_));
+            pool_.ReturnChunk(std::move(current_));
+        }
+
+        __declspec(property(get=get_TotalBytes)) size_t TotalBytes;
+        size_t get_TotalBytes() const { return totalBytes_ + this->GetCurrentChunkLength(); }
+
+        //
+        // Completes the trailing partial chunk and moves out all chunks. Fails if the json document
+        // is not complete.
+        //
+        HRESULT TakeChunks(__out ByteBufferChunkList & chunks)
+        {
+            if (!m_stack.IsEmpty())
+            {
+                return JSON_E_NOT_COMPLETE;
+            }
+
+            this->CompleteCurrentChunk();
+
+            chunks = std::move(completedChunks_);
+            completedChunks_.clear();
+
+            return S_OK;
+        }
+
+    public:
+        // IUnknown - lifetime is owned by the caller, so reference counting is a no-op
+        //
+        STDMETHODIMP QueryInterface(REFIID riid, void ** ppvObject)
+        {
+            if (ppvObject == nullptr) { return E_POINTER; }
+
+            if (riid == __uuidof(IUnknown) || riid == __uuidof(IJsonWriter))
+            {
+                *ppvObject = static_cast<IJsonWriter*>(this);
+                return S_OK;
+            }
+
+            *ppvObject = nullptr;
+            return E_NOINTERFACE;
+        }
+
+        STDMETHODIMP_(ULONG) AddRef() { return 1; }
+        STDMETHODIMP_(ULONG) Release() { return 1; }
+
+    public:
+        // IJsonWriter
+        //
+        STDMETHODIMP PropertyName(LPCWSTR pszStr)
+        {
+            if (!pszStr) return E_POINTER;
+
+            if (m_stack.Peek() == '[')
+            {
+                return JSON_E_PROPERTY_NOT_REQUIRED;
+            }
+            else if (m_stack.Peek() == '{')
+            {
+                if (m_bPropertyAppended)
+                {
+                    return JSON_E_PROPERTY_ALREADY_ADDED;
+                }
+            }
+            else
+            {
+                return JSON_E_PROPERTY_ARRAY_OR_OBJECT_NOT_STARTED;
+            }
+
+            PrefixMemberSeperator();
+            m_bFirstValue = true;
+            Put(PropertyStartToken);
+            AppendEscapeString(pszStr);
+            Put(PropertyEndToken);
+            Put(ValueSeparatorToken);
+            m_bPropertyAppended = true;
+            return S_OK;
+        }
+
+        STDMETHODIMP StringValue(LPCWSTR pszStr)
+        {
+            if (!pszStr) return E_POINTER;
+
+            HRESULT hr = ValueAddCheck();
+            if (FAILED(hr)) return hr;
+
+            PrefixMemberSeperator();
+            Put(StringStartToken);
+            AppendEscapeString(pszStr);
+            Put(StringEndToken);
+            m_bPropertyAppended = false;
+            return hr;
+        }
+
+        STDMETHODIMP FragmentValue(LPCSTR pszFragment)
+        {
+            if (!pszFragment) return E_POINTER;
+
+            HRESULT hr = ValueAddCheck();
+            if (FAILED(hr)) return hr;
+
+            PrefixMemberSeperator();
+            Put(pszFragment, strlen(pszFragment));
+            m_bPropertyAppended = false;
+            return hr;
+        }
+
+        STDMETHODIMP ObjectStart()
+        {
+            return StartScope(ObjectStartToken);
+        }
+
+        STDMETHODIMP ObjectEnd()
+        {
+            return EndScope(ObjectEndToken, '{', JSON_E_OBJECT_NOT_STARTED);
+        }
+
+        STDMETHODIMP ArrayStart()
+        {
+            return StartScope(ArrayStartToken);
+        }
+
+        STDMETHODIMP ArrayEnd()
+        {
+            return EndScope(ArrayEndToken, '[', JSON_E_ARRAY_NOT_STARTED);
+        }
+
+        STDMETHODIMP IntValue(__int64 iVal)
+        {
+            HRESULT hr = ValueAddCheck();
+            if (FAILED(hr)) return hr;
+
+            PrefixMemberSeperator();
+
+            bool isNegative = (iVal < 0);
+            unsigned __int64 magnitude = isNegative
+                ? static_cast<unsigned __int64>(-(iVal + 1)) + 1
+                : static_cast<unsigned __int64>(iVal);
+
+            PutUnsigned(magnitude, isNegative);
+            m_bPropertyAppended = false;
+            return hr;
+        }
+
+        STDMETHODIMP UIntValue(unsigned __int64 iVal)
+        {
+            HRESULT hr = ValueAddCheck();
+            if (FAILED(hr)) return hr;
+
+            PrefixMemberSeperator();
+            PutUnsigned(iVal, false);
+            m_bPropertyAppended = false;
+            return hr;
+        }
+
+        STDMETHODIMP NumberValue(double dblVal)
+        {
+            HRESULT hr = ValueAddCheck();
+            if (FAILED(hr)) return hr;
+
+            PrefixMemberSeperator();
+
+            // Keep the same formatting as JsonWriter for doubles
+            //
+            std::string result;
+            StringWriterA(result).Write(dblVal);
+            Put(result.c_str(), result.size());
+
+            m_bPropertyAppended = false;
+            return hr;
+        }
+
+        STDMETHODIMP BoolValue(bool bVal)
+        {
+            HRESULT hr = ValueAddCheck();
+            if (FAILED(hr)) return hr;
+
+            PrefixMemberSeperator();
+            if (bVal)
+            {
+                Put("true", 4);
+            }
+            else
+            {
+                Put("false", 5);
+            }
+
+            m_bPropertyAppended = false;
+            return hr;
+        }
+
+        STDMETHODIMP NullValue()
+        {
+            HRESULT hr = ValueAddCheck();
+            if (FAILED(hr)) return hr;
+
+            PrefixMemberSeperator();
+            Put("null", 4);
+            m_bPropertyAppended = false;
+            return hr;
+        }
+
+    private:
+
+        HRESULT StartScope(char token)
+        {
+            HRESULT hr = ValueAddCheck();
+            if (FAILED(hr)) return hr;
+
+            PrefixMemberSeperator();
+            m_bFirstValue = true;
+            if (m_stack.Push(token) != S_OK)
+            {
+                return JSON_E_MAX_NESTING_EXCEEDED;
+            }
+
+            Put(token);
+            m_bPropertyAppended = false;
+            return S_OK;
+        }
+
+        HRESULT EndScope(char token, WCHAR scope, HRESULT notStartedError)
+        {
+            if (m_stack.Peek() != scope)
+            {
+                return notStartedError;
+            }
+
+            WCHAR popped;
+            m_stack.Pop(&popped);
+
+            Put(token);
+            m_bPropertyAppended = false;
+            m_bFirstValue = false;
+            return S_OK;
+        }
+
+        HRESULT ValueAddCheck()
+        {
+            if (m_stack.IsEmpty())
+            {
+                return m_bFirstValue ? S_OK : JSON_E_PROPERTY_ARRAY_OR_OBJECT_NOT_STARTED;
+            }
+
+            if (m_stack.Peek() == '{' && !m_bPropertyAppended)
+            {
+                return JSON_E_MISSING_PROPERTY;
+            }
+
+            return S_OK;
+        }
+
+        void PrefixMemberSeperator()
+        {
+            if (!m_bFirstValue)
+            {
+                Put(MemberSeparatorToken);
+            }
+
+            m_bFirstValue = false;
+        }
+
+        void AppendEscapeString(LPCWSTR pszStr)
+        {
+            for (LPCWSTR pCh = pszStr; *pCh != L'\0'; ++pCh)
+            {
+                WCHAR c = *pCh;
+
+                // Fast path for the common case of printable ASCII that needs no escaping
+                //
+                if (c >= 0x20 && c < 0x7f && c != L'"' && c != L'\\' && c != L'/')
+                {
+                    Put(static_cast<char>(c));
+                    continue;
+                }
+
+                LPCSTR pszEscapedSequence = JsonWriter::GetEscapeSequence(c);
+                if (pszEscapedSequence != nullptr)
+                {
+                    Put(pszEscapedSequence, strlen(pszEscapedSequence));
+                }
+                else if (c <= 0x7f)
+                {
+                    Put(static_cast<char>(c));
+                }
+                else if (c <= 0x7ff)
+                {
+                    Put(static_cast<char>(0xc0 | (c >> 6)));
+                    Put(static_cast<char>(0x80 | (c & 0x3f)));
+                }
+                else
+                {
+                    Put(static_cast<char>(0xe0 | (c >> 12)));
+                    Put(static_cast<char>(0x80 | ((c >> 6) & 0x3f)));
+                    Put(static_cast<char>(0x80 | (c & 0x3f)));
+                }
+            }
+        }
+
+        void PutUnsigned(unsigned __int64 value, bool isNegative)
+        {
+            char buffer[24];
+            char * pEnd = buffer + sizeof(buffer);
+            char * pStart = pEnd;
+
+            do
+            {
+                *--pStart = static_cast<char>('0' + (value % 10));
+                value /= 10;
+            } while (value != 0);
+
+            if (isNegative)
+            {
+                *--pStart = '-';
+            }
+
+            Put(pStart, pEnd - pStart);
+        }
+
+        __forceinline void Put(char c)
+        {
+            if (cursor_ == end_)
+            {
+                this->StartNewChunk();
+            }
+
+            *cursor_++ = c;
+        }
+
+        void Put(char const * pData, size_t length)
+        {
+            while (length > 0)
+            {
+                if (cursor_ == end_)
+                {
+                    this->StartNewChunk();
+                }
+
+                size_t toCopy = std::min(length, static_cast<size_t>(end_ - cursor_));
+                memcpy(cursor_, pData, toCopy);
+                cursor_ += toCopy;
+                pData += toCopy;
+                length -= toCopy;
+            }
+        }
+
+        size_t GetCurrentChunkLength() const
+        {
+            return current_ ? static_cast<size_t>(cursor_ - reinterpret_cast<char*>(current_->data())) : 0;
+        }
+
+        void CompleteCurrentChunk()
+        {
+            if (!current_)
+            {
+                return;
+            }
+
+            size_t length = this->GetCurrentChunkLength();
+            if (length == 0)
+            {
+                return;
+            }
+
+            current_->resize(length);
+            totalBytes_ += length;
+
+            cursor_ = nullptr;
+            end_ = nullptr;
+
+            completedChunks_.push_back(std::move(current_));
+            current_.reset();
+        }
+
+        void StartNewChunk()
+        {
+            this->CompleteCurrentChunk();
+
+            if (!current_)
+            {
+                current_ = pool_.TakeChunk();
+            }
+
+            cursor_ = reinterpret_cast<char*>(current_->data());
+            end_ = cursor_ + current_->size();
+        }
+
+    private:
+        JsonChunkPool & pool_;
+        ByteBufferChunkList completedChunks_;
+        ByteBufferUPtr current_;
+        char * cursor_;
+        char * end_;
+        size_t totalBytes_;
+
+        bool m_bFirstValue;
+        bool m_bPropertyAppended;
+        JSONStack m_stack;
+    };
+}
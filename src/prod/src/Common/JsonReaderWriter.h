@@ -564,6 +564,66 @@ namespace Common
             return ErrorCode::Success();
         }
 
+        //
+        // Serialize directly into UTF-8 chunks taken from the given pool. The chunks should be returned
+        // to the pool by the caller once they are no longer needed.
+        //
+        template<typename T>
+        static ErrorCode SerializeChunked(
+            T &object,
+            __out ByteBufferChunkList &chunks,
+            JsonSerializerFlags serializerFlags = JsonSerializerFlags::Default,
+            JsonChunkPool &pool = JsonChunkPool::GetDefault())
+        {
+            JsonChunkedWriter jsonWriter(pool);
+            JsonWriterVisitor visitor(&jsonWriter, serializerFlags);
+
+            HRESULT hr = object.ToJson(visitor);
+            if (FAILED(hr))
+            {
+                return ErrorCodeValue::SerializationError;
+            }
+
+            hr = jsonWriter.TakeChunks(chunks);
+            if (FAILED(hr))
+            {
+                return ErrorCodeValue::SerializationError;
+            }
+
+            return ErrorCode::Success();
+        }
+
+        template<typename T>
+        static ErrorCode SerializeChunked(
+            std::vector<T> &objectArray,
+            __out ByteBufferChunkList &chunks,
+            JsonSerializerFlags serializerFlags = JsonSerializerFlags::Default,
+            JsonChunkPool &pool = JsonChunkPool::GetDefault())
+        {
+            JsonChunkedWriter jsonWriter(pool);
+            JsonWriterVisitor visitor(&jsonWriter, serializerFlags);
+            HRESULT hr;
+
+            jsonWriter.ArrayStart();
+            for (auto itr = objectArray.begin(); itr != objectArray.end(); ++itr)
+            {
+                hr = itr->ToJson(visitor);
+                if (FAILED(hr))
+                {
+                    return ErrorCodeValue::SerializationError;
+                }
+            }
+            jsonWriter.ArrayEnd();
+
+            hr = jsonWriter.TakeChunks(chunks);
+            if (FAILED(hr))
+            {
+                return ErrorCodeValue::SerializationError;
+            }
+
+            return ErrorCode::Success();
+        }
+
         template<typename T>
         static ErrorCode Serialize(T &object, __out_opt std::wstring &jsonString, JsonSerializerFlags serializerFlags = JsonSerializerFlags::Default)
         {
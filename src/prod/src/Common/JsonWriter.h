@@ -367,26 +367,6 @@ namespace Common
             return S_OK;
         }
 
-    private:
-
-        void PrefixMemberSeperator()
-        {
-            if(!m_bFirstValue)
-            {
-                m_strBuffer += MemberSeparatorToken;
-            }
-
-            m_bFirstValue = false;
-        }
-
-        template<typename T>
-        std::string ToString(T item)
-        {
-            std::string result;
-            Common::StringWriterA(result).Write(item);
-            return result;
-        }
-
         // All control characters from 00 to 1F should be escaped.
         // 
         // In https://www.ecma-international.org/publications/files/ECMA-ST/ECMA-404.pdf read the following para for more information
@@ -395,7 +375,9 @@ namespace Common
         // except for the code points that must be escaped: quotation mark (U+0022), reverse solidus (U+005C), and the control characters U+0000 to U+001F. 
         // There are two-character escape sequence representations of some characters."
         //
-        char* GetEscapeSequence(WCHAR inputChar)
+        // This is also used by JsonChunkedWriter so that both writers escape identically.
+        //
+        static char const * GetEscapeSequence(WCHAR inputChar)
         {
             switch (inputChar)
             {
@@ -474,6 +456,27 @@ namespace Common
             }
         }
 
+    private:
+
+        void PrefixMemberSeperator()
+        {
+            if(!m_bFirstValue)
+            {
+                m_strBuffer += MemberSeparatorToken;
+            }
+
+            m_bFirstValue = false;
+        }
+
+        template<typename T>
+        std::string ToString(T item)
+        {
+            std::string result;
+            Common::StringWriterA(result).Write(item);
+            return result;
+        }
+
+
         void AppendChar(WCHAR c)
         {
             // encode 0 with two bytes
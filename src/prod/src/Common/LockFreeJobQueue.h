@@ -0,0 +1,665 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Common
+{
+    //
+    // Variant of JobQueue<T, R> for queues with many concurrent producers.
+    //
+    // Enqueue does not take a lock:
+    //  - The pending item count, the active worker count and the closed flag are kept in a
+    //    single 64 bit word that is updated with compare-exchange. Reserving a queue slot and
+    //    claiming a worker thread is a single atomic operation.
+    //  - Items are pushed onto an intrusive lock-free stack.
+    //
+    // Workers move the stack into a deque and take a batch of items per wakeup under a lock
+    // that is only shared by the workers (never by producers). The deque end that the batch is taken
+    // from implements DequePolicy. Items enqueued while a batch is being processed are seen by the next batch.
+    //
+    // Throttling (SetThrottle, Resume and T::NeedThrottle) behaves as in JobQueue.
+    // Reserve/CancelReserve and async jobs are not supported.
+    //
+    template <typename T, typename R>
+    class LockFreeJobQueue
+    {
+        DENY_COPY(LockFreeJobQueue);
+
+    public:
+        static const int DefaultMaxBatchSize = 32;
+
+        LockFreeJobQueue(
+            std::wstring const & name,
+            R & root,
+            bool forceEnqueue = false,
+            int maxThreads = 0,
+            JobQueuePerfCountersSPtr perfCounters = nullptr,
+            uint64 maxQueueSize = UINT64_MAX,
+            DequePolicy dequePolicy = DequePolicy::FifoLifo,
+            int maxBatchSize = DefaultMaxBatchSize)
+            :   root_(root),
+                name_(name),
+                maxThreads_(maxThreads),
+                highestActiveThreads_(0),
+                completed_(0),
+                state_(0),
+                head_(nullptr),
+                forceEnqueue_(forceEnqueue),
+                throttled_(false),
+                perfCounters_(perfCounters),
+                maxQueueSize_(min(maxQueueSize, static_cast<uint64>(PendingMask))),
+                dequePolicy_(dequePolicy),
+                isFifo_(dequePolicy != DequePolicy::Lifo),
+                maxBatchSize_(max(maxBatchSize, 1)),
+                traceProcessingThreads_(false)
+        {
+            rootSPtr_ = CreateComponentRoot();
+
+            if (maxThreads_.load() == 0)
+            {
+                maxThreads_.store(Environment::GetNumberOfProcessors());
+            }
+
+            Trace.WriteInfo("JobQueue", name_, "Lock free queue created MaxThreads {0} MaxBatchSize {1}", maxThreads_.load(), maxBatchSize_);
+        }
+
+        virtual ~LockFreeJobQueue()
+        {
+            ASSERT_IF(GetActiveThreads(state_) != 0,
+                "{0} has {1} active thread during destruction",
+                name_, GetActiveThreads(state_));
+
+            auto node = static_cast<Node*>(head_);
+            while (node != nullptr)
+            {
+                auto next = node->Next;
+                delete node;
+                node = next;
+            }
+
+            Trace.WriteInfo("JobQueue", name_, "Queue destructed, highest threads={0}", highestActiveThreads_.load());
+        }
+
+        int GetMaxThreads()
+        {
+            return maxThreads_.load();
+        }
+
+        uint64 GetQueueLength()
+        {
+            return GetPending(state_);
+        }
+
+        uint64 GetActiveThreads()
+        {
+            return GetActiveThreads(state_);
+        }
+
+        uint GetCompleted()
+        {
+            return static_cast<uint>(completed_.load());
+        }
+
+        void SetTraceProcessingThreads(bool enable)
+        {
+            traceProcessingThreads_ = enable;
+        }
+
+        void Test_ResetHighestActiveThreads()
+        {
+            highestActiveThreads_.store(0);
+        }
+
+        void UpdateMaxThreads(int maxThreads)
+        {
+            Trace.WriteInfo(
+                "JobQueue",
+                name_,
+                "UpdateMaxThreads: old = {0} new = {1}",
+                maxThreads_.load(),
+                maxThreads);
+
+            maxThreads_.store(maxThreads);
+
+            TryScheduleThreads();
+        }
+
+        ComponentRootSPtr CreateComponentRoot()
+        {
+            __if_exists (R::CreateComponentRoot)
+            {
+                return root_.CreateComponentRoot();
+            }
+            __if_not_exists (R::CreateComponentRoot)
+            {
+                return root_.Root.CreateComponentRoot();
+            }
+        }
+
+        virtual void Close()
+        {
+            LONGLONG current = state_;
+            for (;;)
+            {
+                if (IsClosed(current))
+                {
+                    return;
+                }
+
+                auto prev = InterlockedCompareExchange64(&state_, current | ClosedFlag, current);
+                if (prev == current)
+                {
+                    break;
+                }
+
+                current = prev;
+            }
+
+            if (GetActiveThreads(current) == 0)
+            {
+                CompleteClose(L"Close()");
+            }
+            else
+            {
+                Trace.WriteInfo("JobQueue", name_, "Close called, {0} active threads, {1} queued items", GetActiveThreads(current), GetPending(current));
+            }
+        }
+
+        // Same as JobQueue::OnFinishItems
+        virtual void OnFinishItems()
+        {
+        }
+
+        bool IsThrottled() const
+        {
+            return throttled_.load();
+        }
+
+        void SetThrottle(bool enabled)
+        {
+            throttled_.store(enabled);
+
+            if (!enabled)
+            {
+                TryScheduleThreads();
+            }
+        }
+
+        bool Enqueue(T && item)
+        {
+            bool isQueueFull = false;
+            bool isRunnable = false;
+            uint64 queueSize = 0;
+
+            LONGLONG current = state_;
+            for (;;)
+            {
+                if (!forceEnqueue_ && IsClosed(current))
+                {
+                    return false;
+                }
+
+                queueSize = GetPending(current);
+                if (queueSize >= maxQueueSize_)
+                {
+                    isQueueFull = true;
+                    break;
+                }
+
+                isRunnable = !throttled_.load() && GetActiveThreads(current) < static_cast<uint64>(maxThreads_.load());
+
+                LONGLONG next = current + 1 + (isRunnable ? ActiveThreadIncrement : 0);
+                auto prev = InterlockedCompareExchange64(&state_, next, current);
+                if (prev == current)
+                {
+                    break;
+                }
+
+                current = prev;
+            }
+
+            if (isQueueFull)
+            {
+                if (dequePolicy_ == DequePolicy::FifoLifo)
+                {
+                    isFifo_.store(false);
+                }
+
+                if (perfCounters_)
+                {
+                    perfCounters_->NumberOfDroppedItems.Increment();
+                }
+
+                callOnQueueFull(item, static_cast<size_t>(queueSize));
+
+                return false;
+            }
+
+            Push(new Node(std::move(item)));
+
+            if (perfCounters_)
+            {
+                perfCounters_->NumberOfItems.Increment();
+                perfCounters_->NumberOfItemsInsertedPerSecond.Increment();
+            }
+
+            if (isRunnable)
+            {
+                UpdateHighestActiveThreads(GetActiveThreads(current) + 1);
+                ScheduleThread();
+            }
+
+            return true;
+        }
+
+        bool Resume()
+        {
+            T currentItem;
+            bool needThrottle = currentItem.NeedThrottle(root_);
+
+            Trace.WriteInfo("JobQueue", name_, "Resume, needThrottle={0}, throttled_={1}, size={2}", needThrottle, throttled_.load(), GetPending(state_));
+
+            if (!throttled_.load())
+            {
+                return false;
+            }
+
+            std::vector<T> batch;
+            bool fromFront;
+            TakeBatch(1, batch, fromFront);
+
+            if (batch.empty())
+            {
+                throttled_.store(false);
+                return false;
+            }
+
+            currentItem = std::move(batch.front());
+
+            // As in JobQueue, the queue is unthrottled before the item is processed but
+            // workers for the remaining items are only scheduled after it
+            if (!needThrottle)
+            {
+                throttled_.store(false);
+            }
+
+            bool isSync = JobTraits::ProcessJob(currentItem, root_);
+
+            if (!needThrottle)
+            {
+                TryScheduleThreads();
+            }
+
+            return !isSync;
+        }
+
+        __declspec (property(get=get_Name)) std::wstring const & Name;
+        std::wstring const & get_Name() { return name_; }
+
+        __declspec (property(get=get_HighestThreads)) int Test_HighestActiveThreads;
+        int get_HighestThreads() { return highestActiveThreads_.load(); }
+
+    protected:
+        R & root_;
+
+        void Process()
+        {
+            int crtThread = GetCurrentThreadId();
+
+            if (traceProcessingThreads_)
+            {
+                CommonEventSource::Events->JobQueueEnterProcess(name_, crtThread);
+            }
+
+            std::vector<T> batch;
+            batch.reserve(maxBatchSize_);
+
+            bool completeClose = false;
+            R & rootRef = root_;
+
+            for (;;)
+            {
+                bool fromFront = true;
+                if (!throttled_.load())
+                {
+                    TakeBatch(ComputeBatchSize(), batch, fromFront);
+                }
+
+                if (batch.empty())
+                {
+                    // A worker only exits when no items are pending. A producer that reserved a slot
+                    // after this check sees the decremented worker count and schedules a new thread.
+                    //
+                    bool isExiting = false;
+                    LONGLONG current = state_;
+                    for (;;)
+                    {
+                        if (GetPending(current) > 0 && !throttled_.load())
+                        {
+                            break;
+                        }
+
+                        LONGLONG next = current - ActiveThreadIncrement;
+                        auto prev = InterlockedCompareExchange64(&state_, next, current);
+                        if (prev == current)
+                        {
+                            isExiting = true;
+                            completeClose = (GetActiveThreads(next) == 0) && IsClosed(next);
+                            break;
+                        }
+
+                        current = prev;
+                    }
+
+                    if (isExiting)
+                    {
+                        break;
+                    }
+
+                    // The slot is reserved but the producer has not pushed the item yet
+                    //
+                    if (head_ == nullptr)
+                    {
+                        ::Sleep(0);
+                    }
+
+                    continue;
+                }
+
+                ProcessBatch(batch, fromFront, rootRef);
+                batch.clear();
+            }
+
+            // After the worker count is decremented no member may be accessed unless this thread
+            // completes the close as the queue could have been deallocated at any time.
+            //
+            if (completeClose)
+            {
+                CompleteClose(L"Process()");
+            }
+        }
+
+    private:
+        static const LONGLONG PendingMask = 0x00000000FFFFFFFFLL;
+        static const LONGLONG ActiveThreadIncrement = 0x0000000100000000LL;
+        static const LONGLONG ActiveThreadMask = 0x7FFFFFFF00000000LL;
+        static const LONGLONG ClosedFlag = static_cast<LONGLONG>(0x8000000000000000ULL);
+
+        static uint64 GetPending(LONGLONG state) { return static_cast<uint64>(state & PendingMask); }
+        static uint64 GetActiveThreads(LONGLONG state) { return static_cast<uint64>((state & ActiveThreadMask) >> 32); }
+        static bool IsClosed(LONGLONG state) { return (state & ClosedFlag) != 0; }
+
+        typedef JobQueueJobTraits<T, R> JobTraits;
+
+        struct Node
+        {
+            explicit Node(T && item) : Item(std::move(item)), Next(nullptr) { }
+
+            T Item;
+            Node * Next;
+        };
+
+        void Push(Node * node)
+        {
+            PVOID current = head_;
+            for (;;)
+            {
+                node->Next = static_cast<Node*>(current);
+                auto prev = InterlockedCompareExchangePointer(&head_, node, current);
+                if (prev == current)
+                {
+                    return;
+                }
+
+                current = prev;
+            }
+        }
+
+        // Moves everything pushed by producers to the back of the deque in the order it was enqueued
+        void MergePushedItemsCallerHoldsLock()
+        {
+            auto node = static_cast<Node*>(InterlockedExchangePointer(&head_, nullptr));
+
+            Node * reversed = nullptr;
+            while (node != nullptr)
+            {
+                auto next = node->Next;
+                node->Next = reversed;
+                reversed = node;
+                node = next;
+            }
+
+            while (reversed != nullptr)
+            {
+                auto next = reversed->Next;
+                items_.push_back(std::move(reversed->Item));
+                delete reversed;
+                reversed = next;
+            }
+        }
+
+        size_t ComputeBatchSize()
+        {
+            // Spread the pending items over the worker threads so that a single worker
+            // does not take all the items that other threads could be processing
+            auto threads = static_cast<uint64>(max(maxThreads_.load(), static_cast<LONG>(1)));
+            auto share = (GetPending(state_) + threads - 1) / threads;
+            return static_cast<size_t>(max(min(share, static_cast<uint64>(maxBatchSize_)), static_cast<uint64>(1)));
+        }
+
+        void TakeBatch(size_t count, __out std::vector<T> & batch, __out bool & fromFront)
+        {
+            AcquireExclusiveLock grab(consumerLock_);
+
+            MergePushedItemsCallerHoldsLock();
+
+            fromFront = isFifo_.load();
+            while (!items_.empty() && batch.size() < count)
+            {
+                if (fromFront)
+                {
+                    batch.push_back(std::move(items_.front()));
+                    items_.pop_front();
+                }
+                else
+                {
+                    batch.push_back(std::move(items_.back()));
+                    items_.pop_back();
+                }
+            }
+
+            if (!fromFront && dequePolicy_ == DequePolicy::FifoLifo && items_.empty())
+            {
+                isFifo_.store(true);
+            }
+
+            if (!batch.empty())
+            {
+                InterlockedExchangeAdd64(&state_, -static_cast<LONGLONG>(batch.size()));
+
+                if (perfCounters_) { perfCounters_->NumberOfItems.IncrementBy(-static_cast<LONGLONG>(batch.size())); }
+            }
+        }
+
+        // Returns the unprocessed part of a batch to the end of the deque that it was taken from
+        void ReturnBatch(std::vector<T> & batch, size_t startIndex, bool fromFront)
+        {
+            AcquireExclusiveLock grab(consumerLock_);
+
+            for (size_t ix = batch.size(); ix > startIndex; --ix)
+            {
+                if (fromFront)
+                {
+                    items_.push_front(std::move(batch[ix - 1]));
+                }
+                else
+                {
+                    items_.push_back(std::move(batch[ix - 1]));
+                }
+            }
+
+            auto count = static_cast<LONGLONG>(batch.size() - startIndex);
+            InterlockedExchangeAdd64(&state_, count);
+
+            if (perfCounters_) { perfCounters_->NumberOfItems.IncrementBy(count); }
+        }
+
+        void ProcessBatch(std::vector<T> & batch, bool fromFront, R & rootRef)
+        {
+            bool isPrevSync = true;
+
+            for (size_t ix = 0; ix < batch.size(); ++ix)
+            {
+                if (ix > 0 && throttled_.load() && !isPrevSync)
+                {
+                    ReturnBatch(batch, ix, fromFront);
+                    return;
+                }
+
+                auto & currentItem = batch[ix];
+
+                __if_exists(T::NeedThrottle)
+                {
+                    bool needThrottle = currentItem.NeedThrottle(root_);
+                    if (needThrottle != throttled_.load())
+                    {
+                        SetThrottle(needThrottle);
+                    }
+                }
+
+                if (perfCounters_)
+                {
+                    JobTraits::UpdatePerfCounter(currentItem, *perfCounters_);
+                }
+
+                isPrevSync = JobTraits::ProcessJob(currentItem, rootRef);
+
+                __if_exists(T::SynchronizedProcess)
+                {
+                    AcquireExclusiveLock grab(synchronizedProcessLock_);
+                    JobTraits::SynchronizedProcess(currentItem, rootRef);
+                }
+
+                ++completed_;
+
+                JobTraits::Close(currentItem, rootRef);
+            }
+        }
+
+        // Claims worker threads for pending items after throttling is disabled or the thread limit is raised
+        void TryScheduleThreads()
+        {
+            for (;;)
+            {
+                LONGLONG current = state_;
+                if (throttled_.load() ||
+                    GetPending(current) == 0 ||
+                    GetActiveThreads(current) >= static_cast<uint64>(maxThreads_.load()) ||
+                    (!forceEnqueue_ && IsClosed(current)))
+                {
+                    return;
+                }
+
+                if (InterlockedCompareExchange64(&state_, current + ActiveThreadIncrement, current) == current)
+                {
+                    UpdateHighestActiveThreads(GetActiveThreads(current) + 1);
+                    ScheduleThread();
+                }
+            }
+        }
+
+        void UpdateHighestActiveThreads(uint64 activeThreads)
+        {
+            LONG highest = highestActiveThreads_.load();
+            while (static_cast<LONG>(activeThreads) > highest)
+            {
+                if (highestActiveThreads_.compare_exchange_weak(highest, static_cast<LONG>(activeThreads)))
+                {
+                    return;
+                }
+            }
+        }
+
+        void ScheduleThread()
+        {
+            if (traceProcessingThreads_)
+            {
+                CommonEventSource::Events->JobQueueScheduleThread(name_);
+            }
+
+            auto root = CreateComponentRoot();
+            Threadpool::Post([this, root]
+            {
+                this->Process();
+            });
+        }
+
+        void CompleteClose(std::wstring const & caller)
+        {
+            Trace.WriteInfo("JobQueue", name_, "Root reset during {0}", caller);
+
+            // release the root after accessing all the member variables needed in this method as the
+            // release could result in the queue destruction
+            auto tempRoot = std::move(rootSPtr_);
+
+            if (!forceEnqueue_)
+            {
+                OnFinishItems();
+            }
+        }
+
+        // Same optional OnQueueFull dispatch as JobQueue
+        void callOnQueueFull(T & item, size_t queueSize)
+        {
+            callOnQueueFull(item, queueSize, 0);
+        }
+
+        template <typename TU>
+        auto callOnQueueFull(TU & item, size_t queueSize, int) -> decltype(item.OnQueueFull(root_, queueSize), void())
+        {
+            item.OnQueueFull(root_, queueSize);
+        }
+
+        template <typename TU>
+        auto callOnQueueFull(TU & item, size_t queueSize, char) -> decltype(item->OnQueueFull(root_, queueSize), void())
+        {
+            item->OnQueueFull(root_, queueSize);
+        }
+
+        template <typename TU>
+        auto callOnQueueFull(TU &, size_t, ...) -> decltype(void())
+        {
+        }
+
+        std::wstring name_;
+        ComponentRootSPtr rootSPtr_;
+        Common::atomic_long maxThreads_;
+        Common::atomic_long highestActiveThreads_;
+        Common::atomic_long completed_;
+
+        // Pending item count (low 32 bits), active worker threads (next 31 bits) and the closed flag (high bit)
+        LONGLONG volatile state_;
+
+        // Lock-free stack of items pushed by producers, most recent first
+        PVOID volatile head_;
+
+        // Items taken off the stack by workers. Only accessed under consumerLock_
+        ExclusiveLock consumerLock_;
+        std::deque<T> items_;
+
+        ExclusiveLock synchronizedProcessLock_;
+
+        bool forceEnqueue_;
+        Common::atomic_bool throttled_;
+        JobQueuePerfCountersSPtr perfCounters_;
+        uint64 maxQueueSize_;
+        DequePolicy dequePolicy_;
+        Common::atomic_bool isFifo_;
+        size_t maxBatchSize_;
+        // If enabled, traces processing threads. Disabled by default.
+        bool traceProcessingThreads_;
+    };
+}
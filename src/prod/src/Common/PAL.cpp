@@ -23,7 +23,6 @@
 #include <pwd.h>
 #include <netdb.h>
 #include <locale>
-#include <codecvt>
 #include <string>
 #include <sal.h>
 #include <palrt.h>
@@ -56,20 +55,16 @@ typedef enum _TimeConversionConstants
 
 static wstring utf8to16(const char *str)
 {
-    wstring_convert<codecvt_utf8_utf16<char16_t>, char16_t> conv;
-    u16string u16str = conv.from_bytes(str);
-    basic_string<wchar_t> result;
-    for(int index = 0; index < u16str.length(); index++)
-    {
-        result.push_back((wchar_t)u16str[index]);
-    }
+    wstring result;
+    Common::StringUtility::Utf8ToUtf16(str, strlen(str), result);
     return result;
 }
 
 static string utf16to8(const wchar_t *wstr)
 {
-    wstring_convert<codecvt_utf8_utf16<char16_t>, char16_t> conv;
-    return conv.to_bytes((const char16_t *) wstr);
+    string result;
+    Common::StringUtility::Utf16ToUtf8(wstr, char_traits<wchar_t>::length(wstr), result);
+    return result;
 }
 
 int _kbhit() {
@@ -4,6 +4,11 @@
 // ------------------------------------------------------------
 
 #include "stdafx.h"
+#include <sys/syscall.h>
+
+#ifndef __NR_pidfd_open
+#define __NR_pidfd_open 434
+#endif
 
 using namespace Common;
 using namespace std;
@@ -78,9 +83,27 @@ namespace Common
         static void AddWaiter(pid_t pid, AsyncOperationSPtr const & thisSPtr);
         static void RemoveWaiter(pid_t pid, AsyncOperationSPtr const & thisSPtr);
         static size_t TryCompleteWaiters();
+        static size_t TryCompleteWaiters(pid_t pid);
         static Global<map<pid_t, set<AsyncOperationSPtr>>> waiters_;
         static Global<ProcessExitCache> processExitCache_;
 
+        // Processes with waiters are either watched with a pidfd registered on an event loop,
+        // or checked on every SIGCHLD when pidfd is not available
+        struct PidFdWatch
+        {
+            int Fd;
+            EventLoop* Loop;
+            EventLoop::FdContext* Context;
+        };
+
+        static void StartWatching(pid_t pid);
+        static bool TryWatchPidFd(pid_t pid);
+        static void StopWatching(pid_t pid);
+        static void OnPidFdReadable(pid_t pid, int fd, uint events);
+        static Global<map<pid_t, PidFdWatch>> pidFdWatches_;
+        static Global<set<pid_t>> unwatchedPids_;
+        static bool pidFdUnsupported_;
+
         Handle handle_;
         pid_t pid_;
         ProcessWait::WaitCallback callback_;
@@ -104,6 +127,9 @@ namespace Common
     decltype(ProcessWaitImpl::waiters_) ProcessWaitImpl::waiters_ = make_global<map<pid_t, set<AsyncOperationSPtr>>>();
     Global<ProcessExitCache> ProcessWaitImpl::processExitCache_ = make_global<ProcessExitCache>();
     Global<RwLock> ProcessWaitImpl::Lock = make_global<RwLock>();
+    decltype(ProcessWaitImpl::pidFdWatches_) ProcessWaitImpl::pidFdWatches_ = make_global<map<pid_t, PidFdWatch>>();
+    decltype(ProcessWaitImpl::unwatchedPids_) ProcessWaitImpl::unwatchedPids_ = make_global<set<pid_t>>();
+    bool ProcessWaitImpl::pidFdUnsupported_ = false;
 }
 
 size_t ProcessExitCache::Test_Size() const
@@ -316,6 +342,8 @@ void ProcessWaitImpl::AddWaiter(pid_t pid, AsyncOperationSPtr const & thisSPtr)
     opSet.emplace(thisSPtr);
     waiters_->emplace(pid, move(opSet));
     WriteNoise(TraceType, "added {0} as waiter for process {1}, new waiter set", TextTracePtr(thisSPtr.get()), pid);
+
+    StartWatching(pid);
 }
 
 void ProcessWaitImpl::RemoveWaiter(pid_t pid, AsyncOperationSPtr const & thisSPtr)
@@ -332,6 +360,7 @@ void ProcessWaitImpl::RemoveWaiter(pid_t pid, AsyncOperationSPtr const & thisSPt
     if (iter->second.empty())
     {
         waiters_->erase(iter);
+        StopWatching(pid);
         WriteNoise(TraceType, "removed waiter set for process {0}", pid);
     }
     else
@@ -342,31 +371,144 @@ void ProcessWaitImpl::RemoveWaiter(pid_t pid, AsyncOperationSPtr const & thisSPt
 
 size_t ProcessWaitImpl::TryCompleteWaiters()
 {
-    // Need to go through all entries as there may be SIGCHLD loss
+    // Processes watched with a pidfd are reaped when their pidfd becomes readable.
+    // Need to go through all other entries as there may be SIGCHLD loss
     size_t completed = 0;
-    for(auto iter = waiters_->cbegin(); iter != waiters_->cend(); )
+    for(auto iter = unwatchedPids_->cbegin(); iter != unwatchedPids_->cend(); )
     {
-        int status = 0;
-        auto err = TryGetExitCode(iter->first, status);
-        if (!err)
-        {
-            for(auto & op : iter->second)
-            {
-                auto waiter = move(op);
-                AsyncOperation::Get<ProcessWaitImpl>(waiter)->TryCompleteAsync(waiter, status);
-                ++completed;
-            }
+        // TryCompleteWaiters(pid) removes pid from unwatchedPids_ on completion
+        pid_t pid = *iter;
+        ++iter;
 
-            iter = waiters_->erase(iter);
-            continue;
-        }
+        completed += TryCompleteWaiters(pid);
+    }
 
-        ++iter;
+    return completed;
+}
+
+size_t ProcessWaitImpl::TryCompleteWaiters(pid_t pid)
+{
+    auto iter = waiters_->find(pid);
+    if (iter == waiters_->cend())
+    {
+        return 0;
+    }
+
+    int status = 0;
+    auto err = TryGetExitCode(pid, status);
+    if (err)
+    {
+        return 0;
     }
 
+    size_t completed = 0;
+    for(auto & op : iter->second)
+    {
+        auto waiter = move(op);
+        AsyncOperation::Get<ProcessWaitImpl>(waiter)->TryCompleteAsync(waiter, status);
+        ++completed;
+    }
+
+    waiters_->erase(iter);
+    StopWatching(pid);
     return completed;
 }
 
+void ProcessWaitImpl::StartWatching(pid_t pid)
+{
+    if (!TryWatchPidFd(pid))
+    {
+        unwatchedPids_->emplace(pid);
+    }
+}
+
+bool ProcessWaitImpl::TryWatchPidFd(pid_t pid)
+{
+    if (pidFdUnsupported_ || !CommonConfig::GetConfig().ProcessWaitUsePidFd)
+    {
+        return false;
+    }
+
+    // pidfd_open always sets O_CLOEXEC
+    int fd = (int)syscall(__NR_pidfd_open, pid, 0);
+    if (fd < 0)
+    {
+        if (errno == ENOSYS)
+        {
+            WriteInfo(TraceType, "pidfd_open is not supported, fall back to SIGCHLD for all processes");
+            pidFdUnsupported_ = true;
+        }
+        else
+        {
+            WriteInfo(TraceType, "pidfd_open({0}) failed: errno = {1}", pid, errno);
+        }
+
+        return false;
+    }
+
+    // pidfd reports EPOLLIN once the process exits, unlike SIGCHLD such notification cannot be lost
+    auto & loop = EventLoopPool::GetDefault()->Assign();
+    auto context = loop.RegisterFd(
+        fd,
+        EPOLLIN,
+        true,
+        [pid] (int fd, uint events) { OnPidFdReadable(pid, fd, events); });
+
+    auto error = loop.Activate(context);
+    if (!error.IsSuccess())
+    {
+        WriteInfo(TraceType, "failed to activate pidfd of process {0}: {1}", pid, error);
+        loop.UnregisterFd(context, false);
+        close(fd);
+        return false;
+    }
+
+    PidFdWatch watch = { fd, &loop, context };
+    pidFdWatches_->emplace(pid, watch);
+    WriteNoise(TraceType, "watching process {0} with pidfd {1}", pid, fd);
+    return true;
+}
+
+void ProcessWaitImpl::StopWatching(pid_t pid)
+{
+    if (unwatchedPids_->erase(pid) > 0)
+    {
+        return;
+    }
+
+    auto iter = pidFdWatches_->find(pid);
+    if (iter == pidFdWatches_->end())
+    {
+        return;
+    }
+
+    // Called with *Lock held, possibly from the callback on this pidfd, so must not wait for callback
+    iter->second.Loop->UnregisterFd(iter->second.Context, false);
+    close(iter->second.Fd);
+    pidFdWatches_->erase(iter);
+}
+
+void ProcessWaitImpl::OnPidFdReadable(pid_t pid, int fd, uint events)
+{
+    WriteNoise(TraceType, "pidfd {0} of process {1} reported events {2:x}", fd, pid, events);
+
+    AcquireWriteLock grab(*Lock);
+
+    if (TryCompleteWaiters(pid) > 0)
+    {
+        return;
+    }
+
+    auto iter = pidFdWatches_->find(pid);
+    if (iter != pidFdWatches_->end() && iter->second.Fd == fd)
+    {
+        // The process could not be reaped through its pidfd, leave it to the SIGCHLD scan
+        WriteInfo(TraceType, "process {0} not reaped after pidfd notification, events = {1:x}", pid, events);
+        StopWatching(pid);
+        unwatchedPids_->emplace(pid);
+    }
+}
+
 void ProcessWaitImpl::SigChildHandler(int sig, siginfo_t *si, void*)
 {
     auto savedErrno = errno;
@@ -291,6 +291,61 @@ BOOST_AUTO_TEST_CASE(UtfConversion)
     BOOST_REQUIRE(utf16Output == utf16Input);
 }
 
+BOOST_AUTO_TEST_CASE(UtfConversionMultiByte)
+{
+    // Long enough to cross the vector block boundaries, with 2, 3 and 4 byte sequences in between
+    wstring utf16Input;
+    for (int i = 0; i < 20; ++i)
+    {
+        utf16Input.append(L"ascii run of some length ");
+        utf16Input.push_back(static_cast<wchar_t>(0x00E9));
+        utf16Input.push_back(static_cast<wchar_t>(0x4E2D));
+        utf16Input.push_back(static_cast<wchar_t>(0xD83D));
+        utf16Input.push_back(static_cast<wchar_t>(0xDE00));
+    }
+
+    string utf8Expected;
+    for (int i = 0; i < 20; ++i)
+    {
+        utf8Expected.append("ascii run of some length ");
+        utf8Expected.append("\xC3\xA9");
+        utf8Expected.append("\xE4\xB8\xAD");
+        utf8Expected.append("\xF0\x9F\x98\x80");
+    }
+
+    string utf8Output = StringUtility::Utf16ToUtf8(utf16Input);
+    VERIFY_IS_TRUE(utf8Output == utf8Expected);
+    VERIFY_IS_TRUE(StringUtility::Utf8ToUtf16(utf8Output) == utf16Input);
+
+    vector<char> utf8Buffer(StringUtility::MaxUtf8Length(utf16Input.size()));
+    auto length = StringUtility::Utf16ToUtf8(utf16Input.c_str(), utf16Input.size(), utf8Buffer.data(), utf8Buffer.size());
+    VERIFY_IS_TRUE(length == utf8Expected.size());
+    VERIFY_IS_TRUE(string(utf8Buffer.data(), length) == utf8Expected);
+
+    vector<wchar_t> utf16Buffer(StringUtility::MaxUtf16Length(utf8Expected.size()));
+    length = StringUtility::Utf8ToUtf16(utf8Expected.c_str(), utf8Expected.size(), utf16Buffer.data(), utf16Buffer.size());
+    VERIFY_IS_TRUE(length == utf16Input.size());
+    VERIFY_IS_TRUE(wstring(utf16Buffer.data(), length) == utf16Input);
+
+    // Too small a buffer fails instead of truncating
+    length = StringUtility::Utf16ToUtf8(utf16Input.c_str(), utf16Input.size(), utf8Buffer.data(), utf8Expected.size() - 1);
+    VERIFY_IS_TRUE(length == string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(UtfConversionMalformed)
+{
+    wstring loneSurrogate(L"abc");
+    loneSurrogate.push_back(static_cast<wchar_t>(0xDC00));
+    BOOST_REQUIRE_THROW(StringUtility::Utf16ToUtf8(loneSurrogate), range_error);
+
+    BOOST_REQUIRE_THROW(StringUtility::Utf8ToUtf16(string("abc\xC0\xAF")), range_error);      // overlong
+    BOOST_REQUIRE_THROW(StringUtility::Utf8ToUtf16(string("abc\xED\xA0\x80")), range_error);  // encoded surrogate
+    BOOST_REQUIRE_THROW(StringUtility::Utf8ToUtf16(string("abc\xE4\xB8")), range_error);      // truncated
+
+    wchar_t buffer[16];
+    VERIFY_IS_TRUE(StringUtility::Utf8ToUtf16("\xF4\x90\x80\x80", 4, buffer, 16) == string::npos);
+}
+
 BOOST_AUTO_TEST_CASE(CompareDigitsAsNumbers)
 {
     VERIFY_IS_TRUE(StringUtility::CompareDigitsAsNumbers((const wchar_t*)0, (const wchar_t*)L"ac") == -1);
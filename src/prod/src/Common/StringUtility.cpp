@@ -4,12 +4,415 @@
 // ------------------------------------------------------------
 
 #include "stdafx.h"
-#include <codecvt>
 #include <pdhmsg.h>
 #include <regex>
 
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define STRINGUTILITY_X64_KERNELS
+#endif
+
 using namespace std;
 
+namespace
+{
+    static_assert(sizeof(wchar_t) == sizeof(uint16), "UTF-16 transcoding requires a 16-bit wchar_t");
+
+    enum class TranscodeResult
+    {
+        Success,
+        BufferTooSmall,
+        Malformed
+    };
+
+    //
+    // The ASCII kernels convert the leading run of ASCII code units and return how many they converted.
+    // They only process whole blocks and leave the tail and everything after the first non-ASCII code
+    // unit to the scalar loops below.
+    //
+    typedef size_t (*AsciiUtf16ToUtf8Kernel)(uint16 const * src, size_t length, char * dst);
+    typedef size_t (*AsciiUtf8ToUtf16Kernel)(unsigned char const * src, size_t length, uint16 * dst);
+
+#if !defined(STRINGUTILITY_X64_KERNELS)
+    // Word at a time fallback for targets without vector kernels
+    size_t AsciiUtf16ToUtf8Scalar(uint16 const * src, size_t length, char * dst)
+    {
+        size_t i = 0;
+        for (; i + 4 <= length; i += 4)
+        {
+            uint64 block;
+            memcpy(&block, src + i, sizeof(block));
+            if ((block & 0xFF80FF80FF80FF80ull) != 0)
+            {
+                break;
+            }
+
+            dst[i] = static_cast<char>(src[i]);
+            dst[i + 1] = static_cast<char>(src[i + 1]);
+            dst[i + 2] = static_cast<char>(src[i + 2]);
+            dst[i + 3] = static_cast<char>(src[i + 3]);
+        }
+
+        return i;
+    }
+
+    size_t AsciiUtf8ToUtf16Scalar(unsigned char const * src, size_t length, uint16 * dst)
+    {
+        size_t i = 0;
+        for (; i + 8 <= length; i += 8)
+        {
+            uint64 block;
+            memcpy(&block, src + i, sizeof(block));
+            if ((block & 0x8080808080808080ull) != 0)
+            {
+                break;
+            }
+
+            for (size_t j = 0; j < 8; ++j)
+            {
+                dst[i + j] = src[i + j];
+            }
+        }
+
+        return i;
+    }
+
+#else
+    // SSE2 is part of the x64 baseline, so these need no dispatch
+    size_t AsciiUtf16ToUtf8Sse2(uint16 const * src, size_t length, char * dst)
+    {
+        __m128i const nonAsciiMask = _mm_set1_epi16(static_cast<short>(0xFF80));
+
+        size_t i = 0;
+        for (; i + 16 <= length; i += 16)
+        {
+            __m128i low = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i));
+            __m128i high = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i + 8));
+            __m128i nonAscii = _mm_and_si128(_mm_or_si128(low, high), nonAsciiMask);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(nonAscii, _mm_setzero_si128())) != 0xFFFF)
+            {
+                break;
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(low, high));
+        }
+
+        return i;
+    }
+
+    size_t AsciiUtf8ToUtf16Sse2(unsigned char const * src, size_t length, uint16 * dst)
+    {
+        __m128i const zero = _mm_setzero_si128();
+
+        size_t i = 0;
+        for (; i + 16 <= length; i += 16)
+        {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i));
+            if (_mm_movemask_epi8(bytes) != 0)
+            {
+                break;
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_unpacklo_epi8(bytes, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 8), _mm_unpackhi_epi8(bytes, zero));
+        }
+
+        return i;
+    }
+
+#if defined(__GNUC__)
+    __attribute__((target("avx2")))
+    size_t AsciiUtf16ToUtf8Avx2(uint16 const * src, size_t length, char * dst)
+    {
+        __m256i const nonAsciiMask = _mm256_set1_epi16(static_cast<short>(0xFF80));
+
+        size_t i = 0;
+        for (; i + 32 <= length; i += 32)
+        {
+            __m256i low = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + i));
+            __m256i high = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + i + 16));
+            if (!_mm256_testz_si256(_mm256_or_si256(low, high), nonAsciiMask))
+            {
+                break;
+            }
+
+            // packus works per 128-bit lane, so restore the order of the 64-bit quarters
+            __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(low, high), 0xD8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), packed);
+        }
+
+        return i + AsciiUtf16ToUtf8Sse2(src + i, length - i, dst + i);
+    }
+
+    __attribute__((target("avx2")))
+    size_t AsciiUtf8ToUtf16Avx2(unsigned char const * src, size_t length, uint16 * dst)
+    {
+        size_t i = 0;
+        for (; i + 32 <= length; i += 32)
+        {
+            __m256i bytes = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + i));
+            if (_mm256_movemask_epi8(bytes) != 0)
+            {
+                break;
+            }
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(bytes)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(bytes, 1)));
+        }
+
+        return i + AsciiUtf8ToUtf16Sse2(src + i, length - i, dst + i);
+    }
+#endif
+#endif
+
+    struct AsciiKernels
+    {
+        AsciiUtf16ToUtf8Kernel Utf16ToUtf8;
+        AsciiUtf8ToUtf16Kernel Utf8ToUtf16;
+    };
+
+    AsciiKernels SelectAsciiKernels()
+    {
+#if defined(STRINGUTILITY_X64_KERNELS)
+#if defined(__GNUC__)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return AsciiKernels { AsciiUtf16ToUtf8Avx2, AsciiUtf8ToUtf16Avx2 };
+        }
+#endif
+        return AsciiKernels { AsciiUtf16ToUtf8Sse2, AsciiUtf8ToUtf16Sse2 };
+#else
+        return AsciiKernels { AsciiUtf16ToUtf8Scalar, AsciiUtf8ToUtf16Scalar };
+#endif
+    }
+
+    AsciiKernels const & GetAsciiKernels()
+    {
+        static AsciiKernels const kernels = SelectAsciiKernels();
+        return kernels;
+    }
+
+    //
+    // Both transcoders stop at the first code point that is malformed or does not fit, and report
+    // how far they got so that the caller can grow the buffer and resume.
+    //
+    TranscodeResult TranscodeUtf16ToUtf8(
+        wchar_t const * utf16,
+        size_t length,
+        char * dst,
+        size_t capacity,
+        __out size_t & read,
+        __out size_t & written)
+    {
+        auto src = reinterpret_cast<uint16 const *>(utf16);
+        auto asciiKernel = GetAsciiKernels().Utf16ToUtf8;
+        auto result = TranscodeResult::Success;
+
+        size_t i = 0;
+        size_t o = 0;
+        while (i < length)
+        {
+            uint32 codePoint = src[i];
+            if (codePoint < 0x80)
+            {
+                size_t run = asciiKernel(src + i, min(length - i, capacity - o), dst + o);
+                i += run;
+                o += run;
+
+                for (; i < length && src[i] < 0x80 && o < capacity; ++i, ++o)
+                {
+                    dst[o] = static_cast<char>(src[i]);
+                }
+
+                if (i < length && src[i] < 0x80)
+                {
+                    result = TranscodeResult::BufferTooSmall;
+                    break;
+                }
+
+                continue;
+            }
+
+            size_t unitCount = 1;
+            size_t byteCount;
+            if (codePoint < 0x800)
+            {
+                byteCount = 2;
+            }
+            else if (codePoint < 0xD800 || codePoint > 0xDFFF)
+            {
+                byteCount = 3;
+            }
+            else if (codePoint <= 0xDBFF && i + 1 < length && src[i + 1] >= 0xDC00 && src[i + 1] <= 0xDFFF)
+            {
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (src[i + 1] - 0xDC00);
+                unitCount = 2;
+                byteCount = 4;
+            }
+            else
+            {
+                result = TranscodeResult::Malformed;
+                break;
+            }
+
+            if (capacity - o < byteCount)
+            {
+                result = TranscodeResult::BufferTooSmall;
+                break;
+            }
+
+            switch (byteCount)
+            {
+            case 2:
+                dst[o] = static_cast<char>(0xC0 | (codePoint >> 6));
+                dst[o + 1] = static_cast<char>(0x80 | (codePoint & 0x3F));
+                break;
+            case 3:
+                dst[o] = static_cast<char>(0xE0 | (codePoint >> 12));
+                dst[o + 1] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                dst[o + 2] = static_cast<char>(0x80 | (codePoint & 0x3F));
+                break;
+            default:
+                dst[o] = static_cast<char>(0xF0 | (codePoint >> 18));
+                dst[o + 1] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                dst[o + 2] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                dst[o + 3] = static_cast<char>(0x80 | (codePoint & 0x3F));
+                break;
+            }
+
+            i += unitCount;
+            o += byteCount;
+        }
+
+        read = i;
+        written = o;
+        return result;
+    }
+
+    // Decodes one multi-byte sequence, rejecting overlong forms, surrogates and values past U+10FFFF
+    bool TryDecodeUtf8Sequence(unsigned char const * src, size_t length, __out uint32 & codePoint, __out size_t & byteCount)
+    {
+        unsigned char lead = src[0];
+        unsigned char secondMin = 0x80;
+        unsigned char secondMax = 0xBF;
+
+        if (lead >= 0xC2 && lead <= 0xDF)
+        {
+            byteCount = 2;
+            codePoint = lead & 0x1F;
+        }
+        else if (lead >= 0xE0 && lead <= 0xEF)
+        {
+            byteCount = 3;
+            codePoint = lead & 0x0F;
+            if (lead == 0xE0) { secondMin = 0xA0; }
+            if (lead == 0xED) { secondMax = 0x9F; }
+        }
+        else if (lead >= 0xF0 && lead <= 0xF4)
+        {
+            byteCount = 4;
+            codePoint = lead & 0x07;
+            if (lead == 0xF0) { secondMin = 0x90; }
+            if (lead == 0xF4) { secondMax = 0x8F; }
+        }
+        else
+        {
+            return false;
+        }
+
+        if (length < byteCount || src[1] < secondMin || src[1] > secondMax)
+        {
+            return false;
+        }
+
+        codePoint = (codePoint << 6) | (src[1] & 0x3F);
+        for (size_t k = 2; k < byteCount; ++k)
+        {
+            if ((src[k] & 0xC0) != 0x80)
+            {
+                return false;
+            }
+
+            codePoint = (codePoint << 6) | (src[k] & 0x3F);
+        }
+
+        return true;
+    }
+
+    TranscodeResult TranscodeUtf8ToUtf16(
+        char const * utf8,
+        size_t length,
+        wchar_t * utf16,
+        size_t capacity,
+        __out size_t & read,
+        __out size_t & written)
+    {
+        auto src = reinterpret_cast<unsigned char const *>(utf8);
+        auto dst = reinterpret_cast<uint16 *>(utf16);
+        auto asciiKernel = GetAsciiKernels().Utf8ToUtf16;
+        auto result = TranscodeResult::Success;
+
+        size_t i = 0;
+        size_t o = 0;
+        while (i < length)
+        {
+            if (src[i] < 0x80)
+            {
+                size_t run = asciiKernel(src + i, min(length - i, capacity - o), dst + o);
+                i += run;
+                o += run;
+
+                for (; i < length && src[i] < 0x80 && o < capacity; ++i, ++o)
+                {
+                    dst[o] = src[i];
+                }
+
+                if (i < length && src[i] < 0x80)
+                {
+                    result = TranscodeResult::BufferTooSmall;
+                    break;
+                }
+
+                continue;
+            }
+
+            uint32 codePoint;
+            size_t byteCount;
+            if (!TryDecodeUtf8Sequence(src + i, length - i, codePoint, byteCount))
+            {
+                result = TranscodeResult::Malformed;
+                break;
+            }
+
+            size_t unitCount = (codePoint >= 0x10000) ? 2 : 1;
+            if (capacity - o < unitCount)
+            {
+                result = TranscodeResult::BufferTooSmall;
+                break;
+            }
+
+            if (unitCount == 1)
+            {
+                dst[o] = static_cast<uint16>(codePoint);
+            }
+            else
+            {
+                codePoint -= 0x10000;
+                dst[o] = static_cast<uint16>(0xD800 | (codePoint >> 10));
+                dst[o + 1] = static_cast<uint16>(0xDC00 | (codePoint & 0x3FF));
+            }
+
+            i += byteCount;
+            o += unitCount;
+        }
+
+        read = i;
+        written = o;
+        return result;
+    }
+}
+
 namespace Common
 {
     void StringUtility::ToUpper(string & str)
@@ -72,13 +475,7 @@ namespace Common
 
     void StringUtility::Utf16ToUtf8(std::wstring const & utf16String, std::string & utf8String)
     {
-#ifdef PLATFORM_UNIX
-        wstring_convert<codecvt_utf8_utf16<char16_t>, char16_t> convertor;
-        utf8String = convertor.to_bytes((const char16_t *)utf16String.c_str());
-#else
-        wstring_convert<codecvt_utf8_utf16<unsigned short>, unsigned short> convertor;
-        utf8String = convertor.to_bytes((const unsigned short *)utf16String.c_str());
-#endif
+        Utf16ToUtf8(utf16String.c_str(), utf16String.size(), utf8String);
     }
 
     string StringUtility::Utf16ToUtf8(std::wstring const & utf16String)
@@ -90,16 +487,7 @@ namespace Common
 
     void StringUtility::Utf8ToUtf16(std::string const & utf8String, std::wstring & utf16String)
     {
-#ifdef PLATFORM_UNIX
-        wstring_convert<codecvt_utf8_utf16<char16_t>, char16_t> convertor;
-#else
-        wstring_convert<codecvt_utf8_utf16<unsigned short>, unsigned short> convertor;
-#endif
-        utf16String.clear();
-        for (auto const & ch : convertor.from_bytes(utf8String))
-        {
-            utf16String.push_back(ch);
-        }
+        Utf8ToUtf16(utf8String.c_str(), utf8String.size(), utf16String);
     }
 
     wstring StringUtility::Utf8ToUtf16(std::string const & utf8String)
@@ -109,6 +497,68 @@ namespace Common
         return utf16String;
     }
 
+    void StringUtility::Utf16ToUtf8(wchar_t const * utf16, size_t utf16Length, std::string & utf8String)
+    {
+        //
+        // Size for ASCII first, which is exact for most strings, and grow once to the worst case
+        // for the rest when a multi-byte sequence does not fit.
+        //
+        utf8String.resize(utf16Length);
+
+        size_t read = 0;
+        size_t written = 0;
+        auto result = TranscodeUtf16ToUtf8(utf16, utf16Length, &utf8String[0], utf8String.size(), read, written);
+        if (result == TranscodeResult::BufferTooSmall)
+        {
+            utf8String.resize(written + MaxUtf8Length(utf16Length - read));
+
+            size_t tailRead = 0;
+            size_t tailWritten = 0;
+            result = TranscodeUtf16ToUtf8(utf16 + read, utf16Length - read, &utf8String[written], utf8String.size() - written, tailRead, tailWritten);
+            written += tailWritten;
+        }
+
+        if (result != TranscodeResult::Success)
+        {
+            utf8String.clear();
+            throw range_error("Utf16ToUtf8: malformed UTF-16 input");
+        }
+
+        utf8String.resize(written);
+    }
+
+    void StringUtility::Utf8ToUtf16(char const * utf8, size_t utf8Length, std::wstring & utf16String)
+    {
+        utf16String.resize(MaxUtf16Length(utf8Length));
+
+        size_t read = 0;
+        size_t written = 0;
+        auto result = TranscodeUtf8ToUtf16(utf8, utf8Length, &utf16String[0], utf16String.size(), read, written);
+        if (result != TranscodeResult::Success)
+        {
+            utf16String.clear();
+            throw range_error("Utf8ToUtf16: malformed UTF-8 input");
+        }
+
+        utf16String.resize(written);
+    }
+
+    size_t StringUtility::Utf16ToUtf8(wchar_t const * utf16, size_t utf16Length, char * utf8Buffer, size_t utf8BufferLength)
+    {
+        size_t read = 0;
+        size_t written = 0;
+        auto result = TranscodeUtf16ToUtf8(utf16, utf16Length, utf8Buffer, utf8BufferLength, read, written);
+        return (result == TranscodeResult::Success) ? written : string::npos;
+    }
+
+    size_t StringUtility::Utf8ToUtf16(char const * utf8, size_t utf8Length, wchar_t * utf16Buffer, size_t utf16BufferLength)
+    {
+        size_t read = 0;
+        size_t written = 0;
+        auto result = TranscodeUtf8ToUtf16(utf8, utf8Length, utf16Buffer, utf16BufferLength, read, written);
+        return (result == TranscodeResult::Success) ? written : string::npos;
+    }
+
     void StringUtility::UnicodeToAnsi(std::wstring const &uniString, std::string &dst)
     {
         wchar_t const *str = uniString.c_str();
@@ -377,11 +377,24 @@ namespace Common
 
         static void TrimWhitespaces(std::string & str);
 
-        // Converts a wstring to a string
+        // Converts a wstring to a string. Malformed input throws std::range_error.
         static void Utf16ToUtf8(std::wstring const & utf16String, std::string & utf8String);
         static void Utf8ToUtf16(std::string const & utf8String, std::wstring & utf16String);
         static std::string Utf16ToUtf8(std::wstring const & utf16String);
         static std::wstring Utf8ToUtf16(std::string const & utf8String);
+        static void Utf16ToUtf8(__in_ecount(utf16Length) wchar_t const * utf16, size_t utf16Length, std::string & utf8String);
+        static void Utf8ToUtf16(__in_ecount(utf8Length) char const * utf8, size_t utf8Length, std::wstring & utf16String);
+
+        //
+        // Transcodes into a caller supplied buffer without allocating. Returns the number of code units
+        // written, or std::string::npos if the input is malformed or the buffer is too small. A buffer of
+        // MaxUtf8Length/MaxUtf16Length code units is always large enough.
+        //
+        static size_t Utf16ToUtf8(__in_ecount(utf16Length) wchar_t const * utf16, size_t utf16Length, __out_ecount(utf8BufferLength) char * utf8Buffer, size_t utf8BufferLength);
+        static size_t Utf8ToUtf16(__in_ecount(utf8Length) char const * utf8, size_t utf8Length, __out_ecount(utf16BufferLength) wchar_t * utf16Buffer, size_t utf16BufferLength);
+        static size_t MaxUtf8Length(size_t utf16Length) { return utf16Length * 3; }
+        static size_t MaxUtf16Length(size_t utf8Length) { return utf8Length; }
+
         static void UnicodeToAnsi(std::wstring const &uniString, std::string &dst);
 
         // -----------------------------------------------------
@@ -4,24 +4,23 @@
 // ------------------------------------------------------------
 
 #include "stdafx.h"
-#include <codecvt>
 #include <algorithm>
 
 using namespace std;
 using namespace Common;
 
-// UTF-8 to UTF-16 Conversion. TODO: wchar_t seems still 4-bytes in to_bytes()
 static wstring utf8to16(const char *str)
 {
-    wstring_convert<codecvt_utf8_utf16<char16_t>, char16_t> conv;
-    u16string u16str = conv.from_bytes(str);
-    return wstring((wchar_t *) u16str.c_str());
+    wstring result;
+    StringUtility::Utf8ToUtf16(str, strlen(str), result);
+    return result;
 }
 
 static string utf16to8(const wchar_t *wstr)
 {
-    wstring_convert<codecvt_utf8_utf16<char16_t>, char16_t> conv;
-    return conv.to_bytes((const char16_t *) wstr);
+    string result;
+    StringUtility::Utf16ToUtf8(wstr, char_traits<wchar_t>::length(wstr), result);
+    return result;
 }
 
 static HRESULT xmlResultConv(int xmlResult)
@@ -4,7 +4,6 @@
 // ------------------------------------------------------------
 
 #pragma once
-#include <codecvt>
 #include <pdhmsg.h>
 #include <regex>
 
@@ -16,11 +15,8 @@ inline static boost::unit_test::const_string BoostTaef_UnicodeToAnsi(WCHAR const
 {
     if (ws == nullptr) return boost::unit_test::const_string();
 
-#ifdef PLATFORM_UNIX
-    std::string ansiString = std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>().to_bytes((const char16_t*)ws);
-#else
-    std::string ansiString = std::wstring_convert<std::codecvt_utf8_utf16<unsigned short>, unsigned short>().to_bytes((const unsigned short*)ws);
-#endif
+    std::string ansiString;
+    Common::StringUtility::Utf16ToUtf8(ws, std::char_traits<wchar_t>::length(ws), ansiString);
     auto tid = ::GetCurrentThreadId();
 
     Common::AcquireWriteLock grab(boostTaefBuffersLock);
@@ -82,6 +82,11 @@ namespace Federation
         INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"Federation", ConnectionIdleTimeout, Common::TimeSpan::FromMinutes(15), Common::ConfigEntryUpgradePolicy::Static);
         // Default timeout for routing layer retry.
         INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"Federation", RoutingRetryTimeout, Common::TimeSpan::FromSeconds(5), Common::ConfigEntryUpgradePolicy::Static);
+        // The number of token ranges whose owner is remembered from routed request replies, so that later
+        // routed messages can be sent to the owner directly. Set to 0 to always route hop by hop.
+        INTERNAL_CONFIG_ENTRY(int, L"Federation", RoutingTokenOwnerCacheCapacity, 256, Common::ConfigEntryUpgradePolicy::Static, Common::NoLessThan(0));
+        // How long a remembered token owner is used before routing hop by hop again.
+        INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"Federation", RoutingTokenOwnerCacheEntryTimeToLive, Common::TimeSpan::FromSeconds(60), Common::ConfigEntryUpgradePolicy::Static);
         // The wait interval to send LivenessUpdate message when there are pending incoming requests.
         INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"Federation", LivenessUpdateInterval, Common::TimeSpan::FromSeconds(3), Common::ConfigEntryUpgradePolicy::Static);
         // This is deprecated because message size checking is disabled for peer-to-peer mode.
@@ -13,14 +13,21 @@ namespace Federation
 
     public:
         NodeRingBase()
+            : version_(0)
         {
         }
 
         NodeRingBase(NodeRingBase && other)
-            : ring_(std::move(other.ring_))
+            : ring_(std::move(other.ring_)), version_(other.version_)
         {
         }
 
+        /// <summary>
+        /// Return the number of changes made to the membership of the ring
+        /// </summary>
+        __declspec (property(get=getVersion)) uint64 Version;
+        uint64 getVersion() const { return version_; }
+
         /// <summary>
         /// Return the size of the ring
         /// </summary>
@@ -100,6 +107,11 @@ namespace Federation
         /// </summary>
         virtual void Clear();
 
+        /// <summary>
+        /// Replace the nodes in this ring with the nodes of another ring.
+        /// </summary>
+        void CopyFrom(NodeRingBase const & other);
+
         void WriteTo(Common::TextWriter&, Common::FormatOptions const &) const;
 
     protected:
@@ -130,6 +142,11 @@ namespace Federation
         /// The ring data structure
         /// </summary>
         std::vector<PartnerNodeSPtr> ring_;
+
+        /// <summary>
+        /// Incremented whenever a node is added, removed or replaced
+        /// </summary>
+        uint64 version_;
     };
 
     /// <summary>
@@ -61,6 +61,16 @@ namespace Federation
             return;
         }
 
+        // Retries take the hop by hop path in case the cached owner is stale
+        if (!ownsToken && retryCount_ == 0)
+        {
+            auto owner = siteNode_->GetRoutingManager().GetCachedTokenOwner(this->nodeId_, header_.ToRing);
+            if (owner)
+            {
+                to = move(owner);
+            }
+        }
+
         TimeSpan remainingTime = this->timeoutHelper_.GetRemainingTime();
         if (remainingTime <= TimeSpan::Zero)
         {
@@ -227,6 +237,15 @@ namespace Federation
         if (error.IsSuccess())
         {
             hopTo->OnReceive(false);
+
+            if (header_.ExpectsReply && reply_)
+            {
+                siteNode_->GetRoutingManager().OnRoutedRequestReply(this->nodeId_, header_.ToRing, *reply_);
+            }
+        }
+        else
+        {
+            siteNode_->GetRoutingManager().InvalidateTokenOwner(this->nodeId_);
         }
 
         if (!error.IsSuccess() && RoutingManager::IsRetryable(error, message_->Idempotent) && CanRetry())
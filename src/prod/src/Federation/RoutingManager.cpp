@@ -20,7 +20,10 @@ StringLiteral const TraceIgnore("Ignore");
 StringLiteral const TraceExpire("Expire");
 
 RoutingManager::RoutingManager(__in SiteNode & siteNode)
-    : siteNode_(siteNode)
+    : siteNode_(siteNode),
+    tokenOwnerCache_(
+        static_cast<size_t>(FederationConfig::GetConfig().RoutingTokenOwnerCacheCapacity),
+        FederationConfig::GetConfig().RoutingTokenOwnerCacheEntryTimeToLive)
 {
 }
 
@@ -721,6 +724,75 @@ void RoutingManager::ProcessRoutedMessageHoldingList()
 void RoutingManager::Stop()
 {
     this->ClearRoutedMessageHoldingList();
+    this->tokenOwnerCache_.Clear();
+}
+
+PartnerNodeSPtr RoutingManager::GetCachedTokenOwner(NodeId nodeId, wstring const & toRing)
+{
+    if (!this->siteNode_.IsRingNameMatched(toRing))
+    {
+        return nullptr;
+    }
+
+    NodeInstance owner;
+    if (!this->tokenOwnerCache_.TryGet(nodeId, owner))
+    {
+        return nullptr;
+    }
+
+    auto partner = this->siteNode_.Table.Get(owner, toRing);
+    if (!partner || partner->Instance != owner || !partner->IsRouting || partner->Instance.Match(this->siteNode_.Instance))
+    {
+        WriteInfo(
+            TraceState,
+            "{0} dropping cached token owner {1} for {2}: {3}",
+            this->siteNode_.Id,
+            owner,
+            nodeId,
+            partner ? partner->Phase : NodePhase::Shutdown);
+
+        this->tokenOwnerCache_.Invalidate(nodeId);
+        return nullptr;
+    }
+
+    return partner;
+}
+
+// The reply to a routed request is sent directly by the node that owned the token for the target
+void RoutingManager::OnRoutedRequestReply(NodeId nodeId, wstring const & toRing, __in Message & reply)
+{
+    NodeInstance owner;
+    if (!this->siteNode_.IsRingNameMatched(toRing) || !PointToPointManager::GetFromInstance(reply, owner) || owner.Match(this->siteNode_.Instance))
+    {
+        return;
+    }
+
+    // Remember the whole token of the owner when it is known, otherwise only the target
+    auto partner = this->siteNode_.Table.Get(owner, toRing);
+    NodeIdRange range = (partner && partner->Instance == owner && partner->Token.Range.Contains(nodeId))
+        ? partner->Token.Range
+        : NodeIdRange(nodeId, nodeId);
+
+    WriteNoise(
+        TraceState,
+        "{0} caching token owner {1} for {2}, range {3}",
+        this->siteNode_.Id,
+        owner,
+        nodeId,
+        range);
+
+    this->tokenOwnerCache_.Add(range, owner);
+}
+
+void RoutingManager::InvalidateTokenOwner(NodeId nodeId)
+{
+    this->tokenOwnerCache_.Invalidate(nodeId);
+}
+
+void RoutingManager::OnTokenOrNeighborhoodChanged()
+{
+    this->tokenOwnerCache_.Clear();
+    this->ProcessRoutedMessageHoldingList();
 }
 
 void RoutingManager::RoutingContext::UpdateRoutingHeader()
@@ -62,6 +62,15 @@ namespace Federation
 
         static bool IsRetryable(Common::ErrorCode error, bool isIdempotent);
 
+        // Returns the node that recently owned the token for nodeId when it is still routing, or null
+        PartnerNodeSPtr GetCachedTokenOwner(NodeId nodeId, std::wstring const & toRing);
+
+        void OnRoutedRequestReply(NodeId nodeId, std::wstring const & toRing, __in Transport::Message & reply);
+
+        void InvalidateTokenOwner(NodeId nodeId);
+
+        void OnTokenOrNeighborhoodChanged();
+
     private:
         struct RoutingContext;
         typedef std::unique_ptr<RoutingContext> RoutingContextUPtr;
@@ -71,6 +80,7 @@ namespace Federation
         std::list<RoutingContextUPtr> routedMessageHoldingList_;
         Common::ExclusiveLock routedMessageProcessingSetLock_;
         std::set<Transport::MessageId> routedMessageProcessingSet_; // TODO: refactor into a common threadsafe set
+        RoutingTokenOwnerCache tokenOwnerCache_;
 
         RoutingHeader GetRoutingHeader(
             __in Transport::Message & message,
@@ -512,7 +512,7 @@ namespace FederationUnitTests
         NodeId node140(LargeInteger(0, 140));
         NodeId node150(LargeInteger(0, 150));
 
-		sitePtr->Test_SetToken(RoutingToken(NodeIdRange(LargeInteger(0, 96), LargeInteger(0, 105)), 1));
+		table.Test_SetToken(RoutingToken(NodeIdRange(LargeInteger(0, 96), LargeInteger(0, 105)), 1));
 
         // Check a routing hop arriving at the current node
         node = table.GetRoutingHop(NodeId(LargeInteger(0, 100)), L"", 0, ownsToken);
@@ -57,6 +57,10 @@ namespace Federation
 
         ~WriteLock()
         {
+            // Publish before the notifications so that they observe the new state,
+            // and again afterwards in case the health check has changed it further.
+            table_.PublishSnapshot();
+
             if (!table_.isTestMode_)
             {
                 if (table_.neighborhoodVersion_ != oldNeighborhoodVersion_)
@@ -69,6 +73,8 @@ namespace Federation
                     table_.OnRoutingTokenChanged((static_cast<uint>(oldTokenVersion_)) != table_.site_.Token.TokenVersion);
                 }
             }
+
+            table_.PublishSnapshot();
         }
 
     private:
@@ -78,6 +84,80 @@ namespace Federation
         uint oldNeighborhoodVersion_;
     };
 
+    class RoutingTable::Snapshot : public NodeRingBase
+    {
+        DENY_COPY(Snapshot)
+
+    public:
+        Snapshot(RoutingTable const & table)
+            :   thisNode_(table.ring_.ThisNode),
+                ringVersion_(table.ring_.Version),
+                knownTableVersion_(table.knownTable_.Version),
+                token_(table.site_.Token),
+                predProbeTarget_(table.GetActiveProbeTarget(false)),
+                succProbeTarget_(table.GetActiveProbeTarget(true))
+        {
+            CopyFrom(table.ring_);
+
+            hoodRange_ = table.knownTable_.GetHood(hood_);
+            table.knownTable_.GetPingTargets(pingTargets_);
+            AddProbeTarget(table, predProbeTarget_);
+            AddProbeTarget(table, succProbeTarget_);
+        }
+
+        __declspec (property(get=getThisNode)) size_t ThisNode;
+        size_t getThisNode() const { return thisNode_; }
+
+        __declspec (property(get=getThisNodePtr)) PartnerNodeSPtr const & ThisNodePtr;
+        PartnerNodeSPtr const & getThisNodePtr() const { return GetNode(thisNode_); }
+
+        __declspec (property(get=getToken)) RoutingToken const & Token;
+        RoutingToken const & getToken() const { return token_; }
+
+        __declspec (property(get=getHoodRange)) NodeIdRange const & HoodRange;
+        NodeIdRange const & getHoodRange() const { return hoodRange_; }
+
+        __declspec (property(get=getHood)) vector<PartnerNodeSPtr> const & Hood;
+        vector<PartnerNodeSPtr> const & getHood() const { return hood_; }
+
+        __declspec (property(get=getPingTargets)) vector<PartnerNodeSPtr> const & PingTargets;
+        vector<PartnerNodeSPtr> const & getPingTargets() const { return pingTargets_; }
+
+        bool IsCurrent(RoutingTable const & table) const
+        {
+            return (ringVersion_ == table.ring_.Version &&
+                    knownTableVersion_ == table.knownTable_.Version &&
+                    token_.Version == table.site_.Token.Version &&
+                    token_.Range == table.site_.Token.Range &&
+                    hoodRange_ == table.knownTable_.GetRange() &&
+                    predProbeTarget_ == table.GetActiveProbeTarget(false) &&
+                    succProbeTarget_ == table.GetActiveProbeTarget(true));
+        }
+
+    private:
+        void AddProbeTarget(RoutingTable const & table, NodeId const & target)
+        {
+            if (target != table.site_.Id)
+            {
+                PartnerNodeSPtr const & node = table.GetInternal(target, &table.knownTable_);
+                if (node)
+                {
+                    pingTargets_.push_back(node);
+                }
+            }
+        }
+
+        size_t thisNode_;
+        uint64 ringVersion_;
+        uint64 knownTableVersion_;
+        RoutingToken token_;
+        NodeId predProbeTarget_;
+        NodeId succProbeTarget_;
+        NodeIdRange hoodRange_;
+        vector<PartnerNodeSPtr> hood_;
+        vector<PartnerNodeSPtr> pingTargets_;
+    };
+
     class GapRequestAction : public StateMachineAction
     {
         DENY_COPY(GapRequestAction)
@@ -217,72 +297,116 @@ namespace Federation
                 this->OnTimer();
             },
             true);
+
+        PublishSnapshot();
     }
 
     RoutingTable::~RoutingTable()
     {
     }
 
+    void RoutingTable::Test_SetToken(RoutingToken const & token)
+    {
+        AcquireWriteLock grab(lock_);
+        site_.Test_SetToken(token);
+        PublishSnapshot();
+    }
+
+    NodeId RoutingTable::GetActiveProbeTarget(bool isSuccDirection) const
+    {
+        if (isSuccDirection)
+        {
+            return (succRecoveryTime_ != StopwatchTime::Zero ? succProbeTarget_ : site_.Id);
+        }
+
+        return (predRecoveryTime_ != StopwatchTime::Zero ? predProbeTarget_ : site_.Id);
+    }
+
+    void RoutingTable::PublishSnapshot()
+    {
+        SnapshotSPtr current = GetSnapshot();
+        if (current && current->IsCurrent(*this))
+        {
+            return;
+        }
+
+        SnapshotSPtr snapshot = make_shared<Snapshot>(*this);
+        atomic_store(&snapshot_, snapshot);
+    }
+
+    RoutingTable::SnapshotSPtr RoutingTable::GetSnapshot() const
+    {
+        return atomic_load(&snapshot_);
+    }
+
     int RoutingTable::GetRoutingNodeCount() const
     {
-        AcquireReadLock grab(lock_);
-        return ring_.GetRoutingNodeCount();
+        return GetSnapshot()->GetRoutingNodeCount();
     }
 
     PartnerNodeSPtr RoutingTable::FindClosest(NodeId const& value, wstring const & toRing) const
     {
+        if (site_.IsRingNameMatched(toRing))
+        {
+            SnapshotSPtr snapshot = GetSnapshot();
+            return InternalFindClosest(value, *snapshot, snapshot.get());
+        }
+
         AcquireReadLock grab(lock_);
-        return InternalFindClosest(value, toRing, false);
+        return InternalFindClosestExternal(value, toRing, false);
     }
 
     PartnerNodeSPtr RoutingTable::GetRoutingHop(NodeId const& value, wstring const & toRing, bool safeMode, bool& ownsToken) const
     {
-        AcquireReadLock grab(lock_);
-        
-        ownsToken = (site_.IsRingNameMatched(toRing) && site_.Token.Contains(value));
-        if (ownsToken)
+        if (site_.IsRingNameMatched(toRing))
         {
-            return knownTable_.ThisNodePtr;
+            SnapshotSPtr snapshot = GetSnapshot();
+
+            ownsToken = snapshot->Token.Contains(value);
+            if (ownsToken)
+            {
+                return snapshot->ThisNodePtr;
+            }
+
+            return InternalFindClosest(value, *snapshot, snapshot.get());
         }
 
-        return InternalFindClosest(value, toRing, safeMode);
+        ownsToken = false;
+
+        AcquireReadLock grab(lock_);
+        return InternalFindClosestExternal(value, toRing, safeMode);
     }
 
-    PartnerNodeSPtr const& RoutingTable::InternalFindClosest(NodeId const& value, wstring const & toRing, bool safeMode) const
+    PartnerNodeSPtr const& RoutingTable::InternalFindClosestExternal(NodeId const& value, wstring const & toRing, bool safeMode) const
     {
-        if (site_.IsRingNameMatched(toRing))
+        auto it = externalRings_.find(toRing);
+        if (it != externalRings_.end())
         {
-            return InternalFindClosest(value, ring_);
-        }
-        else
-        {
-            auto it = externalRings_.find(toRing);
-            if (it != externalRings_.end())
+            if (safeMode)
             {
-                if (safeMode)
+                PartnerNodeSPtr const & result = it->second.GetRoutingSeedNode();
+                if (result)
                 {
-                    PartnerNodeSPtr const & result = it->second.GetRoutingSeedNode();
-                    if (result)
-                    {
-                        return result;
-                    }
+                    return result;
                 }
-
-                return InternalFindClosest(value, it->second);
             }
 
-            return knownTable_.ThisNodePtr;
+            return InternalFindClosest(value, it->second, nullptr);
         }
+
+        return knownTable_.ThisNodePtr;
     }
 
-    PartnerNodeSPtr const& RoutingTable::InternalFindClosest(NodeId const& value, NodeRingBase const & ring) const
+    PartnerNodeSPtr const& RoutingTable::InternalFindClosest(NodeId const& value, NodeRingBase const & ring, Snapshot const * localSnapshot) const
     {
+        // The local ring is always searched through a snapshot without holding the lock,
+        // external rings are searched with the read lock held.
+        bool isLocal = (localSnapshot != nullptr);
         if (ring.Size == 0)
         {
-            return knownTable_.ThisNodePtr;
+            return (isLocal ? localSnapshot->ThisNodePtr : knownTable_.ThisNodePtr);
         }
 
-        bool isLocal = (&ring == &ring_);
         size_t succOrSame = ring.FindSuccOrSamePosition(value);
         size_t pred = ring.GetPred(succOrSame);
 
@@ -306,7 +430,7 @@ namespace Federation
                     foundSuccRouting = true;
                 }
 
-                if (!currentNode->IsUnknown || (isLocal && site_.IsAvailable && knownTable_.WithinHoodRange(currentNode->Id)))
+                if (!currentNode->IsUnknown || (isLocal && site_.IsAvailable && localSnapshot->HoodRange.Contains(currentNode->Id)))
                 {
                     found = true;
                     break;
@@ -338,7 +462,7 @@ namespace Federation
                     foundPredRouting = true;
                 }
 
-                if (!currentNode->IsUnknown || (isLocal && site_.IsAvailable && knownTable_.WithinHoodRange(currentNode->Id)))
+                if (!currentNode->IsUnknown || (isLocal && site_.IsAvailable && localSnapshot->HoodRange.Contains(currentNode->Id)))
                 {
                     break;
                 }
@@ -361,14 +485,14 @@ namespace Federation
             // but will check whether it is better than the saved unknown nodes
             if (value.PredDist(predNode->Id) <= value.SuccDist(succOrSameNode->Id))
             {
-                if (!isLocal || pred != ring_.ThisNode)
+                if (!isLocal || pred != localSnapshot->ThisNode)
                 {
                     return predNode;
                 }
             }
             else
             {
-                if (!isLocal || succOrSame != ring_.ThisNode)
+                if (!isLocal || succOrSame != localSnapshot->ThisNode)
                 {
                     return succOrSameNode;
                 }
@@ -765,16 +889,15 @@ namespace Federation
 
     NodeIdRange RoutingTable::GetHood(vector<PartnerNodeSPtr>& vecNode) const
     {
-        AcquireReadLock grab(lock_);
+        SnapshotSPtr snapshot = GetSnapshot();
+        vecNode.insert(vecNode.end(), snapshot->Hood.begin(), snapshot->Hood.end());
 
-        return knownTable_.GetHood(vecNode);
+        return snapshot->HoodRange;
     }
 
     NodeIdRange RoutingTable::GetHoodRange() const
     {
-        AcquireReadLock grab(lock_);
-
-        return knownTable_.GetRange();
+        return GetSnapshot()->HoodRange;
     }
 
     NodeIdRange RoutingTable::GetCombinedNeighborHoodTokenRange() const
@@ -799,79 +922,55 @@ namespace Federation
 
     void RoutingTable::GetPingTargets(vector<PartnerNodeSPtr>& vecNode) const
     {
-        AcquireReadLock grab(lock_);
-
-        knownTable_.GetPingTargets(vecNode);
-
-        if (predRecoveryTime_ != StopwatchTime::Zero && predProbeTarget_ != site_.Id)
-        {
-            PartnerNodeSPtr const & target = GetInternal(predProbeTarget_, &knownTable_);
-            if (target)
-            {
-                vecNode.push_back(target);
-            }
-        }
-
-        if (succRecoveryTime_ != StopwatchTime::Zero && succProbeTarget_ != site_.Id)
-        {
-            PartnerNodeSPtr const & target = GetInternal(succProbeTarget_, &knownTable_);
-            if (target)
-            {
-                vecNode.push_back(target);
-            }
-        }
+        // The snapshot also contains the recovery probe targets
+        SnapshotSPtr snapshot = GetSnapshot();
+        vecNode.insert(vecNode.end(), snapshot->PingTargets.begin(), snapshot->PingTargets.end());
     }
     
-    void RoutingTable::InternalGetExtendedHood(vector<PartnerNodeSPtr>& vecNode) const
+    void RoutingTable::InternalGetExtendedHood(NodeRingBase const & ring, size_t thisNode, vector<PartnerNodeSPtr>& vecNode) const
     {
         int predCount, succCount;
-        if (static_cast<int>(ring_.Size) > hoodSize_ + hoodSize_)
+        if (static_cast<int>(ring.Size) > hoodSize_ + hoodSize_)
         {
             predCount = succCount = hoodSize_;
         }
         else
         {
-            predCount = static_cast<int>(ring_.Size) - 1;
+            predCount = static_cast<int>(ring.Size) - 1;
             succCount = 0;
         }
 
-        size_t index = ring_.ThisNode;
+        size_t index = thisNode;
         for (int i = 0; i < predCount; i++)
         {
-            index = ring_.GetPred(index);
-            vecNode.push_back(ring_.GetNode(index));
+            index = ring.GetPred(index);
+            vecNode.push_back(ring.GetNode(index));
         }
 
-        index = ring_.ThisNode;
+        index = thisNode;
         for (int i = 0; i < succCount; i++)
         {
-            index = ring_.GetSucc(index);
-            vecNode.push_back(ring_.GetNode(index));
+            index = ring.GetSucc(index);
+            vecNode.push_back(ring.GetNode(index));
         }
     }
 
     void RoutingTable::GetExtendedHood(vector<PartnerNodeSPtr>& vecNode) const
     {
-        AcquireReadLock grab(lock_);
-        InternalGetExtendedHood(vecNode);
+        SnapshotSPtr snapshot = GetSnapshot();
+        InternalGetExtendedHood(*snapshot, snapshot->ThisNode, vecNode);
     }
 
     PartnerNodeSPtr RoutingTable::GetPredecessor() const
     {
-        AcquireReadLock grab(lock_);
-
-        size_t index = ring_.ThisNode;
-        index = ring_.GetPred(index);
-        return ring_.GetNode(index);
+        SnapshotSPtr snapshot = GetSnapshot();
+        return snapshot->GetNode(snapshot->GetPred(snapshot->ThisNode));
     }
 
     PartnerNodeSPtr RoutingTable::GetSuccessor() const
     {
-        AcquireReadLock grab(lock_);
-
-        size_t index = ring_.ThisNode;
-        index = ring_.GetSucc(index);
-        return ring_.GetNode(index);
+        SnapshotSPtr snapshot = GetSnapshot();
+        return snapshot->GetNode(snapshot->GetSucc(snapshot->ThisNode));
     }
 
     void RoutingTable::InternalExtendHood(NodeIdRange const& range, set<NodeInstance> const& shutdownNodes, set<NodeInstance> const* availableNodes, bool versionMatched)
@@ -37,6 +37,8 @@ namespace Federation
 			isTestMode_ = true;
 		}
 
+        void Test_SetToken(RoutingToken const & token);
+
         /// <summary>
         /// Get the size of the routing table (all nodes including "this" node and shutdown ones)
         /// </summary>
@@ -262,6 +264,14 @@ namespace Federation
     private:
         class WriteLock;
 
+        /// <summary>
+        /// An immutable copy of the routing ring and the neighborhood of this node.
+        /// A new one is published whenever a writer changes them, so that routing
+        /// and neighborhood queries can be answered without taking the lock.
+        /// </summary>
+        class Snapshot;
+        typedef std::shared_ptr<Snapshot const> SnapshotSPtr;
+
         // This list maintains all the effective echoed promise by
         // the node so that before token recovery we can check against
         // this list to see whether the recovery is going to break
@@ -389,6 +399,12 @@ namespace Federation
         /// </summary>
         MUTABLE_RWLOCK(Federation.RoutingTable, lock_);
 
+        /// <summary>
+        /// The last published snapshot, only replaced while holding the write lock
+        /// and read with std::atomic_load
+        /// </summary>
+        SnapshotSPtr snapshot_;
+
         Common::TimerSPtr timer_;
 
         Common::StopwatchTime lastSuccEdgeProbe_;
@@ -431,8 +447,16 @@ namespace Federation
 
         ImplicitLeaseContext implicitLeaseContext_;
 
-        PartnerNodeSPtr const& InternalFindClosest(NodeId const& value, std::wstring const & toRing, bool safeMode) const;
-        PartnerNodeSPtr const& InternalFindClosest(NodeId const& value, NodeRingBase const & ring) const;
+        PartnerNodeSPtr const& InternalFindClosestExternal(NodeId const& value, std::wstring const & toRing, bool safeMode) const;
+        PartnerNodeSPtr const& InternalFindClosest(NodeId const& value, NodeRingBase const & ring, Snapshot const * localSnapshot) const;
+
+        /// <summary>
+        /// Publish a new snapshot if the ring, the neighborhood or the token has changed.
+        /// Must be called with the write lock held.
+        /// </summary>
+        void PublishSnapshot();
+        SnapshotSPtr GetSnapshot() const;
+        NodeId GetActiveProbeTarget(bool isSuccDirection) const;
 
         PartnerNodeSPtr const& InternalConsider(FederationPartnerNodeHeader const & nodeInfo, bool isInserting = false, int64 now = 0);
         PartnerNodeSPtr const& InternalConsiderExternalNode(FederationPartnerNodeHeader const & nodeInfo);
@@ -483,7 +507,7 @@ namespace Federation
 
         void Compact();
 
-        void InternalGetExtendedHood(std::vector<PartnerNodeSPtr>& vecNode) const;
+        void InternalGetExtendedHood(NodeRingBase const & ring, size_t thisNode, std::vector<PartnerNodeSPtr>& vecNode) const;
 
         void OnTimer();
         void CheckHealth();
@@ -0,0 +1,89 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+namespace FederationUnitTests
+{
+    using namespace std;
+    using namespace Common;
+    using namespace Federation;
+
+    class RoutingTokenOwnerCacheTests
+    {
+    protected:
+        static NodeId Id(uint64 value) { return NodeId(LargeInteger(0, value)); }
+        static NodeIdRange Range(uint64 begin, uint64 end) { return NodeIdRange(Id(begin), Id(end)); }
+    };
+
+    BOOST_FIXTURE_TEST_SUITE(RoutingTokenOwnerCacheTestsSuite,RoutingTokenOwnerCacheTests)
+
+    BOOST_AUTO_TEST_CASE(TestRangeLookup)
+    {
+        RoutingTokenOwnerCache cache(16, TimeSpan::FromMinutes(1));
+        NodeInstance owner1(Id(150), 1);
+        NodeInstance owner2(Id(250), 1);
+
+        cache.Add(Range(100, 200), owner1);
+        cache.Add(Range(201, 300), owner2);
+
+        NodeInstance owner;
+        VERIFY_IS_TRUE(cache.TryGet(Id(100), owner));
+        VERIFY_IS_TRUE(owner == owner1);
+        VERIFY_IS_TRUE(cache.TryGet(Id(260), owner));
+        VERIFY_IS_TRUE(owner == owner2);
+        VERIFY_IS_FALSE(cache.TryGet(Id(301), owner));
+
+        cache.Invalidate(Id(180));
+        VERIFY_IS_FALSE(cache.TryGet(Id(150), owner));
+        VERIFY_IS_TRUE(cache.TryGet(Id(250), owner));
+
+        cache.Clear();
+        VERIFY_ARE_EQUAL(0u, cache.Count);
+    }
+
+    BOOST_AUTO_TEST_CASE(TestOverlappingRangeIsReplaced)
+    {
+        RoutingTokenOwnerCache cache(16, TimeSpan::FromMinutes(1));
+        NodeInstance oldOwner(Id(150), 1);
+        NodeInstance newOwner(Id(160), 1);
+
+        cache.Add(Range(100, 200), oldOwner);
+        cache.Add(Range(150, 250), newOwner);
+        VERIFY_ARE_EQUAL(1u, cache.Count);
+
+        // The part of the old range that is not covered by the new one is no longer known
+        NodeInstance owner;
+        VERIFY_IS_FALSE(cache.TryGet(Id(120), owner));
+        VERIFY_IS_TRUE(cache.TryGet(Id(180), owner));
+        VERIFY_IS_TRUE(owner == newOwner);
+    }
+
+    BOOST_AUTO_TEST_CASE(TestCapacityAndExpiry)
+    {
+        RoutingTokenOwnerCache cache(2, TimeSpan::FromMinutes(1));
+        cache.Add(Range(100, 100), NodeInstance(Id(100), 1));
+        cache.Add(Range(200, 200), NodeInstance(Id(200), 1));
+        cache.Add(Range(300, 300), NodeInstance(Id(300), 1));
+        VERIFY_ARE_EQUAL(2u, cache.Count);
+
+        NodeInstance owner;
+        VERIFY_IS_FALSE(cache.TryGet(Id(100), owner));
+        VERIFY_IS_TRUE(cache.TryGet(Id(300), owner));
+
+        RoutingTokenOwnerCache expiredCache(2, TimeSpan::Zero);
+        expiredCache.Add(Range(100, 100), NodeInstance(Id(100), 1));
+        VERIFY_IS_FALSE(expiredCache.TryGet(Id(100), owner));
+
+        RoutingTokenOwnerCache disabledCache(0, TimeSpan::FromMinutes(1));
+        disabledCache.Add(Range(100, 100), NodeInstance(Id(100), 1));
+        VERIFY_ARE_EQUAL(0u, disabledCache.Count);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+}
@@ -0,0 +1,91 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace std;
+using namespace Common;
+using namespace Federation;
+
+RoutingTokenOwnerCache::RoutingTokenOwnerCache(size_t capacity, TimeSpan entryTimeToLive)
+    : capacity_(capacity),
+    entryTimeToLive_(entryTimeToLive)
+{
+}
+
+size_t RoutingTokenOwnerCache::get_Count() const
+{
+    AcquireReadLock grab(lock_);
+    return entries_.size();
+}
+
+bool RoutingTokenOwnerCache::TryGet(NodeId const & target, __out NodeInstance & owner) const
+{
+    StopwatchTime now = Stopwatch::Now();
+
+    AcquireReadLock grab(lock_);
+
+    for (auto const & entry : entries_)
+    {
+        if (entry.ExpiryTime > now && entry.Range.Contains(target))
+        {
+            owner = entry.Owner;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void RoutingTokenOwnerCache::Add(NodeIdRange const & range, NodeInstance const & owner)
+{
+    if (capacity_ == 0 || range.IsEmpty)
+    {
+        return;
+    }
+
+    StopwatchTime now = Stopwatch::Now();
+
+    AcquireWriteLock grab(lock_);
+
+    entries_.erase(
+        remove_if(entries_.begin(), entries_.end(), [&range, now](Entry const & entry)
+        {
+            return entry.ExpiryTime <= now || !entry.Range.Disjoint(range);
+        }),
+        entries_.end());
+
+    if (entries_.size() >= capacity_)
+    {
+        auto oldest = min_element(entries_.begin(), entries_.end(), [](Entry const & left, Entry const & right)
+        {
+            return left.ExpiryTime < right.ExpiryTime;
+        });
+
+        entries_.erase(oldest);
+    }
+
+    Entry entry;
+    entry.Range = range;
+    entry.Owner = owner;
+    entry.ExpiryTime = now + entryTimeToLive_;
+
+    entries_.push_back(move(entry));
+}
+
+void RoutingTokenOwnerCache::Invalidate(NodeId const & target)
+{
+    AcquireWriteLock grab(lock_);
+
+    entries_.erase(
+        remove_if(entries_.begin(), entries_.end(), [&target](Entry const & entry) { return entry.Range.Contains(target); }),
+        entries_.end());
+}
+
+void RoutingTokenOwnerCache::Clear()
+{
+    AcquireWriteLock grab(lock_);
+    entries_.clear();
+}
@@ -0,0 +1,46 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Federation
+{
+    // Remembers which node owned the routing token for the targets of recent routed requests,
+    // so that the next request for the same part of the ring can be sent to that node directly
+    // instead of hop by hop. Entries are only hints: a node that no longer owns the target
+    // forwards the message as usual, and the next reply replaces the entry.
+    class RoutingTokenOwnerCache
+    {
+        DENY_COPY(RoutingTokenOwnerCache);
+
+    public:
+        RoutingTokenOwnerCache(size_t capacity, Common::TimeSpan entryTimeToLive);
+
+        __declspec(property(get=get_Count)) size_t Count;
+        size_t get_Count() const;
+
+        bool TryGet(NodeId const & target, __out NodeInstance & owner) const;
+
+        // Replaces the entries that overlap the range
+        void Add(NodeIdRange const & range, NodeInstance const & owner);
+
+        void Invalidate(NodeId const & target);
+
+        void Clear();
+
+    private:
+        struct Entry
+        {
+            NodeIdRange Range;
+            NodeInstance Owner;
+            Common::StopwatchTime ExpiryTime;
+        };
+
+        size_t const capacity_;
+        Common::TimeSpan const entryTimeToLive_;
+        mutable Common::RwLock lock_;
+        std::vector<Entry> entries_;
+    };
+}
@@ -141,7 +141,7 @@ protected:
             // TODO: If SiteNode must do any other processing on these events consider making a general method to move ProcessRoutedMessageHoldingList to
             if (siteNode)
             {
-                siteNode->routingManager_->ProcessRoutedMessageHoldingList();
+                siteNode->routingManager_->OnTokenOrNeighborhoodChanged();
             }
         };
 
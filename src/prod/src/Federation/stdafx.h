@@ -62,6 +62,7 @@
 #include "Federation/SendMessageAction.h"
 #include "Federation/NodeRing.h"
 #include "Federation/RoutingTable.h"
+#include "Federation/RoutingTokenOwnerCache.h"
 #include "Federation/JoinLock.h"
 #include "Federation/JoinLockManager.h"
 #include "Federation/VoteEntry.h"
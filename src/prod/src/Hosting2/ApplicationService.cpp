@@ -48,6 +48,121 @@ public:
 
 protected:
     void OnStart(AsyncOperationSPtr const & thisSPtr)
+    {
+#if defined(PLATFORM_UNIX)
+        if (HostingConfig::GetConfig().EnableCgroupResourceUsageSampling)
+        {
+            if (!owner_.IsContainerHost)
+            {
+                if (TryMeasureCgroupUsage(owner_.processDescription_.CgroupName))
+                {
+                    TryComplete(thisSPtr, ErrorCodeValue::Success);
+                    return;
+                }
+            }
+            else
+            {
+                bool isResolved;
+                wstring cgroupName;
+                {
+                    AcquireReadLock lock(owner_.rwlock_);
+                    isResolved = owner_.isContainerCgroupResolved_;
+                    cgroupName = owner_.containerCgroupName_;
+                }
+
+                if (!isResolved)
+                {
+                    auto operation = owner_.ActivationManager.containerActivator_->BeginQuery(
+                        owner_.containerDescription_,
+                        HostingConfig::GetConfig().ContainerStatsTimeout,
+                        [this](AsyncOperationSPtr const & operation)
+                    {
+                        this->OnContainerQueryCompleted(operation, false);
+                    },
+                        thisSPtr);
+                    this->OnContainerQueryCompleted(operation, true);
+                    return;
+                }
+
+                if (TryMeasureCgroupUsage(cgroupName))
+                {
+                    TryComplete(thisSPtr, ErrorCodeValue::Success);
+                    return;
+                }
+            }
+        }
+#endif
+
+        MeasureFromActivator(thisSPtr);
+    }
+
+#if defined(PLATFORM_UNIX)
+    bool TryMeasureCgroupUsage(wstring const & cgroupName)
+    {
+        return !cgroupName.empty() && owner_.ActivationManager.cgroupResourceSampler_->TryGetUsage(cgroupName, resourceMeasurement_);
+    }
+
+    void OnContainerQueryCompleted(
+        AsyncOperationSPtr const & operation,
+        bool expectedCompletedSynhronously)
+    {
+        if (operation->CompletedSynchronously != expectedCompletedSynhronously)
+        {
+            return;
+        }
+
+        ContainerInspectResponse containerInspect;
+        auto error = owner_.ActivationManager.containerActivator_->EndQuery(operation, containerInspect);
+        if (error.IsSuccess())
+        {
+            // The cgroup layout depends on the cgroup driver of docker, so it is taken from the container init process.
+            // Without it, assume the cgroupfs driver: the container cgroup is under the cgroup parent, or under /docker.
+            wstring cgroupName;
+            bool isFromProcess =
+                containerInspect.State.Pid != 0 &&
+                owner_.ActivationManager.cgroupResourceSampler_->TryGetProcessCgroup(containerInspect.State.Pid, cgroupName);
+            if (!isFromProcess && !containerInspect.Id.empty())
+            {
+                cgroupName = wformatString(
+                    "{0}/{1}",
+                    containerInspect.HostConfig.CgroupName.empty() ? wstring(L"/docker") : containerInspect.HostConfig.CgroupName,
+                    containerInspect.Id);
+            }
+
+            WriteInfo(
+                TraceType_ActivationManager,
+                owner_.parentId_,
+                "Application Service with service Id {0} samples container resource usage from cgroup '{1}'",
+                owner_.appServiceId_,
+                cgroupName);
+
+            {
+                AcquireWriteLock lock(owner_.rwlock_);
+                owner_.containerCgroupName_ = cgroupName;
+                owner_.isContainerCgroupResolved_ = true;
+            }
+
+            if (TryMeasureCgroupUsage(cgroupName))
+            {
+                TryComplete(operation->Parent, ErrorCodeValue::Success);
+                return;
+            }
+        }
+        else
+        {
+            WriteWarning(
+                TraceType_ActivationManager,
+                owner_.parentId_,
+                "Application Service with service Id {0} container query error {1}",
+                owner_.appServiceId_,
+                error);
+        }
+
+        MeasureFromActivator(operation->Parent);
+    }
+#endif
+
+    void MeasureFromActivator(AsyncOperationSPtr const & thisSPtr)
     {
         if (owner_.IsContainerHost)
         {
@@ -683,6 +798,10 @@ ApplicationService::ApplicationService(
     containerDescription_(containerDescription),
     fabricBinFolder_(fabricBinFolder),
     rwlock_()
+#if defined(PLATFORM_UNIX)
+    , containerCgroupName_()
+    , isContainerCgroupResolved_(false)
+#endif
 {
     this->SetTraceId(parentId);
     WriteNoise(
@@ -121,6 +121,11 @@ namespace Hosting2
         BOOL isContainerHost_;
         IProcessActivationContextSPtr activationContext_;
         Common::RwLock rwlock_;
+#if defined(PLATFORM_UNIX)
+        // The cgroup of the container that resource usage is sampled from, resolved on the first measurement
+        std::wstring containerCgroupName_;
+        bool isContainerCgroupResolved_;
+#endif
 
         class ActivateAsyncOperation;
         class DeactivateAsyncOperation;
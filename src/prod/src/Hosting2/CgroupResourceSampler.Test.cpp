@@ -0,0 +1,155 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+using namespace std;
+using namespace Common;
+using namespace Hosting2;
+using namespace Management::ResourceMonitor;
+
+class CgroupResourceSamplerTestClass
+{
+protected:
+    CgroupResourceSamplerTestClass()
+        : rootFolder_(Path::Combine(Directory::GetCurrentDirectory(), L"CgroupResourceSamplerTest"))
+    {
+        BOOST_REQUIRE(Setup());
+    }
+
+    TEST_CLASS_SETUP(Setup);
+    ~CgroupResourceSamplerTestClass() { BOOST_REQUIRE(Cleanup()); }
+    TEST_CLASS_CLEANUP(Cleanup);
+
+    string GetRoot() const;
+    void WriteFile(wstring const & relativePath, string const & content);
+
+    wstring rootFolder_;
+};
+
+BOOST_FIXTURE_TEST_SUITE(CgroupResourceSamplerTestClassSuite, CgroupResourceSamplerTestClass)
+
+BOOST_AUTO_TEST_CASE(UnifiedHierarchyTest)
+{
+    HostingConfig::GetConfig().CgroupResourceUsageSamplingInterval = TimeSpan::FromMinutes(10);
+
+    WriteFile(L"cgroup.controllers", "cpu memory\n");
+    WriteFile(L"fabric/sp1/cp1/cpu.stat", "usage_usec 2500\nuser_usec 2000\nsystem_usec 500\n");
+    WriteFile(L"fabric/sp1/cp1/memory.current", "10485760\n");
+    WriteFile(L"fabric/sp1/cp1/memory.stat", "anon 4194304\nfile 6291456\ninactive_file 2097152\n");
+
+    CgroupResourceSampler sampler(L"CgroupResourceSamplerTest", GetRoot());
+    VERIFY_IS_TRUE(sampler.IsUnified);
+
+    ResourceMeasurement measurement;
+    VERIFY_IS_TRUE(sampler.TryGetUsage(L"/fabric/sp1/cp1", measurement));
+    VERIFY_ARE_EQUAL(25000u, measurement.TotalCpuTime);
+    VERIFY_ARE_EQUAL(8388608u, measurement.MemoryUsage);
+
+    VERIFY_IS_FALSE(sampler.TryGetUsage(L"/fabric/sp1/cp2", measurement));
+    VERIFY_ARE_EQUAL(1u, sampler.TrackedCount);
+
+    // Served from the last sweep until the sampling interval elapses
+    WriteFile(L"fabric/sp1/cp1/cpu.stat", "usage_usec 5000\n");
+    VERIFY_IS_TRUE(sampler.TryGetUsage(L"/fabric/sp1/cp1", measurement));
+    VERIFY_ARE_EQUAL(25000u, measurement.TotalCpuTime);
+
+    HostingConfig::GetConfig().CgroupResourceUsageSamplingInterval = TimeSpan::Zero;
+    VERIFY_IS_TRUE(sampler.TryGetUsage(L"/fabric/sp1/cp1", measurement));
+    VERIFY_ARE_EQUAL(50000u, measurement.TotalCpuTime);
+
+    HostingConfig::GetConfig().CgroupResourceUsageSamplingInterval = TimeSpan::FromSeconds(30);
+}
+
+BOOST_AUTO_TEST_CASE(LegacyHierarchyTest)
+{
+    HostingConfig::GetConfig().CgroupResourceUsageSamplingInterval = TimeSpan::Zero;
+
+    WriteFile(L"cpuacct/fabric/sp1/cp1/cpuacct.usage", "123456789\n");
+    WriteFile(L"memory/fabric/sp1/cp1/memory.usage_in_bytes", "10485760\n");
+    WriteFile(L"memory/fabric/sp1/cp1/memory.stat", "cache 6291456\ninactive_file 1048576\ntotal_inactive_file 2097152\n");
+
+    CgroupResourceSampler sampler(L"CgroupResourceSamplerTest", GetRoot());
+    VERIFY_IS_FALSE(sampler.IsUnified);
+
+    ResourceMeasurement measurement;
+    VERIFY_IS_TRUE(sampler.TryGetUsage(L"/fabric/sp1/cp1", measurement));
+    VERIFY_ARE_EQUAL(1234567u, measurement.TotalCpuTime);
+    VERIFY_ARE_EQUAL(8388608u, measurement.MemoryUsage);
+
+    // Removed cgroups are dropped on the next sweep
+    VERIFY_IS_TRUE(Directory::Delete(Path::Combine(rootFolder_, L"cpuacct"), true, true).IsSuccess());
+    VERIFY_IS_FALSE(sampler.TryGetUsage(L"/fabric/sp1/cp1", measurement));
+    VERIFY_ARE_EQUAL(0u, sampler.TrackedCount);
+
+    HostingConfig::GetConfig().CgroupResourceUsageSamplingInterval = TimeSpan::FromSeconds(30);
+}
+
+BOOST_AUTO_TEST_CASE(ProcessCgroupTest)
+{
+    string cgroupName;
+
+    // docker with the systemd cgroup driver on cgroup v2
+    VERIFY_IS_TRUE(CgroupResourceSampler::TryParseProcessCgroup(
+        "0::/system.slice/docker-4f3c2a.scope\n",
+        true,
+        cgroupName));
+    VERIFY_ARE_EQUAL(string("/system.slice/docker-4f3c2a.scope"), cgroupName);
+
+    // docker with the cgroupfs driver on cgroup v1, with the unified entry of the hybrid layout
+    string legacy =
+        "12:memory:/docker/4f3c2a\n"
+        "4:cpu,cpuacct:/docker/4f3c2a\n"
+        "1:name=systemd:/docker/4f3c2a\n"
+        "0::/system.slice/containerd.service\n";
+    VERIFY_IS_TRUE(CgroupResourceSampler::TryParseProcessCgroup(legacy, false, cgroupName));
+    VERIFY_ARE_EQUAL(string("/docker/4f3c2a"), cgroupName);
+    VERIFY_IS_TRUE(CgroupResourceSampler::TryParseProcessCgroup(legacy, true, cgroupName));
+    VERIFY_ARE_EQUAL(string("/system.slice/containerd.service"), cgroupName);
+
+    // Processes in the root cgroup are not sampled
+    VERIFY_IS_FALSE(CgroupResourceSampler::TryParseProcessCgroup("0::/\n", true, cgroupName));
+    VERIFY_IS_FALSE(CgroupResourceSampler::TryParseProcessCgroup("4:cpu:/docker/4f3c2a\n", false, cgroupName));
+    VERIFY_IS_FALSE(CgroupResourceSampler::TryParseProcessCgroup("", true, cgroupName));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+bool CgroupResourceSamplerTestClass::Setup()
+{
+    if (Directory::Exists(rootFolder_))
+    {
+        Directory::Delete(rootFolder_, true, true).ReadValue();
+    }
+
+    return Directory::Create2(rootFolder_).IsSuccess();
+}
+
+bool CgroupResourceSamplerTestClass::Cleanup()
+{
+    return Directory::Delete(rootFolder_, true, true).IsSuccess();
+}
+
+string CgroupResourceSamplerTestClass::GetRoot() const
+{
+    string root;
+    StringUtility::Utf16ToUtf8(rootFolder_, root);
+    return root;
+}
+
+void CgroupResourceSamplerTestClass::WriteFile(wstring const & relativePath, string const & content)
+{
+    wstring path = Path::Combine(rootFolder_, relativePath);
+    VERIFY_IS_TRUE(Directory::Create2(Path::GetDirectoryName(path)).IsSuccess());
+
+    File file;
+    VERIFY_IS_TRUE(file.TryOpen(path, FileMode::Create, FileAccess::Write, FileShare::None).IsSuccess());
+    DWORD bytesWritten = 0;
+    VERIFY_IS_TRUE(file.TryWrite2(content.c_str(), static_cast<int>(content.size()), bytesWritten).IsSuccess());
+    file.Close();
+}
@@ -0,0 +1,296 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace std;
+using namespace Common;
+using namespace Hosting2;
+using namespace Management::ResourceMonitor;
+
+StringLiteral const Trace_CgroupResourceSampler("CgroupResourceSampler");
+
+namespace
+{
+    // cgroup v2 keeps all controllers in a single hierarchy with this file at its root
+    char const * const UnifiedControllersFile = "/cgroup.controllers";
+
+    // cgroup v1 CPU usage is in nanoseconds, cgroup v2 CPU usage is in microseconds
+    uint64 const NanosecondsPerTick = 100;
+    uint64 const TicksPerMicrosecond = 10;
+
+    // Accounting files are a few lines at most, except memory.stat
+    size_t const MaxAccountingFileSize = 8192;
+}
+
+CgroupResourceSampler::CgroupResourceSampler(wstring const & traceId, string const & cgroupRoot)
+    : traceId_(traceId)
+    , cgroupRoot_(cgroupRoot)
+    , isUnified_(access((cgroupRoot + UnifiedControllersFile).c_str(), F_OK) == 0)
+    , lock_()
+    , samples_()
+    , lastSweep_(StopwatchTime::Zero)
+{
+    WriteInfo(
+        Trace_CgroupResourceSampler,
+        traceId_,
+        "Sampling cgroup resource usage under {0}, unified hierarchy {1}",
+        cgroupRoot_,
+        isUnified_);
+}
+
+size_t CgroupResourceSampler::get_TrackedCount() const
+{
+    AcquireReadLock grab(lock_);
+    return samples_.size();
+}
+
+bool CgroupResourceSampler::TryGetUsage(wstring const & cgroupName, __out ResourceMeasurement & measurement)
+{
+    string name;
+    StringUtility::Utf16ToUtf8(cgroupName, name);
+
+    auto now = Stopwatch::Now();
+
+    AcquireWriteLock grab(lock_);
+
+    if (now - lastSweep_ >= HostingConfig::GetConfig().CgroupResourceUsageSamplingInterval)
+    {
+        SweepCallerHoldsLock(now);
+    }
+
+    auto it = samples_.find(name);
+    if (it == samples_.end())
+    {
+        Sample sample;
+        if (!TryRead(name, sample.Measurement))
+        {
+            return false;
+        }
+
+        it = samples_.insert(make_pair(move(name), move(sample))).first;
+    }
+
+    it->second.LastRequested = now;
+    measurement = it->second.Measurement;
+    return true;
+}
+
+void CgroupResourceSampler::SweepCallerHoldsLock(StopwatchTime now)
+{
+    auto retention = HostingConfig::GetConfig().CgroupResourceUsageRetention;
+    size_t dropped = 0;
+
+    for (auto it = samples_.begin(); it != samples_.end();)
+    {
+        // Cgroups are removed when their code package is deactivated
+        if (now - it->second.LastRequested >= retention || !TryRead(it->first, it->second.Measurement))
+        {
+            it = samples_.erase(it);
+            ++dropped;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    lastSweep_ = now;
+
+    WriteNoise(
+        Trace_CgroupResourceSampler,
+        traceId_,
+        "Sampled {0} cgroups in {1}, dropped {2}",
+        samples_.size(),
+        Stopwatch::Now() - now,
+        dropped);
+}
+
+bool CgroupResourceSampler::TryGetProcessCgroup(DWORD pid, __out wstring & cgroupName) const
+{
+    string path = formatString("/proc/{0}/cgroup", pid);
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    char buf[MaxAccountingFileSize];
+    auto len = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+
+    if (len <= 0)
+    {
+        return false;
+    }
+
+    string name;
+    if (!TryParseProcessCgroup(string(buf, len), isUnified_, name))
+    {
+        WriteInfo(
+            Trace_CgroupResourceSampler,
+            traceId_,
+            "No cgroup found for process {0}, unified hierarchy {1}",
+            pid,
+            isUnified_);
+        return false;
+    }
+
+    StringUtility::Utf8ToUtf16(name, cgroupName);
+    return true;
+}
+
+bool CgroupResourceSampler::TryParseProcessCgroup(string const & content, bool isUnified, __out string & cgroupName)
+{
+    // Each line is "<hierarchy id>:<comma separated controllers>:<path>"
+    size_t lineBegin = 0;
+    while (lineBegin < content.size())
+    {
+        size_t lineEnd = content.find('\n', lineBegin);
+        if (lineEnd == string::npos)
+        {
+            lineEnd = content.size();
+        }
+
+        string line = content.substr(lineBegin, lineEnd - lineBegin);
+        lineBegin = lineEnd + 1;
+
+        size_t first = line.find(':');
+        size_t second = (first == string::npos) ? string::npos : line.find(':', first + 1);
+        if (second == string::npos)
+        {
+            continue;
+        }
+
+        string hierarchyId = line.substr(0, first);
+        string controllers = line.substr(first + 1, second - first - 1);
+        string path = line.substr(second + 1);
+
+        bool matches;
+        if (isUnified)
+        {
+            matches = (hierarchyId == "0" && controllers.empty());
+        }
+        else
+        {
+            matches = (("," + controllers + ",").find(",cpuacct,") != string::npos);
+        }
+
+        // A process in the root cgroup would be accounted with the whole host
+        if (matches && !path.empty() && path != "/")
+        {
+            cgroupName = move(path);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool CgroupResourceSampler::TryRead(string const & cgroupName, __out ResourceMeasurement & measurement) const
+{
+    uint64 cpuTime = 0;
+    uint64 memoryUsage = 0;
+    uint64 inactiveFile = 0;
+
+    if (isUnified_)
+    {
+        string cgroupPath = cgroupRoot_ + cgroupName;
+
+        uint64 usageUsec = 0;
+        if (!TryReadKeyValue(cgroupPath + "/cpu.stat", "usage_usec", usageUsec) ||
+            !TryReadValue(cgroupPath + "/memory.current", memoryUsage))
+        {
+            return false;
+        }
+
+        cpuTime = usageUsec * TicksPerMicrosecond;
+        TryReadKeyValue(cgroupPath + "/memory.stat", "inactive_file", inactiveFile);
+    }
+    else
+    {
+        string memoryPath = cgroupRoot_ + "/memory" + cgroupName;
+
+        uint64 usageNs = 0;
+        if (!TryReadValue(cgroupRoot_ + "/cpuacct" + cgroupName + "/cpuacct.usage", usageNs) ||
+            !TryReadValue(memoryPath + "/memory.usage_in_bytes", memoryUsage))
+        {
+            return false;
+        }
+
+        cpuTime = usageNs / NanosecondsPerTick;
+        TryReadKeyValue(memoryPath + "/memory.stat", "total_inactive_file", inactiveFile);
+    }
+
+    measurement.TotalCpuTime = cpuTime;
+    measurement.MemoryUsage = memoryUsage > inactiveFile ? memoryUsage - inactiveFile : memoryUsage;
+    measurement.TimeRead = DateTime::Now();
+    return true;
+}
+
+bool CgroupResourceSampler::TryReadValue(string const & path, __out uint64 & value)
+{
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    char buf[64];
+    auto len = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+
+    if (len <= 0)
+    {
+        return false;
+    }
+
+    buf[len] = 0;
+    char * end = nullptr;
+    value = strtoull(buf, &end, 10);
+    return end != buf;
+}
+
+bool CgroupResourceSampler::TryReadKeyValue(string const & path, char const * key, __out uint64 & value)
+{
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    char buf[MaxAccountingFileSize];
+    auto len = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+
+    if (len <= 0)
+    {
+        return false;
+    }
+
+    buf[len] = 0;
+    size_t keyLength = strlen(key);
+
+    // Each line is "<key> <value>"
+    for (char * line = buf; line != nullptr && *line != 0;)
+    {
+        char * next = strchr(line, '\n');
+        if (next != nullptr)
+        {
+            *next++ = 0;
+        }
+
+        if (strncmp(line, key, keyLength) == 0 && line[keyLength] == ' ')
+        {
+            char * end = nullptr;
+            value = strtoull(line + keyLength + 1, &end, 10);
+            return end != line + keyLength + 1;
+        }
+
+        line = next;
+    }
+
+    return false;
+}
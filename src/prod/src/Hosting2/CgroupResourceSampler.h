@@ -0,0 +1,69 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Hosting2
+{
+    //
+    // Samples the CPU and memory usage of code packages and containers from the accounting files of
+    // their cgroups, without a round trip to the container runtime. All cgroups that are tracked are
+    // read together in one sweep, at most once per CgroupResourceUsageSamplingInterval, and requests
+    // in between are served from the last sweep. A cgroup that is requested for the first time is
+    // read right away and tracked from then on.
+    //
+    // Both the cgroup v1 (cpuacct and memory controllers) and the cgroup v2 (unified) hierarchies are
+    // supported. The CPU usage is reported in 100ns units like the job object accounting on Windows and
+    // the memory usage excludes the inactive page cache.
+    //
+    class CgroupResourceSampler
+        : protected Common::TextTraceComponent<Common::TraceTaskCodes::Hosting>
+    {
+        DENY_COPY(CgroupResourceSampler)
+
+    public:
+        CgroupResourceSampler(std::wstring const & traceId, std::string const & cgroupRoot = "/sys/fs/cgroup");
+
+        __declspec(property(get=get_IsUnified)) bool IsUnified;
+        bool get_IsUnified() const { return isUnified_; }
+
+        __declspec(property(get=get_TrackedCount)) size_t TrackedCount;
+        size_t get_TrackedCount() const;
+
+        // Returns false if the accounting files of the cgroup cannot be read, e.g. because it was removed
+        bool TryGetUsage(std::wstring const & cgroupName, __out Management::ResourceMonitor::ResourceMeasurement & measurement);
+
+        //
+        // Gets the cgroup of a process from /proc/<pid>/cgroup, in the form TryGetUsage expects. The layout
+        // depends on the cgroup driver of the container runtime (e.g. /docker/<id> with cgroupfs,
+        // /system.slice/docker-<id>.scope with systemd), so it is read instead of built.
+        //
+        bool TryGetProcessCgroup(DWORD pid, __out std::wstring & cgroupName) const;
+
+        // Parses the content of /proc/<pid>/cgroup: the unified hierarchy entry, or the cpuacct one for cgroup v1
+        static bool TryParseProcessCgroup(std::string const & content, bool isUnified, __out std::string & cgroupName);
+
+    private:
+        struct Sample
+        {
+            Management::ResourceMonitor::ResourceMeasurement Measurement;
+            Common::StopwatchTime LastRequested;
+        };
+
+        void SweepCallerHoldsLock(Common::StopwatchTime now);
+        bool TryRead(std::string const & cgroupName, __out Management::ResourceMonitor::ResourceMeasurement & measurement) const;
+
+        static bool TryReadValue(std::string const & path, __out uint64 & value);
+        static bool TryReadKeyValue(std::string const & path, char const * key, __out uint64 & value);
+
+        std::wstring const traceId_;
+        std::string const cgroupRoot_;
+        bool const isUnified_;
+
+        mutable Common::RwLock lock_;
+        std::map<std::string, Sample> samples_;
+        Common::StopwatchTime lastSweep_;
+    };
+}
@@ -479,6 +479,7 @@ wstring ContainerConfig::GetDnsSearchOptions(wstring const & appName)
 }
 
 Common::WStringLiteral const CreateContainerResponse::IdParameter(L"Id");
+Common::WStringLiteral const ContainerInspectResponse::IdParameter(L"Id");
 
 CreateContainerResponse::CreateContainerResponse() : Id()
 {
@@ -495,6 +496,9 @@ GetContainerResponse::GetContainerResponse()
 GetContainerResponse::~GetContainerResponse(){}
 
 ContainerState::ContainerState()
+    : Error()
+    , Pid(0)
+    , IsDead(false)
 {}
 
 ContainerState::~ContainerState()
@@ -126,19 +126,6 @@ namespace Hosting2
         static double const DockerVersionThreshold;
     };
 
-    class ContainerInspectResponse : public Common::IFabricJsonSerializable
-    {
-    public:
-        ContainerInspectResponse() = default;
-        ~ContainerInspectResponse() = default;
-
-        BEGIN_JSON_SERIALIZABLE_PROPERTIES()
-            SERIALIZABLE_PROPERTY(ContainerConfig::HostConfigParameter, HostConfig)
-        END_JSON_SERIALIZABLE_PROPERTIES()
-
-        ContainerHostConfig HostConfig;
-    };
-
     class CreateContainerResponse : public Common::IFabricJsonSerializable
     {
     public:
@@ -190,6 +177,25 @@ namespace Hosting2
         static Common::WStringLiteral const StateParameter;
     };
 
+    class ContainerInspectResponse : public Common::IFabricJsonSerializable
+    {
+    public:
+        ContainerInspectResponse() = default;
+        ~ContainerInspectResponse() = default;
+
+        BEGIN_JSON_SERIALIZABLE_PROPERTIES()
+            SERIALIZABLE_PROPERTY(ContainerInspectResponse::IdParameter, Id)
+            SERIALIZABLE_PROPERTY(ContainerConfig::HostConfigParameter, HostConfig)
+            SERIALIZABLE_PROPERTY(GetContainerResponse::StateParameter, State)
+        END_JSON_SERIALIZABLE_PROPERTIES()
+
+        std::wstring Id;
+        ContainerHostConfig HostConfig;
+        ContainerState State;
+
+        static Common::WStringLiteral const IdParameter;
+    };
+
     class DockerResponse : public Common::IFabricJsonSerializable
     {
     public:
@@ -695,6 +695,10 @@ private:
             return; // ImageCache is disabled
         }
 
+        // The package content cache is shared across application types, its entries expire when unused
+        PackageContentCache contentCache(owner_.hosting_.ImageCacheFolder, owner_.Root.TraceId);
+        contentCache.Prune(HostingConfig::GetConfig().PackageContentCacheRetention);
+
         wstring imageCacheStoreFolder = Path::Combine(owner_.hosting_.ImageCacheFolder, L"Store");
 
         AppTypeContentMap imageCacheContent;
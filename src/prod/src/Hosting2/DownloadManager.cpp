@@ -496,6 +496,173 @@ protected:
         return error;
     }
 
+    // A code, config or data package of a service package
+    struct SubPackageDownload
+    {
+        SubPackageDownload(
+            wstring && storePath,
+            wstring && storeChecksumPath,
+            wstring const & expectedChecksumValue,
+            wstring && targetPath,
+            wstring && linkPath,
+            bool allowHardLinks)
+            : StorePath(move(storePath)),
+            StoreChecksumPath(move(storeChecksumPath)),
+            ExpectedChecksumValue(expectedChecksumValue),
+            TargetPath(move(targetPath)),
+            LinkPath(move(linkPath)),
+            AllowHardLinks(allowHardLinks)
+        {
+        }
+
+        wstring StorePath;
+        wstring StoreChecksumPath;
+        wstring ExpectedChecksumValue;
+        // The run layout folder, or the shared layout folder for shared packages
+        wstring TargetPath;
+        // Set for shared packages: the run layout folder that is linked to TargetPath
+        wstring LinkPath;
+        // Data packages can be written by the application and are always copied
+        bool AllowHardLinks;
+    };
+
+    // Downloads the packages on up to MaxParallelPackageDownloads threads, including the calling thread.
+    // The calling thread keeps taking packages until none is left, so the download completes even if the
+    // posted workers do not get a thread.
+    ErrorCode DownloadSubPackages(vector<SubPackageDownload> const & downloads)
+    {
+        if (downloads.empty())
+        {
+            return ErrorCodeValue::Success;
+        }
+
+        struct DownloadState
+        {
+            explicit DownloadState(size_t count) : Count(count), Next(0), Completed(0), Error(), Lock(), CompletedEvent(false) { }
+
+            size_t const Count;
+            atomic_uint64 Next;
+            size_t Completed;
+            ErrorCode Error;
+            ExclusiveLock Lock;
+            ManualResetEvent CompletedEvent;
+        };
+
+        auto state = make_shared<DownloadState>(downloads.size());
+
+        // Workers that start after all packages are taken only touch the state
+        auto worker = [this, &downloads, state]()
+        {
+            for (;;)
+            {
+                size_t index = static_cast<size_t>(state->Next++);
+                if (index >= state->Count)
+                {
+                    return;
+                }
+
+                ErrorCode error;
+                {
+                    AcquireExclusiveLock lock(state->Lock);
+                    error = state->Error;
+                }
+
+                // Skip the remaining packages once one of them failed
+                if (error.IsSuccess())
+                {
+                    error = this->DownloadSubPackage(downloads[index]);
+                }
+
+                AcquireExclusiveLock lock(state->Lock);
+                if (!error.IsSuccess() && state->Error.IsSuccess())
+                {
+                    state->Error = error;
+                }
+
+                if (++state->Completed == state->Count)
+                {
+                    state->CompletedEvent.Set();
+                }
+            }
+        };
+
+        int maxParallelDownloads = max(1, HostingConfig::GetConfig().MaxParallelPackageDownloads);
+        size_t workerCount = min(downloads.size(), static_cast<size_t>(maxParallelDownloads));
+        for (size_t i = 1; i < workerCount; ++i)
+        {
+            Threadpool::Post([worker]() { worker(); });
+        }
+
+        worker();
+        state->CompletedEvent.WaitOne();
+
+        AcquireExclusiveLock lock(state->Lock);
+        if (!state->Error.IsSuccess())
+        {
+            return state->Error;
+        }
+
+        for (auto const & download : downloads)
+        {
+            if (!download.LinkPath.empty() && !Directory::IsSymbolicLink(download.LinkPath))
+            {
+                ArrayPair<wstring, wstring> link;
+                link.key = download.LinkPath;
+                link.value = download.TargetPath;
+                this->symbolicLinks_.push_back(link);
+            }
+        }
+
+        return ErrorCodeValue::Success;
+    }
+
+    // Materializes the package from the package content cache when the same content was downloaded before,
+    // for any application type, version or instance. Otherwise downloads and validates it from the store
+    // and adds it to the content cache.
+    ErrorCode DownloadSubPackage(SubPackageDownload const & download)
+    {
+        auto const & contentCache = owner_.contentCache_;
+        bool useContentCache =
+            contentCache &&
+            !download.ExpectedChecksumValue.empty() &&
+            HostingConfig::GetConfig().EnablePackageContentCache;
+        bool useHardLinks = download.AllowHardLinks && HostingConfig::GetConfig().PackageContentCacheUseHardLinks;
+
+        if (useContentCache)
+        {
+            auto error = contentCache->Materialize(download.ExpectedChecksumValue, download.TargetPath, useHardLinks);
+            if (error.IsSuccess())
+            {
+                return error;
+            }
+
+            if (!error.IsError(ErrorCodeValue::NotFound))
+            {
+                WriteInfo(
+                    Trace_DownloadManager,
+                    owner_.Root.TraceId,
+                    "Materializing {0} from the package content cache failed with {1}, downloading from the store",
+                    download.TargetPath,
+                    error);
+            }
+        }
+
+        auto error = CopySubPackageFromStore(
+            download.StorePath,
+            download.TargetPath,
+            download.StoreChecksumPath,
+            download.ExpectedChecksumValue);
+
+        // Added from the target folder rather than the ImageCache, since the ImageCache is overwritten in
+        // place when it is stale. Files in the target folder are never overwritten by the download.
+        if (error.IsSuccess() && useContentCache)
+        {
+            contentCache->Add(download.ExpectedChecksumValue, download.TargetPath, useHardLinks).ReadValue();
+        }
+
+        return error;
+    }
+
     virtual AsyncOperationSPtr BeginDownloadContent(
         AsyncCallback const & callback,
         AsyncOperationSPtr const & parent) = 0;
@@ -1665,19 +1832,19 @@ protected:
             return error;
         }
 
-        error = GetCodePackages(servicePackageDescription_);
-        if (!error.IsSuccess()) { return error; }
+        // Code, config and data packages are downloaded together in parallel
+        vector<SubPackageDownload> downloads;
 
-        error = GetConfigPackages(servicePackageDescription_);
+        error = GetCodePackages(servicePackageDescription_, downloads);
         if (!error.IsSuccess()) { return error; }
 
-        error = GetDataPackages(servicePackageDescription_);
-        if (!error.IsSuccess()) { return error; }
+        GetConfigPackages(servicePackageDescription_, downloads);
+        GetDataPackages(servicePackageDescription_, downloads);
 
-        return error;
+        return DownloadSubPackages(downloads);
     }
 
-    ErrorCode GetCodePackages(ServicePackageDescription const & servicePackage)
+    ErrorCode GetCodePackages(ServicePackageDescription const & servicePackage, __inout vector<SubPackageDownload> & downloads)
     {
         ErrorCode error = ErrorCodeValue::Success;
         containerImages_.clear();
@@ -1724,31 +1891,23 @@ protected:
                         iter->CodePackage.Name,
                         iter->CodePackage.Version);
 
-                    error = CopySubPackageFromStore(
-                        storeCodePackagePath,
-                        sharedCodePackagePath,
-                        storeCodePackageChecksumPath,
-                        iter->ContentChecksum);
-
-                    if (error.IsSuccess() && !Directory::IsSymbolicLink(runCodePackagePath))
-                    {
-                        ArrayPair<wstring, wstring> link;
-                        link.key = runCodePackagePath;
-                        link.value = sharedCodePackagePath;
-                        this->symbolicLinks_.push_back(link);
-                    }
+                    downloads.push_back(SubPackageDownload(
+                        move(storeCodePackagePath),
+                        move(storeCodePackageChecksumPath),
+                        iter->ContentChecksum,
+                        move(sharedCodePackagePath),
+                        wstring(runCodePackagePath),
+                        true)); // allowHardLinks
                 }
                 else
                 {
-                    error = CopySubPackageFromStore(
-                        storeCodePackagePath,
-                        runCodePackagePath,
-                        storeCodePackageChecksumPath,
-                        iter->ContentChecksum);
-                }
-                if (!error.IsSuccess())
-                {
-                    return error;
+                    downloads.push_back(SubPackageDownload(
+                        move(storeCodePackagePath),
+                        move(storeCodePackageChecksumPath),
+                        iter->ContentChecksum,
+                        wstring(runCodePackagePath),
+                        wstring(),
+                        true)); // allowHardLinks
                 }
 
                 if (!iter->CodePackage.EntryPoint.ContainerEntryPoint.FromSource.empty())
@@ -1778,13 +1937,12 @@ protected:
                         iter->ContainerPolicies.RepositoryCredentials));
             }
         }
+
         return error;
     }
 
-    ErrorCode GetConfigPackages(ServicePackageDescription const & servicePackage)
+    void GetConfigPackages(ServicePackageDescription const & servicePackage, __inout vector<SubPackageDownload> & downloads)
     {
-        ErrorCode error = ErrorCodeValue::Success;
-
         for (auto iter = servicePackage.DigestedConfigPackages.begin();
             iter != servicePackage.DigestedConfigPackages.end();
             ++iter)
@@ -1823,41 +1981,29 @@ protected:
                     iter->ConfigPackage.Name,
                     iter->ConfigPackage.Version);
 
-                error = CopySubPackageFromStore(
-                    storeConfigPackagePath,
-                    sharedConfigPackagePath,
-                    storeConfigPackageChecksumPath,
-                    iter->ContentChecksum);
-
-                if (error.IsSuccess() && !Directory::IsSymbolicLink(runConfigPackagePath))
-                {
-                    ArrayPair<wstring, wstring> link;
-                    link.key = runConfigPackagePath;
-                    link.value = sharedConfigPackagePath;
-                    this->symbolicLinks_.push_back(link);
-                }
+                downloads.push_back(SubPackageDownload(
+                    move(storeConfigPackagePath),
+                    move(storeConfigPackageChecksumPath),
+                    iter->ContentChecksum,
+                    move(sharedConfigPackagePath),
+                    move(runConfigPackagePath),
+                    true)); // allowHardLinks
             }
             else
             {
-                error = CopySubPackageFromStore(
-                    storeConfigPackagePath,
-                    runConfigPackagePath,
-                    storeConfigPackageChecksumPath,
-                    iter->ContentChecksum);
-            }
-            if (!error.IsSuccess())
-            {
-                return error;
+                downloads.push_back(SubPackageDownload(
+                    move(storeConfigPackagePath),
+                    move(storeConfigPackageChecksumPath),
+                    iter->ContentChecksum,
+                    move(runConfigPackagePath),
+                    wstring(),
+                    true)); // allowHardLinks
             }
         }
-
-        return error;
     }
 
-    ErrorCode GetDataPackages(ServicePackageDescription const & servicePackage)
+    void GetDataPackages(ServicePackageDescription const & servicePackage, __inout vector<SubPackageDownload> & downloads)
     {
-        ErrorCode error = ErrorCodeValue::Success;
-
         for (auto iter = servicePackage.DigestedDataPackages.begin();
             iter != servicePackage.DigestedDataPackages.end();
             ++iter)
@@ -1896,36 +2042,25 @@ protected:
                     iter->DataPackage.Name,
                     iter->DataPackage.Version);
 
-                error = CopySubPackageFromStore(
-                    storeDataPackagePath,
-                    sharedDataPackagePath,
-                    storeDataPackageChecksumPath,
-                    iter->ContentChecksum);
-
-                if (error.IsSuccess() && !Directory::IsSymbolicLink(runDataPackagePath))
-                {
-                    ArrayPair<wstring, wstring> link;
-                    link.key = runDataPackagePath;
-                    link.value = sharedDataPackagePath;
-                    this->symbolicLinks_.push_back(link);
-                }
+                downloads.push_back(SubPackageDownload(
+                    move(storeDataPackagePath),
+                    move(storeDataPackageChecksumPath),
+                    iter->ContentChecksum,
+                    move(sharedDataPackagePath),
+                    move(runDataPackagePath),
+                    false)); // allowHardLinks
             }
             else
             {
-                error = CopySubPackageFromStore(
-                    storeDataPackagePath,
-                    runDataPackagePath,
-                    storeDataPackageChecksumPath,
-                    iter->ContentChecksum);
-            }
-
-            if (!error.IsSuccess())
-            {
-                return error;
+                downloads.push_back(SubPackageDownload(
+                    move(storeDataPackagePath),
+                    move(storeDataPackageChecksumPath),
+                    iter->ContentChecksum,
+                    move(runDataPackagePath),
+                    wstring(),
+                    false)); // allowHardLinks
             }
         }
-
-        return error;
     }
 
     virtual ErrorCode OnRegisterComponent()
@@ -3021,6 +3156,7 @@ DownloadManager::DownloadManager(
     fabricUpgradeStoreLayout_(),
     sharedLayout_(Path::Combine(hosting.DeploymentFolder, Constants::SharedFolderName)),
     imageStore_(),
+    contentCache_(hosting.ImageCacheFolder.empty() ? nullptr : make_unique<PackageContentCache>(hosting.ImageCacheFolder, root.TraceId)),
     nodeConfig_(nodeConfig),
     pendingDownloads_(),
     nonRetryableFailedDownloads_(),
@@ -180,6 +180,8 @@ namespace Hosting2
         Management::ImageModel::StoreLayoutSpecification const sharedLayout_;
         PendingOperationMapUPtr pendingDownloads_;
         Management::ImageStore::ImageStoreUPtr imageStore_;
+        // Null when the ImageCache is disabled
+        std::unique_ptr<PackageContentCache> contentCache_;
         Common::FabricNodeConfigSPtr nodeConfig_;
         Api::IClientFactoryPtr passThroughClientFactoryPtr_;
         Common::SynchronizedMap<std::wstring, Common::ErrorCode> nonRetryableFailedDownloads_;
@@ -65,6 +65,7 @@
 #include "Hosting2/ProcessActivationContext.Linux.h"
 #include "Hosting2/ProcessConsoleRedirector.Linux.h"
 #include "Hosting2/DockerClient.h"
+#include "Hosting2/CgroupResourceSampler.h"
 #endif
 #if !defined(PLATFORM_UNIX)
 #include "Hosting2/ProcessActivator.h"
@@ -157,6 +158,7 @@
 #include "Hosting2/ApplicationManager.h"
 #include "Hosting2/Activator.h"
 #include "Hosting2/Deactivator.h"
+#include "Hosting2/PackageContentCache.h"
 #include "Hosting2/DownloadManager.h"
 #include "Hosting2/DeletionManager.h"
 #include "Hosting2/FabricUpgradeImpl.h"
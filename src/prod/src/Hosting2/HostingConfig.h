@@ -143,6 +143,18 @@ namespace Hosting2
         // Backoff internval on failure during Cache Cleanup
         INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"Hosting", CacheCleanupBackoffInternval, Common::TimeSpan::FromSeconds(10), Common::ConfigEntryUpgradePolicy::Dynamic);
 
+        // -------------- Package content cache settings
+        // Reuses the code, config and data packages in the ImageCache across application types, versions and instances by their content checksum.
+        // Off by default: without hard links, packages are copied into and out of the cache, which costs more disk I/O and space than it saves.
+        INTERNAL_CONFIG_ENTRY(bool, L"Hosting", EnablePackageContentCache, false, Common::ConfigEntryUpgradePolicy::Dynamic);
+        // Materializes code and config packages from the package content cache with hard links instead of copies.
+        // Off by default since hard links share the file permissions and ACLs set on the application folders with the cache and other applications.
+        INTERNAL_CONFIG_ENTRY(bool, L"Hosting", PackageContentCacheUseHardLinks, false, Common::ConfigEntryUpgradePolicy::Dynamic);
+        // Package content cache entries not used for this interval are removed by the cache cleanup
+        INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"Hosting", PackageContentCacheRetention, Common::TimeSpan::FromHours(24), Common::ConfigEntryUpgradePolicy::Dynamic);
+        // The maximum number of code, config and data packages of a service package that are downloaded in parallel
+        INTERNAL_CONFIG_ENTRY(int, L"Hosting", MaxParallelPackageDownloads, 4, Common::ConfigEntryUpgradePolicy::Dynamic);
+
         // Maximum number of continous failures before giving up on CacheCleanup
         INTERNAL_CONFIG_ENTRY(uint, L"Hosting", CacheCleanupMaxContinuousFailures, 3, Common::ConfigEntryUpgradePolicy::Dynamic);
 
@@ -192,6 +204,16 @@ namespace Hosting2
         PUBLIC_CONFIG_ENTRY(std::wstring, L"Hosting", ContainerGroupEntrypoint, L"", Common::ConfigEntryUpgradePolicy::Static);
         //The primary directory of external executable commands on the node.
         PUBLIC_CONFIG_ENTRY(std::wstring, L"Hosting", LinuxExternalExecutablePath, L"/usr/bin/", Common::ConfigEntryUpgradePolicy::Static);
+        //Launch processes with clone(CLONE_VM|CLONE_VFORK), which does not copy the page tables of FabricHost.
+        //Processes that are placed in a cgroup are always launched with fork.
+        INTERNAL_CONFIG_ENTRY(bool, L"Hosting", UseVforkProcessLaunch, true, Common::ConfigEntryUpgradePolicy::Static);
+        //Reads the resource usage of code packages and containers that are placed in a cgroup from the cgroup accounting files
+        //instead of querying the container runtime.
+        INTERNAL_CONFIG_ENTRY(bool, L"Hosting", EnableCgroupResourceUsageSampling, true, Common::ConfigEntryUpgradePolicy::Dynamic);
+        //The accounting files of all sampled cgroups are read together at most once per this interval.
+        INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"Hosting", CgroupResourceUsageSamplingInterval, Common::TimeSpan::FromSeconds(30), Common::ConfigEntryUpgradePolicy::Dynamic);
+        //A cgroup whose resource usage was not requested for this interval is no longer sampled.
+        INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"Hosting", CgroupResourceUsageRetention, Common::TimeSpan::FromMinutes(10), Common::ConfigEntryUpgradePolicy::Dynamic);
 #else
         PUBLIC_CONFIG_ENTRY(std::wstring, L"Hosting", ContainerGroupRootImageName, L"microsoft/nanoserver:latest", Common::ConfigEntryUpgradePolicy::Static);
         PUBLIC_CONFIG_ENTRY(std::wstring, L"Hosting", ContainerGroupEntrypoint, L"powershell.exe", Common::ConfigEntryUpgradePolicy::Static);
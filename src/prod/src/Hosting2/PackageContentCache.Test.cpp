@@ -0,0 +1,174 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+using namespace std;
+using namespace Common;
+using namespace Hosting2;
+
+class PackageContentCacheTestClass
+{
+protected:
+    PackageContentCacheTestClass()
+        : rootFolder_(Path::Combine(Directory::GetCurrentDirectory(), L"PackageContentCacheTest"))
+    {
+        BOOST_REQUIRE(Setup());
+    }
+
+    TEST_CLASS_SETUP(Setup);
+    ~PackageContentCacheTestClass() { BOOST_REQUIRE(Cleanup()); }
+    TEST_CLASS_CLEANUP(Cleanup);
+
+    void CreatePackage(wstring const & folder);
+    void VerifyPackage(wstring const & folder);
+
+    static void WriteFile(wstring const & path, string const & content);
+    static string ReadFile(wstring const & path);
+
+    wstring rootFolder_;
+};
+
+BOOST_FIXTURE_TEST_SUITE(PackageContentCacheTestClassSuite, PackageContentCacheTestClass)
+
+BOOST_AUTO_TEST_CASE(AddAndMaterializeTest)
+{
+    PackageContentCache cache(Path::Combine(rootFolder_, L"ImageCache"), L"PackageContentCacheTest");
+
+    wstring downloadedFolder = Path::Combine(Path::Combine(rootFolder_, L"App1"), L"Code.1.0");
+    CreatePackage(downloadedFolder);
+
+    wstring checksum(L"0A1B+2c3D/4e5F==");
+
+    VERIFY_IS_TRUE(cache.Materialize(checksum, Path::Combine(Path::Combine(rootFolder_, L"App2"), L"Code.2.0"), true).IsError(ErrorCodeValue::NotFound));
+
+    VERIFY_IS_TRUE(cache.Add(checksum, downloadedFolder, true).IsSuccess());
+    VERIFY_IS_TRUE(cache.Add(checksum, downloadedFolder, true).IsSuccess());
+
+    // Checksums are case insensitive
+    wstring upperChecksum = checksum;
+    StringUtility::ToUpper(upperChecksum);
+    wstring linkedFolder = Path::Combine(Path::Combine(rootFolder_, L"App2"), L"Code.2.0");
+    VERIFY_IS_TRUE(cache.Materialize(upperChecksum, linkedFolder, true).IsSuccess());
+    VerifyPackage(linkedFolder);
+
+    wstring copiedFolder = Path::Combine(Path::Combine(rootFolder_, L"App3"), L"Code.2.0");
+    VERIFY_IS_TRUE(cache.Materialize(checksum, copiedFolder, false).IsSuccess());
+    VerifyPackage(copiedFolder);
+
+    // Existing files in the target are kept
+    WriteFile(Path::Combine(copiedFolder, L"Setup.cmd"), "modified");
+    VERIFY_IS_TRUE(cache.Materialize(checksum, copiedFolder, false).IsSuccess());
+    VERIFY_ARE_EQUAL(string("modified"), ReadFile(Path::Combine(copiedFolder, L"Setup.cmd")));
+
+    // Checksums that only differ in characters that are escaped have different entries
+    VERIFY_IS_TRUE(cache.Materialize(L"0A1B/2c3D+4e5F==", Path::Combine(Path::Combine(rootFolder_, L"App4"), L"Code.2.0"), true).IsError(ErrorCodeValue::NotFound));
+}
+
+BOOST_AUTO_TEST_CASE(PruneTest)
+{
+    PackageContentCache cache(Path::Combine(rootFolder_, L"ImageCache"), L"PackageContentCacheTest");
+
+    wstring downloadedFolder = Path::Combine(Path::Combine(rootFolder_, L"App1"), L"Config.1.0");
+    CreatePackage(downloadedFolder);
+
+    VERIFY_IS_TRUE(cache.Add(L"ABCDEF", downloadedFolder, true).IsSuccess());
+
+    cache.Prune(TimeSpan::FromHours(1));
+    VERIFY_IS_TRUE(cache.Materialize(L"ABCDEF", Path::Combine(Path::Combine(rootFolder_, L"App2"), L"Config.1.0"), true).IsSuccess());
+
+    cache.Prune(TimeSpan::Zero);
+    VERIFY_IS_TRUE(cache.Materialize(L"ABCDEF", Path::Combine(Path::Combine(rootFolder_, L"App3"), L"Config.1.0"), true).IsError(ErrorCodeValue::NotFound));
+
+    // Files materialized before the entry was pruned are not affected
+    VerifyPackage(Path::Combine(Path::Combine(rootFolder_, L"App2"), L"Config.1.0"));
+    VERIFY_ARE_EQUAL(0u, Directory::GetSubDirectories(cache.ContentFolder).size());
+}
+
+BOOST_AUTO_TEST_CASE(PruneSkipsLockedEntryTest)
+{
+    PackageContentCache cache(Path::Combine(rootFolder_, L"ImageCache"), L"PackageContentCacheTest");
+
+    wstring downloadedFolder = Path::Combine(Path::Combine(rootFolder_, L"App1"), L"Data.1.0");
+    CreatePackage(downloadedFolder);
+
+    VERIFY_IS_TRUE(cache.Add(L"ABCDEF", downloadedFolder, false).IsSuccess());
+
+    {
+        // Held by a concurrent Materialize of the same content
+        FileReaderLock readerLock(Path::Combine(cache.ContentFolder, L"abcdef"));
+        VERIFY_IS_TRUE(readerLock.Acquire().IsSuccess());
+
+        cache.Prune(TimeSpan::Zero);
+        VERIFY_ARE_EQUAL(1u, Directory::GetSubDirectories(cache.ContentFolder).size());
+    }
+
+    VERIFY_IS_TRUE(cache.Materialize(L"ABCDEF", Path::Combine(Path::Combine(rootFolder_, L"App2"), L"Data.1.0"), false).IsSuccess());
+    VerifyPackage(Path::Combine(Path::Combine(rootFolder_, L"App2"), L"Data.1.0"));
+
+    cache.Prune(TimeSpan::Zero);
+    VERIFY_ARE_EQUAL(0u, Directory::GetSubDirectories(cache.ContentFolder).size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+bool PackageContentCacheTestClass::Setup()
+{
+    if (Directory::Exists(rootFolder_))
+    {
+        Directory::Delete(rootFolder_, true, true).ReadValue();
+    }
+
+    return Directory::Create2(rootFolder_).IsSuccess();
+}
+
+bool PackageContentCacheTestClass::Cleanup()
+{
+    return Directory::Delete(rootFolder_, true, true).IsSuccess();
+}
+
+void PackageContentCacheTestClass::CreatePackage(wstring const & folder)
+{
+    VERIFY_IS_TRUE(Directory::Create2(Path::Combine(Path::Combine(folder, L"bin"), L"x64")).IsSuccess());
+    VERIFY_IS_TRUE(Directory::Create2(Path::Combine(folder, L"empty")).IsSuccess());
+
+    WriteFile(Path::Combine(folder, L"Setup.cmd"), "setup");
+    WriteFile(Path::Combine(Path::Combine(folder, L"bin"), L"Service.exe"), "service");
+    WriteFile(Path::Combine(Path::Combine(Path::Combine(folder, L"bin"), L"x64"), L"Native.dll"), "native");
+}
+
+void PackageContentCacheTestClass::VerifyPackage(wstring const & folder)
+{
+    VERIFY_IS_TRUE(Directory::Exists(Path::Combine(folder, L"empty")));
+    VERIFY_ARE_EQUAL(string("setup"), ReadFile(Path::Combine(folder, L"Setup.cmd")));
+    VERIFY_ARE_EQUAL(string("service"), ReadFile(Path::Combine(Path::Combine(folder, L"bin"), L"Service.exe")));
+    VERIFY_ARE_EQUAL(string("native"), ReadFile(Path::Combine(Path::Combine(Path::Combine(folder, L"bin"), L"x64"), L"Native.dll")));
+}
+
+void PackageContentCacheTestClass::WriteFile(wstring const & path, string const & content)
+{
+    File file;
+    VERIFY_IS_TRUE(file.TryOpen(path, FileMode::Create, FileAccess::Write, FileShare::None).IsSuccess());
+    DWORD bytesWritten = 0;
+    VERIFY_IS_TRUE(file.TryWrite2(content.c_str(), static_cast<int>(content.size()), bytesWritten).IsSuccess());
+    file.Close();
+}
+
+string PackageContentCacheTestClass::ReadFile(wstring const & path)
+{
+    File file;
+    VERIFY_IS_TRUE(file.TryOpen(path, FileMode::Open, FileAccess::Read, FileShare::Read).IsSuccess());
+
+    string content(static_cast<size_t>(file.size()), '\0');
+    DWORD bytesRead = 0;
+    VERIFY_IS_TRUE(file.TryRead2(&content[0], static_cast<int>(content.size()), bytesRead).IsSuccess());
+    file.Close();
+
+    content.resize(bytesRead);
+    return content;
+}
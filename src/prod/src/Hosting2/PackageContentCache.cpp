@@ -0,0 +1,283 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace std;
+using namespace Common;
+using namespace Hosting2;
+
+StringLiteral const Trace_PackageContentCache("PackageContentCache");
+
+namespace
+{
+    wstring const ContentFolderName(L"Content");
+    wstring const UsedMarkerExtension(L".used");
+    wstring const TempFolderExtension(L".tmp");
+    wstring const DeletingFolderExtension(L".deleting");
+    wstring const ReaderLockExtension(L".ReadLock");
+    wstring const WriterLockExtension(L".WriteLock");
+}
+
+PackageContentCache::PackageContentCache(wstring const & imageCacheFolder, wstring const & traceId)
+    : contentFolder_(Path::Combine(imageCacheFolder, ContentFolderName)),
+    traceId_(traceId)
+{
+}
+
+ErrorCode PackageContentCache::Materialize(wstring const & checksum, wstring const & targetFolder, bool useHardLinks)
+{
+    wstring entryFolder = GetEntryFolder(checksum);
+
+    // Prune renames and deletes the entry only while it holds the writer lock
+    FileReaderLock readerLock(entryFolder);
+    auto error = readerLock.Acquire();
+    if (!error.IsSuccess())
+    {
+        WriteInfo(
+            Trace_PackageContentCache,
+            traceId_,
+            "Materialize: failed to acquire the reader lock of {0}: ErrorCode={1}",
+            entryFolder,
+            error);
+        return error;
+    }
+
+    if (!Directory::Exists(entryFolder))
+    {
+        return ErrorCodeValue::NotFound;
+    }
+
+    error = LinkOrCopyFolder(entryFolder, targetFolder, useHardLinks);
+
+    WriteTrace(
+        error.ToLogLevel(LogLevel::Warning, LogLevel::Noise),
+        Trace_PackageContentCache,
+        traceId_,
+        "Materialize: ErrorCode={0}, Checksum={1}, Entry={2}, Target={3}, UseHardLinks={4}",
+        error,
+        checksum,
+        entryFolder,
+        targetFolder,
+        useHardLinks);
+
+    if (error.IsSuccess())
+    {
+        File::Touch(GetUsedMarkerFile(entryFolder)).ReadValue();
+    }
+
+    return error;
+}
+
+ErrorCode PackageContentCache::Add(wstring const & checksum, wstring const & sourceFolder, bool useHardLinks)
+{
+    wstring entryFolder = GetEntryFolder(checksum);
+    if (Directory::Exists(entryFolder))
+    {
+        return ErrorCodeValue::Success;
+    }
+
+    wstring tempFolder = wformatString("{0}.{1}{2}", entryFolder, Guid::NewGuid().ToString('N'), TempFolderExtension);
+
+    auto error = LinkOrCopyFolder(sourceFolder, tempFolder, useHardLinks);
+    if (error.IsSuccess())
+    {
+        // Synchronizes with Materialize and Prune of the same content
+        FileWriterLock writerLock(entryFolder);
+        error = writerLock.Acquire();
+        if (error.IsSuccess())
+        {
+            // Otherwise added concurrently by another download of the same content
+            if (!Directory::Exists(entryFolder))
+            {
+                error = Directory::Rename(tempFolder, entryFolder);
+            }
+
+            if (error.IsSuccess())
+            {
+                File::Touch(GetUsedMarkerFile(entryFolder)).ReadValue();
+            }
+        }
+    }
+
+    if (Directory::Exists(tempFolder))
+    {
+        Directory::Delete(tempFolder, true, true).ReadValue();
+    }
+
+    WriteTrace(
+        error.ToLogLevel(LogLevel::Warning, LogLevel::Info),
+        Trace_PackageContentCache,
+        traceId_,
+        "Add: ErrorCode={0}, Checksum={1}, Source={2}, Entry={3}, UseHardLinks={4}",
+        error,
+        checksum,
+        sourceFolder,
+        entryFolder,
+        useHardLinks);
+
+    return error;
+}
+
+void PackageContentCache::Prune(TimeSpan const unusedInterval)
+{
+    if (!Directory::Exists(contentFolder_))
+    {
+        return;
+    }
+
+    DateTime now = DateTime::Now();
+    size_t prunedCount = 0;
+
+    vector<wstring> folders = Directory::GetSubDirectories(contentFolder_, L"*", false /*fullPath*/, true /*topDirOnly*/);
+    for (auto const & folder : folders)
+    {
+        wstring folderPath = Path::Combine(contentFolder_, folder);
+        bool isEntry = (folder.find(L'.') == wstring::npos);
+
+        // Entries that are being materialized or added hold the lock, the used marker is checked under it
+        unique_ptr<FileWriterLock> writerLock;
+        if (isEntry)
+        {
+            writerLock = make_unique<FileWriterLock>(folderPath);
+            if (!writerLock->Acquire().IsSuccess())
+            {
+                continue;
+            }
+        }
+
+        DateTime lastUsedTime;
+        auto error = isEntry ?
+            File::GetLastWriteTime(GetUsedMarkerFile(folderPath), lastUsedTime) :
+            Directory::GetLastWriteTime(folderPath, lastUsedTime);
+        if (!error.IsSuccess())
+        {
+            error = Directory::GetLastWriteTime(folderPath, lastUsedTime);
+            if (!error.IsSuccess()) { continue; }
+        }
+
+        if (now - lastUsedTime < unusedInterval)
+        {
+            continue;
+        }
+
+        wstring folderToDelete = folderPath;
+        if (isEntry)
+        {
+            // Rename first so that the entry is never seen partially deleted
+            folderToDelete = wformatString("{0}.{1}{2}", folderPath, Guid::NewGuid().ToString('N'), DeletingFolderExtension);
+            error = Directory::Rename(folderPath, folderToDelete);
+            if (!error.IsSuccess())
+            {
+                WriteInfo(
+                    Trace_PackageContentCache,
+                    traceId_,
+                    "Prune: failed to rename {0}: ErrorCode={1}",
+                    folderPath,
+                    error);
+                continue;
+            }
+
+            File::Delete2(GetUsedMarkerFile(folderPath)).ReadValue();
+            writerLock->Release();
+        }
+
+        error = Directory::Delete(folderToDelete, true, true /*deleteReadOnlyFiles*/);
+        if (!error.IsSuccess())
+        {
+            WriteInfo(
+                Trace_PackageContentCache,
+                traceId_,
+                "Prune: failed to delete {0}: ErrorCode={1}",
+                folderToDelete,
+                error);
+            continue;
+        }
+
+        ++prunedCount;
+    }
+
+    WriteInfo(
+        Trace_PackageContentCache,
+        traceId_,
+        "Prune: removed {0} of {1} folders unused for {2}",
+        prunedCount,
+        folders.size(),
+        unusedInterval);
+}
+
+wstring PackageContentCache::GetEntryFolder(wstring const & checksum) const
+{
+    return Path::Combine(contentFolder_, GetEntryName(checksum));
+}
+
+// Checksums are compared case insensitively. Characters that are not valid in a file name
+// (base64 uses '/' and '+') are escaped, which keeps the names of different checksums distinct.
+wstring PackageContentCache::GetEntryName(wstring const & checksum)
+{
+    wstring name;
+    name.reserve(checksum.size());
+
+    for (wchar_t c : checksum)
+    {
+        if (iswalnum(c))
+        {
+            name.push_back(towlower(c));
+        }
+        else
+        {
+            name.append(wformatString("_{0:x}", static_cast<unsigned int>(c)));
+        }
+    }
+
+    return name;
+}
+
+wstring PackageContentCache::GetUsedMarkerFile(wstring const & entryFolder)
+{
+    return entryFolder + UsedMarkerExtension;
+}
+
+ErrorCode PackageContentCache::LinkOrCopyFolder(wstring const & sourceFolder, wstring const & targetFolder, bool useHardLinks)
+{
+    auto error = Directory::Create2(targetFolder);
+    if (!error.IsSuccess()) { return error; }
+
+    vector<wstring> subFolders = Directory::GetSubDirectories(sourceFolder, L"*", false /*fullPath*/, true /*topDirOnly*/);
+    for (auto const & subFolder : subFolders)
+    {
+        error = LinkOrCopyFolder(Path::Combine(sourceFolder, subFolder), Path::Combine(targetFolder, subFolder), useHardLinks);
+        if (!error.IsSuccess()) { return error; }
+    }
+
+    vector<wstring> files = Directory::GetFiles(sourceFolder, L"*", false /*fullPath*/, true /*topDirOnly*/);
+    for (auto const & file : files)
+    {
+        if (IsLockFile(file)) { continue; }
+
+        wstring sourceFile = Path::Combine(sourceFolder, file);
+        wstring targetFile = Path::Combine(targetFolder, file);
+
+        if (File::Exists(targetFile)) { continue; }
+
+        // Hard links fail across volumes and on file systems without support for them
+        if (useHardLinks && File::CreateHardLink(targetFile, sourceFile)) { continue; }
+
+        error = File::Copy(sourceFile, targetFile, false);
+        if (!error.IsSuccess())
+        {
+            File::Delete2(targetFile, true).ReadValue();
+            return error;
+        }
+    }
+
+    return ErrorCodeValue::Success;
+}
+
+bool PackageContentCache::IsLockFile(wstring const & fileName)
+{
+    return StringUtility::EndsWithCaseInsensitive(fileName, ReaderLockExtension) ||
+        StringUtility::EndsWithCaseInsensitive(fileName, WriterLockExtension);
+}
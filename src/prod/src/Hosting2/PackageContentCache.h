@@ -0,0 +1,53 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Hosting2
+{
+    //
+    // Content addressed store of the code, config and data packages downloaded to the node, keyed by
+    // the content checksum of the package. A package that was downloaded and validated once, for any
+    // application type, version or instance, is materialized from here instead of being downloaded
+    // and copied again. Files are hard linked when allowed and copied otherwise.
+    //
+    // Each entry is a folder under <ImageCache>\Content. An entry is populated in a temporary folder
+    // and renamed, so an existing entry folder is always complete. The <entry>.used file is touched
+    // every time the entry is used and drives Prune. Materialize holds the reader lock of the entry,
+    // Add and Prune hold its writer lock while they rename it.
+    //
+    class PackageContentCache
+        : protected Common::TextTraceComponent<Common::TraceTaskCodes::Hosting>
+    {
+        DENY_COPY(PackageContentCache)
+
+    public:
+        PackageContentCache(std::wstring const & imageCacheFolder, std::wstring const & traceId);
+
+        __declspec(property(get=get_ContentFolder)) std::wstring const & ContentFolder;
+        std::wstring const & get_ContentFolder() const { return contentFolder_; }
+
+        // Materializes the content with the checksum into the target folder. Files that already exist
+        // in the target folder are kept. Returns NotFound if the content is not in the cache.
+        Common::ErrorCode Materialize(std::wstring const & checksum, std::wstring const & targetFolder, bool useHardLinks);
+
+        // Adds the content of a downloaded and validated package folder under its checksum
+        Common::ErrorCode Add(std::wstring const & checksum, std::wstring const & sourceFolder, bool useHardLinks);
+
+        // Removes the entries that were not used for the given interval
+        void Prune(Common::TimeSpan const unusedInterval);
+
+    private:
+        std::wstring GetEntryFolder(std::wstring const & checksum) const;
+
+        static std::wstring GetEntryName(std::wstring const & checksum);
+        static std::wstring GetUsedMarkerFile(std::wstring const & entryFolder);
+        static Common::ErrorCode LinkOrCopyFolder(std::wstring const & sourceFolder, std::wstring const & targetFolder, bool useHardLinks);
+        static bool IsLockFile(std::wstring const & fileName);
+
+        std::wstring const contentFolder_;
+        std::wstring const traceId_;
+    };
+}
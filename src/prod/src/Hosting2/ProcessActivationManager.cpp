@@ -2247,6 +2247,10 @@ ProcessActivationManager::ProcessActivationManager(
         });
 
     containerActivator_ = move(containerActivator);
+
+#if defined(PLATFORM_UNIX)
+    cgroupResourceSampler_ = make_unique<CgroupResourceSampler>(root.TraceId);
+#endif
 }
 
 ProcessActivationManager::~ProcessActivationManager()
@@ -324,6 +324,9 @@ namespace Hosting2
         CrashDumpConfigurationManagerUPtr crashDumpConfigurationManager_;
         FirewallSecurityProviderUPtr firewallProvider_;
         IContainerActivatorUPtr containerActivator_;
+#if defined(PLATFORM_UNIX)
+        std::unique_ptr<CgroupResourceSampler> cgroupResourceSampler_;
+#endif
 
         Common::RwLock lock_;
         Common::RwLock registryAccessLock_;
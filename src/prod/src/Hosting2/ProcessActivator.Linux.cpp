@@ -15,6 +15,9 @@
 #include <sys/stat.h>
 #include <pwd.h>
 #include <grp.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
 
 using namespace std;
 using namespace Common;
@@ -119,11 +122,187 @@ public:
     }
 
 private:
+    // State handed to the child between its creation and execve. With Clone, the child runs on
+    // the address space of this process, so it only reports a failing step here and exits, and
+    // it must not allocate, trace or call wrappers that synchronize with the threads of this
+    // process (glibc setuid/setgid/setgroups do), hence the raw system calls in SetupChild.
+    struct ChildContext
+    {
+        ProcessStartupInfoItem * Item;
+        struct passwd * Pw;
+        gid_t * Groups;
+        int NGroups;
+        pid_t ParentPid;
+        struct cgroup * CgroupObj;
+        bool SharesAddressSpace;
+        sigset_t SignalMask;
+        char const * FailedStep;
+        int FailedErrno;
+    };
+
+    static const size_t ChildStackSize = 256 * 1024;
+
     sem_t queueSema_;
     pthread_mutex_t queueLock_;
     list<ProcessStartupInfoItem *> queue_;
+    char * childStack_;
+
+    // Creates the child with clone(CLONE_VM|CLONE_VFORK), which does not copy the page tables of
+    // this process, so the cost does not grow with its size. This thread is suspended until the
+    // child calls execve or exits.
+    pid_t Clone(ChildContext & context)
+    {
+        if (childStack_ == nullptr)
+        {
+            void * stack = mmap(nullptr, ChildStackSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+            if (stack == MAP_FAILED)
+            {
+                return -1;
+            }
+
+            childStack_ = static_cast<char*>(stack);
+        }
+
+        context.SharesAddressSpace = true;
+
+        // No signal handler of this process may run on the child before it has reset them
+        sigset_t allSignals;
+        sigfillset(&allSignals);
+        pthread_sigmask(SIG_BLOCK, &allSignals, &context.SignalMask);
+
+        pid_t pid = clone(RunChild, childStack_ + ChildStackSize, CLONE_VM | CLONE_VFORK | SIGCHLD, &context);
+        int cloneErrno = errno;
+
+        pthread_sigmask(SIG_SETMASK, &context.SignalMask, nullptr);
+
+        errno = cloneErrno;
+        return pid;
+    }
+
+    static int RunChild(void * arg)
+    {
+        ChildContext & context = *static_cast<ChildContext*>(arg);
+
+        if (context.SharesAddressSpace)
+        {
+            for (int sig = 1; sig < _NSIG; ++sig)
+            {
+                struct sigaction sa;
+                if (sigaction(sig, nullptr, &sa) == 0 && sa.sa_handler != SIG_DFL && sa.sa_handler != SIG_IGN)
+                {
+                    sa.sa_handler = SIG_DFL;
+                    sa.sa_flags = 0;
+                    sigemptyset(&sa.sa_mask);
+                    sigaction(sig, &sa, nullptr);
+                }
+            }
+
+            sigprocmask(SIG_SETMASK, &context.SignalMask, nullptr);
+        }
+        else if (context.CgroupObj)
+        {
+            //add the process to the appropriate cgroup
+            auto error = cgroup_attach_task_pid(context.CgroupObj, getpid());
+            if (error)
+            {
+                TraceWarning(TraceTaskCodes::Hosting, TraceType_Activator,
+                     "Cgroup process attach failed for {0} with error {1}, description of error if available {2}",
+                     context.Item->cgroupName_, error, cgroup_get_last_errno());
+                abort();
+            }
+        }
+
+        if (SetupChild(context))
+        {
+            // execute
+            execve(context.Item->filename_, context.Item->argv_, context.Item->envp_);
+            context.FailedStep = "execve";
+            context.FailedErrno = errno;
+        }
+
+        if (context.SharesAddressSpace)
+        {
+            _exit(127);
+        }
+
+        TraceWarning(TraceTaskCodes::Hosting, TraceType_Activator, "ProcessActivator: {0} failed for {1} with error {2}", context.FailedStep, context.Item->filename_, context.FailedErrno);
+        abort();
+    }
+
+    static bool SetupChild(ChildContext & context)
+    {
+        ProcessStartupInfoItem * item = context.Item;
+
+        if (item->workdir_)
+        {
+            // stays in the current directory if workdir_ is not an existing directory
+            chdir(item->workdir_);
+        }
+
+        // make it session leader
+        setsid();
+
+        // setup pseudo tty
+        int fdm, fds;
+        char pts_name[128];
+        fdm = posix_openpt(O_RDWR);
+        if (fdm < 0 || unlockpt(fdm) < 0
+            || ptsname_r(fdm, pts_name, sizeof(pts_name)) != 0
+            || (fds = open(pts_name, O_RDWR)) == 0
+            || ioctl(fds, TIOCSCTTY, NULL) < 0)
+        {
+            return ReportChildFailure(context, "setup ptty");
+        }
+
+        if (dup2(fds, STDIN_FILENO) < 0)
+        {
+            return ReportChildFailure(context, "dup stdio");
+        }
+
+        // set gid and groups
+        if (syscall(SYS_setgid, context.Pw->pw_gid) == -1)
+        {
+            return ReportChildFailure(context, "setgid");
+        }
+        if (0 == getuid() || 0 == geteuid())
+        {
+            if (syscall(SYS_setgroups, context.NGroups, context.Groups) == -1)
+            {
+                return ReportChildFailure(context, "setgroups");
+            }
+        }
+
+        // setuid
+        if (item->uid_ && syscall(SYS_setuid, item->uid_) != 0)
+        {
+            return ReportChildFailure(context, "setuid");
+        }
+
+        if (!item->detach_)
+        {
+            // if parent exits, signal SIGKILL
+            prctl(PR_SET_PDEATHSIG, SIGKILL);
+            if (context.ParentPid != getppid())
+            {
+                return ReportChildFailure(context, "parent check");
+            }
+        }
+
+        // umask
+        //umask(0002);
+
+        return true;
+    }
+
+    static bool ReportChildFailure(ChildContext & context, char const * step)
+    {
+        context.FailedStep = step;
+        context.FailedErrno = errno;
+        return false;
+    }
 
     ProcessActivatorThreadSingleton() 
+        : childStack_(nullptr)
     {
         pthread_mutex_init(&queueLock_, NULL);
         sem_init(&queueSema_, 0, 0);
@@ -187,7 +366,7 @@ private:
                 char* buf = new char[bufsz];
                 gid_t *groups = new gid_t[ngroups_max];
                 int ngroups = ngroups_max;
-                pid_t pID, ppid;
+                pid_t pID;
                 ProcessWait::WaitCallback exitCallback = item->callback_;
                 struct cgroup *cgroupObj = nullptr;
 
@@ -232,92 +411,42 @@ private:
                     }
                 }
 
-                ppid = getpid();
-                pID = fork();
-                if (pID == 0)  // child
                 {
-                    //add the process to the appropriate cgroup
-                    if (cgroupObj)
+                    ChildContext context = {};
+                    context.Item = item;
+                    context.Pw = pw;
+                    context.Groups = groups;
+                    context.NGroups = ngroups;
+                    context.ParentPid = getpid();
+                    context.CgroupObj = cgroupObj;
+
+                    // Processes that join a cgroup are attached by libcgroup in the child, which is
+                    // only safe when the child has its own copy of the address space
+                    if (cgroupObj == nullptr && HostingConfig::GetConfig().UseVforkProcessLaunch)
                     {
-                        auto error = cgroup_attach_task_pid(cgroupObj, getpid());
-                        if (error)
-                        {
-                            TraceWarning(TraceTaskCodes::Hosting, TraceType_Activator,
-                                 "Cgroup process attach failed for {0} with error {1}, description of error if available {2}",
-                                 item->cgroupName_, error, cgroup_get_last_errno());
-                            abort();
-                        }
-                    }
-                    if(item->workdir_)
-                    {
-                        DIR* dir = opendir(item->workdir_);
-                        if(dir)
-                        {
-                            closedir(dir);
-                            chdir(item->workdir_);
-                        }
-                    }
-
-                    // make it session leader
-                    setsid();
-
-                    // setup pseudo tty
-                    int fdm, fds;
-                    char* pts_name;
-                    fdm = posix_openpt(O_RDWR);
-                    if (fdm < 0 || unlockpt(fdm) < 0
-                        || (pts_name = ptsname(fdm)) == 0
-                        || (fds = open(pts_name, O_RDWR)) == 0
-                        || ioctl(fds, TIOCSCTTY, NULL) < 0)
-                    {
-                        TraceWarning(TraceTaskCodes::Hosting, TraceType_Activator, "ProcessActivator: setup ptty failed with error {0}", errno);
-                        abort();
-                    }
-
-                    if (dup2(fds, STDIN_FILENO) < 0)
-                    {
-                        TraceWarning(TraceTaskCodes::Hosting, TraceType_Activator, "ProcessActivator: dup stdio failed with error {0}", errno);
-                        abort();
+                        pID = pObj->Clone(context);
                     }
-
-                    // set gid and groups
-                    if (setgid(pw->pw_gid) == -1)
-                    {
-                        TraceWarning(TraceTaskCodes::Hosting, TraceType_Activator, "ProcessActivator: setgid failed with error {0}", errno);
-                        abort();
-                    }
-                    if (0 == getuid() || 0 == geteuid())
+                    else
                     {
-                        if (setgroups(ngroups, groups) == -1)
+                        pID = fork();
+                        if (pID == 0)  // child
                         {
-                            TraceWarning(TraceTaskCodes::Hosting, TraceType_Activator, "ProcessActivator: setgroups failed with error {0}", errno);
-                            abort();
+                            RunChild(&context);
                         }
                     }
 
-                    // setuid
-                    if(item->uid_ && setuid(item->uid_) != 0)
+                    if (pID > 0 && context.FailedStep != nullptr)
                     {
-                        TraceWarning(TraceTaskCodes::Hosting, TraceType_Activator, "ProcessActivator: setuid failed with error {0}", errno);
-                        abort();
-                    }
+                        // only possible with Clone, the child has already exited
+                        TraceWarning(TraceTaskCodes::Hosting, TraceType_Activator,
+                            "ProcessActivator: {0} failed for {1} with error {2}",
+                            context.FailedStep, item->filename_, context.FailedErrno);
 
-                    if (!item->detach_)
-                    {
-                        // if parent exits, signal SIGKILL
-                        prctl(PR_SET_PDEATHSIG, SIGKILL);
-                        if (ppid != getppid()) abort();
+                        int status = 0;
+                        waitpid(pID, &status, 0);
+                        item->error_.Overwrite(ErrorCodeValue::OperationFailed);
+                        goto Cleanup;
                     }
-
-                    // umask
-                    //umask(0002);
-
-                    // execute
-                    auto retv=execve(item->filename_, item->argv_, item->envp_);
-                    TraceInfo(TraceTaskCodes::Hosting, TraceType_Activator, "ProcessActivator: execve failed to start {0}. ret={1}, err={2}", item->filename_, retv, errno);
-
-                    // in case execve fails
-                    abort();
                 }
 
                 // parent
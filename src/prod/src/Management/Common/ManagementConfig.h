@@ -191,6 +191,11 @@ namespace Management
         INTERNAL_CONFIG_ENTRY(double, L"HealthManager", MessageContentBufferRatio, 0.75, Common::ConfigEntryUpgradePolicy::Dynamic, Common::InRange<double>(0.0, 1.0));
         // The maximum number of job items that can be executed in the same transaction by an entity
         INTERNAL_CONFIG_ENTRY(int, L"HealthManager", MaxEntityJobItemBatchCount, 32, Common::ConfigEntryUpgradePolicy::Dynamic, Common::GreaterThan(0));
+        // The fraction of the time to live that may elapse since a transient event (RemoveWhenExpired) was last persisted
+        // before a refresh with unchanged state and description is written to the store again. Until then, refreshes only update
+        // the in-memory event. On failover, transient events expire based on the persisted time, so this bounds the lifetime lost.
+        // 0 persists every refresh of transient events, which is the default.
+        INTERNAL_CONFIG_ENTRY(double, L"HealthManager", TransientHealthEventInMemoryRefreshRatio, 0.0, Common::ConfigEntryUpgradePolicy::Dynamic, Common::InRange<double>(0.0, 1.0));
         // The time close replica waits for the job queue to finish before bringing down the process
         INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"HealthManager", MaxCloseJobQueueWaitDuration, Common::TimeSpan::FromMinutes(5), Common::ConfigEntryUpgradePolicy::Dynamic, Common::TimeSpanGreaterThan(Common::TimeSpan::FromMinutes(3)));
         // Enable extra tracing for the query job queue, to show thread ids for processing threads.
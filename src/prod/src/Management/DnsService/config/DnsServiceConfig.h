@@ -21,6 +21,7 @@ namespace DNS
         INTERNAL_CONFIG_ENTRY(int, L"DnsService", NumberOfConcurrentQueries, 100, Common::ConfigEntryUpgradePolicy::Static);
         INTERNAL_CONFIG_ENTRY(int, L"DnsService", MaxMessageSizeInKB, 8, Common::ConfigEntryUpgradePolicy::Static);
         INTERNAL_CONFIG_ENTRY(int, L"DnsService", MaxCacheSize, 5000, Common::ConfigEntryUpgradePolicy::Static);
+        INTERNAL_CONFIG_ENTRY(bool, L"DnsService", IsAnswerCacheEnabled, true, Common::ConfigEntryUpgradePolicy::Static);
         INTERNAL_CONFIG_ENTRY(int, L"DnsService", NDots, 1, Common::ConfigEntryUpgradePolicy::Static);
         INTERNAL_CONFIG_ENTRY(bool, L"DnsService", IsRecursiveQueryEnabled, true, Common::ConfigEntryUpgradePolicy::Static);
         INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"DnsService", TimeToLive, Common::TimeSpan::FromSeconds(1), Common::ConfigEntryUpgradePolicy::Static);
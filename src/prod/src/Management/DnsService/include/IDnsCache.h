@@ -63,6 +63,26 @@ namespace DNS
         virtual void UnregisterNotification(
             __in IDnsCacheNotification& notification
         ) = 0;
+
+        // Serialized answers are keyed by the whole question message except the transaction id.
+        // The answer is copied to the answer buffer with the transaction id of the question,
+        // question and answer can be the same buffer.
+        virtual bool TryGetAnswer(
+            __in KBuffer& question,
+            __in ULONG questionSize,
+            __out KBuffer& answer,
+            __out ULONG& answerSize
+        ) = 0;
+
+        virtual void PutAnswer(
+            __in KBuffer& question,
+            __in ULONG questionSize,
+            __in KBuffer& answer,
+            __in ULONG answerSize,
+            __in ULONG timeToLiveInSeconds
+        ) = 0;
+
+        virtual void ClearAnswers() = 0;
     };
 
     void CreateDnsCache(
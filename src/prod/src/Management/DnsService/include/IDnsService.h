@@ -36,7 +36,8 @@ namespace DNS
             NodeDnsCacheHealthCheckIntervalInSeconds(5),
             NumberOfConcurrentQueries(1),
             MaxMessageSizeInKB(8),
-            MaxCacheSize(5000)
+            MaxCacheSize(5000),
+            IsAnswerCacheEnabled(true)
         {
         }
 
@@ -51,6 +52,7 @@ namespace DNS
         ULONG NumberOfConcurrentQueries;
         ULONG MaxMessageSizeInKB;
         ULONG MaxCacheSize;
+        bool IsAnswerCacheEnabled;          // TRUE if serialized fabric answers are cached for TimeToLiveInSeconds
     };
 
     void CreateDnsService(
@@ -67,6 +67,7 @@ DnsCache::DnsCache(
 _htDnsToFabric(997, K_DefaultHashFunction, CompareKString, GetThisAllocator()),
 _htFabricToDns(997, K_DefaultHashFunction, CompareKString, GetThisAllocator()),
 _publicCache(GetThisAllocator(), maxSize),
+_answerCache(GetThisAllocator(), maxSize),
 _arrNotifications(GetThisAllocator())
 {
 }
@@ -88,6 +89,8 @@ void DnsCache::Remove(
     {
         _htFabricToDns.Remove(spServiceName);
         _htDnsToFabric.Remove(spDnsName);
+
+        ClearAnswers();
     }
 }
 
@@ -176,7 +179,16 @@ void DnsCache::Put(
 
         KString::SPtr spDns(&dnsName);
         KString::SPtr spFabric(&serviceName);
-        NTSTATUS status = _htDnsToFabric.Put(spDns, spFabric, TRUE/*forceUpdate*/);
+
+        // Cached answers are only stale when the name maps to a different service
+        KString::SPtr spExisting;
+        NTSTATUS status = _htDnsToFabric.Get(spDns, /*out*/spExisting);
+        if (status != STATUS_SUCCESS || !CompareKString(spExisting, spFabric))
+        {
+            ClearAnswers();
+        }
+
+        status = _htDnsToFabric.Put(spDns, spFabric, TRUE/*forceUpdate*/);
         if (status != STATUS_SUCCESS && status != STATUS_OBJECT_NAME_EXISTS)
         {
             KInvariant(false);
@@ -237,6 +249,38 @@ void DnsCache::UnregisterNotification(
     }
 }
 
+bool DnsCache::TryGetAnswer(
+    __in KBuffer& question,
+    __in ULONG questionSize,
+    __out KBuffer& answer,
+    __out ULONG& answerSize
+)
+{
+    StackSharedLock lock(_lockAnswers);
+
+    return _answerCache.TryGet(question, questionSize, /*out*/answer, /*out*/answerSize);
+}
+
+void DnsCache::PutAnswer(
+    __in KBuffer& question,
+    __in ULONG questionSize,
+    __in KBuffer& answer,
+    __in ULONG answerSize,
+    __in ULONG timeToLiveInSeconds
+)
+{
+    StackExLock lock(_lockAnswers);
+
+    _answerCache.Put(question, questionSize, answer, answerSize, timeToLiveInSeconds);
+}
+
+void DnsCache::ClearAnswers()
+{
+    StackExLock lock(_lockAnswers);
+
+    _answerCache.Clear();
+}
+
 void DnsCache::EnsureSize()
 {
     static double IncreaseFactor = 1.5;
@@ -345,3 +389,202 @@ void PublicNameCache::Remove(__in KString& name)
         _ht.Remove(spKey);
     }
 }
+
+
+/*static*/
+void DnsAnswerEntry::Create(
+    __out DnsAnswerEntry::SPtr& spEntry,
+    __in KAllocator& allocator,
+    __in ULONGLONG key,
+    __in KBuffer& question,
+    __in ULONG questionSize,
+    __in KBuffer& answer,
+    __in ULONG answerSize,
+    __in Common::StopwatchTime expiration
+)
+{
+    spEntry = _new(TAG, allocator) DnsAnswerEntry(key, question, questionSize, answer, answerSize, expiration);
+    KInvariant(spEntry != nullptr);
+    KInvariant(NT_SUCCESS(spEntry->Status()));
+}
+
+DnsAnswerEntry::DnsAnswerEntry(
+    __in ULONGLONG key,
+    __in KBuffer& question,
+    __in ULONG questionSize,
+    __in KBuffer& answer,
+    __in ULONG answerSize,
+    __in Common::StopwatchTime expiration
+) : _key(key),
+_questionSize(questionSize),
+_answerSize(answerSize),
+_expiration(expiration)
+{
+    NTSTATUS status = KBuffer::Create(questionSize, /*out*/_spQuestion, GetThisAllocator());
+    if (status != STATUS_SUCCESS)
+    {
+        SetConstructorStatus(status);
+        return;
+    }
+
+    status = KBuffer::Create(answerSize, /*out*/_spAnswer, GetThisAllocator());
+    if (status != STATUS_SUCCESS)
+    {
+        SetConstructorStatus(status);
+        return;
+    }
+
+    KMemCpySafe(_spQuestion->GetBuffer(), questionSize, question.GetBuffer(), questionSize);
+    KMemCpySafe(_spAnswer->GetBuffer(), answerSize, answer.GetBuffer(), answerSize);
+}
+
+DnsAnswerEntry::~DnsAnswerEntry()
+{
+}
+
+bool DnsAnswerEntry::IsSameQuestion(
+    __in KBuffer& question,
+    __in ULONG questionSize
+) const
+{
+    if (questionSize != _questionSize)
+    {
+        return false;
+    }
+
+    // Skip the transaction id
+    const UCHAR* pLeft = static_cast<const UCHAR*>(_spQuestion->GetBuffer()) + sizeof(USHORT);
+    const UCHAR* pRight = static_cast<const UCHAR*>(question.GetBuffer()) + sizeof(USHORT);
+    return memcmp(pLeft, pRight, questionSize - sizeof(USHORT)) == 0;
+}
+
+DnsAnswerCache::DnsAnswerCache(
+    __in KAllocator& allocator,
+    __in ULONG maxSize
+) : _allocator(allocator),
+_maxSize(maxSize),
+_ht(maxSize, K_DefaultHashFunction, allocator),
+_fifo(FIELD_OFFSET(DnsAnswerEntry, _listEntry))
+{
+}
+
+DnsAnswerCache::~DnsAnswerCache()
+{
+    Clear();
+}
+
+/*static*/
+ULONGLONG DnsAnswerCache::GetKey(
+    __in KBuffer& question,
+    __in ULONG questionSize
+)
+{
+    // FNV-1a of the question without the transaction id
+    ULONGLONG hash = 14695981039346656037ULL;
+    const UCHAR* pData = static_cast<const UCHAR*>(question.GetBuffer());
+    for (ULONG i = sizeof(USHORT); i < questionSize; i++)
+    {
+        hash ^= pData[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+bool DnsAnswerCache::TryGet(
+    __in KBuffer& question,
+    __in ULONG questionSize,
+    __out KBuffer& answer,
+    __out ULONG& answerSize
+)
+{
+    if (questionSize <= sizeof(USHORT))
+    {
+        return false;
+    }
+
+    DnsAnswerEntry::SPtr spEntry;
+    NTSTATUS status = _ht.Get(GetKey(question, questionSize), /*out*/spEntry);
+    if (status != STATUS_SUCCESS)
+    {
+        return false;
+    }
+
+    if (spEntry->IsExpired(Common::Stopwatch::Now()) ||
+        !spEntry->IsSameQuestion(question, questionSize) ||
+        spEntry->AnswerSize() > answer.QuerySize())
+    {
+        return false;
+    }
+
+    // Question and answer can be the same buffer, read the id before it gets overwritten
+    USHORT id = *static_cast<USHORT*>(question.GetBuffer());
+
+    answerSize = spEntry->AnswerSize();
+    KMemCpySafe(answer.GetBuffer(), answer.QuerySize(), spEntry->Answer().GetBuffer(), answerSize);
+    *static_cast<USHORT*>(answer.GetBuffer()) = id;
+
+    return true;
+}
+
+void DnsAnswerCache::Put(
+    __in KBuffer& question,
+    __in ULONG questionSize,
+    __in KBuffer& answer,
+    __in ULONG answerSize,
+    __in ULONG timeToLiveInSeconds
+)
+{
+    if ((_maxSize == 0) || (timeToLiveInSeconds == 0) || (questionSize <= sizeof(USHORT)))
+    {
+        return;
+    }
+
+    Common::StopwatchTime now = Common::Stopwatch::Now();
+
+    // Oldest entries expire first
+    while (_fifo.Count() > 0 && _fifo.PeekTail()->IsExpired(now))
+    {
+        RemoveEntry(*_fifo.PeekTail());
+    }
+
+    ULONGLONG key = GetKey(question, questionSize);
+
+    DnsAnswerEntry::SPtr spExisting;
+    if (STATUS_SUCCESS == _ht.Get(key, /*out*/spExisting))
+    {
+        RemoveEntry(*spExisting);
+    }
+
+    DnsAnswerEntry::SPtr spEntry;
+    DnsAnswerEntry::Create(/*out*/spEntry, _allocator, key, question, questionSize, answer, answerSize,
+        now + Common::TimeSpan::FromSeconds(timeToLiveInSeconds));
+
+    NTSTATUS status = _ht.Put(key, spEntry, TRUE/*forceUpdate*/);
+    if (status != STATUS_SUCCESS && status != STATUS_OBJECT_NAME_EXISTS)
+    {
+        KInvariant(false);
+    }
+
+    _fifo.InsertHead(spEntry.RawPtr());
+
+    if (_ht.Count() > _maxSize)
+    {
+        RemoveEntry(*_fifo.PeekTail());
+    }
+}
+
+void DnsAnswerCache::Clear()
+{
+    _fifo.Reset();
+    _ht.Clear();
+}
+
+void DnsAnswerCache::RemoveEntry(
+    __in DnsAnswerEntry& entry
+)
+{
+    // The hash table holds the last reference, unlink first
+    _fifo.Remove(&entry);
+    _ht.Remove(entry.Key());
+}
@@ -59,6 +59,107 @@ namespace DNS
         KHashTable<KString::SPtr, PublicNameEntry::SPtr> _ht;
     };
 
+    class DnsAnswerEntry :
+        public KShared<DnsAnswerEntry>
+    {
+        K_FORCE_SHARED(DnsAnswerEntry);
+    public:
+        static void Create(
+            __out DnsAnswerEntry::SPtr& spEntry,
+            __in KAllocator& allocator,
+            __in ULONGLONG key,
+            __in KBuffer& question,
+            __in ULONG questionSize,
+            __in KBuffer& answer,
+            __in ULONG answerSize,
+            __in Common::StopwatchTime expiration
+        );
+
+    private:
+        DnsAnswerEntry(
+            __in ULONGLONG key,
+            __in KBuffer& question,
+            __in ULONG questionSize,
+            __in KBuffer& answer,
+            __in ULONG answerSize,
+            __in Common::StopwatchTime expiration
+        );
+
+    public:
+        ULONGLONG Key() const { return _key; }
+        KBuffer& Answer() { return *_spAnswer; }
+        ULONG AnswerSize() const { return _answerSize; }
+        bool IsExpired(__in Common::StopwatchTime now) const { return now >= _expiration; }
+
+        bool IsSameQuestion(
+            __in KBuffer& question,
+            __in ULONG questionSize
+        ) const;
+
+    private:
+        ULONGLONG _key;
+        KBuffer::SPtr _spQuestion;
+        ULONG _questionSize;
+        KBuffer::SPtr _spAnswer;
+        ULONG _answerSize;
+        Common::StopwatchTime _expiration;
+
+    public:
+        KListEntry _listEntry;
+    };
+
+    //
+    // Serialized answers of the questions resolved by fabric.
+    // All the entries have the same time to live, entries are kept in the insertion order
+    // so the oldest one is always the first to expire and the first to be evicted.
+    //
+    class DnsAnswerCache
+    {
+        K_DENY_COPY(DnsAnswerCache);
+
+    public:
+        DnsAnswerCache(
+            __in KAllocator& allocator,
+            __in ULONG maxSize
+        );
+
+        ~DnsAnswerCache();
+
+    public:
+        bool TryGet(
+            __in KBuffer& question,
+            __in ULONG questionSize,
+            __out KBuffer& answer,
+            __out ULONG& answerSize
+        );
+
+        void Put(
+            __in KBuffer& question,
+            __in ULONG questionSize,
+            __in KBuffer& answer,
+            __in ULONG answerSize,
+            __in ULONG timeToLiveInSeconds
+        );
+
+        void Clear();
+
+        static ULONGLONG GetKey(
+            __in KBuffer& question,
+            __in ULONG questionSize
+        );
+
+    private:
+        void RemoveEntry(
+            __in DnsAnswerEntry& entry
+        );
+
+    private:
+        KAllocator& _allocator;
+        ULONG _maxSize;
+        KNodeList<DnsAnswerEntry> _fifo;
+        KHashTable<ULONGLONG, DnsAnswerEntry::SPtr> _ht;
+    };
+
     class DnsCache :
         public KShared<DnsCache>,
         public IDnsCache
@@ -113,6 +214,23 @@ namespace DNS
             __in IDnsCacheNotification& notification
         ) override;
 
+        virtual bool TryGetAnswer(
+            __in KBuffer& question,
+            __in ULONG questionSize,
+            __out KBuffer& answer,
+            __out ULONG& answerSize
+        ) override;
+
+        virtual void PutAnswer(
+            __in KBuffer& question,
+            __in ULONG questionSize,
+            __in KBuffer& answer,
+            __in ULONG answerSize,
+            __in ULONG timeToLiveInSeconds
+        ) override;
+
+        virtual void ClearAnswers() override;
+
     private:
         void EnsureSize();
 
@@ -122,6 +240,9 @@ namespace DNS
         KHashTable<KString::SPtr, KString::SPtr> _htDnsToFabric;
         KHashTable<KString::SPtr, KString::SPtr> _htFabricToDns;
 
+        KReaderWriterSpinLock _lockAnswers;
+        DnsAnswerCache _answerCache;
+
         KReaderWriterSpinLock _lockNotifications;
         KArray<IDnsCacheNotification::SPtr> _arrNotifications;
     };
@@ -15,11 +15,12 @@ void DnsExchangeOp::Create(
     __in INetIoManager& netIoManager,
     __in IUdpListener& udpServer,
     __in IFabricResolve& fabricResolve,
+    __in IDnsCache& dnsCache,
     __in INetworkParams& networkParams,
     __in const DnsServiceParams& params
 )
 {
-    spExchangeOp = _new(TAG, allocator) DnsExchangeOp(tracer, dnsParser, netIoManager, udpServer, fabricResolve, networkParams, params);
+    spExchangeOp = _new(TAG, allocator) DnsExchangeOp(tracer, dnsParser, netIoManager, udpServer, fabricResolve, dnsCache, networkParams, params);
     KInvariant(spExchangeOp != nullptr);
 }
 
@@ -29,6 +30,7 @@ DnsExchangeOp::DnsExchangeOp(
     __in INetIoManager& netIoManager,
     __in IUdpListener& udpServer,
     __in IFabricResolve& fabricResolve,
+    __in IDnsCache& dnsCache,
     __in INetworkParams& networkParams,
     __in const DnsServiceParams& params
 ) : _tracer(tracer),
@@ -36,7 +38,10 @@ _dnsParser(dnsParser),
 _netIoManager(netIoManager),
 _udpServer(udpServer),
 _fabricResolve(fabricResolve),
+_dnsCache(dnsCache),
 _bytesWrittenToBuffer(0),
+_questionSize(0),
+_fCacheAnswer(false),
 _params(params)
 {
 
@@ -137,6 +142,31 @@ void DnsExchangeOp::OnStateEnter_ReadQuestionFailed()
     ChangeStateAsync(fSuccess);
 }
 
+void DnsExchangeOp::OnStateEnter_ReadCachedAnswer()
+{
+    _fCacheAnswer = false;
+
+    if (!_params.IsAnswerCacheEnabled)
+    {
+        ChangeStateAsync(false);
+        return;
+    }
+
+    KMemCpySafe(_spQuestion->GetBuffer(), _spQuestion->QuerySize(), _spBuffer->GetBuffer(), _questionSize);
+
+    if (_dnsCache.TryGetAnswer(*_spQuestion, _questionSize, /*out*/*_spBuffer, /*out*/_bytesWrittenToBuffer))
+    {
+        _tracer.Trace(DnsTraceLevel_Noise,
+            "DnsExchangeOp activityId {0}, answered from cache, bytes {1}",
+            WSTR(_activityId), _bytesWrittenToBuffer);
+
+        ChangeStateAsync(true);
+        return;
+    }
+
+    ChangeStateAsync(false);
+}
+
 void DnsExchangeOp::OnStateEnter_FabricResolve()
 {
     DnsResolveOp::DnsResolveCallback resolveCallback(this, &DnsExchangeOp::OnDnsResolveCompleted);
@@ -155,6 +185,9 @@ void DnsExchangeOp::OnStateEnter_FabricResolveSucceeded()
     DnsFlags::SetFlag(/*out*/flags, DnsFlags::AUTHORITY);
     message.SetFlags(flags);
 
+    // Only answers resolved by fabric are cached, they get invalidated by the service notifications
+    _fCacheAnswer = _params.IsAnswerCacheEnabled;
+
     ChangeStateAsync(true);
 }
 
@@ -235,11 +268,39 @@ void DnsExchangeOp::OnStateEnter_SerializeFabricAnswer()
         _tracer.Trace(DnsTraceLevel_Info,
             "DnsExchangeOp activityId {0}, processed query {1}",
             WSTR(_activityId), WSTR(*spMessageStr));
+
+        // Answers with several endpoints are not cached. A cached answer keeps the same record order
+        // for its whole TTL, which would defeat the shuffle that spreads clients across the endpoints.
+        if (_fCacheAnswer && HasSingleEndpoint(message))
+        {
+            _dnsCache.PutAnswer(*_spQuestion, _questionSize, *_spBuffer, _bytesWrittenToBuffer, _params.TimeToLiveInSeconds);
+        }
     }
 
     ChangeStateAsync(fSuccess);
 }
 
+/*static*/
+bool DnsExchangeOp::HasSingleEndpoint(
+    __in IDnsMessage& message
+)
+{
+    // Each endpoint is answered with one record of every requested type
+    KArray<IDnsRecord::SPtr>& arrAnswers = message.Answers();
+    for (ULONG i = 0; i < arrAnswers.Count(); i++)
+    {
+        for (ULONG j = 0; j < i; j++)
+        {
+            if (arrAnswers[i]->Type() == arrAnswers[j]->Type())
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
 void DnsExchangeOp::OnStateEnter_WriteAnswers()
 {
     AcquireActivities();
@@ -328,6 +389,15 @@ void DnsExchangeOp::StartExchange(
         KInvariant(false);
     }
 
+    if (_params.IsAnswerCacheEnabled && _spQuestion == nullptr)
+    {
+        if (STATUS_SUCCESS != KBuffer::Create(bufferSizeInBytes, /*out*/_spQuestion, GetThisAllocator()))
+        {
+            _tracer.Trace(DnsTraceLevel_Error, "Failed to allocate question buffer");
+            KInvariant(false);
+        }
+    }
+
     _tracer.Trace(DnsTraceLevel_Noise, "New DnsExchangeOp activityId {0} bufferSize {1} IsRecursiveQueryEnabled {2}",
         WSTR(_activityId), bufferSizeInBytes, (BOOLEAN)_params.IsRecursiveQueryEnabled);
 
@@ -362,6 +432,7 @@ void DnsExchangeOp::OnUdpReadCompleted(
     else
     {
         _spMessage = spMessage;
+        _questionSize = bytesRead;
 
         _tracer.Trace(DnsTraceLevel_Noise,
             "DnsExchangeOp activityId {0} UDP read succeeded, status {1}, bytesRead {2}",
@@ -17,15 +17,16 @@ namespace DNS
         K_FORCE_SHARED(DnsExchangeOp);
 
         BEGIN_STATEMACHINE_DEFINITION
-            DECLARE_STATES_15(ReadQuestion, ReadQuestionSucceeded, ReadQuestionFailed, \
-                FabricResolve, FabricResolveSucceeded, FabricResolveFailed, \
+            DECLARE_STATES_16(ReadQuestion, ReadQuestionSucceeded, ReadQuestionFailed, \
+                ReadCachedAnswer, FabricResolve, FabricResolveSucceeded, FabricResolveFailed, \
                 IsRemoteResolveEnabled, RemoteResolve, RemoteResolveSucceeded, RemoteResolveFailed, \
                 SerializeFabricAnswer, CreateBadRequestAnswer, CreateInternalErrorAnswer,\
                 WriteAnswers, DropMessage)
             BEGIN_TRANSITIONS
                 TRANSITION(Start, ReadQuestion)
                 TRANSITION_BOOL(ReadQuestion, ReadQuestionSucceeded, ReadQuestionFailed)
-                TRANSITION(ReadQuestionSucceeded, FabricResolve)
+                TRANSITION(ReadQuestionSucceeded, ReadCachedAnswer)
+                TRANSITION_BOOL(ReadCachedAnswer, WriteAnswers, FabricResolve)
                 TRANSITION_BOOL(ReadQuestionFailed, CreateBadRequestAnswer, DropMessage)
                 TRANSITION_BOOL(FabricResolve, FabricResolveSucceeded, FabricResolveFailed)
                 TRANSITION(FabricResolveSucceeded, SerializeFabricAnswer)
@@ -56,6 +57,7 @@ namespace DNS
             __in INetIoManager& netIoManager,
             __in IUdpListener& udpServer,
             __in IFabricResolve& fabricResolve,
+            __in IDnsCache& dnsCache,
             __in INetworkParams& networkParams,
             __in const DnsServiceParams& params
         );
@@ -67,6 +69,7 @@ namespace DNS
             __in INetIoManager& netIoManager,
             __in IUdpListener& udpServer,
             __in IFabricResolve& fabricResolve,
+            __in IDnsCache& dnsCache,
             __in INetworkParams& networkParams,
             __in const DnsServiceParams& params
         );
@@ -108,12 +111,17 @@ namespace DNS
             __in ULONG bytesSent
         );
 
+        static bool HasSingleEndpoint(
+            __in IDnsMessage& message
+        );
+
     private:
         IDnsTracer& _tracer;
         IDnsParser& _dnsParser;
         INetIoManager& _netIoManager;
         IUdpListener& _udpServer;
         IFabricResolve& _fabricResolve;
+        IDnsCache& _dnsCache;
         const DnsServiceParams& _params;
 
         KLocalString<64> _activityId;
@@ -121,6 +129,11 @@ namespace DNS
         KBuffer::SPtr _spBuffer;
         ULONG _bytesWrittenToBuffer;
 
+        // Copy of the question, the buffer is overwritten with the answer
+        KBuffer::SPtr _spQuestion;
+        ULONG _questionSize;
+        bool _fCacheAnswer;
+
         DnsResolveOp::SPtr _spDnsResolveOp;
         DnsRemoteQueryOp::SPtr _spDnsRemoteQueryOp;
 
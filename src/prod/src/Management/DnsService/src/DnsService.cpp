@@ -291,6 +291,7 @@ void DnsService::StartExchangeOps()
             *_spNetIoManager,
             *_spUdpListener,
             *_spFabricResolve,
+            *_spDnsCache,
             *_spNetworkParams,
             _params
         );
@@ -96,6 +96,9 @@ void FabricResolve::NotifyServiceChanged(
     __in bool fServiceDeleted
 )
 {
+    // Endpoints of the service may have changed
+    _spCache->ClearAnswers();
+
     if (fServiceDeleted)
     {
         _spCache->Remove(serviceName);
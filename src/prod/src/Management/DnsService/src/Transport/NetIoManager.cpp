@@ -380,6 +380,137 @@ int NetIoManager::WriteAsync(
     return WSA_IO_PENDING;
 }
 
+int NetIoManager::ReadBatchInternal(
+    __in SOCKET socket,
+    __in Queue& readQueue,
+    __out ULONG& opsCompleted
+)
+{
+    opsCompleted = 0;
+
+    IUdpAsyncOp::SPtr ops[MaxBatchSize];
+    struct mmsghdr msgs[MaxBatchSize];
+    struct iovec iovecs[MaxBatchSize];
+
+    ULONG count = 0;
+    while ((count < MaxBatchSize) && readQueue.Deq(ops[count]))
+    {
+        KBuffer::SPtr spBuffer = ops[count]->GetBuffer();
+        ISocketAddress::SPtr spAddress = ops[count]->GetAddress();
+
+        iovecs[count].iov_base = spBuffer->GetBuffer();
+        iovecs[count].iov_len = spBuffer->QuerySize();
+
+        RtlZeroMemory(&msgs[count], sizeof(msgs[count]));
+        msgs[count].msg_hdr.msg_iov = &iovecs[count];
+        msgs[count].msg_hdr.msg_iovlen = 1;
+        msgs[count].msg_hdr.msg_name = spAddress->Address();
+        msgs[count].msg_hdr.msg_namelen = *spAddress->SizePtr();
+
+        count++;
+    }
+
+    int result = NOERROR;
+    int received = recvmmsg(socket, msgs, count, 0 /*flags*/, nullptr /*timeout*/);
+    if (received < 0)
+    {
+        result = errno;
+        received = 0;
+    }
+
+    for (int i = 0; i < received; i++)
+    {
+        *ops[i]->GetAddress()->SizePtr() = msgs[i].msg_hdr.msg_namelen;
+        ops[i]->IOCP_Completion(STATUS_SUCCESS, msgs[i].msg_len);
+    }
+
+    ULONG next = static_cast<ULONG>(received);
+    if ((result != NOERROR) && (result != EAGAIN) && (result != EWOULDBLOCK))
+    {
+        // Same as a failed recvfrom, the error goes to the first op
+        ops[next]->IOCP_Completion(result, 0);
+        next++;
+    }
+
+    opsCompleted = next;
+
+    // Ops that did not get a datagram wait for the next EPOLLIN, any op can take any datagram
+    for (ULONG i = next; i < count; i++)
+    {
+        if (!readQueue.Enq(ops[i]))
+        {
+            KInvariant(false);
+        }
+    }
+
+    return result;
+}
+
+int NetIoManager::WriteBatchInternal(
+    __in SOCKET socket,
+    __in Queue& writeQueue,
+    __out ULONG& opsCompleted
+)
+{
+    opsCompleted = 0;
+
+    IUdpAsyncOp::SPtr ops[MaxBatchSize];
+    struct mmsghdr msgs[MaxBatchSize];
+    struct iovec iovecs[MaxBatchSize];
+
+    ULONG count = 0;
+    while ((count < MaxBatchSize) && writeQueue.Deq(ops[count]))
+    {
+        KBuffer::SPtr spBuffer = ops[count]->GetBuffer();
+        ISocketAddress::SPtr spAddress = ops[count]->GetAddress();
+
+        iovecs[count].iov_base = spBuffer->GetBuffer();
+        iovecs[count].iov_len = ops[count]->GetBufferDataLength();
+
+        RtlZeroMemory(&msgs[count], sizeof(msgs[count]));
+        msgs[count].msg_hdr.msg_iov = &iovecs[count];
+        msgs[count].msg_hdr.msg_iovlen = 1;
+        msgs[count].msg_hdr.msg_name = spAddress->Address();
+        msgs[count].msg_hdr.msg_namelen = spAddress->Size();
+
+        count++;
+    }
+
+    int result = NOERROR;
+    int sent = sendmmsg(socket, msgs, count, 0 /*flags*/);
+    if (sent < 0)
+    {
+        result = errno;
+        sent = 0;
+    }
+
+    for (int i = 0; i < sent; i++)
+    {
+        ops[i]->IOCP_Completion(STATUS_SUCCESS, msgs[i].msg_len);
+    }
+
+    ULONG next = static_cast<ULONG>(sent);
+    if ((result != NOERROR) && (result != EAGAIN) && (result != EWOULDBLOCK))
+    {
+        // Same as a failed sendto, the error goes to the first op
+        ops[next]->IOCP_Completion(result, 0);
+        next++;
+    }
+
+    // Answers go to different clients, the ones that were not sent can be requeued at the tail
+    for (ULONG i = next; i < count; i++)
+    {
+        if (!writeQueue.Enq(ops[i]))
+        {
+            KInvariant(false);
+        }
+    }
+
+    opsCompleted = next;
+
+    return result;
+}
+
 void NetIoManager::HandleEpollEvents()
 {
     typedef struct epoll_event EPOLLEVENT;
@@ -430,21 +561,17 @@ void NetIoManager::HandleEpollEvents()
                     Queue& readQueue = *queues.ReadQueue;
                     while (!readQueue.IsEmpty() && !fReadDone)
                     {
-                        IUdpAsyncOp::SPtr spOp = readQueue.Peek();
-                        ULONG bytesRead;
-                        int result = ReadInternal(ev.data.fd, *spOp, /*out*/bytesRead);
+                        ULONG opsCompleted = 0;
+                        int result = ReadBatchInternal(ev.data.fd, readQueue, /*out*/opsCompleted);
                         if ((result != EAGAIN) && (result != EWOULDBLOCK))
                         {
                             Tracer().Trace(DnsTraceLevel_Noise,
-                                "DNS NetIoManager MainLoop EPOLLIN, successfully read data from socket {0}, bytesRead {1}, error {2}",
-                                ev.data.fd, bytesRead, (LONG)result);
-
-                            spOp->IOCP_Completion(result, bytesRead);
-                            readQueue.Deq();
+                                "DNS NetIoManager MainLoop EPOLLIN, successfully read data from socket {0}, ops completed {1}, error {2}",
+                                ev.data.fd, opsCompleted, (LONG)result);
                         }
                         else
                         {
-                            // Nothing to read, this is perfectly OK, don't dequeue the item
+                            // Nothing to read, this is perfectly OK, the pending ops stay in the queue
                             fReadDone = true;
 
                             Tracer().Trace(DnsTraceLevel_Noise,
@@ -468,28 +595,15 @@ void NetIoManager::HandleEpollEvents()
                     Queue& writeQueue = *queues.WriteQueue;
                     while (!writeQueue.IsEmpty() && !fWriteDone)
                     {
-                        IUdpAsyncOp::SPtr spOp = writeQueue.Peek();
-                        ULONG bytesWritten = 0;
-
-                        int result = WriteInternal(
-                            ev.data.fd,
-                            *spOp->GetBuffer(),
-                            spOp->GetBufferDataLength(),
-                            *spOp->GetAddress(),
-                            /*out*/bytesWritten);
-
-                        if ((result != EAGAIN) && (result != EWOULDBLOCK))
-                        {
-                            spOp->IOCP_Completion(result, bytesWritten);
-                            writeQueue.Deq();
-                        }
-                        else
+                        ULONG opsCompleted = 0;
+                        int result = WriteBatchInternal(ev.data.fd, writeQueue, /*out*/opsCompleted);
+                        if ((result == EAGAIN) || (result == EWOULDBLOCK))
                         {
                             // Can't write, exit
                             fWriteDone = true;
 
                             Tracer().Trace(DnsTraceLevel_Noise,
-                                "DNS NetIoManager MainLoop EPOLLOUT, can't write to socket {0}, error",
+                                "DNS NetIoManager MainLoop EPOLLOUT, can't write to socket {0}, error {1}",
                                 ev.data.fd, (LONG)result);
                         }
                     }
@@ -100,13 +100,32 @@ namespace DNS
         );
 #endif
 
+    private:
+        typedef KSharedType<KQueue<IUdpAsyncOp::SPtr>> Queue;
+
+#if defined(PLATFORM_UNIX)
+        // Max number of datagrams moved by one recvmmsg/sendmmsg call
+        static const ULONG MaxBatchSize = 32;
+
+        int ReadBatchInternal(
+            __in SOCKET socket,
+            __in Queue& readQueue,
+            __out ULONG& opsCompleted
+        );
+
+        int WriteBatchInternal(
+            __in SOCKET socket,
+            __in Queue& writeQueue,
+            __out ULONG& opsCompleted
+        );
+#endif
+
     private:
         int _efd;
         IDnsTracer::SPtr _spTracer;
         DnsServiceParams _params;
         KThread::SPtr _spEpollThread;
 
-        typedef KSharedType<KQueue<IUdpAsyncOp::SPtr>> Queue;
         struct Queues
         {
             Queue::SPtr ReadQueue;
@@ -352,5 +352,73 @@ namespace DNS { namespace Test
         }
     }
 
+    BOOST_AUTO_TEST_CASE(TestAnswerCache)
+    {
+        const ULONG size = 32;
+        KBuffer::SPtr spQuestion;
+        KBuffer::SPtr spAnswer;
+        KBuffer::SPtr spRead;
+        VERIFY_IS_TRUE(STATUS_SUCCESS == KBuffer::Create(size, /*out*/spQuestion, GetAllocator()));
+        VERIFY_IS_TRUE(STATUS_SUCCESS == KBuffer::Create(size, /*out*/spAnswer, GetAllocator()));
+        VERIFY_IS_TRUE(STATUS_SUCCESS == KBuffer::Create(size, /*out*/spRead, GetAllocator()));
+
+        UCHAR* pQuestion = static_cast<UCHAR*>(spQuestion->GetBuffer());
+        UCHAR* pAnswer = static_cast<UCHAR*>(spAnswer->GetBuffer());
+        for (ULONG i = 0; i < size; i++)
+        {
+            pQuestion[i] = static_cast<UCHAR>(i);
+            pAnswer[i] = static_cast<UCHAR>(size - i);
+        }
+
+        ULONG answerSize = 0;
+        VERIFY_IS_FALSE(_spCache->TryGetAnswer(*spQuestion, size, /*out*/*spRead, /*out*/answerSize));
+
+        _spCache->PutAnswer(*spQuestion, size, *spAnswer, size, 1/*timeToLiveInSeconds*/);
+
+        // Same question with a different transaction id gets the answer with its own id
+        pQuestion[0] = 0xAB;
+        pQuestion[1] = 0xCD;
+        VERIFY_IS_TRUE(_spCache->TryGetAnswer(*spQuestion, size, /*out*/*spRead, /*out*/answerSize));
+        VERIFY_ARE_EQUAL(size, answerSize);
+
+        UCHAR* pRead = static_cast<UCHAR*>(spRead->GetBuffer());
+        VERIFY_ARE_EQUAL(static_cast<UCHAR>(0xAB), pRead[0]);
+        VERIFY_ARE_EQUAL(static_cast<UCHAR>(0xCD), pRead[1]);
+        VERIFY_IS_TRUE(memcmp(pRead + 2, pAnswer + 2, size - 2) == 0);
+
+        // Question and answer can share the buffer
+        VERIFY_IS_TRUE(_spCache->TryGetAnswer(*spQuestion, size, /*out*/*spQuestion, /*out*/answerSize));
+        VERIFY_ARE_EQUAL(static_cast<UCHAR>(0xAB), pQuestion[0]);
+        VERIFY_IS_TRUE(memcmp(pQuestion + 2, pAnswer + 2, size - 2) == 0);
+
+        for (ULONG i = 2; i < size; i++)
+        {
+            pQuestion[i] = static_cast<UCHAR>(i);
+        }
+
+        // Different question
+        VERIFY_IS_FALSE(_spCache->TryGetAnswer(*spQuestion, size - 1, /*out*/*spRead, /*out*/answerSize));
+
+        // Service notification drops the answers
+        KString::SPtr spDnsName = KString::Create(L"answer.cache", GetAllocator());
+        KString::SPtr spFabricName = KString::Create(L"fabric:/answer/cache", GetAllocator());
+        _spCache->Put(*spDnsName, *spFabricName);
+        VERIFY_IS_FALSE(_spCache->TryGetAnswer(*spQuestion, size, /*out*/*spRead, /*out*/answerSize));
+
+        // Same mapping again keeps the answers
+        _spCache->PutAnswer(*spQuestion, size, *spAnswer, size, 1/*timeToLiveInSeconds*/);
+        _spCache->Put(*spDnsName, *spFabricName);
+        VERIFY_IS_TRUE(_spCache->TryGetAnswer(*spQuestion, size, /*out*/*spRead, /*out*/answerSize));
+
+        _spCache->Remove(*spFabricName);
+        VERIFY_IS_FALSE(_spCache->TryGetAnswer(*spQuestion, size, /*out*/*spRead, /*out*/answerSize));
+
+        // Answer expires after the time to live
+        _spCache->PutAnswer(*spQuestion, size, *spAnswer, size, 1/*timeToLiveInSeconds*/);
+        VERIFY_IS_TRUE(_spCache->TryGetAnswer(*spQuestion, size, /*out*/*spRead, /*out*/answerSize));
+        KNt::Sleep(1100);
+        VERIFY_IS_FALSE(_spCache->TryGetAnswer(*spQuestion, size, /*out*/*spRead, /*out*/answerSize));
+    }
+
     BOOST_AUTO_TEST_SUITE_END()
 }}
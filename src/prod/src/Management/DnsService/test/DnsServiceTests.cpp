@@ -217,7 +217,57 @@ namespace DNS { namespace Test
         QueryHelper(L"google.com", L"fabric:/bogus", L"bogus" /*answer*/,
             L"10.1.1.1" /*a*/, L"10.1.1.1:1234" /*txt*/, L"google.com:1234"/*srv*/);
     }
-  
+
+    BOOST_AUTO_TEST_CASE(TestMultipleEndpointsNotCached)
+    {
+        KString::SPtr spAnswer1 = KString::Create(L"10.0.0.1:1025", GetAllocator());
+        KString::SPtr spAnswer2 = KString::Create(L"10.0.0.2:1025", GetAllocator());
+
+        KArray<KString::SPtr> arrResults(GetAllocator());
+        arrResults.Append(spAnswer1);
+        arrResults.Append(spAnswer2);
+
+        ComPointer<IFabricResolvedServicePartitionResult> spResult;
+        _spData->SerializeServiceEndpoints(/*out*/spResult, arrResults);
+
+        _spServiceManager->AddResult(L"fabric:/multi", *spResult.RawPtr());
+
+        ComPointer<IFabricPropertyValueResult> spPropResult;
+        _spData->SerializePropertyValue(/*out*/spPropResult, L"fabric:/multi");
+
+        _spPropertyManager->SetResult(spPropResult);
+
+        KBuffer::SPtr spBuffer;
+        KBuffer::Create(4096, spBuffer, GetAllocator());
+        KArray<DNS_DATA> results(GetAllocator());
+        DNS_STATUS status = DnsHelper::Query(*_spNetIoManager, *spBuffer, *_spParser, _port, L"multi.my", DNS_TYPE_ANY, results);
+
+        if (status != 0)
+        {
+            VERIFY_FAIL_FMT(L"Failed to get valid answer to DNS server, status 0x%x", status);
+        }
+
+        ULONG aRecCount = 0;
+        for (ULONG i = 0; i < results.Count(); i++)
+        {
+            if (results[i].Type == DNS_TYPE_A)
+            {
+                aRecCount++;
+            }
+        }
+
+        if (aRecCount != 2)
+        {
+            VERIFY_FAIL_FMT(L"Expected 2 A records, got %u", aRecCount);
+        }
+
+        // The answer with several endpoints was not cached, so that every query gets its own shuffle.
+        // The second query is resolved by fabric again and sees the new endpoint.
+        //
+        QueryHelper(L"multi.my", L"fabric:/multi", L"10.0.0.3:1025" /*answer*/,
+            L"10.0.0.3" /*a*/, L"10.0.0.3:1025" /*txt*/, L"multi.my:1025"/*srv*/);
+    }
+
     BOOST_AUTO_TEST_CASE(TestBadRequest)
     {        
         KBuffer::SPtr spBuffer;
@@ -0,0 +1,329 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+namespace HttpServer
+{
+    using namespace std;
+    using namespace Common;
+
+    class HttpRequestParserTest
+    {
+    protected:
+        static size_t const MaxHeadSize = 256;
+
+        //
+        // Feeds data the way the connection does: head bytes first, then body bytes, until the request
+        // completes or fails. Returns the number of bytes that belong to the request.
+        //
+        static size_t Parse(HttpRequestParser & parser, string const & data, __inout string & body)
+        {
+            size_t offset = 0;
+            while (offset < data.size())
+            {
+                size_t consumed = 0;
+                if (parser.CurrentState == HttpRequestParser::Head)
+                {
+                    consumed = parser.ParseHead(data.data() + offset, data.size() - offset);
+                }
+                else if (parser.CurrentState == HttpRequestParser::Body)
+                {
+                    char const * bodyData;
+                    size_t bodyLength;
+                    consumed = parser.ParseBody(data.data() + offset, data.size() - offset, bodyData, bodyLength);
+                    if (bodyLength > 0)
+                    {
+                        body.append(bodyData, bodyLength);
+                    }
+                }
+
+                if (consumed == 0)
+                {
+                    break;
+                }
+
+                offset += consumed;
+            }
+
+            return offset;
+        }
+
+        // Same as Parse, with the data arriving in receives of pieceSize bytes
+        static size_t ParseInPieces(HttpRequestParser & parser, string const & data, size_t pieceSize, __inout string & body)
+        {
+            size_t offset = 0;
+            while (offset < data.size())
+            {
+                auto piece = data.substr(offset, pieceSize);
+                auto consumed = Parse(parser, piece, body);
+                offset += consumed;
+
+                if (consumed < piece.size())
+                {
+                    break;
+                }
+            }
+
+            return offset;
+        }
+
+        static void VerifyError(string const & data, USHORT expectedStatusCode, size_t maxHeadSize = MaxHeadSize)
+        {
+            HttpRequestParser parser(maxHeadSize);
+            string body;
+            Parse(parser, data, body);
+            VERIFY_ARE_EQUAL(HttpRequestParser::Error, parser.CurrentState);
+            VERIFY_ARE_EQUAL(expectedStatusCode, parser.ErrorStatusCode);
+            VERIFY_IS_FALSE(parser.KeepAlive);
+        }
+
+        static string GetHeader(HttpRequestParser const & parser, string const & name)
+        {
+            string value;
+            VERIFY_IS_TRUE(HttpRequestParser::TryGetHeader(parser.Headers, name, value));
+            return value;
+        }
+    };
+
+    BOOST_FIXTURE_TEST_SUITE(HttpRequestParserTestSuite, HttpRequestParserTest)
+
+    BOOST_AUTO_TEST_CASE(SplitHead)
+    {
+        string request =
+            "POST /Applications/$/Create?api-version=6.0 HTTP/1.1\r\n"
+            "Host: localhost:19080\r\n"
+            "X-Test: a\r\n"
+            "x-test:  b \r\n"
+            "Content-Length: 11\r\n"
+            "\r\n"
+            "hello world";
+
+        // Every split point, including inside the CRLFCRLF that ends the head
+        for (size_t pieceSize = 1; pieceSize <= request.size(); ++pieceSize)
+        {
+            HttpRequestParser parser(MaxHeadSize);
+            string body;
+            VERIFY_ARE_EQUAL(request.size(), ParseInPieces(parser, request, pieceSize, body));
+
+            VERIFY_ARE_EQUAL(HttpRequestParser::Complete, parser.CurrentState);
+            VERIFY_ARE_EQUAL(string("POST"), parser.Method);
+            VERIFY_ARE_EQUAL(string("/Applications/$/Create?api-version=6.0"), parser.Target);
+            VERIFY_ARE_EQUAL(string("localhost:19080"), GetHeader(parser, "host"));
+            VERIFY_ARE_EQUAL(string("a, b"), GetHeader(parser, "X-Test"));
+            VERIFY_IS_TRUE(parser.KeepAlive);
+            VERIFY_ARE_EQUAL(string("hello world"), body);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(Pipelining)
+    {
+        string first = "GET /first HTTP/1.1\r\nHost: a\r\n\r\n";
+        string second = "PUT /second HTTP/1.1\r\nContent-Length: 3\r\n\r\nabc";
+        string third = "\r\nDELETE /third HTTP/1.1\r\nConnection: close\r\n\r\n";
+        string received = first + second + third;
+
+        HttpRequestParser parser(MaxHeadSize);
+        string body;
+
+        // Each request stops at its own end and leaves the following ones in the receive buffer
+        size_t offset = Parse(parser, received, body);
+        VERIFY_ARE_EQUAL(first.size(), offset);
+        VERIFY_ARE_EQUAL(HttpRequestParser::Complete, parser.CurrentState);
+        VERIFY_ARE_EQUAL(string("/first"), parser.Target);
+        VERIFY_IS_FALSE(parser.HasBody);
+
+        parser.Reset();
+        offset += Parse(parser, received.substr(offset), body);
+        VERIFY_ARE_EQUAL(first.size() + second.size(), offset);
+        VERIFY_ARE_EQUAL(HttpRequestParser::Complete, parser.CurrentState);
+        VERIFY_ARE_EQUAL(string("PUT"), parser.Method);
+        VERIFY_ARE_EQUAL(string("abc"), body);
+
+        // The empty line before the request line is skipped
+        parser.Reset();
+        body.clear();
+        offset += Parse(parser, received.substr(offset), body);
+        VERIFY_ARE_EQUAL(received.size(), offset);
+        VERIFY_ARE_EQUAL(HttpRequestParser::Complete, parser.CurrentState);
+        VERIFY_ARE_EQUAL(string("DELETE"), parser.Method);
+        VERIFY_IS_FALSE(parser.KeepAlive);
+        VERIFY_IS_TRUE(body.empty());
+    }
+
+    BOOST_AUTO_TEST_CASE(ChunkedBody)
+    {
+        string request =
+            "POST /upload HTTP/1.1\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "5;name=value\r\n"
+            "hello\r\n"
+            "6\r\n"
+            " world\r\n"
+            "0\r\n"
+            "Trailer-Field: ignored\r\n"
+            "\r\n";
+
+        for (size_t pieceSize = 1; pieceSize <= request.size(); ++pieceSize)
+        {
+            HttpRequestParser parser(MaxHeadSize);
+            string body;
+            VERIFY_ARE_EQUAL(request.size(), ParseInPieces(parser, request, pieceSize, body));
+            VERIFY_ARE_EQUAL(HttpRequestParser::Complete, parser.CurrentState);
+            VERIFY_IS_TRUE(parser.KeepAlive);
+            VERIFY_ARE_EQUAL(string("hello world"), body);
+        }
+
+        // Chunk data must be followed by CRLF
+        VerifyError("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n3\r\nabcX\r\n0\r\n\r\n", 400);
+    }
+
+    BOOST_AUTO_TEST_CASE(ContentLengthAndTransferEncoding)
+    {
+        // Transfer-Encoding wins over Content-Length, and the connection is not reused
+        {
+            HttpRequestParser parser(MaxHeadSize);
+            string body;
+            string request = "POST / HTTP/1.1\r\nContent-Length: 100\r\nTransfer-Encoding: chunked\r\n\r\n3\r\nabc\r\n0\r\n\r\n";
+            VERIFY_ARE_EQUAL(request.size(), Parse(parser, request, body));
+            VERIFY_ARE_EQUAL(HttpRequestParser::Complete, parser.CurrentState);
+            VERIFY_IS_FALSE(parser.KeepAlive);
+            VERIFY_ARE_EQUAL(string("abc"), body);
+        }
+
+        // Repeated Content-Length values that agree are accepted
+        {
+            HttpRequestParser parser(MaxHeadSize);
+            string body;
+            string request = "POST / HTTP/1.1\r\nContent-Length: 2, 2\r\nContent-Length: 2\r\n\r\nab";
+            VERIFY_ARE_EQUAL(request.size(), Parse(parser, request, body));
+            VERIFY_ARE_EQUAL(HttpRequestParser::Complete, parser.CurrentState);
+            VERIFY_IS_TRUE(parser.KeepAlive);
+            VERIFY_ARE_EQUAL(string("ab"), body);
+        }
+
+        VerifyError("POST / HTTP/1.1\r\nContent-Length: 2\r\nContent-Length: 3\r\n\r\nabc", 400);
+        VerifyError("POST / HTTP/1.1\r\nContent-Length: 2, 3\r\n\r\nabc", 400);
+        VerifyError("POST / HTTP/1.1\r\nContent-Length: -1\r\n\r\n", 400);
+        VerifyError("POST / HTTP/1.1\r\nContent-Length: 12345678901234567890\r\n\r\n", 400);
+        VerifyError("POST / HTTP/1.1\r\nTransfer-Encoding: gzip, chunked\r\n\r\n", 501);
+    }
+
+    BOOST_AUTO_TEST_CASE(ChunkSizeOverflow)
+    {
+        // The largest size that fits in 64 bits is accepted, the body just never ends in this test
+        {
+            HttpRequestParser parser(MaxHeadSize);
+            string body;
+            Parse(parser, "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\nffffffffffffffff\r\nab", body);
+            VERIFY_ARE_EQUAL(HttpRequestParser::Body, parser.CurrentState);
+            VERIFY_ARE_EQUAL(string("ab"), body);
+        }
+
+        VerifyError("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n10000000000000000\r\n", 400);
+        VerifyError("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n-1\r\n", 400);
+        VerifyError("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n5x\r\n", 400);
+        VerifyError("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n\r\n", 400);
+    }
+
+    BOOST_AUTO_TEST_CASE(OversizedLines)
+    {
+        size_t const maxHeadSize = 64;
+
+        // A head that does not end within the limit, whether it arrives at once or in pieces
+        string longHeader = "GET / HTTP/1.1\r\nX-Long: " + string(maxHeadSize, 'a') + "\r\n\r\n";
+        VerifyError(longHeader, 431, maxHeadSize);
+
+        {
+            HttpRequestParser parser(maxHeadSize);
+            string body;
+            ParseInPieces(parser, longHeader, 7, body);
+            VERIFY_ARE_EQUAL(HttpRequestParser::Error, parser.CurrentState);
+            VERIFY_ARE_EQUAL(431, parser.ErrorStatusCode);
+        }
+
+        VerifyError("GET /" + string(maxHeadSize, 'a') + " HTTP/1.1\r\n\r\n", 431, maxHeadSize);
+
+        // Lines of the chunked coding are bounded by the same limit
+        VerifyError(
+            "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n1;" + string(maxHeadSize, 'e') + "\r\n",
+            400,
+            maxHeadSize);
+
+        // A head right at the limit is accepted
+        {
+            string request = "GET / HTTP/1.1\r\nX-Fill: ";
+            request.append(maxHeadSize - request.size(), 'b');
+            request.append("\r\n\r\n");
+
+            HttpRequestParser parser(maxHeadSize);
+            string body;
+            VERIFY_ARE_EQUAL(request.size(), Parse(parser, request, body));
+            VERIFY_ARE_EQUAL(HttpRequestParser::Complete, parser.CurrentState);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(ExpectContinue)
+    {
+        {
+            HttpRequestParser parser(MaxHeadSize);
+            string body;
+            Parse(parser, "PUT /file HTTP/1.1\r\nExpect: 100-Continue\r\nContent-Length: 4\r\n\r\n", body);
+            VERIFY_ARE_EQUAL(HttpRequestParser::Body, parser.CurrentState);
+            VERIFY_IS_TRUE(parser.ExpectContinue);
+
+            // Reset clears the expectation for the next request on the connection
+            Parse(parser, "data", body);
+            VERIFY_ARE_EQUAL(HttpRequestParser::Complete, parser.CurrentState);
+            parser.Reset();
+            VERIFY_IS_FALSE(parser.ExpectContinue);
+        }
+
+        // HTTP/1.0 clients don't know about 100-continue, the header is ignored
+        {
+            HttpRequestParser parser(MaxHeadSize);
+            string body;
+            Parse(parser, "PUT /file HTTP/1.0\r\nExpect: 100-continue\r\nContent-Length: 4\r\n\r\n", body);
+            VERIFY_ARE_EQUAL(HttpRequestParser::Body, parser.CurrentState);
+            VERIFY_IS_FALSE(parser.ExpectContinue);
+            VERIFY_IS_FALSE(parser.KeepAlive);
+        }
+
+        VerifyError("PUT /file HTTP/1.1\r\nExpect: something-else\r\nContent-Length: 4\r\n\r\n", 417);
+    }
+
+    BOOST_AUTO_TEST_CASE(MalformedHead)
+    {
+        VerifyError("GET / HTTP/2.0\r\n\r\n", 505);
+        VerifyError("GET / FTP/1.1\r\n\r\n", 400);
+        VerifyError("GET /\r\n\r\n", 400);
+        VerifyError(" / HTTP/1.1\r\n\r\n", 400);
+        VerifyError("G(T / HTTP/1.1\r\n\r\n", 400);
+        VerifyError("GET / HTTP/1.1\r\nNo-Colon\r\n\r\n", 400);
+        VerifyError("GET / HTTP/1.1\r\nSpace : before colon\r\n\r\n", 400);
+        VerifyError("GET / HTTP/1.1\r\nHost: a\r\n folded\r\n\r\n", 400);
+    }
+
+    BOOST_AUTO_TEST_CASE(KeepAlive)
+    {
+        HttpRequestParser parser(MaxHeadSize);
+        string body;
+
+        Parse(parser, "GET / HTTP/1.0\r\nConnection: Keep-Alive\r\n\r\n", body);
+        VERIFY_ARE_EQUAL(HttpRequestParser::Complete, parser.CurrentState);
+        VERIFY_IS_TRUE(parser.KeepAlive);
+
+        parser.Reset();
+        Parse(parser, "GET / HTTP/1.1\r\nConnection: upgrade, close\r\n\r\n", body);
+        VERIFY_ARE_EQUAL(HttpRequestParser::Complete, parser.CurrentState);
+        VERIFY_IS_FALSE(parser.KeepAlive);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+}
@@ -0,0 +1,493 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace std;
+using namespace Common;
+using namespace HttpServer;
+
+namespace
+{
+    char const * const HeadTerminator = "\r\n\r\n";
+    size_t const HeadTerminatorLength = 4;
+
+    // A chunk size line longer than this is not a size a client would send
+    size_t const MaxChunkSizeDigits = 16;
+
+    bool IsTokenChar(char c)
+    {
+        return c > 0x20 && c < 0x7f && strchr("()<>@,;:\\\"/[]?={}", c) == nullptr;
+    }
+
+    void TrimOptionalWhitespace(__inout string & value)
+    {
+        size_t begin = value.find_first_not_of(" \t");
+        if (begin == string::npos)
+        {
+            value.clear();
+            return;
+        }
+
+        size_t end = value.find_last_not_of(" \t");
+        value = value.substr(begin, end - begin + 1);
+    }
+
+    bool ContainsToken(string const & list, char const * token)
+    {
+        vector<string> tokens;
+        StringUtility::Split<string>(list, tokens, ",");
+        for (auto & item : tokens)
+        {
+            TrimOptionalWhitespace(item);
+            if (StringUtility::AreEqualCaseInsensitive(item.c_str(), token))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+}
+
+HttpRequestParser::HttpRequestParser(size_t maxHeadSize)
+    : maxHeadSize_(maxHeadSize)
+    , state_(Head)
+    , headBuffer_()
+    , method_()
+    , target_()
+    , minorVersion_(1)
+    , headers_()
+    , keepAlive_(true)
+    , expectContinue_(false)
+    , isChunked_(false)
+    , contentLength_(0)
+    , remaining_(0)
+    , chunkState_(ChunkSize)
+    , lineBuffer_()
+    , errorStatusCode_(0)
+{
+}
+
+void HttpRequestParser::Reset()
+{
+    state_ = Head;
+    headBuffer_.clear();
+    method_.clear();
+    target_.clear();
+    minorVersion_ = 1;
+    headers_.clear();
+    keepAlive_ = true;
+    expectContinue_ = false;
+    isChunked_ = false;
+    contentLength_ = 0;
+    remaining_ = 0;
+    chunkState_ = ChunkSize;
+    lineBuffer_.clear();
+    errorStatusCode_ = 0;
+}
+
+void HttpRequestParser::SetError(USHORT statusCode)
+{
+    state_ = Error;
+    errorStatusCode_ = statusCode;
+    keepAlive_ = false;
+}
+
+size_t HttpRequestParser::ParseHead(char const * data, size_t length)
+{
+    if (state_ != Head)
+    {
+        return 0;
+    }
+
+    size_t consumed = 0;
+
+    // Empty lines before the request line are ignored (RFC 7230 3.5)
+    if (headBuffer_.empty())
+    {
+        while (consumed < length && (data[consumed] == '\r' || data[consumed] == '\n'))
+        {
+            ++consumed;
+        }
+
+        if (consumed == length)
+        {
+            return consumed;
+        }
+    }
+
+    // The terminator may straddle the previous receive
+    size_t searchFrom = headBuffer_.size() >= HeadTerminatorLength - 1 ? headBuffer_.size() - (HeadTerminatorLength - 1) : 0;
+    size_t available = min(length - consumed, maxHeadSize_ + HeadTerminatorLength - headBuffer_.size());
+    headBuffer_.append(data + consumed, available);
+
+    size_t terminator = headBuffer_.find(HeadTerminator, searchFrom);
+    if (terminator == string::npos)
+    {
+        if (headBuffer_.size() >= maxHeadSize_)
+        {
+            SetError(431);
+        }
+
+        return consumed + available;
+    }
+
+    size_t headEnd = terminator + HeadTerminatorLength;
+    consumed += available - (headBuffer_.size() - headEnd);
+    headBuffer_.resize(terminator);
+
+    if (ParseHeadBlock() && ApplyFramingHeaders())
+    {
+        state_ = this->HasBody ? Body : Complete;
+    }
+
+    headBuffer_.clear();
+    return consumed;
+}
+
+bool HttpRequestParser::ParseHeadBlock()
+{
+    size_t lineStart = 0;
+    bool isRequestLine = true;
+
+    while (lineStart <= headBuffer_.size())
+    {
+        size_t lineEnd = headBuffer_.find("\r\n", lineStart);
+        if (lineEnd == string::npos)
+        {
+            lineEnd = headBuffer_.size();
+        }
+
+        string line = headBuffer_.substr(lineStart, lineEnd - lineStart);
+        if (isRequestLine)
+        {
+            if (!ParseRequestLine(line)) { return false; }
+            isRequestLine = false;
+        }
+        else if (!ParseHeaderLine(line))
+        {
+            return false;
+        }
+
+        lineStart = lineEnd + 2;
+    }
+
+    return true;
+}
+
+bool HttpRequestParser::ParseRequestLine(string const & line)
+{
+    size_t methodEnd = line.find(' ');
+    size_t targetEnd = methodEnd == string::npos ? string::npos : line.find(' ', methodEnd + 1);
+    if (methodEnd == 0 || targetEnd == string::npos || targetEnd == methodEnd + 1)
+    {
+        SetError(400);
+        return false;
+    }
+
+    method_ = line.substr(0, methodEnd);
+    if (!all_of(method_.begin(), method_.end(), IsTokenChar))
+    {
+        SetError(400);
+        return false;
+    }
+
+    target_ = line.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+
+    string version = line.substr(targetEnd + 1);
+    if (version == "HTTP/1.1")
+    {
+        minorVersion_ = 1;
+    }
+    else if (version == "HTTP/1.0")
+    {
+        minorVersion_ = 0;
+    }
+    else
+    {
+        SetError(StringUtility::StartsWith<string>(version, "HTTP/") ? 505 : 400);
+        return false;
+    }
+
+    return true;
+}
+
+bool HttpRequestParser::ParseHeaderLine(string const & line)
+{
+    // Line folding is obsolete and whitespace before the colon is not allowed (RFC 7230 3.2.4)
+    size_t colon = line.find(':');
+    if (colon == string::npos || colon == 0 || !all_of(line.begin(), line.begin() + colon, IsTokenChar))
+    {
+        SetError(400);
+        return false;
+    }
+
+    string value = line.substr(colon + 1);
+    TrimOptionalWhitespace(value);
+    headers_.push_back(make_pair(line.substr(0, colon), move(value)));
+
+    return true;
+}
+
+bool HttpRequestParser::ApplyFramingHeaders()
+{
+    keepAlive_ = (minorVersion_ >= 1);
+
+    string value;
+    if (TryGetHeader(headers_, "Connection", value))
+    {
+        if (ContainsToken(value, "close"))
+        {
+            keepAlive_ = false;
+        }
+        else if (ContainsToken(value, "keep-alive"))
+        {
+            keepAlive_ = true;
+        }
+    }
+
+    if (minorVersion_ >= 1 && TryGetHeader(headers_, "Expect", value))
+    {
+        if (!StringUtility::AreEqualCaseInsensitive(value.c_str(), "100-continue"))
+        {
+            SetError(417);
+            return false;
+        }
+
+        expectContinue_ = true;
+    }
+
+    bool hasTransferEncoding = TryGetHeader(headers_, "Transfer-Encoding", value);
+    if (hasTransferEncoding)
+    {
+        // Only the chunked coding is supported; it must be the only one applied
+        TrimOptionalWhitespace(value);
+        if (!StringUtility::AreEqualCaseInsensitive(value.c_str(), "chunked"))
+        {
+            SetError(501);
+            return false;
+        }
+
+        isChunked_ = true;
+    }
+
+    //
+    // Every Content-Length field must agree. If Transfer-Encoding is present it wins and the
+    // connection is not reused, as the message may be an attempt at request smuggling (RFC 7230 3.3.3).
+    //
+    bool hasContentLength = false;
+    for (auto const & header : headers_)
+    {
+        if (!StringUtility::AreEqualCaseInsensitive(header.first.c_str(), "Content-Length"))
+        {
+            continue;
+        }
+
+        vector<string> lengths;
+        StringUtility::Split<string>(header.second, lengths, ",");
+        for (auto & length : lengths)
+        {
+            TrimOptionalWhitespace(length);
+            if (length.empty() || length.size() > 19 || !all_of(length.begin(), length.end(), ::isdigit))
+            {
+                SetError(400);
+                return false;
+            }
+
+            uint64 parsed = stoull(length);
+            if (hasContentLength && parsed != contentLength_)
+            {
+                SetError(400);
+                return false;
+            }
+
+            contentLength_ = parsed;
+            hasContentLength = true;
+        }
+    }
+
+    if (isChunked_)
+    {
+        contentLength_ = 0;
+        if (hasContentLength)
+        {
+            keepAlive_ = false;
+        }
+    }
+
+    remaining_ = contentLength_;
+    return true;
+}
+
+size_t HttpRequestParser::ParseBody(
+    char const * data,
+    size_t length,
+    __out char const * & bodyData,
+    __out size_t & bodyLength)
+{
+    bodyData = nullptr;
+    bodyLength = 0;
+
+    if (state_ != Body)
+    {
+        return 0;
+    }
+
+    if (!isChunked_)
+    {
+        size_t take = static_cast<size_t>(min<uint64>(remaining_, length));
+        bodyData = data;
+        bodyLength = take;
+        remaining_ -= take;
+        if (remaining_ == 0)
+        {
+            state_ = Complete;
+        }
+
+        return take;
+    }
+
+    size_t consumed = 0;
+    while (consumed < length && state_ == Body)
+    {
+        if (chunkState_ == ChunkData)
+        {
+            size_t take = static_cast<size_t>(min<uint64>(remaining_, length - consumed));
+            bodyData = data + consumed;
+            bodyLength = take;
+            consumed += take;
+            remaining_ -= take;
+            if (remaining_ == 0)
+            {
+                chunkState_ = ChunkDataEnd;
+            }
+
+            // One contiguous span per call
+            return consumed;
+        }
+
+        if (!TryTakeLine(data, length, consumed))
+        {
+            break;
+        }
+
+        switch (chunkState_)
+        {
+        case ChunkSize:
+            if (!ParseChunkSize())
+            {
+                return consumed;
+            }
+
+            chunkState_ = (remaining_ == 0) ? Trailer : ChunkData;
+            break;
+
+        case ChunkDataEnd:
+            if (!lineBuffer_.empty())
+            {
+                SetError(400);
+                return consumed;
+            }
+
+            chunkState_ = ChunkSize;
+            break;
+
+        case Trailer:
+            // Trailer fields are not surfaced
+            if (lineBuffer_.empty())
+            {
+                state_ = Complete;
+            }
+
+            break;
+
+        default:
+            Assert::CodingError("unexpected chunk state {0}", static_cast<int>(chunkState_));
+        }
+
+        lineBuffer_.clear();
+    }
+
+    return consumed;
+}
+
+bool HttpRequestParser::TryTakeLine(char const * data, size_t length, __inout size_t & consumed)
+{
+    auto begin = data + consumed;
+    auto newline = static_cast<char const *>(memchr(begin, '\n', length - consumed));
+    auto end = (newline == nullptr) ? data + length : newline;
+
+    lineBuffer_.append(begin, end - begin);
+    consumed = (newline == nullptr) ? length : (newline - data) + 1;
+
+    if (lineBuffer_.size() > maxHeadSize_)
+    {
+        SetError(400);
+        return false;
+    }
+
+    if (newline == nullptr)
+    {
+        return false;
+    }
+
+    if (!lineBuffer_.empty() && lineBuffer_.back() == '\r')
+    {
+        lineBuffer_.pop_back();
+    }
+
+    return true;
+}
+
+bool HttpRequestParser::ParseChunkSize()
+{
+    // Chunk extensions are ignored
+    size_t digits = 0;
+    uint64 size = 0;
+    for (; digits < lineBuffer_.size() && ::isxdigit(lineBuffer_[digits]); ++digits)
+    {
+        char c = lineBuffer_[digits];
+        size = (size << 4) | static_cast<uint64>(::isdigit(c) ? c - '0' : (::tolower(c) - 'a' + 10));
+    }
+
+    if (digits == 0 || digits > MaxChunkSizeDigits)
+    {
+        SetError(400);
+        return false;
+    }
+
+    if (digits < lineBuffer_.size() && lineBuffer_[digits] != ';' && lineBuffer_[digits] != ' ' && lineBuffer_[digits] != '\t')
+    {
+        SetError(400);
+        return false;
+    }
+
+    remaining_ = size;
+    return true;
+}
+
+bool HttpRequestParser::TryGetHeader(HttpHeaderList const & headers, string const & name, __out string & value)
+{
+    bool found = false;
+    for (auto const & header : headers)
+    {
+        if (StringUtility::AreEqualCaseInsensitive(header.first, name))
+        {
+            if (found)
+            {
+                value.append(", ");
+                value.append(header.second);
+            }
+            else
+            {
+                value = header.second;
+                found = true;
+            }
+        }
+    }
+
+    return found;
+}
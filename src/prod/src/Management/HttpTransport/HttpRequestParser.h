@@ -0,0 +1,110 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace HttpServer
+{
+    typedef std::vector<std::pair<std::string, std::string>> HttpHeaderList;
+
+    //
+    // Incremental HTTP/1.1 request parser used by the native Linux http server. Received data is fed
+    // as it arrives and may hold part of a request or several pipelined requests. The request line and
+    // headers are accumulated until the header block is complete. The body is handed back in place as
+    // it arrives, with the chunked transfer coding removed, so it never has to be buffered here.
+    //
+    class HttpRequestParser
+    {
+        DENY_COPY(HttpRequestParser)
+
+    public:
+        enum State
+        {
+            Head,
+            Body,
+            Complete,
+            Error
+        };
+
+        explicit HttpRequestParser(size_t maxHeadSize);
+
+        __declspec(property(get=get_State)) State CurrentState;
+        State get_State() const { return state_; }
+
+        // Valid once the head is parsed
+        __declspec(property(get=get_Method)) std::string const & Method;
+        std::string const & get_Method() const { return method_; }
+
+        __declspec(property(get=get_Target)) std::string const & Target;
+        std::string const & get_Target() const { return target_; }
+
+        __declspec(property(get=get_Headers)) HttpHeaderList const & Headers;
+        HttpHeaderList const & get_Headers() const { return headers_; }
+
+        __declspec(property(get=get_KeepAlive)) bool KeepAlive;
+        bool get_KeepAlive() const { return keepAlive_; }
+
+        __declspec(property(get=get_ExpectContinue)) bool ExpectContinue;
+        bool get_ExpectContinue() const { return expectContinue_; }
+
+        __declspec(property(get=get_HasBody)) bool HasBody;
+        bool get_HasBody() const { return isChunked_ || contentLength_ > 0; }
+
+        // The status code to respond with when the state is Error
+        __declspec(property(get=get_ErrorStatusCode)) USHORT ErrorStatusCode;
+        USHORT get_ErrorStatusCode() const { return errorStatusCode_; }
+
+        // Consumes request head bytes. Returns the number of bytes consumed, which is less than
+        // length only when the head completed (state is Body or Complete) or failed.
+        size_t ParseHead(char const * data, size_t length);
+
+        // Consumes body bytes. bodyData and bodyLength are set to the body bytes found, which point
+        // into data. Returns the number of bytes consumed; the state becomes Complete after the last
+        // byte of the body.
+        size_t ParseBody(char const * data, size_t length, __out char const * & bodyData, __out size_t & bodyLength);
+
+        // Prepares for the next request on the connection
+        void Reset();
+
+        // Returns the value of the header, with multiple occurrences joined by ", "
+        static bool TryGetHeader(HttpHeaderList const & headers, std::string const & name, __out std::string & value);
+
+    private:
+        enum ChunkState
+        {
+            ChunkSize,
+            ChunkData,
+            ChunkDataEnd,
+            Trailer
+        };
+
+        bool ParseHeadBlock();
+        bool ParseRequestLine(std::string const & line);
+        bool ParseHeaderLine(std::string const & line);
+        bool ApplyFramingHeaders();
+        void SetError(USHORT statusCode);
+
+        // Accumulates a CRLF terminated line of the chunked coding; returns true when lineBuffer_ has a complete line
+        bool TryTakeLine(char const * data, size_t length, __inout size_t & consumed);
+        bool ParseChunkSize();
+
+        size_t const maxHeadSize_;
+
+        State state_;
+        std::string headBuffer_;
+        std::string method_;
+        std::string target_;
+        int minorVersion_;
+        HttpHeaderList headers_;
+        bool keepAlive_;
+        bool expectContinue_;
+        bool isChunked_;
+        uint64 contentLength_;
+        uint64 remaining_;
+        ChunkState chunkState_;
+        std::string lineBuffer_;
+        USHORT errorStatusCode_;
+    };
+}
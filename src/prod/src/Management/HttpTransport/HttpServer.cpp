@@ -281,6 +281,25 @@ protected:
             },
             thisSPtr);
 #else
+        if (!error.IsSuccess())
+        {
+            TryComplete(thisSPtr, error);
+            return;
+        }
+
+        if (owner_.useNativeServer_)
+        {
+            HttpServerImpl & owner = owner_;
+            error = owner_.nativeServer_->Open(
+                [&owner](IRequestMessageContextUPtr && messageContext)
+            {
+                owner.DispatchRequest(move(messageContext));
+            });
+
+            TryComplete(thisSPtr, error);
+            return;
+        }
+
         HttpServerImpl & owner = owner_;
         owner_.LHttpBeginOpen(
             owner_.listenAddress_,
@@ -334,6 +353,13 @@ protected:
             },
             thisSPtr);
 #else
+        if (owner_.useNativeServer_)
+        {
+            owner_.nativeServer_->Close();
+            TryComplete(thisSPtr, ErrorCode::Success());
+            return;
+        }
+
         owner_.LHttpBeginClose(
             [this](AsyncOperationSPtr const& operation)
         {
@@ -528,7 +554,14 @@ ErrorCode HttpServerImpl::Initialize()
 
     if (!error.IsSuccess()) { return error; }
 #else
-    LHttpServer::Create(httpServer_);
+    if (useNativeServer_)
+    {
+        nativeServer_ = make_shared<NativeHttpServer>(listenAddress_, nativeServerSettings_);
+    }
+    else
+    {
+        LHttpServer::Create(httpServer_);
+    }
 #endif
 
     return ErrorCodeValue::Success;
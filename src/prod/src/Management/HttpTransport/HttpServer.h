@@ -30,9 +30,36 @@ namespace HttpServer
             , numberOfParallelRequests_(numberOfParallelRequests)
             , credentialKind_(credentialKind)
             , useLookasideAllocator_(false)
+#if defined(PLATFORM_UNIX)
+            , useNativeServer_(false)
+#endif
         {
         }
 
+#if defined(PLATFORM_UNIX)
+        //
+        // Plain text listeners are served by NativeHttpServer; secure listeners stay on the
+        // casablanca listener, which handles the TLS handshake and client certificates.
+        //
+        HttpServerImpl(
+            Common::ComponentRoot const &root,
+            std::wstring const& listenAddress,
+            ULONG numberOfParallelRequests,
+            Transport::SecurityProvider::Enum credentialKind,
+            NativeHttpServerSettings &&nativeServerSettings)
+            : AsyncFabricComponent()
+            , RootedObject(root)
+            , listenAddress_(listenAddress)
+            , prefixTreeUPtr_(std::make_unique<PrefixTree>(std::make_unique<PrefixTreeNode>(NodeData(listenAddress_))))
+            , numberOfParallelRequests_(numberOfParallelRequests)
+            , credentialKind_(credentialKind)
+            , useLookasideAllocator_(false)
+            , useNativeServer_(credentialKind == Transport::SecurityProvider::None)
+            , nativeServerSettings_(std::move(nativeServerSettings))
+        {
+        }
+#endif
+
 #if !defined(PLATFORM_UNIX)
         HttpServerImpl(
             Common::ComponentRoot const &root,
@@ -218,5 +245,11 @@ namespace HttpServer
         ULONG numberOfParallelRequests_;
         Transport::SecurityProvider::Enum credentialKind_;
         bool useLookasideAllocator_;
+
+#if defined(PLATFORM_UNIX)
+        bool useNativeServer_;
+        NativeHttpServerSettings nativeServerSettings_;
+        NativeHttpServerSPtr nativeServer_;
+#endif
     };
 }
@@ -37,5 +37,10 @@
 #include "HttpServer.LinuxAsyncServiceBaseOperation.h"
 #include "HttpServer.OpenLinuxAsyncServiceOperation.h"
 #include "HttpServer.CloseLinuxAsyncServiceOperation.h"
+#include "HttpRequestParser.h"
+#include "NativeHttpServer.ReceiveBufferPool.h"
+#include "NativeHttpServer.h"
+#include "NativeHttpServer.Connection.h"
+#include "NativeRequestMessageContext.h"
 
 #endif
@@ -26,6 +26,9 @@ namespace HttpServer
 
     class HttpServerWebSocket;
     typedef std::shared_ptr<HttpServerWebSocket> HttpServerWebSocketSPtr;
+
+    class NativeHttpServer;
+    typedef std::shared_ptr<NativeHttpServer> NativeHttpServerSPtr;
 }
 
 //
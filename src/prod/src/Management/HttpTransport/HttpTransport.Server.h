@@ -14,6 +14,9 @@
 #include "Constants.h"
 
 #include "LookasideAllocatorSettings.h"
+#if defined(PLATFORM_UNIX)
+#include "NativeHttpServerSettings.h"
+#endif
 #include "IRequestMessageContext.h"
 #include "IHttpRequestHandler.h"
 #include "IHttpServer.h"
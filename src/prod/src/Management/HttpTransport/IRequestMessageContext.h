@@ -202,6 +202,29 @@ namespace HttpServer
             __in Common::AsyncCallback const& callback,
             __in Common::AsyncOperationSPtr const& parent) = 0;
 
+        //
+        // Sends the chunks as the response body without coalescing them. The chunks must be kept
+        // alive until the send completes.
+        //
+        virtual Common::AsyncOperationSPtr BeginSendResponseChunks(
+            __in USHORT statusCode,
+            __in std::wstring description,
+            __in Common::ByteBufferChunkList const& chunks,
+            __in Common::AsyncCallback const& callback,
+            __in Common::AsyncOperationSPtr const& parent) = 0;
+
+        //
+        // Sends the contents of the file as the response body. Failing to open the file completes the
+        // operation with the error before anything is sent.
+        //
+        virtual Common::AsyncOperationSPtr BeginSendResponseFile(
+            __in USHORT statusCode,
+            __in std::wstring description,
+            __in std::wstring const& filePath,
+            __in Common::AsyncCallback const& callback,
+            __in Common::AsyncOperationSPtr const& parent) = 0;
+
+        // Completes all of the BeginSendResponse* operations
         virtual Common::ErrorCode EndSendResponse(
             __in Common::AsyncOperationSPtr const& operation) = 0;
     };
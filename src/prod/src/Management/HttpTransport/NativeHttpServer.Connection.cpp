@@ -0,0 +1,878 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <sys/sendfile.h>
+
+using namespace std;
+using namespace Common;
+using namespace HttpServer;
+
+StringLiteral const TraceType("NativeHttpConnection");
+
+namespace
+{
+    // Requests read ahead of the response being written, beyond which reading is paused
+    size_t const MaxPipelinedRequests = 16;
+
+    // Bounded so that one large file doesn't hold the connection lock for long
+    size_t const MaxSendfileChunk = 1024 * 1024;
+
+    int const MaxIovecs = 64;
+
+    char const ContinueResponse[] = "HTTP/1.1 100 Continue\r\n\r\n";
+
+    char const * GetReasonPhrase(USHORT statusCode)
+    {
+        switch (statusCode)
+        {
+        case 400: return "Bad Request";
+        case 417: return "Expectation Failed";
+        case 431: return "Request Header Fields Too Large";
+        case 501: return "Not Implemented";
+        case 505: return "HTTP Version Not Supported";
+        default: return "Error";
+        }
+    }
+
+    bool IsFramingHeader(string const & name)
+    {
+        // Framing is decided by the server from the response body
+        return StringUtility::AreEqualCaseInsensitive(name.c_str(), "Content-Length") ||
+            StringUtility::AreEqualCaseInsensitive(name.c_str(), "Transfer-Encoding") ||
+            StringUtility::AreEqualCaseInsensitive(name.c_str(), "Connection");
+    }
+}
+
+NativeHttpServer::Connection::RequestSlot::RequestSlot(uint64 id, bool keepAlive, bool expectContinue, bool hasBody)
+    : Id(id)
+    , KeepAlive(keepAlive)
+    , ExpectContinue(expectContinue)
+    , ContinuePending(false)
+    , BodyComplete(!hasBody)
+    , DiscardBody(false)
+    , BodySink()
+    , Responded(false)
+    , ResponseWritten(false)
+    , ResponseHead()
+    , PendingResponse()
+    , Segments()
+    , SegmentIndex(0)
+    , SegmentOffset(0)
+    , FileOffset(0)
+    , Completion()
+{
+}
+
+NativeHttpServer::Connection::Connection(NativeHttpServerSPtr const & server, int fd, wstring const & remoteAddress)
+    : server_(server)
+    , fd_(fd)
+    , remoteAddress_(remoteAddress)
+    , traceId_(wformatString("{0}", TextTraceThis))
+    , evtLoopIn_(nullptr)
+    , evtLoopOut_(nullptr)
+    , fdCtxIn_(nullptr)
+    , fdCtxOut_(nullptr)
+    , lock_()
+    , closed_(false)
+    , receiveArmed_(false)
+    , sendArmed_(false)
+    , receiveShutdown_(false)
+    , lastActivity_(Stopwatch::Now())
+    , parser_(server->Settings.MaxRequestHeaderSize)
+    , receiveBuffer_()
+    , receiveBegin_(0)
+    , receiveEnd_(0)
+    , nextRequestId_(0)
+    , slots_()
+    , receivingSlot_(nullptr)
+{
+    WriteNoise(TraceType, traceId_, "accepted from {0}", remoteAddress_);
+}
+
+NativeHttpServer::Connection::~Connection()
+{
+    WriteNoise(TraceType, traceId_, "destructed");
+}
+
+void NativeHttpServer::Connection::Start()
+{
+    EventLoopPool::GetDefault()->AssignPair(&evtLoopIn_, &evtLoopOut_);
+
+    // The registrations keep the connection alive until they are removed on close
+    auto thisSPtr = shared_from_this();
+
+    ActionList actions;
+    {
+        AcquireWriteLock grab(lock_);
+
+        fdCtxIn_ = evtLoopIn_->RegisterFd(
+            fd_,
+            EPOLLIN,
+            true,
+            [thisSPtr](int sd, uint events) { thisSPtr->ReadEvtCallback(sd, events); });
+
+        fdCtxOut_ = evtLoopOut_->RegisterFd(
+            fd_,
+            EPOLLOUT,
+            true,
+            [thisSPtr](int sd, uint events) { thisSPtr->WriteEvtCallback(sd, events); });
+
+        receiveArmed_ = true;
+        auto error = evtLoopIn_->Activate(fdCtxIn_);
+        if (!error.IsSuccess())
+        {
+            Close_CallerHoldsLock(error, actions);
+        }
+    }
+
+    RunActions(actions);
+}
+
+void NativeHttpServer::Connection::Close()
+{
+    ActionList actions;
+    {
+        AcquireWriteLock grab(lock_);
+        Close_CallerHoldsLock(ErrorCodeValue::ObjectClosed, actions);
+    }
+
+    RunActions(actions);
+}
+
+bool NativeHttpServer::Connection::CloseIfIdle(StopwatchTime idleSince)
+{
+    ActionList actions;
+    {
+        AcquireWriteLock grab(lock_);
+
+        if (closed_ || !slots_.empty() || lastActivity_ >= idleSince)
+        {
+            return false;
+        }
+
+        WriteNoise(TraceType, traceId_, "closing idle connection, last activity at {0}", lastActivity_);
+        Close_CallerHoldsLock(ErrorCodeValue::Timeout, actions);
+    }
+
+    RunActions(actions);
+    return true;
+}
+
+void NativeHttpServer::Connection::ReadEvtCallback(int, uint events)
+{
+    ActionList actions;
+    {
+        AcquireWriteLock grab(lock_);
+
+        receiveArmed_ = false;
+        if (closed_)
+        {
+            return;
+        }
+
+        if (events & EPOLLERR)
+        {
+            Close_CallerHoldsLock(ErrorCodeValue::OperationFailed, actions);
+        }
+        else
+        {
+            TryReceive_CallerHoldsLock(actions);
+        }
+    }
+
+    RunActions(actions);
+}
+
+void NativeHttpServer::Connection::WriteEvtCallback(int, uint events)
+{
+    ActionList actions;
+    {
+        AcquireWriteLock grab(lock_);
+
+        sendArmed_ = false;
+        if (closed_)
+        {
+            return;
+        }
+
+        if (events & EPOLLERR)
+        {
+            Close_CallerHoldsLock(ErrorCodeValue::OperationFailed, actions);
+        }
+        else
+        {
+            Send_CallerHoldsLock(actions);
+        }
+    }
+
+    RunActions(actions);
+}
+
+void NativeHttpServer::Connection::TryReceive_CallerHoldsLock(__inout ActionList & actions)
+{
+    for (;;)
+    {
+        ProcessReceived_CallerHoldsLock(actions);
+
+        if (closed_ || receiveShutdown_ || IsReceivePaused_CallerHoldsLock())
+        {
+            return;
+        }
+
+        if (!receiveBuffer_)
+        {
+            receiveBuffer_ = server_->ReceiveBufferPool.TakeBuffer();
+        }
+
+        // Everything received so far has been processed
+        receiveBegin_ = receiveEnd_ = 0;
+
+        auto received = read(fd_, receiveBuffer_->data(), receiveBuffer_->size());
+        if (received > 0)
+        {
+            receiveEnd_ = received;
+            lastActivity_ = Stopwatch::Now();
+            continue;
+        }
+
+        if (received == 0)
+        {
+            WriteNoise(TraceType, traceId_, "peer closed its side, {0} requests pending", slots_.size());
+
+            receiveShutdown_ = true;
+            if (slots_.empty() || parser_.CurrentState != HttpRequestParser::Head)
+            {
+                // Nothing left to respond to, or a request was cut off
+                Close_CallerHoldsLock(ErrorCodeValue::Success, actions);
+            }
+
+            return;
+        }
+
+        if (errno == EINTR)
+        {
+            continue;
+        }
+
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            // Idle connections don't hold on to a receive buffer
+            server_->ReceiveBufferPool.ReturnBuffer(move(receiveBuffer_));
+            receiveBuffer_.reset();
+
+            receiveArmed_ = true;
+            auto error = evtLoopIn_->Activate(fdCtxIn_);
+            if (!error.IsSuccess())
+            {
+                Close_CallerHoldsLock(error, actions);
+            }
+
+            return;
+        }
+
+        auto error = ErrorCode::FromErrno();
+        WriteInfo(TraceType, traceId_, "read failed: {0}", error);
+        Close_CallerHoldsLock(error, actions);
+        return;
+    }
+}
+
+bool NativeHttpServer::Connection::IsReceivePaused_CallerHoldsLock() const
+{
+    if (receiveBuffer_ && receiveBegin_ < receiveEnd_)
+    {
+        // Processing stopped short of the received data
+        return true;
+    }
+
+    switch (parser_.CurrentState)
+    {
+    case HttpRequestParser::Head:
+        return slots_.size() >= MaxPipelinedRequests;
+
+    case HttpRequestParser::Body:
+        return !receivingSlot_->BodySink && !receivingSlot_->DiscardBody;
+
+    default:
+        return false;
+    }
+}
+
+void NativeHttpServer::Connection::ResumeReceive_CallerHoldsLock(__inout ActionList & actions)
+{
+    if (closed_ || receiveShutdown_ || receiveArmed_)
+    {
+        return;
+    }
+
+    TryReceive_CallerHoldsLock(actions);
+}
+
+void NativeHttpServer::Connection::ProcessReceived_CallerHoldsLock(__inout ActionList & actions)
+{
+    while (!closed_ && !receiveShutdown_ && receiveBuffer_ && receiveBegin_ < receiveEnd_)
+    {
+        auto data = reinterpret_cast<char const *>(receiveBuffer_->data()) + receiveBegin_;
+        auto length = receiveEnd_ - receiveBegin_;
+
+        if (parser_.CurrentState == HttpRequestParser::Head)
+        {
+            if (slots_.size() >= MaxPipelinedRequests)
+            {
+                return;
+            }
+
+            receiveBegin_ += parser_.ParseHead(data, length);
+
+            if (parser_.CurrentState == HttpRequestParser::Error)
+            {
+                WriteInfo(TraceType, traceId_, "invalid request head, responding with {0}", parser_.ErrorStatusCode);
+
+                // The rest of the stream can't be parsed
+                receiveShutdown_ = true;
+                QueueErrorResponse_CallerHoldsLock(parser_.ErrorStatusCode);
+                Send_CallerHoldsLock(actions);
+                return;
+            }
+
+            if (parser_.CurrentState != HttpRequestParser::Head)
+            {
+                OnRequestHead_CallerHoldsLock(actions);
+            }
+        }
+        else if (parser_.CurrentState == HttpRequestParser::Body)
+        {
+            auto & slot = *receivingSlot_;
+            if (!slot.BodySink && !slot.DiscardBody)
+            {
+                // Wait for the handler to ask for the body
+                return;
+            }
+
+            char const * body = nullptr;
+            size_t bodyLength = 0;
+            receiveBegin_ += parser_.ParseBody(data, length, body, bodyLength);
+
+            if (bodyLength > 0 && slot.BodySink)
+            {
+                auto error = slot.BodySink->OnBodyData(body, bodyLength);
+                if (!error.IsSuccess())
+                {
+                    OnBodyComplete_CallerHoldsLock(slot, error, actions);
+                }
+            }
+
+            if (parser_.CurrentState == HttpRequestParser::Error)
+            {
+                WriteInfo(TraceType, traceId_, "invalid chunked body in request {0}", slot.Id);
+                OnBodyComplete_CallerHoldsLock(slot, ErrorCodeValue::InvalidMessage, actions);
+                Close_CallerHoldsLock(ErrorCodeValue::InvalidMessage, actions);
+                return;
+            }
+        }
+
+        if (parser_.CurrentState == HttpRequestParser::Complete)
+        {
+            auto & slot = *receivingSlot_;
+            slot.BodyComplete = true;
+            OnBodyComplete_CallerHoldsLock(slot, ErrorCodeValue::Success, actions);
+            receivingSlot_ = nullptr;
+
+            if (!parser_.KeepAlive)
+            {
+                // Anything after the last request is ignored
+                receiveShutdown_ = true;
+            }
+
+            parser_.Reset();
+
+            // A response waiting on the body to be drained can now complete
+            Send_CallerHoldsLock(actions);
+        }
+    }
+}
+
+void NativeHttpServer::Connection::OnRequestHead_CallerHoldsLock(__inout ActionList & actions)
+{
+    auto slot = make_unique<RequestSlot>(nextRequestId_++, parser_.KeepAlive, parser_.ExpectContinue, parser_.HasBody);
+    auto requestId = slot->Id;
+    receivingSlot_ = slot.get();
+    slots_.push_back(move(slot));
+
+    WriteNoise(
+        TraceType,
+        traceId_,
+        "request {0}: {1} {2}, keepAlive = {3}, pending = {4}",
+        requestId,
+        parser_.Method,
+        parser_.Target,
+        parser_.KeepAlive,
+        slots_.size());
+
+    // The context is created and dispatched after the lock is released
+    actions.push_back(
+        [thisSPtr = shared_from_this(),
+         requestId,
+         method = parser_.Method,
+         target = parser_.Target,
+         headers = parser_.Headers,
+         hasBody = parser_.HasBody]() mutable
+    {
+        auto const & server = *thisSPtr->server_;
+        auto messageContext = make_unique<NativeRequestMessageContext>(
+            thisSPtr,
+            requestId,
+            move(method),
+            move(target),
+            move(headers),
+            hasBody,
+            server.ListenPath,
+            server.Settings.MaxEntityBodySize);
+
+        thisSPtr->server_->DispatchRequest(move(messageContext));
+    });
+}
+
+void NativeHttpServer::Connection::OnBodyComplete_CallerHoldsLock(
+    RequestSlot & slot,
+    ErrorCode const & error,
+    __inout ActionList & actions)
+{
+    if (!error.IsSuccess())
+    {
+        slot.DiscardBody = true;
+    }
+
+    if (slot.BodySink)
+    {
+        actions.push_back([sink = move(slot.BodySink), error]() { sink->OnBodyComplete(error); });
+        slot.BodySink.reset();
+    }
+}
+
+ErrorCode NativeHttpServer::Connection::AttachBodySink(uint64 requestId, IBodySinkSPtr const & sink)
+{
+    ErrorCode error;
+    ActionList actions;
+    {
+        AcquireWriteLock grab(lock_);
+
+        auto slot = FindSlot_CallerHoldsLock(requestId);
+        if (closed_)
+        {
+            error = ErrorCodeValue::ObjectClosed;
+        }
+        else if (slot == nullptr || slot->BodySink || slot->Responded || slot->DiscardBody)
+        {
+            error = ErrorCodeValue::InvalidState;
+        }
+        else if (slot->BodyComplete)
+        {
+            actions.push_back([sink]() { sink->OnBodyComplete(ErrorCode::Success()); });
+        }
+        else
+        {
+            slot->BodySink = sink;
+
+            if (slot->ExpectContinue)
+            {
+                slot->ExpectContinue = false;
+                slot->ContinuePending = true;
+                Send_CallerHoldsLock(actions);
+            }
+
+            ResumeReceive_CallerHoldsLock(actions);
+        }
+    }
+
+    RunActions(actions);
+    return error;
+}
+
+void NativeHttpServer::Connection::SendResponse(uint64 requestId, Response && response, SendCompletion const & completion)
+{
+    ActionList actions;
+    {
+        AcquireWriteLock grab(lock_);
+
+        auto slot = FindSlot_CallerHoldsLock(requestId);
+        if (closed_ || slot == nullptr || slot->Responded)
+        {
+            if (response.FileFd >= 0)
+            {
+                ::close(response.FileFd);
+            }
+
+            ErrorCode error = closed_ ? ErrorCodeValue::ObjectClosed : ErrorCodeValue::InvalidState;
+            actions.push_back([completion, error]() { completion(error); });
+        }
+        else
+        {
+            slot->Responded = true;
+            slot->PendingResponse = move(response);
+            slot->Completion = completion;
+
+            if (!slot->BodyComplete)
+            {
+                OnBodyComplete_CallerHoldsLock(*slot, ErrorCodeValue::OperationCanceled, actions);
+
+                if (slot->ExpectContinue)
+                {
+                    // The client is waiting to be told to send the body; rather than reading it,
+                    // the connection is closed after the response
+                    slot->ExpectContinue = false;
+                    slot->KeepAlive = false;
+                    slot->BodyComplete = true;
+                    receiveShutdown_ = true;
+                }
+                else
+                {
+                    // The unread body is consumed and dropped to get to the next request
+                    slot->DiscardBody = true;
+                }
+            }
+
+            PrepareResponse_CallerHoldsLock(*slot);
+            Send_CallerHoldsLock(actions);
+            ResumeReceive_CallerHoldsLock(actions);
+        }
+    }
+
+    RunActions(actions);
+}
+
+void NativeHttpServer::Connection::OnRequestAbandoned(uint64 requestId)
+{
+    ActionList actions;
+    {
+        AcquireWriteLock grab(lock_);
+
+        auto slot = FindSlot_CallerHoldsLock(requestId);
+        if (slot == nullptr || slot->Responded)
+        {
+            return;
+        }
+
+        WriteWarning(TraceType, traceId_, "request {0} was not responded to", requestId);
+        Close_CallerHoldsLock(ErrorCodeValue::OperationCanceled, actions);
+    }
+
+    RunActions(actions);
+}
+
+void NativeHttpServer::Connection::QueueErrorResponse_CallerHoldsLock(USHORT statusCode)
+{
+    auto slot = make_unique<RequestSlot>(nextRequestId_++, false, false, false);
+    slot->Responded = true;
+    slot->PendingResponse.StatusCode = statusCode;
+    slot->PendingResponse.Reason = GetReasonPhrase(statusCode);
+
+    PrepareResponse_CallerHoldsLock(*slot);
+    slots_.push_back(move(slot));
+}
+
+void NativeHttpServer::Connection::PrepareResponse_CallerHoldsLock(RequestSlot & slot)
+{
+    auto & response = slot.PendingResponse;
+
+    uint64 contentLength = 0;
+    if (response.Body)
+    {
+        contentLength = response.Body->size();
+    }
+    else if (response.Chunks != nullptr)
+    {
+        for (auto const & chunk : *response.Chunks)
+        {
+            contentLength += chunk->size();
+        }
+    }
+    else if (response.FileFd >= 0)
+    {
+        contentLength = response.FileSize;
+    }
+
+    auto & head = slot.ResponseHead;
+    head.reserve(256);
+    head.append("HTTP/1.1 ");
+    head.append(to_string(response.StatusCode));
+    head.append(" ");
+    head.append(response.Reason);
+    head.append("\r\n");
+
+    for (auto const & header : response.Headers)
+    {
+        if (IsFramingHeader(header.first))
+        {
+            continue;
+        }
+
+        head.append(header.first);
+        head.append(": ");
+        head.append(header.second);
+        head.append("\r\n");
+    }
+
+    head.append("Content-Length: ");
+    head.append(to_string(contentLength));
+    head.append("\r\n");
+
+    if (!slot.KeepAlive)
+    {
+        head.append("Connection: close\r\n");
+    }
+
+    head.append("\r\n");
+
+    // A 100 Continue that is not on its way yet is no longer needed
+    slot.ContinuePending = false;
+
+    slot.Segments.push_back(Segment { head.data(), head.size() });
+
+    if (response.Body && !response.Body->empty())
+    {
+        slot.Segments.push_back(Segment { reinterpret_cast<char const *>(response.Body->data()), response.Body->size() });
+    }
+    else if (response.Chunks != nullptr)
+    {
+        for (auto const & chunk : *response.Chunks)
+        {
+            if (!chunk->empty())
+            {
+                slot.Segments.push_back(Segment { reinterpret_cast<char const *>(chunk->data()), chunk->size() });
+            }
+        }
+    }
+}
+
+bool NativeHttpServer::Connection::TryWrite_CallerHoldsLock(RequestSlot & slot, __out bool & wouldBlock)
+{
+    wouldBlock = false;
+
+    while (slot.SegmentIndex < slot.Segments.size())
+    {
+        iovec iov[MaxIovecs];
+        int count = 0;
+        for (auto i = slot.SegmentIndex; i < slot.Segments.size() && count < MaxIovecs; ++i, ++count)
+        {
+            auto offset = (i == slot.SegmentIndex) ? slot.SegmentOffset : 0;
+            iov[count].iov_base = const_cast<char *>(slot.Segments[i].Data + offset);
+            iov[count].iov_len = slot.Segments[i].Length - offset;
+        }
+
+        auto written = writev(fd_, iov, count);
+        if (written < 0)
+        {
+            if (errno == EINTR) { continue; }
+
+            wouldBlock = (errno == EAGAIN || errno == EWOULDBLOCK);
+            return wouldBlock;
+        }
+
+        size_t remaining = written;
+        while (remaining > 0)
+        {
+            auto left = slot.Segments[slot.SegmentIndex].Length - slot.SegmentOffset;
+            if (remaining < left)
+            {
+                slot.SegmentOffset += remaining;
+                break;
+            }
+
+            remaining -= left;
+            ++slot.SegmentIndex;
+            slot.SegmentOffset = 0;
+        }
+    }
+
+    auto & response = slot.PendingResponse;
+    if (!slot.Responded || response.FileFd < 0)
+    {
+        return true;
+    }
+
+    while (slot.FileOffset < response.FileSize)
+    {
+        off_t offset = static_cast<off_t>(slot.FileOffset);
+        auto sent = sendfile(fd_, response.FileFd, &offset, static_cast<size_t>(min<uint64>(response.FileSize - slot.FileOffset, MaxSendfileChunk)));
+        if (sent < 0)
+        {
+            if (errno == EINTR) { continue; }
+
+            wouldBlock = (errno == EAGAIN || errno == EWOULDBLOCK);
+            return wouldBlock;
+        }
+
+        if (sent == 0)
+        {
+            // The file was truncated after its size was taken, the promised length can't be sent
+            errno = EIO;
+            return false;
+        }
+
+        slot.FileOffset = offset;
+    }
+
+    return true;
+}
+
+void NativeHttpServer::Connection::Send_CallerHoldsLock(__inout ActionList & actions)
+{
+    while (!closed_ && !slots_.empty())
+    {
+        auto & slot = *slots_.front();
+
+        if (slot.ContinuePending)
+        {
+            slot.ContinuePending = false;
+            slot.Segments.push_back(Segment { ContinueResponse, sizeof(ContinueResponse) - 1 });
+        }
+
+        if (!slot.ResponseWritten)
+        {
+            bool wouldBlock = false;
+            if (!TryWrite_CallerHoldsLock(slot, wouldBlock))
+            {
+                auto error = ErrorCode::FromErrno();
+                WriteInfo(TraceType, traceId_, "write failed: {0}", error);
+                Close_CallerHoldsLock(error, actions);
+                return;
+            }
+
+            if (wouldBlock)
+            {
+                if (!sendArmed_)
+                {
+                    sendArmed_ = true;
+                    auto error = evtLoopOut_->Activate(fdCtxOut_);
+                    if (!error.IsSuccess())
+                    {
+                        Close_CallerHoldsLock(error, actions);
+                    }
+                }
+
+                return;
+            }
+
+            if (!slot.Responded)
+            {
+                // Waiting for the handler
+                return;
+            }
+
+            slot.ResponseWritten = true;
+            lastActivity_ = Stopwatch::Now();
+
+            if (slot.PendingResponse.FileFd >= 0)
+            {
+                ::close(slot.PendingResponse.FileFd);
+                slot.PendingResponse.FileFd = -1;
+            }
+
+            if (slot.Completion)
+            {
+                actions.push_back([completion = move(slot.Completion)]() { completion(ErrorCode::Success()); });
+                slot.Completion = nullptr;
+            }
+        }
+
+        if (!slot.BodyComplete)
+        {
+            // The request body is still being drained
+            return;
+        }
+
+        bool keepAlive = slot.KeepAlive;
+        if (receivingSlot_ == &slot)
+        {
+            receivingSlot_ = nullptr;
+        }
+
+        slots_.pop_front();
+
+        if (!keepAlive || (receiveShutdown_ && slots_.empty()))
+        {
+            Close_CallerHoldsLock(ErrorCodeValue::Success, actions);
+            return;
+        }
+    }
+}
+
+void NativeHttpServer::Connection::Close_CallerHoldsLock(ErrorCode const & error, __inout ActionList & actions)
+{
+    if (closed_)
+    {
+        return;
+    }
+
+    closed_ = true;
+
+    WriteNoise(TraceType, traceId_, "closing with {0}, {1} requests pending", error, slots_.size());
+
+    for (auto & slot : slots_)
+    {
+        OnBodyComplete_CallerHoldsLock(*slot, ErrorCodeValue::ObjectClosed, actions);
+
+        if (slot->PendingResponse.FileFd >= 0)
+        {
+            ::close(slot->PendingResponse.FileFd);
+            slot->PendingResponse.FileFd = -1;
+        }
+
+        if (slot->Completion)
+        {
+            actions.push_back([completion = move(slot->Completion)]() { completion(ErrorCodeValue::ObjectClosed); });
+        }
+    }
+
+    slots_.clear();
+    receivingSlot_ = nullptr;
+
+    if (receiveBuffer_)
+    {
+        server_->ReceiveBufferPool.ReturnBuffer(move(receiveBuffer_));
+        receiveBuffer_.reset();
+    }
+
+    // Waiting for callbacks would deadlock when closing from one of them; they check closed_ instead
+    if (fdCtxIn_)
+    {
+        evtLoopIn_->UnregisterFd(fdCtxIn_, false);
+        fdCtxIn_ = nullptr;
+    }
+
+    if (fdCtxOut_)
+    {
+        evtLoopOut_->UnregisterFd(fdCtxOut_, false);
+        fdCtxOut_ = nullptr;
+    }
+
+    ::close(fd_);
+
+    actions.push_back([thisSPtr = shared_from_this()]() { thisSPtr->server_->OnConnectionClosed(thisSPtr.get()); });
+}
+
+NativeHttpServer::Connection::RequestSlot * NativeHttpServer::Connection::FindSlot_CallerHoldsLock(uint64 requestId)
+{
+    for (auto & slot : slots_)
+    {
+        if (slot->Id == requestId)
+        {
+            return slot.get();
+        }
+    }
+
+    return nullptr;
+}
+
+void NativeHttpServer::Connection::RunActions(ActionList & actions)
+{
+    for (auto & action : actions)
+    {
+        action();
+    }
+}
@@ -0,0 +1,149 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace HttpServer
+{
+    //
+    // One accepted connection. Receive and send readiness are reported on a pair of event loops, the same
+    // way TcpConnection does it. Every syscall on the socket is made with lock_ held after checking closed_,
+    // so that the descriptor cannot be reused under a callback that is still running. Completions of body
+    // sinks and responses are collected while the lock is held and run after it is released.
+    //
+    class NativeHttpServer::Connection
+        : public std::enable_shared_from_this<NativeHttpServer::Connection>
+        , public Common::TextTraceComponent<Common::TraceTaskCodes::HttpGateway>
+    {
+        DENY_COPY(Connection)
+
+    public:
+        typedef std::function<void(Common::ErrorCode const &)> SendCompletion;
+
+        struct Response
+        {
+            Response()
+                : StatusCode(0)
+                , Headers()
+                , Body()
+                , Chunks(nullptr)
+                , FileFd(-1)
+                , FileSize(0)
+            {
+            }
+
+            USHORT StatusCode;
+            std::string Reason;
+            HttpHeaderList Headers;
+
+            // At most one of the following body sources is set. Chunks are owned by the caller and must
+            // be kept alive until the send completes; the file descriptor is closed by the connection.
+            Common::ByteBufferUPtr Body;
+            Common::ByteBufferChunkList const * Chunks;
+            int FileFd;
+            uint64 FileSize;
+        };
+
+        Connection(NativeHttpServerSPtr const & server, int fd, std::wstring const & remoteAddress);
+        ~Connection();
+
+        __declspec(property(get=get_RemoteAddress)) std::wstring const & RemoteAddress;
+        std::wstring const & get_RemoteAddress() const { return remoteAddress_; }
+
+        void Start();
+        void Close();
+
+        // Closes the connection if it has been idle with no request in progress since idleSince
+        bool CloseIfIdle(Common::StopwatchTime idleSince);
+
+        Common::ErrorCode AttachBodySink(uint64 requestId, IBodySinkSPtr const & sink);
+        void SendResponse(uint64 requestId, Response && response, SendCompletion const & completion);
+
+        // The request context went away without responding; the responses that follow can't be sent in order
+        void OnRequestAbandoned(uint64 requestId);
+
+    private:
+        typedef std::vector<std::function<void()>> ActionList;
+
+        struct Segment
+        {
+            char const * Data;
+            size_t Length;
+        };
+
+        struct RequestSlot
+        {
+            RequestSlot(uint64 id, bool keepAlive, bool expectContinue, bool hasBody);
+
+            uint64 Id;
+            bool KeepAlive;
+            bool ExpectContinue;
+            bool ContinuePending;
+            bool BodyComplete;
+            bool DiscardBody;
+            IBodySinkSPtr BodySink;
+
+            bool Responded;
+            bool ResponseWritten;
+            std::string ResponseHead;
+            Response PendingResponse;
+            std::vector<Segment> Segments;
+            size_t SegmentIndex;
+            size_t SegmentOffset;
+            uint64 FileOffset;
+            SendCompletion Completion;
+        };
+
+        typedef std::unique_ptr<RequestSlot> RequestSlotUPtr;
+
+        void ReadEvtCallback(int fd, uint events);
+        void WriteEvtCallback(int fd, uint events);
+
+        void TryReceive_CallerHoldsLock(__inout ActionList & actions);
+        void ProcessReceived_CallerHoldsLock(__inout ActionList & actions);
+        bool IsReceivePaused_CallerHoldsLock() const;
+        void ResumeReceive_CallerHoldsLock(__inout ActionList & actions);
+        void OnRequestHead_CallerHoldsLock(__inout ActionList & actions);
+        void OnBodyComplete_CallerHoldsLock(RequestSlot & slot, Common::ErrorCode const & error, __inout ActionList & actions);
+        void QueueErrorResponse_CallerHoldsLock(USHORT statusCode);
+
+        void PrepareResponse_CallerHoldsLock(RequestSlot & slot);
+        bool TryWrite_CallerHoldsLock(RequestSlot & slot, __out bool & wouldBlock);
+        void Send_CallerHoldsLock(__inout ActionList & actions);
+
+        void Close_CallerHoldsLock(Common::ErrorCode const & error, __inout ActionList & actions);
+        RequestSlot * FindSlot_CallerHoldsLock(uint64 requestId);
+
+        static void RunActions(ActionList & actions);
+
+        NativeHttpServerSPtr const server_;
+        int const fd_;
+        std::wstring const remoteAddress_;
+        std::wstring const traceId_;
+
+        Common::EventLoop * evtLoopIn_;
+        Common::EventLoop * evtLoopOut_;
+        Common::EventLoop::FdContext * fdCtxIn_;
+        Common::EventLoop::FdContext * fdCtxOut_;
+
+        mutable Common::RwLock lock_;
+        bool closed_;
+        bool receiveArmed_;
+        bool sendArmed_;
+        bool receiveShutdown_;
+        Common::StopwatchTime lastActivity_;
+
+        HttpRequestParser parser_;
+        Common::ByteBufferUPtr receiveBuffer_;
+        size_t receiveBegin_;
+        size_t receiveEnd_;
+
+        uint64 nextRequestId_;
+        std::deque<RequestSlotUPtr> slots_;
+
+        // The slot whose body the parser is reading, if any
+        RequestSlot * receivingSlot_;
+    };
+}
@@ -0,0 +1,73 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace HttpServer
+{
+    //
+    // Receive buffers of the native HTTP server. A connection takes a buffer when its socket becomes
+    // readable and returns it once everything received has been consumed, so idle keep-alive connections
+    // don't hold one. The pool only has to cover the connections that are reading at the same time, and
+    // the memory it keeps is bounded independently of the buffer size.
+    //
+    class NativeHttpServerReceiveBufferPool
+    {
+        DENY_COPY(NativeHttpServerReceiveBufferPool)
+
+    public:
+        static const size_t MaxPooledBytes = 16 * 1024 * 1024;
+
+        explicit NativeHttpServerReceiveBufferPool(size_t bufferSize)
+            : bufferSize_(bufferSize)
+            , maxPooledBuffers_(std::max<size_t>(MaxPooledBytes / bufferSize, 1))
+            , lock_()
+            , buffers_()
+        {
+        }
+
+        __declspec(property(get=get_BufferSize)) size_t BufferSize;
+        size_t get_BufferSize() const { return bufferSize_; }
+
+        //
+        // Returns a buffer with size() == BufferSize. The contents are undefined.
+        //
+        Common::ByteBufferUPtr TakeBuffer()
+        {
+            {
+                Common::AcquireExclusiveLock grab(lock_);
+                if (!buffers_.empty())
+                {
+                    auto buffer = std::move(buffers_.back());
+                    buffers_.pop_back();
+                    return buffer;
+                }
+            }
+
+            return std::make_unique<Common::ByteBuffer>(bufferSize_);
+        }
+
+        // Receive buffers are never resized by the connection, anything else is not pooled
+        void ReturnBuffer(Common::ByteBufferUPtr && buffer)
+        {
+            if (!buffer || buffer->size() != bufferSize_)
+            {
+                return;
+            }
+
+            Common::AcquireExclusiveLock grab(lock_);
+            if (buffers_.size() < maxPooledBuffers_)
+            {
+                buffers_.push_back(std::move(buffer));
+            }
+        }
+
+    private:
+        size_t const bufferSize_;
+        size_t const maxPooledBuffers_;
+        Common::ExclusiveLock lock_;
+        std::vector<Common::ByteBufferUPtr> buffers_;
+    };
+}
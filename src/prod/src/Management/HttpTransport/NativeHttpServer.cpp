@@ -0,0 +1,331 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace std;
+using namespace Common;
+using namespace HttpServer;
+
+StringLiteral const TraceType("NativeHttpServer");
+StringLiteral const IdleTimerTag("NativeHttpServer.Idle");
+
+NativeHttpServer::NativeHttpServer(wstring const & listenAddress, NativeHttpServerSettings const & settings)
+    : listenAddress_(listenAddress)
+    , settings_(settings)
+    , listenPath_()
+    , receiveBufferPool_(settings.ReceiveBufferSize)
+    , lock_()
+    , closed_(false)
+    , listenFd_(-1)
+    , acceptLoop_(nullptr)
+    , acceptFdContext_(nullptr)
+    , requestHandler_()
+    , connections_()
+    , idleTimer_()
+{
+}
+
+NativeHttpServer::~NativeHttpServer()
+{
+    Close();
+}
+
+ErrorCode NativeHttpServer::Open(RequestHandler const & requestHandler)
+{
+    requestHandler_ = requestHandler;
+
+    auto error = CreateListenSocket();
+    if (!error.IsSuccess())
+    {
+        return error;
+    }
+
+    acceptLoop_ = &EventLoopPool::GetDefault()->Assign();
+    acceptFdContext_ = acceptLoop_->RegisterFd(
+        listenFd_,
+        EPOLLIN,
+        true,
+        [this](int sd, uint events) { AcceptCallback(sd, events); });
+
+    error = acceptLoop_->Activate(acceptFdContext_);
+    if (!error.IsSuccess())
+    {
+        WriteWarning(TraceType, "failed to activate listener on {0}: {1}", listenAddress_, error);
+        return error;
+    }
+
+    auto idleCheckInterval = TimeSpan::FromTicks(max(settings_.KeepAliveTimeout.Ticks / 2, TimeSpan::FromSeconds(1).Ticks));
+    idleTimer_ = Timer::Create(
+        IdleTimerTag,
+        [this](TimerSPtr const &) { OnIdleTimer(); },
+        false);
+    idleTimer_->SetCancelWait();
+    idleTimer_->Change(idleCheckInterval, idleCheckInterval);
+
+    WriteInfo(
+        TraceType,
+        "listening on {0}: maxHeaderSize = {1}, maxBodySize = {2}, receiveBufferSize = {3}, keepAliveTimeout = {4}",
+        listenAddress_,
+        settings_.MaxRequestHeaderSize,
+        settings_.MaxEntityBodySize,
+        settings_.ReceiveBufferSize,
+        settings_.KeepAliveTimeout);
+
+    return ErrorCode::Success();
+}
+
+void NativeHttpServer::Close()
+{
+    vector<ConnectionSPtr> connections;
+    {
+        AcquireWriteLock grab(lock_);
+
+        if (closed_)
+        {
+            return;
+        }
+
+        closed_ = true;
+        for (auto const & connection : connections_)
+        {
+            connections.push_back(connection.second);
+        }
+
+        connections_.clear();
+    }
+
+    if (acceptFdContext_)
+    {
+        acceptLoop_->UnregisterFd(acceptFdContext_, true);
+        acceptFdContext_ = nullptr;
+    }
+
+    if (listenFd_ >= 0)
+    {
+        ::close(listenFd_);
+        listenFd_ = -1;
+    }
+
+    if (idleTimer_)
+    {
+        idleTimer_->Cancel();
+    }
+
+    WriteInfo(TraceType, "closing listener on {0}, {1} connections", listenAddress_, connections.size());
+
+    for (auto const & connection : connections)
+    {
+        connection->Close();
+    }
+}
+
+ErrorCode NativeHttpServer::ParseListenAddress(__out string & host, __out string & port)
+{
+    string address;
+    StringUtility::Utf16ToUtf8(listenAddress_, address);
+
+    // <scheme>://<host>:<port>/<path>
+    auto schemeEnd = address.find("://");
+    if (schemeEnd == string::npos)
+    {
+        return ErrorCodeValue::InvalidAddress;
+    }
+
+    auto authorityBegin = schemeEnd + 3;
+    auto pathBegin = address.find('/', authorityBegin);
+    string authority = address.substr(authorityBegin, pathBegin == string::npos ? string::npos : pathBegin - authorityBegin);
+    listenPath_ = (pathBegin == string::npos) ? "/" : address.substr(pathBegin);
+
+    size_t portSeparator;
+    if (!authority.empty() && authority[0] == '[')
+    {
+        auto hostEnd = authority.find(']');
+        if (hostEnd == string::npos)
+        {
+            return ErrorCodeValue::InvalidAddress;
+        }
+
+        host = authority.substr(1, hostEnd - 1);
+        portSeparator = authority.find(':', hostEnd);
+    }
+    else
+    {
+        portSeparator = authority.rfind(':');
+        host = authority.substr(0, portSeparator);
+    }
+
+    port = (portSeparator == string::npos) ? "80" : authority.substr(portSeparator + 1);
+
+    // Wildcard hosts of http.sys style listen addresses
+    if (host == "+" || host == "*")
+    {
+        host.clear();
+    }
+
+    return port.empty() ? ErrorCodeValue::InvalidAddress : ErrorCodeValue::Success;
+}
+
+ErrorCode NativeHttpServer::CreateListenSocket()
+{
+    string host;
+    string port;
+    auto error = ParseListenAddress(host, port);
+    if (!error.IsSuccess())
+    {
+        WriteWarning(TraceType, "invalid listen address {0}", listenAddress_);
+        return error;
+    }
+
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+
+    addrinfo * addresses = nullptr;
+    auto result = getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &addresses);
+    if (result != 0)
+    {
+        WriteWarning(TraceType, "getaddrinfo({0}, {1}) failed: {2}", host, port, gai_strerror(result));
+        return ErrorCodeValue::InvalidAddress;
+    }
+
+    error = ErrorCodeValue::InvalidAddress;
+    for (auto address = addresses; address != nullptr; address = address->ai_next)
+    {
+        int fd = socket(address->ai_family, address->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, address->ai_protocol);
+        if (fd < 0)
+        {
+            error = ErrorCode::FromErrno();
+            continue;
+        }
+
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        if (::bind(fd, address->ai_addr, address->ai_addrlen) == 0 && listen(fd, SOMAXCONN) == 0)
+        {
+            listenFd_ = fd;
+            error = ErrorCode::Success();
+            break;
+        }
+
+        error = ErrorCode::FromErrno();
+        ::close(fd);
+    }
+
+    freeaddrinfo(addresses);
+
+    if (!error.IsSuccess())
+    {
+        WriteWarning(TraceType, "failed to listen on {0}: {1}", listenAddress_, error);
+    }
+
+    return error;
+}
+
+void NativeHttpServer::AcceptCallback(int, uint events)
+{
+    if (EventLoop::IsFdClosedOrInError(events))
+    {
+        WriteWarning(TraceType, "listen socket for {0} reported events {1:x}", listenAddress_, events);
+    }
+
+    for (;;)
+    {
+        sockaddr_storage remote;
+        socklen_t remoteLength = sizeof(remote);
+        int fd = accept4(listenFd_, reinterpret_cast<sockaddr*>(&remote), &remoteLength, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED)
+            {
+                continue;
+            }
+
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                WriteWarning(TraceType, "accept on {0} failed: {1}", listenAddress_, ErrorCode::FromErrno());
+            }
+
+            break;
+        }
+
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        auto connection = make_shared<Connection>(
+            shared_from_this(),
+            fd,
+            Endpoint(*reinterpret_cast<sockaddr const*>(&remote)).ToString());
+
+        {
+            AcquireWriteLock grab(lock_);
+
+            if (closed_)
+            {
+                ::close(fd);
+                return;
+            }
+
+            connections_[connection.get()] = connection;
+        }
+
+        connection->Start();
+    }
+
+    auto error = acceptLoop_->Activate(acceptFdContext_);
+    if (!error.IsSuccess())
+    {
+        WriteWarning(TraceType, "failed to reactivate listener on {0}: {1}", listenAddress_, error);
+    }
+}
+
+void NativeHttpServer::DispatchRequest(IRequestMessageContextUPtr && messageContext)
+{
+    {
+        AcquireReadLock grab(lock_);
+        if (closed_)
+        {
+            return;
+        }
+    }
+
+    requestHandler_(move(messageContext));
+}
+
+void NativeHttpServer::OnConnectionClosed(Connection const * connection)
+{
+    AcquireWriteLock grab(lock_);
+    connections_.erase(connection);
+}
+
+void NativeHttpServer::OnIdleTimer()
+{
+    vector<ConnectionSPtr> connections;
+    {
+        AcquireReadLock grab(lock_);
+        connections.reserve(connections_.size());
+        for (auto const & connection : connections_)
+        {
+            connections.push_back(connection.second);
+        }
+    }
+
+    auto idleSince = Stopwatch::Now() - settings_.KeepAliveTimeout;
+    size_t closed = 0;
+    for (auto const & connection : connections)
+    {
+        if (connection->CloseIfIdle(idleSince))
+        {
+            ++closed;
+        }
+    }
+
+    if (closed > 0)
+    {
+        WriteInfo(TraceType, "closed {0} of {1} connections idle for {2}", closed, connections.size(), settings_.KeepAliveTimeout);
+    }
+}
@@ -0,0 +1,86 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace HttpServer
+{
+    //
+    // HTTP/1.1 server for plain text listeners on Linux, driven by the process wide EventLoopPool
+    // instead of a thread per request. Connections are kept alive and pipelined requests are parsed
+    // from a pooled receive buffer and dispatched as soon as their head is read. Responses are written
+    // in request order with writev, or sendfile for file responses.
+    //
+    // Request bodies are not buffered by the server. They are handed to the body sink of the request
+    // as they are received, and reading from the connection is paused until the handler asks for the
+    // body, so that a slow handler pushes back on the client.
+    //
+    class NativeHttpServer
+        : public std::enable_shared_from_this<NativeHttpServer>
+        , public Common::TextTraceComponent<Common::TraceTaskCodes::HttpGateway>
+    {
+        DENY_COPY(NativeHttpServer)
+
+    public:
+        typedef std::function<void(IRequestMessageContextUPtr &&)> RequestHandler;
+
+        //
+        // Receives the body of a request. OnBodyData is called with the connection lock held and must not
+        // call back into the connection; returning an error stops delivery and the rest of the body is
+        // discarded. OnBodyComplete is called exactly once, without the lock held.
+        //
+        class IBodySink
+        {
+        public:
+            virtual ~IBodySink() {}
+            virtual Common::ErrorCode OnBodyData(char const * data, size_t length) = 0;
+            virtual void OnBodyComplete(Common::ErrorCode const & error) = 0;
+        };
+
+        typedef std::shared_ptr<IBodySink> IBodySinkSPtr;
+
+        class Connection;
+        typedef std::shared_ptr<Connection> ConnectionSPtr;
+
+        NativeHttpServer(std::wstring const & listenAddress, NativeHttpServerSettings const & settings);
+        ~NativeHttpServer();
+
+        __declspec(property(get=get_Settings)) NativeHttpServerSettings const & Settings;
+        NativeHttpServerSettings const & get_Settings() const { return settings_; }
+
+        // Path of the listen address, stripped from request targets to get the suffix
+        __declspec(property(get=get_ListenPath)) std::string const & ListenPath;
+        std::string const & get_ListenPath() const { return listenPath_; }
+
+        __declspec(property(get=get_ReceiveBufferPool)) NativeHttpServerReceiveBufferPool & ReceiveBufferPool;
+        NativeHttpServerReceiveBufferPool & get_ReceiveBufferPool() { return receiveBufferPool_; }
+
+        Common::ErrorCode Open(RequestHandler const & requestHandler);
+        void Close();
+
+        void DispatchRequest(IRequestMessageContextUPtr && messageContext);
+        void OnConnectionClosed(Connection const * connection);
+
+    private:
+        Common::ErrorCode ParseListenAddress(__out std::string & host, __out std::string & port);
+        Common::ErrorCode CreateListenSocket();
+        void AcceptCallback(int fd, uint events);
+        void OnIdleTimer();
+
+        std::wstring const listenAddress_;
+        NativeHttpServerSettings const settings_;
+        std::string listenPath_;
+        NativeHttpServerReceiveBufferPool receiveBufferPool_;
+
+        Common::RwLock lock_;
+        bool closed_;
+        int listenFd_;
+        Common::EventLoop * acceptLoop_;
+        Common::EventLoop::FdContext * acceptFdContext_;
+        RequestHandler requestHandler_;
+        std::unordered_map<Connection const *, ConnectionSPtr> connections_;
+        Common::TimerSPtr idleTimer_;
+    };
+}
@@ -0,0 +1,51 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace HttpServer
+{
+    class NativeHttpServerSettings
+    {
+    public:
+        NativeHttpServerSettings()
+            : maxRequestHeaderSize_(HttpCommon::HttpConstants::DefaultHeaderBufferSize)
+            , maxEntityBodySize_(HttpCommon::HttpConstants::MaxEntityBodySize)
+            , receiveBufferSize_(64 * 1024)
+            , keepAliveTimeout_(Common::TimeSpan::FromSeconds(120))
+        {}
+
+        NativeHttpServerSettings(
+            ULONG maxRequestHeaderSize,
+            ULONG maxEntityBodySize,
+            ULONG receiveBufferSize,
+            Common::TimeSpan keepAliveTimeout)
+            : maxRequestHeaderSize_(maxRequestHeaderSize)
+            , maxEntityBodySize_(maxEntityBodySize)
+            , receiveBufferSize_(receiveBufferSize)
+            , keepAliveTimeout_(keepAliveTimeout)
+        {
+        }
+
+        __declspec(property(get = get_MaxRequestHeaderSize)) ULONG MaxRequestHeaderSize;
+        ULONG get_MaxRequestHeaderSize() const { return maxRequestHeaderSize_; }
+
+        // Limit on bodies that are read into memory; uploads streamed to a file are not limited
+        __declspec(property(get = get_MaxEntityBodySize)) ULONG MaxEntityBodySize;
+        ULONG get_MaxEntityBodySize() const { return maxEntityBodySize_; }
+
+        __declspec(property(get = get_ReceiveBufferSize)) ULONG ReceiveBufferSize;
+        ULONG get_ReceiveBufferSize() const { return receiveBufferSize_; }
+
+        __declspec(property(get = get_KeepAliveTimeout)) Common::TimeSpan KeepAliveTimeout;
+        Common::TimeSpan get_KeepAliveTimeout() const { return keepAliveTimeout_; }
+
+    private:
+        ULONG maxRequestHeaderSize_;
+        ULONG maxEntityBodySize_;
+        ULONG receiveBufferSize_;
+        Common::TimeSpan keepAliveTimeout_;
+    };
+}
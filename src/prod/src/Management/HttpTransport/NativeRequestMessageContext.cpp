@@ -0,0 +1,522 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace std;
+using namespace Common;
+using namespace HttpServer;
+using namespace HttpCommon;
+
+StringLiteral const TraceType("NativeRequestMessageContext");
+
+//
+// Reads the request body from the connection as it is received. The operation is the body sink
+// for the duration of the read.
+//
+class NativeRequestMessageContext::ReadBodyAsyncOperation
+    : public AsyncOperation
+    , public NativeHttpServer::IBodySink
+    , public TextTraceComponent<TraceTaskCodes::HttpGateway>
+{
+    DENY_COPY(ReadBodyAsyncOperation)
+
+public:
+    ReadBodyAsyncOperation(
+        NativeRequestMessageContext const & messageContext,
+        AsyncCallback const & callback,
+        AsyncOperationSPtr const & parent)
+        : AsyncOperation(callback, parent)
+        , messageContext_(messageContext)
+    {
+    }
+
+    void OnBodyComplete(ErrorCode const & error) override
+    {
+        TryComplete(shared_from_this(), error);
+    }
+
+protected:
+    void OnStart(AsyncOperationSPtr const & thisSPtr) override
+    {
+        if (!messageContext_.hasBody_)
+        {
+            TryComplete(thisSPtr, ErrorCode::Success());
+            return;
+        }
+
+        auto error = messageContext_.connection_->AttachBodySink(
+            messageContext_.requestId_,
+            NativeHttpServer::IBodySinkSPtr(thisSPtr, static_cast<NativeHttpServer::IBodySink*>(this)));
+
+        if (!error.IsSuccess())
+        {
+            TryComplete(thisSPtr, error);
+        }
+    }
+
+    NativeRequestMessageContext const & messageContext_;
+};
+
+class NativeRequestMessageContext::GetMessageBodyAsyncOperation
+    : public NativeRequestMessageContext::ReadBodyAsyncOperation
+{
+    DENY_COPY(GetMessageBodyAsyncOperation)
+
+public:
+    GetMessageBodyAsyncOperation(
+        NativeRequestMessageContext const & messageContext,
+        AsyncCallback const & callback,
+        AsyncOperationSPtr const & parent)
+        : ReadBodyAsyncOperation(messageContext, callback, parent)
+        , body_()
+    {
+    }
+
+    static ErrorCode End(AsyncOperationSPtr const & operation, __out ByteBufferUPtr & body)
+    {
+        auto thisPtr = AsyncOperation::End<GetMessageBodyAsyncOperation>(operation);
+        if (thisPtr->Error.IsSuccess())
+        {
+            body = make_unique<ByteBuffer>(move(thisPtr->body_));
+        }
+
+        return thisPtr->Error;
+    }
+
+    ErrorCode OnBodyData(char const * data, size_t length) override
+    {
+        if (body_.size() + length > messageContext_.maxEntityBodySize_)
+        {
+            WriteInfo(
+                TraceType,
+                "Request body of {0} exceeds the limit of {1} bytes",
+                messageContext_.GetClientRequestId(),
+                messageContext_.maxEntityBodySize_);
+
+            return ErrorCodeValue::MessageTooLarge;
+        }
+
+        body_.insert(body_.end(), data, data + length);
+        return ErrorCode::Success();
+    }
+
+private:
+    ByteBuffer body_;
+};
+
+class NativeRequestMessageContext::GetFileFromUploadAsyncOperation
+    : public NativeRequestMessageContext::ReadBodyAsyncOperation
+{
+    DENY_COPY(GetFileFromUploadAsyncOperation)
+
+public:
+    GetFileFromUploadAsyncOperation(
+        NativeRequestMessageContext const & messageContext,
+        AsyncCallback const & callback,
+        AsyncOperationSPtr const & parent)
+        : ReadBodyAsyncOperation(messageContext, callback, parent)
+        , uniqueFileName_()
+        , fd_(-1)
+    {
+    }
+
+    static ErrorCode End(AsyncOperationSPtr const & operation, __out wstring & uniqueFileName)
+    {
+        auto thisPtr = AsyncOperation::End<GetFileFromUploadAsyncOperation>(operation);
+        if (thisPtr->Error.IsSuccess())
+        {
+            uniqueFileName = move(thisPtr->uniqueFileName_);
+        }
+
+        return thisPtr->Error;
+    }
+
+    ErrorCode OnBodyData(char const * data, size_t length) override
+    {
+        while (length > 0)
+        {
+            auto written = write(fd_, data, length);
+            if (written < 0)
+            {
+                if (errno == EINTR) { continue; }
+
+                auto error = ErrorCode::FromErrno();
+                WriteWarning(TraceType, "Writing upload file {0} failed with {1}", uniqueFileName_, error);
+                return error;
+            }
+
+            data += written;
+            length -= written;
+        }
+
+        return ErrorCode::Success();
+    }
+
+protected:
+    void OnStart(AsyncOperationSPtr const & thisSPtr) override
+    {
+        wstring fabricDataRoot;
+        auto error = FabricEnvironment::GetFabricDataRoot(fabricDataRoot);
+        if (!error.IsSuccess())
+        {
+            WriteWarning(TraceType, "Get fabric data root path failed with {0}", error);
+            TryComplete(thisSPtr, error);
+            return;
+        }
+
+        uniqueFileName_ = Path::Combine(fabricDataRoot, Guid::NewGuid().ToString());
+        fd_ = open(StringUtility::Utf16ToUtf8(uniqueFileName_).c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+        if (fd_ < 0)
+        {
+            error = ErrorCode::FromErrno();
+            WriteWarning(TraceType, "Creating upload file {0} failed with {1}", uniqueFileName_, error);
+            TryComplete(thisSPtr, error);
+            return;
+        }
+
+        WriteInfo(TraceType, "Add unique file {0} for request {1}", uniqueFileName_, messageContext_.GetUrl());
+
+        ReadBodyAsyncOperation::OnStart(thisSPtr);
+    }
+
+    void OnCompleted() override
+    {
+        if (fd_ >= 0)
+        {
+            ::close(fd_);
+            fd_ = -1;
+
+            if (!this->Error.IsSuccess())
+            {
+                File::Delete2(uniqueFileName_).ReadValue();
+            }
+        }
+
+        ReadBodyAsyncOperation::OnCompleted();
+    }
+
+private:
+    wstring uniqueFileName_;
+    int fd_;
+};
+
+class NativeRequestMessageContext::SendResponseAsyncOperation
+    : public AsyncOperation
+{
+    DENY_COPY(SendResponseAsyncOperation)
+
+public:
+    SendResponseAsyncOperation(
+        NativeHttpServer::ConnectionSPtr const & connection,
+        uint64 requestId,
+        NativeHttpServer::Connection::Response && response,
+        ErrorCode const & error,
+        AsyncCallback const & callback,
+        AsyncOperationSPtr const & parent)
+        : AsyncOperation(callback, parent)
+        , connection_(connection)
+        , requestId_(requestId)
+        , response_(move(response))
+        , error_(error)
+    {
+    }
+
+    static ErrorCode End(AsyncOperationSPtr const & operation)
+    {
+        return AsyncOperation::End<SendResponseAsyncOperation>(operation)->Error;
+    }
+
+protected:
+    void OnStart(AsyncOperationSPtr const & thisSPtr) override
+    {
+        if (!error_.IsSuccess())
+        {
+            TryComplete(thisSPtr, error_);
+            return;
+        }
+
+        connection_->SendResponse(
+            requestId_,
+            move(response_),
+            [this, thisSPtr](ErrorCode const & error) { TryComplete(thisSPtr, error); });
+    }
+
+private:
+    NativeHttpServer::ConnectionSPtr const connection_;
+    uint64 const requestId_;
+    NativeHttpServer::Connection::Response response_;
+    ErrorCode const error_;
+};
+
+NativeRequestMessageContext::NativeRequestMessageContext(
+    NativeHttpServer::ConnectionSPtr const & connection,
+    uint64 requestId,
+    string && method,
+    string && target,
+    HttpHeaderList && headers,
+    bool hasBody,
+    string const & listenPath,
+    ULONG maxEntityBodySize)
+    : connection_(connection)
+    , requestId_(requestId)
+    , headers_(move(headers))
+    , hasBody_(hasBody)
+    , maxEntityBodySize_(maxEntityBodySize)
+    , verb_()
+    , url_()
+    , suffix_()
+    , clientRequestId_()
+    , responseHeaders_()
+    , responded_(false)
+{
+    // Requests to a proxy carry the absolute form of the target
+    string path = move(target);
+    auto schemeEnd = path.find("://");
+    if (schemeEnd != string::npos && path.find('/') > schemeEnd)
+    {
+        auto pathBegin = path.find('/', schemeEnd + 3);
+        path = (pathBegin == string::npos) ? "/" : path.substr(pathBegin);
+    }
+
+    // The suffix is relative to the path the server listens on, like http_listener's relative uri
+    string prefix = listenPath;
+    if (!prefix.empty() && prefix.back() == '/')
+    {
+        prefix.pop_back();
+    }
+
+    string suffix = path;
+    if (!prefix.empty() && StringUtility::StartsWithCaseInsensitive<string>(suffix, prefix))
+    {
+        suffix = suffix.substr(prefix.size());
+    }
+
+    StringUtility::Utf8ToUtf16(method, verb_);
+    StringUtility::Utf8ToUtf16("http://localhost" + path, url_);
+    StringUtility::Utf8ToUtf16(suffix, suffix_);
+
+    //If client specifies a RequestId in header "X-ServiceFabricRequestId", use it for correlation
+    auto error = GetRequestHeader(*HttpConstants::ServiceFabricHttpClientRequestIdHeader, clientRequestId_);
+    if (!error.IsSuccess())
+    {
+        clientRequestId_ = Guid::NewGuid().ToString();
+    }
+}
+
+NativeRequestMessageContext::~NativeRequestMessageContext()
+{
+    if (!responded_)
+    {
+        connection_->OnRequestAbandoned(requestId_);
+    }
+}
+
+wstring const& NativeRequestMessageContext::GetVerb() const
+{
+    return verb_;
+}
+
+wstring NativeRequestMessageContext::GetUrl() const
+{
+    return url_;
+}
+
+wstring NativeRequestMessageContext::GetSuffix() const
+{
+    return suffix_;
+}
+
+wstring NativeRequestMessageContext::GetClientRequestId() const
+{
+    return clientRequestId_;
+}
+
+ErrorCode NativeRequestMessageContext::GetRequestHeader(__in wstring const &headerName, __out wstring &headerValue) const
+{
+    string name;
+    StringUtility::Utf16ToUtf8(headerName, name);
+
+    string value;
+    if (HttpRequestParser::TryGetHeader(headers_, name, value))
+    {
+        StringUtility::Utf8ToUtf16(value, headerValue);
+        return ErrorCode::Success();
+    }
+
+    return ErrorCode::FromNtStatus(STATUS_NOT_FOUND);
+}
+
+ErrorCode NativeRequestMessageContext::GetClientToken(__out HANDLE &hToken) const
+{
+    hToken = INVALID_HANDLE_VALUE;
+    return ErrorCode::Success();
+}
+
+AsyncOperationSPtr NativeRequestMessageContext::BeginGetClientCertificate(
+    __in AsyncCallback const& callback,
+    __in AsyncOperationSPtr const& parent) const
+{
+    return AsyncOperation::CreateAndStart<CompletedAsyncOperation>(callback, parent);
+}
+
+ErrorCode NativeRequestMessageContext::EndGetClientCertificate(
+    __in AsyncOperationSPtr const& operation,
+    __out SSL** sslContext) const
+{
+    // The native server only serves plain text listeners
+    *sslContext = nullptr;
+    return CompletedAsyncOperation::End(operation);
+}
+
+ErrorCode NativeRequestMessageContext::GetRemoteAddress(__out wstring &remoteAddress) const
+{
+    remoteAddress = connection_->RemoteAddress;
+    return ErrorCode::Success();
+}
+
+AsyncOperationSPtr NativeRequestMessageContext::BeginGetMessageBody(
+    __in AsyncCallback const& callback,
+    __in AsyncOperationSPtr const& parent) const
+{
+    return AsyncOperation::CreateAndStart<GetMessageBodyAsyncOperation>(*this, callback, parent);
+}
+
+ErrorCode NativeRequestMessageContext::EndGetMessageBody(
+    __in AsyncOperationSPtr const& operation,
+    __out ByteBufferUPtr &body) const
+{
+    return GetMessageBodyAsyncOperation::End(operation, body);
+}
+
+AsyncOperationSPtr NativeRequestMessageContext::BeginGetFileFromUpload(
+    __in ULONG,
+    __in ULONG,
+    __in ULONG,
+    __in AsyncCallback const& callback,
+    __in AsyncOperationSPtr const& parent) const
+{
+    // The body is written to the file as it is received, so the chunk sizes don't apply
+    return AsyncOperation::CreateAndStart<GetFileFromUploadAsyncOperation>(*this, callback, parent);
+}
+
+ErrorCode NativeRequestMessageContext::EndGetFileFromUpload(
+    __in AsyncOperationSPtr const& operation,
+    __out wstring & uniqueFileName) const
+{
+    return GetFileFromUploadAsyncOperation::End(operation, uniqueFileName);
+}
+
+ErrorCode NativeRequestMessageContext::SetResponseHeader(__in wstring const &headerName, __in wstring const &headerValue)
+{
+    string name;
+    string value;
+    StringUtility::Utf16ToUtf8(headerName, name);
+    StringUtility::Utf16ToUtf8(headerValue, value);
+    responseHeaders_.push_back(make_pair(move(name), move(value)));
+    return ErrorCode::Success();
+}
+
+AsyncOperationSPtr NativeRequestMessageContext::BeginSendResponse(
+    __in ErrorCode operationStatus,
+    __in ByteBufferUPtr bodyUPtr,
+    __in AsyncCallback const& callback,
+    __in AsyncOperationSPtr const& parent)
+{
+    USHORT httpStatus;
+    wstring httpStatusLine;
+    HttpUtil::ErrorCodeToHttpStatus(operationStatus.ReadValue(), httpStatus, httpStatusLine);
+
+    return BeginSendResponse(httpStatus, move(httpStatusLine), move(bodyUPtr), callback, parent);
+}
+
+AsyncOperationSPtr NativeRequestMessageContext::BeginSendResponse(
+    __in USHORT statusCode,
+    __in wstring description,
+    __in ByteBufferUPtr bodyUPtr,
+    __in AsyncCallback const& callback,
+    __in AsyncOperationSPtr const& parent)
+{
+    NativeHttpServer::Connection::Response response;
+    response.Body = move(bodyUPtr);
+
+    return BeginSendResponse(statusCode, description, move(response), callback, parent);
+}
+
+AsyncOperationSPtr NativeRequestMessageContext::BeginSendResponseChunks(
+    __in USHORT statusCode,
+    __in wstring description,
+    __in ByteBufferChunkList const& chunks,
+    __in AsyncCallback const& callback,
+    __in AsyncOperationSPtr const& parent)
+{
+    NativeHttpServer::Connection::Response response;
+    response.Chunks = &chunks;
+
+    return BeginSendResponse(statusCode, description, move(response), callback, parent);
+}
+
+AsyncOperationSPtr NativeRequestMessageContext::BeginSendResponseFile(
+    __in USHORT statusCode,
+    __in wstring description,
+    __in wstring const& filePath,
+    __in AsyncCallback const& callback,
+    __in AsyncOperationSPtr const& parent)
+{
+    NativeHttpServer::Connection::Response response;
+
+    response.FileFd = open(StringUtility::Utf16ToUtf8(filePath).c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat fileStat;
+    if (response.FileFd < 0 || fstat(response.FileFd, &fileStat) != 0)
+    {
+        auto error = ErrorCode::FromErrno();
+        WriteInfo(TraceType, "Opening response file {0} failed with {1}", filePath, error);
+
+        if (response.FileFd >= 0)
+        {
+            ::close(response.FileFd);
+        }
+
+        // Nothing was sent, the caller can still respond with the error
+        return AsyncOperation::CreateAndStart<SendResponseAsyncOperation>(
+            connection_,
+            requestId_,
+            NativeHttpServer::Connection::Response(),
+            error,
+            callback,
+            parent);
+    }
+
+    response.FileSize = static_cast<uint64>(fileStat.st_size);
+
+    return BeginSendResponse(statusCode, description, move(response), callback, parent);
+}
+
+AsyncOperationSPtr NativeRequestMessageContext::BeginSendResponse(
+    USHORT statusCode,
+    wstring const & description,
+    NativeHttpServer::Connection::Response && response,
+    AsyncCallback const& callback,
+    AsyncOperationSPtr const& parent)
+{
+    response.StatusCode = statusCode;
+    StringUtility::Utf16ToUtf8(description, response.Reason);
+    response.Headers = responseHeaders_;
+    responded_ = true;
+
+    return AsyncOperation::CreateAndStart<SendResponseAsyncOperation>(
+        connection_,
+        requestId_,
+        move(response),
+        ErrorCode::Success(),
+        callback,
+        parent);
+}
+
+ErrorCode NativeRequestMessageContext::EndSendResponse(
+    __in AsyncOperationSPtr const& operation)
+{
+    return SendResponseAsyncOperation::End(operation);
+}
@@ -0,0 +1,137 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace HttpServer
+{
+    //
+    // Request message context of the native Linux http server. The request head is owned by the context;
+    // the body is read from the connection only when the handler asks for it.
+    //
+    class NativeRequestMessageContext
+        : public IRequestMessageContext
+        , public Common::TextTraceComponent<Common::TraceTaskCodes::HttpGateway>
+    {
+        DENY_COPY(NativeRequestMessageContext)
+
+    public:
+        NativeRequestMessageContext(
+            NativeHttpServer::ConnectionSPtr const & connection,
+            uint64 requestId,
+            std::string && method,
+            std::string && target,
+            HttpHeaderList && headers,
+            bool hasBody,
+            std::string const & listenPath,
+            ULONG maxEntityBodySize);
+
+        virtual ~NativeRequestMessageContext();
+
+        //
+        // IRequestMessageContext methods.
+        //
+
+        std::wstring const& GetVerb() const;
+
+        std::wstring GetUrl() const;
+
+        std::wstring GetSuffix() const;
+
+        std::wstring GetClientRequestId() const;
+
+        Common::ErrorCode GetRequestHeader(__in std::wstring const &headerName, __out std::wstring &headerValue) const;
+
+        Common::ErrorCode GetClientToken(__out HANDLE &hToken) const;
+
+        Common::AsyncOperationSPtr BeginGetClientCertificate(
+            __in Common::AsyncCallback const& callback,
+            __in Common::AsyncOperationSPtr const& parent) const;
+
+        Common::ErrorCode EndGetClientCertificate(
+            __in Common::AsyncOperationSPtr const& operation,
+            __out SSL** sslContext) const;
+
+        Common::ErrorCode GetRemoteAddress(__out std::wstring &remoteAddress) const;
+
+        Common::AsyncOperationSPtr BeginGetMessageBody(
+            __in Common::AsyncCallback const& callback,
+            __in Common::AsyncOperationSPtr const& parent) const;
+
+        Common::ErrorCode EndGetMessageBody(
+            __in Common::AsyncOperationSPtr const& operation,
+            __out Common::ByteBufferUPtr &body) const;
+
+        Common::AsyncOperationSPtr BeginGetFileFromUpload(
+            __in ULONG fileSize,
+            __in ULONG maxEntityBodyForUploadChunkSize,
+            __in ULONG defaultEntityBodyForUploadChunkSize,
+            __in Common::AsyncCallback const& callback,
+            __in Common::AsyncOperationSPtr const& parent) const;
+
+        Common::ErrorCode EndGetFileFromUpload(
+            __in Common::AsyncOperationSPtr const& operation,
+            __out std::wstring & uniqueFileName) const;
+
+        Common::ErrorCode SetResponseHeader(__in std::wstring const& headerName, __in std::wstring const& headerValue);
+
+        Common::AsyncOperationSPtr BeginSendResponse(
+            __in Common::ErrorCode operationStatus,
+            __in Common::ByteBufferUPtr buffer,
+            __in Common::AsyncCallback const& callback,
+            __in Common::AsyncOperationSPtr const& parent);
+
+        Common::AsyncOperationSPtr BeginSendResponse(
+            __in USHORT statusCode,
+            __in std::wstring description,
+            __in Common::ByteBufferUPtr buffer,
+            __in Common::AsyncCallback const& callback,
+            __in Common::AsyncOperationSPtr const& parent);
+
+        Common::AsyncOperationSPtr BeginSendResponseChunks(
+            __in USHORT statusCode,
+            __in std::wstring description,
+            __in Common::ByteBufferChunkList const& chunks,
+            __in Common::AsyncCallback const& callback,
+            __in Common::AsyncOperationSPtr const& parent);
+
+        Common::AsyncOperationSPtr BeginSendResponseFile(
+            __in USHORT statusCode,
+            __in std::wstring description,
+            __in std::wstring const& filePath,
+            __in Common::AsyncCallback const& callback,
+            __in Common::AsyncOperationSPtr const& parent);
+
+        Common::ErrorCode EndSendResponse(
+            __in Common::AsyncOperationSPtr const& operation);
+
+    private:
+        class ReadBodyAsyncOperation;
+        class GetMessageBodyAsyncOperation;
+        class GetFileFromUploadAsyncOperation;
+        class SendResponseAsyncOperation;
+
+        Common::AsyncOperationSPtr BeginSendResponse(
+            USHORT statusCode,
+            std::wstring const & description,
+            NativeHttpServer::Connection::Response && response,
+            Common::AsyncCallback const& callback,
+            Common::AsyncOperationSPtr const& parent);
+
+        NativeHttpServer::ConnectionSPtr const connection_;
+        uint64 const requestId_;
+        HttpHeaderList const headers_;
+        bool const hasBody_;
+        ULONG const maxEntityBodySize_;
+
+        std::wstring verb_;
+        std::wstring url_;
+        std::wstring suffix_;
+        std::wstring clientRequestId_;
+
+        HttpHeaderList responseHeaders_;
+        bool responded_;
+    };
+}
@@ -62,8 +62,25 @@ RequestMessageContext::SendResponseAsyncOperation::SendResponseAsyncOperation(
     messageContext_.responseUPtr_->set_reason_phrase(reasonPhrase);
 }
 
+RequestMessageContext::SendResponseAsyncOperation::SendResponseAsyncOperation(
+    Common::ErrorCode const& startError,
+    RequestMessageContext & messageContext,
+    Common::AsyncCallback const & callback,
+    Common::AsyncOperationSPtr const & parent)
+    : Common::AsyncOperation(callback, parent)
+    , messageContext_(messageContext)
+    , startError_(startError)
+{
+}
+
 void RequestMessageContext::SendResponseAsyncOperation::OnStart(AsyncOperationSPtr const& thisSPtr)
 {
+    if (!startError_.IsSuccess())
+    {
+        TryComplete(thisSPtr, startError_);
+        return;
+    }
+
     messageContext_.requestUPtr_->reply(*messageContext_.responseUPtr_).then([this, thisSPtr](pplx::task<void> t)
     {
         try
@@ -30,6 +30,13 @@ namespace HttpServer
             Common::AsyncCallback const & callback,
             Common::AsyncOperationSPtr const & parent);
 
+        // Completes with the error without sending a response
+        SendResponseAsyncOperation(
+            Common::ErrorCode const& startError,
+            RequestMessageContext & messageContext,
+            Common::AsyncCallback const & callback,
+            Common::AsyncOperationSPtr const & parent);
+
         static Common::ErrorCode End(__in Common::AsyncOperationSPtr const & asyncOperation);
 
     protected:
@@ -45,5 +52,6 @@ namespace HttpServer
         Common::ErrorCode operationStatus_;
         USHORT statusCode_;
         std::wstring statusDescription_;
+        Common::ErrorCode startError_;
     };
 }
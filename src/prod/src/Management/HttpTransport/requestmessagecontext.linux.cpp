@@ -165,6 +165,49 @@ AsyncOperationSPtr RequestMessageContext::BeginSendResponse(
     return AsyncOperation::CreateAndStart<SendResponseAsyncOperation>(statusCode, description, move(bodyUPtr), *this, callback, parent);
 }
 
+AsyncOperationSPtr RequestMessageContext::BeginSendResponseChunks(
+    __in USHORT statusCode,
+    __in std::wstring description,
+    __in Common::ByteBufferChunkList const& chunks,
+    __in Common::AsyncCallback const& callback,
+    __in Common::AsyncOperationSPtr const& parent)
+{
+    // http_response takes the body as a single buffer
+    size_t bodySize = 0;
+    for (auto const & chunk : chunks)
+    {
+        bodySize += chunk->size();
+    }
+
+    auto bodyUPtr = make_unique<ByteBuffer>();
+    bodyUPtr->reserve(bodySize);
+    for (auto const & chunk : chunks)
+    {
+        bodyUPtr->insert(bodyUPtr->end(), chunk->begin(), chunk->end());
+    }
+
+    return AsyncOperation::CreateAndStart<SendResponseAsyncOperation>(statusCode, description, move(bodyUPtr), *this, callback, parent);
+}
+
+AsyncOperationSPtr RequestMessageContext::BeginSendResponseFile(
+    __in USHORT statusCode,
+    __in std::wstring description,
+    __in std::wstring const& filePath,
+    __in Common::AsyncCallback const& callback,
+    __in Common::AsyncOperationSPtr const& parent)
+{
+    ifstream file(StringUtility::Utf16ToUtf8(filePath), ios::in | ios::binary);
+    if (!file)
+    {
+        Trace.WriteInfo(TraceType, "Opening response file {0} failed", filePath);
+        return AsyncOperation::CreateAndStart<SendResponseAsyncOperation>(ErrorCode(ErrorCodeValue::FileNotFound), *this, callback, parent);
+    }
+
+    auto bodyUPtr = make_unique<ByteBuffer>(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+
+    return AsyncOperation::CreateAndStart<SendResponseAsyncOperation>(statusCode, description, move(bodyUPtr), *this, callback, parent);
+}
+
 ErrorCode RequestMessageContext::EndSendResponse(
     __in AsyncOperationSPtr const& operation)
 {
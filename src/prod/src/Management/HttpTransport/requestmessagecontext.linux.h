@@ -91,6 +91,20 @@ namespace HttpServer
             __in Common::AsyncCallback const& callback,
             __in Common::AsyncOperationSPtr const& parent);
 
+        Common::AsyncOperationSPtr BeginSendResponseChunks(
+            __in USHORT statusCode,
+            __in std::wstring description,
+            __in Common::ByteBufferChunkList const& chunks,
+            __in Common::AsyncCallback const& callback,
+            __in Common::AsyncOperationSPtr const& parent);
+
+        Common::AsyncOperationSPtr BeginSendResponseFile(
+            __in USHORT statusCode,
+            __in std::wstring description,
+            __in std::wstring const& filePath,
+            __in Common::AsyncCallback const& callback,
+            __in Common::AsyncOperationSPtr const& parent);
+
         Common::ErrorCode EndSendResponse(
             __in Common::AsyncOperationSPtr const& operation);
 
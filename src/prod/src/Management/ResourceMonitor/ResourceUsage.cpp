@@ -29,6 +29,13 @@ bool ResourceUsage::ShouldCheckUsage(DateTime now)
 
 void ResourceUsage::Update(Management::ResourceMonitor::ResourceMeasurement const & measurement)
 {
+    //measurements sampled in the background (e.g. from cgroups) can be handed out again before a new sample is taken
+    //they carry nothing new and would make the cpu rate time span zero, so skip them
+    if (timeMeasured_ > 0 && measurement.TimeRead <= lastRead_)
+    {
+        return;
+    }
+
     //we are interested in MB - we get the memory in bytes
     uint64 memoryUsageInMB = measurement.MemoryUsage / (1024 * 1024);
     //if this is not our first measure we can calculate the cpu rate
@@ -0,0 +1,65 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+namespace HealthManagerUnitTest
+{
+    using namespace Common;
+    using namespace Management::HealthManager;
+    using namespace std;
+
+    class HealthEventStoreDataTest
+    {
+    protected:
+        static bool CanRefresh(TimeSpan timeToLive, TimeSpan sincePersisted, double refreshRatio)
+        {
+            DateTime lastPersistedUtc = DateTime::Now();
+            return HealthEventStoreData::CanRefreshTransientEventInMemory(
+                timeToLive,
+                lastPersistedUtc,
+                lastPersistedUtc + sincePersisted,
+                refreshRatio);
+        }
+    };
+
+    BOOST_FIXTURE_TEST_SUITE(HealthEventStoreDataTestSuite, HealthEventStoreDataTest)
+
+    BOOST_AUTO_TEST_CASE(TransientRefreshPersistLag)
+    {
+        TimeSpan ttl = TimeSpan::FromSeconds(60);
+
+        // Refreshes before ratio * TTL stay in memory
+        VERIFY_IS_TRUE(CanRefresh(ttl, TimeSpan::Zero, 0.5));
+        VERIFY_IS_TRUE(CanRefresh(ttl, TimeSpan::FromSeconds(29), 0.5));
+        VERIFY_IS_TRUE(CanRefresh(ttl, TimeSpan::FromSeconds(50), 0.9));
+
+        // The first refresh after ratio * TTL is persisted
+        VERIFY_IS_FALSE(CanRefresh(ttl, TimeSpan::FromSeconds(30), 0.5));
+        VERIFY_IS_FALSE(CanRefresh(ttl, TimeSpan::FromSeconds(31), 0.5));
+        VERIFY_IS_FALSE(CanRefresh(ttl, TimeSpan::FromSeconds(55), 0.9));
+        VERIFY_IS_FALSE(CanRefresh(ttl, TimeSpan::FromSeconds(61), 1.0));
+    }
+
+    BOOST_AUTO_TEST_CASE(TransientRefreshDisabled)
+    {
+        // The default ratio persists every refresh
+        VERIFY_ARE_EQUAL(0.0, Management::ManagementConfig::GetConfig().TransientHealthEventInMemoryRefreshRatio);
+
+        VERIFY_IS_FALSE(CanRefresh(TimeSpan::FromSeconds(60), TimeSpan::Zero, 0.0));
+        VERIFY_IS_FALSE(CanRefresh(TimeSpan::MaxValue, TimeSpan::Zero, 0.0));
+    }
+
+    BOOST_AUTO_TEST_CASE(TransientRefreshInfiniteTimeToLive)
+    {
+        // The persisted event never expires, so it never needs to be refreshed in the store
+        VERIFY_IS_TRUE(CanRefresh(TimeSpan::MaxValue, TimeSpan::FromDays(30), 0.5));
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+}
@@ -421,9 +421,9 @@ bool HealthEventStoreData::TryUpdateDiff(ServiceModel::HealthReport const & repo
         return false;
     }
     
-    if (removeWhenExpired_)
+    if (removeWhenExpired_ && !CanRefreshTransientEventInMemory())
     {
-        // Always persist transient events
+        // Persist the refresh so the transient event doesn't expire early after failover
         return false;
     }
 
@@ -440,6 +440,39 @@ bool HealthEventStoreData::TryUpdateDiff(ServiceModel::HealthReport const & repo
     return true;
 }
 
+// Transient events are not renewed on load from store: after failover, they expire based on the persisted
+// last modified time. Keep refreshes in memory only until the configured fraction of the time to live has elapsed
+// since the event was persisted.
+bool HealthEventStoreData::CanRefreshTransientEventInMemory() const
+{
+    return CanRefreshTransientEventInMemory(
+        timeToLive_,
+        lastModifiedUtc_,
+        DateTime::Now(),
+        ManagementConfig::GetConfig().TransientHealthEventInMemoryRefreshRatio);
+}
+
+bool HealthEventStoreData::CanRefreshTransientEventInMemory(
+    TimeSpan timeToLive,
+    DateTime lastPersistedUtc,
+    DateTime now,
+    double refreshRatio)
+{
+    if (refreshRatio <= 0.0)
+    {
+        return false;
+    }
+
+    if (timeToLive == TimeSpan::MaxValue)
+    {
+        // The persisted event never expires
+        return true;
+    }
+
+    auto maxInMemoryDuration = TimeSpan::FromTicks(static_cast<int64>(timeToLive.Ticks * refreshRatio));
+    return now - lastPersistedUtc < maxInMemoryDuration;
+}
+
 HealthEvent HealthEventStoreData::GenerateEvent() const
 {
     return HealthEvent(
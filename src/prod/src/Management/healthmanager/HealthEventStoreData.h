@@ -110,6 +110,14 @@ namespace Management
 
             bool TryUpdateDiff(ServiceModel::HealthReport const & report);
 
+            // Checks whether a refresh of an unchanged transient event can stay in memory, given the time
+            // the event was last persisted and the configured TransientHealthEventInMemoryRefreshRatio.
+            static bool CanRefreshTransientEventInMemory(
+                Common::TimeSpan timeToLive,
+                Common::DateTime lastPersistedUtc,
+                Common::DateTime now,
+                double refreshRatio);
+
             ServiceModel::HealthEvent GenerateEvent() const;
                         
             static std::wstring GeneratePrefix(std::wstring const & entityId);
@@ -128,6 +136,8 @@ namespace Management
         private:
             std::wstring GetTransitionHistory() const;
 
+            bool CanRefreshTransientEventInMemory() const;
+
         protected:
             // Maintains a diff from a base health event.
             class HealthEventDiff
@@ -746,7 +746,9 @@ bool FileTransferGateway::AccessCheck(Message & message)
     {
         success = message.IsInRole(ClientAccessConfig::GetConfig().FileDownloadRoles);
     }
-    else if (message.Action == FileTransferTcpMessage::FileContentAction)
+    else if (message.Action == FileTransferTcpMessage::FileContentAction ||
+        message.Action == FileTransferTcpMessage::FileContentAckAction ||
+        message.Action == FileTransferTcpMessage::FileContentResumeAction)
     {
         success = message.IsInRole(ClientAccessConfig::GetConfig().FileContentRoles);
     }
@@ -0,0 +1,208 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Naming
+{
+    //
+    // Maps names to values with one level per name segment. Looking up all the values registered
+    // on a name and on its parent names walks the segments of the name once, instead of
+    // building, hashing and comparing a NamingUri for every parent.
+    //
+    // The segments follow NamingUri::GetParentName(), which strips the path from its last '/',
+    // so the root name is the root of the trie and query/fragment are not part of the key.
+    //
+    template <class TValue>
+    class NameSegmentTrie
+    {
+        DENY_COPY(NameSegmentTrie)
+
+    public:
+        NameSegmentTrie() : root_(std::make_unique<Node>()), count_(0) { }
+
+        __declspec(property(get=get_Count)) size_t Count;
+        size_t get_Count() const { return count_; }
+
+        bool IsEmpty() const { return count_ == 0; }
+
+        void Clear()
+        {
+            root_ = std::make_unique<Node>();
+            count_ = 0;
+        }
+
+        // Returns false if a value already exists for the name
+        bool TryAdd(Common::NamingUri const & name, TValue const & value)
+        {
+            auto const & path = name.Path;
+            Node * node = root_.get();
+
+            std::wstring segment;
+            size_t position = 0;
+            while (TryGetNextSegment(path, position, segment))
+            {
+                auto & child = node->Children[segment];
+                if (!child)
+                {
+                    child = std::make_unique<Node>();
+                }
+
+                node = child.get();
+            }
+
+            if (node->HasValue)
+            {
+                return false;
+            }
+
+            node->Value = value;
+            node->HasValue = true;
+            ++count_;
+
+            return true;
+        }
+
+        bool TryRemove(Common::NamingUri const & name)
+        {
+            bool removed = TryRemove(*root_, name.Path, 0);
+            if (removed)
+            {
+                --count_;
+            }
+
+            return removed;
+        }
+
+        bool TryGet(Common::NamingUri const & name, __out TValue & value) const
+        {
+            auto const & path = name.Path;
+            Node const * node = root_.get();
+
+            std::wstring segment;
+            size_t position = 0;
+            while (TryGetNextSegment(path, position, segment))
+            {
+                auto it = node->Children.find(segment);
+                if (it == node->Children.end())
+                {
+                    return false;
+                }
+
+                node = it->second.get();
+            }
+
+            if (!node->HasValue)
+            {
+                return false;
+            }
+
+            value = node->Value;
+
+            return true;
+        }
+
+        // Appends the values registered on the name and on all its parents, deepest name first
+        void GetPrefixMatches(Common::NamingUri const & name, __inout std::vector<TValue const *> & matches) const
+        {
+            auto const & path = name.Path;
+            Node const * node = root_.get();
+
+            size_t first = matches.size();
+
+            std::wstring segment;
+            size_t position = 0;
+            while (true)
+            {
+                if (node->HasValue)
+                {
+                    matches.push_back(&node->Value);
+                }
+
+                if (!TryGetNextSegment(path, position, segment))
+                {
+                    break;
+                }
+
+                auto it = node->Children.find(segment);
+                if (it == node->Children.end())
+                {
+                    break;
+                }
+
+                node = it->second.get();
+            }
+
+            std::reverse(matches.begin() + first, matches.end());
+        }
+
+    private:
+        struct Node
+        {
+            Node() : Children(), Value(), HasValue(false) { }
+
+            std::unordered_map<std::wstring, std::unique_ptr<Node>> Children;
+            TValue Value;
+            bool HasValue;
+        };
+
+        // Every '/' in the path starts a segment. The segment buffer is reused across calls.
+        static bool TryGetNextSegment(std::wstring const & path, __inout size_t & position, __out std::wstring & segment)
+        {
+            if (position >= path.size())
+            {
+                return false;
+            }
+
+            size_t start = (path[position] == L'/') ? position + 1 : position;
+            size_t end = path.find(L'/', start);
+            if (end == std::wstring::npos)
+            {
+                end = path.size();
+            }
+
+            segment.assign(path, start, end - start);
+            position = end;
+
+            return true;
+        }
+
+        static bool TryRemove(Node & node, std::wstring const & path, size_t position)
+        {
+            std::wstring segment;
+            if (!TryGetNextSegment(path, position, segment))
+            {
+                if (!node.HasValue)
+                {
+                    return false;
+                }
+
+                node.Value = TValue();
+                node.HasValue = false;
+
+                return true;
+            }
+
+            auto it = node.Children.find(segment);
+            if (it == node.Children.end())
+            {
+                return false;
+            }
+
+            bool removed = TryRemove(*(it->second), path, position);
+
+            // Prune the branches that no longer lead to a value
+            if (removed && !it->second->HasValue && it->second->Children.empty())
+            {
+                node.Children.erase(it);
+            }
+
+            return removed;
+        }
+
+        std::unique_ptr<Node> root_;
+        size_t count_;
+    };
+}
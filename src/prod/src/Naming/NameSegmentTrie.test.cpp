@@ -0,0 +1,220 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+namespace Naming
+{
+    using namespace std;
+    using namespace Common;
+
+    StringLiteral const NameSegmentTrieTestSource("NameSegmentTrieTest");
+
+    class NameSegmentTrieTest
+    {
+    protected:
+        static NamingUri CreateName(wstring const & name)
+        {
+            NamingUri uri;
+            VERIFY_IS_TRUE(NamingUri::TryParse(name, uri));
+            return uri;
+        }
+
+        // Matches the way prefix filters were looked up before the trie: one hash lookup per parent name
+        static void GetPrefixMatchesByParentName(
+            unordered_map<NamingUri, int, NamingUri::Hasher> const & values,
+            NamingUri const & name,
+            __out vector<int> & matches)
+        {
+            auto prefixUri = name;
+            auto parentUri = name.GetParentName();
+            bool done = false;
+
+            while (!done)
+            {
+                auto it = values.find(prefixUri);
+                if (it != values.end())
+                {
+                    matches.push_back(it->second);
+                }
+
+                if (prefixUri == parentUri)
+                {
+                    done = true;
+                }
+                else
+                {
+                    prefixUri = parentUri;
+                    parentUri = prefixUri.GetParentName();
+                }
+            }
+        }
+
+        static vector<int> GetPrefixMatches(NameSegmentTrie<int> const & trie, NamingUri const & name)
+        {
+            vector<int const *> matches;
+            trie.GetPrefixMatches(name, matches);
+
+            vector<int> result;
+            for (auto const & match : matches)
+            {
+                result.push_back(*match);
+            }
+
+            return result;
+        }
+    };
+
+    BOOST_FIXTURE_TEST_SUITE(NameSegmentTrieTestSuite, NameSegmentTrieTest)
+
+    BOOST_AUTO_TEST_CASE(BasicTest)
+    {
+        NameSegmentTrie<int> trie;
+
+        VERIFY_IS_TRUE(trie.IsEmpty());
+
+        VERIFY_IS_TRUE(trie.TryAdd(NamingUri(L""), 0));
+        VERIFY_IS_TRUE(trie.TryAdd(CreateName(L"fabric:/app"), 1));
+        VERIFY_IS_TRUE(trie.TryAdd(CreateName(L"fabric:/app/svc"), 2));
+        VERIFY_IS_TRUE(trie.TryAdd(CreateName(L"fabric:/app/svc/child"), 3));
+        VERIFY_IS_TRUE(trie.TryAdd(CreateName(L"fabric:/other/svc"), 4));
+        VERIFY_IS_FALSE(trie.TryAdd(CreateName(L"fabric:/app"), 5));
+        VERIFY_ARE_EQUAL(static_cast<size_t>(5), trie.Count);
+
+        int value = -1;
+        VERIFY_IS_TRUE(trie.TryGet(CreateName(L"fabric:/app/svc"), value));
+        VERIFY_ARE_EQUAL(2, value);
+        VERIFY_IS_FALSE(trie.TryGet(CreateName(L"fabric:/other"), value));
+        VERIFY_IS_FALSE(trie.TryGet(CreateName(L"fabric:/App"), value));
+
+        auto matches = GetPrefixMatches(trie, CreateName(L"fabric:/app/svc/child/grandchild"));
+        VERIFY_ARE_EQUAL(static_cast<size_t>(4), matches.size());
+        VERIFY_ARE_EQUAL(3, matches[0]);
+        VERIFY_ARE_EQUAL(2, matches[1]);
+        VERIFY_ARE_EQUAL(1, matches[2]);
+        VERIFY_ARE_EQUAL(0, matches[3]);
+
+        // Segments must match completely
+        matches = GetPrefixMatches(trie, CreateName(L"fabric:/app/svc2"));
+        VERIFY_ARE_EQUAL(static_cast<size_t>(2), matches.size());
+        VERIFY_ARE_EQUAL(1, matches[0]);
+
+        matches = GetPrefixMatches(trie, CreateName(L"fabric:/other"));
+        VERIFY_ARE_EQUAL(static_cast<size_t>(1), matches.size());
+        VERIFY_ARE_EQUAL(0, matches[0]);
+
+        VERIFY_IS_TRUE(trie.TryRemove(CreateName(L"fabric:/app/svc")));
+        VERIFY_IS_FALSE(trie.TryRemove(CreateName(L"fabric:/app/svc")));
+        VERIFY_IS_FALSE(trie.TryRemove(CreateName(L"fabric:/other")));
+        VERIFY_ARE_EQUAL(static_cast<size_t>(4), trie.Count);
+
+        matches = GetPrefixMatches(trie, CreateName(L"fabric:/app/svc/child"));
+        VERIFY_ARE_EQUAL(static_cast<size_t>(3), matches.size());
+        VERIFY_ARE_EQUAL(3, matches[0]);
+        VERIFY_ARE_EQUAL(1, matches[1]);
+
+        VERIFY_IS_TRUE(trie.TryRemove(CreateName(L"fabric:/app/svc/child")));
+        matches = GetPrefixMatches(trie, CreateName(L"fabric:/app/svc/child"));
+        VERIFY_ARE_EQUAL(static_cast<size_t>(2), matches.size());
+
+        trie.Clear();
+        VERIFY_IS_TRUE(trie.IsEmpty());
+        VERIFY_ARE_EQUAL(static_cast<size_t>(0), GetPrefixMatches(trie, CreateName(L"fabric:/app")).size());
+    }
+
+    //
+    // Gateway with 100k registered filters, one per client (application and service prefixes plus exact
+    // names) matching service table updates. Verifies the trie returns the same matches as the parent
+    // name walk and reports the cost of both.
+    //
+    BOOST_AUTO_TEST_CASE(PrefixMatchPerf100K)
+    {
+        int const filterCount = 100000;
+        int const appCount = 1000;
+        int const updateCount = 20000;
+
+        NameSegmentTrie<int> trie;
+        unordered_map<NamingUri, int, NamingUri::Hasher> values;
+
+        vector<NamingUri> updates;
+        for (int i = 0; i < filterCount; ++i)
+        {
+            wstring name;
+            switch (i % 3)
+            {
+            case 0:
+                name = wformatString("fabric:/App{0}", i % appCount);
+                break;
+            case 1:
+                name = wformatString("fabric:/App{0}/Service{1}", i % appCount, i);
+                break;
+            default:
+                name = wformatString("fabric:/App{0}/Service{1}/Partition{2}", i % appCount, i - 1, i);
+                break;
+            }
+
+            auto uri = CreateName(name);
+            if (values.insert(make_pair(uri, i)).second)
+            {
+                VERIFY_IS_TRUE(trie.TryAdd(uri, i));
+            }
+        }
+
+        VERIFY_ARE_EQUAL(values.size(), trie.Count);
+
+        Random random(0);
+        for (int i = 0; i < updateCount; ++i)
+        {
+            int service = random.Next(filterCount);
+            updates.push_back(CreateName(wformatString("fabric:/App{0}/Service{1}/Partition{2}", service % appCount, service, i)));
+        }
+
+        size_t parentWalkMatches = 0;
+        Stopwatch parentWalkStopwatch;
+        parentWalkStopwatch.Start();
+        for (auto const & update : updates)
+        {
+            vector<int> matches;
+            GetPrefixMatchesByParentName(values, update, matches);
+            parentWalkMatches += matches.size();
+        }
+        parentWalkStopwatch.Stop();
+
+        size_t trieMatches = 0;
+        Stopwatch trieStopwatch;
+        trieStopwatch.Start();
+        for (auto const & update : updates)
+        {
+            vector<int const *> matches;
+            trie.GetPrefixMatches(update, matches);
+            trieMatches += matches.size();
+        }
+        trieStopwatch.Stop();
+
+        Trace.WriteInfo(
+            NameSegmentTrieTestSource,
+            "{0} updates against {1} filters: parent name walk={2}ms ({3} matches) trie={4}ms ({5} matches)",
+            updateCount,
+            trie.Count,
+            parentWalkStopwatch.ElapsedMilliseconds,
+            parentWalkMatches,
+            trieStopwatch.ElapsedMilliseconds,
+            trieMatches);
+
+        VERIFY_ARE_EQUAL(parentWalkMatches, trieMatches);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            vector<int> expected;
+            GetPrefixMatchesByParentName(values, updates[i], expected);
+            VERIFY_IS_TRUE(expected == GetPrefixMatches(trie, updates[i]));
+        }
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+}
@@ -261,11 +261,26 @@ private:
 
 public:
 
-    NameFilterIndex() : filtersByName_() { }
+    // Prefix filters are also indexed by name segment so that matching a name
+    // visits each of its parents once without building the parent names.
+    //
+    explicit NameFilterIndex(bool isPrefixIndex) 
+        : filtersByName_()
+        , filtersByPrefix_(isPrefixIndex ? make_unique<NameSegmentTrie<NameFilterIndexEntrySPtr>>() : nullptr)
+    { 
+    }
 
     bool IsEmpty() { return filtersByName_.empty(); }
 
-    void Clear() { filtersByName_.clear(); }
+    void Clear() 
+    { 
+        filtersByName_.clear(); 
+
+        if (filtersByPrefix_)
+        {
+            filtersByPrefix_->Clear();
+        }
+    }
 
     ErrorCode TryAddFilter(ClientRegistrationSPtr const & registration, ServiceNotificationFilterSPtr const & filter)
     {
@@ -274,6 +289,11 @@ public:
         if (it == filtersByName_.end())
         {
             it = filtersByName_.insert(FilterPair(filter->Name, make_shared<NameFilterIndexEntry>())).first;
+
+            if (filtersByPrefix_)
+            {
+                filtersByPrefix_->TryAdd(filter->Name, it->second);
+            }
         }
 
         auto indexEntry = it->second;
@@ -296,6 +316,11 @@ public:
         if (removed && indexEntry->IsEmpty())
         {
             filtersByName_.erase(it);
+
+            if (filtersByPrefix_)
+            {
+                filtersByPrefix_->TryRemove(filter->Name);
+            }
         }
 
         return removed;
@@ -315,9 +340,19 @@ public:
         return false;
     }
 
+    // Filters registered on the name and on all its parent names, deepest name first
+    //
+    void GetPrefixFilters(NamingUri const & name, __out vector<NameFilterIndexEntrySPtr const *> & result)
+    {
+        ASSERT_IF(!filtersByPrefix_, "GetPrefixFilters called on exact filter index");
+
+        filtersByPrefix_->GetPrefixMatches(name, result);
+    }
+
 private:
 
     FiltersHash filtersByName_;
+    unique_ptr<NameSegmentTrie<NameFilterIndexEntrySPtr>> filtersByPrefix_;
 };
 
 //
@@ -338,8 +373,8 @@ ServiceNotificationManager::ServiceNotificationManager(
     , trace_(trace)
     , transport_()
     , clientTable_(make_unique<ClientRegistrationTable>())
-    , exactFilterIndex_(make_unique<NameFilterIndex>())
-    , prefixFilterIndex_(make_unique<NameFilterIndex>())
+    , exactFilterIndex_(make_unique<NameFilterIndex>(false))
+    , prefixFilterIndex_(make_unique<NameFilterIndex>(true))
     , registrationsLock_()
 {
 }
@@ -1096,29 +1131,20 @@ ServiceNotificationManager::MatchResultList ServiceNotificationManager::GetPrefi
     CachedServiceTableEntrySPtr const & cachePartition)
 {
     MatchResultList results;
-    auto prefixUri = uri;
-    auto parentUri = uri.GetParentName();
-    bool done = false;
 
-    while (!done)
+    if (prefixFilterIndex_->IsEmpty())
     {
-        NameFilterIndexEntrySPtr indexEntry;
-        if (!prefixFilterIndex_->IsEmpty() && prefixFilterIndex_->TryGetFilters(prefixUri, indexEntry))
-        {
-            for (auto const & it : indexEntry->FiltersByRegistrationId)
-            {
-                results.push_back(make_pair(it.first, MatchedServiceTableEntry::CreateOnUpdateMatch(cachePartition, it.second->IsPrimaryOnly)));
-            }
-        }
+        return move(results);
+    }
 
-        if (prefixUri == parentUri)
-        {
-            done = true;
-        }
-        else
+    vector<NameFilterIndexEntrySPtr const *> indexEntries;
+    prefixFilterIndex_->GetPrefixFilters(uri, indexEntries);
+
+    for (auto const & indexEntry : indexEntries)
+    {
+        for (auto const & it : (*indexEntry)->FiltersByRegistrationId)
         {
-            prefixUri = parentUri;
-            parentUri = prefixUri.GetParentName();
+            results.push_back(make_pair(it.first, MatchedServiceTableEntry::CreateOnUpdateMatch(cachePartition, it.second->IsPrimaryOnly)));
         }
     }
 
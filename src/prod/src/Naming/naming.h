@@ -55,6 +55,7 @@
 #include "Naming/ClientIdentityHeader.h"
 #include "Naming/ServiceNotificationSender.h"
 #include "Naming/ClientRegistrationTable.h"
+#include "Naming/NameSegmentTrie.h"
 #include "Naming/ServiceNotificationManager.h"
 #include "Naming/FabricGatewayManager.h"
 #include "Naming/FabricApplicationGatewayManager.h"
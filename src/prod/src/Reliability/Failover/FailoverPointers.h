@@ -306,6 +306,9 @@ namespace Reliability
         namespace Communication
         {
             class FMTransport;
+
+            class LoadReportBatcher;
+            typedef std::unique_ptr<LoadReportBatcher> LoadReportBatcherUPtr;
         }
 
         namespace Storage
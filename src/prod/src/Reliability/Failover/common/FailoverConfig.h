@@ -73,6 +73,11 @@ namespace Reliability
         // The PeriodicStateScanInterval determines how often the FM background thread activates to scan for changes and kick off actions
         INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"FailoverManager", PeriodicStateScanInterval, Common::TimeSpan::FromSeconds(5.0), Common::ConfigEntryUpgradePolicy::Dynamic);
 
+        // Between full scans, the FM background thread only processes the FailoverUnits that changed or still have pending work.
+        // All FailoverUnits are scanned at this interval, and whenever a node, service or upgrade needs them. A value that is
+        // not larger than PeriodicStateScanInterval scans all FailoverUnits on every pass.
+        INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"FailoverManager", PeriodicFullStateScanInterval, Common::TimeSpan::FromSeconds(60.0), Common::ConfigEntryUpgradePolicy::Dynamic);
+
         // When the FM sends a particular action for a specific replica, it starts this timer.  Before it expires, the FM will not send additional
         // actions to the replica
         INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"FailoverManager", MinActionRetryIntervalPerReplica, Common::TimeSpan::FromSeconds(10.0), Common::ConfigEntryUpgradePolicy::Dynamic);
@@ -451,6 +456,22 @@ namespace Reliability
         // MaxNumberOfLoadReportsPerMessage defines the batch size for ReportLoad messages from RAP to RA
         INTERNAL_CONFIG_ENTRY(int, L"ReconfigurationAgent", MaxNumberOfLoadReportsPerMessage,  500, Common::ConfigEntryUpgradePolicy::Dynamic);
 
+        // LoadReportDeltaThresholdPercent defines how much (in percent of the last reported value) a load metric has to change before RAP reports it again.
+        // Zero reports every change but drops repeated values. Negative value (the default) disables the filtering. Filtering is never done when PLB decays the reported loads.
+        INTERNAL_CONFIG_ENTRY(int, L"ReconfigurationAgent", LoadReportDeltaThresholdPercent, -1, Common::ConfigEntryUpgradePolicy::Dynamic);
+
+        // LoadReportRefreshInterval defines the interval after which RAP reports the load metrics of a partition even if they did not change
+        // Load reports are not acknowledged so this bounds how long FM can keep a stale load after a lost report or an FM failover
+        INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"ReconfigurationAgent", LoadReportRefreshInterval, Common::TimeSpan::FromSeconds(300), Common::ConfigEntryUpgradePolicy::Dynamic);
+
+        // NodeLoadReportBatchInterval defines the interval for which RA accumulates load reports from all the hosts on the node before sending them to FM in one message.
+        // Zero sends every load report to FM as soon as it is received.
+        INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"ReconfigurationAgent", NodeLoadReportBatchInterval, Common::TimeSpan::Zero, Common::ConfigEntryUpgradePolicy::Dynamic);
+
+        // EnableCompactLoadReports makes RA send load reports to FM with metric names, service names and node ids encoded in a dictionary.
+        // Must only be enabled once all the nodes in the cluster run a version that understands the compact form.
+        INTERNAL_CONFIG_ENTRY(bool, L"ReconfigurationAgent", EnableCompactLoadReports, false, Common::ConfigEntryUpgradePolicy::Dynamic);
+
          // ProxyOutgoingMessageRetryTimerInterval defines the timer interval for outgoing messages, like ReportFault, in RAP
         INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"ReconfigurationAgent", ProxyOutgoingMessageRetryTimerInterval, Common::TimeSpan::FromSeconds(30.0), Common::ConfigEntryUpgradePolicy::Dynamic);
 
@@ -493,6 +514,15 @@ namespace Reliability
         // The maximum time to wait for async ESE transactions to commit
         INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"ReconfigurationAgent/Store", MaxEseCommitWaitDuration, Common::TimeSpan::MaxValue, Common::ConfigEntryUpgradePolicy::Dynamic);
 
+        // Batch concurrent RA store operations into a single local store transaction
+        INTERNAL_CONFIG_ENTRY(bool, L"ReconfigurationAgent/Store", EnableStoreGroupCommit, true, Common::ConfigEntryUpgradePolicy::Dynamic);
+
+        // The time to wait for more store operations before starting a group commit. Zero starts a group commit as soon as the previous one completes
+        INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"ReconfigurationAgent/Store", StoreGroupCommitWindow, Common::TimeSpan::Zero, Common::ConfigEntryUpgradePolicy::Dynamic);
+
+        // The maximum number of store operations that are committed in a single group commit
+        INTERNAL_CONFIG_ENTRY(int, L"ReconfigurationAgent/Store", MaxStoreGroupCommitBatchSize, 256, Common::ConfigEntryUpgradePolicy::Dynamic);
+
         // Specify timespan in seconds. The duration for which the system will wait before terminating service hosts that have replicas that are stuck in close during node deactivation.
         PUBLIC_CONFIG_ENTRY(Common::TimeSpan, L"ReconfigurationAgent", NodeDeactivationMaxReplicaCloseDuration, Common::TimeSpan::FromSeconds(900), Common::ConfigEntryUpgradePolicy::Dynamic);
 
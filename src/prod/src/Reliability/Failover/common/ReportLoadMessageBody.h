@@ -19,7 +19,8 @@ namespace Reliability
         ReportLoadMessageBody(ReportLoadMessageBody && other) :
             reportsNew_(std::move(other.reportsNew_)),
             senderTime_(other.senderTime_),
-            reports_(std::move(other.reports_))
+            reports_(std::move(other.reports_)),
+            compactReports_(std::move(other.compactReports_))
         {
         }
 
@@ -34,6 +35,7 @@ namespace Reliability
             {
                 reportsNew_ = std::move(other.reportsNew_);
                 senderTime_ = other.senderTime_;
+                compactReports_ = std::move(other.compactReports_);
             }
 
             return *this;
@@ -46,16 +48,39 @@ namespace Reliability
         __declspec (property(get=get_SenderTime)) Common::StopwatchTime SenderTime;
         Common::StopwatchTime get_SenderTime() const { return senderTime_; }
 
+        // Moves the reports into the dictionary encoded form before the message is sent.
+        // The receiver must call TryExpandCompactReports before accessing Reports.
+        // Only used when all the nodes understand the compact form (see EnableCompactLoadReports).
+        void CompactReports()
+        {
+            if (!reportsNew_.empty())
+            {
+                compactReports_ = LoadBalancingComponent::CompactLoadReport(std::move(reportsNew_));
+                reportsNew_.clear();
+            }
+        }
+
+        bool TryExpandCompactReports()
+        {
+            if (compactReports_.IsEmpty)
+            {
+                return true;
+            }
+
+            return compactReports_.TryExpand(reportsNew_);
+        }
+
         void WriteTo(Common::TextWriter& writer, Common::FormatOptions const&) const
         {
-            writer.Write("{0} {1}", reportsNew_, senderTime_);
+            writer.Write("{0} {1} {2}", reportsNew_, senderTime_, compactReports_);
         }
 
-        FABRIC_FIELDS_03(reports_, reportsNew_, senderTime_);
+        FABRIC_FIELDS_04(reports_, reportsNew_, senderTime_, compactReports_);
 
     private:
         std::vector<ReportLoadInfo> reports_;
         std::vector<LoadBalancingComponent::LoadOrMoveCostDescription> reportsNew_;
         Common::StopwatchTime senderTime_;
+        LoadBalancingComponent::CompactLoadReport compactReports_;
     };
 }
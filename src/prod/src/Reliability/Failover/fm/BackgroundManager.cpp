@@ -11,6 +11,11 @@ using namespace Reliability;
 using namespace Reliability::FailoverManagerComponent;
 using namespace ServiceModel;
 
+StringLiteral const TraceBackground("Background");
+
+// An incremental pass uses one thread per this many FailoverUnits, up to BackgroundThreadCount
+static const size_t IncrementalScanFailoverUnitsPerThread = 256;
+
 BackgroundManager::EnumerationContext::EnumerationContext()
     : count_(0), asyncCommitCount_(0)
 {
@@ -39,6 +44,9 @@ BackgroundManager::BackgroundManager(FailoverManager & fm, Common::ComponentRoot
     activeThreadCount_(0),
     enumerationAborted_(false),
     enumerationCompleted_(true),
+    isFullScan_(true),
+    isFullScanRequested_(true),
+    lastFullScanTime_(StopwatchTime::Zero),
     isThrottled_(false),
     actionCount_(0),
     asyncCommitCount_(0),
@@ -106,6 +114,8 @@ void BackgroundManager::ScheduleRun()
             return;
         }
 
+        isFullScanRequested_ = true;
+
         if (isRunning_)
         {
             isRescheduled_ = true;
@@ -165,8 +175,12 @@ void BackgroundManager::CreateThreadContexts()
     // Add ThreadContext for FailoverUnit health report.
     fm_.FailoverUnitCacheObj.AddThreadContexts();
 
+    // Thread contexts need to see every FailoverUnit. Without any, only the FailoverUnits that
+    // changed or still have pending work are visited between the periodic full scans.
+    isFullScan_ = !currentContexts_.empty() || IsFullScanNeeded();
+
     // Add ThreadContext for performance counters.
-    if (!(fm_.IsMaster))
+    if (isFullScan_ && !(fm_.IsMaster))
     {
         AddThreadContext(make_unique<FailoverUnitCountsContext>());
     }
@@ -270,7 +284,34 @@ void BackgroundManager::RunPeriodicTask()
         activeThreadCount_ = Environment::GetNumberOfProcessors();
     }
 
-    visitor_ = fm_.FailoverUnitCacheObj.CreateVisitor(true, TimeSpan::Zero, true);
+    FailoverUnitWorkQueue & workQueue = fm_.FailoverUnitCacheObj.WorkQueue;
+    vector<FailoverUnitId> failoverUnitIds;
+    workQueue.TakeDue(iterationStartTime_, failoverUnitIds);
+
+    if (isFullScan_)
+    {
+        // The FailoverUnits taken from the work queue are visited by the full scan
+        lastFullScanTime_ = iterationStartTime_;
+        visitor_ = fm_.FailoverUnitCacheObj.CreateVisitor(true, TimeSpan::Zero, true);
+    }
+    else
+    {
+        visitor_ = fm_.FailoverUnitCacheObj.CreateVisitor(move(failoverUnitIds), TimeSpan::Zero, true);
+
+        LONG threadCount = static_cast<LONG>(visitor_->Count / IncrementalScanFailoverUnitsPerThread) + 1;
+        if (activeThreadCount_ > threadCount)
+        {
+            activeThreadCount_ = threadCount;
+        }
+    }
+
+    fm_.WriteInfo(
+        TraceBackground,
+        "Starting {0} scan of {1} FailoverUnits on {2} threads, {3} FailoverUnits scheduled",
+        isFullScan_ ? "full" : "incremental",
+        visitor_->Count,
+        activeThreadCount_,
+        workQueue.Count);
 
     // This thread itself will be performing the task as well.
     int threadsToInvoke = activeThreadCount_ - 1;
@@ -289,6 +330,24 @@ void BackgroundManager::OnPeriodicTaskEnd()
     fm_.FailoverUnitCounters->NumberOfUnprocessedFailoverUnits.Value = static_cast<PerformanceCounterValue>(unprocessedFailoverUnits_.size());
     fm_.FailoverUnitCounters->NumberOfFailoverUnitActions.Value = static_cast<PerformanceCounterValue>(actionCount_);
 
+    // FailoverUnits that could not be locked, failed to commit or were not reached before the
+    // enumeration was aborted are processed by the next pass.
+    FailoverUnitWorkQueue & workQueue = fm_.FailoverUnitCacheObj.WorkQueue;
+    if (enumerationAborted_)
+    {
+        vector<FailoverUnitId> unvisitedFailoverUnits;
+        visitor_->GetUnvisitedFailoverUnits(unvisitedFailoverUnits);
+        for (FailoverUnitId const & failoverUnitId : unvisitedFailoverUnits)
+        {
+            workQueue.MarkDirty(failoverUnitId);
+        }
+    }
+
+    for (FailoverUnitId const & failoverUnitId : unprocessedFailoverUnits_)
+    {
+        workQueue.MarkDirty(failoverUnitId);
+    }
+
     visitor_ = nullptr;
 
     for (auto it = currentContexts_.begin(); it != currentContexts_.end(); ++it)
@@ -390,6 +449,21 @@ bool BackgroundManager::IsEnumerationCompleted()
     return enumerationCompleted_;
 }
 
+bool BackgroundManager::IsFullScanNeeded()
+{
+    TimeSpan fullScanInterval = FailoverConfig::GetConfig().PeriodicFullStateScanInterval;
+    bool isFullScanNeeded =
+        fullScanInterval <= FailoverConfig::GetConfig().PeriodicStateScanInterval ||
+        Stopwatch::Now() - lastFullScanTime_ >= fullScanInterval;
+
+    AcquireExclusiveLock lock(lockObject_);
+
+    isFullScanNeeded = isFullScanNeeded || isFullScanRequested_;
+    isFullScanRequested_ = false;
+
+    return isFullScanNeeded;
+}
+
 bool BackgroundManager::EnableThrottledThread()
 {
     AcquireExclusiveLock lock(throttleLock_);
@@ -664,6 +738,14 @@ bool BackgroundManager::ProcessFailoverUnit(
     bool updated = (failoverUnit->PersistenceState != PersistenceState::NoChange);
     int replicaDifference = failoverUnit->ReplicaDifference;
 
+    // Revisit the FailoverUnit in the next incremental pass until it is stable
+    if (updated || replicaDifference != 0 || !actions.empty() || !failoverUnit->IsStable || failoverUnit->IsToBeDeleted)
+    {
+        fm_.FailoverUnitCacheObj.WorkQueue.Schedule(
+            failoverUnit->Id,
+            Stopwatch::Now() + FailoverConfig::GetConfig().PeriodicStateScanInterval);
+    }
+
     if (!updated)
     {
         if (replicaDifference != 0)
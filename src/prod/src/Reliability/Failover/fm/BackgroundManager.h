@@ -91,6 +91,13 @@ namespace Reliability
 
             bool enumerationAborted_;
             bool enumerationCompleted_;
+
+            // Whether the current pass visits all FailoverUnits, or only the ones in the work queue of the FailoverUnitCache.
+            bool isFullScan_;
+            // Set by ScheduleRun when a change that is not tracked per FailoverUnit needs a full scan. Protected by lockObject_.
+            bool isFullScanRequested_;
+            Common::StopwatchTime lastFullScanTime_;
+
             std::set<FailoverUnitId> unprocessedFailoverUnits_;
 
             // The state machine tasks for stateless services and stateful services
@@ -134,6 +141,8 @@ namespace Reliability
 
             bool IsEnumerationCompleted();
 
+            bool IsFullScanNeeded();
+
             // This is executed by each worker thread. It processes FailoverUnits until there is no one left.
             void Process();
             bool Process(EnumerationContext & enumerationContext, bool isThrottledThread);
@@ -85,6 +85,7 @@
 #include "Reliability/Failover/fm/GFUMMessageBody.h"
 #include "Reliability/Failover/fm/FMServiceLookupTable.h"
 #include "Reliability/Failover/fm/FailoverUnitCacheEntry.h"
+#include "Reliability/Failover/fm/FailoverUnitWorkQueue.h"
 #include "Reliability/Failover/fm/LockedFailoverUnitPtr.h"
 #include "Reliability/Failover/fm/StateMachineAction.h"
 #include "Reliability/Failover/fm/FailoverUnitJobQueue.h"
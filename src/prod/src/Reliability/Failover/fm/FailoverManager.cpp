@@ -2522,6 +2522,12 @@ Transport::MessageUPtr FailoverManager::ReportLoadMessageHandler(Message & reque
         return nullptr;
     }
 
+    if (!body.TryExpandCompactReports())
+    {
+        WriteWarning("ReportLoadMessageHandler", "Dropping malformed compact load report {0}", request.MessageId);
+        return nullptr;
+    }
+
     TimeSpan diff = Stopwatch::Now() - body.SenderTime;
     for (auto it = body.Reports.begin(); it != body.Reports.end(); ++it)
     {
@@ -80,6 +80,14 @@ FailoverUnitCache::Visitor::Visitor(FailoverUnitCache const& cache,
     }
 }
 
+FailoverUnitCache::Visitor::Visitor(FailoverUnitCache const& cache, 
+                                    vector<FailoverUnitId> && failoverUnitIds,
+                                    TimeSpan timeout,
+                                    bool executeStateMachine)
+    : cache_(cache), shuffleTable_(move(failoverUnitIds)), index_(-1), timeout_(timeout), executeStateMachine_(executeStateMachine)
+{
+}
+
 LockedFailoverUnitPtr FailoverUnitCache::Visitor::MoveNext()
 {
     LockedFailoverUnitPtr failoverUnit;
@@ -130,6 +138,15 @@ void FailoverUnitCache::Visitor::Reset()
     InterlockedExchange(&index_, -1);
 }
 
+void FailoverUnitCache::Visitor::GetUnvisitedFailoverUnits(__inout vector<FailoverUnitId> & failoverUnitIds) const
+{
+    size_t next = static_cast<size_t>(index_ + 1);
+    if (next < shuffleTable_.size())
+    {
+        failoverUnitIds.insert(failoverUnitIds.end(), shuffleTable_.begin() + next, shuffleTable_.end());
+    }
+}
+
 FailoverUnitCache::FailoverUnitCache(
     FailoverManager& fm,
     vector<FailoverUnitUPtr> & failoverUnits,
@@ -147,7 +164,8 @@ FailoverUnitCache::FailoverUnitCache(
     initialSequence_(0),
     ackedSequence_(FABRIC_INVALID_SEQUENCE_NUMBER),
     invalidateSequence_(0),
-    healthInitialized_(false)
+    healthInitialized_(false),
+    workQueue_()
 {
     int64 plbElapsedMilliseconds;
     for (size_t i = 0; i < failoverUnits.size(); i++)
@@ -201,6 +219,8 @@ void FailoverUnitCache::InsertFailoverUnitInCache(FailoverUnitUPtr && failoverUn
     auto failoverUnitCacheEntry = make_shared<FailoverUnitCacheEntry>(fm_, move(failoverUnit));
     auto result = failoverUnits_.insert(make_pair(failoverUnitId, failoverUnitCacheEntry));
 
+    workQueue_.MarkDirty(failoverUnitId);
+
     FailoverUnit & insertedFailoverUnit = *(result.first->second->FailoverUnit);
 
     // Update ServiceLookupTable
@@ -381,6 +401,8 @@ ErrorCode FailoverUnitCache::PostUpdateFailoverUnit(
             {
                 serviceLookupTable_.Update(*failoverUnit);
             }
+
+            workQueue_.MarkDirty(failoverUnit->Id);
         }
 
         UpdatePlacementAndLoadBalancer(failoverUnit, persistenceState, plbDuration);
@@ -448,6 +470,8 @@ ErrorCode FailoverUnitCache::PostUpdateFailoverUnit(
     {
         fm_.FTEvents.FTUpdateFailureError(failoverUnit->Id.Guid, *failoverUnit, error);
 
+        workQueue_.MarkDirty(failoverUnit->Id);
+
         if (fm_.IsMaster || FailoverConfig::GetConfig().StoreConnectionString.size() == 0)
         {
             return error;
@@ -505,6 +529,7 @@ ErrorCode FailoverUnitCache::UpdateFailoverUnit(LockedFailoverUnitPtr & failover
         if (failoverUnit->ReplicaDifference != 0)
         {
             UpdatePlacementAndLoadBalancer(failoverUnit, failoverUnit->PersistenceState, plbDuration);
+            workQueue_.MarkDirty(failoverUnit->Id);
         }
 
         return ErrorCodeValue::Success;
@@ -590,6 +615,11 @@ FailoverUnitCache::VisitorSPtr FailoverUnitCache::CreateVisitor(bool randomAcces
     return make_shared<Visitor>(*this, randomAccess, timeout, executeStateMachine);
 }
 
+FailoverUnitCache::VisitorSPtr FailoverUnitCache::CreateVisitor(vector<FailoverUnitId> && failoverUnitIds, TimeSpan timeout, bool executeStateMachine) const
+{
+    return make_shared<Visitor>(*this, move(failoverUnitIds), timeout, executeStateMachine);
+}
+
 bool FailoverUnitCache::TryProcessTaskAsync(FailoverUnitId failoverUnitId, DynamicStateMachineTaskUPtr & task, Federation::NodeInstance const & from, bool const isFromPLB) const
 {
     FailoverUnitCacheEntrySPtr entry;
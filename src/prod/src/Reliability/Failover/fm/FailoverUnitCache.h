@@ -33,12 +33,19 @@ namespace Reliability
 
             public:
                 Visitor(FailoverUnitCache const& cache, bool randomAccess, Common::TimeSpan timeout, bool executeStateMachine);
+                Visitor(FailoverUnitCache const& cache, std::vector<FailoverUnitId> && failoverUnitIds, Common::TimeSpan timeout, bool executeStateMachine);
+
+                __declspec(property(get=get_Count)) size_t Count;
+                size_t get_Count() const { return shuffleTable_.size(); }
 
                 LockedFailoverUnitPtr MoveNext();
                 LockedFailoverUnitPtr MoveNext(__out bool & result, FailoverUnitId & failoverUnitId);
 
                 void Reset();
 
+                // Appends the FailoverUnits that have not been returned by MoveNext yet.
+                void GetUnvisitedFailoverUnits(__inout std::vector<FailoverUnitId> & failoverUnitIds) const;
+
             private:
                 FailoverUnitCache const& cache_;
                 std::vector<FailoverUnitId> shuffleTable_;
@@ -73,6 +80,10 @@ namespace Reliability
             __declspec(property(get=get_InvalidatedHealthSequence)) FABRIC_SEQUENCE_NUMBER InvalidatedHealthSequence;
             FABRIC_SEQUENCE_NUMBER get_InvalidatedHealthSequence() const { return invalidateSequence_; }
 
+            // The FailoverUnits with pending work for the incremental background passes
+            __declspec(property(get=get_WorkQueue)) FailoverUnitWorkQueue & WorkQueue;
+            FailoverUnitWorkQueue & get_WorkQueue() { return workQueue_; }
+
             Common::ErrorCode UpdateFailoverUnit(LockedFailoverUnitPtr & failoverUnit);
 
             void UpdateFailoverUnitAsync(
@@ -85,6 +96,9 @@ namespace Reliability
             VisitorSPtr CreateVisitor(bool randomAccess, Common::TimeSpan timeout, bool executeStateMachine = false) const;
             VisitorSPtr CreateVisitor(bool randomAccess = false) const;
 
+            // Visits the given FailoverUnits only, skipping the ones that no longer exist
+            VisitorSPtr CreateVisitor(std::vector<FailoverUnitId> && failoverUnitIds, Common::TimeSpan timeout, bool executeStateMachine) const;
+
             bool TryProcessTaskAsync(FailoverUnitId failoverUnitId, DynamicStateMachineTaskUPtr & task, Federation::NodeInstance const & from, bool const isFromPLB = false) const;
 
             bool TryGetLockedFailoverUnit(
@@ -150,6 +164,8 @@ namespace Reliability
             FABRIC_SEQUENCE_NUMBER invalidateSequence_;
             bool healthInitialized_;
 
+            FailoverUnitWorkQueue workQueue_;
+
             MUTABLE_RWLOCK(FM.FailoverUnitCache, lock_);
         };
     }
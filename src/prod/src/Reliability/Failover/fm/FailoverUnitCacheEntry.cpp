@@ -105,6 +105,7 @@ bool FailoverUnitCacheEntry::Lock(
 bool FailoverUnitCacheEntry::Release(bool restoreExecutingTask, bool processPendingTask)
 {
     bool waiting;
+    bool hasPendingTasks;
     {
 #if !defined(PLATFORM_UNIX)
         AcquireWriteLock grab(lock_);
@@ -140,6 +141,7 @@ bool FailoverUnitCacheEntry::Release(bool restoreExecutingTask, bool processPend
             }
         }
 
+        hasPendingTasks = !pendingTasks_.empty();
         isFree_ = true;
     }
 
@@ -151,6 +153,11 @@ bool FailoverUnitCacheEntry::Release(bool restoreExecutingTask, bool processPend
     // Consider to post to processing queue when there is pending task and
     // restoreExecutingTask is false.  At this moment the code path that
     // can benefit from this optimization is quite rare.
+    // The next background pass picks up the pending tasks instead.
+    if (hasPendingTasks)
+    {
+        fm_.FailoverUnitCacheObj.WorkQueue.MarkDirty(failoverUnit_->Id);
+    }
 
     return true;
 }
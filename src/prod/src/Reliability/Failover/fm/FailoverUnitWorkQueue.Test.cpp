@@ -0,0 +1,136 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+namespace FailoverManagerUnitTest
+{
+    using namespace Common;
+    using namespace std;
+    using namespace Reliability;
+    using namespace Reliability::FailoverManagerComponent;
+
+    class TestFailoverUnitWorkQueue
+    {
+    protected:
+        static vector<FailoverUnitId> CreateFailoverUnitIds(int count)
+        {
+            vector<FailoverUnitId> failoverUnitIds;
+            for (int i = 0; i < count; i++)
+            {
+                failoverUnitIds.push_back(FailoverUnitId(Guid::NewGuid()));
+            }
+
+            return failoverUnitIds;
+        }
+
+        static set<FailoverUnitId> TakeDue(FailoverUnitWorkQueue & workQueue, StopwatchTime now)
+        {
+            vector<FailoverUnitId> failoverUnitIds;
+            workQueue.TakeDue(now, failoverUnitIds);
+
+            set<FailoverUnitId> result(failoverUnitIds.begin(), failoverUnitIds.end());
+            VERIFY_ARE_EQUAL(failoverUnitIds.size(), result.size());
+
+            return result;
+        }
+    };
+
+    BOOST_FIXTURE_TEST_SUITE(TestFailoverUnitWorkQueueSuite, TestFailoverUnitWorkQueue)
+
+    BOOST_AUTO_TEST_CASE(DirtyTest)
+    {
+        FailoverUnitWorkQueue workQueue;
+        auto ids = CreateFailoverUnitIds(3);
+
+        workQueue.MarkDirty(ids[0]);
+        workQueue.MarkDirty(ids[1]);
+        workQueue.MarkDirty(ids[0]);
+        VERIFY_ARE_EQUAL(2u, workQueue.Count);
+
+        auto due = TakeDue(workQueue, StopwatchTime::Zero);
+        VERIFY_ARE_EQUAL(2u, due.size());
+        VERIFY_IS_TRUE(due.find(ids[0]) != due.end());
+        VERIFY_IS_TRUE(due.find(ids[1]) != due.end());
+        VERIFY_ARE_EQUAL(0u, workQueue.Count);
+
+        VERIFY_ARE_EQUAL(0u, TakeDue(workQueue, StopwatchTime::MaxValue).size());
+    }
+
+    BOOST_AUTO_TEST_CASE(ScheduleTest)
+    {
+        FailoverUnitWorkQueue workQueue;
+        auto ids = CreateFailoverUnitIds(3);
+
+        StopwatchTime now = Stopwatch::Now();
+        workQueue.Schedule(ids[0], now + TimeSpan::FromSeconds(10));
+        workQueue.Schedule(ids[1], now + TimeSpan::FromSeconds(20));
+        workQueue.Schedule(ids[2], now + TimeSpan::FromSeconds(30));
+        VERIFY_ARE_EQUAL(3u, workQueue.Count);
+
+        VERIFY_ARE_EQUAL(0u, TakeDue(workQueue, now).size());
+
+        auto due = TakeDue(workQueue, now + TimeSpan::FromSeconds(20));
+        VERIFY_ARE_EQUAL(2u, due.size());
+        VERIFY_IS_TRUE(due.find(ids[2]) == due.end());
+        VERIFY_ARE_EQUAL(1u, workQueue.Count);
+
+        due = TakeDue(workQueue, now + TimeSpan::FromSeconds(30));
+        VERIFY_ARE_EQUAL(1u, due.size());
+        VERIFY_IS_TRUE(due.find(ids[2]) != due.end());
+        VERIFY_ARE_EQUAL(0u, workQueue.Count);
+    }
+
+    BOOST_AUTO_TEST_CASE(EarliestDeadlineWinsTest)
+    {
+        FailoverUnitWorkQueue workQueue;
+        auto ids = CreateFailoverUnitIds(2);
+
+        StopwatchTime now = Stopwatch::Now();
+        workQueue.Schedule(ids[0], now + TimeSpan::FromSeconds(30));
+        workQueue.Schedule(ids[0], now + TimeSpan::FromSeconds(10));
+        workQueue.Schedule(ids[1], now + TimeSpan::FromSeconds(10));
+        workQueue.Schedule(ids[1], now + TimeSpan::FromSeconds(30));
+        VERIFY_ARE_EQUAL(2u, workQueue.Count);
+
+        auto due = TakeDue(workQueue, now + TimeSpan::FromSeconds(10));
+        VERIFY_ARE_EQUAL(2u, due.size());
+
+        // The replaced deadlines must not return the FailoverUnits again
+        VERIFY_ARE_EQUAL(0u, TakeDue(workQueue, now + TimeSpan::FromSeconds(30)).size());
+    }
+
+    BOOST_AUTO_TEST_CASE(DirtyOverridesScheduleTest)
+    {
+        FailoverUnitWorkQueue workQueue;
+        auto ids = CreateFailoverUnitIds(2);
+
+        StopwatchTime now = Stopwatch::Now();
+        workQueue.Schedule(ids[0], now + TimeSpan::FromSeconds(10));
+        workQueue.MarkDirty(ids[0]);
+        workQueue.MarkDirty(ids[1]);
+        workQueue.Schedule(ids[1], now + TimeSpan::FromSeconds(10));
+        VERIFY_ARE_EQUAL(2u, workQueue.Count);
+
+        VERIFY_ARE_EQUAL(2u, TakeDue(workQueue, now).size());
+        VERIFY_ARE_EQUAL(0u, workQueue.Count);
+        VERIFY_ARE_EQUAL(0u, TakeDue(workQueue, now + TimeSpan::FromSeconds(10)).size());
+
+        // A FailoverUnit can be scheduled again after it was taken
+        workQueue.Schedule(ids[0], now + TimeSpan::FromSeconds(20));
+        VERIFY_ARE_EQUAL(1u, TakeDue(workQueue, now + TimeSpan::FromSeconds(20)).size());
+
+        workQueue.MarkDirty(ids[1]);
+        workQueue.Schedule(ids[0], now);
+        workQueue.Clear();
+        VERIFY_ARE_EQUAL(0u, workQueue.Count);
+        VERIFY_ARE_EQUAL(0u, TakeDue(workQueue, StopwatchTime::MaxValue).size());
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+}
@@ -0,0 +1,97 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace std;
+using namespace Common;
+using namespace Reliability;
+using namespace Reliability::FailoverManagerComponent;
+
+FailoverUnitWorkQueue::FailoverUnitWorkQueue()
+    : dirty_(),
+    deadlines_(),
+    deadlineQueue_(),
+    lock_()
+{
+}
+
+size_t FailoverUnitWorkQueue::get_Count() const
+{
+    AcquireExclusiveLock grab(lock_);
+    return dirty_.size() + deadlines_.size();
+}
+
+void FailoverUnitWorkQueue::MarkDirty(FailoverUnitId const & failoverUnitId)
+{
+    AcquireExclusiveLock grab(lock_);
+
+    if (dirty_.insert(failoverUnitId).second)
+    {
+        deadlines_.erase(failoverUnitId);
+    }
+}
+
+void FailoverUnitWorkQueue::Schedule(FailoverUnitId const & failoverUnitId, StopwatchTime dueTime)
+{
+    AcquireExclusiveLock grab(lock_);
+
+    if (dirty_.find(failoverUnitId) != dirty_.end())
+    {
+        return;
+    }
+
+    auto it = deadlines_.find(failoverUnitId);
+    if (it != deadlines_.end())
+    {
+        if (it->second <= dueTime)
+        {
+            return;
+        }
+
+        it->second = dueTime;
+    }
+    else
+    {
+        deadlines_.insert(make_pair(failoverUnitId, dueTime));
+    }
+
+    deadlineQueue_.push(make_pair(dueTime, failoverUnitId));
+}
+
+void FailoverUnitWorkQueue::TakeDue(StopwatchTime now, __inout vector<FailoverUnitId> & failoverUnitIds)
+{
+    AcquireExclusiveLock grab(lock_);
+
+    failoverUnitIds.insert(failoverUnitIds.end(), dirty_.begin(), dirty_.end());
+    dirty_.clear();
+
+    while (!deadlineQueue_.empty() && deadlineQueue_.top().first <= now)
+    {
+        Deadline deadline = deadlineQueue_.top();
+        deadlineQueue_.pop();
+
+        auto it = deadlines_.find(deadline.second);
+        if (it != deadlines_.end() && it->second == deadline.first)
+        {
+            failoverUnitIds.push_back(deadline.second);
+            deadlines_.erase(it);
+        }
+    }
+
+    if (deadlines_.empty())
+    {
+        deadlineQueue_ = decltype(deadlineQueue_)();
+    }
+}
+
+void FailoverUnitWorkQueue::Clear()
+{
+    AcquireExclusiveLock grab(lock_);
+
+    dirty_.clear();
+    deadlines_.clear();
+    deadlineQueue_ = decltype(deadlineQueue_)();
+}
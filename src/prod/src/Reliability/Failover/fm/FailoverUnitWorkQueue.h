@@ -0,0 +1,52 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Reliability
+{
+    namespace FailoverManagerComponent
+    {
+        /// <summary>
+        /// The FailoverUnits the background manager needs to process between full scans:
+        /// the ones that changed since the last pass (dirty) and the ones that still have
+        /// pending work and are revisited once their deadline is reached.
+        /// </summary>
+        class FailoverUnitWorkQueue
+        {
+            DENY_COPY(FailoverUnitWorkQueue);
+
+        public:
+            FailoverUnitWorkQueue();
+
+            __declspec(property(get=get_Count)) size_t Count;
+            size_t get_Count() const;
+
+            // The FailoverUnit is processed by the next background pass.
+            void MarkDirty(FailoverUnitId const & failoverUnitId);
+
+            // The FailoverUnit is processed by the first background pass after dueTime.
+            // The earliest deadline wins if the FailoverUnit is already scheduled.
+            void Schedule(FailoverUnitId const & failoverUnitId, Common::StopwatchTime dueTime);
+
+            // Removes the FailoverUnits that are dirty or due at the given time and appends them.
+            void TakeDue(Common::StopwatchTime now, __inout std::vector<FailoverUnitId> & failoverUnitIds);
+
+            void Clear();
+
+        private:
+            typedef std::pair<Common::StopwatchTime, FailoverUnitId> Deadline;
+
+            std::set<FailoverUnitId> dirty_;
+
+            // Current deadline of each scheduled FailoverUnit that is not dirty. Entries in the
+            // priority queue that do not match it were replaced or taken, and are skipped.
+            std::map<FailoverUnitId, Common::StopwatchTime> deadlines_;
+            std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> deadlineQueue_;
+
+            mutable Common::ExclusiveLock lock_;
+        };
+    }
+}
@@ -298,6 +298,24 @@ void InstrumentedPLB::UpdateLoadOrMoveCost(LoadOrMoveCostDescription && loadOrMo
     }
 }
 
+void InstrumentedPLB::UpdateLoadOrMoveCosts(vector<LoadOrMoveCostDescription> && loadOrMoveCosts)
+{
+    Stopwatch sw;
+    sw.Start();
+
+    plb_->UpdateLoadOrMoveCosts(move(loadOrMoveCosts));
+
+    sw.Stop();
+
+    fm_.FailoverUnitCounters->PlbUpdateLoadOrMoveCostBase.Increment();
+    fm_.FailoverUnitCounters->PlbUpdateLoadOrMoveCost.IncrementBy(static_cast<PerformanceCounterValue>(sw.ElapsedMilliseconds));
+
+    if (sw.Elapsed > FailoverConfig::GetConfig().PlbUpdateTimeLimit)
+    {
+        fm_.Events.PlbFunctionCallSlow(PlbApiCallName::UpdateLoadOrMoveCost, sw.ElapsedMilliseconds);
+    }
+}
+
 void InstrumentedPLB::UpdateClusterUpgrade(bool isUpgradeInProgress, std::set<std::wstring> && completedUDs)
 {
     Stopwatch sw;
@@ -40,6 +40,7 @@ namespace Reliability
             virtual void UpdateFailoverUnit(LoadBalancingComponent::FailoverUnitDescription && failoverUnitDescription, __out int64 & plbElapsedMilliseconds);
             virtual void DeleteFailoverUnit(std::wstring && serviceName, Common::Guid failoverUnitId, __out int64 & plbElapsedMilliseconds);
             virtual void UpdateLoadOrMoveCost(LoadBalancingComponent::LoadOrMoveCostDescription && loadOrMoveCost);
+            virtual void UpdateLoadOrMoveCosts(std::vector<LoadBalancingComponent::LoadOrMoveCostDescription> && loadOrMoveCosts);
             virtual Common::ErrorCode ResetPartitionLoad(FailoverUnitId const & failoverUnitId, std::wstring const & serviceName, bool isStateful);
 
             //Query APIs
@@ -200,6 +200,11 @@ void LoadCache::PersistCallback(size_t listIndex, int64 operationLSN, ErrorCode
 void LoadCache::OnPersistCompleted(size_t listIndex, bool isSuccess, int64 operationLSN)
 {
     PersistenceListUPtr const & list = activeLists_[listIndex];
+
+    // The loads of the whole persisted batch are handed to PLB in one call
+    vector<LoadBalancingComponent::LoadOrMoveCostDescription> plbUpdates;
+    plbUpdates.reserve(list->size());
+
     for (auto id : *list)
     {
         auto it = loads_.find(id);
@@ -215,7 +220,7 @@ void LoadCache::OnPersistCompleted(size_t listIndex, bool isSuccess, int64 opera
 
         bool isDeleted = peristenceState == PersistenceState::ToBeDeleted;
 
-        bool pendingUpdate = it->second->OnPersistCompleted(isSuccess, isDeleted, plb_);
+        bool pendingUpdate = it->second->OnPersistCompleted(isSuccess, isDeleted, plbUpdates);
 
         if (isDeleted)
         {
@@ -229,6 +234,11 @@ void LoadCache::OnPersistCompleted(size_t listIndex, bool isSuccess, int64 opera
 
     list->clear();
 
+    if (!plbUpdates.empty())
+    {
+        plb_.UpdateLoadOrMoveCosts(move(plbUpdates));
+    }
+
     if (isSuccess && pendingQueue_.size() >= maxBatchSize_)
     {
         StartPersist();
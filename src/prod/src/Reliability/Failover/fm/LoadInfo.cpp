@@ -137,7 +137,7 @@ void LoadInfo::StartPersist()
     isUpdating_ = true;
 }
 
-bool LoadInfo::OnPersistCompleted(bool isSuccess, bool isDeleted, LoadBalancingComponent::IPlacementAndLoadBalancing & plb)
+bool LoadInfo::OnPersistCompleted(bool isSuccess, bool isDeleted, __inout vector<LoadBalancingComponent::LoadOrMoveCostDescription> & plbUpdates)
 {
     ASSERT_IFNOT(isUpdating_,
         "Invalid state {0} when persistence completed", *this);
@@ -149,7 +149,7 @@ bool LoadInfo::OnPersistCompleted(bool isSuccess, bool isDeleted, LoadBalancingC
     {
         if (!isDeleted)
         {
-            plb.UpdateLoadOrMoveCost(GetPLBLoadOrMoveCostDescription());
+            plbUpdates.push_back(GetPLBLoadOrMoveCostDescription());
         }
 
         if (isPending_)
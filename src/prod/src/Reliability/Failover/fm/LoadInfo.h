@@ -40,7 +40,7 @@ namespace Reliability
             LoadBalancingComponent::LoadOrMoveCostDescription GetPLBLoadOrMoveCostDescription();
 
             void StartPersist();
-            bool OnPersistCompleted(bool isSuccess, bool isDeleted, LoadBalancingComponent::IPlacementAndLoadBalancing & plb);
+            bool OnPersistCompleted(bool isSuccess, bool isDeleted, __inout std::vector<LoadBalancingComponent::LoadOrMoveCostDescription> & plbUpdates);
 
             void WriteTo(Common::TextWriter&, Common::FormatOptions const &) const;
 
@@ -0,0 +1,146 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "Ra.Stdafx.h"
+
+using namespace std;
+using namespace Common;
+using namespace Transport;
+using namespace Reliability;
+using namespace ReconfigurationAgentComponent;
+using namespace Communication;
+
+LoadReportBatcher::LoadReportBatcher(ReconfigurationAgent & ra)
+    : ra_(ra),
+      isClosed_(false),
+      isTimerSet_(false)
+{
+    auto root = ra.Root.CreateComponentRoot();
+    timer_ = Timer::Create("RA.LoadReportBatcher", [this, root] (TimerSPtr const &)
+    {
+        this->OnTimer();
+    });
+}
+
+LoadReportBatcher::~LoadReportBatcher()
+{
+}
+
+void LoadReportBatcher::Close()
+{
+    // Pending reports are dropped, the hosts report the load again after the node comes back
+    AcquireExclusiveLock grab(lock_);
+    isClosed_ = true;
+    pendingReports_.clear();
+    if (timer_ != nullptr)
+    {
+        timer_->Cancel();
+        timer_ = nullptr;
+    }
+}
+
+void LoadReportBatcher::Add(ReportLoadMessageBody && body)
+{
+    TimeSpan batchInterval = ra_.Config.NodeLoadReportBatchInterval;
+
+    {
+        AcquireExclusiveLock grab(lock_);
+
+        if (isClosed_)
+        {
+            return;
+        }
+
+        if (batchInterval > TimeSpan::Zero)
+        {
+            // The timestamps of all the reports are taken on this node so they can be merged as is
+            for (auto it = body.Reports.begin(); it != body.Reports.end(); ++it)
+            {
+                auto pending = pendingReports_.find(it->FailoverUnitId);
+                if (pending == pendingReports_.end())
+                {
+                    pendingReports_.insert(make_pair(it->FailoverUnitId, move(*it)));
+                }
+                else
+                {
+                    pending->second.MergeLoads(move(*it));
+                }
+            }
+
+            if (!isTimerSet_)
+            {
+                isTimerSet_ = true;
+                timer_->Change(batchInterval);
+            }
+
+            return;
+        }
+    }
+
+    Send(move(body.Reports), body.SenderTime);
+}
+
+void LoadReportBatcher::OnTimer()
+{
+    vector<LoadBalancingComponent::LoadOrMoveCostDescription> reports;
+
+    {
+        AcquireExclusiveLock grab(lock_);
+
+        isTimerSet_ = false;
+
+        if (isClosed_)
+        {
+            return;
+        }
+
+        reports.reserve(pendingReports_.size());
+        for (auto it = pendingReports_.begin(); it != pendingReports_.end(); ++it)
+        {
+            reports.push_back(move(it->second));
+        }
+
+        pendingReports_.clear();
+    }
+
+    if (!reports.empty())
+    {
+        Send(move(reports), Stopwatch::Now());
+    }
+}
+
+void LoadReportBatcher::Send(vector<LoadBalancingComponent::LoadOrMoveCostDescription> && reports, StopwatchTime senderTime)
+{
+    size_t maxReportsPerMessage = static_cast<size_t>(max(ra_.Config.MaxNumberOfLoadReportsPerMessage, 1));
+    bool isCompact = ra_.Config.EnableCompactLoadReports;
+
+    for (size_t start = 0; start < reports.size(); start += maxReportsPerMessage)
+    {
+        size_t end = min(reports.size(), start + maxReportsPerMessage);
+
+        vector<LoadBalancingComponent::LoadOrMoveCostDescription> chunk;
+        if (start == 0 && end == reports.size())
+        {
+            chunk = move(reports);
+        }
+        else
+        {
+            chunk.reserve(end - start);
+            for (size_t i = start; i < end; ++i)
+            {
+                chunk.push_back(move(reports[i]));
+            }
+        }
+
+        ReportLoadMessageBody body(move(chunk), senderTime);
+        if (isCompact)
+        {
+            body.CompactReports();
+        }
+
+        MessageUPtr msg = RSMessage::GetReportLoad().CreateMessage<ReportLoadMessageBody>(body);
+        ra_.Federation.SendToFM(move(msg));
+    }
+}
@@ -0,0 +1,43 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Reliability
+{
+    namespace ReconfigurationAgentComponent
+    {
+        namespace Communication
+        {
+            // Forwards the load reports of all the hosts (and resource monitor) on the node to the FM
+            // Reports received within NodeLoadReportBatchInterval are merged per failover unit and sent in one message
+            class LoadReportBatcher
+            {
+                DENY_COPY(LoadReportBatcher);
+
+            public:
+                LoadReportBatcher(ReconfigurationAgent & ra);
+                ~LoadReportBatcher();
+
+                void Close();
+
+                void Add(ReportLoadMessageBody && body);
+
+            private:
+                void OnTimer();
+
+                void Send(std::vector<LoadBalancingComponent::LoadOrMoveCostDescription> && reports, Common::StopwatchTime senderTime);
+
+                ReconfigurationAgent & ra_;
+
+                Common::ExclusiveLock lock_;
+                bool isClosed_;
+                bool isTimerSet_;
+                Common::TimerSPtr timer_;
+                std::map<Common::Guid, LoadBalancingComponent::LoadOrMoveCostDescription> pendingReports_;
+            };
+        }
+    }
+}
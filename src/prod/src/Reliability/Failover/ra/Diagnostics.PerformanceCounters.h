@@ -235,6 +235,32 @@ namespace Reliability
                         L"# of Service Description Update Pending FTs",
                         L"Number of Service Description Update Pending FTs")
 
+                    COUNTER_DEFINITION(
+                        40,
+                        Common::PerformanceCounterType::RateOfCountPerSecond32,
+                        L"Store Group Commits/sec",
+                        L"Number of batched store transactions committed per second")
+
+                    COUNTER_DEFINITION(
+                        41,
+                        Common::PerformanceCounterType::AverageBase,
+                        L"Avg. Store Operations/Group Commit Base",
+                        L"Base counter for average store operations committed in every group commit",
+                        noDisplay)
+
+                    COUNTER_DEFINITION_WITH_BASE(
+                        42,
+                        41,
+                        Common::PerformanceCounterType::AverageCount64,
+                        L"Avg. Store Operations/Group Commit",
+                        L"Average store operations committed in every group commit")
+
+                    COUNTER_DEFINITION(
+                        43,
+                        Common::PerformanceCounterType::RawData64,
+                        L"# of Pending Group Commit Operations",
+                        L"Number of store operations waiting to be added to a group commit")
+
                 END_COUNTER_SET_DEFINITION()
 
                 DECLARE_COUNTER_INSTANCE(NumberOfCompletedUpgrades)
@@ -271,6 +297,10 @@ namespace Reliability
                 DECLARE_COUNTER_INSTANCE(NumberOfReplicaOpenPendingFTs)
                 DECLARE_COUNTER_INSTANCE(NumberOfReplicaClosePendingFTs)
                 DECLARE_COUNTER_INSTANCE(NumberOfServiceDescriptionUpdatePendingFTs)
+                DECLARE_COUNTER_INSTANCE(NumberOfStoreGroupCommitsPerSecond)
+                DECLARE_COUNTER_INSTANCE(AverageOperationsPerStoreGroupCommitBase)
+                DECLARE_COUNTER_INSTANCE(AverageOperationsPerStoreGroupCommit)
+                DECLARE_COUNTER_INSTANCE(NumberOfPendingGroupCommitOperations)
 
                 BEGIN_COUNTER_SET_INSTANCE(RAPerformanceCounters)
                     DEFINE_COUNTER_INSTANCE(NumberOfCompletedUpgrades,                  6)
@@ -307,6 +337,10 @@ namespace Reliability
                     DEFINE_COUNTER_INSTANCE(NumberOfReplicaOpenPendingFTs,              37)
                     DEFINE_COUNTER_INSTANCE(NumberOfReplicaClosePendingFTs,             38)
                     DEFINE_COUNTER_INSTANCE(NumberOfServiceDescriptionUpdatePendingFTs, 39)
+                    DEFINE_COUNTER_INSTANCE(NumberOfStoreGroupCommitsPerSecond,         40)
+                    DEFINE_COUNTER_INSTANCE(AverageOperationsPerStoreGroupCommitBase,   41)
+                    DEFINE_COUNTER_INSTANCE(AverageOperationsPerStoreGroupCommit,       42)
+                    DEFINE_COUNTER_INSTANCE(NumberOfPendingGroupCommitOperations,       43)
                 END_COUNTER_SET_INSTANCE()
 
             public:
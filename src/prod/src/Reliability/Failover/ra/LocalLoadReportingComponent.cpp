@@ -14,6 +14,7 @@ LocalLoadReportingComponent::LocalLoadReportingComponent(
     Common::ComponentRoot const & root,
     Transport::IpcClient & ipcClient)
         :failoverUnitLoadMap_(),
+        reportedLoadMap_(),
         lock_(),
         open_(false),
         reportTimerSPtr_(),    
@@ -66,6 +67,7 @@ void LocalLoadReportingComponent::Close()
             }
 
             failoverUnitLoadMap_.clear();
+            reportedLoadMap_.clear();
         }
     }
 }
@@ -189,6 +191,15 @@ void LocalLoadReportingComponent::AddLoad(
         {
             RAPEventSource::Events->LoadReportingAddLoad(id_, failoverUnitLoadMap_.size(), fuId.Guid, replicaRole, metric.Name, metric.Value);
         }
+
+        auto plbReplicaRole = ReplicaRole::ConvertToPLBReplicaRole(isStateful, replicaRole);
+        StopwatchTime now = Stopwatch::Now();
+
+        RemoveUnchangedLoads(fuId, plbReplicaRole, now, loadMetrics);
+        if (loadMetrics.empty())
+        {
+            return;
+        }
         
         auto entry = failoverUnitLoadMap_.find(fuId);
         if (entry == failoverUnitLoadMap_.end())
@@ -196,7 +207,7 @@ void LocalLoadReportingComponent::AddLoad(
             entry = failoverUnitLoadMap_.insert(make_pair(fuId, LoadBalancingComponent::LoadOrMoveCostDescription(fuId.Guid, move(serviceName), isStateful))).first;
         }
 
-        entry->second.MergeLoads(ReplicaRole::ConvertToPLBReplicaRole(isStateful, replicaRole), move(loadMetrics), Stopwatch::Now(), true, nodeId);
+        entry->second.MergeLoads(plbReplicaRole, move(loadMetrics), now, true, nodeId);
     }
 
     SetTimer();
@@ -245,5 +256,64 @@ void LocalLoadReportingComponent::RemoveFailoverUnit(FailoverUnitId const & fuId
 
             failoverUnitLoadMap_.erase(fuId);
         }
+
+        reportedLoadMap_.erase(fuId);
+    }
+}
+
+bool LocalLoadReportingComponent::IsSignificantChange(uint lastValue, uint newValue, int thresholdPercent)
+{
+    uint64 difference = lastValue > newValue ? lastValue - newValue : newValue - lastValue;
+
+    return difference > 0 && difference * 100 > static_cast<uint64>(thresholdPercent) * lastValue;
+}
+
+void LocalLoadReportingComponent::RemoveUnchangedLoads(
+    FailoverUnitId const & fuId,
+    LoadBalancingComponent::ReplicaRole::Enum replicaRole,
+    StopwatchTime now,
+    __inout vector<LoadBalancingComponent::LoadMetric> & loadMetrics)
+{
+    auto const & config = FailoverConfig::GetConfig();
+    int thresholdPercent = config.LoadReportDeltaThresholdPercent;
+
+    // With decay every reported sample contributes to the average kept by PLB so nothing can be dropped
+    if (thresholdPercent < 0 || LoadBalancingComponent::PLBConfig::GetConfig().LoadDecayFactor != 0.0)
+    {
+        return;
+    }
+
+    // Everything is reported once per refresh interval so that FM recovers from lost messages
+    ReportedLoad & reportedLoad = reportedLoadMap_[fuId];
+    if (reportedLoad.RefreshTime + config.LoadReportRefreshInterval <= now)
+    {
+        reportedLoad.RefreshTime = now;
+        reportedLoad.Values.clear();
+    }
+
+    vector<LoadBalancingComponent::LoadMetric> changedMetrics;
+    changedMetrics.reserve(loadMetrics.size());
+
+    for (auto it = loadMetrics.begin(); it != loadMetrics.end(); ++it)
+    {
+        auto key = make_pair(replicaRole, it->Name);
+        auto reportedValue = reportedLoad.Values.find(key);
+
+        if (reportedValue == reportedLoad.Values.end())
+        {
+            reportedLoad.Values.insert(make_pair(move(key), it->Value));
+        }
+        else if (IsSignificantChange(reportedValue->second, it->Value, thresholdPercent))
+        {
+            reportedValue->second = it->Value;
+        }
+        else
+        {
+            continue;
+        }
+
+        changedMetrics.push_back(move(*it));
     }
+
+    loadMetrics = move(changedMetrics);
 }
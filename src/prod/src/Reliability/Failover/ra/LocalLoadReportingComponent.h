@@ -39,12 +39,30 @@ namespace Reliability
             void RemoveFailoverUnit(FailoverUnitId const & fuId);
 
         private:
+            // Last values of the load metrics of a failover unit that were handed over for reporting
+            struct ReportedLoad
+            {
+                ReportedLoad() : RefreshTime(Common::StopwatchTime::Zero) {}
+
+                Common::StopwatchTime RefreshTime;
+                std::map<std::pair<LoadBalancingComponent::ReplicaRole::Enum, std::wstring>, uint> Values;
+            };
+
             static bool IsValidLoad(
                 bool isStateful, 
                 Reliability::ReplicaRole::Enum replicaRole, 
                 std::vector<LoadBalancingComponent::LoadMetric> const & loadMetrics);
 
+            static bool IsSignificantChange(uint lastValue, uint newValue, int thresholdPercent);
+
+            void RemoveUnchangedLoads(
+                FailoverUnitId const & fuId,
+                LoadBalancingComponent::ReplicaRole::Enum replicaRole,
+                Common::StopwatchTime now,
+                __inout std::vector<LoadBalancingComponent::LoadMetric> & loadMetrics);
+
             std::map<FailoverUnitId, LoadBalancingComponent::LoadOrMoveCostDescription> failoverUnitLoadMap_;
+            std::map<FailoverUnitId, ReportedLoad> reportedLoadMap_;
             
             bool open_;
             Common::TimerSPtr reportTimerSPtr_;
@@ -265,6 +265,7 @@ typedef std::function<Reliability::ReconfigurationAgentComponent::Infrastructure
 #include "Reliability/Failover/ra/Communication.FMMessageBuilder.h"
 #include "Reliability/Failover/ra/Communication.FMTransport.h"
 #include "Reliability/Failover/ra/Communication.RequestFMMessageRetryAction.h"
+#include "Reliability/Failover/ra/Communication.LoadReportBatcher.h"
 
 // Node
 #include "Reliability/Failover/ra/Node.NodeDeactivationInfo.h"
@@ -195,6 +195,8 @@ ErrorCode ReconfigurationAgent::Open(NodeUpOperationFactory & factory)
 
     CreateResourceMonitorComponent();
 
+    CreateLoadReportBatcher();
+
     // Initialize LFUM cache
     // The FTs require all the Failover Unit Sets etc to be initialized before
     // Hence this is the last step
@@ -246,6 +248,11 @@ void ReconfigurationAgent::CreateResourceMonitorComponent()
     resourceMonitorComponent_ = make_unique<ResourceMonitor::ResourceComponent>(*this);
 }
 
+void ReconfigurationAgent::CreateLoadReportBatcher()
+{
+    loadReportBatcher_ = make_unique<Communication::LoadReportBatcher>(*this);
+}
+
 void ReconfigurationAgent::CreateJobQueueManager()
 {
     threadpool_ = threadpoolFactory_(*this);
@@ -505,6 +512,7 @@ void ReconfigurationAgent::Close()
     CloseIfNotNull(updateServiceDescriptionMessageRetryWorkManager_);
     CloseIfNotNull(fmMessageRetryComponent_);
     CloseIfNotNull(fmmMessageRetryComponent_);
+    CloseIfNotNull(loadReportBatcher_);
 
     CloseIfNotNull(hostingAdapter_);
 
@@ -3679,7 +3687,7 @@ void ReconfigurationAgent::ReportLoadMessageHandler(Message & message)
         return;
     }
 
-    ProcessLoadReport(body);
+    ProcessLoadReport(move(body));
 }
 
 void ReconfigurationAgent::ReportHealthReportMessageHandler(MessageUPtr && messagePtr, IpcReceiverContextUPtr && context)
@@ -3699,11 +3707,9 @@ void ReconfigurationAgent::ReportResourceUsageHandler(Message & message)
     resourceMonitorComponent_->ProcessResoureUsageMessage(body);
 }
 
-void ReconfigurationAgent::ProcessLoadReport(ReportLoadMessageBody const & loadReport)
+void ReconfigurationAgent::ProcessLoadReport(ReportLoadMessageBody && loadReport)
 {
-    MessageUPtr msg = RSMessage::GetReportLoad().CreateMessage<ReportLoadMessageBody>(move(loadReport));
-
-    federationWrapper_->SendToFM(move(msg));
+    loadReportBatcher_->Add(move(loadReport));
 }
 
 void ReconfigurationAgent::ProxyReplicaEndpointUpdatedMessageHandler(HandlerParameters & parameters, ReplicaMessageContext & msgContext)
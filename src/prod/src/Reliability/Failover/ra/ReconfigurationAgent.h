@@ -461,7 +461,7 @@ namespace Reliability
 
             void ClientReportFaultRequestHandler(Transport::MessageUPtr && requestPtr, Federation::RequestReceiverContextUPtr && context);
 
-            void ProcessLoadReport(ReportLoadMessageBody const & loadReport);
+            void ProcessLoadReport(ReportLoadMessageBody && loadReport);
 
             void CreateReplicaUpReplyJobItemAndAddToList(
                 Reliability::FailoverUnitInfo && ftInfo,
@@ -799,6 +799,7 @@ namespace Reliability
             void CreateHostingAdapter();
             void CreateFMMessageRetryComponent();
             void CreateResourceMonitorComponent();
+            void CreateLoadReportBatcher();
 #pragma endregion
 
             // Member variables
@@ -879,6 +880,7 @@ namespace Reliability
             MessageHandler messageHandler_;
 
             ResourceMonitor::ResourceComponentUPtr resourceMonitorComponent_;
+            Communication::LoadReportBatcherUPtr loadReportBatcher_;
         };
     }
 }
@@ -191,13 +191,228 @@ private:
     RowIdentifier const & id_;
 };
 
+class LocalStoreAdapter::GroupCommitOperation : public Common::AsyncOperation
+{
+    DENY_COPY(GroupCommitOperation);
+public:
+    GroupCommitOperation(
+        LocalStoreAdapter & store,
+        RowIdentifier const & id,
+        OperationType::Enum operationType,
+        RowData && bytes,
+        Common::AsyncCallback const & callback,
+        Common::AsyncOperationSPtr const & parent) :
+        AsyncOperation(callback, parent),
+        store_(store),
+        id_(id),
+        operationType_(operationType),
+        bytes_(std::move(bytes))
+    {
+    }
+
+    __declspec(property(get = get_Id)) RowIdentifier const & Id;
+    RowIdentifier const & get_Id() const { return id_; }
+
+    __declspec(property(get = get_StoreOperationType)) OperationType::Enum StoreOperationType;
+    OperationType::Enum get_StoreOperationType() const { return operationType_; }
+
+    __declspec(property(get = get_Bytes)) RowData & Bytes;
+    RowData & get_Bytes() { return bytes_; }
+
+protected:
+    void OnStart(Common::AsyncOperationSPtr const & thisSPtr) override
+    {
+        store_.EnqueueGroupCommitOperation(std::static_pointer_cast<GroupCommitOperation>(thisSPtr));
+    }
+
+private:
+    LocalStoreAdapter & store_;
+
+    // The operation is queued so the row identifier must be owned
+    RowIdentifier id_;
+    OperationType::Enum operationType_;
+    RowData bytes_;
+};
+
+/*
+    Performs a batch of store operations in a single local store transaction
+    and completes every operation in the batch with the result of the commit
+
+    If any operation in the batch fails then the transaction is rolled back and 
+    each operation is committed in its own transaction so that a failure
+    (such as an insert of a row that already exists) is only reported for that operation
+*/
+class LocalStoreAdapter::GroupCommitBatchAsyncOperation : public Common::AsyncOperation
+{
+    DENY_COPY(GroupCommitBatchAsyncOperation);
+public:
+    GroupCommitBatchAsyncOperation(
+        LocalStoreAdapter & store,
+        std::vector<GroupCommitOperationSPtr> && operations,
+        Common::AsyncCallback const & callback,
+        Common::AsyncOperationSPtr const & parent) :
+        AsyncOperation(callback, parent),
+        store_(store),
+        operations_(std::move(operations)),
+        txnHolder_(store),
+        pendingFallbackCount_(0)
+    {
+    }
+
+protected:
+    void OnStart(Common::AsyncOperationSPtr const & thisSPtr) override
+    {
+        auto error = store_.CreateTransaction(txnHolder_);
+        if (!error.IsSuccess())
+        {
+            CompleteOperations(thisSPtr, error);
+            return;
+        }
+
+        for (auto const & it : operations_)
+        {
+            error = store_.PerformOperationInternal(txnHolder_.Transaction, it->StoreOperationType, it->Id, it->Bytes);
+            if (!error.IsSuccess())
+            {
+                break;
+            }
+        }
+
+        if (!error.IsSuccess())
+        {
+            txnHolder_.Transaction->Rollback();
+
+            if (operations_.size() == 1)
+            {
+                CompleteOperations(thisSPtr, error);
+            }
+            else
+            {
+                CommitIndividually(thisSPtr);
+            }
+
+            return;
+        }
+
+        store_.GetPerfCounters().NumberOfStoreGroupCommitsPerSecond.Increment();
+        store_.GetPerfCounters().AverageOperationsPerStoreGroupCommitBase.Increment();
+        store_.GetPerfCounters().AverageOperationsPerStoreGroupCommit.IncrementBy(operations_.size());
+        store_.GetPerfCounters().NumberOfStoreCommitsPerSecond.Increment();
+        store_.GetPerfCounters().NumberOfCommittingStoreTransactions.Increment();
+
+        auto op = txnHolder_.Transaction->BeginCommit(
+            Common::TimeSpan::MaxValue,
+            [this](Common::AsyncOperationSPtr const & innerOp)
+            {
+                if (!innerOp->CompletedSynchronously)
+                {
+                    FinishCommit(innerOp);
+                }
+            },
+            thisSPtr);
+
+        if (op->CompletedSynchronously)
+        {
+            FinishCommit(op);
+        }
+    }
+
+private:
+    void FinishCommit(Common::AsyncOperationSPtr const & txPtrCommitOperation)
+    {
+        store_.GetPerfCounters().NumberOfCommittingStoreTransactions.Decrement();
+        auto error = txnHolder_.Transaction->EndCommit(txPtrCommitOperation);
+
+        // Release ESE callback threads immediately -> same as the individual commit
+        auto op = store_.GetThreadpool().BeginScheduleCommitCallback(
+            [this, error](Common::AsyncOperationSPtr const & scheduleCommitOp)
+            {
+                if (!scheduleCommitOp->CompletedSynchronously)
+                {
+                    FinishScheduleCommitCallback(scheduleCommitOp, error);
+                }
+            },
+            txPtrCommitOperation->Parent);
+
+        if (op->CompletedSynchronously)
+        {
+            FinishScheduleCommitCallback(op, error);
+        }
+    }
+
+    void FinishScheduleCommitCallback(Common::AsyncOperationSPtr const & scheduleCommitCallbackOp, Common::ErrorCode const & txCommitError)
+    {
+        auto scheduleCommitError = store_.GetThreadpool().EndScheduleCommitCallback(scheduleCommitCallbackOp);
+        ASSERT_IF(!scheduleCommitError.IsSuccess(), "Schedule commit must succeed");
+
+        CompleteOperations(scheduleCommitCallbackOp->Parent, txCommitError);
+    }
+
+    void CommitIndividually(Common::AsyncOperationSPtr const & thisSPtr)
+    {
+        pendingFallbackCount_.store(static_cast<LONG>(operations_.size()));
+
+        for (auto const & it : operations_)
+        {
+            auto operation = it;
+            auto op = Common::AsyncOperation::CreateAndStart<CommitAsyncOperation>(
+                store_,
+                operation->Id,
+                operation->StoreOperationType,
+                std::move(operation->Bytes),
+                Common::TimeSpan::MaxValue,
+                [this, operation](Common::AsyncOperationSPtr const & innerOp)
+                {
+                    if (!innerOp->CompletedSynchronously)
+                    {
+                        FinishIndividualCommit(innerOp, operation);
+                    }
+                },
+                thisSPtr);
+
+            if (op->CompletedSynchronously)
+            {
+                FinishIndividualCommit(op, operation);
+            }
+        }
+    }
+
+    void FinishIndividualCommit(Common::AsyncOperationSPtr const & commitOp, GroupCommitOperationSPtr const & operation)
+    {
+        auto error = Common::AsyncOperation::End<Common::AsyncOperation>(commitOp)->Error;
+        operation->TryComplete(operation, error);
+
+        if (--pendingFallbackCount_ == 0)
+        {
+            TryComplete(commitOp->Parent);
+        }
+    }
+
+    void CompleteOperations(Common::AsyncOperationSPtr const & thisSPtr, Common::ErrorCode const & error)
+    {
+        for (auto const & it : operations_)
+        {
+            it->TryComplete(it, error);
+        }
+
+        TryComplete(thisSPtr);
+    }
+
+    LocalStoreAdapter & store_;
+    std::vector<GroupCommitOperationSPtr> operations_;
+    TransactionHolder txnHolder_;
+    Common::atomic_long pendingFallbackCount_;
+};
+
 // Constructor
 LocalStoreAdapter::LocalStoreAdapter(
     Store::IStoreFactorySPtr const & storeFactory,
     ReconfigurationAgent & ra) : 
     storeFactory_(storeFactory),
     ra_(ra),
-    isOpen_(false)
+    isOpen_(false),
+    isGroupCommitInProgress_(false),
+    isGroupCommitTimerSet_(false)
 {
     ASSERT_IF(storeFactory == nullptr, "Factory can't be null");
 }
@@ -228,6 +443,9 @@ ErrorCode LocalStoreAdapter::Open(
     error = store->Initialize(instance, ra_.NodeId);
     if (error.IsSuccess())
     {
+        auto root = ra_.Root.CreateComponentRoot();
+        groupCommitTimer_ = Timer::Create("RA.GroupCommit", [this, root](TimerSPtr const &) { OnGroupCommitTimerCallback(); }, false);
+
         store_ = move(store);
         isOpen_.store(true);
     }
@@ -265,6 +483,26 @@ void LocalStoreAdapter::Close()
         return;
     }
 
+    /*
+        Any operations waiting for the group commit timer are failed now as the store is no longer usable
+        A group commit that is already in flight has its transaction open and is waited for by Drain
+    */
+    groupCommitTimer_->Cancel();
+
+    std::deque<GroupCommitOperationSPtr> pendingOperations;
+
+    {
+        AcquireExclusiveLock grab(groupCommitLock_);
+        pendingOperations.swap(pendingGroupCommitOperations_);
+        isGroupCommitTimerSet_ = false;
+    }
+
+    GetPerfCounters().NumberOfPendingGroupCommitOperations.IncrementBy(-static_cast<LONGLONG>(pendingOperations.size()));
+    for (auto const & operation : pendingOperations)
+    {
+        operation->TryComplete(operation, ErrorCodeValue::ObjectClosed);
+    }
+
     store_->Terminate();
     store_->Drain();
 }
@@ -386,6 +624,11 @@ Common::AsyncOperationSPtr LocalStoreAdapter::BeginStoreOperation(
     Common::AsyncCallback const & callback,
     Common::AsyncOperationSPtr const & parent)
 {
+    if (ra_.Config.EnableStoreGroupCommit)
+    {
+        return Common::AsyncOperation::CreateAndStart<GroupCommitOperation>(*this, rowId, operationType, std::move(bytes), callback, parent);
+    }
+
     return Common::AsyncOperation::CreateAndStart<CommitAsyncOperation>(*this, rowId, operationType, std::move(bytes), Common::TimeSpan::MaxValue, callback, parent);
 }
 
@@ -394,6 +637,139 @@ Common::ErrorCode LocalStoreAdapter::EndStoreOperation(Common::AsyncOperationSPt
     return Common::AsyncOperation::End<Common::AsyncOperation>(operation)->Error;
 }
 
+void LocalStoreAdapter::EnqueueGroupCommitOperation(GroupCommitOperationSPtr const & operation)
+{
+    auto window = ra_.Config.StoreGroupCommitWindow;
+    bool startGroupCommit = false;
+    bool setTimer = false;
+
+    {
+        AcquireExclusiveLock grab(groupCommitLock_);
+
+        pendingGroupCommitOperations_.push_back(operation);
+        GetPerfCounters().NumberOfPendingGroupCommitOperations.Increment();
+
+        if (!isGroupCommitInProgress_)
+        {
+            if (window <= TimeSpan::Zero ||
+                !isOpen_.load() ||
+                static_cast<int>(pendingGroupCommitOperations_.size()) >= ra_.Config.MaxStoreGroupCommitBatchSize)
+            {
+                isGroupCommitInProgress_ = true;
+                startGroupCommit = true;
+            }
+            else if (!isGroupCommitTimerSet_)
+            {
+                isGroupCommitTimerSet_ = true;
+                setTimer = true;
+            }
+        }
+    }
+
+    if (startGroupCommit)
+    {
+        StartGroupCommit();
+    }
+    else if (setTimer)
+    {
+        groupCommitTimer_->Change(window);
+    }
+}
+
+void LocalStoreAdapter::OnGroupCommitTimerCallback()
+{
+    {
+        AcquireExclusiveLock grab(groupCommitLock_);
+
+        isGroupCommitTimerSet_ = false;
+
+        // The group commit in progress will pick up the pending operations when it completes
+        if (isGroupCommitInProgress_ || pendingGroupCommitOperations_.empty())
+        {
+            return;
+        }
+
+        isGroupCommitInProgress_ = true;
+    }
+
+    StartGroupCommit();
+}
+
+void LocalStoreAdapter::StartGroupCommit()
+{
+    for (;;)
+    {
+        std::vector<GroupCommitOperationSPtr> batch;
+
+        {
+            AcquireExclusiveLock grab(groupCommitLock_);
+            batch = TakeGroupCommitBatchUnderLock();
+        }
+
+        auto op = Common::AsyncOperation::CreateAndStart<GroupCommitBatchAsyncOperation>(
+            *this,
+            move(batch),
+            [this](AsyncOperationSPtr const & batchOp)
+            {
+                if (!batchOp->CompletedSynchronously && FinishGroupCommit(batchOp))
+                {
+                    StartGroupCommit();
+                }
+            },
+            ra_.Root.CreateAsyncOperationRoot());
+
+        // Loop instead of recursing if the commit completed synchronously
+        if (!op->CompletedSynchronously || !FinishGroupCommit(op))
+        {
+            return;
+        }
+    }
+}
+
+bool LocalStoreAdapter::FinishGroupCommit(AsyncOperationSPtr const & batchOperation)
+{
+    AsyncOperation::End<GroupCommitBatchAsyncOperation>(batchOperation);
+
+    AcquireExclusiveLock grab(groupCommitLock_);
+
+    // Operations that arrived while the commit was in flight have already waited
+    // at least one commit so they are started immediately
+    if (pendingGroupCommitOperations_.empty())
+    {
+        isGroupCommitInProgress_ = false;
+        return false;
+    }
+
+    return true;
+}
+
+std::vector<LocalStoreAdapter::GroupCommitOperationSPtr> LocalStoreAdapter::TakeGroupCommitBatchUnderLock()
+{
+    size_t maxBatchSize = static_cast<size_t>(max(ra_.Config.MaxStoreGroupCommitBatchSize, 1));
+
+    std::vector<GroupCommitOperationSPtr> batch;
+    std::set<std::wstring> ids;
+
+    /*
+        A row may appear only once in a batch 
+        The batch is ended at the second operation for the same row so that it is committed in a later transaction
+    */
+    while (!pendingGroupCommitOperations_.empty() && batch.size() < maxBatchSize)
+    {
+        auto const & operation = pendingGroupCommitOperations_.front();
+        if (!ids.insert(operation->Id.Id).second)
+        {
+            break;
+        }
+
+        batch.push_back(move(pendingGroupCommitOperations_.front()));
+        pendingGroupCommitOperations_.pop_front();
+    }
+
+    GetPerfCounters().NumberOfPendingGroupCommitOperations.IncrementBy(-static_cast<LONGLONG>(batch.size()));
+    return batch;
+}
+
 Common::ErrorCode LocalStoreAdapter::PerformOperationInternal(
     Store::IStoreBase::TransactionSPtr const & txPtr,
     OperationType::Enum operationType,
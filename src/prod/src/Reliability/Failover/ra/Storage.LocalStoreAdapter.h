@@ -51,8 +51,27 @@ namespace Reliability
                 ReconfigurationAgent & ra_;
 
                 class CommitAsyncOperation;
+                class GroupCommitOperation;
+                class GroupCommitBatchAsyncOperation;
                 class TransactionHolder;
 
+                typedef std::shared_ptr<GroupCommitOperation> GroupCommitOperationSPtr;
+
+                // Store operations that are waiting for the next group commit
+                // Only one group commit is in flight at a time so that the operations
+                // on a row are committed in the order in which they were started
+                Common::ExclusiveLock groupCommitLock_;
+                std::deque<GroupCommitOperationSPtr> pendingGroupCommitOperations_;
+                bool isGroupCommitInProgress_;
+                bool isGroupCommitTimerSet_;
+                Common::TimerSPtr groupCommitTimer_;
+
+                void EnqueueGroupCommitOperation(GroupCommitOperationSPtr const & operation);
+                void OnGroupCommitTimerCallback();
+                void StartGroupCommit();
+                bool FinishGroupCommit(Common::AsyncOperationSPtr const & batchOperation);
+                std::vector<GroupCommitOperationSPtr> TakeGroupCommitBatchUnderLock();
+
                 Infrastructure::IThreadpool & GetThreadpool();
                 Diagnostics::RAPerformanceCounters & GetPerfCounters();
 
@@ -24,6 +24,7 @@ namespace
     wstring const LodCtrPath = L"lodctr.exe";// L"C:\\windows\\system32\\lodctr.exe";
     wstring const UnLodCtrPath = L"lodctr.exe";// UnLodCtrPath;
     const int NumberOfPartitions = 1000 * 1000;
+    const int NumberOfReplicasToOpen = 1000;
 }
 
 class ManifestCopier
@@ -355,6 +356,8 @@ protected:
     void RunServiceTypeRegisteredPhase();
     void WaitForWorkToDrain(int expected);
 
+    TimeSpan MeasureOpenReplicas(int count);
+
     ScenarioTestHolderUPtr holder_;
     unique_ptr<TestEnvironment> testEnv_;
 };
@@ -496,10 +499,61 @@ void PerformanceTest::RunServiceTypeRegisteredPhase()
     WaitForWorkToDrain(2 * NumberOfPartitions);
 }
 
+TimeSpan PerformanceTest::MeasureOpenReplicas(int count)
+{
+    auto & perfCounters = GetScenarioTest().RA.PerfCounters;
+    auto requests = CreateRequests(count);
+
+    Stopwatch sw;
+    sw.Start();
+
+    ExecuteRequests(requests);
+
+    // Poll at a finer interval than WaitForWorkToDrain as the whole run takes a few seconds
+    for (int iteration = 0; iteration < 60 * 1000; ++iteration)
+    {
+        if (perfCounters.NumberOfCompletedJobItems.RawValue >= count)
+        {
+            sw.Stop();
+
+            TestLog::WriteInfo(wformatString(
+                "Opened {0} replicas in {1}ms. Store commits: {2}. Group commits: {3}. Commit failures: {4}",
+                count,
+                sw.ElapsedMilliseconds,
+                perfCounters.NumberOfStoreCommitsPerSecond.RawValue,
+                perfCounters.NumberOfStoreGroupCommitsPerSecond.RawValue,
+                perfCounters.NumberOfCommitFailures.RawValue));
+
+            ASSERT_IF(perfCounters.NumberOfCommitFailures.RawValue != 0, "Found commit failures");
+            return sw.Elapsed;
+        }
+
+        Sleep(10);
+    }
+
+    Assert::CodingError("Test did not stabilize");
+}
+
 BOOST_AUTO_TEST_SUITE(Functional)
 
 BOOST_FIXTURE_TEST_SUITE(PerformanceTestSuite, PerformanceTest)
 
+BOOST_AUTO_TEST_CASE(OpenReplicasWithGroupCommit)
+{
+    GetScenarioTest().UTContext.Config.EnableStoreGroupCommit = true;
+
+    auto elapsed = MeasureOpenReplicas(NumberOfReplicasToOpen);
+    TestLog::WriteInfo(wformatString("Measurement OpenReplicasWithGroupCommit: {0}ms", elapsed.TotalMilliseconds()));
+}
+
+BOOST_AUTO_TEST_CASE(OpenReplicasWithoutGroupCommit)
+{
+    GetScenarioTest().UTContext.Config.EnableStoreGroupCommit = false;
+
+    auto elapsed = MeasureOpenReplicas(NumberOfReplicasToOpen);
+    TestLog::WriteInfo(wformatString("Measurement OpenReplicasWithoutGroupCommit: {0}ms", elapsed.TotalMilliseconds()));
+}
+
 // BOOST_AUTO_TEST_CASE(PerformanceTest1)
 // {
 // TestLog::WriteInfo(L"Starting CreatePhase");
@@ -0,0 +1,270 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CompactLoadReport.h"
+
+using namespace std;
+using namespace Common;
+using namespace Reliability::LoadBalancingComponent;
+
+CompactLoadMetricStats::CompactLoadMetricStats()
+    : metricIndex_(0),
+    lastReportValue_(0),
+    count_(0),
+    weightedSum_(0.0),
+    sumOfWeight_(0.0),
+    lastReportTime_(StopwatchTime::Zero)
+{
+}
+
+CompactLoadMetricStats::CompactLoadMetricStats(uint metricIndex, LoadMetricStats const & stats)
+    : metricIndex_(metricIndex),
+    lastReportValue_(stats.LastReportValue),
+    count_(stats.Count),
+    weightedSum_(stats.WeightedSum),
+    sumOfWeight_(stats.SumOfWeight),
+    lastReportTime_(stats.LastReportTime)
+{
+}
+
+LoadMetricStats CompactLoadMetricStats::ToLoadMetricStats(vector<wstring> const & metricNames) const
+{
+    return LoadMetricStats(wstring(metricNames[metricIndex_]), lastReportValue_, lastReportTime_, count_, weightedSum_, sumOfWeight_);
+}
+
+CompactNodeLoadMetricStats::CompactNodeLoadMetricStats()
+    : nodeIndex_(0),
+    entries_()
+{
+}
+
+CompactNodeLoadMetricStats::CompactNodeLoadMetricStats(uint nodeIndex, vector<CompactLoadMetricStats> && entries)
+    : nodeIndex_(nodeIndex),
+    entries_(move(entries))
+{
+}
+
+CompactLoadOrMoveCostDescription::CompactLoadOrMoveCostDescription()
+    : failoverUnitId_(Guid::Empty()),
+    serviceIndex_(0),
+    isStateful_(false),
+    primaryEntries_(),
+    secondaryEntries_(),
+    secondaryEntriesMap_(),
+    isSecondaryFromNodeMap_(false)
+{
+}
+
+CompactLoadReport::CompactLoadReport()
+    : metricNames_(),
+    serviceNames_(),
+    nodeIds_(),
+    entries_()
+{
+}
+
+CompactLoadReport::CompactLoadReport(vector<LoadOrMoveCostDescription> && reports)
+    : metricNames_(),
+    serviceNames_(),
+    nodeIds_(),
+    entries_()
+{
+    map<wstring, uint> metricIndexes;
+    map<wstring, uint> serviceIndexes;
+    map<Federation::NodeId, uint> nodeIndexes;
+
+    entries_.reserve(reports.size());
+
+    for (auto it = reports.begin(); it != reports.end(); ++it)
+    {
+        CompactLoadOrMoveCostDescription entry;
+        entry.failoverUnitId_ = it->FailoverUnitId;
+        entry.serviceIndex_ = GetOrAddIndex(it->ServiceName, serviceIndexes, serviceNames_);
+        entry.isStateful_ = it->IsStateful;
+
+        if (it->IsStateful)
+        {
+            entry.primaryEntries_ = Compact(it->PrimaryEntries, metricIndexes);
+        }
+
+        auto const & secondaryEntriesMap = it->SecondaryEntriesMap;
+        for (auto nodeIt = secondaryEntriesMap.begin(); nodeIt != secondaryEntriesMap.end(); ++nodeIt)
+        {
+            entry.secondaryEntriesMap_.push_back(CompactNodeLoadMetricStats(
+                GetOrAddIndex(nodeIt->first, nodeIndexes, nodeIds_),
+                Compact(nodeIt->second, metricIndexes)));
+        }
+
+        if (secondaryEntriesMap.size() == 1 && AreSame(it->SecondaryEntries, secondaryEntriesMap.begin()->second))
+        {
+            entry.isSecondaryFromNodeMap_ = true;
+        }
+        else
+        {
+            entry.secondaryEntries_ = Compact(it->SecondaryEntries, metricIndexes);
+        }
+
+        entries_.push_back(move(entry));
+    }
+
+    reports.clear();
+}
+
+CompactLoadReport::CompactLoadReport(CompactLoadReport && other)
+    : metricNames_(move(other.metricNames_)),
+    serviceNames_(move(other.serviceNames_)),
+    nodeIds_(move(other.nodeIds_)),
+    entries_(move(other.entries_))
+{
+}
+
+CompactLoadReport & CompactLoadReport::operator=(CompactLoadReport && other)
+{
+    if (this != &other)
+    {
+        metricNames_ = move(other.metricNames_);
+        serviceNames_ = move(other.serviceNames_);
+        nodeIds_ = move(other.nodeIds_);
+        entries_ = move(other.entries_);
+    }
+
+    return *this;
+}
+
+bool CompactLoadReport::TryExpand(__inout vector<LoadOrMoveCostDescription> & reports)
+{
+    reports.reserve(reports.size() + entries_.size());
+
+    bool isValid = true;
+    for (auto it = entries_.begin(); it != entries_.end() && isValid; ++it)
+    {
+        vector<LoadMetricStats> primaryEntries;
+        vector<LoadMetricStats> secondaryEntries;
+        map<Federation::NodeId, vector<LoadMetricStats>> secondaryEntriesMap;
+
+        isValid =
+            it->serviceIndex_ < serviceNames_.size() &&
+            TryExpand(it->primaryEntries_, primaryEntries) &&
+            TryExpand(it->secondaryEntries_, secondaryEntries);
+
+        for (auto nodeIt = it->secondaryEntriesMap_.begin(); nodeIt != it->secondaryEntriesMap_.end() && isValid; ++nodeIt)
+        {
+            vector<LoadMetricStats> nodeEntries;
+            isValid = nodeIt->NodeIndex < nodeIds_.size() && TryExpand(nodeIt->Entries, nodeEntries);
+
+            if (isValid)
+            {
+                secondaryEntriesMap[nodeIds_[nodeIt->NodeIndex]] = move(nodeEntries);
+            }
+        }
+
+        if (isValid && it->isSecondaryFromNodeMap_)
+        {
+            isValid = secondaryEntriesMap.size() == 1;
+
+            if (isValid)
+            {
+                secondaryEntries = secondaryEntriesMap.begin()->second;
+            }
+        }
+
+        if (isValid)
+        {
+            reports.push_back(LoadOrMoveCostDescription(
+                it->failoverUnitId_,
+                wstring(serviceNames_[it->serviceIndex_]),
+                it->isStateful_,
+                move(primaryEntries),
+                move(secondaryEntries),
+                move(secondaryEntriesMap)));
+        }
+    }
+
+    metricNames_.clear();
+    serviceNames_.clear();
+    nodeIds_.clear();
+    entries_.clear();
+
+    return isValid;
+}
+
+void CompactLoadReport::WriteTo(TextWriter& writer, FormatOptions const&) const
+{
+    writer.Write("Reports:{0} Metrics:{1} Services:{2} Nodes:{3}", entries_.size(), metricNames_, serviceNames_.size(), nodeIds_.size());
+}
+
+//------------------------------------------------------------
+// private members
+//------------------------------------------------------------
+
+template <typename T>
+uint CompactLoadReport::GetOrAddIndex(T const & value, __inout map<T, uint> & indexes, __inout vector<T> & values)
+{
+    auto it = indexes.find(value);
+    if (it == indexes.end())
+    {
+        it = indexes.insert(make_pair(value, static_cast<uint>(values.size()))).first;
+        values.push_back(value);
+    }
+
+    return it->second;
+}
+
+vector<CompactLoadMetricStats> CompactLoadReport::Compact(vector<LoadMetricStats> const & entries, __inout map<wstring, uint> & metricIndexes)
+{
+    vector<CompactLoadMetricStats> result;
+    result.reserve(entries.size());
+
+    for (auto it = entries.begin(); it != entries.end(); ++it)
+    {
+        result.push_back(CompactLoadMetricStats(GetOrAddIndex(it->Name, metricIndexes, metricNames_), *it));
+    }
+
+    return result;
+}
+
+bool CompactLoadReport::TryExpand(vector<CompactLoadMetricStats> const & entries, __out vector<LoadMetricStats> & result) const
+{
+    result.reserve(entries.size());
+
+    for (auto it = entries.begin(); it != entries.end(); ++it)
+    {
+        if (it->MetricIndex >= metricNames_.size())
+        {
+            return false;
+        }
+
+        result.push_back(it->ToLoadMetricStats(metricNames_));
+    }
+
+    return true;
+}
+
+bool CompactLoadReport::AreSame(vector<LoadMetricStats> const & left, vector<LoadMetricStats> const & right)
+{
+    if (left.size() != right.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < left.size(); ++i)
+    {
+        LoadMetricStats const & l = left[i];
+        LoadMetricStats const & r = right[i];
+
+        if (l.Name != r.Name ||
+            l.LastReportValue != r.LastReportValue ||
+            l.LastReportTime != r.LastReportTime ||
+            l.Count != r.Count ||
+            l.WeightedSum != r.WeightedSum ||
+            l.SumOfWeight != r.SumOfWeight)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,138 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+#include "LoadMetricStats.h"
+#include "LoadOrMoveCostDescription.h"
+
+namespace Reliability
+{
+    namespace LoadBalancingComponent
+    {
+        // Load metric statistics where the metric name is replaced by an index into the metric name dictionary of the report
+        class CompactLoadMetricStats : public Serialization::FabricSerializable
+        {
+        public:
+            CompactLoadMetricStats();
+
+            CompactLoadMetricStats(uint metricIndex, LoadMetricStats const & stats);
+
+            __declspec (property(get=get_MetricIndex)) uint MetricIndex;
+            uint get_MetricIndex() const { return metricIndex_; }
+
+            LoadMetricStats ToLoadMetricStats(std::vector<std::wstring> const & metricNames) const;
+
+            FABRIC_FIELDS_06(metricIndex_, lastReportValue_, count_, weightedSum_, sumOfWeight_, lastReportTime_);
+
+        private:
+            uint metricIndex_;
+            uint lastReportValue_;
+            uint count_;
+            double weightedSum_;
+            double sumOfWeight_;
+            Common::StopwatchTime lastReportTime_;
+        };
+
+        class CompactNodeLoadMetricStats : public Serialization::FabricSerializable
+        {
+        public:
+            CompactNodeLoadMetricStats();
+
+            CompactNodeLoadMetricStats(uint nodeIndex, std::vector<CompactLoadMetricStats> && entries);
+
+            __declspec (property(get=get_NodeIndex)) uint NodeIndex;
+            uint get_NodeIndex() const { return nodeIndex_; }
+
+            __declspec (property(get=get_Entries)) std::vector<CompactLoadMetricStats> const & Entries;
+            std::vector<CompactLoadMetricStats> const & get_Entries() const { return entries_; }
+
+            FABRIC_FIELDS_02(nodeIndex_, entries_);
+
+        private:
+            uint nodeIndex_;
+            std::vector<CompactLoadMetricStats> entries_;
+        };
+
+        class CompactLoadOrMoveCostDescription : public Serialization::FabricSerializable
+        {
+        public:
+            CompactLoadOrMoveCostDescription();
+
+            __declspec (property(get=get_FailoverUnitId)) Common::Guid FailoverUnitId;
+            Common::Guid get_FailoverUnitId() const { return failoverUnitId_; }
+
+            FABRIC_FIELDS_07(failoverUnitId_, serviceIndex_, isStateful_, primaryEntries_, secondaryEntries_, secondaryEntriesMap_, isSecondaryFromNodeMap_);
+
+        private:
+            friend class CompactLoadReport;
+
+            Common::Guid failoverUnitId_;
+            uint serviceIndex_;
+            bool isStateful_;
+            std::vector<CompactLoadMetricStats> primaryEntries_;
+            std::vector<CompactLoadMetricStats> secondaryEntries_;
+            std::vector<CompactNodeLoadMetricStats> secondaryEntriesMap_;
+
+            // RA keeps the secondary entries both in the list and in the per node map,
+            // in that case the list is not sent and is restored from the only node in the map
+            bool isSecondaryFromNodeMap_;
+        };
+    }
+}
+
+DEFINE_USER_ARRAY_UTILITY(Reliability::LoadBalancingComponent::CompactLoadMetricStats);
+DEFINE_USER_ARRAY_UTILITY(Reliability::LoadBalancingComponent::CompactNodeLoadMetricStats);
+DEFINE_USER_ARRAY_UTILITY(Reliability::LoadBalancingComponent::CompactLoadOrMoveCostDescription);
+
+namespace Reliability
+{
+    namespace LoadBalancingComponent
+    {
+        // A batch of load reports where metric names, service names and node ids are sent once
+        // in a dictionary and each load report refers to them by index
+        class CompactLoadReport : public Serialization::FabricSerializable
+        {
+            DENY_COPY(CompactLoadReport);
+
+        public:
+            CompactLoadReport();
+
+            explicit CompactLoadReport(std::vector<LoadOrMoveCostDescription> && reports);
+
+            CompactLoadReport(CompactLoadReport && other);
+
+            CompactLoadReport & operator=(CompactLoadReport && other);
+
+            __declspec (property(get=get_IsEmpty)) bool IsEmpty;
+            bool get_IsEmpty() const { return entries_.empty(); }
+
+            __declspec (property(get=get_Count)) size_t Count;
+            size_t get_Count() const { return entries_.size(); }
+
+            // Moves the load reports out of the batch, the batch is empty afterwards.
+            // Returns false if the batch refers to a dictionary entry that does not exist.
+            bool TryExpand(__inout std::vector<LoadOrMoveCostDescription> & reports);
+
+            void WriteTo(Common::TextWriter& writer, Common::FormatOptions const&) const;
+
+            FABRIC_FIELDS_04(metricNames_, serviceNames_, nodeIds_, entries_);
+
+        private:
+            template <typename T>
+            static uint GetOrAddIndex(T const & value, __inout std::map<T, uint> & indexes, __inout std::vector<T> & values);
+
+            std::vector<CompactLoadMetricStats> Compact(std::vector<LoadMetricStats> const & entries, __inout std::map<std::wstring, uint> & metricIndexes);
+            bool TryExpand(std::vector<CompactLoadMetricStats> const & entries, __out std::vector<LoadMetricStats> & result) const;
+
+            static bool AreSame(std::vector<LoadMetricStats> const & left, std::vector<LoadMetricStats> const & right);
+
+            std::vector<std::wstring> metricNames_;
+            std::vector<std::wstring> serviceNames_;
+            std::vector<Federation::NodeId> nodeIds_;
+            std::vector<CompactLoadOrMoveCostDescription> entries_;
+        };
+    }
+}
@@ -59,6 +59,7 @@ namespace Reliability
             virtual void DeleteFailoverUnit(std::wstring && serviceName, Common::Guid fuId) = 0;
 
             virtual void UpdateLoadOrMoveCost(LoadOrMoveCostDescription && loadOrMoveCost) = 0;
+            virtual void UpdateLoadOrMoveCosts(std::vector<LoadOrMoveCostDescription> && loadOrMoveCosts) = 0;
             virtual Common::ErrorCode ResetPartitionLoad(FailoverUnitId const & failoverUnitId, std::wstring const & serviceName, bool isStateful) = 0;
 
             virtual Common::ErrorCode UpdateApplication(ApplicationDescription && applicationDescription, bool forceUpdate = false) = 0;
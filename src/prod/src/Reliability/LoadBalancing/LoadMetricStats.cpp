@@ -26,6 +26,22 @@ LoadMetricStats::LoadMetricStats(std::wstring && name, uint value, StopwatchTime
 {
 }
 
+LoadMetricStats::LoadMetricStats(
+    std::wstring && name,
+    uint lastReportValue,
+    StopwatchTime lastReportTime,
+    uint count,
+    double weightedSum,
+    double sumOfWeight)
+    : name_(move(name)),
+    lastReportValue_(lastReportValue),
+    lastReportTime_(lastReportTime),
+    count_(count),
+    weightedSum_(weightedSum),
+    sumOfWeight_(sumOfWeight)
+{
+}
+
 LoadMetricStats::LoadMetricStats(LoadMetricStats && other)
     : name_(move(other.name_)), 
     lastReportValue_(other.lastReportValue_), 
@@ -17,6 +17,15 @@ namespace Reliability
 
             LoadMetricStats(std::wstring && name, uint value, Common::StopwatchTime timestamp);
 
+            // restores all the statistics, used when expanding a compact load report
+            LoadMetricStats(
+                std::wstring && name,
+                uint lastReportValue,
+                Common::StopwatchTime lastReportTime,
+                uint count,
+                double weightedSum,
+                double sumOfWeight);
+
             LoadMetricStats(LoadMetricStats && other);
 
             LoadMetricStats(LoadMetricStats const& other);
@@ -35,6 +44,18 @@ namespace Reliability
             __declspec (property(get=get_Value)) uint Value;
             uint get_Value() const;
 
+            __declspec (property(get=get_LastReportValue)) uint LastReportValue;
+            uint get_LastReportValue() const { return lastReportValue_; }
+
+            __declspec (property(get=get_Count)) uint Count;
+            uint get_Count() const { return count_; }
+
+            __declspec (property(get=get_WeightedSum)) double WeightedSum;
+            double get_WeightedSum() const { return weightedSum_; }
+
+            __declspec (property(get=get_SumOfWeight)) double SumOfWeight;
+            double get_SumOfWeight() const { return sumOfWeight_; }
+
             void AdjustTimestamp(Common::TimeSpan diff);
 
             bool Update(uint value, Common::StopwatchTime timestamp);
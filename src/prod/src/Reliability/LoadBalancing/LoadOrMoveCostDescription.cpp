@@ -34,6 +34,23 @@ LoadOrMoveCostDescription::LoadOrMoveCostDescription(
 {
 }
 
+LoadOrMoveCostDescription::LoadOrMoveCostDescription(
+    Guid failoverUnitId,
+    wstring && serviceName,
+    bool isStateful,
+    vector<LoadMetricStats> && primaryEntries,
+    vector<LoadMetricStats> && secondaryEntries,
+    map<Federation::NodeId, vector<LoadMetricStats>> && secondaryEntriesMap) :
+    failoverUnitId_(failoverUnitId),
+    serviceName_(move(serviceName)),
+    isStateful_(isStateful),
+    isReset_(false),
+    primaryEntries_(move(primaryEntries)),
+    secondaryEntries_(move(secondaryEntries)),
+    secondaryEntriesMap_(move(secondaryEntriesMap))
+{
+}
+
 LoadOrMoveCostDescription::LoadOrMoveCostDescription(LoadOrMoveCostDescription && other) :
     failoverUnitId_(other.failoverUnitId_),
     serviceName_(move(other.serviceName_)),
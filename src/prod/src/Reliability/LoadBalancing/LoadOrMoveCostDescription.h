@@ -28,6 +28,14 @@ namespace Reliability
                 bool isStateful,
                 bool isReset = false);
 
+            LoadOrMoveCostDescription(
+                Common::Guid failoverUnitId,
+                std::wstring && serviceName,
+                bool isStateful,
+                std::vector<LoadMetricStats> && primaryEntries,
+                std::vector<LoadMetricStats> && secondaryEntries,
+                std::map<Federation::NodeId, std::vector<LoadMetricStats>> && secondaryEntriesMap);
+
             LoadOrMoveCostDescription(LoadOrMoveCostDescription && other);
 
             LoadOrMoveCostDescription & operator=(LoadOrMoveCostDescription && other);
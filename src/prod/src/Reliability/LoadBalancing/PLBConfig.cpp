@@ -12,6 +12,13 @@ using namespace Reliability::LoadBalancingComponent;
 
 DEFINE_SINGLETON_COMPONENT_CONFIG(PLBConfig)
 
+bool PLBConfig::OnUpdate(std::wstring const & section, std::wstring const & key)
+{
+    bool retval = this->ComponentConfig::OnUpdate(section, key);
+    ++updateVersion_;
+    return retval;
+}
+
 PLBConfig::KeyDoubleValueMap PLBConfig::KeyDoubleValueMap::Parse(StringMap const & entries)
 {
     KeyDoubleValueMap result;
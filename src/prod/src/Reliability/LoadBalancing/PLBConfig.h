@@ -595,6 +595,23 @@ namespace Reliability
 
             // Determines how often statistics are traced out.
             INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"PlacementAndLoadBalancing", StatisticsTracingInterval, Common::TimeSpan::FromSeconds(60.0), Common::ConfigEntryUpgradePolicy::Dynamic);
+
+            // Determines if the snapshot of a service domain that did not change since the previous refresh is reused instead of taken again.
+            INTERNAL_CONFIG_ENTRY(bool, L"PlacementAndLoadBalancing", UseIncrementalSnapshot, true, Common::ConfigEntryUpgradePolicy::Dynamic);
+
+            // Interval after which the snapshots of all service domains are taken again, even if the domains did not change.
+            INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"PlacementAndLoadBalancing", FullSnapshotInterval, Common::TimeSpan::FromSeconds(300.0), Common::ConfigEntryUpgradePolicy::Dynamic);
+
+            virtual bool OnUpdate(std::wstring const & section, std::wstring const & key);
+
+            // Incremented on each dynamic update, so that state derived from the configuration can be rebuilt
+            __declspec(property(get=get_UpdateVersion)) uint64 UpdateVersion;
+            uint64 get_UpdateVersion() const { return updateVersion_.load(); }
+
+            void Test_IncrementUpdateVersion() { ++updateVersion_; }
+
+        private:
+            Common::atomic_uint64 updateVersion_;
         };
     }
 }
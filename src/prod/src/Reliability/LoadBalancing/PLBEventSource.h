@@ -93,7 +93,7 @@ namespace Reliability
             DECLARE_STRUCTURED_TRACE(SplitServiceDomainStart, std::wstring, size_t);
             DECLARE_STRUCTURED_TRACE(SplitServiceDomainEnd, std::wstring, size_t);
             DECLARE_STRUCTURED_TRACE(SnapshotStart);
-            DECLARE_STRUCTURED_TRACE(SnapshotEnd, int64);
+            DECLARE_STRUCTURED_TRACE(SnapshotEnd, int64, uint64, uint64);
             DECLARE_STRUCTURED_TRACE(SearchForUpgradeUnsucess, Common::Guid, std::wstring);
             DECLARE_STRUCTURED_TRACE(Scheduler, std::wstring, std::wstring);
             DECLARE_STRUCTURED_TRACE(FailoverUnitNotFound, Common::Guid);
@@ -225,7 +225,7 @@ namespace Reliability
                 PLB_STRUCTURED_TRACE(SplitServiceDomainStart, 58, Info, "Split Service Domain Start for Domain: {0}, Total Service Domain Count: {1}", "id", "count"),
                 PLB_STRUCTURED_TRACE(SplitServiceDomainEnd, 59, Info, "Split Service Domain End for Domain: {0}, Total Service Domain Count: {1}", "id", "count"),
                 PLB_STRUCTURED_TRACE(SnapshotStart, 60, Info, "Taking snapshot begin."),
-                PLB_STRUCTURED_TRACE(SnapshotEnd, 61, Info, "Taking snapshot end. Total ms: {0}", "timeSpent"),
+                PLB_STRUCTURED_TRACE(SnapshotEnd, 61, Info, "Taking snapshot end. Total ms: {0} Taken domains: {1} Reused domains: {2}", "timeSpent", "takenDomains", "reusedDomains"),
                 PLB_STRUCTURED_TRACE(SearchForUpgradeUnsucess, 62, Warning, "SearchForUpgrade: Did not find a solution for partition {0} with flag {1}", "partition", "flag"),
                 PLB_STRUCTURED_TRACE(Scheduler, 63, Info, "{1}", "id", "event"),
                 PLB_STRUCTURED_TRACE(FailoverUnitNotFound, 64, Warning, "FailoverUnit {0} not found", "failoverUnitId"),
@@ -0,0 +1,300 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+#include "TestUtility.h"
+#include "TestFM.h"
+#include "PLBConfig.h"
+#include "PlacementAndLoadBalancing.h"
+#include "CompactLoadReport.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+namespace PlacementAndLoadBalancingUnitTest
+{
+    using namespace std;
+    using namespace Common;
+    using namespace Federation;
+    using namespace Reliability::LoadBalancingComponent;
+
+    StringLiteral const PLBLoadReportTestSource("PLBLoadReportTestSource");
+
+    // Same layout as the reports sent in ReportLoadMessageBody before the compact form
+    class LegacyLoadReport : public Serialization::FabricSerializable
+    {
+    public:
+        LegacyLoadReport() {}
+
+        vector<LoadOrMoveCostDescription> Reports;
+
+        FABRIC_FIELDS_01(Reports);
+    };
+
+    class TestPLBLoadReport
+    {
+    protected:
+        TestPLBLoadReport() {
+            BOOST_REQUIRE(ClassSetup());
+            BOOST_REQUIRE(TestSetup());
+        }
+
+        ~TestPLBLoadReport()
+        {
+            BOOST_REQUIRE(ClassCleanup());
+        }
+
+        TEST_CLASS_SETUP(ClassSetup);
+        TEST_CLASS_CLEANUP(ClassCleanup);
+        TEST_METHOD_SETUP(TestSetup);
+
+        static wstring GetMetricName(int metric)
+        {
+            return wformatString("CustomMetricNumber{0}", metric);
+        }
+
+        // Load reports of one node as RA aggregates them: half of the replicas are primaries
+        static vector<LoadOrMoveCostDescription> CreateNodeLoadReports(
+            wstring const & serviceName,
+            int replicaCount,
+            NodeId const & nodeId,
+            uint loadOffset,
+            int changedMetricCount)
+        {
+            vector<LoadOrMoveCostDescription> reports;
+            reports.reserve(replicaCount);
+
+            StopwatchTime now = Stopwatch::Now();
+            for (int replica = 0; replica < replicaCount; ++replica)
+            {
+                vector<LoadMetric> loads;
+                for (int metric = 0; metric < changedMetricCount; ++metric)
+                {
+                    loads.push_back(LoadMetric(GetMetricName(metric), replica % 100 + metric + loadOffset));
+                }
+
+                LoadOrMoveCostDescription report(CreateGuid(replica), wstring(serviceName), true);
+                report.MergeLoads(replica % 2 == 0 ? ReplicaRole::Primary : ReplicaRole::Secondary, move(loads), now, true, nodeId);
+                reports.push_back(move(report));
+            }
+
+            return reports;
+        }
+
+        static size_t GetLegacySize(vector<LoadOrMoveCostDescription> const & reports)
+        {
+            LegacyLoadReport legacy;
+            legacy.Reports = reports;
+
+            vector<byte> buffer;
+            VERIFY_IS_TRUE(FabricSerializer::Serialize(&legacy, buffer).IsSuccess());
+            return buffer.size();
+        }
+
+        static size_t GetCompactSize(vector<LoadOrMoveCostDescription> const & reports)
+        {
+            vector<LoadOrMoveCostDescription> copy = reports;
+            CompactLoadReport compact(move(copy));
+
+            vector<byte> buffer;
+            VERIFY_IS_TRUE(FabricSerializer::Serialize(&compact, buffer).IsSuccess());
+            return buffer.size();
+        }
+
+        static void VerifyStats(vector<LoadMetricStats> const & expected, vector<LoadMetricStats> const & actual)
+        {
+            VERIFY_ARE_EQUAL(expected.size(), actual.size());
+            for (size_t i = 0; i < expected.size(); ++i)
+            {
+                VERIFY_ARE_EQUAL(expected[i].Name, actual[i].Name);
+                VERIFY_ARE_EQUAL(expected[i].LastReportValue, actual[i].LastReportValue);
+                VERIFY_ARE_EQUAL(expected[i].LastReportTime, actual[i].LastReportTime);
+                VERIFY_ARE_EQUAL(expected[i].Count, actual[i].Count);
+                VERIFY_ARE_EQUAL(expected[i].WeightedSum, actual[i].WeightedSum);
+                VERIFY_ARE_EQUAL(expected[i].SumOfWeight, actual[i].SumOfWeight);
+            }
+        }
+
+        shared_ptr<TestFM> fm_;
+    };
+
+    BOOST_FIXTURE_TEST_SUITE(TestPLBLoadReportSuite, TestPLBLoadReport)
+
+    BOOST_AUTO_TEST_CASE(CompactLoadReportRoundTrip)
+    {
+        vector<LoadOrMoveCostDescription> reports;
+
+        // Stateful with primary load and secondary loads on two nodes
+        map<NodeId, uint> secondaryLoads;
+        secondaryLoads.insert(make_pair(CreateNodeId(1), 10));
+        secondaryLoads.insert(make_pair(CreateNodeId(2), 20));
+        reports.push_back(CreateLoadOrMoveCost(0, L"fabric:/Service0", L"MetricA", 30, secondaryLoads));
+
+        // Stateless reported by RA, list and per node map hold the same entries
+        reports.push_back(CreateLoadOrMoveCost(1, L"fabric:/Service1", L"MetricA", 40, map<NodeId, uint>(), false));
+        {
+            vector<LoadMetric> loads;
+            loads.push_back(LoadMetric(L"MetricB", 50));
+            reports.back().MergeLoads(ReplicaRole::Secondary, move(loads), Stopwatch::Now(), true, CreateNodeId(3));
+        }
+
+        // Stateful from the same service with secondary load without a node
+        reports.push_back(CreateLoadOrMoveCost(2, L"fabric:/Service0", L"MetricB", 60, 70));
+
+        vector<LoadOrMoveCostDescription> expected = reports;
+
+        CompactLoadReport compact(move(reports));
+        VERIFY_ARE_EQUAL(3u, compact.Count);
+
+        vector<byte> buffer;
+        VERIFY_IS_TRUE(FabricSerializer::Serialize(&compact, buffer).IsSuccess());
+
+        CompactLoadReport received;
+        VERIFY_IS_TRUE(FabricSerializer::Deserialize(received, buffer).IsSuccess());
+
+        vector<LoadOrMoveCostDescription> actual;
+        VERIFY_IS_TRUE(received.TryExpand(actual));
+        VERIFY_IS_TRUE(received.IsEmpty);
+        VERIFY_ARE_EQUAL(expected.size(), actual.size());
+
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            VERIFY_ARE_EQUAL(expected[i].FailoverUnitId, actual[i].FailoverUnitId);
+            VERIFY_ARE_EQUAL(expected[i].ServiceName, actual[i].ServiceName);
+            VERIFY_ARE_EQUAL(expected[i].IsStateful, actual[i].IsStateful);
+
+            if (expected[i].IsStateful)
+            {
+                VerifyStats(expected[i].PrimaryEntries, actual[i].PrimaryEntries);
+            }
+
+            VerifyStats(expected[i].SecondaryEntries, actual[i].SecondaryEntries);
+
+            VERIFY_ARE_EQUAL(expected[i].SecondaryEntriesMap.size(), actual[i].SecondaryEntriesMap.size());
+            for (auto it = expected[i].SecondaryEntriesMap.begin(); it != expected[i].SecondaryEntriesMap.end(); ++it)
+            {
+                auto actualIt = actual[i].SecondaryEntriesMap.find(it->first);
+                VERIFY_IS_TRUE(actualIt != actual[i].SecondaryEntriesMap.end());
+                VerifyStats(it->second, actualIt->second);
+            }
+        }
+    }
+
+    //
+    // Measures the bytes sent from one node to FM and the FM side cost of handing the loads to PLB
+    // for 10K replicas with 5 metrics each, for the full report and for a delta where one metric changed.
+    //
+    BOOST_AUTO_TEST_CASE(LoadReportSizeAndApplyCost10K)
+    {
+        int const replicaCount = 10000;
+        int const metricCount = 5;
+        wstring serviceName(L"fabric:/LoadReportApplication/LoadReportService");
+        wstring serviceType(L"LoadReportServiceType");
+
+        PlacementAndLoadBalancing & plb = fm_->PLB;
+
+        plb.UpdateNode(CreateNodeDescription(0));
+        plb.UpdateNode(CreateNodeDescription(1));
+        plb.UpdateServiceType(ServiceTypeDescription(wstring(serviceType), set<NodeId>()));
+
+        wstring metrics;
+        for (int metric = 0; metric < metricCount; ++metric)
+        {
+            metrics += wformatString("{0}{1}/1.0/10/10", metric == 0 ? L"" : L",", GetMetricName(metric));
+        }
+
+        plb.UpdateService(CreateServiceDescription(wstring(serviceName), wstring(serviceType), true, CreateMetrics(metrics)));
+
+        for (int replica = 0; replica < replicaCount; ++replica)
+        {
+            plb.UpdateFailoverUnit(FailoverUnitDescription(CreateGuid(replica), wstring(serviceName), 0, CreateReplicas(replica % 2 == 0 ? L"P/0, S/1" : L"P/1, S/0"), 0));
+        }
+
+        plb.ProcessPendingUpdatesPeriodicTask();
+
+        auto fullReports = CreateNodeLoadReports(serviceName, replicaCount, CreateNodeId(0), 0, metricCount);
+        auto deltaReports = CreateNodeLoadReports(serviceName, replicaCount, CreateNodeId(0), 1, 1);
+
+        size_t legacyFullSize = GetLegacySize(fullReports);
+        size_t compactFullSize = GetCompactSize(fullReports);
+        size_t legacyDeltaSize = GetLegacySize(deltaReports);
+        size_t compactDeltaSize = GetCompactSize(deltaReports);
+
+        Trace.WriteInfo(
+            PLBLoadReportTestSource,
+            "Bytes for {0} replicas x {1} metrics: legacy={2} compact={3}; one changed metric: legacy={4} compact={5}",
+            replicaCount,
+            metricCount,
+            legacyFullSize,
+            compactFullSize,
+            legacyDeltaSize,
+            compactDeltaSize);
+
+        VERIFY_IS_TRUE(compactFullSize < legacyFullSize);
+        VERIFY_IS_TRUE(compactDeltaSize < legacyDeltaSize);
+        VERIFY_IS_TRUE(legacyDeltaSize < legacyFullSize);
+
+        // FM: one PLB call per failover unit
+        vector<LoadOrMoveCostDescription> perCallReports = fullReports;
+        Stopwatch perCallStopwatch;
+        perCallStopwatch.Start();
+        for (auto it = perCallReports.begin(); it != perCallReports.end(); ++it)
+        {
+            plb.UpdateLoadOrMoveCost(move(*it));
+        }
+        perCallStopwatch.Stop();
+
+        plb.ProcessPendingUpdatesPeriodicTask();
+
+        // FM: compact message expanded and handed to PLB in one call
+        vector<LoadOrMoveCostDescription> batchReports = fullReports;
+        CompactLoadReport compact(move(batchReports));
+
+        Stopwatch batchStopwatch;
+        batchStopwatch.Start();
+        vector<LoadOrMoveCostDescription> expanded;
+        VERIFY_IS_TRUE(compact.TryExpand(expanded));
+        VERIFY_ARE_EQUAL(static_cast<size_t>(replicaCount), expanded.size());
+        plb.UpdateLoadOrMoveCosts(move(expanded));
+        batchStopwatch.Stop();
+
+        plb.ProcessPendingUpdatesPeriodicTask();
+
+        Trace.WriteInfo(
+            PLBLoadReportTestSource,
+            "FM apply for {0} replicas: per call={1}us batched (including expand)={2}us",
+            replicaCount,
+            perCallStopwatch.ElapsedMicroseconds,
+            batchStopwatch.ElapsedMicroseconds);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+
+    bool TestPLBLoadReport::ClassSetup()
+    {
+        Trace.WriteInfo(PLBLoadReportTestSource, "Random seed: {0}", PLBConfig::GetConfig().InitialRandomSeed);
+
+        fm_ = make_shared<TestFM>();
+
+        return TRUE;
+    }
+
+    bool TestPLBLoadReport::TestSetup()
+    {
+        fm_->Load();
+
+        return TRUE;
+    }
+
+    bool TestPLBLoadReport::ClassCleanup()
+    {
+        Trace.WriteInfo(PLBLoadReportTestSource, "Cleaning up the class.");
+
+        // Dispose PLB
+        fm_->PLBTestHelper.Dispose();
+
+        return TRUE;
+    }
+}
@@ -0,0 +1,333 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+#include "TestUtility.h"
+#include "TestFM.h"
+#include "PLBConfig.h"
+#include "PlacementAndLoadBalancing.h"
+#include "PlacementAndLoadBalancingTestHelper.h"
+
+#if defined(PLATFORM_UNIX)
+#include <malloc.h>
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+namespace PlacementAndLoadBalancingUnitTest
+{
+    using namespace std;
+    using namespace Common;
+    using namespace Federation;
+    using namespace Reliability::LoadBalancingComponent;
+
+    StringLiteral const PLBSnapshotTestSource("PLBSnapshotTestSource");
+
+    class TestPLBSnapshot
+    {
+    protected:
+        TestPLBSnapshot() {
+            BOOST_REQUIRE(ClassSetup());
+            BOOST_REQUIRE(TestSetup());
+        }
+
+        ~TestPLBSnapshot()
+        {
+            BOOST_REQUIRE(ClassCleanup());
+        }
+
+        TEST_CLASS_SETUP(ClassSetup);
+        TEST_CLASS_CLEANUP(ClassCleanup);
+        TEST_METHOD_SETUP(TestSetup);
+
+        static wstring GetServiceName(int domain)
+        {
+            return wformatString("fabric:/SnapshotService{0}", domain);
+        }
+
+        static wstring GetMetricName(int domain)
+        {
+            return wformatString("SnapshotMetric{0}", domain);
+        }
+
+        // Each service has its own metric so each of them ends up in a separate service domain
+        static void CreateDomains(PlacementAndLoadBalancing & plb, int domainCount, int partitionsPerDomain, int nodeCount)
+        {
+            for (int node = 0; node < nodeCount; ++node)
+            {
+                plb.UpdateNode(CreateNodeDescription(node));
+            }
+
+            wstring serviceType(L"SnapshotServiceType");
+            plb.UpdateServiceType(ServiceTypeDescription(wstring(serviceType), set<NodeId>()));
+
+            for (int domain = 0; domain < domainCount; ++domain)
+            {
+                wstring serviceName = GetServiceName(domain);
+                plb.UpdateService(CreateServiceDescription(
+                    wstring(serviceName),
+                    wstring(serviceType),
+                    true,
+                    CreateMetrics(wformatString("{0}/1.0/10/10", GetMetricName(domain)))));
+
+                for (int partition = 0; partition < partitionsPerDomain; ++partition)
+                {
+                    int primary = partition % nodeCount;
+                    plb.UpdateFailoverUnit(FailoverUnitDescription(
+                        CreateGuid(domain * partitionsPerDomain + partition),
+                        wstring(serviceName),
+                        0,
+                        CreateReplicas(wformatString("P/{0},S/{1}", primary, (primary + 1) % nodeCount)),
+                        0));
+                }
+            }
+
+            plb.ProcessPendingUpdatesPeriodicTask();
+        }
+
+        static void UpdateDomainLoads(PlacementAndLoadBalancing & plb, int domain, int partitionsPerDomain, int partitionCount, uint load)
+        {
+            vector<LoadOrMoveCostDescription> loads;
+            loads.reserve(partitionCount);
+
+            for (int partition = 0; partition < partitionCount; ++partition)
+            {
+                loads.push_back(CreateLoadOrMoveCost(domain * partitionsPerDomain + partition, GetServiceName(domain), GetMetricName(domain), load, load));
+            }
+
+            plb.UpdateLoadOrMoveCosts(move(loads));
+            plb.ProcessPendingUpdatesPeriodicTask();
+        }
+
+        // Number of domains whose data is shared between the two snapshots
+        static size_t CountSharedDomains(Snapshot const & first, Snapshot const & second)
+        {
+            size_t count = 0;
+            for (auto it = first.ServiceDomainSnapshot.begin(); it != first.ServiceDomainSnapshot.end(); ++it)
+            {
+                auto itSecond = second.ServiceDomainSnapshot.find(it->first);
+                if (itSecond != second.ServiceDomainSnapshot.end() && itSecond->second.get() == it->second.get())
+                {
+                    ++count;
+                }
+            }
+
+            return count;
+        }
+
+        static int64 GetHeapBytesInUse()
+        {
+#if defined(PLATFORM_UNIX)
+            return static_cast<int64>(mallinfo().uordblks);
+#else
+            return 0;
+#endif
+        }
+
+        shared_ptr<TestFM> fm_;
+    };
+
+    BOOST_FIXTURE_TEST_SUITE(TestPLBSnapshotSuite, TestPLBSnapshot)
+
+    BOOST_AUTO_TEST_CASE(IncrementalSnapshotReusesUnchangedDomains)
+    {
+        PLBConfigScopeChange(UseIncrementalSnapshot, bool, true);
+        PLBConfigScopeChange(FullSnapshotInterval, TimeSpan, TimeSpan::MaxValue);
+
+        PlacementAndLoadBalancing & plb = fm_->PLB;
+        PlacementAndLoadBalancingTestHelper & plbTestHelper = fm_->PLBTestHelper;
+
+        CreateDomains(plb, 2, 10, 3);
+
+        Snapshot first = plbTestHelper.TakeSnapshot();
+        VERIFY_ARE_EQUAL(2u, first.ServiceDomainSnapshot.size());
+
+        // Nothing changed, both domains are reused
+        Snapshot second = plbTestHelper.TakeSnapshot();
+        VERIFY_ARE_EQUAL(2u, CountSharedDomains(first, second));
+
+        // Load change in one domain
+        UpdateDomainLoads(plb, 0, 10, 1, 20);
+        Snapshot third = plbTestHelper.TakeSnapshot();
+        VERIFY_ARE_EQUAL(1u, CountSharedDomains(second, third));
+
+        // Failover unit change in one domain
+        plb.UpdateFailoverUnit(FailoverUnitDescription(CreateGuid(10), wstring(GetServiceName(1)), 1, CreateReplicas(L"P/2,S/0"), 0));
+        plb.ProcessPendingUpdatesPeriodicTask();
+        Snapshot fourth = plbTestHelper.TakeSnapshot();
+        VERIFY_ARE_EQUAL(1u, CountSharedDomains(third, fourth));
+
+        // Node change affects all domains
+        plb.UpdateNode(CreateNodeDescription(3));
+        plb.ProcessPendingUpdatesPeriodicTask();
+        Snapshot fifth = plbTestHelper.TakeSnapshot();
+        VERIFY_ARE_EQUAL(0u, CountSharedDomains(fourth, fifth));
+
+        // Service change affects all domains since domains can be merged or split
+        plb.UpdateService(CreateServiceDescription(
+            GetServiceName(2),
+            L"SnapshotServiceType",
+            true,
+            CreateMetrics(wformatString("{0}/1.0/10/10", GetMetricName(2)))));
+        Snapshot sixth = plbTestHelper.TakeSnapshot();
+        VERIFY_ARE_EQUAL(0u, CountSharedDomains(fifth, sixth));
+        VERIFY_ARE_EQUAL(3u, sixth.ServiceDomainSnapshot.size());
+
+        // Configuration change affects all domains, and they are reused again afterwards
+        PLBConfigScopeModify(FullSnapshotInterval, TimeSpan::FromSeconds(3600.0));
+        Snapshot seventh = plbTestHelper.TakeSnapshot();
+        VERIFY_ARE_EQUAL(0u, CountSharedDomains(sixth, seventh));
+        Snapshot eighth = plbTestHelper.TakeSnapshot();
+        VERIFY_ARE_EQUAL(3u, CountSharedDomains(seventh, eighth));
+
+        // Nothing is reused once the feature is turned off
+        PLBConfigScopeModify(UseIncrementalSnapshot, false);
+        Snapshot ninth = plbTestHelper.TakeSnapshot();
+        VERIFY_ARE_EQUAL(0u, CountSharedDomains(eighth, ninth));
+        Snapshot tenth = plbTestHelper.TakeSnapshot();
+        VERIFY_ARE_EQUAL(0u, CountSharedDomains(ninth, tenth));
+    }
+
+    BOOST_AUTO_TEST_CASE(IncrementalSnapshotQueryAfterLoadChange)
+    {
+        PLBConfigScopeChange(UseIncrementalSnapshot, bool, true);
+        PLBConfigScopeChange(FullSnapshotInterval, TimeSpan, TimeSpan::MaxValue);
+
+        PlacementAndLoadBalancing & plb = fm_->PLB;
+
+        CreateDomains(plb, 2, 1, 2);
+
+        UpdateDomainLoads(plb, 0, 1, 1, 30);
+        fm_->RefreshPLB(Stopwatch::Now());
+
+        // Second domain did not change, query result has to reflect the new load of the first domain
+        UpdateDomainLoads(plb, 0, 1, 1, 40);
+        fm_->RefreshPLB(Stopwatch::Now());
+
+        ServiceModel::NodeLoadInformationQueryResult queryResult;
+        VERIFY_IS_TRUE(plb.GetNodeLoadInformationQueryResult(CreateNodeId(0), queryResult).IsSuccess());
+
+        bool foundChangedMetric = false;
+        bool foundUnchangedMetric = false;
+        for (auto it = queryResult.NodeLoadMetricInformation.begin(); it != queryResult.NodeLoadMetricInformation.end(); ++it)
+        {
+            if (it->Name == GetMetricName(0))
+            {
+                VERIFY_ARE_EQUAL(40, it->NodeLoad);
+                foundChangedMetric = true;
+            }
+            else if (it->Name == GetMetricName(1))
+            {
+                VERIFY_ARE_EQUAL(10, it->NodeLoad);
+                foundUnchangedMetric = true;
+            }
+        }
+
+        VERIFY_IS_TRUE(foundChangedMetric);
+        VERIFY_IS_TRUE(foundUnchangedMetric);
+    }
+
+    //
+    // Measures snapshot time and the heap memory kept by the new snapshot for 100K partitions in 100 service domains,
+    // where the loads of 1% of the partitions change between two snapshots. Loads of one domain change in each round.
+    //
+    BOOST_AUTO_TEST_CASE(IncrementalSnapshotPerformance100K)
+    {
+        int const domainCount = 100;
+        int const partitionsPerDomain = 1000;
+        int const nodeCount = 20;
+        int const roundCount = 10;
+
+        PLBConfigScopeChange(UseIncrementalSnapshot, bool, true);
+        PLBConfigScopeChange(FullSnapshotInterval, TimeSpan, TimeSpan::MaxValue);
+
+        PlacementAndLoadBalancing & plb = fm_->PLB;
+        PlacementAndLoadBalancingTestHelper & plbTestHelper = fm_->PLBTestHelper;
+
+        CreateDomains(plb, domainCount, partitionsPerDomain, nodeCount);
+
+        for (int mode = 0; mode < 2; ++mode)
+        {
+            bool useIncrementalSnapshot = (mode == 1);
+            PLBConfigScopeModify(UseIncrementalSnapshot, useIncrementalSnapshot);
+
+            unique_ptr<Snapshot> previous = make_unique<Snapshot>(plbTestHelper.TakeSnapshot());
+
+            int64 totalMicroseconds = 0;
+            int64 totalBytes = 0;
+            size_t totalShared = 0;
+
+            for (int round = 0; round < roundCount; ++round)
+            {
+                UpdateDomainLoads(plb, round % domainCount, partitionsPerDomain, partitionsPerDomain, round + 20);
+
+                // Previous snapshot is still alive as it is in PLB until the next refresh completes
+                int64 bytesBefore = GetHeapBytesInUse();
+
+                Stopwatch stopwatch;
+                stopwatch.Start();
+                unique_ptr<Snapshot> current = make_unique<Snapshot>(plbTestHelper.TakeSnapshot());
+                stopwatch.Stop();
+
+                totalBytes += GetHeapBytesInUse() - bytesBefore;
+                totalMicroseconds += stopwatch.ElapsedMicroseconds;
+                totalShared += CountSharedDomains(*previous, *current);
+
+                VERIFY_ARE_EQUAL(static_cast<size_t>(domainCount), current->ServiceDomainSnapshot.size());
+
+                previous = move(current);
+            }
+
+            if (useIncrementalSnapshot)
+            {
+                VERIFY_ARE_EQUAL(static_cast<size_t>((domainCount - 1) * roundCount), totalShared);
+            }
+            else
+            {
+                VERIFY_ARE_EQUAL(0u, totalShared);
+            }
+
+            Trace.WriteInfo(
+                PLBSnapshotTestSource,
+                "Snapshot of {0} partitions in {1} domains, {2} changed partitions per round, incremental={3}: average {4}us and {5} bytes per snapshot, {6} domains reused",
+                domainCount * partitionsPerDomain,
+                domainCount,
+                partitionsPerDomain,
+                useIncrementalSnapshot,
+                totalMicroseconds / roundCount,
+                totalBytes / roundCount,
+                totalShared);
+        }
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+
+    bool TestPLBSnapshot::ClassSetup()
+    {
+        Trace.WriteInfo(PLBSnapshotTestSource, "Random seed: {0}", PLBConfig::GetConfig().InitialRandomSeed);
+
+        fm_ = make_shared<TestFM>();
+
+        return TRUE;
+    }
+
+    bool TestPLBSnapshot::TestSetup()
+    {
+        fm_->Load();
+
+        return TRUE;
+    }
+
+    bool TestPLBSnapshot::ClassCleanup()
+    {
+        Trace.WriteInfo(PLBSnapshotTestSource, "Cleaning up the class.");
+
+        // Dispose PLB
+        fm_->PLBTestHelper.Dispose();
+
+        return TRUE;
+    }
+}
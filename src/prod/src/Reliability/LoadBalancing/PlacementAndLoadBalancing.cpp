@@ -124,6 +124,9 @@ PlacementAndLoadBalancing::PlacementAndLoadBalancing(
     tracingJobQueueFinished_(false),
     testTracingLock_(),
     testTracingBarrier_(testTracingLock_),
+    domainSnapshots_(),
+    lastFullSnapshot_(StopwatchTime::Zero),
+    lastSnapshotConfigVersion_(0),
     lastStatisticsTrace_(StopwatchTime::Zero),
     rgStatistics_()
 {
@@ -226,6 +229,7 @@ void PlacementAndLoadBalancing::SetMovementEnabled(bool constraintCheckEnabled,
     }
 
     AcquireWriteLock grab(lock_);
+    ClearDomainSnapshotsCallerHoldsLock();
     StopwatchTime now = Stopwatch::Now();
 
     constraintCheckEnabled_.store(constraintCheckEnabled);
@@ -482,6 +486,7 @@ void PlacementAndLoadBalancing::UpdateServiceType(ServiceTypeDescription && serv
     }
 
     AcquireWriteLock grab(lock_);
+    ClearDomainSnapshotsCallerHoldsLock();
 
     wstring serviceTypeName = serviceTypeDescription.Name;
     bool changed = false;
@@ -525,6 +530,7 @@ void PlacementAndLoadBalancing::UpdateClusterUpgrade(bool isUpgradeInProgress, s
     Trace.UpdateUpgradeCompletedUDs(L"cluster", isUpgradeInProgress, UDsToString(completedUDs));
 
     AcquireWriteLock grab(lock_);
+    ClearDomainSnapshotsCallerHoldsLock();
 
     clusterUpgradeInProgress_.store(isUpgradeInProgress);
 
@@ -562,6 +568,7 @@ Common::ErrorCode PlacementAndLoadBalancing::UpdateApplication(ApplicationDescri
     wstring applicationName = applicationDescription.Name;
 
     AcquireWriteLock grab(lock_);
+    ClearDomainSnapshotsCallerHoldsLock();
 
     if (applicationDescription.ApplicationId == 0)
     {
@@ -1001,6 +1008,7 @@ void PlacementAndLoadBalancing::DeleteApplication(std::wstring const& applicatio
     }
 
     AcquireWriteLock grab(lock_);
+    ClearDomainSnapshotsCallerHoldsLock();
 
     if (applicationToIdMap_.find(applicationName) == applicationToIdMap_.end())
     {
@@ -1199,6 +1207,7 @@ void PlacementAndLoadBalancing::DeleteServiceType(wstring const& serviceTypeName
 
     // assume all failover units of the service have already been deleted
     AcquireWriteLock grab(lock_);
+    ClearDomainSnapshotsCallerHoldsLock();
 
     auto itServiceType = serviceTypeTable_.find(serviceTypeName);
     if (itServiceType != serviceTypeTable_.end()) // to deal with the case where a deleted service be deleted again
@@ -1216,6 +1225,7 @@ ErrorCode PlacementAndLoadBalancing::UpdateService(ServiceDescription && service
     }
 
     AcquireWriteLock grab(lock_);
+    ClearDomainSnapshotsCallerHoldsLock();
 
     wstring serviceName = serviceDescription.Name;
 
@@ -1233,6 +1243,7 @@ void PlacementAndLoadBalancing::DeleteService(std::wstring const& serviceName)
 
     // assume all failover units of the service have already been deleted
     AcquireWriteLock grab(lock_);
+    ClearDomainSnapshotsCallerHoldsLock();
 
     // consume all pending updates so we won't have dangling FailoverUnits
     ProcessPendingUpdatesCallerHoldsLock(Stopwatch::Now());
@@ -1278,6 +1289,27 @@ void PlacementAndLoadBalancing::UpdateLoadOrMoveCost(LoadOrMoveCostDescription &
     InternalUpdateLoadOrMoveCost(move(loadOrMoveCost));
 }
 
+void PlacementAndLoadBalancing::UpdateLoadOrMoveCosts(vector<LoadOrMoveCostDescription> && loadOrMoveCosts)
+{
+    if (IsDisposed() || loadOrMoveCosts.empty())
+    {
+        return;
+    }
+
+    // One acquisition of the buffer lock for the whole batch so that FM does not
+    // contend with the refresh for every single load report
+
+    StopwatchTime now = Stopwatch::Now();
+
+    LockAndSetBooleanLock grab(bufferUpdateLock_);
+
+    pendingLoadsOrMoveCosts_.reserve(pendingLoadsOrMoveCosts_.size() + loadOrMoveCosts.size());
+    for (auto it = loadOrMoveCosts.begin(); it != loadOrMoveCosts.end(); ++it)
+    {
+        pendingLoadsOrMoveCosts_.push_back(make_pair(move(*it), now));
+    }
+}
+
 Common::ErrorCode PlacementAndLoadBalancing::ResetPartitionLoad(Reliability::FailoverUnitId const & failoverUnitId, wstring const & serviceName, bool isStateful)
 {
     Trace.ResetPartitionLoadStart(failoverUnitId.Guid);
@@ -4216,6 +4248,11 @@ bool PlacementAndLoadBalancing::ProcessPendingUpdatesCallerHoldsLock(StopwatchTi
 
     size_t numUpdates = fuUpdates.size() + loadOrMoveCostUpdates.size() + nodeUpdates.size();
 
+    if (!nodeUpdates.empty())
+    {
+        ClearDomainSnapshotsCallerHoldsLock();
+    }
+
     for (auto it = nodeUpdates.begin(); it != nodeUpdates.end(); ++it)
     {
         ProcessUpdateNode(move(it->first), now);
@@ -4925,10 +4962,12 @@ Common::ErrorCode PlacementAndLoadBalancing::SnapshotConstraintChecker(
         auto & newSnap = (snapshotsOnEachRefresh_->second.CreatedTimeUtc > snapshotsOnEachRefresh_->first.CreatedTimeUtc) ?
             snapshotsOnEachRefresh_->second.ServiceDomainSnapshot : snapshotsOnEachRefresh_->first.ServiceDomainSnapshot;
 
-        auto & snapState = newSnap.at(domainId).state_;
+        auto & snapState = newSnap.at(domainId)->state_;
 
         {
             AcquireExclusiveLock grabBig(lock_);
+            // Full closure changes the domain data, so it must not be reused by the next snapshot
+            EvictDomainSnapshotCallerHoldsLock(domainId);
             snapState.CreatePlacementAndChecker(PartitionClosureType::Full);
         }
 
@@ -5119,10 +5158,11 @@ std::pair<Common::ErrorCode, std::vector<Federation::NodeId>> PlacementAndLoadBa
         auto& newSnap = (snapshotsOnEachRefresh_->second.CreatedTimeUtc > snapshotsOnEachRefresh_->first.CreatedTimeUtc) ?
             snapshotsOnEachRefresh_->second.ServiceDomainSnapshot : snapshotsOnEachRefresh_->first.ServiceDomainSnapshot;
 
-        auto& snapState = newSnap.at(domainId).state_;
+        auto& snapState = newSnap.at(domainId)->state_;
 
         {
             AcquireExclusiveLock bigGrab(lock_);
+            EvictDomainSnapshotCallerHoldsLock(domainId);
             //Run this to generate the checkerObj
             snapState.CreatePlacementAndChecker(PartitionClosureType::Full);
         }
@@ -5405,14 +5445,52 @@ Snapshot PlacementAndLoadBalancing::TakeSnapShot()
     timer.Start();
     Trace.SnapshotStart();
 
-    map<wstring, ServiceDomain::DomainData> serviceDomainMap;
+    StopwatchTime now = Stopwatch::Now();
+    bool useIncrementalSnapshot = PLBConfig::GetConfig().UseIncrementalSnapshot;
+    uint64 configVersion = PLBConfig::GetConfig().UpdateVersion;
+
+    // Snapshots depend on the configuration as well, so they are taken again as soon as it changes
+    if (!useIncrementalSnapshot ||
+        lastSnapshotConfigVersion_ != configVersion ||
+        lastFullSnapshot_ + PLBConfig::GetConfig().FullSnapshotInterval <= now)
+    {
+        domainSnapshots_.clear();
+        lastFullSnapshot_ = now;
+        lastSnapshotConfigVersion_ = configVersion;
+    }
+
+    map<wstring, ServiceDomain::DomainDataSPtr> serviceDomainMap;
+    map<ServiceDomain::DomainId, DomainSnapshotEntry> domainSnapshots;
+    uint64 takenDomainCount = 0;
+    uint64 reusedDomainCount = 0;
 
     for (auto iter = serviceDomainTable_.begin(); iter != serviceDomainTable_.end(); ++iter)
     {
-        ServiceDomain::DomainData domainData = iter->second.TakeSnapshot(plbDiagnosticsSPtr_);
-        serviceDomainMap.insert(pair<wstring, ServiceDomain::DomainData>(iter->first, move(domainData)));
+        ServiceDomain::DomainDataSPtr domainData;
+
+        auto itSnapshot = domainSnapshots_.find(iter->first);
+        if (itSnapshot != domainSnapshots_.end() && CanReuseDomainSnapshot(itSnapshot->second, iter->second))
+        {
+            domainData = itSnapshot->second.domainData_;
+            ++reusedDomainCount;
+        }
+        else
+        {
+            domainData = make_shared<ServiceDomain::DomainData>(iter->second.TakeSnapshot(plbDiagnosticsSPtr_));
+            ++takenDomainCount;
+        }
+
+        if (useIncrementalSnapshot)
+        {
+            domainSnapshots.insert(make_pair(iter->first, DomainSnapshotEntry(&(iter->second), iter->second.StateVersion, domainData)));
+        }
+
+        serviceDomainMap.insert(make_pair(iter->first, move(domainData)));
     }
 
+    // Snapshots of the domains that do not exist anymore are dropped here
+    domainSnapshots_ = move(domainSnapshots);
+
     // We want to snapshot metrics that do have capacity but no services.
     wstring prefix = L"";
     unique_ptr<ServiceDomain> tempDomainUPtr;
@@ -5433,8 +5511,10 @@ Snapshot PlacementAndLoadBalancing::TakeSnapShot()
 
     if (prefix != L"")
     {
-        ServiceDomain::DomainData domainData = tempDomainUPtr->TakeSnapshot(plbDiagnosticsSPtr_);
-        serviceDomainMap.insert(pair<wstring, ServiceDomain::DomainData>(prefix, move(domainData)));
+        // Temporary domain is never reused since it is created again on each snapshot
+        ServiceDomain::DomainDataSPtr domainData = make_shared<ServiceDomain::DomainData>(tempDomainUPtr->TakeSnapshot(plbDiagnosticsSPtr_));
+        serviceDomainMap.insert(make_pair(prefix, move(domainData)));
+        ++takenDomainCount;
     }
 
     Snapshot snapshot = move(Snapshot(move(serviceDomainMap)));
@@ -5456,11 +5536,32 @@ Snapshot PlacementAndLoadBalancing::TakeSnapShot()
 
     timer.Stop();
 
-    Trace.SnapshotEnd(timer.ElapsedMilliseconds);
+    Trace.SnapshotEnd(timer.ElapsedMilliseconds, takenDomainCount, reusedDomainCount);
 
     return snapshot;
 }
 
+bool PlacementAndLoadBalancing::CanReuseDomainSnapshot(DomainSnapshotEntry const& entry, ServiceDomain const& serviceDomain) const
+{
+    // Snapshot keeps the scheduler action, so it is taken again when the action changes.
+    // Domain pointer is checked as well since domains are moved when they are merged or split.
+    PLBSchedulerAction currentAction = serviceDomain.Scheduler.CurrentAction;
+    return entry.domain_ == &serviceDomain &&
+        entry.stateVersion_ == serviceDomain.StateVersion &&
+        entry.domainData_->action_.Action == currentAction.Action &&
+        entry.domainData_->action_.IsSkip == currentAction.IsSkip;
+}
+
+void PlacementAndLoadBalancing::ClearDomainSnapshotsCallerHoldsLock()
+{
+    domainSnapshots_.clear();
+}
+
+void PlacementAndLoadBalancing::EvictDomainSnapshotCallerHoldsLock(ServiceDomain::DomainId const& domainId)
+{
+    domainSnapshots_.erase(domainId);
+}
+
 void PlacementAndLoadBalancing::TrackDroppedPLBMovements()
 {
     //This method is used to trace when the FM drops PLB movements and update the PLB Perf Counters to track the moving average of dropped movements.
@@ -5551,13 +5652,13 @@ Common::ErrorCode PlacementAndLoadBalancing::GetClusterLoadInformationQueryResul
 
     for (auto iter = snapshots->first.ServiceDomainSnapshot.begin(); iter != snapshots->first.ServiceDomainSnapshot.end(); iter++)
     {
-        TESTASSERT_IFNOT(iter->second.state_.PlacementObj, "Placement object before refresh is not available for service domain: {0}", iter->second.domainId_);
-        if (!iter->second.state_.PlacementObj)
+        TESTASSERT_IFNOT(iter->second->state_.PlacementObj, "Placement object before refresh is not available for service domain: {0}", iter->second->domainId_);
+        if (!iter->second->state_.PlacementObj)
         {
             Trace.InternalError(L"GetClusterLoadInformationQueryResult(): Placement object is nullptr in shapshot.");
             return ErrorCodeValue::PLBNotReady;
         }
-        Placement const& pl = *(iter->second.state_.PlacementObj);
+        Placement const& pl = *(iter->second->state_.PlacementObj);
 
         Score originalScore(
             pl.TotalMetricCount,
@@ -5579,7 +5680,7 @@ Common::ErrorCode PlacementAndLoadBalancing::GetClusterLoadInformationQueryResul
                 loadMetricInformation.put_Name(j->Name);
                 loadMetricInformation.IsBalancedBefore = j->IsBalanced;
                 loadMetricInformation.DeviationBefore = originalScore.CalculateAvgStdDevForMetric(j->Name);
-                PLBSchedulerAction action = iter->second.action_;
+                PLBSchedulerAction action = iter->second->action_;
                 loadMetricInformation.Action = action.ToQueryString();
                 loadMetricInformation.MaxNodeLoadValue = -1;
                 loadMetricInformation.MinNodeLoadValue = -1;
@@ -5592,14 +5693,14 @@ Common::ErrorCode PlacementAndLoadBalancing::GetClusterLoadInformationQueryResul
 
     for (auto iter = snapshots->second.ServiceDomainSnapshot.begin(); iter != snapshots->second.ServiceDomainSnapshot.end(); iter++)
     {
-        TESTASSERT_IFNOT(iter->second.state_.PlacementObj, "Placement object after refresh is not available for service domain: {0}", iter->second.domainId_);
-        if (!iter->second.state_.PlacementObj)
+        TESTASSERT_IFNOT(iter->second->state_.PlacementObj, "Placement object after refresh is not available for service domain: {0}", iter->second->domainId_);
+        if (!iter->second->state_.PlacementObj)
         {
             Trace.InternalError(L"GetClusterLoadInformationQueryResult(): Placement object is nullptr in shapshot.");
             return ErrorCodeValue::PLBNotReady;
         }
 
-        Placement const& pl = *(iter->second.state_.PlacementObj);
+        Placement const& pl = *(iter->second->state_.PlacementObj);
 
         Score originalScore(
             pl.TotalMetricCount,
@@ -5776,9 +5877,9 @@ Common::ErrorCode PlacementAndLoadBalancing::GetNodeLoadInformationQueryResult(F
 
     for (auto iter = snapshots->second.ServiceDomainSnapshot.begin(); iter != snapshots->second.ServiceDomainSnapshot.end(); ++iter)
     {
-        if (iter->second.state_.PlacementObj)
+        if (iter->second->state_.PlacementObj)
         {
-            Placement const& pl = *(iter->second.state_.PlacementObj);
+            Placement const& pl = *(iter->second->state_.PlacementObj);
             for (size_t j = 0; j< pl.NodeCount; ++j)
             {
                 NodeEntry const & node = pl.SelectNode(j);
@@ -93,6 +93,7 @@ namespace Reliability
             virtual void DeleteFailoverUnit(std::wstring && serviceName, Common::Guid fuId);
 
             virtual void UpdateLoadOrMoveCost(LoadOrMoveCostDescription && loadOrMoveCost);
+            virtual void UpdateLoadOrMoveCosts(std::vector<LoadOrMoveCostDescription> && loadOrMoveCosts);
             virtual Common::ErrorCode ResetPartitionLoad(FailoverUnitId const & failoverUnitId, std::wstring const & serviceName, bool isStateful);
 
             //Query APIs
@@ -198,6 +199,20 @@ namespace Reliability
                 std::set<std::wstring> services_;
             };
 
+            // Snapshot of a service domain that is reused on the next refresh if the domain did not change
+            class DomainSnapshotEntry
+            {
+            public:
+                DomainSnapshotEntry(ServiceDomain const* domain, uint64 stateVersion, ServiceDomain::DomainDataSPtr const& domainData)
+                    : domain_(domain), stateVersion_(stateVersion), domainData_(domainData)
+                {
+                }
+
+                ServiceDomain const* domain_;
+                uint64 stateVersion_;
+                ServiceDomain::DomainDataSPtr domainData_;
+            };
+
             void PassMovementsToFM(ServiceDomain::DomainData * searcherDomainData);
             void UpdatePartitionsWithCreation(ServiceDomain::DomainData * searcherDomainData);
             
@@ -225,6 +240,13 @@ namespace Reliability
             std::vector<ServiceDomainData> GetServiceDomains();
 
             Snapshot TakeSnapShot();
+            bool CanReuseDomainSnapshot(DomainSnapshotEntry const& entry, ServiceDomain const& serviceDomain) const;
+
+            // Drops the snapshots kept for reuse, called on updates that are not tracked by the domain state version
+            void ClearDomainSnapshotsCallerHoldsLock();
+
+            // Drops the snapshot of one domain kept for reuse, called when the snapshot data gets modified
+            void EvictDomainSnapshotCallerHoldsLock(ServiceDomain::DomainId const& domainId);
 
             // Called from service domain to determine the time for next action.
             void UpdateNextActionPeriod(Common::TimeSpan nextActionPeriod);
@@ -563,6 +585,11 @@ namespace Reliability
 
             std::shared_ptr<std::pair<Snapshot,Snapshot>> snapshotsOnEachRefresh_;
 
+            // Domain snapshots taken on the last refresh, read by Refresh and evicted under the exclusive lock
+            std::map<ServiceDomain::DomainId, DomainSnapshotEntry> domainSnapshots_;
+            Common::StopwatchTime lastFullSnapshot_;
+            uint64 lastSnapshotConfigVersion_;
+
             Common::StopwatchTime lastStatisticsTrace_;
             RGStatistics rgStatistics_;
 
@@ -69,6 +69,11 @@ void PlacementAndLoadBalancingTestHelper::UpdateLoadOrMoveCost(LoadOrMoveCostDes
     plb_.UpdateLoadOrMoveCost(std::move(loadOrMoveCost));
 }
 
+void PlacementAndLoadBalancingTestHelper::UpdateLoadOrMoveCosts(std::vector<LoadOrMoveCostDescription> && loadOrMoveCosts)
+{
+    plb_.UpdateLoadOrMoveCosts(std::move(loadOrMoveCosts));
+}
+
 Common::ErrorCode PlacementAndLoadBalancingTestHelper::ResetPartitionLoad(Reliability::FailoverUnitId const & failoverUnitId, std::wstring const & serviceName, bool isStateful)
 {
     return plb_.ResetPartitionLoad(failoverUnitId, serviceName, isStateful);
@@ -344,6 +349,12 @@ void PlacementAndLoadBalancingTestHelper::Refresh(Common::StopwatchTime now)
 
 }
 
+Snapshot PlacementAndLoadBalancingTestHelper::TakeSnapshot()
+{
+    AcquireReadLock grab(plb_.lock_);
+    return plb_.TakeSnapShot();
+}
+
 bool PlacementAndLoadBalancingTestHelper::CheckLoadReport(std::wstring const& serviceName, Common::Guid fuId, int numberOfReports)
 {
     {
@@ -58,6 +58,7 @@ namespace Reliability
             virtual void DeleteFailoverUnit(std::wstring && serviceName, Common::Guid fuId);
 
             virtual void UpdateLoadOrMoveCost(LoadOrMoveCostDescription && loadOrMoveCost);
+            virtual void UpdateLoadOrMoveCosts(std::vector<LoadOrMoveCostDescription> && loadOrMoveCosts);
             virtual Common::ErrorCode ResetPartitionLoad(FailoverUnitId const & failoverUnitId, std::wstring const & serviceName, bool isStateful);
 
             virtual Common::ErrorCode UpdateApplication(ApplicationDescription && applicationDescription, bool forceUpdate = false);
@@ -101,6 +102,9 @@ namespace Reliability
 
             bool CheckLoadReport(std::wstring const& serviceName, Common::Guid fuId, int numberOfReports);
 
+            // Takes the snapshot of all service domains in the same way as it is done on refresh
+            Snapshot TakeSnapshot();
+
             // Check secondary load map if exists, otherwise, return the secondary entry (default load)
             // If callGetSecondaryLoad is true, return by call GetSecondaryLoad
             bool CheckLoadValue(
@@ -34,6 +34,7 @@ ServiceDomain::ServiceDomain(DomainId && id, PlacementAndLoadBalancing const& pl
         StopwatchTime::Zero,
         Stopwatch::Now(),
         StopwatchTime::Zero),
+    stateVersion_(0),
     changedNodes_(),
     changedServiceTypes_(),
     changedServices_(),
@@ -72,6 +73,7 @@ ServiceDomain::ServiceDomain(ServiceDomain && other)
     failoverUnitTable_(move(other.failoverUnitTable_)),
     movePlan_(move(other.movePlan_)),
     scheduler_(move(other.scheduler_)),
+    stateVersion_(other.stateVersion_),
     changedNodes_(move(other.changedNodes_)),
     changedServiceTypes_(move(other.changedServiceTypes_)),
     changedServices_(move(other.changedServices_)),
@@ -475,6 +477,8 @@ void ServiceDomain::MergeDomain(ServiceDomain && other)
 
 void ServiceDomain::AddFailoverUnit(FailoverUnit && failoverUnitToAdd, StopwatchTime timeStamp)
 {
+    ++stateVersion_;
+
     Common::Guid fuId = failoverUnitToAdd.FuDescription.FUId;
     Service & service = GetService(failoverUnitToAdd.FuDescription.ServiceId);
 
@@ -512,6 +516,8 @@ void ServiceDomain::AddFailoverUnit(FailoverUnit && failoverUnitToAdd, Stopwatch
 
 bool ServiceDomain::UpdateFailoverUnit(FailoverUnitDescription && failoverUnitDescription, StopwatchTime timeStamp, bool traceDetail)
 {
+    ++stateVersion_;
+
     bool ret = false;
     Common::Guid fuId = failoverUnitDescription.FUId;
     Service & service = GetService(failoverUnitDescription.ServiceId);
@@ -658,6 +664,8 @@ bool ServiceDomain::UpdateFailoverUnit(FailoverUnitDescription && failoverUnitDe
 
 void ServiceDomain::UpdateFailoverUnitWithMoves(FailoverUnitMovement const& movement)
 {
+    ++stateVersion_;
+
     auto itFailoverUnit = failoverUnitTable_.find(movement.FailoverUnitId);
 
     if (itFailoverUnit != failoverUnitTable_.end())
@@ -682,6 +690,8 @@ void ServiceDomain::UpdateFailoverUnitWithMoves(FailoverUnitMovement const& move
 
 void ServiceDomain::UpdateLoadOrMoveCost(LoadOrMoveCostDescription && loadOrMoveCost, StopwatchTime timeStamp)
 {
+    ++stateVersion_;
+
     bool isReset = loadOrMoveCost.IsReset;
 
     size_t updatedMetricCount = 0;
@@ -1273,6 +1283,8 @@ void ServiceDomain::OnServiceTypeChanged(std::wstring const& serviceTypeName)
 
 void ServiceDomain::UpdateFailoverUnitWithCreationMoves(vector<Common::Guid> & partitionsWithCreations)
 {
+    ++stateVersion_;
+
     if (!partitionsWithCreations.empty() && (scheduler_.CurrentAction.IsCreation() || scheduler_.CurrentAction.IsCreationWithMove()))
     {
         for (auto it = partitionsWithCreations.begin(); it != partitionsWithCreations.end(); ++it)
@@ -1291,6 +1303,8 @@ void ServiceDomain::UpdateFailoverUnitWithCreationMoves(vector<Common::Guid> & p
 
 void ServiceDomain::OnMovementGenerated(StopwatchTime timeStamp, Common::Guid decisionGuid, double newAvgStdDev, FailoverUnitMovementTable && movementList)
 {
+    ++stateVersion_;
+
     bool isCreation = (scheduler_.CurrentAction.Action == PLBSchedulerActionType::Creation ||
         scheduler_.CurrentAction.Action == PLBSchedulerActionType::CreationWithMove);
 
@@ -1603,6 +1617,8 @@ void ServiceDomain::UpdateReservationsServicesNoMetric(
 
 inline void ServiceDomain::AddNodeLoad(Service const& service, FailoverUnit const& failoverUnit, vector<ReplicaDescription> const& replicas, bool isLoadOrMoveCostChange)
 {
+    ++stateVersion_;
+
     vector<ServiceMetric> const& metrics = service.ServiceDesc.Metrics;
     ASSERT_IFNOT(metrics.size() == failoverUnit.PrimaryEntries.size() && metrics.size() ==
         failoverUnit.SecondaryEntries.size(), "Metric sizes don't match");
@@ -1822,6 +1838,8 @@ inline void ServiceDomain::AddNodeLoad(Service const& service, FailoverUnit cons
 inline void ServiceDomain::DeleteNodeLoad(Service const& service, FailoverUnit const& failoverUnit,
     vector<ReplicaDescription> const& replicas)
 {
+    ++stateVersion_;
+
     vector<ServiceMetric> const& metrics = service.ServiceDesc.Metrics;
     ASSERT_IFNOT(metrics.size() == failoverUnit.PrimaryEntries.size() && metrics.size() ==
         failoverUnit.SecondaryEntries.size(), "Metric sizes don't match");
@@ -99,6 +99,8 @@ namespace Reliability
                 Common::StopwatchTime interruptTime_;
             };
 
+            typedef std::shared_ptr<DomainData> DomainDataSPtr;
+
 
             ServiceDomain(DomainId && id, PlacementAndLoadBalancing const& plb);
 
@@ -107,6 +109,11 @@ namespace Reliability
             __declspec (property(get=get_DomainId)) DomainId const& Id;
             DomainId const& get_DomainId() const { return domainId_; }
 
+            // Changes whenever a failover unit, its load or its movements change in this domain.
+            // Used by PLB to reuse the snapshot of a domain that did not change since the last refresh.
+            __declspec (property(get=get_StateVersion)) uint64 StateVersion;
+            uint64 get_StateVersion() const { return stateVersion_; }
+
             __declspec (property(get=get_Scheduler)) PLBScheduler const& Scheduler;
             PLBScheduler const& get_Scheduler() const { return scheduler_; }
 
@@ -158,7 +165,7 @@ namespace Reliability
             void AddFailoverUnit(FailoverUnit && failoverUnitToAdd, Common::StopwatchTime timeStamp);
             bool UpdateFailoverUnit(FailoverUnitDescription && failoverUnitDescription, Common::StopwatchTime timeStamp, bool traceDetail = true);
             void UpdateLoadOrMoveCost(LoadOrMoveCostDescription && loadOrMoveCost, Common::StopwatchTime timeStamp);
-            void RemoveFailoverUnit(Common::Guid fuId) { failoverUnitTable_.erase(fuId); }
+            void RemoveFailoverUnit(Common::Guid fuId) { failoverUnitTable_.erase(fuId); ++stateVersion_; }
 
             void UpdateFailoverUnitWithMoves(FailoverUnitMovement const& movement);
 
@@ -345,6 +352,9 @@ namespace Reliability
 
             PLBScheduler scheduler_;
 
+            // version of failover units, loads and movements in this domain
+            uint64 stateVersion_;
+
             // changed nodes since last refresh
             std::set<uint64> changedNodes_;
 
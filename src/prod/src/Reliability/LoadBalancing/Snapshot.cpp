@@ -21,7 +21,7 @@ Snapshot::Snapshot(Snapshot && other)
 {
 }
 
-Snapshot::Snapshot(map<wstring, ServiceDomain::DomainData> && serviceDomainSnapshot)
+Snapshot::Snapshot(map<wstring, ServiceDomain::DomainDataSPtr> && serviceDomainSnapshot)
     :serviceDomainSnapshot_(move(serviceDomainSnapshot))
     ,createdTimeUtc_(StopwatchTime::ToDateTime(Stopwatch::Now()))
     ,rgDomainId_()
@@ -35,19 +35,9 @@ ServiceDomain::DomainData const * Reliability::LoadBalancingComponent::Snapshot:
         auto const & itDomainSnapshot = serviceDomainSnapshot_.find(rgDomainId_);
         if (itDomainSnapshot != serviceDomainSnapshot_.end())
         {
-            return &(itDomainSnapshot->second);
+            return itDomainSnapshot->second.get();
         }
     }
     return nullptr;
 }
 
-void Snapshot::GetFullSnapshot(std::wstring domainId)
-{
-    auto serviceDomainIt = serviceDomainSnapshot_.find(domainId);
-    if (serviceDomainIt == serviceDomainSnapshot_.end())
-    {
-        return;
-    }
-
-    serviceDomainIt->second.state_.CreatePlacementAndChecker(PartitionClosureType::Full);
-}
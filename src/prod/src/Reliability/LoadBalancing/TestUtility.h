@@ -42,7 +42,7 @@ namespace PlacementAndLoadBalancingUnitTest
     public: \
     ScopeChangeClass##key() : original_(PLBConfig::GetConfig().key) {} \
     ~ScopeChangeClass##key() { SetValue(original_); } \
-    void SetValue(type value) { PLBConfig::GetConfig().key = value; } \
+    void SetValue(type value) { PLBConfig::GetConfig().key = value; PLBConfig::GetConfig().Test_IncrementUpdateVersion(); } \
     private: \
     type original_; \
     } ScopeChangeObject##key; \
@@ -57,7 +57,7 @@ namespace PlacementAndLoadBalancingUnitTest
     public: \
     ScopeChangeClass##key(bool cond) : cond_(cond), original_(cond ? PLBConfig::GetConfig().config1 : PLBConfig::GetConfig().config2) {} \
     ~ScopeChangeClass##key() { SetValue(original_); } \
-    void SetValue(type value) { cond_ ? PLBConfig::GetConfig().config1 = value : PLBConfig::GetConfig().config2 = value; } \
+    void SetValue(type value) { cond_ ? PLBConfig::GetConfig().config1 = value : PLBConfig::GetConfig().config2 = value; PLBConfig::GetConfig().Test_IncrementUpdateVersion(); } \
     private: \
     type original_; \
     bool cond_; \
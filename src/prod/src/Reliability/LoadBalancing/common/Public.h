@@ -21,3 +21,4 @@
 #include "Reliability/LoadBalancing/LoadMetric.h"
 #include "Reliability/LoadBalancing/LoadMetricStats.h"
 #include "Reliability/LoadBalancing/LoadOrMoveCostDescription.h"
+#include "Reliability/LoadBalancing/CompactLoadReport.h"
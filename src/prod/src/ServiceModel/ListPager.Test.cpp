@@ -0,0 +1,119 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+namespace ServiceModelTests
+{
+    using namespace std;
+    using namespace Common;
+    using namespace ServiceModel;
+    using namespace Naming;
+
+    class ListPagerTest
+    {
+    protected:
+        typedef MergedQueryListPager<wstring, ApplicationQueryResult> ApplicationListPager;
+
+        static vector<ApplicationQueryResult> CreateApplications(vector<wstring> const & paths, wstring const & typeName);
+        static vector<wstring> TakeNames(ApplicationListPager & pager, __out vector<wstring> & descriptions);
+        static ApplicationListPager::KeySelector GetKeySelector();
+    };
+
+    BOOST_FIXTURE_TEST_SUITE(ListPagerTestSuite, ListPagerTest)
+
+    BOOST_AUTO_TEST_CASE(MergeSortedListsTest)
+    {
+        ApplicationListPager pager;
+        pager.AddSortedList(CreateApplications({ L"a", L"c", L"e" }, L"FMType"), GetKeySelector());
+        pager.AddSortedList(CreateApplications({}, L"HMType"), GetKeySelector());
+        pager.AddSortedList(CreateApplications({ L"b", L"c", L"d" }, L"CMType"), GetKeySelector());
+
+        vector<wstring> descriptions;
+        vector<wstring> names = TakeNames(pager, descriptions);
+
+        vector<wstring> expectedNames = { L"fabric:/a", L"fabric:/b", L"fabric:/c", L"fabric:/d", L"fabric:/e" };
+        VERIFY_IS_TRUE(names == expectedNames);
+
+        // The duplicate key is taken from the list that was added first
+        VERIFY_IS_TRUE(StringUtility::Contains<wstring>(descriptions[2], L"FMType"));
+        VERIFY_IS_TRUE(StringUtility::Contains<wstring>(descriptions[3], L"CMType"));
+    }
+
+    BOOST_AUTO_TEST_CASE(MergeUnsortedListTest)
+    {
+        ApplicationListPager pager;
+        pager.AddSortedList(CreateApplications({ L"d", L"a", L"d", L"b" }, L"FMType"), GetKeySelector());
+        pager.AddSortedList(CreateApplications({ L"c" }, L"CMType"), GetKeySelector());
+
+        vector<wstring> descriptions;
+        vector<wstring> names = TakeNames(pager, descriptions);
+
+        vector<wstring> expectedNames = { L"fabric:/a", L"fabric:/b", L"fabric:/c", L"fabric:/d" };
+        VERIFY_IS_TRUE(names == expectedNames);
+    }
+
+    BOOST_AUTO_TEST_CASE(MergeRespectsContinuationTokenTest)
+    {
+        ApplicationListPager pager;
+        pager.AddSortedList(CreateApplications({ L"a", L"c", L"e" }, L"FMType"), GetKeySelector());
+        pager.AddSortedList(CreateApplications({ L"b", L"d" }, L"CMType"), GetKeySelector());
+
+        ActivityId activityId;
+        VERIFY_IS_TRUE(pager.MergePagingStatus(activityId, "FM", make_unique<PagingStatus>(wstring(L"fabric:/e"))).IsSuccess());
+        VERIFY_IS_TRUE(pager.MergePagingStatus(activityId, "CM", make_unique<PagingStatus>(wstring(L"fabric:/c"))).IsSuccess());
+        VERIFY_ARE_EQUAL(wstring(L"fabric:/c"), pager.ContinuationToken);
+
+        vector<wstring> descriptions;
+        vector<wstring> names = TakeNames(pager, descriptions);
+
+        vector<wstring> expectedNames = { L"fabric:/a", L"fabric:/b", L"fabric:/c" };
+        VERIFY_IS_TRUE(names == expectedNames);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+
+    vector<ApplicationQueryResult> ListPagerTest::CreateApplications(vector<wstring> const & paths, wstring const & typeName)
+    {
+        vector<ApplicationQueryResult> applications;
+        for (auto const & path : paths)
+        {
+            applications.push_back(ApplicationQueryResult(
+                NamingUri(path),
+                typeName,
+                L"1.0",
+                ApplicationStatus::Ready,
+                map<wstring, wstring>(),
+                FABRIC_APPLICATION_DEFINITION_KIND_SERVICE_FABRIC_APPLICATION_DESCRIPTION,
+                L"",
+                map<wstring, wstring>()));
+        }
+
+        return applications;
+    }
+
+    vector<wstring> ListPagerTest::TakeNames(ApplicationListPager & pager, __out vector<wstring> & descriptions)
+    {
+        map<wstring, FABRIC_HEALTH_STATE> healthStates;
+        auto entries = pager.TakeMergedPager(ActivityId(), healthStates).TakeEntries();
+
+        vector<wstring> names;
+        for (auto const & entry : entries)
+        {
+            names.push_back(entry.ApplicationName.ToString());
+            descriptions.push_back(entry.ToString());
+        }
+
+        return names;
+    }
+
+    ListPagerTest::ApplicationListPager::KeySelector ListPagerTest::GetKeySelector()
+    {
+        return [](ApplicationQueryResult const & application) { return application.ApplicationName.ToString(); };
+    }
+}
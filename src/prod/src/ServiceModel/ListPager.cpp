@@ -187,6 +187,7 @@ MergedQueryListPager<TKey, TEntry>::MergedQueryListPager()
     : pager_()
     , mergedContinuationTokenData_()
     , sortedResults_()
+    , sortedLists_()
 {
 }
 
@@ -308,6 +309,146 @@ ListPager<TEntry> && MergedQueryListPager<TKey, TEntry>::TakePager(Common::Activ
     return move(pager_);
 }
 
+template<class TKey, class TEntry>
+void MergedQueryListPager<TKey, TEntry>::AddSortedList(std::vector<TEntry> && entries, KeySelector const & keySelector)
+{
+    if (entries.empty())
+    {
+        return;
+    }
+
+    SortedList list;
+    list.Keys.reserve(entries.size());
+    list.Next = 0;
+
+    bool isSorted = true;
+    for (size_t ix = 0; ix < entries.size(); ++ix)
+    {
+        TKey key = keySelector(entries[ix]);
+        if (isSorted && !list.Keys.empty() && key < list.Keys.back().first)
+        {
+            isSorted = false;
+        }
+
+        list.Keys.push_back(std::make_pair(std::move(key), ix));
+    }
+
+    // Only the keys are sorted, the entries stay where the sub-query put them.
+    // The index breaks ties, so the first of the duplicate keys in a list is kept.
+    if (!isSorted)
+    {
+        std::sort(list.Keys.begin(), list.Keys.end());
+    }
+
+    list.Entries = std::move(entries);
+    sortedLists_.push_back(std::move(list));
+}
+
+// K-way merge of the sub-query lists. A heap holds the index of every list that has entries left,
+// ordered by the next key of the list; ties go to the list that was added first.
+template<class TKey, class TEntry>
+ListPager<TEntry> && MergedQueryListPager<TKey, TEntry>::TakeMergedPager(
+    Common::ActivityId const & activityId,
+    std::map<TKey, FABRIC_HEALTH_STATE> const & healthStates)
+{
+    auto isAfter = [this](size_t left, size_t right)
+    {
+        TKey const & leftKey = sortedLists_[left].Keys[sortedLists_[left].Next].first;
+        TKey const & rightKey = sortedLists_[right].Keys[sortedLists_[right].Next].first;
+
+        if (leftKey < rightKey) { return false; }
+        if (rightKey < leftKey) { return true; }
+        return left > right;
+    };
+
+    std::vector<size_t> heap;
+    heap.reserve(sortedLists_.size());
+    for (size_t ix = 0; ix < sortedLists_.size(); ++ix)
+    {
+        heap.push_back(ix);
+    }
+
+    std::make_heap(heap.begin(), heap.end(), isAfter);
+
+    TKey lastKey;
+    bool hasLastKey = false;
+    size_t visitedCount = 0;
+
+    while (!heap.empty())
+    {
+        std::pop_heap(heap.begin(), heap.end(), isAfter);
+
+        auto & list = sortedLists_[heap.back()];
+        auto const & item = list.Keys[list.Next++];
+
+        if (list.Next < list.Keys.size())
+        {
+            std::push_heap(heap.begin(), heap.end(), isAfter);
+        }
+        else
+        {
+            heap.pop_back();
+        }
+
+        ++visitedCount;
+
+        // All the keys left in the lists are larger
+        if (!RespectsContinuationToken(item.first))
+        {
+            break;
+        }
+
+        if (hasLastKey && !(lastKey < item.first))
+        {
+            continue;
+        }
+
+        lastKey = item.first;
+        hasLastKey = true;
+
+        TEntry & entry = list.Entries[item.second];
+
+        auto healthInfo = healthStates.find(item.first);
+        if (healthInfo != healthStates.end())
+        {
+            entry.HealthState = healthInfo->second;
+        }
+        else
+        {
+            Trace.WriteInfo(
+                TraceSource,
+                "{0}: {1}: no health info",
+                activityId,
+                item.first);
+        }
+
+        auto mergeError = pager_.TryAdd(std::move(entry));
+        if (pager_.IsBenignError(mergeError))
+        {
+            Trace.WriteInfo(
+                TraceSource,
+                "{0}: TryAdd {1}: {2}, {3}",
+                activityId,
+                item.first,
+                mergeError,
+                mergeError.Message);
+            break;
+        }
+    }
+
+    Trace.WriteNoise(
+        TraceSource,
+        "{0}: merged {1} lists: visited {2} entries, returned {3}",
+        activityId,
+        sortedLists_.size(),
+        visitedCount,
+        pager_.Entries.size());
+
+    sortedLists_.clear();
+
+    return move(pager_);
+}
+
 //
 // Template specializations
 //
@@ -56,6 +56,8 @@ namespace ServiceModel
         DENY_COPY(MergedQueryListPager)
 
     public:
+        typedef std::function<TKey(TEntry const &)> KeySelector;
+
         MergedQueryListPager();
         ~MergedQueryListPager();
 
@@ -75,15 +77,35 @@ namespace ServiceModel
         void Add(TKey && key, TEntry && entry);
         void Add(TKey const & key, TEntry && entry);
 
+        // Adds the results of one sub-query. Paged sub-queries return their entries in ascending key order;
+        // a list that isn't is sorted here by key. The lists are kept as they are until TakeMergedPager.
+        void AddSortedList(std::vector<TEntry> && entries, KeySelector const & keySelector);
+
         ListPager<TEntry> && TakePager(Common::ActivityId const & activityId);
 
+        // Merges the lists added with AddSortedList in key order, keeping the first entry added for duplicate keys.
+        // The merge stops as soon as the pager is full or the merged continuation token is passed,
+        // so only the entries that are returned are visited and have their health state updated.
+        ListPager<TEntry> && TakeMergedPager(
+            Common::ActivityId const & activityId,
+            std::map<TKey, FABRIC_HEALTH_STATE> const & healthStates);
+
         void UpdateHealthStates(
             Common::ActivityId const & activityId,
             std::map<TKey, FABRIC_HEALTH_STATE> const & healthStates);
 
     private:
+        struct SortedList
+        {
+            std::vector<TEntry> Entries;
+            // Keys in ascending order, with the index of their entry
+            std::vector<std::pair<TKey, size_t>> Keys;
+            size_t Next;
+        };
+
         ListPager<TEntry> pager_;
         std::unique_ptr<TKey> mergedContinuationTokenData_;
         std::map<TKey, TEntry> sortedResults_;
+        std::vector<SortedList> sortedLists_;
     };
 }
@@ -8,7 +8,7 @@
 namespace TxnReplicator
 {
 
-#define TR_GLOBAL_SETTINGS_COUNT 9
+#define TR_GLOBAL_SETTINGS_COUNT 10
 #define TR_OVERRIDABLE_STATIC_SETTINGS_COUNT 8
 #define TR_OVERRIDABLE_DYNAMIC_SETTINGS_COUNT 10
 #define TR_OVERRIDABLE_SETTINGS_COUNT (TR_OVERRIDABLE_STATIC_SETTINGS_COUNT + TR_OVERRIDABLE_DYNAMIC_SETTINGS_COUNT)
@@ -72,6 +72,8 @@ namespace TxnReplicator
             double get_TestLogDelayProcessExitRatio() const; \
             __declspec(property(get=get_FlushedRecordsTraceVectorSize)) int64 FlushedRecordsTraceVectorSize ; \
             int64 get_FlushedRecordsTraceVectorSize() const; \
+            __declspec(property(get=get_EnablePipelinedLogFlush)) bool EnablePipelinedLogFlush ; \
+            bool get_EnablePipelinedLogFlush() const; \
 
 #define DEFINE_GET_TR_CONFIG_METHOD() \
             void GetTransactionalReplicatorSettingsStructValues(TxnReplicator::TRConfigValues & config) const \
@@ -98,6 +100,7 @@ namespace TxnReplicator
                 config.CopyBatchSizeInKb = static_cast<DWORD>(this->CopyBatchSizeInKb); \
                 config.ProgressVectorMaxEntries = static_cast<DWORD>(this->ProgressVectorMaxEntries); \
                 config.FlushedRecordsTraceVectorSize = static_cast<DWORD>(this->FlushedRecordsTraceVectorSize); \
+                config.EnablePipelinedLogFlush = this->EnablePipelinedLogFlush; \
                 config.Test_LogMinDelayIntervalMilliseconds = static_cast<DWORD>(this->Test_LogMinDelayIntervalMilliseconds); \
                 config.Test_LogMaxDelayIntervalMilliseconds = static_cast<DWORD>(this->Test_LogMaxDelayIntervalMilliseconds); \
                 config.Test_LogDelayRatio = static_cast<DWORD>(this->Test_LogDelayRatio); \
@@ -129,6 +132,7 @@ namespace TxnReplicator
             int64 copyBatchSizeInKb_; \
             int64 progressVectorMaxEntries_; \
             int64 flushedRecordsTraceVectorSize_; \
+            bool enablePipelinedLogFlush_; \
             std::wstring test_LoggingEngine_; \
             int64 test_LogMinDelayIntervalMilliseconds_; \
             int64 test_LogMaxDelayIntervalMilliseconds_; \
@@ -158,7 +162,11 @@ namespace TxnReplicator
             INTERNAL_CONFIG_ENTRY(uint, section_name, MaxStreamSizeInMB, 1024, Common::ConfigEntryUpgradePolicy::Static); \
             INTERNAL_CONFIG_ENTRY(uint, section_name, ProgressVectorMaxEntries, 800, Common::ConfigEntryUpgradePolicy::Dynamic); \
             INTERNAL_CONFIG_ENTRY(uint, section_name, FlushedRecordsTraceVectorSize, 32, Common::ConfigEntryUpgradePolicy::Static); \
+            INTERNAL_CONFIG_ENTRY(bool, section_name, EnablePipelinedLogFlush, true, Common::ConfigEntryUpgradePolicy::Static); \
             INTERNAL_CONFIG_ENTRY(uint, section_name, SerializationVersion, 0, Common::ConfigEntryUpgradePolicy::Static); \
+            /* Checkpoint file merges of the stores in the process, read by TStore */ \
+            INTERNAL_CONFIG_ENTRY(uint, section_name, MergeIoBudgetInMBPerSecond, 0, Common::ConfigEntryUpgradePolicy::Static); \
+            INTERNAL_CONFIG_ENTRY(bool, section_name, EnableMergePlanner, false, Common::ConfigEntryUpgradePolicy::Static); \
             TEST_CONFIG_ENTRY(std::wstring, section_name, Test_LoggingEngine, L"ktl", Common::ConfigEntryUpgradePolicy::NotAllowed); \
             TEST_CONFIG_ENTRY(uint, section_name, Test_LogMinDelayIntervalMilliseconds, 0, Common::ConfigEntryUpgradePolicy::Dynamic); \
             TEST_CONFIG_ENTRY(uint, section_name, Test_LogMaxDelayIntervalMilliseconds, 0, Common::ConfigEntryUpgradePolicy::Dynamic); \
@@ -189,6 +197,7 @@ namespace TxnReplicator
             INTERNAL_CONFIG_ENTRY(Common::TimeSpan, section_name, SlowLogIOHealthReportTTL, Common::TimeSpan::FromSeconds(60), Common::ConfigEntryUpgradePolicy::Dynamic); \
             INTERNAL_CONFIG_ENTRY(uint, section_name, ProgressVectorMaxEntries, 800, Common::ConfigEntryUpgradePolicy::Dynamic); \
             INTERNAL_CONFIG_ENTRY(uint, section_name, FlushedRecordsTraceVectorSize, 32, Common::ConfigEntryUpgradePolicy::Static); \
+            INTERNAL_CONFIG_ENTRY(bool, section_name, EnablePipelinedLogFlush, true, Common::ConfigEntryUpgradePolicy::Static); \
             TEST_CONFIG_ENTRY(std::wstring, section_name, Test_LoggingEngine, L"ktl", Common::ConfigEntryUpgradePolicy::NotAllowed); \
             TEST_CONFIG_ENTRY(uint, section_name, Test_LogMinDelayIntervalMilliseconds, 0, Common::ConfigEntryUpgradePolicy::Dynamic); \
             TEST_CONFIG_ENTRY(uint, section_name, Test_LogMaxDelayIntervalMilliseconds, 0, Common::ConfigEntryUpgradePolicy::Dynamic); \
@@ -115,13 +115,40 @@ ErrorCode TSComponent::FromNtStatus(StringLiteral const & tag, NTSTATUS status)
     }
 }
 
+void TSComponent::SplitKey(
+    KString::SPtr const & kString,
+    __out KeyView & result)
+{
+    wchar_t const * buffer = static_cast<wchar_t *>(*kString);
+    size_t length = kString->Length();
+
+    result.Type = buffer;
+
+    auto delimiter = char_traits<wchar_t>::find(buffer, length, TypeKeyDelimiter->front());
+    if (delimiter == nullptr)
+    {
+        result.TypeLength = length;
+        result.Key = buffer + length;
+        result.KeyLength = 0;
+    }
+    else
+    {
+        result.TypeLength = delimiter - buffer;
+        result.Key = delimiter + 1;
+        result.KeyLength = length - result.TypeLength - 1;
+    }
+}
+
 void TSComponent::SplitKey(
     KString::SPtr const & kString,
     __out wstring & type,
     __out wstring & key)
 {
-    wstring input = this->ToWString(kString);
-    StringUtility::SplitOnce(input, type, key, *TypeKeyDelimiter);
+    KeyView view;
+    this->SplitKey(kString, view);
+
+    type.assign(view.Type, view.TypeLength);
+    key.assign(view.Key, view.KeyLength);
 }
 
 ErrorCode TSComponent::CreateKey(
@@ -137,8 +164,19 @@ ErrorCode TSComponent::CreateKey(
             wformatString("type='{0}' contains reserved character'{1}'", type, TypeKeyDelimiter));
     }
 
-    auto kKey = wformatString("{0}{1}{2}", type, TypeKeyDelimiter, key);
-    auto status = KString::Create(result, allocator, kKey.c_str());
+    // Sized up front so that the key is built with a single allocation
+    auto length = type.size() + TypeKeyDelimiter->size() + key.size() + 1;
+    auto status = KString::Create(result, allocator, static_cast<ULONG>(length));
+    if (NT_SUCCESS(status))
+    {
+        if (!result->Concat(KStringView(type.c_str()))
+            || !result->Concat(KStringView(TypeKeyDelimiter->c_str()))
+            || !result->Concat(KStringView(key.c_str()))
+            || !result->SetNullTerminator())
+        {
+            status = STATUS_INSUFFICIENT_RESOURCES;
+        }
+    }
 
     return this->FromNtStatus("CreateKey", status);
 }
@@ -75,6 +75,18 @@ namespace Store
         // Key/Value entry conversion
         //
 
+        // Type and key parts of a composite key, pointing into the key's own buffer
+        struct KeyView
+        {
+            KeyView() : Type(nullptr), TypeLength(0), Key(nullptr), KeyLength(0) { }
+
+            wchar_t const * Type;
+            size_t TypeLength;
+            wchar_t const * Key;
+            size_t KeyLength;
+        };
+
+        void SplitKey(KString::SPtr const &, __out KeyView &);
         void SplitKey(KString::SPtr const &, __out std::wstring & type, __out std::wstring & key);
         Common::ErrorCode CreateKey(wstring const & type, wstring const & key, __in KAllocator &, __out KString::SPtr &);
 
@@ -23,6 +23,8 @@ TSEnumerationBase::TSEnumerationBase(
     , targetKeyPrefix_(keyPrefix)
     , strictPrefix_(strictPrefix)
     , isInnerEnumInitialized_(false)
+    , currentKeyString_()
+    , isCurrentTypeAndKeyInitialized_(false)
     , currentType_()
     , currentKey_()
 {
@@ -56,42 +58,48 @@ ErrorCode TSEnumerationBase::InnerMoveNext()
     //
     while (this->OnInnerMoveNext())
     {
-        auto kString = this->OnGetCurrentKey();
+        currentKeyString_ = this->OnGetCurrentKey();
+        isCurrentTypeAndKeyInitialized_ = false;
 
-        this->SplitKey(kString, currentType_, currentKey_);
+        KeyView current;
+        this->SplitKey(currentKeyString_, current);
 
         WriteNoise(
             this->GetTraceComponent(), 
-            "{0} MoveNext: raw='{1}' type='{2}' key='{3}'",
+            "{0} MoveNext: type='{1}' key='{2}'",
             this->GetTraceId(),
-            wstring(static_cast<wchar_t *>(*kString), kString->Length()),
-            currentType_,
-            currentKey_);
+            WStringLiteral(current.Type, current.Type + current.TypeLength),
+            WStringLiteral(current.Key, current.Key + current.KeyLength));
+
+        // Same ordinal ordering as comparing the split std::wstrings, without building them
+        int targetTypeCompare = targetType_.compare(0, wstring::npos, current.Type, current.TypeLength);
 
         if (!isInnerEnumInitialized_)
         {
-            if (currentType_ < targetType_)
+            if (targetTypeCompare > 0)
             {
                 continue;
             }
-            else if (currentType_ > targetType_)
+            else if (targetTypeCompare < 0)
             {
                 break;
             }
 
-            if (currentKey_ < targetKeyPrefix_)
+            if (targetKeyPrefix_.compare(0, wstring::npos, current.Key, current.KeyLength) > 0)
             {
                 continue;
             }
 
             isInnerEnumInitialized_ = true;
         }
-        else if (currentType_ != targetType_)
+        else if (targetTypeCompare != 0)
         {
             break;
         }
 
-        if (!strictPrefix_ || StringUtility::StartsWith(currentKey_, targetKeyPrefix_))
+        if (!strictPrefix_ || 
+            (current.KeyLength >= targetKeyPrefix_.size() &&
+             char_traits<wchar_t>::compare(current.Key, targetKeyPrefix_.c_str(), targetKeyPrefix_.size()) == 0))
         {
             return ErrorCodeValue::Success;
         }
@@ -101,6 +109,8 @@ ErrorCode TSEnumerationBase::InnerMoveNext()
         }
     }
 
+    currentKeyString_ = nullptr;
+
     WriteNoise(
         this->GetTraceComponent(), 
         "{0} enumeration completed",
@@ -108,3 +118,12 @@ ErrorCode TSEnumerationBase::InnerMoveNext()
             
     return ErrorCodeValue::EnumerationCompleted;
 }
+
+void TSEnumerationBase::InitializeCurrentTypeAndKey()
+{
+    if (!isCurrentTypeAndKeyInitialized_ && currentKeyString_ != nullptr)
+    {
+        this->SplitKey(currentKeyString_, currentType_, currentKey_);
+        isCurrentTypeAndKeyInitialized_ = true;
+    }
+}
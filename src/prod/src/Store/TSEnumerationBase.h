@@ -33,8 +33,8 @@ namespace Store
             
         std::wstring const & GetTargetType() { return targetType_; }
         std::wstring const & GetTargetKeyPrefix() { return targetKeyPrefix_; }
-        std::wstring const & GetCurrentType() { return currentType_; }
-        std::wstring const & GetCurrentKey() { return currentKey_; }
+        std::wstring const & GetCurrentType() { this->InitializeCurrentTypeAndKey(); return currentType_; }
+        std::wstring const & GetCurrentKey() { this->InitializeCurrentTypeAndKey(); return currentKey_; }
 
     protected:
 
@@ -51,12 +51,17 @@ namespace Store
 
     private:
         Common::ErrorCode InnerMoveNext();
+        void InitializeCurrentTypeAndKey();
 
         std::wstring targetType_;
         std::wstring targetKeyPrefix_;
         bool strictPrefix_;
 
         bool isInnerEnumInitialized_;
+
+        // The type and key strings are only built when asked for; skipped entries never allocate
+        KString::SPtr currentKeyString_;
+        bool isCurrentTypeAndKeyInitialized_;
         std::wstring currentType_;
         std::wstring currentKey_;
     };
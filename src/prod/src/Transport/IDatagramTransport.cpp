@@ -64,6 +64,11 @@ namespace
     {
         // create a dedicated EventLoopPool for isolation
         eventLoopPool = new EventLoopPool(L"Transport");
+        if (TransportConfig::GetConfig().EventLoopRunToCompletion)
+        {
+            eventLoopPool->SetRunToCompletion(TransportConfig::GetConfig().EventLoopBusyPollDuration);
+        }
+
         return TRUE;
     }
 }
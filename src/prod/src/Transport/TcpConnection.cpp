@@ -2267,7 +2267,8 @@ void TcpConnection::RegisterEvtLoopIn()
         socket_.GetHandle(),
         EPOLLIN,
         eventLoopDispatchReadAsync_,
-        [this] (int sd, uint evts) { ReadEvtCallback(sd, evts); });
+        [this] (int sd, uint evts) { ReadEvtCallback(sd, evts); },
+        true);
 }
 
 void TcpConnection::RegisterEvtLoopOut()
@@ -2276,7 +2277,8 @@ void TcpConnection::RegisterEvtLoopOut()
         socket_.GetHandle(),
         EPOLLOUT,
         eventLoopDispatchWriteAsync_,
-        [this] (int sd, uint evts) { WriteEvtCallback(sd, evts); });
+        [this] (int sd, uint evts) { WriteEvtCallback(sd, evts); },
+        true);
 }
 
 void TcpConnection::UnregisterEvtLoopIn(bool waitForCallback)
@@ -139,6 +139,11 @@ namespace Transport
         DEPRECATED_CONFIG_ENTRY(uint, L"Transport", EventLoopConcurrency, 0, Common::ConfigEntryUpgradePolicy::Static);
         // Cleanup delay for fd context used in event loop
         DEPRECATED_CONFIG_ENTRY(Common::TimeSpan, L"Transport", EventLoopCleanupDelay, Common::TimeSpan::FromSeconds(120), Common::ConfigEntryUpgradePolicy::Static, Common::TimeSpanGreaterThan(Common::TimeSpan::Zero));
+        // Linux only, whether the default transport event loops run to completion: each loop is pinned to a cpu
+        // and handles socket readiness on the loop thread instead of dispatching it to the thread pool
+        INTERNAL_CONFIG_ENTRY(bool, L"Transport", EventLoopRunToCompletion, false, Common::ConfigEntryUpgradePolicy::Static);
+        // How long a run-to-completion event loop keeps polling for events before blocking again, zero disables busy polling
+        INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"Transport", EventLoopBusyPollDuration, Common::TimeSpan::Zero, Common::ConfigEntryUpgradePolicy::Static, Common::TimeSpanNoLessThan(Common::TimeSpan::Zero));
         // Enable support for Unreliable over IPC
         INTERNAL_CONFIG_ENTRY(bool, L"Transport", UseUnreliableForRequestReply, false, Common::ConfigEntryUpgradePolicy::Static);
         // For testing IPv6 usage.  If true, transport will fail open if the endpoint is not an IPv6 address
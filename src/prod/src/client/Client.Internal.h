@@ -111,6 +111,8 @@
 #include "client/MovePrimaryResult.h"
 #include "client/MoveSecondaryResult.h"
 
+#include "client/FileSendWindow.h"
+#include "client/FileReceiveWindow.h"
 #include "client/FileSender.h"
 #include "client/FileReceiver.h"
 #include "client/FileTransferClient.h"
@@ -59,5 +59,12 @@ namespace Client
         PUBLIC_CONFIG_ENTRY(Common::TimeSpan, L"FabricClient", RetryBackoffInterval, Common::TimeSpan::FromSeconds(3), Common::ConfigEntryUpgradePolicy::Dynamic);
         // The max number of files that are transferred in parallel
         PUBLIC_CONFIG_ENTRY(uint, L"FabricClient", MaxFileSenderThreads, 10, Common::ConfigEntryUpgradePolicy::Static);
+        // The max number of file chunks sent ahead of the last chunk acknowledged by the receiver. 0 disables the window and acknowledgements.
+        INTERNAL_CONFIG_ENTRY(uint, L"FabricClient", FileTransferWindowSize, 8, Common::ConfigEntryUpgradePolicy::Dynamic);
+        // The time without any acknowledged chunk after which the sender resends from the last acknowledged chunk
+        INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"FabricClient", FileTransferAckTimeout, Common::TimeSpan::FromSeconds(30), Common::ConfigEntryUpgradePolicy::Dynamic);
+        // The number of chunks sent without any acknowledgement after which the sender waits for FileTransferAckTimeout. If nothing is acknowledged by then, the receiver
+        // is treated as not supporting the window, and the sender falls back to sending without one
+        INTERNAL_CONFIG_ENTRY(uint, L"FabricClient", FileTransferUnacknowledgedChunkLimit, 16, Common::ConfigEntryUpgradePolicy::Dynamic);
     };
 }
@@ -16,13 +16,15 @@ namespace Naming
             : sequenceNumber_(0)
             , isLast_(false)
             , bufferSize_(0)
+            , windowSize_(0)
         { 
         }
 
-        explicit FileSequenceHeader(uint64 const sequenceNumber, bool const isLast, uint64 const bufferSize) 
+        explicit FileSequenceHeader(uint64 const sequenceNumber, bool const isLast, uint64 const bufferSize, uint const windowSize = 0) 
             : sequenceNumber_(sequenceNumber)
             , isLast_(isLast)
             , bufferSize_(bufferSize)
+            , windowSize_(windowSize)
         {
         }
 
@@ -30,6 +32,7 @@ namespace Naming
             : sequenceNumber_(other.sequenceNumber_)
             , isLast_(other.isLast_)
             , bufferSize_(other.bufferSize_)
+            , windowSize_(other.windowSize_)
         {
         }
 
@@ -42,20 +45,27 @@ namespace Naming
         __declspec(property(get=get_BufferSize)) uint64 const BufferSize;
         uint64 const get_BufferSize() { return bufferSize_; }
 
+        // Number of unacknowledged chunks the sender keeps in flight. Zero when the sender
+        // does not expect FileContentAck messages from the receiver.
+        __declspec(property(get=get_WindowSize)) uint const WindowSize;
+        uint const get_WindowSize() const { return windowSize_; }
+
         void WriteTo(Common::TextWriter& w, Common::FormatOptions const&) const 
         { 
             w.Write("FileSequenceHeader{ ");
             w.Write("SequenceNumber = {0},", sequenceNumber_);
             w.Write("IsLast = {0},", isLast_);
             w.Write("BufferSize = {0},", bufferSize_);
+            w.Write("WindowSize = {0},", windowSize_);
             w.Write(" }");
         }
 
-        FABRIC_FIELDS_03(sequenceNumber_, isLast_, bufferSize_);
+        FABRIC_FIELDS_04(sequenceNumber_, isLast_, bufferSize_, windowSize_);
 
     private:
         uint64 sequenceNumber_;
         bool isLast_;
         uint64 bufferSize_;
+        uint windowSize_;
     };
 }
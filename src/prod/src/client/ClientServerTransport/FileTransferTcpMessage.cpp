@@ -16,4 +16,6 @@ GlobalWString FileTransferTcpMessage::FileContentAction = make_global<wstring>(L
 GlobalWString FileTransferTcpMessage::FileDownloadAction = make_global<wstring>(L"FileDownload");
 GlobalWString FileTransferTcpMessage::ClientOperationSuccessAction = make_global<wstring>(L"ClientOperationSuccess");
 GlobalWString FileTransferTcpMessage::ClientOperationFailureAction = make_global<wstring>(L"ClientOperationFailure");
+GlobalWString FileTransferTcpMessage::FileContentAckAction = make_global<wstring>(L"FileContentAck");
+GlobalWString FileTransferTcpMessage::FileContentResumeAction = make_global<wstring>(L"FileContentResume");
 
@@ -18,6 +18,10 @@ namespace ClientServerTransport
         // Reply action
         static Common::GlobalWString ClientOperationSuccessAction;
         static Common::GlobalWString ClientOperationFailureAction;
+
+        // Flow control actions sent by the receiver of a windowed file upload
+        static Common::GlobalWString FileContentAckAction;
+        static Common::GlobalWString FileContentResumeAction;
         
         FileTransferTcpMessage(
             std::wstring const & action,
@@ -45,6 +49,7 @@ namespace ClientServerTransport
             std::shared_ptr<std::vector<BYTE>> const & buffer,
             uint64 const sequenceNumber,
             bool const isLast,
+            uint const windowSize,
             Common::Guid const & operationId,
             Transport::Actor::Enum actor)
             : Client::ClientServerRequestMessage(action, actor, Common::ActivityId(operationId)),
@@ -52,7 +57,19 @@ namespace ClientServerTransport
             sequenceNumber_(sequenceNumber),
             isLast_(isLast)
         {
-            Headers.Add(Naming::FileSequenceHeader(sequenceNumber_, isLast_, buffer_->size()));
+            Headers.Add(Naming::FileSequenceHeader(sequenceNumber_, isLast_, buffer_->size(), windowSize));
+        }
+
+        FileTransferTcpMessage(
+            std::wstring const & action,
+            uint64 const sequenceNumber,
+            Common::Guid const & operationId,
+            Transport::Actor::Enum actor)
+            : Client::ClientServerRequestMessage(action, actor, Common::ActivityId(operationId)),
+            sequenceNumber_(sequenceNumber),
+            isLast_(false)
+        {
+            Headers.Add(Naming::FileSequenceHeader(sequenceNumber_, isLast_, 0));
         }
 
         Transport::MessageUPtr GetTcpMessage() override
@@ -89,10 +106,11 @@ namespace ClientServerTransport
             std::shared_ptr<std::vector<BYTE>> const & buffer,
             uint64 const sequenceNumber,
             bool const isLast,             
+            uint const windowSize,
             Common::Guid const & operationId, 
             Transport::Actor::Enum actor)
         { 
-            return Common::make_unique<FileTransferTcpMessage>(FileContentAction, buffer, sequenceNumber, isLast, operationId, actor);
+            return Common::make_unique<FileTransferTcpMessage>(FileContentAction, buffer, sequenceNumber, isLast, windowSize, operationId, actor);
         }    
 
         static Client::ClientServerRequestMessageUPtr GetFileDownloadMessage(
@@ -122,6 +140,24 @@ namespace ClientServerTransport
             return Common::make_unique<FileTransferTcpMessage>(ClientOperationSuccessAction, operationId, actor);
         }
 
+        // All the chunks before nextSequenceNumber have been written by the receiver
+        static Client::ClientServerRequestMessageUPtr GetFileContentAckMessage(
+            uint64 const nextSequenceNumber,
+            Common::Guid const & operationId,
+            Transport::Actor::Enum actor)
+        {
+            return Common::make_unique<FileTransferTcpMessage>(FileContentAckAction, nextSequenceNumber, operationId, actor);
+        }
+
+        // The receiver dropped chunks after a gap and asks the sender to resend from nextSequenceNumber
+        static Client::ClientServerRequestMessageUPtr GetFileContentResumeMessage(
+            uint64 const nextSequenceNumber,
+            Common::Guid const & operationId,
+            Transport::Actor::Enum actor)
+        {
+            return Common::make_unique<FileTransferTcpMessage>(FileContentResumeAction, nextSequenceNumber, operationId, actor);
+        }
+
         static bool TryGetErrorOnClientOperationFailureAction(
             Transport::Message & message,
             __out Common::ErrorCode & error)
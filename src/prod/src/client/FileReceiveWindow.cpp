@@ -0,0 +1,48 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace std;
+using namespace Client;
+
+FileReceiveWindow::FileReceiveWindow()
+    : expectedSequenceNumber_(0)
+    , resumeRequestedSequenceNumber_(numeric_limits<uint64>::max())
+{
+}
+
+FileReceiveAction::Enum FileReceiveWindow::OnReceive(uint64 sequenceNumber, uint windowSize)
+{
+    if (sequenceNumber == expectedSequenceNumber_)
+    {
+        return FileReceiveAction::Write;
+    }
+
+    if (windowSize == 0)
+    {
+        return FileReceiveAction::Fail;
+    }
+
+    if (sequenceNumber < expectedSequenceNumber_)
+    {
+        // Resent by the sender after it resumed from an older acknowledgement
+        return FileReceiveAction::DropDuplicate;
+    }
+
+    // The chunks in flight behind the gap are dropped, so the resend is requested once per gap
+    if (resumeRequestedSequenceNumber_ == expectedSequenceNumber_)
+    {
+        return FileReceiveAction::Drop;
+    }
+
+    resumeRequestedSequenceNumber_ = expectedSequenceNumber_;
+    return FileReceiveAction::RequestResume;
+}
+
+void FileReceiveWindow::OnWritten()
+{
+    ++expectedSequenceNumber_;
+}
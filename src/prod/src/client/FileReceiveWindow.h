@@ -0,0 +1,52 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Client
+{
+    namespace FileReceiveAction
+    {
+        enum Enum
+        {
+            // The chunk is the next one expected, write and acknowledge it
+            Write = 0,
+
+            // The chunk was already written, acknowledge the next expected one again
+            DropDuplicate = 1,
+
+            // Chunks were lost in between, ask the sender to resend from the next expected one
+            RequestResume = 2,
+
+            // Chunks were lost in between and a resend has already been requested
+            Drop = 3,
+
+            // The sender does not support the window and cannot resend, fail the transfer
+            Fail = 4,
+        };
+    }
+
+    //
+    // Sequencing of a file transfer on the receiver. Only accessed from the receive job queue thread.
+    //
+    class FileReceiveWindow
+    {
+        DENY_COPY(FileReceiveWindow)
+
+    public:
+        FileReceiveWindow();
+
+        __declspec(property(get=get_ExpectedSequenceNumber)) uint64 ExpectedSequenceNumber;
+        uint64 get_ExpectedSequenceNumber() const { return expectedSequenceNumber_; }
+
+        FileReceiveAction::Enum OnReceive(uint64 sequenceNumber, uint windowSize);
+
+        void OnWritten();
+
+    private:
+        uint64 expectedSequenceNumber_;
+        uint64 resumeRequestedSequenceNumber_;
+    };
+}
@@ -36,7 +36,7 @@ public:
         , destinationFullPath_(destinationFullPath)
         , tempLocation_(wformatString("{0}.{1}", destinationFullPath, SequenceNumber::GetNext()))
         , completedOrCanceled_(false)
-        , sequenceId_(0)
+        , window_()
         , fileUPtr_()
     {
         fileUPtr_ = make_unique<File>();
@@ -151,6 +151,7 @@ private:
         uint64 const sequenceId,
         bool const isLast,
         uint64 const totalBufferSize,
+        uint const windowSize,
         ISendTarget::SPtr const & sendTarget)
     {
         WriteNoise(
@@ -160,14 +161,54 @@ private:
             operationId_,
             sequenceId);
 
-        if (sequenceId_.load() != sequenceId)
+        uint64 expectedSequenceId = window_.ExpectedSequenceNumber;
+        switch (window_.OnReceive(sequenceId, windowSize))
         {
+        case FileReceiveAction::Write:
+            break;
+
+        case FileReceiveAction::DropDuplicate:
+            WriteInfo(
+                TraceComponent,
+                owner_.traceId_,
+                "{0}: Dropping duplicate file content. Expected={1}, Received={2}.",
+                operationId_,
+                expectedSequenceId,
+                sequenceId);
+
+            owner_.SendToSender(
+                sendTarget,
+                operationId_,
+                FileTransferTcpMessage::GetFileContentAckMessage(expectedSequenceId, operationId_, Actor::FileSender),
+                RemainingTime);
+            return;
+
+        case FileReceiveAction::RequestResume:
+            WriteWarning(
+                TraceComponent,
+                owner_.traceId_,
+                "{0}: Requesting resume since the sequence number is unexpected. Expected={1}, Received={2}.",
+                operationId_,
+                expectedSequenceId,
+                sequenceId);
+
+            owner_.SendToSender(
+                sendTarget,
+                operationId_,
+                FileTransferTcpMessage::GetFileContentResumeMessage(expectedSequenceId, operationId_, Actor::FileSender),
+                RemainingTime);
+            return;
+
+        case FileReceiveAction::Drop:
+            return;
+
+        default:
             WriteWarning(
                 TraceComponent,
                 owner_.traceId_,
                 "{0}: Dropping file content since the sequence number is unexpected. Expected={1}, Received={2}.",
                 operationId_,
-                sequenceId_.load(),
+                expectedSequenceId,
                 sequenceId);
 
             owner_.ReplyToSender(sendTarget, operationId_, ErrorCode(ErrorCodeValue::OperationFailed), RemainingTime);
@@ -219,7 +260,16 @@ private:
             return;
         }
 
-        sequenceId_++;
+        window_.OnWritten();
+
+        if (windowSize > 0)
+        {
+            owner_.SendToSender(
+                sendTarget,
+                operationId_,
+                FileTransferTcpMessage::GetFileContentAckMessage(sequenceId + 1, operationId_, Actor::FileSender),
+                RemainingTime);
+        }
 
         if (isLast)
         {
@@ -287,6 +337,7 @@ private:
                 sequenceHeader.SequenceNumber,
                 sequenceHeader.IsLast,
                 sequenceHeader.BufferSize,
+                sequenceHeader.WindowSize,
                 receiverContext_->ReplyTarget);
         }
     
@@ -300,7 +351,8 @@ private:
     wstring const tempLocation_;
     wstring const destinationFullPath_;
 
-    atomic_uint64 sequenceId_;
+    // Only accessed from the job queue thread
+    FileReceiveWindow window_;
 
     ExclusiveLock lock_;
     unique_ptr<File> fileUPtr_;
@@ -360,20 +412,27 @@ ErrorCode FileReceiver::ReplyToSender(Transport::ISendTarget::SPtr const & sendT
         message = FileTransferTcpMessage::GetFailureMessage(error, operationId, Transport::Actor::FileSender);
     }
 
+    return SendToSender(sendTarget, operationId, move(message), timeout);
+}
+
+ErrorCode FileReceiver::SendToSender(Transport::ISendTarget::SPtr const & sendTarget, Guid const & operationId, ClientServerRequestMessageUPtr && message, TimeSpan timeout)
+{
     if (includeClientVersionHeaderInMessage_)
     {
         message->Headers.Replace(*ClientProtocolVersionHeader::CurrentVersionHeader);
     }
 
+    wstring action = message->Action;
     auto sendError = transport_->SendOneWay(sendTarget, move(message), timeout);
     if(!sendError.IsSuccess())
     {
         WriteWarning(
             TraceComponent,
             traceId_,
-            "Failed to send reply to sender for OperationId:{0}. SendOneWay failed with {1}",
+            "Failed to send {0} to sender for OperationId:{1}. SendOneWay failed with {2}",
+            action,
             operationId,
-            error);
+            sendError);
     }
 
     return sendError;
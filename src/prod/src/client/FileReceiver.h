@@ -42,6 +42,12 @@ namespace Client
             Common::ErrorCode const & error,
             Common::TimeSpan timeout = Common::TimeSpan::MaxValue);
 
+        Common::ErrorCode SendToSender(
+            Transport::ISendTarget::SPtr const & sendTarget,
+            Common::Guid const & operationId,
+            ClientServerRequestMessageUPtr && message,
+            Common::TimeSpan timeout);
+
         class ReceiveAsyncOperation;        
     private:
         bool const includeClientVersionHeaderInMessage_;
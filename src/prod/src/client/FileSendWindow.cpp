@@ -0,0 +1,182 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace std;
+using namespace Common;
+using namespace Client;
+
+FileSendWindow::FileSendWindow(uint windowSize, uint unacknowledgedChunkLimit, StopwatchTime now)
+    : windowSize_(windowSize)
+    , unacknowledgedChunkLimit_(max(windowSize, unacknowledgedChunkLimit))
+    , isEnabled_(windowSize > 0)
+    , isAckReceived_(false)
+    , ackedSequenceNumber_(0)
+    , sendSequenceNumber_(0)
+    , lastSequenceNumber_(numeric_limits<uint64>::max())
+    , unackedBuffers_()
+    , lastAckTime_(now)
+{
+}
+
+bool FileSendWindow::ShouldDisable(StopwatchTime now, TimeSpan const ackTimeout) const
+{
+    // Before the first acknowledgement, lastAckTime_ is the time the first chunk was sent
+    return isEnabled_ &&
+        !isAckReceived_ &&
+        unackedBuffers_.size() >= unacknowledgedChunkLimit_ &&
+        now - lastAckTime_ >= ackTimeout;
+}
+
+void FileSendWindow::Disable()
+{
+    ackedSequenceNumber_ = GetNextNewSequenceNumber();
+    sendSequenceNumber_ = ackedSequenceNumber_;
+    unackedBuffers_.clear();
+    isEnabled_ = false;
+}
+
+bool FileSendWindow::TryGetResend(
+    __out uint64 & sequenceNumber,
+    __out BufferSPtr & buffer,
+    __out bool & isLast)
+{
+    if (sendSequenceNumber_ >= GetNextNewSequenceNumber())
+    {
+        return false;
+    }
+
+    sequenceNumber = sendSequenceNumber_++;
+    buffer = unackedBuffers_[sequenceNumber - ackedSequenceNumber_];
+    isLast = (sequenceNumber == lastSequenceNumber_);
+    return true;
+}
+
+bool FileSendWindow::CanSendNew() const
+{
+    if (lastSequenceNumber_ != numeric_limits<uint64>::max())
+    {
+        return false;
+    }
+
+    if (!isEnabled_)
+    {
+        return true;
+    }
+
+    return unackedBuffers_.size() < (isAckReceived_ ? windowSize_ : unacknowledgedChunkLimit_);
+}
+
+uint64 FileSendWindow::OnSendNew(BufferSPtr const & buffer, bool isLast, StopwatchTime now)
+{
+    uint64 sequenceNumber = GetNextNewSequenceNumber();
+
+    if (isEnabled_)
+    {
+        if (unackedBuffers_.empty())
+        {
+            lastAckTime_ = now;
+        }
+
+        unackedBuffers_.push_back(buffer);
+    }
+    else
+    {
+        ackedSequenceNumber_ = sequenceNumber + 1;
+    }
+
+    // A pending resume sends this chunk again once it gets to it
+    if (sendSequenceNumber_ == sequenceNumber)
+    {
+        sendSequenceNumber_ = sequenceNumber + 1;
+    }
+
+    if (isLast)
+    {
+        lastSequenceNumber_ = sequenceNumber;
+    }
+
+    return sequenceNumber;
+}
+
+void FileSendWindow::OnAck(uint64 nextSequenceNumber, StopwatchTime now)
+{
+    if (!isEnabled_) { return; }
+
+    isAckReceived_ = true;
+    AdvanceAckedSequenceNumber(nextSequenceNumber, now);
+}
+
+bool FileSendWindow::OnResume(uint64 nextSequenceNumber, StopwatchTime now)
+{
+    if (!isEnabled_) { return false; }
+
+    isAckReceived_ = true;
+    AdvanceAckedSequenceNumber(nextSequenceNumber, now);
+
+    if (ackedSequenceNumber_ != nextSequenceNumber || sendSequenceNumber_ <= nextSequenceNumber)
+    {
+        return false;
+    }
+
+    sendSequenceNumber_ = nextSequenceNumber;
+    lastAckTime_ = now;
+    return true;
+}
+
+bool FileSendWindow::TryResumeOnAckTimeout(
+    StopwatchTime now,
+    TimeSpan const ackTimeout,
+    __out TimeSpan & waitTime)
+{
+    // Without any acknowledgement, nothing is expected until the unacknowledged chunk limit is reached
+    if (!isEnabled_ ||
+        unackedBuffers_.empty() ||
+        (!isAckReceived_ && unackedBuffers_.size() < unacknowledgedChunkLimit_))
+    {
+        waitTime = TimeSpan::MaxValue;
+        return false;
+    }
+
+    auto elapsed = now - lastAckTime_;
+    if (elapsed < ackTimeout)
+    {
+        waitTime = ackTimeout - elapsed;
+        return false;
+    }
+
+    if (!isAckReceived_)
+    {
+        // Chunks sent to a receiver that never acknowledged are not resent, it may not support the window
+        waitTime = TimeSpan::Zero;
+        return false;
+    }
+
+    sendSequenceNumber_ = ackedSequenceNumber_;
+    lastAckTime_ = now;
+    return true;
+}
+
+void FileSendWindow::AdvanceAckedSequenceNumber(uint64 nextSequenceNumber, StopwatchTime now)
+{
+    if (nextSequenceNumber <= ackedSequenceNumber_)
+    {
+        return;
+    }
+
+    while (ackedSequenceNumber_ < nextSequenceNumber && !unackedBuffers_.empty())
+    {
+        unackedBuffers_.pop_front();
+        ++ackedSequenceNumber_;
+    }
+
+    if (sendSequenceNumber_ < ackedSequenceNumber_)
+    {
+        sendSequenceNumber_ = ackedSequenceNumber_;
+    }
+
+    lastAckTime_ = now;
+}
@@ -0,0 +1,108 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Client
+{
+    //
+    // Flow control of a file transfer on the sender. Keeps the chunks the receiver did not acknowledge yet,
+    // so that the transfer can resume from the last acknowledged chunk.
+    //
+    // Until the first acknowledgement arrives, up to unacknowledgedChunkLimit chunks are sent regardless of the
+    // window. A receiver that did not acknowledge any of them within the acknowledgement timeout does not support
+    // the window (older version), and the sender falls back to sending without one. The timeout keeps a receiver
+    // on a high latency link from being downgraded just because its first acknowledgement is still in flight.
+    //
+    // Not thread safe, FileSender accesses it under its lock.
+    //
+    class FileSendWindow
+    {
+        DENY_COPY(FileSendWindow)
+
+    public:
+        typedef std::shared_ptr<std::vector<BYTE>> BufferSPtr;
+
+        FileSendWindow(uint windowSize, uint unacknowledgedChunkLimit, Common::StopwatchTime now);
+
+        __declspec(property(get=get_IsEnabled)) bool IsEnabled;
+        bool get_IsEnabled() const { return isEnabled_; }
+
+        // Window advertised to the receiver, zero once the window is disabled
+        __declspec(property(get=get_WindowSize)) uint WindowSize;
+        uint get_WindowSize() const { return isEnabled_ ? windowSize_ : 0; }
+
+        __declspec(property(get=get_IsAckReceived)) bool IsAckReceived;
+        bool get_IsAckReceived() const { return isAckReceived_; }
+
+        // All the chunks before this one have been written by the receiver
+        __declspec(property(get=get_AckedSequenceNumber)) uint64 AckedSequenceNumber;
+        uint64 get_AckedSequenceNumber() const { return ackedSequenceNumber_; }
+
+        __declspec(property(get=get_SendSequenceNumber)) uint64 SendSequenceNumber;
+        uint64 get_SendSequenceNumber() const { return sendSequenceNumber_; }
+
+        __declspec(property(get=get_UnackedCount)) size_t UnackedCount;
+        size_t get_UnackedCount() const { return unackedBuffers_.size(); }
+
+        //
+        // True when the unacknowledged chunk limit is reached and the receiver did not acknowledge anything
+        // for ackTimeout since the first chunk was sent.
+        //
+        bool ShouldDisable(Common::StopwatchTime now, Common::TimeSpan const ackTimeout) const;
+
+        void Disable();
+
+        //
+        // Returns the next chunk to send again after a resume.
+        //
+        bool TryGetResend(
+            __out uint64 & sequenceNumber,
+            __out BufferSPtr & buffer,
+            __out bool & isLast);
+
+        bool CanSendNew() const;
+
+        //
+        // Records a new chunk that is sent to the receiver and returns its sequence number.
+        //
+        uint64 OnSendNew(BufferSPtr const & buffer, bool isLast, Common::StopwatchTime now);
+
+        void OnAck(uint64 nextSequenceNumber, Common::StopwatchTime now);
+
+        //
+        // Resends from nextSequenceNumber, returns false if the chunks are already acknowledged or being resent.
+        //
+        bool OnResume(uint64 nextSequenceNumber, Common::StopwatchTime now);
+
+        //
+        // Resends from the last acknowledged chunk when the receiver did not acknowledge anything for ackTimeout.
+        // Otherwise returns false and the time left to wait, TimeSpan::MaxValue if no acknowledgement is expected.
+        // Chunks sent before the first acknowledgement are never resent; once the timeout expires for them,
+        // the wait time is zero and ShouldDisable is true.
+        //
+        bool TryResumeOnAckTimeout(
+            Common::StopwatchTime now,
+            Common::TimeSpan const ackTimeout,
+            __out Common::TimeSpan & waitTime);
+
+    private:
+        uint64 GetNextNewSequenceNumber() const { return ackedSequenceNumber_ + unackedBuffers_.size(); }
+
+        void AdvanceAckedSequenceNumber(uint64 nextSequenceNumber, Common::StopwatchTime now);
+
+        uint const windowSize_;
+        uint const unacknowledgedChunkLimit_;
+        bool isEnabled_;
+        bool isAckReceived_;
+        uint64 ackedSequenceNumber_;
+        uint64 sendSequenceNumber_;
+        uint64 lastSequenceNumber_;
+
+        // Chunks from ackedSequenceNumber_ on, empty once the window is disabled
+        std::deque<BufferSPtr> unackedBuffers_;
+        Common::StopwatchTime lastAckTime_;
+    };
+}
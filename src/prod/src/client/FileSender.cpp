@@ -64,7 +64,17 @@ public:
         shouldOverwrite_(shouldOverwrite),
         progressHandler_(move(progressHandler)),
         completedOrCanceled_(false),
-        fileSize_(0)
+        fileSize_(0),
+        file_(),
+        remainingBytesToRead_(0),
+        readAheadBuffer_(),
+        readAheadError_(),
+        readAheadCompleted_(true),
+        window_(
+            ClientConfig::GetConfig().FileTransferWindowSize,
+            ClientConfig::GetConfig().FileTransferUnacknowledgedChunkLimit,
+            Stopwatch::Now()),
+        flowControlChanged_(false)
     {
     }
 
@@ -97,6 +107,39 @@ public:
         TryComplete(thisSPtr, errorCode);
     }
 
+    // All the chunks before nextSequenceNumber have been written by the receiver
+    void ProcessAck(uint64 const nextSequenceNumber)
+    {
+        {
+            AcquireExclusiveLock lock(lock_);
+            window_.OnAck(nextSequenceNumber, Stopwatch::Now());
+        }
+
+        flowControlChanged_.Set();
+    }
+
+    // The receiver dropped the chunks after a gap and expects nextSequenceNumber
+    void ProcessResume(uint64 const nextSequenceNumber)
+    {
+        {
+            AcquireExclusiveLock lock(lock_);
+
+            uint64 sendSequenceNumber = window_.SendSequenceNumber;
+            if (window_.OnResume(nextSequenceNumber, Stopwatch::Now()))
+            {
+                WriteInfo(
+                    TraceComponent,
+                    owner_.traceId_,
+                    "{0}: Resuming from SequenceNumber {1} requested by the receiver. SendSequenceNumber={2}.",
+                    operationId_,
+                    nextSequenceNumber,
+                    sendSequenceNumber);
+            }
+        }
+
+        flowControlChanged_.Set();
+    }
+
 protected:
     void OnStart(AsyncOperationSPtr const & thisSPtr)
     {
@@ -145,6 +188,7 @@ protected:
             operationId_);
 
         operationCompleted_.Set();
+        flowControlChanged_.Set();
     }
 
 private:
@@ -180,8 +224,7 @@ private:
             return;
         }
 
-        File file;
-        error = file.TryOpen(
+        error = file_.TryOpen(
             sourceFullPath_,
             FileMode::Open,
             FileAccess::Read,
@@ -200,83 +243,221 @@ private:
             return;
         }
 
-        fileSize_ = file.size();
-        size_t maxAllowedBytes = Utility::GetMessageContentThreshold();
-        int64 remainingBytesToSend = fileSize_;
-        uint64 sequenceNumber = 0;
+        fileSize_ = file_.size();
+        remainingBytesToRead_ = fileSize_;
 
         if (progressHandler.get() != nullptr)
         {
-            progressHandler->IncrementTotalTransferItems(remainingBytesToSend);
+            progressHandler->IncrementTotalTransferItems(fileSize_);
             progressHandler->IncrementTotalFiles(1);
         }
 
-        bool isLast = false;
-        while (!completedOrCanceled_.load() && !isLast)
-        {
-            DWORD bytesRead;
-
-            int bufferSize = static_cast<int>(maxAllowedBytes);
-            if (remainingBytesToSend <= numeric_limits<int>::max())
-            {
-                int remainingBytes = static_cast<int>(remainingBytesToSend);
-                if (bufferSize > remainingBytes)
-                {
-                    bufferSize = remainingBytes;
-                }
-            }
+        StartReadAhead(thisSPtr);
 
-            shared_ptr<vector<BYTE>> buffer = make_shared<vector<BYTE>>(bufferSize);
-            error = file.TryRead2(buffer->data(), bufferSize, bytesRead);
+        shared_ptr<vector<BYTE>> buffer;
+        uint64 sequenceNumber;
+        bool isLast;
+        bool isResend;
+        uint windowSize;
+        while (TryGetNextChunk(thisSPtr, buffer, sequenceNumber, isLast, isResend, windowSize, error))
+        {
+            error = UploadBytes(buffer, sequenceNumber, isLast, isResend, windowSize);
             if (!error.IsSuccess())
             {
                 WriteWarning(
                     TraceComponent,
                     owner_.traceId_,
-                    "{0}: TryRead of '{1}' failed with {2}.",
+                    "{0}: UploadBytes failed with {1}.",
                     operationId_,
-                    sourceFullPath_,
                     error);
-                this->TryComplete(thisSPtr, error);
-                return;
+                break;
             }
 
-            TESTASSERT_IF(bufferSize != static_cast<int>(bytesRead), "BufferSize should be equal to BytesRead. BufferSize={0}, BytesRead={1}", bufferSize, bytesRead);
-            if (bufferSize != static_cast<int>(bytesRead))
+            if (!isResend && progressHandler.get() != nullptr)
             {
-                buffer->resize(bytesRead);
+                progressHandler->IncrementTransferCompletedItems(buffer->size());
             }
+        }
+
+        if (!error.IsSuccess())
+        {
+            this->TryComplete(thisSPtr, error);
+        }
+
+        operationCompleted_.WaitOne();
 
-            remainingBytesToSend -= bytesRead;
-            isLast = (remainingBytesToSend == 0);
+        readAheadCompleted_.WaitOne();
+        file_.Close();
+    }
 
-            ASSERT_IF(remainingBytesToSend < 0, "remainingBytesToSend cannot be negative");
+    //
+    // Reads the next chunk on the threadpool while the previous ones are being sent. Only one read
+    // is outstanding at a time and the job queue thread waits on readAheadCompleted_ before using
+    // its results, so the file and the read-ahead members are not accessed concurrently.
+    //
+    void StartReadAhead(AsyncOperationSPtr const & thisSPtr)
+    {
+        readAheadCompleted_.Reset();
 
-            error = UploadBytes(buffer, sequenceNumber, isLast);
-            if (!error.IsSuccess())
+        Threadpool::Post([this, thisSPtr]()
+        {
+            this->ReadAhead();
+            readAheadCompleted_.Set();
+        });
+    }
+
+    void ReadAhead()
+    {
+        int bufferSize = static_cast<int>(Utility::GetMessageContentThreshold());
+        if (remainingBytesToRead_ <= numeric_limits<int>::max())
+        {
+            int remainingBytes = static_cast<int>(remainingBytesToRead_);
+            if (bufferSize > remainingBytes)
             {
-                WriteWarning(
-                    TraceComponent,
-                    owner_.traceId_,
-                    "{0}: UploadBytes failed with {1}.",
-                    operationId_,
-                    error);
-                this->TryComplete(thisSPtr, error);
-                return;
+                bufferSize = remainingBytes;
             }
+        }
 
-            if (progressHandler.get() != nullptr)
+        DWORD bytesRead;
+        auto buffer = make_shared<vector<BYTE>>(bufferSize);
+        readAheadError_ = file_.TryRead2(buffer->data(), bufferSize, bytesRead);
+        if (!readAheadError_.IsSuccess())
+        {
+            WriteWarning(
+                TraceComponent,
+                owner_.traceId_,
+                "{0}: TryRead of '{1}' failed with {2}.",
+                operationId_,
+                sourceFullPath_,
+                readAheadError_);
+            readAheadBuffer_.reset();
+            return;
+        }
+
+        TESTASSERT_IF(bufferSize != static_cast<int>(bytesRead), "BufferSize should be equal to BytesRead. BufferSize={0}, BytesRead={1}", bufferSize, bytesRead);
+        if (bufferSize != static_cast<int>(bytesRead))
+        {
+            buffer->resize(bytesRead);
+        }
+
+        remainingBytesToRead_ -= bytesRead;
+
+        ASSERT_IF(remainingBytesToRead_ < 0, "remainingBytesToRead cannot be negative");
+
+        readAheadBuffer_ = move(buffer);
+    }
+
+    //
+    // Returns the next chunk to send: the unacknowledged chunks after a resume first, then new chunks
+    // from the read-ahead while the window has room. Blocks while the window is full or everything has
+    // been sent, resending from the last acknowledged chunk when the receiver stops acknowledging.
+    // Returns false once the operation completes or the read fails.
+    //
+    bool TryGetNextChunk(
+        AsyncOperationSPtr const & thisSPtr,
+        __out shared_ptr<vector<BYTE>> & buffer,
+        __out uint64 & sequenceNumber,
+        __out bool & isLast,
+        __out bool & isResend,
+        __out uint & windowSize,
+        __out ErrorCode & error)
+    {
+        while (!completedOrCanceled_.load())
+        {
+            TimeSpan waitTime = this->RemainingTime;
+            {
+                AcquireExclusiveLock lock(lock_);
+
+                if (window_.ShouldDisable(Stopwatch::Now(), ClientConfig::GetConfig().FileTransferAckTimeout))
+                {
+                    // The receiver does not acknowledge chunks (older version). Fall back to
+                    // sending without a window, it still replies once the whole file is received.
+                    WriteInfo(
+                        TraceComponent,
+                        owner_.traceId_,
+                        "{0}: No acknowledgement received for {1} chunks within {2}. Sending without a window.",
+                        operationId_,
+                        window_.UnackedCount,
+                        ClientConfig::GetConfig().FileTransferAckTimeout);
+
+                    window_.Disable();
+                }
+
+                windowSize = window_.WindowSize;
+
+                if (window_.TryGetResend(sequenceNumber, buffer, isLast))
+                {
+                    isResend = true;
+                    return true;
+                }
+
+                if (window_.CanSendNew())
+                {
+                    break;
+                }
+
+                TimeSpan ackWaitTime;
+                if (window_.TryResumeOnAckTimeout(Stopwatch::Now(), ClientConfig::GetConfig().FileTransferAckTimeout, ackWaitTime))
+                {
+                    WriteWarning(
+                        TraceComponent,
+                        owner_.traceId_,
+                        "{0}: No acknowledgement received for {1}. Resuming from SequenceNumber {2}.",
+                        operationId_,
+                        ClientConfig::GetConfig().FileTransferAckTimeout,
+                        window_.AckedSequenceNumber);
+                    continue;
+                }
+
+                waitTime = min(waitTime, ackWaitTime);
+                flowControlChanged_.Reset();
+            }
+
+            auto remainingTime = this->RemainingTime;
+            if (remainingTime <= TimeSpan::Zero)
+            {
+                // The timer completes the operation and signals flowControlChanged_
+                flowControlChanged_.WaitOne();
+            }
+            else
             {
-                progressHandler->IncrementTransferCompletedItems(bytesRead);
+                flowControlChanged_.WaitOne(min(waitTime, remainingTime));
             }
-            
-            sequenceNumber++;
         }
 
-        operationCompleted_.WaitOne();
+        if (completedOrCanceled_.load())
+        {
+            return false;
+        }
+
+        readAheadCompleted_.WaitOne();
+
+        error = readAheadError_;
+        if (!error.IsSuccess())
+        {
+            return false;
+        }
+
+        buffer = move(readAheadBuffer_);
+        isLast = (remainingBytesToRead_ == 0);
+        isResend = false;
+
+        if (!isLast)
+        {
+            StartReadAhead(thisSPtr);
+        }
+
+        {
+            AcquireExclusiveLock lock(lock_);
+
+            sequenceNumber = window_.OnSendNew(buffer, isLast, Stopwatch::Now());
+            windowSize = window_.WindowSize;
+        }
+
+        return true;
     }
 
-    ErrorCode UploadBytes(shared_ptr<vector<BYTE>> const & buffer, uint64 const sequenceNumber, bool const isLast)
+    ErrorCode UploadBytes(shared_ptr<vector<BYTE>> const & buffer, uint64 const sequenceNumber, bool const isLast, bool const isResend, uint const windowSize)
     {
         ErrorCode error;
         do
@@ -285,17 +466,19 @@ private:
                 buffer,
                 sequenceNumber,
                 isLast,
+                windowSize,
                 operationId_,
                 Actor::FileReceiver);
-            AddRequiredHeaders(*fileContentMessage, sequenceNumber);
+            AddRequiredHeaders(*fileContentMessage, sequenceNumber, isResend);
 
             WriteNoise(
                 TraceComponent,
                 owner_.traceId_,
-                "{0}: Sending {1} bytes with SequenceNumber {2}.",
+                "{0}: Sending {1} bytes with SequenceNumber {2}. IsResend={3}.",
                 operationId_,
                 buffer->size(),
-                sequenceNumber);
+                sequenceNumber,
+                isResend);
 
             if (sendTarget_)
             {
@@ -350,10 +533,11 @@ private:
         return error;
     }
 
-    void AddRequiredHeaders(ClientServerRequestMessage & message, uint64 const sequenceNumber)
+    void AddRequiredHeaders(ClientServerRequestMessage & message, uint64 const sequenceNumber, bool const isResend)
     {
-        // Add Timeout and FileUploadRequest header only for the first message
-        if (sequenceNumber == 0)
+        // Add Timeout and FileUploadRequest header only for the first message.
+        // A resent first chunk must not start another upload on the receiver.
+        if (sequenceNumber == 0 && !isResend)
         {
             message.Headers.Replace(TimeoutHeader(this->RemainingTime));
             message.Headers.Replace(FileUploadRequestHeader(serviceName_, storeRelativePath_, shouldOverwrite_));
@@ -394,6 +578,17 @@ private:
 
     FileSender & owner_;
     int64 fileSize_;
+
+    // Read-ahead, see StartReadAhead
+    File file_;
+    int64 remainingBytesToRead_;
+    shared_ptr<vector<BYTE>> readAheadBuffer_;
+    ErrorCode readAheadError_;
+    ManualResetEvent readAheadCompleted_;
+
+    // Flow control, protected by lock_
+    FileSendWindow window_;
+    ManualResetEvent flowControlChanged_;
 };
 
 FileSender::FileSender(
@@ -511,6 +706,30 @@ void FileSender::ProcessMessage(Transport::MessageUPtr && message, ReceiverConte
     {
         sendOperation->ProcessReply(operation, ErrorCodeValue::Success);
     }
+    else if (message->Action == FileTransferTcpMessage::FileContentAckAction ||
+        message->Action == FileTransferTcpMessage::FileContentResumeAction)
+    {
+        Naming::FileSequenceHeader sequenceHeader;
+        if (!message->Headers.TryReadFirst(sequenceHeader))
+        {
+            WriteWarning(
+                TraceComponent,
+                traceId_,
+                "Dropping message for OperationId:{0} with Action:{1}. Failed to get FileSequenceHeader.",
+                operationId,
+                message->Action);
+            return;
+        }
+
+        if (message->Action == FileTransferTcpMessage::FileContentAckAction)
+        {
+            sendOperation->ProcessAck(sequenceHeader.SequenceNumber);
+        }
+        else
+        {
+            sendOperation->ProcessResume(sequenceHeader.SequenceNumber);
+        }
+    }
     else
     {
         WriteWarning(
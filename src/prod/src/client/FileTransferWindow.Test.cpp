@@ -0,0 +1,315 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+namespace ClientTest
+{
+    using namespace Common;
+    using namespace Client;
+    using namespace std;
+
+    class FileTransferWindowTest
+    {
+    protected:
+        static FileSendWindow::BufferSPtr CreateBuffer(BYTE value)
+        {
+            return make_shared<vector<BYTE>>(1, value);
+        }
+
+        static void SendNew(FileSendWindow & window, uint64 expectedSequenceNumber, bool isLast, StopwatchTime now)
+        {
+            VERIFY_IS_TRUE(window.CanSendNew());
+            VERIFY_ARE_EQUAL(expectedSequenceNumber, window.OnSendNew(CreateBuffer(static_cast<BYTE>(expectedSequenceNumber)), isLast, now));
+        }
+
+        static void VerifyResend(FileSendWindow & window, uint64 expectedSequenceNumber, bool expectedIsLast)
+        {
+            uint64 sequenceNumber;
+            FileSendWindow::BufferSPtr buffer;
+            bool isLast;
+            VERIFY_IS_TRUE(window.TryGetResend(sequenceNumber, buffer, isLast));
+            VERIFY_ARE_EQUAL(expectedSequenceNumber, sequenceNumber);
+            VERIFY_ARE_EQUAL(static_cast<BYTE>(expectedSequenceNumber), (*buffer)[0]);
+            VERIFY_ARE_EQUAL(expectedIsLast, isLast);
+        }
+
+        static void VerifyNoResend(FileSendWindow & window)
+        {
+            uint64 sequenceNumber;
+            FileSendWindow::BufferSPtr buffer;
+            bool isLast;
+            VERIFY_IS_FALSE(window.TryGetResend(sequenceNumber, buffer, isLast));
+        }
+
+        static void Write(FileReceiveWindow & window, uint64 sequenceNumber, uint windowSize)
+        {
+            VERIFY_ARE_EQUAL(FileReceiveAction::Write, window.OnReceive(sequenceNumber, windowSize));
+            window.OnWritten();
+        }
+    };
+
+    BOOST_FIXTURE_TEST_SUITE(FileTransferWindowTestSuite, FileTransferWindowTest)
+
+    BOOST_AUTO_TEST_CASE(AckOpensWindow)
+    {
+        StopwatchTime now = Stopwatch::Now();
+        FileSendWindow window(2, 4, now);
+        VERIFY_ARE_EQUAL(2u, window.WindowSize);
+
+        SendNew(window, 0, false, now);
+        window.OnAck(1, now);
+        VERIFY_IS_TRUE(window.IsAckReceived);
+        VERIFY_ARE_EQUAL(1u, window.AckedSequenceNumber);
+        VERIFY_ARE_EQUAL(0u, window.UnackedCount);
+
+        SendNew(window, 1, false, now);
+        SendNew(window, 2, false, now);
+        VERIFY_IS_FALSE(window.CanSendNew());
+
+        // Acknowledgements that do not move forward are ignored
+        window.OnAck(1, now);
+        VERIFY_ARE_EQUAL(2u, window.UnackedCount);
+        VERIFY_IS_FALSE(window.CanSendNew());
+
+        window.OnAck(2, now);
+        VERIFY_ARE_EQUAL(1u, window.UnackedCount);
+        SendNew(window, 3, true, now);
+        VERIFY_IS_FALSE(window.CanSendNew());
+
+        window.OnAck(4, now);
+        VERIFY_ARE_EQUAL(4u, window.AckedSequenceNumber);
+        VERIFY_ARE_EQUAL(0u, window.UnackedCount);
+
+        // Everything is sent
+        VERIFY_IS_FALSE(window.CanSendNew());
+        VerifyNoResend(window);
+    }
+
+    BOOST_AUTO_TEST_CASE(ResumeAfterLostChunk)
+    {
+        StopwatchTime now = Stopwatch::Now();
+        FileSendWindow sender(4, 4, now);
+        FileReceiveWindow receiver;
+
+        for (uint64 i = 0; i < 4; ++i)
+        {
+            SendNew(sender, i, i == 3, now);
+        }
+
+        // Chunk 1 is lost, the receiver requests a resend once for the gap and drops the chunks behind it
+        Write(receiver, 0, sender.WindowSize);
+        sender.OnAck(1, now);
+        VERIFY_ARE_EQUAL(FileReceiveAction::RequestResume, receiver.OnReceive(2, sender.WindowSize));
+        VERIFY_ARE_EQUAL(FileReceiveAction::Drop, receiver.OnReceive(3, sender.WindowSize));
+        VERIFY_ARE_EQUAL(1u, receiver.ExpectedSequenceNumber);
+
+        VERIFY_IS_TRUE(sender.OnResume(receiver.ExpectedSequenceNumber, now));
+        VerifyResend(sender, 1, false);
+        VerifyResend(sender, 2, false);
+        VerifyResend(sender, 3, true);
+        VerifyNoResend(sender);
+
+        for (uint64 i = 1; i < 4; ++i)
+        {
+            Write(receiver, i, sender.WindowSize);
+            sender.OnAck(receiver.ExpectedSequenceNumber, now);
+        }
+
+        VERIFY_ARE_EQUAL(4u, sender.AckedSequenceNumber);
+        VERIFY_ARE_EQUAL(0u, sender.UnackedCount);
+    }
+
+    BOOST_AUTO_TEST_CASE(DuplicateChunk)
+    {
+        StopwatchTime now = Stopwatch::Now();
+        FileSendWindow sender(4, 4, now);
+        FileReceiveWindow receiver;
+
+        SendNew(sender, 0, false, now);
+        SendNew(sender, 1, true, now);
+
+        Write(receiver, 0, sender.WindowSize);
+        Write(receiver, 1, sender.WindowSize);
+
+        // Chunk 0 is delivered again, it is dropped and the next expected chunk is acknowledged again
+        VERIFY_ARE_EQUAL(FileReceiveAction::DropDuplicate, receiver.OnReceive(0, sender.WindowSize));
+        VERIFY_ARE_EQUAL(2u, receiver.ExpectedSequenceNumber);
+
+        sender.OnAck(receiver.ExpectedSequenceNumber, now);
+        sender.OnAck(1, now);
+        VERIFY_ARE_EQUAL(2u, sender.AckedSequenceNumber);
+        VERIFY_ARE_EQUAL(2u, sender.SendSequenceNumber);
+        VerifyNoResend(sender);
+    }
+
+    BOOST_AUTO_TEST_CASE(LostFirstChunk)
+    {
+        StopwatchTime now = Stopwatch::Now();
+        FileSendWindow sender(4, 4, now);
+        FileReceiveWindow receiver;
+
+        SendNew(sender, 0, false, now);
+        SendNew(sender, 1, true, now);
+
+        // Nothing was acknowledged yet, the resume request is what tells the sender the window is supported
+        VERIFY_ARE_EQUAL(FileReceiveAction::RequestResume, receiver.OnReceive(1, sender.WindowSize));
+        VERIFY_IS_TRUE(sender.OnResume(receiver.ExpectedSequenceNumber, now));
+        VERIFY_IS_TRUE(sender.IsAckReceived);
+
+        VerifyResend(sender, 0, false);
+        VerifyResend(sender, 1, true);
+
+        Write(receiver, 0, sender.WindowSize);
+        Write(receiver, 1, sender.WindowSize);
+        sender.OnAck(receiver.ExpectedSequenceNumber, now);
+        VERIFY_ARE_EQUAL(0u, sender.UnackedCount);
+    }
+
+    BOOST_AUTO_TEST_CASE(AckTimeoutResendsFromLastAck)
+    {
+        StopwatchTime now = Stopwatch::Now();
+        TimeSpan ackTimeout = TimeSpan::FromSeconds(30);
+        FileSendWindow sender(2, 2, now);
+        TimeSpan waitTime;
+
+        SendNew(sender, 0, false, now);
+        SendNew(sender, 1, false, now);
+
+        // Chunks sent before any acknowledgement are not resent on timeout
+        VERIFY_IS_FALSE(sender.TryResumeOnAckTimeout(now + TimeSpan::FromSeconds(10), ackTimeout, waitTime));
+        VERIFY_ARE_EQUAL(TimeSpan::FromSeconds(20), waitTime);
+        VERIFY_IS_FALSE(sender.TryResumeOnAckTimeout(now + TimeSpan::FromSeconds(60), ackTimeout, waitTime));
+        VERIFY_ARE_EQUAL(TimeSpan::Zero, waitTime);
+
+        sender.OnAck(1, now);
+        SendNew(sender, 2, false, now);
+        VERIFY_IS_FALSE(sender.CanSendNew());
+
+        VERIFY_IS_FALSE(sender.TryResumeOnAckTimeout(now + TimeSpan::FromSeconds(10), ackTimeout, waitTime));
+        VERIFY_ARE_EQUAL(TimeSpan::FromSeconds(20), waitTime);
+
+        VERIFY_IS_TRUE(sender.TryResumeOnAckTimeout(now + ackTimeout, ackTimeout, waitTime));
+        VerifyResend(sender, 1, false);
+        VerifyResend(sender, 2, false);
+        VerifyNoResend(sender);
+    }
+
+    BOOST_AUTO_TEST_CASE(ReceiverWithoutWindowSupport)
+    {
+        StopwatchTime now = Stopwatch::Now();
+        TimeSpan ackTimeout = TimeSpan::FromSeconds(30);
+        FileSendWindow sender(2, 4, now);
+
+        // The window does not apply until the receiver acknowledges, only the unacknowledged chunk limit does
+        for (uint64 i = 0; i < 4; ++i)
+        {
+            VERIFY_IS_FALSE(sender.ShouldDisable(now + ackTimeout, ackTimeout));
+            SendNew(sender, i, false, now);
+        }
+
+        VERIFY_IS_FALSE(sender.CanSendNew());
+
+        // The first acknowledgement may still be in flight
+        VERIFY_IS_FALSE(sender.ShouldDisable(now + TimeSpan::FromSeconds(10), ackTimeout));
+        VERIFY_IS_TRUE(sender.ShouldDisable(now + ackTimeout, ackTimeout));
+
+        sender.Disable();
+        VERIFY_IS_FALSE(sender.IsEnabled);
+        VERIFY_ARE_EQUAL(0u, sender.WindowSize);
+        VERIFY_ARE_EQUAL(0u, sender.UnackedCount);
+        VERIFY_ARE_EQUAL(4u, sender.AckedSequenceNumber);
+        VerifyNoResend(sender);
+
+        // Without the window, chunks are sent one after the other and nothing is kept for resend
+        SendNew(sender, 4, false, now);
+        SendNew(sender, 5, true, now);
+        VERIFY_IS_FALSE(sender.CanSendNew());
+        VERIFY_ARE_EQUAL(0u, sender.UnackedCount);
+
+        sender.OnAck(3, now);
+        VERIFY_IS_FALSE(sender.OnResume(3, now));
+        VerifyNoResend(sender);
+    }
+
+    BOOST_AUTO_TEST_CASE(SmallFileToReceiverWithoutWindowSupport)
+    {
+        StopwatchTime now = Stopwatch::Now();
+        FileSendWindow sender(2, 4, now);
+        TimeSpan waitTime;
+
+        SendNew(sender, 0, false, now);
+        SendNew(sender, 1, true, now);
+
+        // The whole file is sent below the limit, the sender waits for the reply without resending
+        VERIFY_IS_FALSE(sender.CanSendNew());
+        VERIFY_IS_FALSE(sender.ShouldDisable(now + TimeSpan::FromMinutes(10), TimeSpan::FromSeconds(30)));
+        VERIFY_IS_FALSE(sender.TryResumeOnAckTimeout(now + TimeSpan::FromMinutes(10), TimeSpan::FromSeconds(30), waitTime));
+        VERIFY_ARE_EQUAL(TimeSpan::MaxValue, waitTime);
+        VerifyNoResend(sender);
+    }
+
+    BOOST_AUTO_TEST_CASE(HighLatencyReceiver)
+    {
+        StopwatchTime now = Stopwatch::Now();
+        TimeSpan ackTimeout = TimeSpan::FromSeconds(30);
+        FileSendWindow sender(2, 4, now);
+        TimeSpan waitTime;
+
+        for (uint64 i = 0; i < 4; ++i)
+        {
+            SendNew(sender, i, false, now);
+        }
+
+        // The limit is reached before the first acknowledgement arrives, the sender waits for it
+        VERIFY_IS_FALSE(sender.CanSendNew());
+        VERIFY_IS_FALSE(sender.ShouldDisable(now + TimeSpan::FromSeconds(5), ackTimeout));
+        VERIFY_IS_FALSE(sender.TryResumeOnAckTimeout(now + TimeSpan::FromSeconds(5), ackTimeout, waitTime));
+        VERIFY_ARE_EQUAL(TimeSpan::FromSeconds(25), waitTime);
+
+        sender.OnAck(2, now + TimeSpan::FromSeconds(5));
+        VERIFY_IS_TRUE(sender.IsEnabled);
+        VERIFY_IS_FALSE(sender.ShouldDisable(now + TimeSpan::FromMinutes(10), ackTimeout));
+        VERIFY_ARE_EQUAL(2u, sender.WindowSize);
+        VERIFY_ARE_EQUAL(2u, sender.UnackedCount);
+
+        // Once acknowledged, the window applies
+        VERIFY_IS_FALSE(sender.CanSendNew());
+        sender.OnAck(4, now + TimeSpan::FromSeconds(6));
+        SendNew(sender, 4, true, now + TimeSpan::FromSeconds(6));
+    }
+
+    BOOST_AUTO_TEST_CASE(SenderWithoutWindowSupport)
+    {
+        FileReceiveWindow receiver;
+
+        Write(receiver, 0, 0);
+
+        // The sender cannot resend, so an unexpected chunk fails the transfer
+        VERIFY_ARE_EQUAL(FileReceiveAction::Fail, receiver.OnReceive(2, 0));
+        VERIFY_ARE_EQUAL(FileReceiveAction::Fail, receiver.OnReceive(0, 0));
+        VERIFY_ARE_EQUAL(1u, receiver.ExpectedSequenceNumber);
+    }
+
+    BOOST_AUTO_TEST_CASE(WindowDisabledByConfig)
+    {
+        StopwatchTime now = Stopwatch::Now();
+        FileSendWindow sender(0, 4, now);
+
+        VERIFY_IS_FALSE(sender.IsEnabled);
+        VERIFY_ARE_EQUAL(0u, sender.WindowSize);
+        VERIFY_IS_FALSE(sender.ShouldDisable(now + TimeSpan::FromMinutes(10), TimeSpan::FromSeconds(30)));
+
+        SendNew(sender, 0, false, now);
+        SendNew(sender, 1, false, now);
+        VERIFY_ARE_EQUAL(0u, sender.UnackedCount);
+        VERIFY_ARE_EQUAL(2u, sender.AckedSequenceNumber);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+}
@@ -0,0 +1,354 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <stdlib.h>
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+namespace Data
+{
+    namespace Integration
+    {
+        using namespace Common;
+        using namespace ktl;
+        using namespace Data::Utilities;
+        using namespace Data::TStore;
+        using namespace TxnReplicator;
+
+        StringLiteral const TraceComponent("LogFlushPerfTest");
+        std::wstring const TestLogFileName(L"LogFlushPerfTest.log");
+
+        //
+        // Measures the commit latency and throughput of the physical log writer for an increasing number of
+        // concurrent writers. Compare runs with [TransactionalReplicator2] EnablePipelinedLogFlush set to
+        // true and false in data.integration.test.exe.cfg to see the effect of the flush pipeline.
+        //
+        class LogFlushPerfTest
+        {
+        public:
+            Awaitable<void> Run(
+                __in wstring const & workFolder,
+                __in int concurrentWriters,
+                __in int transactionsPerWriter,
+                __in Data::Log::LogManager & logManager);
+
+        protected:
+            wstring CreateFileName(
+                __in wstring const & folderName);
+
+            void InitializeKtlConfig(
+                __in std::wstring workDir,
+                __in std::wstring fileName,
+                __in KAllocator & allocator,
+                __out KtlLogger::SharedLogSettingsSPtr & sharedLogSettings);
+
+            KUri::CSPtr GetStateProviderName(
+                __in int stateProviderIndex);
+
+            void EndTest();
+
+            void RunWithConcurrency(
+                __in wstring const & testName,
+                __in int concurrentWriters,
+                __in int transactionsPerWriter);
+
+            Awaitable<void> WriteKey(
+                __in IStore<int, int>::SPtr store,
+                __in Replica::SPtr replica,
+                __in int key,
+                __in int numberOfUpdates,
+                __inout vector<int64> & commitLatenciesInTicks);
+
+            static int64 GetPercentile(
+                __in vector<int64> const & sortedValues,
+                __in int percentile);
+
+            CommonConfig config; // load the config object as its needed for the tracing to work
+            KtlSystem * underlyingSystem_;
+
+            KGuid pId_;
+            FABRIC_REPLICA_ID rId_;
+            PartitionedReplicaId::SPtr prId_;
+        };
+
+        Awaitable<void> LogFlushPerfTest::WriteKey(
+            __in IStore<int, int>::SPtr store,
+            __in Replica::SPtr replica,
+            __in int key,
+            __in int numberOfUpdates,
+            __inout vector<int64> & commitLatenciesInTicks)
+        {
+            for (int i = 0; i < numberOfUpdates; i++)
+            {
+                TxnReplicator::Transaction::SPtr innerTx;
+                replica->TxnReplicator->CreateTransaction(innerTx);
+                IStoreTransaction<int, int>::SPtr tx = nullptr;
+
+                store->CreateOrFindTransaction(*innerTx, tx);
+                tx->ReadIsolationLevel = StoreTransactionReadIsolationLevel::Enum::Snapshot;
+
+                if (i == 0)
+                {
+                    co_await store->AddAsync(
+                        *tx,
+                        key,
+                        i,
+                        TimeSpan::MaxValue,
+                        CancellationToken::None);
+                }
+                else
+                {
+                    co_await store->ConditionalUpdateAsync(
+                        *tx,
+                        key,
+                        i,
+                        TimeSpan::MaxValue,
+                        CancellationToken::None,
+                        i - 1);
+                }
+
+                // Only the commit waits for the log flush
+                Stopwatch commitWatch;
+                commitWatch.Start();
+
+                co_await innerTx->CommitAsync();
+
+                commitWatch.Stop();
+                commitLatenciesInTicks.push_back(commitWatch.ElapsedTicks);
+
+                innerTx->Dispose();
+            }
+
+            co_return;
+        }
+
+        Awaitable<void> LogFlushPerfTest::Run(
+            __in wstring const & testFolder,
+            __in int concurrentWriters,
+            __in int transactionsPerWriter,
+            __in Data::Log::LogManager & logManager)
+        {
+#ifndef PERF_TEST
+            UNREFERENCED_PARAMETER(testFolder);
+            UNREFERENCED_PARAMETER(concurrentWriters);
+            UNREFERENCED_PARAMETER(transactionsPerWriter);
+            UNREFERENCED_PARAMETER(logManager);
+#else
+            Replica::SPtr replica = Replica::Create(
+                pId_,
+                rId_,
+                testFolder,
+                logManager,
+                underlyingSystem_->PagedAllocator());
+
+            co_await replica->OpenAsync();
+
+            FABRIC_EPOCH epoch1; epoch1.DataLossNumber = 1; epoch1.ConfigurationNumber = 1; epoch1.Reserved = nullptr;
+            co_await replica->ChangeRoleAsync(epoch1, FABRIC_REPLICA_ROLE_PRIMARY);
+
+            replica->SetReadStatus(FABRIC_SERVICE_PARTITION_ACCESS_STATUS_GRANTED);
+            replica->SetWriteStatus(FABRIC_SERVICE_PARTITION_ACCESS_STATUS_GRANTED);
+
+            KUri::CSPtr stateProviderName = GetStateProviderName(0);
+            {
+                Transaction::SPtr txn;
+                replica->TxnReplicator->CreateTransaction(txn);
+                KFinally([&] {txn->Dispose(); });
+
+                NTSTATUS status = co_await replica->TxnReplicator->AddAsync(*txn, *stateProviderName, L"LogFlushPerfTest");
+                VERIFY_IS_TRUE(NT_SUCCESS(status));
+                co_await txn->CommitAsync();
+            }
+
+            {
+                IStateProvider2::SPtr stateProvider2;
+                NTSTATUS status = replica->TxnReplicator->Get(*stateProviderName, stateProvider2);
+                VERIFY_IS_TRUE(NT_SUCCESS(status));
+                VERIFY_IS_NOT_NULL(stateProvider2);
+
+                IStore<int, int>::SPtr store = dynamic_cast<IStore<int, int>*>(stateProvider2.RawPtr());
+
+                // Each writer records its own latencies so no synchronization is needed while running
+                vector<vector<int64>> commitLatencies(concurrentWriters);
+                for (int i = 0; i < concurrentWriters; i++)
+                {
+                    commitLatencies[i].reserve(transactionsPerWriter);
+                }
+
+                Stopwatch s;
+                s.Start();
+
+                KArray<Awaitable<void>> tasks(underlyingSystem_->PagedAllocator(), concurrentWriters, 0);
+
+                for (int i = 0; i < concurrentWriters; i++)
+                {
+                    status = tasks.Append(WriteKey(store, replica, i, transactionsPerWriter, commitLatencies[i]));
+                    KInvariant(NT_SUCCESS(status));
+                }
+
+                co_await TaskUtilities<Awaitable<void>>::WhenAll(tasks);
+
+                s.Stop();
+
+                vector<int64> allLatencies;
+                allLatencies.reserve(concurrentWriters * transactionsPerWriter);
+                for (int i = 0; i < concurrentWriters; i++)
+                {
+                    allLatencies.insert(allLatencies.end(), commitLatencies[i].begin(), commitLatencies[i].end());
+                }
+
+                sort(allLatencies.begin(), allLatencies.end());
+
+                int64 totalTransactions = static_cast<int64>(allLatencies.size());
+                int64 txPerSec = (totalTransactions * 1000) / (s.ElapsedMilliseconds + 1);
+
+                Trace.WriteInfo(
+                    TraceComponent,
+                    "{0}: Writers: {1} Transactions: {2} Tx/Sec: {3} Commit latency us p50: {4} p90: {5} p99: {6} max: {7}",
+                    prId_->TraceId,
+                    concurrentWriters,
+                    totalTransactions,
+                    txPerSec,
+                    TimeSpan::FromTicks(GetPercentile(allLatencies, 50)).TotalMilliseconds() * 1000,
+                    TimeSpan::FromTicks(GetPercentile(allLatencies, 90)).TotalMilliseconds() * 1000,
+                    TimeSpan::FromTicks(GetPercentile(allLatencies, 99)).TotalMilliseconds() * 1000,
+                    TimeSpan::FromTicks(GetPercentile(allLatencies, 100)).TotalMilliseconds() * 1000);
+            }
+
+            replica->SetReadStatus(FABRIC_SERVICE_PARTITION_ACCESS_STATUS_NOT_PRIMARY);
+            replica->SetWriteStatus(FABRIC_SERVICE_PARTITION_ACCESS_STATUS_NOT_PRIMARY);
+
+            co_await replica->CloseAsync();
+#endif
+            co_return;
+        }
+
+        int64 LogFlushPerfTest::GetPercentile(
+            __in vector<int64> const & sortedValues,
+            __in int percentile)
+        {
+            if (sortedValues.empty())
+            {
+                return 0;
+            }
+
+            size_t index = (sortedValues.size() * percentile) / 100;
+            return sortedValues[min(index, sortedValues.size() - 1)];
+        }
+
+        void LogFlushPerfTest::RunWithConcurrency(
+            __in wstring const & testName,
+            __in int concurrentWriters,
+            __in int transactionsPerWriter)
+        {
+            wstring testFolderPath = CreateFileName(testName);
+
+            // Pre-clean up
+            Directory::Delete_WithRetry(testFolderPath, true, true);
+
+            wstring workFolder = Path::Combine(testFolderPath, L"work");
+
+            TEST_TRACE_BEGIN(testName)
+            {
+                KtlLogger::SharedLogSettingsSPtr sharedLogSettings;
+                InitializeKtlConfig(testFolderPath, TestLogFileName, underlyingSystem_->NonPagedAllocator(), sharedLogSettings);
+
+                Data::Log::LogManager::SPtr logManager;
+                status = Data::Log::LogManager::Create(underlyingSystem_->NonPagedAllocator(), logManager);
+                CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+                status = SyncAwait(logManager->OpenAsync(CancellationToken::None, sharedLogSettings));
+                CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+                SyncAwait(Run(workFolder, concurrentWriters, transactionsPerWriter, *logManager));
+
+                status = SyncAwait(logManager->CloseAsync(CancellationToken::None));
+                CODING_ERROR_ASSERT(NT_SUCCESS(status));
+                logManager = nullptr;
+            }
+
+            // Post-clean up
+            Directory::Delete_WithRetry(testFolderPath, true, true);
+        }
+
+        wstring LogFlushPerfTest::CreateFileName(
+            __in wstring const & folderName)
+        {
+            wstring testFolderPath = Directory::GetCurrentDirectoryW();
+            Path::CombineInPlace(testFolderPath, folderName);
+
+            return testFolderPath;
+        }
+
+        void LogFlushPerfTest::EndTest()
+        {
+            prId_.Reset();
+        }
+
+        void LogFlushPerfTest::InitializeKtlConfig(
+            __in std::wstring workDir,
+            __in std::wstring fileName,
+            __in KAllocator & allocator,
+            __out KtlLogger::SharedLogSettingsSPtr & sharedLogSettings)
+        {
+            auto settings = std::make_unique<KtlLogManager::SharedLogContainerSettings>();
+
+            KString::SPtr sharedLogFileName = KPath::CreatePath(workDir.c_str(), allocator);
+            KPath::CombineInPlace(*sharedLogFileName, fileName.c_str());
+
+            if (!Common::Directory::Exists(workDir))
+            {
+                Common::Directory::Create(workDir);
+            }
+
+            KInvariant(sharedLogFileName->LengthInBytes() + sizeof(WCHAR) < 512 * sizeof(WCHAR)); // check to make sure there is space for the null terminator
+            KMemCpySafe(&settings->Path[0], 512 * sizeof(WCHAR), sharedLogFileName->operator PVOID(), sharedLogFileName->LengthInBytes());
+            settings->Path[sharedLogFileName->LengthInBytes() / sizeof(WCHAR)] = L'\0'; // set the null terminator
+            settings->LogContainerId.GetReference().CreateNew();
+            settings->LogSize = 1024 * 1024 * 512; // 512 MB.
+            settings->MaximumNumberStreams = 0;
+            settings->MaximumRecordSize = 0;
+            sharedLogSettings = make_shared<KtlLogger::SharedLogSettings>(std::move(settings));
+        };
+
+        KUri::CSPtr LogFlushPerfTest::GetStateProviderName(
+            __in int stateProviderIndex)
+        {
+            wstring stateProviderName = wformatString(L"fabric:/store/{0}", stateProviderIndex);
+
+            KUri::CSPtr spName;
+            NTSTATUS status = KUri::Create(KStringView(stateProviderName.c_str()), underlyingSystem_->PagedAllocator(), spName);
+            if (NT_SUCCESS(status) == false)
+            {
+                throw Exception(status);
+            }
+
+            return spName;
+        }
+
+        BOOST_FIXTURE_TEST_SUITE(LogFlushPerfTestSuite, LogFlushPerfTest);
+
+        BOOST_AUTO_TEST_CASE(CommitLatency_SingleWriter)
+        {
+            // Every commit waits for its own flush, no group commit
+            RunWithConcurrency(L"CommitLatency_SingleWriter", 1, 20000);
+        }
+
+        BOOST_AUTO_TEST_CASE(CommitLatency_16Writers)
+        {
+            RunWithConcurrency(L"CommitLatency_16Writers", 16, 5000);
+        }
+
+        BOOST_AUTO_TEST_CASE(CommitLatency_256Writers)
+        {
+            // Records keep arriving while a flush is outstanding
+            RunWithConcurrency(L"CommitLatency_256Writers", 256, 500);
+        }
+
+        BOOST_AUTO_TEST_SUITE_END();
+    }
+}
@@ -110,6 +110,76 @@ typedef HRESULT(*pfnStore_ContainsKeyAsync)(
     __in void* ctx,
     __out BOOL* synchronousComplete);
 
+typedef HRESULT(*pfnBuffer_Create)(
+    __in StateProviderHandle stateProvider,
+    __in uint32_t length,
+    __out Buffer* buffer);
+
+typedef HRESULT(*pfnStore_AddAsync2)(
+    __in StateProviderHandle stateProvider,
+    __in TransactionHandle txn,
+    __in Store_Key const* key,
+    __in size_t objectHandle,
+    __in BufferHandle value,
+    __in int64_t timeout,
+    __out CancellationTokenSourceHandle* cts,
+    __in fnNotifyAsyncCompletion callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete);
+
+typedef HRESULT(*pfnStore_ConditionalUpdateAsync2)(
+    __in StateProviderHandle stateProvider,
+    __in TransactionHandle txn,
+    __in Store_Key const* key,
+    __in size_t objectHandle,
+    __in BufferHandle value,
+    __in int64_t timeout,
+    __out CancellationTokenSourceHandle* cts,
+    __in int64_t conditionalVersion,
+    __out BOOL* updated,
+    __in fnNotifyUpdateAsyncCompletion callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete);
+
+typedef HRESULT(*pfnStore_ConditionalGetAsync2)(
+    __in StateProviderHandle stateProvider,
+    __in TransactionHandle txn,
+    __in Store_Key const* key,
+    __in int64_t timeout,
+    __in Store_LockMode lockMode,
+    __out size_t* objectHandle,
+    __out Buffer* value,
+    __out int64_t* versionSequenceNumber,
+    __out CancellationTokenSourceHandle* cts,
+    __out BOOL* found,
+    __in fnNotifyGetAsyncCompletion2 callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete);
+
+typedef HRESULT(*pfnStore_ConditionalRemoveAsync2)(
+    __in StateProviderHandle stateProvider,
+    __in TransactionHandle txn,
+    __in Store_Key const* key,
+    __in int64_t timeout,
+    __out CancellationTokenSourceHandle* cts,
+    __in int64_t conditionalVersion,
+    __out BOOL* removed,
+    __in fnNotifyRemoveAsyncCompletion callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete);
+
+typedef HRESULT(*pfnStore_ContainsKeyAsync2)(
+    __in StateProviderHandle stateProvider,
+    __in TransactionHandle txn,
+    __in Store_Key const* key,
+    __in int64_t timeout,
+    __in Store_LockMode lockMode,
+    __out CancellationTokenSourceHandle* cts,
+    __out BOOL* found,
+    __in fnNotifyContainsKeyAsyncCompletion callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete);
+
 typedef void (*pfnTransaction_Release)(
     __in TransactionHandle txn);
 
@@ -380,6 +450,12 @@ struct ReliableCollectionApis
     pfnTransaction_Release Transaction_Release2;
     pfnStore_CreateRangedEnumeratorAsync Store_CreateRangedEnumeratorAsync;
     pfnStore_ContainsKeyAsync Store_ContainsKeyAsync;
+    pfnBuffer_Create Buffer_Create;
+    pfnStore_AddAsync2 Store_AddAsync2;
+    pfnStore_ConditionalUpdateAsync2 Store_ConditionalUpdateAsync2;
+    pfnStore_ConditionalGetAsync2 Store_ConditionalGetAsync2;
+    pfnStore_ConditionalRemoveAsync2 Store_ConditionalRemoveAsync2;
+    pfnStore_ContainsKeyAsync2 Store_ContainsKeyAsync2;
 };
 
 extern "C" HRESULT FabricGetReliableCollectionApiTable(
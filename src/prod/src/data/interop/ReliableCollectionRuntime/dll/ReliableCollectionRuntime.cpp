@@ -292,6 +292,141 @@ extern "C" HRESULT Store_ContainsKeyAsync(
         synchronousComplete);
 }
 
+extern "C" HRESULT Store_AddAsync2(
+    __in StateProviderHandle stateProvider,
+    __in TransactionHandle txn,
+    __in Store_Key const* key,
+    __in size_t objectHandle,
+    __in BufferHandle value,
+    __in int64_t timeout,
+    __out CancellationTokenSourceHandle* cts,
+    __in fnNotifyAsyncCompletion callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete)
+{
+    return g_reliableCollectionApis.Store_AddAsync2(
+        stateProvider,
+        txn,
+        key,
+        objectHandle,
+        value,
+        timeout,
+        cts,
+        callback,
+        ctx,
+        synchronousComplete);
+}
+
+extern "C" HRESULT Store_ConditionalUpdateAsync2(
+    __in StateProviderHandle stateProvider,
+    __in TransactionHandle txn,
+    __in Store_Key const* key,
+    __in size_t objectHandle,
+    __in BufferHandle value,
+    __in int64_t timeout,
+    __out CancellationTokenSourceHandle* cts,
+    __in int64_t conditionalVersion,
+    __out BOOL* updated,
+    __in fnNotifyUpdateAsyncCompletion callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete)
+{
+    return g_reliableCollectionApis.Store_ConditionalUpdateAsync2(
+        stateProvider,
+        txn,
+        key,
+        objectHandle,
+        value,
+        timeout,
+        cts,
+        conditionalVersion,
+        updated,
+        callback,
+        ctx,
+        synchronousComplete);
+}
+
+extern "C" HRESULT Store_ConditionalGetAsync2(
+    __in StateProviderHandle stateProvider,
+    __in TransactionHandle txn,
+    __in Store_Key const* key,
+    __in int64_t timeout,
+    __in Store_LockMode lockMode,
+    __out size_t* objectHandle,
+    __out Buffer* value,
+    __out int64_t* versionSequenceNumber,
+    __out CancellationTokenSourceHandle* cts,
+    __out BOOL* found,
+    __in fnNotifyGetAsyncCompletion2 callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete)
+{
+    return g_reliableCollectionApis.Store_ConditionalGetAsync2(
+        stateProvider,
+        txn,
+        key,
+        timeout,
+        lockMode,
+        objectHandle,
+        value,
+        versionSequenceNumber,
+        cts,
+        found,
+        callback,
+        ctx,
+        synchronousComplete);
+}
+
+extern "C" HRESULT Store_ConditionalRemoveAsync2(
+    __in StateProviderHandle stateProvider,
+    __in TransactionHandle txn,
+    __in Store_Key const* key,
+    __in int64_t timeout,
+    __out CancellationTokenSourceHandle* cts,
+    __in int64_t conditionalVersion,
+    __out BOOL* removed,
+    __in fnNotifyRemoveAsyncCompletion callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete)
+{
+    return g_reliableCollectionApis.Store_ConditionalRemoveAsync2(
+        stateProvider,
+        txn,
+        key,
+        timeout,
+        cts,
+        conditionalVersion,
+        removed,
+        callback,
+        ctx,
+        synchronousComplete);
+}
+
+extern "C" HRESULT Store_ContainsKeyAsync2(
+    __in StateProviderHandle stateProvider,
+    __in TransactionHandle txn,
+    __in Store_Key const* key,
+    __in int64_t timeout,
+    __in Store_LockMode lockMode,
+    __out CancellationTokenSourceHandle* cts,
+    __out BOOL* found,
+    __in fnNotifyContainsKeyAsyncCompletion callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete)
+{
+    return g_reliableCollectionApis.Store_ContainsKeyAsync2(
+        stateProvider,
+        txn,
+        key,
+        timeout,
+        lockMode,
+        cts,
+        found,
+        callback,
+        ctx,
+        synchronousComplete);
+}
+
 extern "C" HRESULT Store_SetNotifyStoreChangeCallback(
     __in StateProviderHandle stateProvider,
     __in fnNotifyStoreChangeCallback callback,
@@ -673,6 +808,14 @@ extern "C" void Buffer_Release(BufferHandle handle)
     g_reliableCollectionApis.Buffer_Release(handle);
 }
 
+extern "C" HRESULT Buffer_Create(
+    __in StateProviderHandle stateProvider,
+    __in uint32_t length,
+    __out Buffer* buffer)
+{
+    return g_reliableCollectionApis.Buffer_Create(stateProvider, length, buffer);
+}
+
 extern "C" HRESULT StateProvider_GetInfo(
     __in StateProviderHandle stateProviderHandle,
     __in LPCWSTR lang,
@@ -161,7 +161,8 @@ enum TxnReplicator_Settings_Flags : uint64_t
 enum StateProvider_Kind : uint32_t
 {
     StateProvider_Kind_Store = 1,
-    StateProvider_Kind_ConcurrentQueue
+    StateProvider_Kind_ConcurrentQueue,
+    StateProvider_Kind_BinaryKeyStore
 };
 
 struct StateProvider_Info
@@ -343,6 +344,104 @@ extern "C"
         __in void* ctx,
         __out BOOL* synchronousComplete);
 
+    //
+    // Keys of a StateProvider_Kind_Store are null terminated UTF-16 strings. Keys of a
+    // StateProvider_Kind_BinaryKeyStore are opaque byte arrays ordered by unsigned byte comparison,
+    // so callers that need a custom order must use an order-preserving encoding.
+    //
+    enum Store_KeyKind : uint32_t
+    {
+        Store_KeyKind_String,
+        Store_KeyKind_Bytes
+    };
+
+    struct Store_Key
+    {
+        Store_KeyKind Kind;
+        void const* Bytes;                   // LPCWSTR for Store_KeyKind_String
+        uint32_t Length;                     // byte count, ignored for Store_KeyKind_String
+    };
+
+    //
+    // Allocates a value buffer that the *Async2 write apis adopt without copying. Bytes points at
+    // Length writable bytes; the buffer is owned by the caller until it is passed to a write api or
+    // released with Buffer_Release.
+    //
+    CLASS_DECLSPEC HRESULT Buffer_Create(
+        __in StateProviderHandle store,
+        __in uint32_t length,
+        __out Buffer* buffer);
+
+    // Takes ownership of value whether or not the call succeeds.
+    CLASS_DECLSPEC HRESULT Store_AddAsync2(
+        __in StateProviderHandle store,
+        __in TransactionHandle txn,
+        __in Store_Key const* key,
+        __in size_t objectHandle,
+        __in BufferHandle value,             // buffer allocated by Buffer_Create
+        __in int64_t timeout,
+        __out CancellationTokenSourceHandle* cts,
+        __in fnNotifyAsyncCompletion callback,
+        __in void* ctx,
+        __out BOOL* synchronousComplete);
+
+    // Takes ownership of value whether or not the call succeeds.
+    CLASS_DECLSPEC HRESULT Store_ConditionalUpdateAsync2(
+        __in StateProviderHandle store,
+        __in TransactionHandle txn,
+        __in Store_Key const* key,
+        __in size_t objectHandle,
+        __in BufferHandle value,             // buffer allocated by Buffer_Create
+        __in int64_t timeout,
+        __out CancellationTokenSourceHandle* cts,
+        __in int64_t conditionalVersion,
+        __out BOOL* updated,
+        __in fnNotifyUpdateAsyncCompletion callback,
+        __in void* ctx,
+        __out BOOL* synchronousComplete);
+
+    // value->Handle is lent to the callee, which must release it with Buffer_Release.
+    typedef void(*fnNotifyGetAsyncCompletion2)(void* ctx, HRESULT status, BOOL r, size_t objectHandle, Buffer* value, int64_t versionSequenceNumber);
+
+    CLASS_DECLSPEC HRESULT Store_ConditionalGetAsync2(
+        __in StateProviderHandle store,
+        __in TransactionHandle txn,
+        __in Store_Key const* key,
+        __in int64_t timeout,
+        __in Store_LockMode lockMode,
+        __out size_t* objectHandle,
+        __out Buffer* value,
+        __out int64_t* versionSequenceNumber,
+        __out CancellationTokenSourceHandle* cts,
+        __out BOOL* found,
+        __in fnNotifyGetAsyncCompletion2 callback,
+        __in void* ctx,
+        __out BOOL* synchronousComplete);
+
+    CLASS_DECLSPEC HRESULT Store_ConditionalRemoveAsync2(
+        __in StateProviderHandle store,
+        __in TransactionHandle txn,
+        __in Store_Key const* key,
+        __in int64_t timeout,
+        __out CancellationTokenSourceHandle* cts,
+        __in int64_t conditionalVersion,
+        __out BOOL* removed,
+        __in fnNotifyRemoveAsyncCompletion callback,
+        __in void* ctx,
+        __out BOOL* synchronousComplete);
+
+    CLASS_DECLSPEC HRESULT Store_ContainsKeyAsync2(
+        __in StateProviderHandle store,
+        __in TransactionHandle txn,
+        __in Store_Key const* key,
+        __in int64_t timeout,
+        __in Store_LockMode lockMode,
+        __out CancellationTokenSourceHandle* cts,
+        __out BOOL* found,
+        __in fnNotifyContainsKeyAsyncCompletion callback,
+        __in void* ctx,
+        __out BOOL* synchronousComplete);
+
     /*************************************
     * StateProvider APIs
     *************************************/
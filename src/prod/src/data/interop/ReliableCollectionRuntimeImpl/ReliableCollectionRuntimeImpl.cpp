@@ -61,7 +61,13 @@ void GetReliableCollectionImplApiTable(ReliableCollectionApis* reliableCollectio
         Transaction_Dispose,
         Transaction_Release2,
         Store_CreateRangedEnumeratorAsync,
-        Store_ContainsKeyAsync
+        Store_ContainsKeyAsync,
+        Buffer_Create,
+        Store_AddAsync2,
+        Store_ConditionalUpdateAsync2,
+        Store_ConditionalGetAsync2,
+        Store_ConditionalRemoveAsync2,
+        Store_ContainsKeyAsync2
     };
 }
 
@@ -719,6 +719,136 @@ namespace Data
             }
         }
 
+        BOOST_AUTO_TEST_CASE(Store_BinaryKey_AddAsync2_ConditionalGetAsync2_SUCCESS)
+        {
+            wstring testName(L"Store_BinaryKey_AddAsync2_ConditionalGetAsync2_SUCCESS");
+
+            TEST_TRACE_BEGIN(testName)
+            {
+                NTSTATUS status;
+                LONG64 count = 0;
+                Buffer value;
+                Buffer newValue;
+                BOOL found = false;
+                size_t objectHandle;
+                LONG64 versionSequenceNumber;
+                ktl::CancellationTokenSource* cts;
+                BOOL synchronouscomplete;
+                IStateProvider2::SPtr stateProvider;
+                KUri::CSPtr stateProviderName = GetStateProviderName(9);
+
+                {
+                    Transaction::SPtr txn;
+                    status = replica_->TxnReplicator->CreateTransaction(txn);
+                    THROW_ON_FAILURE(status);
+                    KFinally([&] {txn->Dispose(); });
+
+                    // Encoded StateProviderInfo of a StateProvider_Kind_BinaryKeyStore
+                    status = SyncAwait(replica_->TxnReplicator->AddAsync(*txn, *stateProviderName, L"0\1\3\n"));
+                    THROW_ON_FAILURE(status);
+
+                    status = SyncAwait(txn->CommitAsync());
+                    THROW_ON_FAILURE(status);
+                }
+
+                status = replica_->TxnReplicator->Get(*stateProviderName, stateProvider);
+                VERIFY_IS_TRUE(NT_SUCCESS(status));
+                VERIFY_IS_NOT_NULL(stateProvider);
+
+                byte keyBytes[] = { 0x00, 0xff, 0x10 };
+                Store_Key key = { Store_KeyKind_Bytes, keyBytes, sizeof(keyBytes) };
+                Store_Key stringKey = { Store_KeyKind_String, L"key1", 0 };
+                char const payload[] = "value1";
+
+                HRESULT hresult = Buffer_Create(stateProvider.RawPtr(), sizeof(payload), &newValue);
+                VERIFY_IS_TRUE(SUCCEEDED(hresult));
+                VERIFY_IS_TRUE(newValue.Length == sizeof(payload));
+                memcpy(newValue.Bytes, payload, sizeof(payload));
+
+                {
+                    Transaction::SPtr txn;
+                    status = replica_->TxnReplicator->CreateTransaction(txn);
+                    THROW_ON_FAILURE(status);
+                    KFinally([&] {txn->Dispose(); });
+
+                    AwaitableCompletionSource<void>::SPtr acs = nullptr;
+                    AwaitableCompletionSource<void>::Create(underlyingSystem_->PagedAllocator(), TEST_CEXPORT_TAG, acs);
+
+                    // A string key is rejected by a binary key store
+                    hresult = Store_ContainsKeyAsync2(stateProvider.RawPtr(), txn.RawPtr(), &stringKey, std::numeric_limits<int64>::max(), Store_LockMode::Store_LockMode_Free, nullptr, &found,
+                        [](void*, HRESULT, BOOL) {}, nullptr, &synchronouscomplete);
+                    VERIFY_IS_TRUE(FAILED(hresult));
+
+                    hresult = Store_AddAsync2(stateProvider.RawPtr(), txn.RawPtr(), &key, 1, newValue.Handle, std::numeric_limits<int64>::max(), (CancellationTokenSourceHandle*)&cts,
+                        [](void* acsHandle, HRESULT _hresult) {
+                            AwaitableCompletionSource<void>* acs = (AwaitableCompletionSource<void>*)acsHandle;
+                            if (!SUCCEEDED(_hresult))
+                                acs->SetException(ktl::Exception(StatusConverter::Convert(_hresult)));
+                            else
+                                acs->Set();
+                        }, acs.RawPtr(), &synchronouscomplete);
+                    VERIFY_IS_TRUE(SUCCEEDED(hresult));
+
+                    if (!synchronouscomplete)
+                    {
+                        CancellationTokenSource_Release(cts);
+                        SyncAwait(acs->GetAwaitable());
+                    }
+
+                    SyncAwait(txn->CommitAsync());
+                }
+
+                Store_GetCount(stateProvider.RawPtr(), &count);
+                VERIFY_IS_TRUE(count == 1);
+
+                {
+                    Transaction::SPtr txn;
+                    status = replica_->TxnReplicator->CreateTransaction(txn);
+                    THROW_ON_FAILURE(status);
+                    KFinally([&] {txn->Dispose(); });
+
+                    AwaitableCompletionSource<tuple<bool, size_t, Buffer, LONG64>>::SPtr acs = nullptr;
+                    AwaitableCompletionSource<tuple<bool, size_t, Buffer, LONG64>>::Create(underlyingSystem_->PagedAllocator(), TEST_CEXPORT_TAG, acs);
+
+                    hresult = Store_ConditionalGetAsync2(
+                        stateProvider.RawPtr(),
+                        txn.RawPtr(),
+                        &key,
+                        std::numeric_limits<int64>::max(),
+                        Store_LockMode::Store_LockMode_Free,
+                        &objectHandle,
+                        &value,
+                        &versionSequenceNumber,
+                        (CancellationTokenSourceHandle*)&cts,
+                        &found,
+                        [](void* acsHandle, HRESULT _hresult, BOOL r, size_t handle, Buffer* buffer, LONG64 lsn) {
+                            auto acs = (AwaitableCompletionSource<tuple<bool, size_t, Buffer, LONG64>>*)acsHandle;
+                            if (!SUCCEEDED(_hresult))
+                                acs->SetException(ktl::Exception(StatusConverter::Convert(_hresult)));
+                            else
+                                acs->SetResult(make_tuple(r, handle, *buffer, lsn));
+                        }, acs.RawPtr(), &synchronouscomplete);
+                    VERIFY_IS_TRUE(SUCCEEDED(hresult));
+
+                    if (!synchronouscomplete)
+                    {
+                        CancellationTokenSource_Release(cts);
+                        tie(found, objectHandle, value, versionSequenceNumber) = SyncAwait(acs->GetAwaitable());
+                    }
+
+                    VERIFY_IS_TRUE(found);
+#ifdef FEATURE_CACHE_OBJHANDLE
+                    VERIFY_IS_TRUE(objectHandle == 1);
+#endif
+                    VERIFY_IS_TRUE(value.Length == sizeof(payload));
+                    VERIFY_IS_TRUE(memcmp(value.Bytes, payload, sizeof(payload)) == 0);
+
+                    SyncAwait(txn->CommitAsync());
+                    Buffer_Release(value.Handle);
+                }
+            }
+        }
+
         BOOST_AUTO_TEST_CASE(TxnReplicator_SetNotifyStateManagerChangeCallback_SingleEntityChanged_SUCCESS)
         {
             wstring testName(L"TxnReplicator_SetNotifyStateManagerChangeCallback_SingleEntityChanged_SUCCESS");
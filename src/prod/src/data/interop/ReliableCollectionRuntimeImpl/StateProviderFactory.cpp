@@ -18,7 +18,11 @@ NTSTATUS StateProviderFactory::Create(
     if (!storeFactory)
         return STATUS_INSUFFICIENT_RESOURCES;
 
-    StateProviderFactory* pointer = _new(RELIABLECOLLECTIONRUNTIME_TAG, allocator) StateProviderFactory(storeFactory.RawPtr());
+    StoreStateProviderFactory::SPtr binaryKeyStoreFactory = StoreStateProviderFactory::CreateBufferBufferFactory(allocator);
+    if (!binaryKeyStoreFactory)
+        return STATUS_INSUFFICIENT_RESOURCES;
+
+    StateProviderFactory* pointer = _new(RELIABLECOLLECTIONRUNTIME_TAG, allocator) StateProviderFactory(storeFactory.RawPtr(), binaryKeyStoreFactory.RawPtr());
     if (!pointer)
         return STATUS_INSUFFICIENT_RESOURCES;
 
@@ -46,6 +50,12 @@ NTSTATUS StateProviderFactory::Create(
         if (!NT_SUCCESS(status))
             return status;
     }
+    else if (stateProviderInfo->Kind == StateProviderKind::BinaryKeyStore)
+    {
+        status = CreateBufferKeyBufferValueStore(factoryArguments, stateProvider);
+        if (!NT_SUCCESS(status))
+            return status;
+    }
     else if (stateProviderInfo->Kind == StateProviderKind::ConcurrentQueue)
     {
         status = CreateBufferItemRCQ(factoryArguments, stateProvider);
@@ -79,6 +89,13 @@ NTSTATUS StateProviderFactory::CreateStringUTF16KeyBufferValueStore(
     return storeFactory_->Create(factoryArguments, stateProvider);
 }
 
+NTSTATUS StateProviderFactory::CreateBufferKeyBufferValueStore(
+    __in Data::StateManager::FactoryArguments const & factoryArguments,
+    __out TxnReplicator::IStateProvider2::SPtr & stateProvider)
+{
+    return binaryKeyStoreFactory_->Create(factoryArguments, stateProvider);
+}
+
 NTSTATUS StateProviderFactory::CreateBufferItemRCQ(
     __in Data::StateManager::FactoryArguments const & factoryArguments,
     __out TxnReplicator::IStateProvider2::SPtr & stateProvider)
@@ -89,10 +106,13 @@ NTSTATUS StateProviderFactory::CreateBufferItemRCQ(
     return STATUS_SUCCESS;
 }
 
-StateProviderFactory::StateProviderFactory(__in Data::StateManager::IStateProvider2Factory* factory)
+StateProviderFactory::StateProviderFactory(
+    __in Data::StateManager::IStateProvider2Factory* storeFactory,
+    __in Data::StateManager::IStateProvider2Factory* binaryKeyStoreFactory)
     : KObject()
     , KShared()
-    , storeFactory_(factory)
+    , storeFactory_(storeFactory)
+    , binaryKeyStoreFactory_(binaryKeyStoreFactory)
 {
 }
 
@@ -28,17 +28,24 @@ namespace Data
 
         private:
 
-            StateProviderFactory(Data::StateManager::IStateProvider2Factory* factory);
+            StateProviderFactory(
+                __in Data::StateManager::IStateProvider2Factory* storeFactory,
+                __in Data::StateManager::IStateProvider2Factory* binaryKeyStoreFactory);
 
             NTSTATUS CreateStringUTF16KeyBufferValueStore(
                 __in Data::StateManager::FactoryArguments const & factoryArguments,
                 __out TxnReplicator::IStateProvider2::SPtr & stateProvider);
 
+            NTSTATUS CreateBufferKeyBufferValueStore(
+                __in Data::StateManager::FactoryArguments const & factoryArguments,
+                __out TxnReplicator::IStateProvider2::SPtr & stateProvider);
+
             NTSTATUS CreateBufferItemRCQ(
                 __in Data::StateManager::FactoryArguments const & factoryArguments,
                 __out TxnReplicator::IStateProvider2::SPtr & stateProvider);
 
             Data::StateManager::IStateProvider2Factory::SPtr storeFactory_;
+            Data::StateManager::IStateProvider2Factory::SPtr binaryKeyStoreFactory_;
         };
     }
 }
@@ -27,10 +27,131 @@ extern "C" void Store_AddRef(
     stateProviderSPtr.Detach();
 }
 
+namespace
+{
+    NTSTATUS CreateStoreKey(
+        __in KAllocator& allocator,
+        __in Store_Key const* key,
+        __out KString::SPtr& result)
+    {
+        if (key->Kind != Store_KeyKind_String || key->Bytes == nullptr)
+            return STATUS_INVALID_PARAMETER;
+
+        return KString::Create(result, allocator, static_cast<LPCWSTR>(key->Bytes));
+    }
+
+    NTSTATUS CreateStoreKey(
+        __in KAllocator& allocator,
+        __in Store_Key const* key,
+        __out KBuffer::SPtr& result)
+    {
+        if (key->Kind != Store_KeyKind_Bytes || (key->Bytes == nullptr && key->Length > 0))
+            return STATUS_INVALID_PARAMETER;
+
+        NTSTATUS status = KBuffer::Create(key->Length, result, allocator);
+        if (!NT_SUCCESS(status))
+            return status;
+
+        if (key->Length > 0)
+            memcpy(result->GetBuffer(), key->Bytes, key->Length);
+
+        return STATUS_SUCCESS;
+    }
+
+    //
+    // Copies the caller's bytes into a new value buffer. Used by the apis that do not take a
+    // buffer allocated by Buffer_Create.
+    //
+    NTSTATUS CreateStoreValue(
+        __in KAllocator& allocator,
+        __in size_t objectHandle,
+        __in void* bytes,
+        __in uint32_t bytesLength,
+        __out KBuffer::SPtr& result)
+    {
+        ULONG kBufferLength = bytesLength;
+#ifdef FEATURE_CACHE_OBJHANDLE
+        kBufferLength += sizeof(size_t);
+#endif
+
+        NTSTATUS status = KBuffer::Create(kBufferLength, result, allocator);
+        if (!NT_SUCCESS(status))
+            return status;
+
+        auto buffer = result->GetBuffer();
+#ifdef FEATURE_CACHE_OBJHANDLE
+        *(size_t*)buffer = objectHandle;
+        buffer = (byte*)buffer + sizeof(size_t);
+#else
+        UNREFERENCED_PARAMETER(objectHandle);
+#endif
+        memcpy(buffer, bytes, bytesLength);
+
+        return STATUS_SUCCESS;
+    }
+
+    // Stamps the object handle into a buffer allocated by Buffer_Create without touching the payload.
+    NTSTATUS AdoptStoreValue(
+        __in size_t objectHandle,
+        __in KBuffer& value)
+    {
+#ifdef FEATURE_CACHE_OBJHANDLE
+        if (value.QuerySize() < sizeof(size_t))
+            return STATUS_INVALID_PARAMETER;
+
+        *(size_t*)value.GetBuffer() = objectHandle;
+#else
+        UNREFERENCED_PARAMETER(objectHandle);
+        UNREFERENCED_PARAMETER(value);
+#endif
+        return STATUS_SUCCESS;
+    }
+
+    void GetStoreValue(
+        __in KBuffer& value,
+        __out size_t& objectHandle,
+        __out char*& bytes,
+        __out uint32_t& bytesLength)
+    {
+        bytes = (char*)value.GetBuffer();
+        bytesLength = value.QuerySize();
+#ifdef FEATURE_CACHE_OBJHANDLE
+        objectHandle = *(size_t*)bytes;
+        bytes += sizeof(size_t);
+        bytesLength -= sizeof(size_t);
+#else
+        objectHandle = 0;
+#endif
+    }
+
+    //
+    // Invokes action with the store cast to its key type. Stores created for
+    // StateProvider_Kind_BinaryKeyStore are keyed by KBuffer, all others by KString.
+    //
+    template <typename TAction>
+    HRESULT InvokeOnStore(
+        __in StateProviderHandle stateProviderHandle,
+        __in TAction const& action)
+    {
+        IStateProvider2* stateProvider = reinterpret_cast<IStateProvider2*>(stateProviderHandle);
+
+        IStore<KString::SPtr, KBuffer::SPtr>* stringKeyStore = dynamic_cast<IStore<KString::SPtr, KBuffer::SPtr>*>(stateProvider);
+        if (stringKeyStore != nullptr)
+            return action(stringKeyStore);
+
+        IStore<KBuffer::SPtr, KBuffer::SPtr>* binaryKeyStore = dynamic_cast<IStore<KBuffer::SPtr, KBuffer::SPtr>*>(stateProvider);
+        if (binaryKeyStore != nullptr)
+            return action(binaryKeyStore);
+
+        return E_INVALIDARG;
+    }
+}
+
+template <typename TKey>
 ktl::Task StoreConditionalGetAsyncInternal(
-    IStore<KString::SPtr, KBuffer::SPtr>* store,
+    IStore<TKey, KBuffer::SPtr>* store,
     Transaction* txn,
-    LPCWSTR key,
+    Store_Key const* key,
     int64 timeout,
     size_t* objectHandle,
     Buffer* value,
@@ -38,20 +159,21 @@ ktl::Task StoreConditionalGetAsyncInternal(
     ktl::CancellationTokenSource** cts,
     BOOL* found,
     fnNotifyGetAsyncCompletion callback,
+    fnNotifyGetAsyncCompletion2 callback2,
     void* ctx,
     NTSTATUS& status,
     BOOL& synchronousComplete)
 {
-    KString::SPtr kstringkey;
+    TKey storeKey;
     ktl::CancellationToken cancellationToken = ktl::CancellationToken::None;
     ktl::CancellationTokenSource::SPtr cancellationTokenSource = nullptr;
     Data::KeyValuePair<LONG64, KBuffer::SPtr> kvpair(-1, nullptr);
-    KSharedPtr<IStoreTransaction<KString::SPtr, KBuffer::SPtr>> storeTxn;
+    KSharedPtr<IStoreTransaction<TKey, KBuffer::SPtr>> storeTxn;
 
     status = STATUS_SUCCESS;
     synchronousComplete = false;
 
-    status = KString::Create(kstringkey, txn->GetThisAllocator(), key);
+    status = CreateStoreKey(txn->GetThisAllocator(), key, storeKey);
     CO_RETURN_VOID_ON_FAILURE(status);
 
     EXCEPTION_TO_STATUS(store->CreateOrFindTransaction(*txn, storeTxn), status);
@@ -66,7 +188,7 @@ ktl::Task StoreConditionalGetAsyncInternal(
 
     storeTxn->ReadIsolationLevel = IsolationHelper::GetIsolationLevel(*txn, IsolationHelper::OperationType::SingleEntity);
 
-    auto awaitable = store->ConditionalGetAsync(*storeTxn, kstringkey, Common::TimeSpan::FromTicks(timeout), kvpair, cancellationToken);
+    auto awaitable = store->ConditionalGetAsync(*storeTxn, storeKey, Common::TimeSpan::FromTicks(timeout), kvpair, cancellationToken);
     if (IsComplete(awaitable))
     {
         synchronousComplete = true;
@@ -77,17 +199,7 @@ ktl::Task StoreConditionalGetAsyncInternal(
         {
             KBuffer::SPtr kBufferSptr;
             kBufferSptr = kvpair.Value;
-            char* buffer = (char*)kBufferSptr->GetBuffer();
-            uint32_t bufferLength = kBufferSptr->QuerySize();
-#ifdef FEATURE_CACHE_OBJHANDLE
-            *objectHandle = *(size_t*)buffer;
-            buffer += sizeof(size_t);
-            bufferLength -= sizeof(size_t);
-#else 
-            *objectHandle = 0;
-#endif
-            value->Bytes = buffer;
-            value->Length = bufferLength;
+            GetStoreValue(*kBufferSptr, *objectHandle, value->Bytes, value->Length);
             value->Handle = kBufferSptr.Detach();
             *versionSequenceNumber = kvpair.get_Key();
         }
@@ -101,29 +213,32 @@ ktl::Task StoreConditionalGetAsyncInternal(
     NTSTATUS ntstatus = STATUS_SUCCESS;
 
     EXCEPTION_TO_STATUS(result = co_await awaitable, ntstatus);
+
+    size_t objHandle = 0;
+    Buffer buffer = { nullptr, 0, nullptr };
+    KBuffer::SPtr kBufferSptr;
     if (result)
     {
-        size_t objHandle = 0;
-        byte* buffer = (byte*)kvpair.get_Value()->GetBuffer();
-        ULONG bufferLength = kvpair.get_Value()->QuerySize();
-#ifdef FEATURE_CACHE_OBJHANDLE
-        objHandle = *(size_t*)buffer;
-        buffer += sizeof(size_t);
-        bufferLength -= sizeof(size_t);
-#endif
-        callback(ctx, StatusConverter::ToHResult(ntstatus), result, objHandle, buffer, bufferLength, kvpair.get_Key());
+        kBufferSptr = kvpair.Value;
+        GetStoreValue(*kBufferSptr, objHandle, buffer.Bytes, buffer.Length);
+    }
+
+    if (callback2 != nullptr)
+    {
+        // The value is lent to the callee, which releases it with Buffer_Release
+        buffer.Handle = kBufferSptr.Detach();
+        callback2(ctx, StatusConverter::ToHResult(ntstatus), result, objHandle, &buffer, result ? kvpair.get_Key() : 0);
     }
     else
-        callback(ctx, StatusConverter::ToHResult(ntstatus), result, 0, nullptr, 0, 0);
+        callback(ctx, StatusConverter::ToHResult(ntstatus), result, objHandle, buffer.Bytes, buffer.Length, result ? kvpair.get_Key() : 0);
 }
 
+template <typename TKey>
 ktl::Task StoreAddAsyncInternal(
-    IStore<KString::SPtr, KBuffer::SPtr>* store, 
+    IStore<TKey, KBuffer::SPtr>* store, 
     Transaction* txn, 
-    LPCWSTR key, 
-    size_t objectHandle, 
-    void* bytes, 
-    uint32_t bytesLength, 
+    Store_Key const* key, 
+    KBuffer::SPtr value, 
     int64 timeout, 
     ktl::CancellationTokenSource** cts,
     fnNotifyAsyncCompletion callback,
@@ -131,34 +246,17 @@ ktl::Task StoreAddAsyncInternal(
     NTSTATUS& status,
     BOOL& synchronousComplete)
 {
-    ULONG kBufferLength;
-    KString::SPtr kstringkey;
-    KBuffer::SPtr bufferSptr;
+    TKey storeKey;
     ktl::CancellationToken cancellationToken = ktl::CancellationToken::None;
     ktl::CancellationTokenSource::SPtr cancellationTokenSource;
-    KSharedPtr<IStoreTransaction<KString::SPtr, KBuffer::SPtr>> storeTxn;
+    KSharedPtr<IStoreTransaction<TKey, KBuffer::SPtr>> storeTxn;
 
     status = STATUS_SUCCESS;
     synchronousComplete = false;
-    kBufferLength = bytesLength;
-
-#ifdef FEATURE_CACHE_OBJHANDLE
-    kBufferLength += sizeof(size_t);
-#endif
-
-    status = KString::Create(kstringkey, txn->GetThisAllocator(), key);
-    CO_RETURN_VOID_ON_FAILURE(status);
 
-    status = KBuffer::Create(kBufferLength, bufferSptr, txn->GetThisAllocator());
+    status = CreateStoreKey(txn->GetThisAllocator(), key, storeKey);
     CO_RETURN_VOID_ON_FAILURE(status);
 
-    auto buffer = bufferSptr->GetBuffer();
-#ifdef FEATURE_CACHE_OBJHANDLE
-    *(size_t*)buffer = objectHandle;
-    buffer = (byte*)buffer + sizeof(size_t);
-#endif
-    memcpy(buffer, bytes, bytesLength);
-
     EXCEPTION_TO_STATUS(store->CreateOrFindTransaction(*txn, storeTxn), status);
     CO_RETURN_VOID_ON_FAILURE(status);
 
@@ -169,7 +267,7 @@ ktl::Task StoreAddAsyncInternal(
         cancellationToken = cancellationTokenSource->Token;
     }
 
-    auto awaitable = store->AddAsync(*storeTxn, kstringkey, bufferSptr, Common::TimeSpan::FromTicks(timeout), cancellationToken);
+    auto awaitable = store->AddAsync(*storeTxn, storeKey, value, Common::TimeSpan::FromTicks(timeout), cancellationToken);
 
     if (IsComplete(awaitable))
     {
@@ -187,13 +285,12 @@ ktl::Task StoreAddAsyncInternal(
     callback(ctx, StatusConverter::ToHResult(ntstatus));
 }
 
+template <typename TKey>
 ktl::Task StoreConditionalUpdateAsyncInternal(
-    IStore<KString::SPtr, KBuffer::SPtr>* store,
+    IStore<TKey, KBuffer::SPtr>* store,
     Transaction* txn,
-    LPCWSTR key,
-    size_t objectHandle,
-    void* bytes,
-    uint32_t bytesLength,
+    Store_Key const* key,
+    KBuffer::SPtr value,
     int64 timeout,
     ktl::CancellationTokenSource** cts,
     LONG64 conditionalVersion,
@@ -203,36 +300,17 @@ ktl::Task StoreConditionalUpdateAsyncInternal(
     NTSTATUS& status,
     BOOL& synchronousComplete)
 {
-    ULONG kBufferLength;
-    //TODO generic key types
-    KString::SPtr kstringkey;
-    //TODO define custom value type
-    KBuffer::SPtr bufferSptr;
+    TKey storeKey;
     ktl::CancellationToken cancellationToken = ktl::CancellationToken::None;
     ktl::CancellationTokenSource::SPtr cancellationTokenSource = nullptr;
-    KSharedPtr<IStoreTransaction<KString::SPtr, KBuffer::SPtr>> storeTxn;
+    KSharedPtr<IStoreTransaction<TKey, KBuffer::SPtr>> storeTxn;
 
     status = STATUS_SUCCESS;
     synchronousComplete = false;
-    kBufferLength = bytesLength;
-
-#ifdef FEATURE_CACHE_OBJHANDLE
-    kBufferLength += sizeof(size_t);
-#endif
-
-    status = KString::Create(kstringkey, txn->GetThisAllocator(), key);
-    CO_RETURN_VOID_ON_FAILURE(status);
 
-    status = KBuffer::Create(kBufferLength, bufferSptr, txn->GetThisAllocator());
+    status = CreateStoreKey(txn->GetThisAllocator(), key, storeKey);
     CO_RETURN_VOID_ON_FAILURE(status);
 
-    auto buffer = bufferSptr->GetBuffer();
-#ifdef FEATURE_CACHE_OBJHANDLE
-    *(size_t*)buffer = objectHandle;
-    buffer = (byte*)buffer + sizeof(size_t);
-#endif
-    memcpy(buffer, bytes, bytesLength);
-
     EXCEPTION_TO_STATUS(store->CreateOrFindTransaction(*txn, storeTxn), status);
     CO_RETURN_VOID_ON_FAILURE(status);
 
@@ -243,7 +321,7 @@ ktl::Task StoreConditionalUpdateAsyncInternal(
         cancellationToken = cancellationTokenSource->Token;
     }
 
-    auto awaitable = store->ConditionalUpdateAsync(*storeTxn, kstringkey, bufferSptr, Common::TimeSpan::FromTicks(timeout), cancellationToken, conditionalVersion);
+    auto awaitable = store->ConditionalUpdateAsync(*storeTxn, storeKey, value, Common::TimeSpan::FromTicks(timeout), cancellationToken, conditionalVersion);
     if (IsComplete(awaitable))
     {
         synchronousComplete = true;
@@ -261,10 +339,11 @@ ktl::Task StoreConditionalUpdateAsyncInternal(
     callback(ctx, StatusConverter::ToHResult(ntstatus), result);
 }
 
+template <typename TKey>
 ktl::Task StoreConditionalRemoveAsyncInternal(
-    IStore<KString::SPtr, KBuffer::SPtr>* store,
+    IStore<TKey, KBuffer::SPtr>* store,
     Transaction* txn,
-    LPCWSTR key,
+    Store_Key const* key,
     int64 timeout,
     ktl::CancellationTokenSource** cts,
     LONG64 conditionalVersion,
@@ -274,15 +353,15 @@ ktl::Task StoreConditionalRemoveAsyncInternal(
     NTSTATUS& status,
     BOOL& synchronousComplete)
 {
-    KString::SPtr kstringKey;
+    TKey storeKey;
     ktl::CancellationToken cancellationToken = ktl::CancellationToken::None;
     ktl::CancellationTokenSource::SPtr ctsSPtr = nullptr;
-    IStoreTransaction<KString::SPtr, KBuffer::SPtr>::SPtr storeTxn;
+    typename IStoreTransaction<TKey, KBuffer::SPtr>::SPtr storeTxn;
 
     status = STATUS_SUCCESS;
     synchronousComplete = false;
 
-    status = KString::Create(kstringKey, txn->GetThisAllocator(), key);
+    status = CreateStoreKey(txn->GetThisAllocator(), key, storeKey);
     CO_RETURN_VOID_ON_FAILURE(status);
 
     EXCEPTION_TO_STATUS(store->CreateOrFindTransaction(*txn, storeTxn), status);
@@ -295,7 +374,7 @@ ktl::Task StoreConditionalRemoveAsyncInternal(
         cancellationToken = ctsSPtr->Token;
     }
 
-    auto awaitable = store->ConditionalRemoveAsync(*storeTxn, kstringKey, Common::TimeSpan::FromTicks(timeout), cancellationToken, conditionalVersion);
+    auto awaitable = store->ConditionalRemoveAsync(*storeTxn, storeKey, Common::TimeSpan::FromTicks(timeout), cancellationToken, conditionalVersion);
     if (IsComplete(awaitable))
     {
         synchronousComplete = true;
@@ -314,10 +393,11 @@ ktl::Task StoreConditionalRemoveAsyncInternal(
     callback(ctx, StatusConverter::ToHResult(ntstatus), isRemoved);
 }
 
+template <typename TKey>
 ktl::Task StoreContainsKeyAsyncInternal(
-    IStore<KString::SPtr, KBuffer::SPtr>* store,
+    IStore<TKey, KBuffer::SPtr>* store,
     Transaction* txn,
-    LPCWSTR key,
+    Store_Key const* key,
     int64 timeout,
     ktl::CancellationTokenSource** cts,
     BOOL* found,
@@ -326,15 +406,15 @@ ktl::Task StoreContainsKeyAsyncInternal(
     NTSTATUS& status,
     BOOL& synchronousComplete)
 {
-    KString::SPtr kstringKey;
+    TKey storeKey;
     ktl::CancellationToken cancellationToken = ktl::CancellationToken::None;
     ktl::CancellationTokenSource::SPtr ctsSPtr = nullptr;
-    IStoreTransaction<KString::SPtr, KBuffer::SPtr>::SPtr storeTxn;
+    typename IStoreTransaction<TKey, KBuffer::SPtr>::SPtr storeTxn;
 
     status = STATUS_SUCCESS;
     synchronousComplete = false;
 
-    status = KString::Create(kstringKey, txn->GetThisAllocator(), key);
+    status = CreateStoreKey(txn->GetThisAllocator(), key, storeKey);
     CO_RETURN_VOID_ON_FAILURE(status);
 
     EXCEPTION_TO_STATUS(store->CreateOrFindTransaction(*txn, storeTxn), status);
@@ -347,7 +427,7 @@ ktl::Task StoreContainsKeyAsyncInternal(
         cancellationToken = ctsSPtr->Token;
     }
 
-    auto awaitable = store->ContainsKeyAsync(*storeTxn, kstringKey, Common::TimeSpan::FromTicks(timeout), cancellationToken);
+    auto awaitable = store->ContainsKeyAsync(*storeTxn, storeKey, Common::TimeSpan::FromTicks(timeout), cancellationToken);
     if (IsComplete(awaitable))
     {
         synchronousComplete = true;
@@ -389,10 +469,11 @@ extern "C" HRESULT Store_ConditionalGetAsync(
     if (store == nullptr)
         return E_INVALIDARG;
 
+    Store_Key storeKey = { Store_KeyKind_String, key, 0 };
     StoreConditionalGetAsyncInternal(
         store,
         (Transaction*)txn, 
-        key,
+        &storeKey,
         timeout,
         objectHandle,
         value,
@@ -400,6 +481,7 @@ extern "C" HRESULT Store_ConditionalGetAsync(
         (ktl::CancellationTokenSource**)cts, 
         found,
         callback,
+        nullptr,
         ctx, 
         status,
         *synchronousComplete);
@@ -421,16 +503,22 @@ extern "C" HRESULT Store_AddAsync(
     __out BOOL* synchronousComplete)
 {
     NTSTATUS status;
+    KBuffer::SPtr valueSPtr;
 
     IStateProvider2* stateProvider = reinterpret_cast<IStateProvider2*>(stateProviderHandle);
     IStore<KString::SPtr, KBuffer::SPtr>* store = dynamic_cast<IStore<KString::SPtr, KBuffer::SPtr>*>(stateProvider);
     if (store == nullptr)
         return E_INVALIDARG;
 
+    status = CreateStoreValue(((Transaction*)txn)->GetThisAllocator(), objectHandle, bytes, bytesLength, valueSPtr);
+    if (!NT_SUCCESS(status))
+        return StatusConverter::ToHResult(status);
+
+    Store_Key storeKey = { Store_KeyKind_String, key, 0 };
     StoreAddAsyncInternal(
         store,
         (Transaction*)txn,
-        key, objectHandle, bytes, bytesLength, timeout,
+        &storeKey, valueSPtr, timeout,
         (ktl::CancellationTokenSource**)cts, 
         callback, ctx, status, *synchronousComplete);
 
@@ -453,15 +541,22 @@ extern "C" HRESULT Store_ConditionalUpdateAsync(
     __out BOOL* synchronousComplete)
 {
     NTSTATUS status;
+    KBuffer::SPtr valueSPtr;
+
     IStateProvider2* stateProvider = reinterpret_cast<IStateProvider2*>(stateProviderHandle);
     IStore<KString::SPtr, KBuffer::SPtr>* store = dynamic_cast<IStore<KString::SPtr, KBuffer::SPtr>*>(stateProvider);
     if (store == nullptr)
         return E_INVALIDARG;
 
+    status = CreateStoreValue(((Transaction*)txn)->GetThisAllocator(), objectHandle, bytes, bytesLength, valueSPtr);
+    if (!NT_SUCCESS(status))
+        return StatusConverter::ToHResult(status);
+
+    Store_Key storeKey = { Store_KeyKind_String, key, 0 };
     StoreConditionalUpdateAsyncInternal(
         store,
         (Transaction*)txn,
-        key, objectHandle, bytes, bytesLength, timeout,
+        &storeKey, valueSPtr, timeout,
         (ktl::CancellationTokenSource**)cts,
         conditionalVersion, updated, callback, 
         ctx, status, *synchronousComplete);
@@ -487,10 +582,11 @@ extern "C" HRESULT Store_ConditionalRemoveAsync(
     if (store == nullptr)
         return E_INVALIDARG;
 
+    Store_Key storeKey = { Store_KeyKind_String, key, 0 };
     StoreConditionalRemoveAsyncInternal(
         store,
         (Transaction*)txn, 
-        key, timeout, 
+        &storeKey, timeout, 
         (ktl::CancellationTokenSource**)cts, 
         conditionalVersion, removed, callback, 
         ctx, status, *synchronousComplete);
@@ -498,27 +594,229 @@ extern "C" HRESULT Store_ConditionalRemoveAsync(
     return StatusConverter::ToHResult(status);
 }
 
-extern "C" HRESULT Store_GetCount(
+extern "C" HRESULT Buffer_Create(
     __in StateProviderHandle stateProviderHandle,
-    __out int64_t* count)
+    __in uint32_t length,
+    __out Buffer* buffer)
 {
-    NTSTATUS status = STATUS_SUCCESS;
-    IStateProvider2* stateProvider = reinterpret_cast<IStateProvider2*>(stateProviderHandle);
-    IStore<KString::SPtr, KBuffer::SPtr>* store = dynamic_cast<IStore<KString::SPtr, KBuffer::SPtr>*>(stateProvider);
-    if (store == nullptr)
+    if (buffer == nullptr)
         return E_INVALIDARG;
 
-    try
+    ULONG kBufferLength = length;
+#ifdef FEATURE_CACHE_OBJHANDLE
+    if (kBufferLength > MAXULONG - sizeof(size_t))
+        return E_INVALIDARG;
+    kBufferLength += sizeof(size_t);
+#endif
+
+    return InvokeOnStore(stateProviderHandle, [&](auto* store)
     {
-        *count = store->Count;
-    }
-    catch (ktl::Exception const & e)
+        KBuffer::SPtr kBufferSptr;
+        NTSTATUS status = KBuffer::Create(kBufferLength, kBufferSptr, store->Allocator);
+        if (!NT_SUCCESS(status))
+            return StatusConverter::ToHResult(status);
+
+        buffer->Bytes = (char*)kBufferSptr->GetBuffer();
+#ifdef FEATURE_CACHE_OBJHANDLE
+        buffer->Bytes += sizeof(size_t);
+#endif
+        buffer->Length = length;
+        buffer->Handle = kBufferSptr.Detach();
+        return S_OK;
+    });
+}
+
+extern "C" HRESULT Store_ConditionalGetAsync2(
+    __in StateProviderHandle stateProviderHandle,
+    __in TransactionHandle txn,
+    __in Store_Key const* key,
+    __in int64_t timeout,
+    __in Store_LockMode lockMode,
+    __out size_t* objectHandle,
+    __out Buffer* value,
+    __out int64_t* versionSequenceNumber,
+    __out CancellationTokenSourceHandle* cts,
+    __out BOOL* found,
+    __in fnNotifyGetAsyncCompletion2 callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete)
+{
+    UNREFERENCED_PARAMETER(lockMode);
+
+    if (key == nullptr)
+        return E_INVALIDARG;
+
+    return InvokeOnStore(stateProviderHandle, [&](auto* store)
     {
-        status = e.GetStatus();
-    }
-    return StatusConverter::ToHResult(status);
+        NTSTATUS status;
+        StoreConditionalGetAsyncInternal(
+            store,
+            (Transaction*)txn,
+            key, timeout,
+            objectHandle, value, versionSequenceNumber,
+            (ktl::CancellationTokenSource**)cts,
+            found, nullptr, callback,
+            ctx, status, *synchronousComplete);
+
+        return StatusConverter::ToHResult(status);
+    });
+}
+
+extern "C" HRESULT Store_AddAsync2(
+    __in StateProviderHandle stateProviderHandle,
+    __in TransactionHandle txn,
+    __in Store_Key const* key,
+    __in size_t objectHandle,
+    __in BufferHandle value,
+    __in int64_t timeout,
+    __out CancellationTokenSourceHandle* cts,
+    __in fnNotifyAsyncCompletion callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete)
+{
+    // Adopted before any validation so the buffer is released on every failure path
+    KBuffer::SPtr valueSPtr;
+    valueSPtr.Attach(reinterpret_cast<KBuffer*>(value));
+
+    if (key == nullptr || !valueSPtr)
+        return E_INVALIDARG;
+
+    NTSTATUS status = AdoptStoreValue(objectHandle, *valueSPtr);
+    if (!NT_SUCCESS(status))
+        return StatusConverter::ToHResult(status);
+
+    return InvokeOnStore(stateProviderHandle, [&](auto* store)
+    {
+        StoreAddAsyncInternal(
+            store,
+            (Transaction*)txn,
+            key, valueSPtr, timeout,
+            (ktl::CancellationTokenSource**)cts,
+            callback, ctx, status, *synchronousComplete);
+
+        return StatusConverter::ToHResult(status);
+    });
+}
+
+extern "C" HRESULT Store_ConditionalUpdateAsync2(
+    __in StateProviderHandle stateProviderHandle,
+    __in TransactionHandle txn,
+    __in Store_Key const* key,
+    __in size_t objectHandle,
+    __in BufferHandle value,
+    __in int64_t timeout,
+    __out CancellationTokenSourceHandle* cts,
+    __in int64_t conditionalVersion,
+    __out BOOL* updated,
+    __in fnNotifyUpdateAsyncCompletion callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete)
+{
+    // Adopted before any validation so the buffer is released on every failure path
+    KBuffer::SPtr valueSPtr;
+    valueSPtr.Attach(reinterpret_cast<KBuffer*>(value));
+
+    if (key == nullptr || !valueSPtr)
+        return E_INVALIDARG;
+
+    NTSTATUS status = AdoptStoreValue(objectHandle, *valueSPtr);
+    if (!NT_SUCCESS(status))
+        return StatusConverter::ToHResult(status);
+
+    return InvokeOnStore(stateProviderHandle, [&](auto* store)
+    {
+        StoreConditionalUpdateAsyncInternal(
+            store,
+            (Transaction*)txn,
+            key, valueSPtr, timeout,
+            (ktl::CancellationTokenSource**)cts,
+            conditionalVersion, updated, callback,
+            ctx, status, *synchronousComplete);
+
+        return StatusConverter::ToHResult(status);
+    });
+}
+
+extern "C" HRESULT Store_ConditionalRemoveAsync2(
+    __in StateProviderHandle stateProviderHandle,
+    __in TransactionHandle txn,
+    __in Store_Key const* key,
+    __in int64_t timeout,
+    __out CancellationTokenSourceHandle* cts,
+    __in int64_t conditionalVersion,
+    __out BOOL* removed,
+    __in fnNotifyRemoveAsyncCompletion callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete)
+{
+    if (key == nullptr)
+        return E_INVALIDARG;
+
+    return InvokeOnStore(stateProviderHandle, [&](auto* store)
+    {
+        NTSTATUS status;
+        StoreConditionalRemoveAsyncInternal(
+            store,
+            (Transaction*)txn,
+            key, timeout,
+            (ktl::CancellationTokenSource**)cts,
+            conditionalVersion, removed, callback,
+            ctx, status, *synchronousComplete);
+
+        return StatusConverter::ToHResult(status);
+    });
+}
+
+extern "C" HRESULT Store_ContainsKeyAsync2(
+    __in StateProviderHandle stateProviderHandle,
+    __in TransactionHandle txn,
+    __in Store_Key const* key,
+    __in int64_t timeout,
+    __in Store_LockMode lockMode,
+    __out CancellationTokenSourceHandle* cts,
+    __out BOOL* found,
+    __in fnNotifyContainsKeyAsyncCompletion callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete)
+{
+    UNREFERENCED_PARAMETER(lockMode);
+
+    if (key == nullptr)
+        return E_INVALIDARG;
+
+    return InvokeOnStore(stateProviderHandle, [&](auto* store)
+    {
+        NTSTATUS status;
+        StoreContainsKeyAsyncInternal(
+            store,
+            (Transaction*)txn,
+            key, timeout,
+            (ktl::CancellationTokenSource**)cts,
+            found, callback,
+            ctx, status, *synchronousComplete);
+
+        return StatusConverter::ToHResult(status);
+    });
 }
 
+extern "C" HRESULT Store_GetCount(
+    __in StateProviderHandle stateProviderHandle,
+    __out int64_t* count)
+{
+    return InvokeOnStore(stateProviderHandle, [&](auto* store)
+    {
+        NTSTATUS status = STATUS_SUCCESS;
+        try
+        {
+            *count = store->Count;
+        }
+        catch (ktl::Exception const & e)
+        {
+            status = e.GetStatus();
+        }
+        return StatusConverter::ToHResult(status);
+    });
+}
 
 
 extern "C" HRESULT Store_SetNotifyStoreChangeCallback(
@@ -764,10 +1062,11 @@ extern "C" HRESULT Store_ContainsKeyAsync(
     if (store == nullptr)
         return E_INVALIDARG;
 
+    Store_Key storeKey = { Store_KeyKind_String, key, 0 };
     StoreContainsKeyAsyncInternal(
         store,
         (Transaction*)txn,
-        key, timeout,
+        &storeKey, timeout,
         (ktl::CancellationTokenSource**)cts,
         found, callback,
         ctx, status, *synchronousComplete);
@@ -767,6 +767,9 @@ namespace Data
                         blockAlignedWriterSPtr);
                     Diagnostics::Validate(status);
 
+                    // Bytes of the merged file already charged against the merge I/O budget shared by all stores in the process.
+                    ULONG64 chargedBytes = 0;
+
                     while (!priorityQueue.IsEmpty())
                     {
                         snappedToken.ThrowIfCancellationRequested();
@@ -905,6 +908,13 @@ namespace Data
                                 co_await blockAlignedWriterSPtr->BlockAlignedWriteItemAsync(kvpToWrite, nullptr, true);
                             }
 
+                            ULONG64 bytesWritten = static_cast<ULONG64>(keyFileStreamSPtr->Position + valueFileStreamSPtr->Position);
+                            if (bytesWritten - chargedBytes >= MergeIoBudget::ChargeGranularityInBytes)
+                            {
+                                co_await MergeIoBudget::GetInstance().AcquireAsync(bytesWritten - chargedBytes, this->GetThisAllocator(), snappedToken);
+                                chargedBytes = bytesWritten;
+                            }
+
                             if (kvpToWrite.Value->GetRecordKind() != RecordKind::DeletedVersion)
                             {
                                 // Copy-on-write the versioned value in-memory into the next consolidated state, to avoid taking locks.
@@ -939,6 +949,12 @@ namespace Data
                        // Flush both key and value checkpoints to disk
                        co_await blockAlignedWriterSPtr->FlushAsync();
 
+                       ULONG64 bytesWritten = static_cast<ULONG64>(keyFileStreamSPtr->Position + valueFileStreamSPtr->Position);
+                       if (bytesWritten > chargedBytes)
+                       {
+                           co_await MergeIoBudget::GetInstance().AcquireAsync(bytesWritten - chargedBytes, this->GetThisAllocator(), snappedToken);
+                       }
+
                        CheckpointFile::SPtr checkpointFileSPtr = nullptr;
                        status = CheckpointFile::Create(*fullFileNameSPtr, *keyFileSPtr, *valueFileSPtr, *traceComponent_, this->GetThisAllocator(), checkpointFileSPtr);
                        Diagnostics::Validate(status);
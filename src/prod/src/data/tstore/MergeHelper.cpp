@@ -66,6 +66,20 @@ MergeHelper::Create(
         return status;
     }
 
+    // Static setting, read once for the process
+    static bool const enableMergePlanner = TxnReplicator::TransactionalReplicatorConfig().EnableMergePlanner;
+    if (enableMergePlanner)
+    {
+        MergePlanner::SPtr plannerSPtr;
+        status = MergePlanner::Create(allocator, plannerSPtr);
+        if (!NT_SUCCESS(status))
+        {
+            return status;
+        }
+
+        output->MergePlannerSPtr = plannerSPtr;
+    }
+
     result = Ktl::Move(output);
     return STATUS_SUCCESS;
 }
@@ -74,6 +88,12 @@ ktl::Awaitable<bool> MergeHelper::ShouldMerge(
     __in MetadataTable& mergeTable, 
     __out KSharedArray<ULONG32>::SPtr& mergeList)
 {
+    if (mergePlannerSPtr_ != nullptr && CurrentMergePolicy != MergePolicy::None)
+    {
+        bool hasVal = co_await ShouldMergeDueToCostPolicy(mergeTable, mergeList);
+        co_return hasVal;
+    }
+
     if (mergeTable.Table->Count < MergeFilesCountThreshold)
     {
         mergeList = nullptr;
@@ -306,6 +326,41 @@ ktl::Awaitable<bool> MergeHelper::ShouldMergeDueToFileCountPolicy(
     co_return false;
 }
 
+ktl::Awaitable<bool> MergeHelper::ShouldMergeDueToCostPolicy(
+    __in MetadataTable& mergeTable,
+    __out KSharedArray<ULONG32>::SPtr& filesToBeMerged)
+{
+    KArray<MergePlanner::FileEstimate> files(GetThisAllocator(), mergeTable.Table->Count);
+    Diagnostics::Validate(files.Status());
+
+    auto enumeratorSPtr = mergeTable.Table->GetEnumerator();
+    while (enumeratorSPtr->MoveNext())
+    {
+        auto currentItem = enumeratorSPtr->Current();
+        FileMetadata::SPtr fileMetadataSPtr = currentItem.Value;
+
+        MergePlanner::FileEstimate file = {};
+        file.FileId = currentItem.Key;
+        file.FileSize = co_await fileMetadataSPtr->GetFileSize();
+        file.TotalNumberOfEntries = fileMetadataSPtr->TotalNumberOfEntries;
+        file.NumberOfValidEntries = fileMetadataSPtr->NumberOfValidEntries;
+
+        auto status = files.Append(file);
+        ASSERT_IFNOT(NT_SUCCESS(status), "Unable to append file estimate");
+    }
+
+    MergePlanner::MergeEstimate estimate;
+    KSharedArray<ULONG32>::SPtr mergeFileIds = mergePlannerSPtr_->GetMergeList(files, estimate);
+    if (mergeFileIds->Count() == 0)
+    {
+        filesToBeMerged = nullptr;
+        co_return false;
+    }
+
+    filesToBeMerged = mergeFileIds;
+    co_return true;
+}
+
 bool MergeHelper::IsMergePolicyEnabled(__in MergePolicy mergePolicy)
 {
     ULONG32 tmpMergePolicy = static_cast<ULONG32>(mergePolicy);
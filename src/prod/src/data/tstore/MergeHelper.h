@@ -81,6 +81,22 @@ namespace Data
                 fileCountMergeConfigurationSPtr_ = &config;
             }
 
+            //
+            // Gets or sets the cost based merge planner. When set, it decides which files to merge instead of
+            // the invalid entries, deleted entries and file count policies. Set by Create when
+            // TransactionalReplicator2/EnableMergePlanner is true, null otherwise.
+            //
+            __declspec (property(get = get_MergePlanner, put = set_MergePlanner)) MergePlanner::SPtr MergePlannerSPtr;
+            MergePlanner::SPtr get_MergePlanner() const
+            {
+                return mergePlannerSPtr_;
+            }
+
+            void set_MergePlanner(__in MergePlanner::SPtr const & planner)
+            {
+                mergePlannerSPtr_ = planner;
+            }
+
             // Default is zero.
             ULONG32 NumberOfInvalidEntries;
 
@@ -108,6 +124,10 @@ namespace Data
                 __in MetadataTable& mergeTable,
                 __out KSharedArray<ULONG32>::SPtr& filesToBeMerged);
 
+            ktl::Awaitable<bool> ShouldMergeDueToCostPolicy(
+                __in MetadataTable& mergeTable,
+                __out KSharedArray<ULONG32>::SPtr& filesToBeMerged);
+
             KSharedArray<ULONG32>::SPtr GetMergeFileListForInvalidAndDeletedEntries(__in MetadataTable & mergeTable);
             KSharedArray<ULONG32>::SPtr GetMergeFileListForInvalidEntries(__in MetadataTable & mergeTable);
             KSharedArray<ULONG32>::SPtr GetMergeFileListForDeletedEntries(__in MetadataTable & mergeTable);
@@ -137,6 +157,8 @@ namespace Data
             // Gets or sets the file count merge configuration.  File count merge configruation.
             FileCountMergeConfiguration::SPtr fileCountMergeConfigurationSPtr_;
 
+            MergePlanner::SPtr mergePlannerSPtr_;
+
             //
             // Invalid Entries Merge Policy Configuration
             //
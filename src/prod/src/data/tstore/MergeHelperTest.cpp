@@ -160,6 +160,81 @@ namespace TStoreTests
         CODING_ERROR_ASSERT((*mergeList)[0] == 1);
     }
     
+    BOOST_AUTO_TEST_CASE(CostPolicy_MostlyInvalidFiles_ShouldMergeOnlyThoseFiles)
+    {
+        KAllocator& allocator = GetAllocator();
+        MergePlanner::SPtr plannerSPtr = nullptr;
+        auto status = MergePlanner::Create(allocator, plannerSPtr);
+        CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+        ULONG64 megabyte = 1024 * 1024;
+        KArray<MergePlanner::FileEstimate> files(allocator);
+        files.Append({ 1, 100 * megabyte, 100, 100 });
+        files.Append({ 2, 10 * megabyte, 10, 2 });
+        files.Append({ 3, 10 * megabyte, 10, 1 });
+
+        MergePlanner::MergeEstimate estimate;
+        KSharedArray<ULONG32>::SPtr mergeList = plannerSPtr->GetMergeList(files, estimate);
+        CODING_ERROR_ASSERT(mergeList->Count() == 2);
+        CODING_ERROR_ASSERT((*mergeList)[0] == 3);
+        CODING_ERROR_ASSERT((*mergeList)[1] == 2);
+        CODING_ERROR_ASSERT(estimate.BytesRead == 20 * megabyte);
+        CODING_ERROR_ASSERT(estimate.BytesWritten == 3 * megabyte);
+        CODING_ERROR_ASSERT(estimate.SpaceRecovered == 17 * megabyte);
+        CODING_ERROR_ASSERT(estimate.FilesRemoved == 1);
+        CODING_ERROR_ASSERT(estimate.ReadAmplification == 2);
+    }
+
+    BOOST_AUTO_TEST_CASE(CostPolicy_ManySmallValidFiles_ShouldMergeOnlyAboveTargetFileCount)
+    {
+        KAllocator& allocator = GetAllocator();
+        MergePlanner::SPtr plannerSPtr = nullptr;
+        auto status = MergePlanner::Create(allocator, plannerSPtr);
+        CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+        ULONG64 megabyte = 1024 * 1024;
+        KArray<MergePlanner::FileEstimate> files(allocator);
+        for (ULONG32 fileId = 0; fileId < plannerSPtr->TargetFileCount; fileId++)
+        {
+            files.Append({ fileId, megabyte, 10, 10 });
+        }
+
+        MergePlanner::MergeEstimate estimate;
+        KSharedArray<ULONG32>::SPtr mergeList = plannerSPtr->GetMergeList(files, estimate);
+        CODING_ERROR_ASSERT(mergeList->Count() == 0);
+
+        for (ULONG32 fileId = plannerSPtr->TargetFileCount; fileId < 2 * plannerSPtr->TargetFileCount; fileId++)
+        {
+            files.Append({ fileId, megabyte, 10, 10 });
+        }
+
+        // Merge rewrites no more than the small merge threshold
+        mergeList = plannerSPtr->GetMergeList(files, estimate);
+        CODING_ERROR_ASSERT(mergeList->Count() == plannerSPtr->SmallMergeBytesThreshold / megabyte);
+        CODING_ERROR_ASSERT(estimate.SpaceRecovered == 0);
+    }
+
+    BOOST_AUTO_TEST_CASE(MergeIoBudget_ChargeBeyondBurst_ShouldWait)
+    {
+        MergeIoBudget & budget = MergeIoBudget::GetInstance();
+        ULONG64 configuredBytesPerSecond = budget.BytesPerSecond;
+        budget.BytesPerSecond = 1024 * 1024;
+        KFinally([&] { budget.BytesPerSecond = configuredBytesPerSecond; });
+
+        ULONGLONG now = 10 * 1000;
+
+        // One second worth of unused budget is available as a burst.
+        CODING_ERROR_ASSERT(budget.Reserve(1024 * 1024, now) == 0);
+        CODING_ERROR_ASSERT(budget.Reserve(512 * 1024, now) == 500);
+        CODING_ERROR_ASSERT(budget.Reserve(512 * 1024, now) == 1000);
+
+        // Budget accrues over time
+        CODING_ERROR_ASSERT(budget.Reserve(512 * 1024, now + 1000) == 500);
+
+        budget.BytesPerSecond = 0;
+        CODING_ERROR_ASSERT(budget.Reserve(1024 * 1024 * 1024, now) == 0);
+    }
+
     // This test requires additonal setup to work correctly
     //BOOST_AUTO_TEST_CASE(FileCountPolicy_OneFileTypeFileCountExceedsConfigThread_ShouldMerge)
     //{
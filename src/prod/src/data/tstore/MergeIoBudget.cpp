@@ -0,0 +1,85 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+#define MERGEIOBUDGET_TAG 'bIeM'
+
+using namespace Data::TStore;
+
+// Longest single wait so that cancellation of a throttled merge is observed promptly.
+static const ULONG32 MaxWaitSliceInMilliseconds = 100;
+
+MergeIoBudget::MergeIoBudget()
+    : bytesPerSecond_(static_cast<ULONG64>(TxnReplicator::TransactionalReplicatorConfig().MergeIoBudgetInMBPerSecond) * 1024 * 1024),
+    paidUntilInMilliseconds_(0)
+{
+}
+
+MergeIoBudget & MergeIoBudget::GetInstance()
+{
+    static MergeIoBudget instance;
+    return instance;
+}
+
+void MergeIoBudget::set_BytesPerSecond(__in ULONG64 value)
+{
+    K_LOCK_BLOCK(lock_)
+    {
+        bytesPerSecond_ = value;
+        paidUntilInMilliseconds_ = 0;
+    }
+}
+
+ULONG32 MergeIoBudget::Reserve(__in ULONG64 bytes, __in ULONGLONG nowInMilliseconds)
+{
+    ULONGLONG waitInMilliseconds = 0;
+
+    K_LOCK_BLOCK(lock_)
+    {
+        ULONG64 bytesPerSecond = bytesPerSecond_;
+        if (bytesPerSecond == 0)
+        {
+            return 0;
+        }
+
+        // Budget left unused for longer than the burst window is forfeited.
+        ULONGLONG earliestPaidUntil = nowInMilliseconds > DefaultBurstInMilliseconds ? nowInMilliseconds - DefaultBurstInMilliseconds : 0;
+        if (paidUntilInMilliseconds_ < earliestPaidUntil)
+        {
+            paidUntilInMilliseconds_ = earliestPaidUntil;
+        }
+
+        paidUntilInMilliseconds_ += (bytes * 1000) / bytesPerSecond;
+
+        if (paidUntilInMilliseconds_ > nowInMilliseconds)
+        {
+            waitInMilliseconds = paidUntilInMilliseconds_ - nowInMilliseconds;
+        }
+    }
+
+    return waitInMilliseconds > MAXULONG32 ? MAXULONG32 : static_cast<ULONG32>(waitInMilliseconds);
+}
+
+ktl::Awaitable<void> MergeIoBudget::AcquireAsync(
+    __in ULONG64 bytes,
+    __in KAllocator & allocator,
+    __in ktl::CancellationToken const & cancellationToken)
+{
+    ktl::CancellationToken snappedToken = cancellationToken;
+    ULONG32 waitInMilliseconds = Reserve(bytes, KNt::GetTickCount64());
+
+    while (waitInMilliseconds > 0)
+    {
+        snappedToken.ThrowIfCancellationRequested();
+
+        ULONG32 sliceInMilliseconds = waitInMilliseconds < MaxWaitSliceInMilliseconds ? waitInMilliseconds : MaxWaitSliceInMilliseconds;
+        NTSTATUS status = co_await KTimer::StartTimerAsync(allocator, MERGEIOBUDGET_TAG, sliceInMilliseconds, nullptr);
+        KInvariant(NT_SUCCESS(status));
+
+        waitInMilliseconds -= sliceInMilliseconds;
+    }
+
+    co_return;
+}
@@ -0,0 +1,69 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Data
+{
+    namespace TStore
+    {
+        //
+        // Disk bandwidth budget shared by the merges of all stores hosted in the process.
+        // Merges charge the bytes they write and are delayed once the budget is used up, so that
+        // many replicas merging together do not saturate the disk used by replication and commits.
+        //
+        class MergeIoBudget
+        {
+            K_DENY_COPY(MergeIoBudget);
+
+        public:
+            //
+            // Unused budget accumulates for at most this long, which bounds the burst a merge can issue without waiting.
+            //
+            static const ULONG32 DefaultBurstInMilliseconds = 1000;
+
+            //
+            // Merges charge the budget in chunks of at least this size.
+            //
+            static const ULONG64 ChargeGranularityInBytes = 1024 * 1024;
+
+            static MergeIoBudget & GetInstance();
+
+            //
+            // Gets or sets the merge bandwidth. Zero disables throttling.
+            // Initialized from TransactionalReplicator2/MergeIoBudgetInMBPerSecond, which is zero by default.
+            //
+            __declspec(property(get = get_BytesPerSecond, put = set_BytesPerSecond)) ULONG64 BytesPerSecond;
+            ULONG64 get_BytesPerSecond() const
+            {
+                return bytesPerSecond_;
+            }
+
+            void set_BytesPerSecond(__in ULONG64 value);
+
+            //
+            // Charges the bytes against the budget and returns how long, in milliseconds, the caller has to wait before issuing them.
+            // Exposed for testability only.
+            //
+            ULONG32 Reserve(__in ULONG64 bytes, __in ULONGLONG nowInMilliseconds);
+
+            ktl::Awaitable<void> AcquireAsync(
+                __in ULONG64 bytes,
+                __in KAllocator & allocator,
+                __in ktl::CancellationToken const & cancellationToken);
+
+        private:
+            MergeIoBudget();
+
+            KSpinLock lock_;
+            volatile ULONG64 bytesPerSecond_;
+
+            //
+            // Time at which all of the bytes charged so far have been paid for.
+            //
+            ULONGLONG paidUntilInMilliseconds_;
+        };
+    }
+}
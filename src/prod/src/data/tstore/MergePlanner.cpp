@@ -0,0 +1,177 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+#define MERGEPLANNER_TAG 'lpGM'
+
+using namespace Data::TStore;
+
+//
+// Default write amplification limit: rewrite at most one byte for every byte recovered.
+//
+static const double DefaultMaxWriteAmplification = 1.0;
+
+//
+// Default file count above which small files get merged.
+//
+static const ULONG32 DefaultTargetFileCount = 16;
+
+MergePlanner::MergePlanner()
+    : maxWriteAmplification_(DefaultMaxWriteAmplification),
+    targetFileCount_(DefaultTargetFileCount),
+    smallMergeBytesThreshold_(FileCountMergeConfiguration::DefaultSmallFileSizeThreshold),
+    maxMergeBytes_(FileCountMergeConfiguration::DefaultLargeFileSizeThreshold),
+    perFileCostInBytes_(FileCountMergeConfiguration::DefaultVerySmallFileSizeThreshold)
+{
+}
+
+MergePlanner::~MergePlanner()
+{
+}
+
+NTSTATUS
+MergePlanner::Create(
+    __in KAllocator& allocator,
+    __out MergePlanner::SPtr& result)
+{
+    NTSTATUS status;
+
+    SPtr output = _new(MERGEPLANNER_TAG, allocator) MergePlanner();
+
+    if (!output)
+    {
+        return STATUS_INSUFFICIENT_RESOURCES;
+    }
+
+    status = output->Status();
+    if (!NT_SUCCESS(status))
+    {
+        return status;
+    }
+
+    result = Ktl::Move(output);
+    return STATUS_SUCCESS;
+}
+
+MergePlanner::MergeEstimate MergePlanner::Estimate(
+    __in KArray<FileEstimate> const & files,
+    __in ULONG32 count,
+    __in ULONG32 totalFileCount)
+{
+    ASSERT_IFNOT(count <= files.Count(), "count {0} should not exceed the number of files {1}", count, files.Count());
+
+    MergeEstimate estimate = {};
+    estimate.FileCount = count;
+
+    for (ULONG32 i = 0; i < count; i++)
+    {
+        estimate.BytesRead += files[i].FileSize;
+        estimate.BytesWritten += GetValidBytes(files[i]);
+    }
+
+    estimate.SpaceRecovered = estimate.BytesRead - estimate.BytesWritten;
+
+    // All files are replaced by a single merged file, unless nothing in them is valid anymore.
+    estimate.FilesRemoved = estimate.BytesWritten > 0 ? count - 1 : count;
+    estimate.ReadAmplification = totalFileCount - estimate.FilesRemoved;
+    estimate.WriteAmplification = static_cast<double>(estimate.BytesWritten) / (estimate.SpaceRecovered > 0 ? estimate.SpaceRecovered : 1);
+
+    return estimate;
+}
+
+KSharedArray<ULONG32>::SPtr MergePlanner::GetMergeList(
+    __in KArray<FileEstimate> const & files,
+    __out MergeEstimate & estimate)
+{
+    KSharedArray<ULONG32>::SPtr mergeFileIds = _new(MERGEPLANNER_TAG, this->GetThisAllocator()) KSharedArray<ULONG32>();
+    Diagnostics::Validate(mergeFileIds);
+
+    // Order the files by how much they recover for what they cost to merge, so that every prefix is the best set of its size.
+    KArray<FileEstimate> orderedFiles(this->GetThisAllocator(), files.Count());
+    Diagnostics::Validate(orderedFiles.Status());
+
+    for (ULONG32 i = 0; i < files.Count(); i++)
+    {
+        NTSTATUS status = orderedFiles.Append(files[i]);
+        Diagnostics::Validate(status);
+
+        for (ULONG32 j = orderedFiles.Count() - 1; j > 0 && GetEfficiency(orderedFiles[j]) > GetEfficiency(orderedFiles[j - 1]); j--)
+        {
+            FileEstimate swap = orderedFiles[j];
+            orderedFiles[j] = orderedFiles[j - 1];
+            orderedFiles[j - 1] = swap;
+        }
+    }
+
+    // Recovered bytes and removed files only add up as the set grows, so the largest set worth merging is the best one.
+    ULONG32 totalFileCount = orderedFiles.Count();
+    ULONG32 mergeFileCount = 0;
+    estimate = {};
+
+    for (ULONG32 count = 1; count <= totalFileCount; count++)
+    {
+        MergeEstimate candidate = Estimate(orderedFiles, count, totalFileCount);
+        if (candidate.BytesRead + candidate.BytesWritten > maxMergeBytes_)
+        {
+            break;
+        }
+
+        if (IsWorthMerging(candidate, totalFileCount))
+        {
+            estimate = candidate;
+            mergeFileCount = count;
+        }
+    }
+
+    for (ULONG32 i = 0; i < mergeFileCount; i++)
+    {
+        NTSTATUS status = mergeFileIds->Append(orderedFiles[i].FileId);
+        Diagnostics::Validate(status);
+    }
+
+    return mergeFileIds;
+}
+
+ULONG64 MergePlanner::GetValidBytes(__in FileEstimate const & file)
+{
+    if (file.TotalNumberOfEntries <= 0)
+    {
+        return 0;
+    }
+
+    // Valid entry count can go negative, see MergeHelper::IsFileQualifiedForInvalidEntriesMergePolicy.
+    LONG64 numValidEntries = file.NumberOfValidEntries;
+    if (numValidEntries < 0)
+    {
+        numValidEntries = 0;
+    }
+    else if (numValidEntries > file.TotalNumberOfEntries)
+    {
+        numValidEntries = file.TotalNumberOfEntries;
+    }
+
+    return static_cast<ULONG64>((static_cast<double>(file.FileSize) * numValidEntries) / file.TotalNumberOfEntries);
+}
+
+bool MergePlanner::IsWorthMerging(__in MergeEstimate const & estimate, __in ULONG32 totalFileCount) const
+{
+    if (estimate.SpaceRecovered > 0 && estimate.WriteAmplification <= maxWriteAmplification_)
+    {
+        return true;
+    }
+
+    // Too many files slow down recovery, so small files are merged even when they do not recover space.
+    return totalFileCount > targetFileCount_ &&
+        estimate.FilesRemoved > 0 &&
+        estimate.BytesWritten <= smallMergeBytesThreshold_;
+}
+
+double MergePlanner::GetEfficiency(__in FileEstimate const & file) const
+{
+    ULONG64 validBytes = GetValidBytes(file);
+    double benefit = static_cast<double>(file.FileSize - validBytes) + perFileCostInBytes_;
+    double cost = static_cast<double>(file.FileSize) + validBytes + 1;
+    return benefit / cost;
+}
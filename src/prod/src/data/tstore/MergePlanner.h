@@ -0,0 +1,158 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Data
+{
+    namespace TStore
+    {
+        //
+        // Cost based merge planner. Estimates the write amplification, read amplification and space recovered
+        // of merging a set of checkpoint files, and picks the largest set whose cost is justified by what it recovers.
+        //
+        class MergePlanner : public KObject<MergePlanner>, public KShared<MergePlanner>
+        {
+            K_FORCE_SHARED(MergePlanner)
+
+        public:
+            //
+            // Inputs of the cost model for one checkpoint file.
+            //
+            struct FileEstimate
+            {
+                ULONG32 FileId;
+                ULONG64 FileSize;
+                LONG64 TotalNumberOfEntries;
+                LONG64 NumberOfValidEntries;
+            };
+
+            //
+            // Estimated cost and benefit of merging a set of checkpoint files.
+            //
+            struct MergeEstimate
+            {
+                ULONG32 FileCount;
+
+                // Bytes read from the files being merged.
+                ULONG64 BytesRead;
+
+                // Bytes of valid entries rewritten into the merged file.
+                ULONG64 BytesWritten;
+
+                // Bytes of invalid entries dropped by the merge.
+                ULONG64 SpaceRecovered;
+
+                // Number of checkpoint files that go away.
+                ULONG32 FilesRemoved;
+
+                // Bytes rewritten per byte recovered.
+                double WriteAmplification;
+
+                // Number of checkpoint files recovery and reads have to go through after the merge.
+                ULONG32 ReadAmplification;
+            };
+
+            static NTSTATUS Create(__in KAllocator& allocator, __out SPtr& result);
+
+            //
+            // Gets or sets the highest write amplification of a merge that is done to recover space.
+            //
+            __declspec(property(get = get_MaxWriteAmplification, put = set_MaxWriteAmplification)) double MaxWriteAmplification;
+            double get_MaxWriteAmplification() const
+            {
+                return maxWriteAmplification_;
+            }
+
+            void set_MaxWriteAmplification(__in double value)
+            {
+                maxWriteAmplification_ = value;
+            }
+
+            //
+            // Gets or sets the file count above which small files are merged even if they do not recover space.
+            //
+            __declspec(property(get = get_TargetFileCount, put = set_TargetFileCount)) ULONG32 TargetFileCount;
+            ULONG32 get_TargetFileCount() const
+            {
+                return targetFileCount_;
+            }
+
+            void set_TargetFileCount(__in ULONG32 value)
+            {
+                targetFileCount_ = value;
+            }
+
+            //
+            // Gets or sets the most bytes a merge done to reduce the file count may rewrite.
+            //
+            __declspec(property(get = get_SmallMergeBytesThreshold, put = set_SmallMergeBytesThreshold)) ULONG64 SmallMergeBytesThreshold;
+            ULONG64 get_SmallMergeBytesThreshold() const
+            {
+                return smallMergeBytesThreshold_;
+            }
+
+            void set_SmallMergeBytesThreshold(__in ULONG64 value)
+            {
+                smallMergeBytesThreshold_ = value;
+            }
+
+            //
+            // Gets or sets the most bytes a single merge may read and write.
+            //
+            __declspec(property(get = get_MaxMergeBytes, put = set_MaxMergeBytes)) ULONG64 MaxMergeBytes;
+            ULONG64 get_MaxMergeBytes() const
+            {
+                return maxMergeBytes_;
+            }
+
+            void set_MaxMergeBytes(__in ULONG64 value)
+            {
+                maxMergeBytes_ = value;
+            }
+
+            //
+            // Gets or sets the cost of keeping one more checkpoint file around, expressed in bytes.
+            //
+            __declspec(property(get = get_PerFileCostInBytes, put = set_PerFileCostInBytes)) ULONG64 PerFileCostInBytes;
+            ULONG64 get_PerFileCostInBytes() const
+            {
+                return perFileCostInBytes_;
+            }
+
+            void set_PerFileCostInBytes(__in ULONG64 value)
+            {
+                perFileCostInBytes_ = value;
+            }
+
+            //
+            // Estimates merging the first count files of the given list, out of totalFileCount checkpoint files.
+            //
+            static MergeEstimate Estimate(
+                __in KArray<FileEstimate> const & files,
+                __in ULONG32 count,
+                __in ULONG32 totalFileCount);
+
+            //
+            // Determine which file ids to merge. Returns an empty list if no merge is worth its cost.
+            //
+            KSharedArray<ULONG32>::SPtr GetMergeList(
+                __in KArray<FileEstimate> const & files,
+                __out MergeEstimate & estimate);
+
+        private:
+            static ULONG64 GetValidBytes(__in FileEstimate const & file);
+
+            bool IsWorthMerging(__in MergeEstimate const & estimate, __in ULONG32 totalFileCount) const;
+            double GetEfficiency(__in FileEstimate const & file) const;
+
+            double maxWriteAmplification_;
+            ULONG32 targetFileCount_;
+            ULONG64 smallMergeBytesThreshold_;
+            ULONG64 maxMergeBytes_;
+            ULONG64 perFileCostInBytes_;
+        };
+    }
+}
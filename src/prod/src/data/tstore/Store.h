@@ -2237,7 +2237,7 @@ namespace Data
 
             StateProviderKind GetKind() const override
             {
-                return StateProviderKind::Store;
+                return std::is_same<TKey, KBuffer::SPtr>::value ? StateProviderKind::BinaryKeyStore : StateProviderKind::Store;
             }
 #pragma endregion
 
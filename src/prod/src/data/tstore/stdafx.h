@@ -107,6 +107,8 @@ namespace Data
 #include "IStore.h"
 #include "StoreFactory.h"
 #include "FileCountMergeConfiguration.h"
+#include "MergePlanner.h"
+#include "MergeIoBudget.h"
 #include "PropertyId.h"
 #include "ByteAlignedReaderWriterHelper.h"
 #include "FilePropertySection.h"
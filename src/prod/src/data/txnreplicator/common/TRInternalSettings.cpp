@@ -290,6 +290,9 @@ int TRInternalSettings::LoadGlobalSettingsCallerHoldsLock()
     this->flushedRecordsTraceVectorSize_ = globalConfig_->FlushedRecordsTraceVectorSize;
     i += 1;
 
+    this->enablePipelinedLogFlush_ = globalConfig_->EnablePipelinedLogFlush;
+    i += 1;
+
     return i;
 }
 
@@ -730,6 +733,12 @@ int64 TRInternalSettings::get_FlushedRecordsTraceVectorSize() const
     return flushedRecordsTraceVectorSize_;
 }
 
+bool TRInternalSettings::get_EnablePipelinedLogFlush() const
+{
+    AcquireReadLock grab(lock_);
+    return enablePipelinedLogFlush_;
+}
+
 std::wstring TRInternalSettings::ToString() const
 {
     std::wstring content;
@@ -828,5 +837,8 @@ int TRInternalSettings::WriteTo(__in Common::TextWriter & w, Common::FormatOptio
     w.WriteLine("FlushedRecordsTraceVectorSize = {0}, ", this->FlushedRecordsTraceVectorSize);
     i += 1;
 
+    w.WriteLine("EnablePipelinedLogFlush = {0}, ", this->EnablePipelinedLogFlush);
+    i += 1;
+
     return i;
 }
@@ -35,6 +35,7 @@ namespace LoggingReplicatorTests
             : maxWaitDurationInMs_(10000)
             , lastFlushedPsn_(0)
             , assertInFlushCallback_(true)
+            , enablePipelinedLogFlush_(true)
         {
         }
 
@@ -64,6 +65,7 @@ namespace LoggingReplicatorTests
         const LONG64 maxWaitDurationInMs_;
 
         bool assertInFlushCallback_;
+        bool enablePipelinedLogFlush_;
         IndexingLogRecord::SPtr logHead_;
         InvalidLogRecords::SPtr invalidRecords_;
         FaultyFileLogicalLog::SPtr fileLog_;
@@ -299,9 +301,12 @@ namespace LoggingReplicatorTests
         TransactionalReplicatorSettingsUPtr tmp;
         TransactionalReplicatorSettings::FromPublicApi(txrSettings, tmp);
 
+        shared_ptr<TransactionalReplicatorConfig> globalConfig = make_shared<TransactionalReplicatorConfig>();
+        globalConfig->EnablePipelinedLogFlushEntry.Test_SetValue(enablePipelinedLogFlush_);
+
         TxnReplicator::TRInternalSettingsSPtr config = TRInternalSettings::Create(
             move(tmp),
-            make_shared<TransactionalReplicatorConfig>());
+            globalConfig);
 
         TestHealthClientSPtr healthClient = TestHealthClient::Create();
 
@@ -459,6 +464,77 @@ namespace LoggingReplicatorTests
         }
     }
 
+    BOOST_AUTO_TEST_CASE(MultiThreaded_NotPipelined)
+    {
+        TEST_TRACE_BEGIN("MultiThreaded_NotPipelined")
+        {
+            // Flush callbacks must be in order with a single batch outstanding as well
+            enablePipelinedLogFlush_ = false;
+
+            SyncAwait(this->CreatePLWAsync(*prId_, L"MultiThreaded_NotPipelined"));
+            SyncAwait(this->CreateAndFlushLogHead());
+
+            KArray<Awaitable<LogRecord::SPtr>> tasks(allocator);
+            status = STATUS_SUCCESS;
+
+            for (ULONG i = 0; i < 100; i++)
+            {
+                Awaitable<LogRecord::SPtr> task = CreateLogRecordsAsync(10, L"MultiThreaded_NotPipelined");
+                status = tasks.Append(Ktl::Move(task));
+                CODING_ERROR_ASSERT(status == STATUS_SUCCESS);
+            }
+
+            for (ULONG i = 0; i < tasks.Count(); i++)
+            {
+                SyncAwait(tasks[i]);
+            }
+
+            auto tailRecord = SyncAwait(CreateLogRecordsAsync(1, L"MultiThreaded_NotPipelinedLast"));
+
+            VERIFY_ARE_EQUAL(writer_->CurrentLogTailRecord->Psn, tailRecord->Psn);
+            SyncAwait(fileLog_->CloseAsync());
+            WaitForRecordFlushToPSN(tailRecord->Psn);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(VerifyPendingRecordsFlushedWhilePreviousFlushCompletes)
+    {
+        TEST_TRACE_BEGIN("VerifyPendingRecordsFlushedWhilePreviousFlushCompletes")
+        {
+            SyncAwait(this->CreatePLWAsync(*prId_, L"VerifyPendingRecordsFlushedWhilePreviousFlushCompletes"));
+            SyncAwait(this->CreateAndFlushLogHead());
+
+            ULONG recordCount = 30;
+            ULONG expectedBufferSize = 0;
+            LONG64 currentBufferSize = 0;
+
+            // Keep queueing batches behind the outstanding flush so that every flush completion finds pending records
+            KArray<Awaitable<void>> flushes(allocator);
+            LogRecord::SPtr lastRecord = nullptr;
+
+            for (ULONG i = 0; i < 10; i++)
+            {
+                lastRecord = InsertLogRecords(recordCount, expectedBufferSize, currentBufferSize);
+                status = flushes.Append(writer_->FlushAsync(L"VerifyPendingRecordsFlushedWhilePreviousFlushCompletes"));
+                CODING_ERROR_ASSERT(status == STATUS_SUCCESS);
+            }
+
+            for (ULONG i = 0; i < flushes.Count(); i++)
+            {
+                SyncAwait(flushes[i]);
+            }
+
+            // All the waiters were woken after their records were flushed and called back in order
+            VERIFY_ARE_EQUAL(writer_->CurrentLogTailRecord->Psn, lastRecord->Psn);
+            WaitForRecordFlush(true, lastRecord->Psn);
+
+            VERIFY_ARE_EQUAL(writer_->PendingFlushRecordsBytes, 0);
+            VERIFY_ARE_EQUAL(lastFlushedPsn_, lastRecord->Psn);
+
+            SyncAwait(fileLog_->CloseAsync());
+        }
+    }
+
     BOOST_AUTO_TEST_CASE(SetTailRecord_LogicalRecord)
     {
         TEST_TRACE_BEGIN("SetTailRecord_LogicalRecord")
@@ -559,165 +559,198 @@ Task PhysicalLogWriter::FlushTask(__in AwaitableCompletionSource<void> & initiat
     THROW_ON_FAILURE(status);
 
     bool isFlushTask = true;
-    LogRecord::SPtr newTail = nullptr;
-    Common::Stopwatch flushWatch;
-    flushWatch.Start();
+    bool isPipelined = transactionalReplicatorConfig_->EnablePipelinedLogFlush;
 
-    Common::Stopwatch serializationWatch;
-    serializationWatch.Start();
+    // Only this task changes flushingRecords_ until it gives up the flush by setting it to null
+    KSharedArray<LogRecord::SPtr>::SPtr records = flushingRecords_;
+    Awaitable<NTSTATUS> writeAwaitable = WriteFlushingRecordsAsync(*records);
 
     do
     {
-        ASSERT_IFNOT(
-            NT_SUCCESS(loggingError_.load()),
-            "{0}:FlushTask | Unexpected logging exception before starting FlushTask",
-            TraceId);
+        status = co_await writeAwaitable;
 
-        ULONG latencySensitiveRecords = 0;
-        ULONG numberOfBytes = 0;
+        if (!NT_SUCCESS(status))
+        {
+            loggingError_.store(status);
 
-        EventSource::Events->FlushStart(
-            TracePartitionId,
-            ReplicaId,
-            flushingRecords_->Count(),
-            (*flushingRecords_)[0]->Psn,
-            logicalLogStream_->GetWritePosition());
+            LR_TRACE_EXCEPTION(
+                L"FlushTask hit exception.",
+                loggingError_.load());
+        }
 
-        // Enable group commit as we are about to issue IO
-        FlushStarting();
+        // Disable group commit as there is no pending IO
+        FlushCompleted();
 
-        flushWatch.Reset();
-        serializationWatch.Reset();
+        KSharedArray<AwaitableCompletionSource<void>::SPtr>::SPtr flushedTasks = flushingTasks;
+        KSharedArray<LogRecord::SPtr>::SPtr flushedRecordsArray = records;
+        bool isNextWriteStarted = false;
 
-        for (ULONG i = 0; i < flushingRecords_->Count(); i++)
+        LoggedRecords::CSPtr flushedRecords = nullptr;
+        if (NT_SUCCESS(loggingError_.load()))
         {
-            serializationWatch.Start();
+            flushedRecords = LoggedRecords::Create(*flushedRecordsArray, GetThisAllocator()).RawPtr();
+        }
+        else
+        {
+            flushedRecords = LoggedRecords::Create(*flushedRecordsArray, loggingError_.load(), GetThisAllocator());
+        }
 
-            OperationData::CSPtr operationData = WriteRecord(*(*flushingRecords_)[i], numberOfBytes);
+        //
+        // The logger allows a single outstanding flush, so the pipeline holds at most two batches:
+        // the one being written and the one whose callbacks and waiters are being completed.
+        // Records that were queued during the write are issued before completing the flushed batch,
+        // which keeps the completions in log order as this task is the only one that processes them
+        //
+        if (isPipelined &&
+            NT_SUCCESS(loggingError_.load()) &&
+            TryTakePendingFlushRecords(*flushedRecords, flushingTasks))
+        {
+            records = flushingRecords_;
+            writeAwaitable = WriteFlushingRecordsAsync(*records);
+            isNextWriteStarted = true;
+        }
 
-#ifdef DBG
-            ReplicatedLogManager::ValidateOperationData(*operationData);
-#endif
+        // It is important to process flushed records before a new flush task can be started by FlushAsync
+        ProcessFlushedRecords(*flushedRecords);
 
-            LogicalLogRecord * logicalRecord = (*flushingRecords_)[i]->AsLogicalLogRecord();
-            if (logicalRecord != nullptr && logicalRecord->IsLatencySensitiveRecord)
-            {
-                latencySensitiveRecords++;
-            }
+        if (isNextWriteStarted)
+        {
+            isFlushTask = true;
+        }
+        else
+        {
+            isFlushTask = ProcessFlushCompletion(*flushedRecords, *flushedTasks, flushingTasks);
+        }
 
-            serializationWatch.Stop();
+        WakeupFlushWaiters(flushedTasks.RawPtr());
 
-            UpdatePerfCounter(PerfCounterName::AvgSerializationLatency, serializationWatch.ElapsedMilliseconds);
+        if (isFlushTask && !NT_SUCCESS(loggingError_.load()))
+        {
+            FailedFlushTask(flushingTasks);
+            isFlushTask = false;
+        }
+        else if (isFlushTask && !isNextWriteStarted)
+        {
+            records = flushingRecords_;
+            writeAwaitable = WriteFlushingRecordsAsync(*records);
+        }
 
-            flushWatch.Start();
+    } while (isFlushTask);
 
-            for (ULONG j = 0; j < operationData->BufferCount; j++)
-            {
-                numberOfBytes += (*operationData)[j]->QuerySize();
+    co_return;
+}
 
-                status = co_await logicalLogStream_->AppendAsync(
-                    *(*operationData)[j],
-                    0,
-                    (*operationData)[j]->QuerySize(),
-                    CancellationToken());
+Awaitable<NTSTATUS> PhysicalLogWriter::WriteFlushingRecordsAsync(__in KSharedArray<LogRecord::SPtr> & flushingRecords)
+{
+    ASSERT_IFNOT(
+        NT_SUCCESS(loggingError_.load()),
+        "{0}:WriteFlushingRecordsAsync | Unexpected logging exception before starting flush",
+        TraceId);
 
-                if (!NT_SUCCESS(status))
-                {
-                    goto FlushComplete;
-                }
-            }
-            flushWatch.Stop();
-        }
+    NTSTATUS status = STATUS_SUCCESS;
+    ULONG latencySensitiveRecords = 0;
+    ULONG numberOfBytes = 0;
+    LogRecord::SPtr newTail = nullptr;
+    Common::Stopwatch flushWatch;
+    Common::Stopwatch serializationWatch;
 
-        flushWatch.Start();
-        status = co_await logicalLogStream_->FlushWithMarkerAsync(CancellationToken());
+    EventSource::Events->FlushStart(
+        TracePartitionId,
+        ReplicaId,
+        flushingRecords.Count(),
+        flushingRecords[0]->Psn,
+        logicalLogStream_->GetWritePosition());
 
-        if (!NT_SUCCESS(status))
-        {
-            goto FlushComplete;
-        }
+    // Enable group commit as we are about to issue IO
+    FlushStarting();
 
-        flushWatch.Stop();
+    for (ULONG i = 0; i < flushingRecords.Count(); i++)
+    {
+        serializationWatch.Start();
 
-        UpdateWriteStats(flushWatch, numberOfBytes);
+        OperationData::CSPtr operationData = WriteRecord(*flushingRecords[i], numberOfBytes);
 
-        currentLogTailPosition_ += numberOfBytes;
-        newTail = (*flushingRecords_)[flushingRecords_->Count() - 1];
-        currentLogTailRecord_.Put(Ktl::Move(newTail));
+#ifdef DBG
+        ReplicatedLogManager::ValidateOperationData(*operationData);
+#endif
 
-        if (flushWatch.Elapsed > transactionalReplicatorConfig_->SlowLogIODuration)
-        {
-            // Update health tracker with slow IO
-            ioMonitor_->OnSlowOperation();
-
-            EventSource::Events->FlushEndWarning(
-                TracePartitionId,
-                ReplicaId,
-                numberOfBytes,
-                latencySensitiveRecords,
-                flushWatch.ElapsedMilliseconds,
-                serializationWatch.ElapsedMilliseconds,
-                (double)writeSpeedBytesPerSecondSum_ / Constants::PhysicalLogWriterMovingAverageHistory,
-                (double)runningLatencySumMs_ / Constants::PhysicalLogWriterMovingAverageHistory,
-                logicalLogStream_->WritePosition - (LONG)numberOfBytes);
-        }
-        else
+        LogicalLogRecord * logicalRecord = flushingRecords[i]->AsLogicalLogRecord();
+        if (logicalRecord != nullptr && logicalRecord->IsLatencySensitiveRecord)
         {
-            EventSource::Events->FlushEnd(
-                TracePartitionId,
-                ReplicaId,
-                numberOfBytes,
-                latencySensitiveRecords,
-                flushWatch.ElapsedMilliseconds,
-                serializationWatch.ElapsedMilliseconds,
-                (double)writeSpeedBytesPerSecondSum_ / Constants::PhysicalLogWriterMovingAverageHistory,
-                (double)runningLatencySumMs_ / Constants::PhysicalLogWriterMovingAverageHistory,
-                logicalLogStream_->WritePosition - (LONG)numberOfBytes);
+            latencySensitiveRecords++;
         }
-    
-    FlushComplete:
-        if (!NT_SUCCESS(status))
-        {
-            loggingError_.store(status);
 
-            LR_TRACE_EXCEPTION(
-                L"FlushTask hit exception.",
-                loggingError_.load());
-        }
+        serializationWatch.Stop();
 
-        // Disable group commit as there is no pending IO
-        FlushCompleted();
+        UpdatePerfCounter(PerfCounterName::AvgSerializationLatency, serializationWatch.ElapsedMilliseconds);
 
-        KSharedArray<AwaitableCompletionSource<void>::SPtr>::SPtr flushedTasks = flushingTasks;
+        flushWatch.Start();
 
-        if (NT_SUCCESS(loggingError_.load()))
+        for (ULONG j = 0; j < operationData->BufferCount; j++)
         {
-            LoggedRecords::SPtr flushedRecords = LoggedRecords::Create(*flushingRecords_, GetThisAllocator());
+            numberOfBytes += (*operationData)[j]->QuerySize();
 
-            ProcessFlushedRecords(*flushedRecords);
+            status = co_await logicalLogStream_->AppendAsync(
+                *(*operationData)[j],
+                0,
+                (*operationData)[j]->QuerySize(),
+                CancellationToken());
 
-            isFlushTask = ProcessFlushCompletion(*flushedRecords, *flushedTasks, flushingTasks);
+            if (!NT_SUCCESS(status))
+            {
+                co_return status;
+            }
         }
-        else
-        {
-            LoggedRecords::CSPtr flushedRecords = LoggedRecords::Create(*flushingRecords_, loggingError_.load(), GetThisAllocator());
+        flushWatch.Stop();
+    }
 
-            ProcessFlushedRecords(*flushedRecords);
+    flushWatch.Start();
+    status = co_await logicalLogStream_->FlushWithMarkerAsync(CancellationToken());
 
-            isFlushTask = ProcessFlushCompletion(*flushedRecords, *flushedTasks, flushingTasks);
-        }
+    if (!NT_SUCCESS(status))
+    {
+        co_return status;
+    }
 
-        WakeupFlushWaiters(flushedTasks.RawPtr());
+    flushWatch.Stop();
 
-        if (isFlushTask && !NT_SUCCESS(loggingError_.load()))
-        {
-            FailedFlushTask(flushingTasks);
-            isFlushTask = false;
-        }
+    UpdateWriteStats(flushWatch, numberOfBytes);
 
-    } while (isFlushTask);
+    currentLogTailPosition_ += numberOfBytes;
+    newTail = flushingRecords[flushingRecords.Count() - 1];
+    currentLogTailRecord_.Put(Ktl::Move(newTail));
 
-    co_return;
+    if (flushWatch.Elapsed > transactionalReplicatorConfig_->SlowLogIODuration)
+    {
+        // Update health tracker with slow IO
+        ioMonitor_->OnSlowOperation();
+
+        EventSource::Events->FlushEndWarning(
+            TracePartitionId,
+            ReplicaId,
+            numberOfBytes,
+            latencySensitiveRecords,
+            flushWatch.ElapsedMilliseconds,
+            serializationWatch.ElapsedMilliseconds,
+            (double)writeSpeedBytesPerSecondSum_ / Constants::PhysicalLogWriterMovingAverageHistory,
+            (double)runningLatencySumMs_ / Constants::PhysicalLogWriterMovingAverageHistory,
+            logicalLogStream_->WritePosition - (LONG)numberOfBytes);
+    }
+    else
+    {
+        EventSource::Events->FlushEnd(
+            TracePartitionId,
+            ReplicaId,
+            numberOfBytes,
+            latencySensitiveRecords,
+            flushWatch.ElapsedMilliseconds,
+            serializationWatch.ElapsedMilliseconds,
+            (double)writeSpeedBytesPerSecondSum_ / Constants::PhysicalLogWriterMovingAverageHistory,
+            (double)runningLatencySumMs_ / Constants::PhysicalLogWriterMovingAverageHistory,
+            logicalLogStream_->WritePosition - (LONG)numberOfBytes);
+    }
+
+    co_return STATUS_SUCCESS;
 }
 
 void PhysicalLogWriter::FailedFlushTask(__inout KSharedArray<AwaitableCompletionSource<void>::SPtr>::SPtr & flushingTasks)
@@ -767,21 +800,7 @@ bool PhysicalLogWriter::ProcessFlushCompletion(
 
     K_LOCK_BLOCK(flushLock_)
     {
-        for (ULONG i = 0; i < flushedRecords.Count; i++)
-        {
-            LONG result = pendingFlushRecordsBytes_.fetch_sub(flushedRecords[i]->ApproximateSizeOnDisk);
-            result = result - flushedRecords[i]->ApproximateSizeOnDisk;
-
-#ifdef DBG
-            ASSERT_IFNOT(
-                result >= 0,
-                "{0}: Subtraction of ApproximateSizeOnDisk {1} for record lsn: {2} yielded negative value for pending flush records {3}",
-                TraceId,
-                flushedRecords[i]->ApproximateSizeOnDisk,
-                flushedRecords[i]->Lsn,
-                result);
-#endif
-        }
+        ReleaseFlushedBytesCallerHoldsLock(flushedRecords);
 
         flushingRecords_ = pendingFlushRecords_;
 
@@ -814,6 +833,48 @@ bool PhysicalLogWriter::ProcessFlushCompletion(
     return isFlushTask;
 }
 
+bool PhysicalLogWriter::TryTakePendingFlushRecords(
+    __in LoggedRecords const & flushedRecords,
+    __out KSharedArray<AwaitableCompletionSource<void>::SPtr>::SPtr & flushingTasks)
+{
+    K_LOCK_BLOCK(flushLock_)
+    {
+        // Pending flush tasks without records are completed along with the flushed records by ProcessFlushCompletion
+        if (pendingFlushRecords_ == nullptr)
+        {
+            return false;
+        }
+
+        ReleaseFlushedBytesCallerHoldsLock(flushedRecords);
+
+        flushingRecords_ = pendingFlushRecords_;
+        flushingTasks = pendingFlushTasks_;
+        pendingFlushRecords_ = nullptr;
+        pendingFlushTasks_ = nullptr;
+    }
+
+    return true;
+}
+
+void PhysicalLogWriter::ReleaseFlushedBytesCallerHoldsLock(__in LoggedRecords const & flushedRecords)
+{
+    for (ULONG i = 0; i < flushedRecords.Count; i++)
+    {
+        LONG result = pendingFlushRecordsBytes_.fetch_sub(flushedRecords[i]->ApproximateSizeOnDisk);
+        result = result - flushedRecords[i]->ApproximateSizeOnDisk;
+
+#ifdef DBG
+        ASSERT_IFNOT(
+            result >= 0,
+            "{0}: Subtraction of ApproximateSizeOnDisk {1} for record lsn: {2} yielded negative value for pending flush records {3}",
+            TraceId,
+            flushedRecords[i]->ApproximateSizeOnDisk,
+            flushedRecords[i]->Lsn,
+            result);
+#endif
+    }
+}
+
 void PhysicalLogWriter::SetTailRecord(__in LogRecord & tailRecord)
 {
     currentLogTailPosition_ = tailRecord.RecordPosition + tailRecord.RecordSize;
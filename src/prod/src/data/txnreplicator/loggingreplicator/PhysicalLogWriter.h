@@ -209,6 +209,9 @@ namespace Data
 
             ktl::Task FlushTask(__in ktl::AwaitableCompletionSource<void> & initiatingTcs);
 
+            // Serializes and appends the records to the logical log and issues the flush for them
+            ktl::Awaitable<NTSTATUS> WriteFlushingRecordsAsync(__in KSharedArray<LogRecordLib::LogRecord::SPtr> & flushingRecords);
+
             void FailedFlushTask(__inout KSharedArray<ktl::AwaitableCompletionSource<void>::SPtr>::SPtr & flushingTasks);
 
             void ProcessFlushedRecords(__in LoggedRecords const & loggedRecords);
@@ -218,6 +221,14 @@ namespace Data
                 __inout KSharedArray<ktl::AwaitableCompletionSource<void>::SPtr> & flushedTasks,
                 __out KSharedArray<ktl::AwaitableCompletionSource<void>::SPtr>::SPtr & flushingTasks);
 
+            // Moves the pending flush records to flushing while the flush task still owns the flush
+            // Returns false if there is nothing to flush, in which case ProcessFlushCompletion must be invoked
+            bool TryTakePendingFlushRecords(
+                __in LoggedRecords const & flushedRecords,
+                __out KSharedArray<ktl::AwaitableCompletionSource<void>::SPtr>::SPtr & flushingTasks);
+
+            void ReleaseFlushedBytesCallerHoldsLock(__in LoggedRecords const & flushedRecords);
+
             // Invoked after the flush task completes a flush
             void FlushCompleted();
             // Invoked before the flush task issues a flush
@@ -252,6 +263,7 @@ namespace Data
 
             //
             // Protects the flushing logic to ensure that there is a single flush issued to the underlying logger at any point in time
+            // With EnablePipelinedLogFlush, the next flush is issued while the callbacks of the previous one are being processed
             //
             mutable KSpinLock flushLock_;
 
@@ -48,9 +48,20 @@ namespace LoggingReplicatorTests
 
     void TransactionMapTest::VerifyPendingTxStats(__in TransactionMap & map, __in ULONG expected)
     {
-        VERIFY_ARE_EQUAL(map.latestRecords_.size(), expected);
-        VERIFY_ARE_EQUAL(map.lsnPendingTransactions_.Count(), expected);
-        VERIFY_ARE_EQUAL(map.transactionIdPendingTransactionsPair_.size(), expected);
+        ULONG latestRecordsCount = 0;
+        ULONG lsnPendingTransactionsCount = 0;
+        ULONG transactionIdPendingTransactionsPairCount = 0;
+
+        for (ULONG i = 0; i < map.shards_.Count(); i++)
+        {
+            latestRecordsCount += static_cast<ULONG>(map.shards_[i]->latestRecords_.size());
+            lsnPendingTransactionsCount += map.shards_[i]->lsnPendingTransactions_.Count();
+            transactionIdPendingTransactionsPairCount += static_cast<ULONG>(map.shards_[i]->transactionIdPendingTransactionsPair_.size());
+        }
+
+        VERIFY_ARE_EQUAL(latestRecordsCount, expected);
+        VERIFY_ARE_EQUAL(lsnPendingTransactionsCount, expected);
+        VERIFY_ARE_EQUAL(transactionIdPendingTransactionsPairCount, expected);
     }
 
     void TransactionMapTest::VerifyCompletedTxStats(__in TransactionMap & map, __in ULONG expected)
@@ -399,6 +410,75 @@ namespace LoggingReplicatorTests
         }
     }
 
+    BOOST_AUTO_TEST_CASE(TxMap_ConcurrentTransactions_VerifyState)
+    {
+        TEST_TRACE_BEGIN("TxMap_ConcurrentTransactions_VerifyState")
+
+        {
+            TransactionMap::SPtr map = TransactionMap::Create(*prId_, allocator);
+            invalidLogRecords_ = InvalidLogRecords::Create(allocator);
+
+            int const threadCount = 16;
+            int const txPerThread = 200;
+            LONG64 volatile lsn = 1;
+
+            // The first transaction of every thread stays pending, the rest are committed
+            KArray<BeginTransactionOperationLogRecord::SPtr> pendingTxs(allocator);
+            for (int i = 0; i < threadCount; i++)
+            {
+                pendingTxs.Append(nullptr);
+            }
+
+            KArray<KEvent *> events(allocator);
+
+            for (int i = 0; i < threadCount; i++)
+            {
+                KEvent * event = _new(KTL_TAG_TEST, allocator)KEvent();
+                events.Append(event);
+                Common::Threadpool::Post([&, i]
+                {
+                    for (int j = 0; j < txPerThread; j++)
+                    {
+                        TestTransaction::SPtr transaction = TestTransaction::Create(*invalidLogRecords_, 1, 1, false, STATUS_SUCCESS, allocator);
+                        BeginTransactionOperationLogRecord::SPtr beginTx = CreateBeginTx(*transaction->Tx, InterlockedIncrement64(&lsn), false);
+                        map->CreateTransaction(*beginTx);
+                        map->AddOperation(*CreateOperation(*transaction->Tx, InterlockedIncrement64(&lsn)));
+
+                        if (j == 0)
+                        {
+                            pendingTxs[i] = beginTx;
+                            continue;
+                        }
+
+                        map->CompleteTransaction(*CreateEndTx(*transaction->Tx, true, InterlockedIncrement64(&lsn)));
+                    }
+
+                    events[i]->SetEvent();
+                });
+            }
+
+            for (int i = 0; i < threadCount; i++)
+            {
+                events[i]->WaitUntilSet();
+                _delete(events[i]);
+            }
+
+            VerifyPendingTxStats(*map, threadCount);
+            VerifyCompletedTxStats(*map, threadCount * (txPerThread - 1));
+
+            LONG64 earliestLsn = MAXLONG64;
+            for (int i = 0; i < threadCount; i++)
+            {
+                earliestLsn = min(earliestLsn, pendingTxs[i]->Lsn);
+            }
+
+            BeginTransactionOperationLogRecord::SPtr earliestPendingTx = map->GetEarliestPendingTransaction();
+            VERIFY_ARE_EQUAL(earliestPendingTx->Lsn, earliestLsn);
+
+            invalidLogRecords_.Reset();
+        }
+    }
+
     // TODO: Add false progress API test cases in the future
 
     BOOST_AUTO_TEST_SUITE_END()
@@ -14,12 +14,9 @@ TransactionMap::TransactionMap(__in Data::Utilities::PartitionedReplicaId const
     : KObject()
     , KShared()
     , PartitionedReplicaTraceComponent(traceId)
-    , lock_()
+    , shards_(GetThisAllocator(), ShardCount)
+    , unstableTransactionsLock_()
     , completedTransactions_(GetThisAllocator())
-    , latestRecords_()
-    , lsnCompareFunction_(&TransactionMap::LsnCompareFunction)
-    , lsnPendingTransactions_(lsnCompareFunction_, GetThisAllocator(), TXMAP_TAG)
-    , transactionIdPendingTransactionsPair_()
     , unstableTransactions_(GetThisAllocator())
 {
     EventSource::Events->Ctor(
@@ -28,9 +25,15 @@ TransactionMap::TransactionMap(__in Data::Utilities::PartitionedReplicaId const
         L"TransactionMap",
         reinterpret_cast<uintptr_t>(this));
 
+    THROW_ON_CONSTRUCTOR_FAILURE(shards_);
     THROW_ON_CONSTRUCTOR_FAILURE(completedTransactions_);
-    THROW_ON_CONSTRUCTOR_FAILURE(lsnPendingTransactions_);
     THROW_ON_CONSTRUCTOR_FAILURE(unstableTransactions_);
+
+    for (ULONG i = 0; i < ShardCount; i++)
+    {
+        NTSTATUS status = shards_.Append(Shard::Create(GetThisAllocator()));
+        THROW_ON_FAILURE(status);
+    }
 }
 
 TransactionMap::~TransactionMap()
@@ -64,13 +67,68 @@ LONG TransactionMap::LsnCompareFunction(
     return 0;
 }
 
-void TransactionMap::Reuse()
+TransactionMap::Shard::SPtr TransactionMap::Shard::Create(__in KAllocator & allocator)
+{
+    Shard * pointer = _new(TXMAP_TAG, allocator)Shard();
+    THROW_ON_ALLOCATION_FAILURE(pointer);
+    return Shard::SPtr(pointer);
+}
+
+TransactionMap::Shard::Shard()
+    : KObject()
+    , KShared()
+    , lock_()
+    , latestRecords_()
+    , lsnCompareFunction_(&TransactionMap::LsnCompareFunction)
+    , lsnPendingTransactions_(lsnCompareFunction_, GetThisAllocator(), TXMAP_TAG)
+    , transactionIdPendingTransactionsPair_()
+{
+    THROW_ON_CONSTRUCTOR_FAILURE(lsnPendingTransactions_);
+}
+
+TransactionMap::Shard::~Shard()
+{
+}
+
+void TransactionMap::Shard::Reuse()
 {
     latestRecords_.clear();
     transactionIdPendingTransactionsPair_.clear();
+    lsnPendingTransactions_.RemoveAll();
+}
+
+TransactionMap::Shard & TransactionMap::GetShard(__in LONG64 transactionId) const
+{
+    ULONG64 hash = static_cast<ULONG64>(transactionId);
+    hash ^= (hash >> 32);
+    return *shards_[static_cast<ULONG>(hash % ShardCount)];
+}
+
+void TransactionMap::AcquireAllShards()
+{
+    for (ULONG i = 0; i < shards_.Count(); i++)
+    {
+        shards_[i]->lock_.Acquire();
+    }
+}
+
+void TransactionMap::ReleaseAllShards()
+{
+    for (ULONG i = shards_.Count(); i > 0; i--)
+    {
+        shards_[i - 1]->lock_.Release();
+    }
+}
+
+void TransactionMap::Reuse()
+{
+    for (ULONG i = 0; i < shards_.Count(); i++)
+    {
+        shards_[i]->Reuse();
+    }
+
     completedTransactions_.Clear();
     unstableTransactions_.Clear();
-    lsnPendingTransactions_.RemoveAll();
 }
 
 void TransactionMap::AddOperation(__in OperationLogRecord & record)
@@ -86,13 +144,15 @@ void TransactionMap::AddOperation(__in OperationLogRecord & record)
         OperationLogRecord::SPtr recordSPtr = &record;
         TransactionLogRecord::SPtr upcastedRecord = recordSPtr.RawPtr();
 
-        K_LOCK_BLOCK(lock_)
+        LONG64 txId = record.BaseTransaction.TransactionId;
+        Shard & shard = GetShard(txId);
+
+        K_LOCK_BLOCK(shard.lock_)
         {
-            LONG64 txId = record.BaseTransaction.TransactionId;
             TransactionLogRecord::SPtr keyFound = nullptr;
-            auto keyFoundIter = latestRecords_.find(txId);
+            auto keyFoundIter = shard.latestRecords_.find(txId);
 
-            if (keyFoundIter != latestRecords_.end())
+            if (keyFoundIter != shard.latestRecords_.end())
             {
                 keyFound = keyFoundIter->second;
                 ASSERT_IF(keyFound == nullptr, "Log record not found during add op for xactid: {0}", txId);
@@ -100,12 +160,12 @@ void TransactionMap::AddOperation(__in OperationLogRecord & record)
                 record.IsEnlistedTransaction = keyFound->IsEnlistedTransaction;
                 record.ParentTransactionRecord = keyFound.RawPtr();
                 keyFound->ChildTransactionRecord = record;
-                latestRecords_[txId] = upcastedRecord;
+                keyFoundIter->second = upcastedRecord;
                 
                 return;
             }
             
-            latestRecords_[txId] = upcastedRecord;
+            shard.latestRecords_[txId] = upcastedRecord;
         }
 
         ASSERT_IFNOT(!record.IsEnlistedTransaction, "Unexpected enlisted xact found during add op");
@@ -118,13 +178,15 @@ void TransactionMap::CompleteTransaction(__in EndTransactionLogRecord & record)
 {
     ASSERT_IFNOT(!record.BaseTransaction.IsAtomicOperation, "Unexpected atomic op xact during complete xact");
 
-    K_LOCK_BLOCK(lock_)
+    LONG64 txId = record.BaseTransaction.TransactionId;
+    Shard & shard = GetShard(txId);
+
+    K_LOCK_BLOCK(shard.lock_)
     {
-        LONG64 txId = record.BaseTransaction.TransactionId;
         TransactionLogRecord::SPtr keyFound = nullptr;
-        auto keyFoundIter = latestRecords_.find(txId);
+        auto keyFoundIter = shard.latestRecords_.find(txId);
 
-        if (keyFoundIter != latestRecords_.end())
+        if (keyFoundIter != shard.latestRecords_.end())
         {
             keyFound = keyFoundIter->second;
             ASSERT_IF(keyFound == nullptr, "Log record not found during complete xact for xactid: {0}", txId);
@@ -132,7 +194,7 @@ void TransactionMap::CompleteTransaction(__in EndTransactionLogRecord & record)
             record.IsEnlistedTransaction = keyFound->IsEnlistedTransaction;
             record.ParentTransactionRecord = keyFound.RawPtr();
             keyFound->ChildTransactionRecord = record;
-            latestRecords_.erase(txId);
+            shard.latestRecords_.erase(keyFoundIter);
         }
         else
         {
@@ -141,25 +203,29 @@ void TransactionMap::CompleteTransaction(__in EndTransactionLogRecord & record)
         }
 
         BeginTransactionOperationLogRecord::SPtr beginTransactionRecord = nullptr;
-        auto txIdFoundIter = transactionIdPendingTransactionsPair_.find(txId);
+        auto txIdFoundIter = shard.transactionIdPendingTransactionsPair_.find(txId);
 
-        if (txIdFoundIter != transactionIdPendingTransactionsPair_.end())
+        if (txIdFoundIter != shard.transactionIdPendingTransactionsPair_.end())
         {
             beginTransactionRecord = txIdFoundIter->second;
             ASSERT_IFNOT(beginTransactionRecord != nullptr, "Could not find begin xact log record: {0}", txId);
 
-            bool success = lsnPendingTransactions_.Remove(LsnKeyType(beginTransactionRecord->Lsn));
+            bool success = shard.lsnPendingTransactions_.Remove(LsnKeyType(beginTransactionRecord->Lsn));
             ASSERT_IFNOT(success, "Cound not remove lsn from pending list: {0}. Returned {1}", beginTransactionRecord->Lsn, success);
 
-            transactionIdPendingTransactionsPair_.erase(txId);
+            shard.transactionIdPendingTransactionsPair_.erase(txIdFoundIter);
         }
 
         ASSERT_IFNOT(
             (record.IsEnlistedTransaction == true) == (beginTransactionRecord != nullptr),
             "Unexpected xact record in complete xact");
 
+        // The transaction moves from pending to unstable while the shard is held, so that it is never missing from both
         if (beginTransactionRecord != nullptr)
         {
+            unstableTransactionsLock_.Acquire();
+            KFinally([&] { unstableTransactionsLock_.Release(); });
+
             AddUnstableTransactionCallerHoldsLock(*beginTransactionRecord, record);
         }
     }
@@ -176,18 +242,20 @@ void TransactionMap::CreateTransaction(__in BeginTransactionOperationLogRecord &
     }
     else
     {
-        K_LOCK_BLOCK(lock_)
+        LONG64 txId = record.BaseTransaction.TransactionId;
+        Shard & shard = GetShard(txId);
+
+        K_LOCK_BLOCK(shard.lock_)
         {
-            LONG64 txId = record.BaseTransaction.TransactionId;
             BeginTransactionOperationLogRecord::SPtr recordSPtr = &record;
             TransactionLogRecord::SPtr upcastedRecord = recordSPtr.RawPtr();
 
-            latestRecords_[txId] = upcastedRecord;
+            shard.latestRecords_[txId] = upcastedRecord;
             record.IsEnlistedTransaction = true;
 
-            transactionIdPendingTransactionsPair_[txId] = recordSPtr;
+            shard.transactionIdPendingTransactionsPair_[txId] = recordSPtr;
             
-            NTSTATUS status = lsnPendingTransactions_.Insert(recordSPtr, LsnKeyType(record.Lsn));
+            NTSTATUS status = shard.lsnPendingTransactions_.Insert(recordSPtr, LsnKeyType(record.Lsn));
             ASSERT_IFNOT(status == STATUS_SUCCESS, "Error inserting lsn in pending xacts: {0}", record.Lsn);
         }
     }
@@ -195,7 +263,7 @@ void TransactionMap::CreateTransaction(__in BeginTransactionOperationLogRecord &
 
 void TransactionMap::RemoveStableTransactions(__in LONG64 lastStableLsn)
 {
-    K_LOCK_BLOCK(lock_)
+    K_LOCK_BLOCK(unstableTransactionsLock_)
     {
         for (LONG i = unstableTransactions_.Count() - 1; i >= 0; i--)
         {
@@ -290,31 +358,32 @@ BeginTransactionOperationLogRecord::SPtr TransactionMap::DeleteTransaction(__in
         return recordSPtr;
     }
 
-    K_LOCK_BLOCK(lock_)
-    {
-        LONG64 txId = recordSPtr->BaseTransaction.TransactionId;
+    LONG64 txId = recordSPtr->BaseTransaction.TransactionId;
+    Shard & shard = GetShard(txId);
 
-        ASSERT_IFNOT(latestRecords_.count(txId) > 0, "Transaction log record not found in latest records");
-        ASSERT_IFNOT(transactionIdPendingTransactionsPair_.count(txId) > 0, "Transaction log record not found in pending transaction pairs");
+    K_LOCK_BLOCK(shard.lock_)
+    {
+        ASSERT_IFNOT(shard.latestRecords_.count(txId) > 0, "Transaction log record not found in latest records");
+        ASSERT_IFNOT(shard.transactionIdPendingTransactionsPair_.count(txId) > 0, "Transaction log record not found in pending transaction pairs");
 
-        TransactionLogRecord::SPtr keyFoundInLatestRecords = latestRecords_[txId];
-        BeginTransactionOperationLogRecord::SPtr keyFoundInPendingTxPair = transactionIdPendingTransactionsPair_[txId];
+        TransactionLogRecord::SPtr keyFoundInLatestRecords = shard.latestRecords_[txId];
+        BeginTransactionOperationLogRecord::SPtr keyFoundInPendingTxPair = shard.transactionIdPendingTransactionsPair_[txId];
 
         recordSPtr = dynamic_cast<BeginTransactionOperationLogRecord *>(keyFoundInLatestRecords.RawPtr());
         ASSERT_IFNOT(recordSPtr != nullptr, "Invalid begin xact op log record during delete");
 
         ASSERT_IFNOT(recordSPtr.RawPtr() == keyFoundInPendingTxPair.RawPtr(), "Invalid log record"); // TODO: Verify validity of this assert
 
-        latestRecords_.erase(txId);
+        shard.latestRecords_.erase(txId);
 
         recordSPtr->IsEnlistedTransaction = true;
 
         LONG64 lsn = recordSPtr->Lsn;
 
-        bool success = lsnPendingTransactions_.Remove(lsn);
+        bool success = shard.lsnPendingTransactions_.Remove(lsn);
         ASSERT_IFNOT(success, "Cound not remove lsn from pending list: {0}. Returned {1}", lsn, success);
 
-        transactionIdPendingTransactionsPair_.erase(txId);
+        shard.transactionIdPendingTransactionsPair_.erase(txId);
     }
 
     return recordSPtr;
@@ -335,12 +404,14 @@ OperationLogRecord::SPtr TransactionMap::FindOperation(__in OperationLogRecord &
 
     ASSERT_IFNOT(LogRecord::IsInvalid(recordSPtr->ParentTransactionRecord.RawPtr()), "Invalid parent log record in find op");
     
-    K_LOCK_BLOCK(lock_)
+    LONG64 txId = recordSPtr->BaseTransaction.TransactionId;
+    Shard & shard = GetShard(txId);
+
+    K_LOCK_BLOCK(shard.lock_)
     {
-        LONG64 txId = recordSPtr->BaseTransaction.TransactionId;
-        ASSERT_IFNOT(latestRecords_.count(txId) > 0, "Transaction log record not found in latest records during find");
+        ASSERT_IFNOT(shard.latestRecords_.count(txId) > 0, "Transaction log record not found in latest records during find");
 
-        TransactionLogRecord::SPtr keyFoundInLatestRecords = latestRecords_[txId];
+        TransactionLogRecord::SPtr keyFoundInLatestRecords = shard.latestRecords_[txId];
 
         recordSPtr = dynamic_cast<OperationLogRecord *>(keyFoundInLatestRecords.RawPtr());
         ASSERT_IFNOT(recordSPtr != nullptr, "Invalid op log record in find op");
@@ -362,12 +433,14 @@ BeginTransactionOperationLogRecord::SPtr TransactionMap::FindTransaction(__in Be
         return recordSPtr;
     }
 
-    K_LOCK_BLOCK(lock_)
+    LONG64 txId = recordSPtr->BaseTransaction.TransactionId;
+    Shard & shard = GetShard(txId);
+
+    K_LOCK_BLOCK(shard.lock_)
     {
-        LONG64 txId = recordSPtr->BaseTransaction.TransactionId;
-        ASSERT_IFNOT(latestRecords_.count(txId) > 0, "Transaction log record not found in latest records during find");
+        ASSERT_IFNOT(shard.latestRecords_.count(txId) > 0, "Transaction log record not found in latest records during find");
 
-        TransactionLogRecord::SPtr keyFoundInLatestRecords = latestRecords_[txId];
+        TransactionLogRecord::SPtr keyFoundInLatestRecords = shard.latestRecords_[txId];
 
         recordSPtr = dynamic_cast<BeginTransactionOperationLogRecord *>(keyFoundInLatestRecords.RawPtr());
         ASSERT_IFNOT(recordSPtr != nullptr, "Invalid begin xact op log record in find xact");
@@ -385,7 +458,7 @@ EndTransactionLogRecord::SPtr TransactionMap::FindUnstableTransaction(__in EndTr
     
     LONG i = 0;
 
-    K_LOCK_BLOCK(lock_)
+    K_LOCK_BLOCK(unstableTransactionsLock_)
     {
         for (i = unstableTransactions_.Count() - 1; i >= 0; i--)
         {
@@ -412,59 +485,79 @@ BeginTransactionOperationLogRecord::SPtr TransactionMap::GetEarliestPendingTrans
     __in LONG64 barrierLsn,
     __out bool & failedBarrierCheck)
 {
-    K_LOCK_BLOCK(lock_)
+    BeginTransactionOperationLogRecord::SPtr result = nullptr;
+
+    // All the shards are held to get the same snapshot of pending and unstable transactions as a single lock.
+    // The earliest pending transaction of each shard is the first entry of its lsn ordered tree
+    AcquireAllShards();
+    KFinally([&] { ReleaseAllShards(); });
+
+    K_LOCK_BLOCK(unstableTransactionsLock_)
     {
-        if (unstableTransactions_.Count() == 0 ||
-            unstableTransactions_[unstableTransactions_.Count() - 1]->Lsn <= barrierLsn)
+        if (unstableTransactions_.Count() > 0 &&
+            unstableTransactions_[unstableTransactions_.Count() - 1]->Lsn > barrierLsn)
         {
-            failedBarrierCheck = false;
+            failedBarrierCheck = true;
+            return nullptr;
+        }
+    }
 
-            if (lsnPendingTransactions_.Count() > 0)
-            {
-                LsnPendingTransactionsMap::Iterator it = lsnPendingTransactions_.GetIterator();
+    failedBarrierCheck = false;
 
-                ASSERT_IFNOT(it.IsValid() == TRUE, "Invalid lsn pending xact iterator");
+    for (ULONG i = 0; i < shards_.Count(); i++)
+    {
+        LsnPendingTransactionsMap & lsnPendingTransactions = shards_[i]->lsnPendingTransactions_;
+        if (lsnPendingTransactions.Count() > 0)
+        {
+            LsnPendingTransactionsMap::Iterator it = lsnPendingTransactions.GetIterator();
 
-                if (it.GetKey().value < barrierLsn)
-                {
-                    BeginTransactionOperationLogRecord::SPtr result = it.Get();
-                    return result;
-                }
-            }
+            ASSERT_IFNOT(it.IsValid() == TRUE, "Invalid lsn pending xact iterator");
 
-            return nullptr;
+            if (it.GetKey().value < barrierLsn &&
+                (result == nullptr || it.GetKey().value < result->Lsn))
+            {
+                result = it.Get();
+            }
         }
-
-        failedBarrierCheck = true;
     }
 
-    return nullptr;
+    return result;
 }
 
 void TransactionMap::GetPendingRecords(__out KArray<TransactionLogRecord::SPtr> & pendingRecords)
 {
-    K_LOCK_BLOCK(lock_)
+    NTSTATUS status;
+
+    for (ULONG i = 0; i < shards_.Count(); i++)
     {
-        NTSTATUS status;
+        Shard & shard = *shards_[i];
 
-        for (auto const & pair : latestRecords_)
+        K_LOCK_BLOCK(shard.lock_)
         {
-            status = pendingRecords.Append(pair.second);
-            THROW_ON_FAILURE(status);
+            for (auto const & pair : shard.latestRecords_)
+            {
+                status = pendingRecords.Append(pair.second);
+                THROW_ON_FAILURE(status);
+            }
         }
     }
 }
 
 void TransactionMap::GetPendingTransactions(__out KArray<BeginTransactionOperationLogRecord::SPtr> & pendingTransactions)
 {
-    K_LOCK_BLOCK(lock_)
+    NTSTATUS status;
+
+    for (ULONG i = 0; i < shards_.Count(); i++)
     {
-        NTSTATUS status;
+        Shard & shard = *shards_[i];
 
-        for (auto const & pair : transactionIdPendingTransactionsPair_)
+        K_LOCK_BLOCK(shard.lock_)
         {
-            status = pendingTransactions.Append(pair.second);
-            THROW_ON_FAILURE(status);
+            for (auto const & pair : shard.transactionIdPendingTransactionsPair_)
+            {
+                status = pendingTransactions.Append(pair.second);
+                THROW_ON_FAILURE(status);
+            }
         }
     }
 }
@@ -473,24 +566,29 @@ void TransactionMap::GetPendingTransactionsOlderThanPosition(
     __in ULONG64 recordPosition,
     __out KArray<BeginTransactionOperationLogRecord::SPtr> & pendingTransactions)
 {
-    K_LOCK_BLOCK(lock_)
+    NTSTATUS status;
+
+    for (ULONG i = 0; i < shards_.Count(); i++)
     {
-        if (lsnPendingTransactions_.Count() > 0)
-        {
-            LsnPendingTransactionsMap::Iterator it = lsnPendingTransactions_.GetIterator();
-            
-            ASSERT_IFNOT(it.IsValid() == TRUE, "Invalid lsn pending xact map iterator");
+        Shard & shard = *shards_[i];
 
-            NTSTATUS status;
-            
-            do
+        K_LOCK_BLOCK(shard.lock_)
+        {
+            if (shard.lsnPendingTransactions_.Count() > 0)
             {
-                if (it.Get()->RecordPosition <= recordPosition)
+                LsnPendingTransactionsMap::Iterator it = shard.lsnPendingTransactions_.GetIterator();
+
+                ASSERT_IFNOT(it.IsValid() == TRUE, "Invalid lsn pending xact map iterator");
+
+                do
                 {
-                    status = pendingTransactions.Append(it.Get());
-                    THROW_ON_FAILURE(status);
-                }
-            } while (it.Next() == TRUE);
+                    if (it.Get()->RecordPosition <= recordPosition)
+                    {
+                        status = pendingTransactions.Append(it.Get());
+                        THROW_ON_FAILURE(status);
+                    }
+                } while (it.Next() == TRUE);
+            }
         }
     }
 }
@@ -512,18 +610,20 @@ OperationLogRecord::SPtr TransactionMap::RedactOperation(
 
     ASSERT_IFNOT(LogRecord::IsInvalid(recordSPtr->ParentTransactionRecord.RawPtr()), "Invalid parent log record during redact");
     
-    K_LOCK_BLOCK(lock_)
+    LONG64 txId = recordSPtr->BaseTransaction.TransactionId;
+    Shard & shard = GetShard(txId);
+
+    K_LOCK_BLOCK(shard.lock_)
     {
-        LONG64 txId = recordSPtr->BaseTransaction.TransactionId;
-        ASSERT_IFNOT(latestRecords_.count(txId) > 0, "Transaction log record not found in redact operation");
+        ASSERT_IFNOT(shard.latestRecords_.count(txId) > 0, "Transaction log record not found in redact operation");
 
-        TransactionLogRecord::SPtr keyFoundInLatestRecords = latestRecords_[txId];
+        TransactionLogRecord::SPtr keyFoundInLatestRecords = shard.latestRecords_[txId];
 
         recordSPtr = dynamic_cast<OperationLogRecord *>(keyFoundInLatestRecords.RawPtr());
         ASSERT_IFNOT(recordSPtr != nullptr, "Invalid op log record during redact");
 
         TransactionLogRecord::SPtr parentRecord = recordSPtr->ParentTransactionRecord;
-        latestRecords_[txId] = parentRecord;
+        shard.latestRecords_[txId] = parentRecord;
         parentRecord->ChildTransactionRecord = invalidTransactionLogRecord;
     }
 
@@ -541,9 +641,15 @@ EndTransactionLogRecord::SPtr TransactionMap::ReifyTransaction(
     EndTransactionLogRecord::SPtr reifiedEndTransactionRecord = nullptr;
 
     LONG i;
+    LONG64 txId = record.BaseTransaction.TransactionId;
+    Shard & shard = GetShard(txId);
 
-    K_LOCK_BLOCK(lock_)
+    K_LOCK_BLOCK(shard.lock_)
     {
+        // Taken while the shard is held, the transaction becomes pending again before it stops being unstable
+        unstableTransactionsLock_.Acquire();
+        KFinally([&] { unstableTransactionsLock_.Release(); });
+
         for (i = completedTransactions_.Count() - 1; i >= 0; i--)
         {
             if (completedTransactions_[i]->BaseTransaction == record.BaseTransaction)
@@ -571,10 +677,9 @@ EndTransactionLogRecord::SPtr TransactionMap::ReifyTransaction(
 
         ASSERT_IFNOT(i >= 0, "End xact record is not present in unstable xacts");
 
-        LONG64 txId = record.BaseTransaction.TransactionId;
         TransactionLogRecord::SPtr parentRecord = reifiedEndTransactionRecord->ParentTransactionRecord;
 
-        latestRecords_[txId] = parentRecord;
+        shard.latestRecords_[txId] = parentRecord;
         parentRecord->ChildTransactionRecord = invalidTransactionLogRecord;
         parentRecord = reifiedEndTransactionRecord.RawPtr();
 
@@ -586,8 +691,8 @@ EndTransactionLogRecord::SPtr TransactionMap::ReifyTransaction(
         ASSERT_IFNOT(reifiedBeginTransactionRecord.RawPtr() == parentRecord.RawPtr(), "Invalid refied being xact log record");
         ASSERT_IFNOT(reifiedBeginTransactionRecord->IsEnlistedTransaction, "Non enlisted xact in reified xact record");
 
-        transactionIdPendingTransactionsPair_[txId] = reifiedBeginTransactionRecord;
-        NTSTATUS status = lsnPendingTransactions_.Insert(reifiedBeginTransactionRecord, LsnKeyType(reifiedBeginTransactionRecord->Lsn));
+        shard.transactionIdPendingTransactionsPair_[txId] = reifiedBeginTransactionRecord;
+        NTSTATUS status = shard.lsnPendingTransactions_.Insert(reifiedBeginTransactionRecord, LsnKeyType(reifiedBeginTransactionRecord->Lsn));
         ASSERT_IFNOT(status == STATUS_SUCCESS, "Error inserting reified log record in lsn pending xacts: {0}", status);
     }
 
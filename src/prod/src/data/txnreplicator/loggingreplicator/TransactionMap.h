@@ -99,6 +99,34 @@ namespace Data
 
             typedef KAvlTree<LogRecordLib::BeginTransactionOperationLogRecord::SPtr, LsnKeyType> LsnPendingTransactionsMap;
 
+            //
+            // Pending transactions whose id maps to the shard.
+            // Operations on different transactions only contend when they map to the same shard
+            //
+            class Shard
+                : public KObject<Shard>
+                , public KShared<Shard>
+            {
+                K_FORCE_SHARED(Shard)
+
+            public:
+
+                static Shard::SPtr Create(__in KAllocator & allocator);
+
+                void Reuse();
+
+                KSpinLock lock_;
+
+                std::unordered_map<LONG64, LogRecordLib::TransactionLogRecord::SPtr> latestRecords_;
+
+                // Define the comparision function before the avl tree as the former is fed into the latter as an input. So the former must be initialized first
+                LsnPendingTransactionsMap::KeyComparisonFunc lsnCompareFunction_;
+                LsnPendingTransactionsMap lsnPendingTransactions_;
+
+                // needed to quickly find earliest pending tx. Order by lsn
+                std::unordered_map<LONG64, LogRecordLib::BeginTransactionOperationLogRecord::SPtr> transactionIdPendingTransactionsPair_;
+            };
+
             //
             // < 0 - The left is less than the right.
             //   0 - The left and the right are equal.
@@ -108,22 +136,24 @@ namespace Data
                 __in LsnKeyType const & left,
                 __in LsnKeyType const & right);
 
+            Shard & GetShard(__in LONG64 transactionId) const;
+
+            // Shards are always acquired in index order, before unstableTransactionsLock_
+            void AcquireAllShards();
+            void ReleaseAllShards();
+
             void AddUnstableTransactionCallerHoldsLock(
                 __in LogRecordLib::BeginTransactionOperationLogRecord & beginTransactionRecord,
                 __in LogRecordLib::EndTransactionLogRecord & endTransactionRecord);
 
-            KSpinLock lock_;
+            static const ULONG ShardCount = 16;
 
-            KArray<LogRecordLib::BeginTransactionOperationLogRecord::SPtr> completedTransactions_;
+            KArray<Shard::SPtr> shards_;
 
-            std::unordered_map<LONG64, LogRecordLib::TransactionLogRecord::SPtr> latestRecords_;
-            
-            // Define the comparision function before the avl tree as the former is fed into the latter as an input. So the former must be initialized first
-            LsnPendingTransactionsMap::KeyComparisonFunc lsnCompareFunction_;
-            LsnPendingTransactionsMap lsnPendingTransactions_;
-            
-            // needed to quickly find earliest pending tx. Order by lsn
-            std::unordered_map<LONG64, LogRecordLib::BeginTransactionOperationLogRecord::SPtr> transactionIdPendingTransactionsPair_;
+            // Protects the completed and unstable transactions
+            KSpinLock unstableTransactionsLock_;
+
+            KArray<LogRecordLib::BeginTransactionOperationLogRecord::SPtr> completedTransactions_;
 
             // lsn ordered
             KArray<LogRecordLib::EndTransactionLogRecord::SPtr> unstableTransactions_;
@@ -27,6 +27,7 @@ namespace LoggingReplicatorTests
         Awaitable<void> UnRegister_ItemRegisteredOnce_TaskMustCompleteImmediatelyAfterUnregister();
         Awaitable<void> UnRegister_ItemRegisteredTwice_TaskMustNotCompleteUntilSecondUnRegister();
         Awaitable<void> UnRegister_ItemRegisteredManyTimes_TaskMustNotCompleteUntilLastUnRegister();
+        Awaitable<void> UnRegister_ItemsUnRegisteredOnOtherThreads_TaskMustNotCompleteUntilLastUnRegister();
 
         void TryRemoveVersion_NoInflightSnapshots_CanRemove();
         Awaitable<void> TryRemoveVersion_VersionAndNextVersionHigherThanOneExistingSnapshot_CanRemove();
@@ -185,6 +186,69 @@ namespace LoggingReplicatorTests
         co_return;
     }
 
+    Awaitable<void> VersionManagerTest::UnRegister_ItemsUnRegisteredOnOtherThreads_TaskMustNotCompleteUntilLastUnRegister()
+    {
+        // Expected
+        vector<LONG64> set0{ 10 };
+        vector<LONG64> notification0{ 10 };
+        TryRemoveVersionResult::SPtr expectedResult = CreateExpectedTryRemoveResult(set0, notification0, GetAllocator());
+
+        // Setup
+        LONG64 stateProviderId = GetRandomLONG64();
+
+        vector<LONG64> barrierResponses{ 10, 10, 10, 10 };
+        TestVersionProvider::SPtr testVersionProvider = TestVersionProvider::Create(barrierResponses, GetAllocator());
+        VersionManager::SPtr versionManagerSPtr = VersionManager::Create(GetAllocator());
+        versionManagerSPtr->Initialize(*testVersionProvider);
+
+        // Register snapshots.
+        co_await RegisterMultipleSnapshotsAsync(*versionManagerSPtr, barrierResponses);
+
+        // Test
+        auto result = TestTryRemoveVersion(*versionManagerSPtr, stateProviderId, 5, 15, *expectedResult);
+
+        // Readers are not required to unregister on the thread they registered on.
+        for (int i = 0; i < barrierResponses.size() - 1; i++)
+        {
+            KEvent unRegistered;
+            Common::Threadpool::Post([&]
+            {
+                versionManagerSPtr->UnRegister(10);
+                unRegistered.SetEvent();
+            });
+
+            unRegistered.WaitUntilSet();
+
+            auto enumerator = result->EnumerationCompletionNotifications->GetEnumerator();
+            while (enumerator->MoveNext())
+            {
+                VERIFY_IS_FALSE(enumerator->Current()->IsNotificationCompleted);
+            }
+        }
+
+        KEvent lastUnRegistered;
+        Common::Threadpool::Post([&]
+        {
+            versionManagerSPtr->UnRegister(10);
+            lastUnRegistered.SetEvent();
+        });
+
+        lastUnRegistered.WaitUntilSet();
+
+        auto enumerator = result->EnumerationCompletionNotifications->GetEnumerator();
+        while (enumerator->MoveNext())
+        {
+            EnumerationCompletionResult::SPtr current = enumerator->Current();
+            VERIFY_IS_TRUE(current->IsNotificationCompleted);
+            Awaitable<LONG64> notificationAwaitable = current->Notification;
+            co_await notificationAwaitable;
+        }
+
+        VerifyState(*versionManagerSPtr, DefaultRetryCount, 0, 0, 0);
+
+        co_return;
+    }
+
     void VersionManagerTest::TryRemoveVersion_NoInflightSnapshots_CanRemove()
     {
         // Expected
@@ -788,6 +852,11 @@ namespace LoggingReplicatorTests
         SyncAwait(UnRegister_ItemRegisteredManyTimes_TaskMustNotCompleteUntilLastUnRegister());
     }
 
+    BOOST_AUTO_TEST_CASE(VM_UnRegister_ItemsUnRegisteredOnOtherThreads_TaskMustNotCompleteUntilLastUnRegister)
+    {
+        SyncAwait(UnRegister_ItemsUnRegisteredOnOtherThreads_TaskMustNotCompleteUntilLastUnRegister());
+    }
+
     BOOST_AUTO_TEST_CASE(VM_TryRemoveVersion_NoInflightSnapshots_CanRemove)
     {
         TryRemoveVersion_NoInflightSnapshots_CanRemove();
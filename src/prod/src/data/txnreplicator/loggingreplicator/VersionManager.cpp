@@ -10,21 +10,6 @@ using namespace Data::LoggingReplicator;
 using namespace TxnReplicator;
 using namespace Data::Utilities;
 
-inline LONG32 Compare(LONG64 const & one, LONG64 const & two)
-{
-    if (one == two)
-    {
-        return 0;
-    }
-
-    if (one > two)
-    {
-        return 1;
-    }
-
-    return -1;
-}
-
 inline ULONG Hash(__in EnumerationCompletionResult::SPtr const & enumerationCompletionResult)
 {
     return enumerationCompletionResult->GetHashCode();
@@ -49,9 +34,10 @@ VersionManager::VersionManager()
     : IInternalVersionManager()
     , KObject()
     , KShared()
+    , readerStripes_(GetThisAllocator(), ReaderStripeCount)
+    , readerRemovalNotificationsLock_()
     , readerRemovalNotifications_(ExpectedNumberOfInflightNotifications, K_DefaultHashFunction, GetThisAllocator())
-    , versionList_(GetThisAllocator(), ExpectedNumberOfInflightVisibilitySequenceNumbers)
-    , versionListLock_()
+    , readerRemovalNotificationsCount_(0)
     , lastDispatchingBarrier_(nullptr)
 {
     if (NT_SUCCESS(readerRemovalNotifications_.Status()) == false)
@@ -60,14 +46,33 @@ VersionManager::VersionManager()
         return;
     }
 
-    if (NT_SUCCESS(versionList_.Status()) == false)
+    if (NT_SUCCESS(readerStripes_.Status()) == false)
     {
-        SetConstructorStatus(versionList_.Status());
+        SetConstructorStatus(readerStripes_.Status());
         return;
     }
 
+    NTSTATUS status = STATUS_SUCCESS;
+    for (ULONG i = 0; i < ReaderStripeCount; i++)
+    {
+        VersionReaderStripe::SPtr stripe = nullptr;
+        status = VersionReaderStripe::Create(GetThisAllocator(), stripe);
+        if (NT_SUCCESS(status) == false)
+        {
+            SetConstructorStatus(status);
+            return;
+        }
+
+        status = readerStripes_.Append(stripe);
+        if (NT_SUCCESS(status) == false)
+        {
+            SetConstructorStatus(status);
+            return;
+        }
+    }
+
     NotificationKeyComparer::SPtr comparerSPtr(nullptr);
-    NTSTATUS status = NotificationKeyComparer::Create(GetThisAllocator(), comparerSPtr);
+    status = NotificationKeyComparer::Create(GetThisAllocator(), comparerSPtr);
     if (NT_SUCCESS(status) == false)
     {
         SetConstructorStatus(status);
@@ -133,15 +138,13 @@ Awaitable<NTSTATUS> VersionManager::TryRemoveCheckpointAsync(
     KArray<Awaitable<LONG64>> taskList(GetThisAllocator());
     THROW_ON_FAILURE(taskList.Status());
 
-    versionListLock_.AcquireShared();
+    AcquireAllReaderStripesShared();
     {
-        KFinally([&] {versionListLock_.ReleaseShared(); });
+        KFinally([&] {ReleaseAllReaderStripesShared(); });
 
-        LONG32 indexVisibilitySequenceHigherThanVersionToBeRemoved;
         bool canBeRemoved = CanVersionBeRemovedCallerHoldsLock(
             checkpointLSNToBeRemoved,
-            nextCheckpointLSN,
-            indexVisibilitySequenceHigherThanVersionToBeRemoved);
+            nextCheckpointLSN);
 
         if (canBeRemoved == true)
         {
@@ -150,17 +153,14 @@ Awaitable<NTSTATUS> VersionManager::TryRemoveCheckpointAsync(
         }
 
         KHashSet<LONG64>::SPtr versionsKeepingItemAlive = FindAllVisibilitySequenceNumbersKeepingVersionAliveCallerHoldsLock(
-            indexVisibilitySequenceHigherThanVersionToBeRemoved,
+            checkpointLSNToBeRemoved,
             nextCheckpointLSN);
 
         IEnumerator<LONG64>::SPtr enumerator = versionsKeepingItemAlive->GetEnumerator();
         while (enumerator->MoveNext())
         {
             LONG64 visibility = enumerator->Current();
-            AwaitableCompletionSource<LONG64>::SPtr acs = nullptr;
-            status = readerRemovalNotifications_.Get(visibility, acs);
-            ASSERT_IFNOT(NT_SUCCESS(status), "Reader removal notification must already exist for VSN: {0}", visibility);
-            ASSERT_IFNOT(acs != nullptr, "Removed acs must not be nullptr for VSN: {0}", visibility);
+            AwaitableCompletionSource<LONG64>::SPtr acs = GetOrAddReaderRemovalNotificationCallerHoldsLock(visibility);
 
             taskList.Append(Ktl::Move(acs->GetAwaitable()));
         }
@@ -187,15 +187,13 @@ NTSTATUS VersionManager::TryRemoveVersion(
     KHashSet<LONG64>::SPtr versionsKeepingItemAlive = nullptr;
     KHashSet<EnumerationCompletionResult::SPtr>::SPtr enumerationCompletionResultSet = nullptr;
 
-    versionListLock_.AcquireShared();
+    AcquireAllReaderStripesShared();
     {
-        KFinally([&] {versionListLock_.ReleaseShared(); });
+        KFinally([&] {ReleaseAllReaderStripesShared(); });
 
-        LONG32 indexVisibilityLSNHigherThanVersionToBeRemoved;
         bool canBeRemoved = CanVersionBeRemovedCallerHoldsLock(
             commitLSN,
-            nextCommitLSN,
-            indexVisibilityLSNHigherThanVersionToBeRemoved);
+            nextCommitLSN);
 
         if (canBeRemoved == true)
         {
@@ -204,7 +202,7 @@ NTSTATUS VersionManager::TryRemoveVersion(
         }
 
         versionsKeepingItemAlive = FindAllVisibilitySequenceNumbersKeepingVersionAliveCallerHoldsLock(
-            indexVisibilityLSNHigherThanVersionToBeRemoved,
+            commitLSN,
             nextCommitLSN);
 
         IEnumerator<LONG64>::SPtr enumerator = versionsKeepingItemAlive->GetEnumerator();
@@ -233,10 +231,7 @@ NTSTATUS VersionManager::TryRemoveVersion(
                 RETURN_ON_FAILURE(status);
             }
 
-            AwaitableCompletionSource<LONG64>::SPtr acs = nullptr;
-            status = readerRemovalNotifications_.Get(visibility, acs);
-            ASSERT_IFNOT(NT_SUCCESS(status), "Reader removal notification must already exist for VSN: {0}", visibility);
-            ASSERT_IFNOT(acs != nullptr, "Removed acs must not be nullptr for VSN: {0}", visibility);
+            AwaitableCompletionSource<LONG64>::SPtr acs = GetOrAddReaderRemovalNotificationCallerHoldsLock(visibility);
 
             ProcessNotificationTask(*acs, *notificationKeySPtr);
 
@@ -275,30 +270,20 @@ Awaitable<NTSTATUS> VersionManager::RegisterAsync(__out FABRIC_SEQUENCE_NUMBER &
     IVersionProvider::SPtr loggingReplicator = this->versionProviderSPtr_->TryGetTarget();
     ASSERT_IFNOT(loggingReplicator != nullptr, "LoggingReplicator could not have closed.");
 
-    versionListLock_.AcquireExclusive();
+    // The version must be read under the stripe lock so that a concurrent removal scan either sees this reader
+    // or runs before the version is handed out.
+    VersionReaderStripe & stripe = GetReaderStripeForCurrentThread();
+    stripe.AcquireExclusive();
     {
-        KFinally([&] {versionListLock_.ReleaseExclusive(); });
+        KFinally([&] {stripe.ReleaseExclusive(); });
 
         status = loggingReplicator->GetVersion(vsn);
 
         CO_RETURN_ON_FAILURE(status);
 
-        ULONG currentSnapshotCount = versionList_.Count();
-        ASSERT_IFNOT(
-            currentSnapshotCount == 0 || vsn >= versionList_[currentSnapshotCount - 1],
-            "Barriers must come in sorted order.");
-
-        versionList_.Append(vsn);
-        bool contains = readerRemovalNotifications_.ContainsKey(vsn);
-        if (contains == false)
-        {
-            AwaitableCompletionSource<LONG64>::SPtr acs;
-            status = AwaitableCompletionSource<LONG64>::Create(GetThisAllocator(), VERSION_MANAGER_TAG, acs);
-
-            CO_RETURN_ON_FAILURE(status);
+        status = stripe.AddReaderCallerHoldsLock(vsn);
 
-            readerRemovalNotifications_.Put(vsn, acs);
-        }
+        CO_RETURN_ON_FAILURE(status);
     }
 
     co_return status;
@@ -306,28 +291,60 @@ Awaitable<NTSTATUS> VersionManager::RegisterAsync(__out FABRIC_SEQUENCE_NUMBER &
 
 NTSTATUS VersionManager::UnRegister(__in FABRIC_SEQUENCE_NUMBER visibilityVersionNumber) noexcept
 {
-    AwaitableCompletionSource<LONG64>::SPtr notification = nullptr;
+    bool isRemoved = false;
+    bool isLastReaderInStripe = false;
+
+    // The reader usually unregisters from the thread it registered on. Otherwise it is found in another stripe.
+    VersionReaderStripe & ownStripe = GetReaderStripeForCurrentThread();
+    ownStripe.AcquireExclusive();
+    {
+        KFinally([&] {ownStripe.ReleaseExclusive(); });
+        isRemoved = ownStripe.TryRemoveReaderCallerHoldsLock(visibilityVersionNumber, isLastReaderInStripe);
+    }
 
-    versionListLock_.AcquireExclusive();
+    for (ULONG i = 0; i < readerStripes_.Count() && isRemoved == false; i++)
     {
-        KFinally([&] {versionListLock_.ReleaseExclusive(); });
+        VersionReaderStripe & stripe = *readerStripes_[i];
+        if (&stripe == &ownStripe)
+        {
+            continue;
+        }
+
+        stripe.AcquireExclusive();
+        {
+            KFinally([&] {stripe.ReleaseExclusive(); });
+            isRemoved = stripe.TryRemoveReaderCallerHoldsLock(visibilityVersionNumber, isLastReaderInStripe);
+        }
+    }
 
-        LONG32 index = Sort<LONG64>::BinarySearch(visibilityVersionNumber, true, Compare, versionList_);
-        ASSERT_IFNOT(
-            index >= 0,
-            "An item that is not registered cannot be unregistered");
+    ASSERT_IFNOT(
+        isRemoved,
+        "An item that is not registered cannot be unregistered");
+
+    // Notifications are added by removal scans while holding the stripe this reader was in,
+    // so a notification added for this version is visible here.
+    if (isLastReaderInStripe == false || readerRemovalNotificationsCount_.load() == 0)
+    {
+        return STATUS_SUCCESS;
+    }
 
-        LONG32 versionCount = static_cast<LONG32>(versionList_.Count());
+    AwaitableCompletionSource<LONG64>::SPtr notification = nullptr;
 
-        bool leftSideMatch = (index > 0) && (versionList_[index - 1] == visibilityVersionNumber);
-        bool rightSideMatch = (index < (versionCount - 1)) && (versionList_[index + 1] == visibilityVersionNumber);
+    AcquireAllReaderStripesShared();
+    {
+        KFinally([&] {ReleaseAllReaderStripesShared(); });
 
-        if (leftSideMatch == false && rightSideMatch == false)
+        if (IsRegisteredCallerHoldsLock(visibilityVersionNumber) == false)
         {
-            readerRemovalNotifications_.Remove(visibilityVersionNumber, &notification);
+            K_LOCK_BLOCK(readerRemovalNotificationsLock_)
+            {
+                NTSTATUS status = readerRemovalNotifications_.Remove(visibilityVersionNumber, &notification);
+                if (NT_SUCCESS(status))
+                {
+                    --readerRemovalNotificationsCount_;
+                }
+            }
         }
-
-        versionList_.Remove(index);
     }
 
     // Making sure that Tasks continuation runs outside the lock.
@@ -344,90 +361,136 @@ bool VersionManager::Test_VerifyState(
     __in LONG32 notificationCount,
     __in LONG32 registeredNotificationsCount)
 {
-    LONG32 tmpCount = static_cast<LONG32>(versionList_.Count());
+    LONG32 tmpCount = 0;
+
+    AcquireAllReaderStripesShared();
+    {
+        KFinally([&] {ReleaseAllReaderStripesShared(); });
+
+        for (ULONG i = 0; i < readerStripes_.Count(); i++)
+        {
+            tmpCount += readerStripes_[i]->ReaderCount;
+        }
+    }
 
     if (tmpCount != versionCount)
     {
         return false;
     }
 
-    tmpCount = static_cast<LONG32>(readerRemovalNotifications_.Count());
+    K_LOCK_BLOCK(readerRemovalNotificationsLock_)
+    {
+        tmpCount = static_cast<LONG32>(readerRemovalNotifications_.Count());
+    }
+
     if (tmpCount != notificationCount)
     {
         return false;
     }
 
-    tmpCount = static_cast<LONG32>(readerRemovalNotifications_.Count());
     return tmpCount == registeredNotificationsCount;
 }
 
-bool VersionManager::CanVersionBeRemovedCallerHoldsLock(
-    __in LONG64 toBeRemovedLSN,
-    __in LONG64 newPreviousLastCommittedLSN,
-    __out LONG32 & indexOfEqualOrImmediatelyHigher)
+VersionReaderStripe & VersionManager::GetReaderStripeForCurrentThread()
 {
-    indexOfEqualOrImmediatelyHigher = LONG_MIN;
+    return *readerStripes_[GetCurrentThreadId() % readerStripes_.Count()];
+}
 
-    // List maintains _size
-    if (versionList_.Count() == 0)
+void VersionManager::AcquireAllReaderStripesShared()
+{
+    // Always in the same order, so that concurrent scans cannot deadlock with each other.
+    for (ULONG i = 0; i < readerStripes_.Count(); i++)
     {
-        // It is removable.
-        return true;
+        readerStripes_[i]->AcquireShared();
     }
+}
 
-    LONG32 index = Sort<LONG64>::BinarySearch(toBeRemovedLSN, true, Compare, versionList_);
+void VersionManager::ReleaseAllReaderStripesShared()
+{
+    for (ULONG i = readerStripes_.Count(); i > 0; i--)
+    {
+        readerStripes_[i - 1]->ReleaseShared();
+    }
+}
 
+bool VersionManager::CanVersionBeRemovedCallerHoldsLock(
+    __in LONG64 toBeRemovedLSN,
+    __in LONG64 newPreviousLastCommittedLSN)
+{
     // version list could have perfect match due to isBarrier records like InformationLogRecord 
     // that is not preceded by a Barrier log record.
-    indexOfEqualOrImmediatelyHigher = index < 0 ? ~index : index;
-
-    LONG32 versionCount = static_cast<LONG32>(versionList_.Count());
-
-    ASSERT_IFNOT(
-        indexOfEqualOrImmediatelyHigher <= versionCount,
-        "indexOfEqualOrImmediatelyHigher {0} <=  versionList_.Count() {1}",
-        indexOfEqualOrImmediatelyHigher,
-        versionCount);
-
-    // if all versions are higher than versionLsnToBeRemoved
-    if (indexOfEqualOrImmediatelyHigher == versionCount)
+    for (ULONG i = 0; i < readerStripes_.Count(); i++)
     {
-        // It is removable.
-        return true;
-    }
+        LONG64 equalOrImmediatelyHigher;
+        bool found = readerStripes_[i]->TryGetEqualOrHigherCallerHoldsLock(toBeRemovedLSN, equalOrImmediatelyHigher);
 
-    if (newPreviousLastCommittedLSN <= versionList_[indexOfEqualOrImmediatelyHigher])
-    {
-        // It is removable.
-        return true;
+        // if all versions are higher than newPreviousLastCommittedLSN, the stripe does not keep it alive.
+        if (found == true && equalOrImmediatelyHigher < newPreviousLastCommittedLSN)
+        {
+            return false;
+        }
     }
 
-    return false;
+    // It is removable.
+    return true;
 }
 
 KHashSet<LONG64>::SPtr VersionManager::FindAllVisibilitySequenceNumbersKeepingVersionAliveCallerHoldsLock(
-    __in LONG32 startIndex,
+    __in LONG64 toBeRemovedLSN,
     __in LONG64 newPreviousLastCommittedLSN)
 {
     KHashSet<LONG64>::SPtr result = nullptr;
     NTSTATUS status = KHashSet<LONG64>::Create(DefaultHashSetSize, K_DefaultHashFunction, GetThisAllocator(), result);
     THROW_ON_FAILURE(status);
 
-    LONG32 versionCount = versionList_.Count();
+    for (ULONG i = 0; i < readerStripes_.Count(); i++)
+    {
+        readerStripes_[i]->AddVisibilitySequenceNumbersInRangeCallerHoldsLock(
+            toBeRemovedLSN,
+            newPreviousLastCommittedLSN,
+            *result);
+    }
+
+    return result;
+}
+
+bool VersionManager::IsRegisteredCallerHoldsLock(__in LONG64 visibilitySequenceNumber)
+{
+    for (ULONG i = 0; i < readerStripes_.Count(); i++)
+    {
+        if (readerStripes_[i]->ContainsCallerHoldsLock(visibilitySequenceNumber))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+AwaitableCompletionSource<LONG64>::SPtr VersionManager::GetOrAddReaderRemovalNotificationCallerHoldsLock(
+    __in LONG64 visibilitySequenceNumber)
+{
+    AwaitableCompletionSource<LONG64>::SPtr acs = nullptr;
 
-    for (LONG32 index = startIndex; index < versionCount; index++)
+    K_LOCK_BLOCK(readerRemovalNotificationsLock_)
     {
-        LONG64 visibilitySequenceNumber = versionList_[index];
-        if (visibilitySequenceNumber > newPreviousLastCommittedLSN)
+        NTSTATUS status = readerRemovalNotifications_.Get(visibilitySequenceNumber, acs);
+        if (NT_SUCCESS(status))
         {
-            break;
+            ASSERT_IFNOT(acs != nullptr, "Removed acs must not be nullptr for VSN: {0}", visibilitySequenceNumber);
+            return acs;
         }
 
-        // Idempotent add.
-        result->TryAdd(visibilitySequenceNumber);
+        status = AwaitableCompletionSource<LONG64>::Create(GetThisAllocator(), VERSION_MANAGER_TAG, acs);
+        THROW_ON_FAILURE(status);
+
+        status = readerRemovalNotifications_.Put(visibilitySequenceNumber, acs);
+        THROW_ON_FAILURE(status);
+
+        ++readerRemovalNotificationsCount_;
     }
 
-    return result;
+    return acs;
 }
 
 Task VersionManager::ProcessNotificationTask(
@@ -48,15 +48,26 @@ namespace Data
                 __in LONG32 registeredNotificationsCount);
 
         private: // Private methods.
+            VersionReaderStripe & GetReaderStripeForCurrentThread();
+
+            void AcquireAllReaderStripesShared();
+            void ReleaseAllReaderStripesShared();
+
             bool CanVersionBeRemovedCallerHoldsLock(
                 __in LONG64 toBeRemovedLSN,
-                __in LONG64 newPreviousLastCommittedLSN,
-                __out LONG32 & indexOfEqualOrImmediatelyHigher);
+                __in LONG64 newPreviousLastCommittedLSN);
 
             Utilities::KHashSet<LONG64>::SPtr FindAllVisibilitySequenceNumbersKeepingVersionAliveCallerHoldsLock(
-                __in LONG32 startIndex,
+                __in LONG64 toBeRemovedLSN,
                 __in LONG64 newPreviousLastCommittedLSN);
 
+            bool IsRegisteredCallerHoldsLock(__in LONG64 visibilitySequenceNumber);
+
+            // Returns the notification that fires when the last reader of the given version unregisters.
+            // Caller must hold all the reader stripes so that the version cannot be unregistered concurrently.
+            ktl::AwaitableCompletionSource<LONG64>::SPtr GetOrAddReaderRemovalNotificationCallerHoldsLock(
+                __in LONG64 visibilitySequenceNumber);
+
             ktl::Task ProcessNotificationTask(
                 __in ktl::AwaitableCompletionSource<LONG64> & acs,
                 __in NotificationKey & key);
@@ -64,11 +75,18 @@ namespace Data
         private: // Private variables
             const ULONG DefaultHashSetSize = 997;
             const ULONG ExpectedNumberOfInflightNotifications = 997;
-            const ULONG ExpectedNumberOfInflightVisibilitySequenceNumbers = 31;
+            const ULONG ReaderStripeCount = 16;
 
+            // Snapshot readers are spread across the stripes by thread id.
+            // Register and UnRegister lock a single stripe, version removal scans take all of them in shared mode.
+            KArray<VersionReaderStripe::SPtr> readerStripes_;
+
+            // Notifications are only created for the versions a removal has to wait for.
+            // Protected by readerRemovalNotificationsLock_, which is always acquired after the reader stripes.
+            KSpinLock readerRemovalNotificationsLock_;
             KHashTable<LONG64, ktl::AwaitableCompletionSource<LONG64>::SPtr> readerRemovalNotifications_;
-            KArray<FABRIC_SEQUENCE_NUMBER> versionList_;
-            KReaderWriterSpinLock versionListLock_;
+            Common::atomic_long readerRemovalNotificationsCount_;
+
             Utilities::ThreadSafeSPtrCache<TxnReplicator::CompletionTask> lastDispatchingBarrier_;
 
             Utilities::ConcurrentDictionary<NotificationKey::SPtr, byte>::SPtr registeredNotifications_;
@@ -0,0 +1,188 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace Data::LoggingReplicator;
+using namespace Data::Utilities;
+
+NTSTATUS VersionReaderStripe::Create(
+    __in KAllocator & allocator,
+    __out SPtr & result) noexcept
+{
+    result = _new(VERSION_READER_STRIPE_TAG, allocator) VersionReaderStripe();
+    if (result == nullptr)
+    {
+        return STATUS_INSUFFICIENT_RESOURCES;
+    }
+
+    if (!NT_SUCCESS(result->Status()))
+    {
+        return (SPtr(Ktl::Move(result)))->Status();
+    }
+
+    return STATUS_SUCCESS;
+}
+
+LONG32 VersionReaderStripe::get_ReaderCount() const
+{
+    return readerCount_;
+}
+
+void VersionReaderStripe::AcquireExclusive()
+{
+    lock_.AcquireExclusive();
+}
+
+void VersionReaderStripe::ReleaseExclusive()
+{
+    lock_.ReleaseExclusive();
+}
+
+void VersionReaderStripe::AcquireShared()
+{
+    lock_.AcquireShared();
+}
+
+void VersionReaderStripe::ReleaseShared()
+{
+    lock_.ReleaseShared();
+}
+
+NTSTATUS VersionReaderStripe::AddReaderCallerHoldsLock(__in LONG64 visibilitySequenceNumber) noexcept
+{
+    ULONG entryCount = entries_.Count();
+    if (entryCount > 0)
+    {
+        ReaderEntry & tail = entries_[entryCount - 1];
+        ASSERT_IFNOT(
+            visibilitySequenceNumber >= tail.VisibilitySequenceNumber,
+            "Barriers must come in sorted order. VSN: {0} Tail: {1}",
+            visibilitySequenceNumber,
+            tail.VisibilitySequenceNumber);
+
+        if (tail.VisibilitySequenceNumber == visibilitySequenceNumber)
+        {
+            tail.Count++;
+            readerCount_++;
+            return STATUS_SUCCESS;
+        }
+    }
+
+    ReaderEntry entry;
+    entry.VisibilitySequenceNumber = visibilitySequenceNumber;
+    entry.Count = 1;
+
+    NTSTATUS status = entries_.Append(entry);
+    if (NT_SUCCESS(status))
+    {
+        readerCount_++;
+    }
+
+    return status;
+}
+
+bool VersionReaderStripe::TryRemoveReaderCallerHoldsLock(
+    __in LONG64 visibilitySequenceNumber,
+    __out bool & isLastReader) noexcept
+{
+    isLastReader = false;
+
+    LONG32 index = FindEqualOrHigherCallerHoldsLock(visibilitySequenceNumber);
+    if (index == static_cast<LONG32>(entries_.Count()) || 
+        entries_[index].VisibilitySequenceNumber != visibilitySequenceNumber)
+    {
+        return false;
+    }
+
+    readerCount_--;
+    entries_[index].Count--;
+    if (entries_[index].Count == 0)
+    {
+        entries_.Remove(index);
+        isLastReader = true;
+    }
+
+    return true;
+}
+
+bool VersionReaderStripe::ContainsCallerHoldsLock(__in LONG64 visibilitySequenceNumber) const noexcept
+{
+    LONG32 index = FindEqualOrHigherCallerHoldsLock(visibilitySequenceNumber);
+    return index < static_cast<LONG32>(entries_.Count()) && 
+        entries_[index].VisibilitySequenceNumber == visibilitySequenceNumber;
+}
+
+bool VersionReaderStripe::TryGetEqualOrHigherCallerHoldsLock(
+    __in LONG64 lsn,
+    __out LONG64 & visibilitySequenceNumber) const noexcept
+{
+    visibilitySequenceNumber = FABRIC_INVALID_SEQUENCE_NUMBER;
+
+    LONG32 index = FindEqualOrHigherCallerHoldsLock(lsn);
+    if (index == static_cast<LONG32>(entries_.Count()))
+    {
+        return false;
+    }
+
+    visibilitySequenceNumber = entries_[index].VisibilitySequenceNumber;
+    return true;
+}
+
+void VersionReaderStripe::AddVisibilitySequenceNumbersInRangeCallerHoldsLock(
+    __in LONG64 startLsn,
+    __in LONG64 endLsn,
+    __in KHashSet<LONG64> & result) const
+{
+    LONG32 entryCount = static_cast<LONG32>(entries_.Count());
+
+    for (LONG32 index = FindEqualOrHigherCallerHoldsLock(startLsn); index < entryCount; index++)
+    {
+        LONG64 visibilitySequenceNumber = entries_[index].VisibilitySequenceNumber;
+        if (visibilitySequenceNumber > endLsn)
+        {
+            break;
+        }
+
+        // Idempotent add.
+        result.TryAdd(visibilitySequenceNumber);
+    }
+}
+
+LONG32 VersionReaderStripe::FindEqualOrHigherCallerHoldsLock(__in LONG64 lsn) const noexcept
+{
+    // Lower bound over the sorted entries.
+    LONG32 low = 0;
+    LONG32 high = static_cast<LONG32>(entries_.Count());
+
+    while (low < high)
+    {
+        LONG32 middle = low + ((high - low) / 2);
+        if (entries_[middle].VisibilitySequenceNumber < lsn)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+VersionReaderStripe::VersionReaderStripe()
+    : KObject()
+    , KShared()
+    , lock_()
+    , entries_(GetThisAllocator(), ExpectedNumberOfInflightVisibilitySequenceNumbers)
+    , readerCount_(0)
+{
+    SetConstructorStatus(entries_.Status());
+}
+
+VersionReaderStripe::~VersionReaderStripe()
+{
+}
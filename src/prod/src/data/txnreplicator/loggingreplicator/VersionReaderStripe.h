@@ -0,0 +1,81 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Data
+{
+    namespace LoggingReplicator
+    {
+        //
+        // One stripe of the snapshot reader registry of the VersionManager.
+        // Readers register and unregister in the stripe picked by their thread, so readers on different threads do not
+        // contend with each other. Scans for the readers keeping a version alive hold all the stripes in shared mode.
+        //
+        // Visibility sequence numbers are handed out under the stripe lock and are monotonically increasing,
+        // hence the entries of a stripe are always sorted and new readers are appended or counted at the tail.
+        //
+        class VersionReaderStripe
+            : public KObject<VersionReaderStripe>
+            , public KShared<VersionReaderStripe>
+        {
+            K_FORCE_SHARED(VersionReaderStripe)
+
+        public:
+            static NTSTATUS Create(
+                __in KAllocator & allocator,
+                __out SPtr & result) noexcept;
+
+        public:
+            /// <summary>
+            /// Number of readers registered in the stripe.
+            /// </summary>
+            __declspec(property(get = get_ReaderCount)) LONG32 ReaderCount;
+            LONG32 get_ReaderCount() const;
+
+        public:
+            void AcquireExclusive();
+            void ReleaseExclusive();
+
+            void AcquireShared();
+            void ReleaseShared();
+
+            NTSTATUS AddReaderCallerHoldsLock(__in LONG64 visibilitySequenceNumber) noexcept;
+
+            // Returns false if the stripe has no reader with the given visibility sequence number.
+            // isLastReader is set when the removed reader was the last one of the stripe with this visibility sequence number.
+            bool TryRemoveReaderCallerHoldsLock(
+                __in LONG64 visibilitySequenceNumber,
+                __out bool & isLastReader) noexcept;
+
+            bool ContainsCallerHoldsLock(__in LONG64 visibilitySequenceNumber) const noexcept;
+
+            // Returns false if all the visibility sequence numbers in the stripe are lower than the given lsn.
+            bool TryGetEqualOrHigherCallerHoldsLock(
+                __in LONG64 lsn,
+                __out LONG64 & visibilitySequenceNumber) const noexcept;
+
+            void AddVisibilitySequenceNumbersInRangeCallerHoldsLock(
+                __in LONG64 startLsn,
+                __in LONG64 endLsn,
+                __in Utilities::KHashSet<LONG64> & result) const;
+
+        private:
+            struct ReaderEntry
+            {
+                LONG64 VisibilitySequenceNumber;
+                LONG32 Count;
+            };
+
+            LONG32 FindEqualOrHigherCallerHoldsLock(__in LONG64 lsn) const noexcept;
+
+            const ULONG ExpectedNumberOfInflightVisibilitySequenceNumbers = 8;
+
+            KReaderWriterSpinLock lock_;
+            KArray<ReaderEntry> entries_;
+            LONG32 readerCount_;
+        };
+    }
+}
@@ -31,6 +31,7 @@
 #define VERSION_MANAGER_TAG 'rgMV'
 #define NOTIFICATION_KEY_TAG 'yeKN'
 #define NOTIFICATION_KEY_COMPARER_TAG 'mcKN'
+#define VERSION_READER_STRIPE_TAG 'tSRV'
 
 // Tags for backup related objects.
 #define BACKUP_METADATA_FILE_PROPERTIES_TAG 'pfMB' // BackupMetadataFileProperties 
@@ -168,6 +169,7 @@
 
 #include "NotificationKey.h"
 #include "NotificationKeyComparer.h"
+#include "VersionReaderStripe.h"
 #include "VersionManager.h"
 
 // LoggingReplicator
@@ -5,8 +5,6 @@
 
 #pragma once
 
-#include <codecvt>
-
 namespace Data
 {
     namespace Utilities
@@ -169,21 +167,8 @@ namespace Data
                 THROW_ON_FAILURE(status);
                 ASSERT_IFNOT(readBytes == length, "BinaryReader: Did not read full string. Read readBytes is {0} and length is {1}", readBytes, length);
 
-                #ifdef PLATFORM_UNIX
-                    wstring_convert<codecvt_utf8_utf16<char16_t>, char16_t> convertor;
-                #else
-                    wstring_convert<codecvt_utf8_utf16<unsigned short>, unsigned short> convertor;
-                #endif
-
-                // Copy 2: Converting the buffer with string (null terminated char*) in to UTF16 encoded wstring
-                // Note: #10258883: Try to avoid the copy. Before we used w_char for the convertor and can just call
-                // from_bytes to assign the wstring. But it segfault on Linux while running test.
-                value.clear();
-                value.reserve(length + 1);
-                for (auto const & ch : convertor.from_bytes(buffer))
-                {
-                    value.push_back(ch);
-                }
+                // Copy 2: Transcoding the buffer straight into the UTF16 encoded wstring
+                Common::StringUtility::Utf8ToUtf16(buffer, length, value);
             }
 
             void Read(
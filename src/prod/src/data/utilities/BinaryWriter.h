@@ -144,13 +144,8 @@ namespace Data
 
                 if (encoding == Encoding::UTF8)
                 {
-#ifdef PLATFORM_UNIX
-                    wstring_convert<codecvt_utf8_utf16<char16_t>, char16_t> convertor;
-                    std::string utf8String = convertor.to_bytes((const char16_t *)static_cast<LPCWSTR>(value));
-#else
-                    wstring_convert<codecvt_utf8_utf16<unsigned short>, unsigned short> convertor;
-                    std::string utf8String = convertor.to_bytes((const unsigned short *)static_cast<LPCWSTR>(value));
-#endif
+                    std::string utf8String;
+                    Common::StringUtility::Utf16ToUtf8(static_cast<LPCWSTR>(value), value.Length(), utf8String);
 
                     Write(utf8String);
                     return;
@@ -1365,10 +1365,10 @@ void ApplicationsHandler::OnGetAllPartitionsComplete(
         return;
     }
 
-    ByteBufferUPtr bufferUPtr;
+    ByteBufferChunkList chunks;
     if (handlerOperation->Uri.ApiVersion == Constants::V1ApiVersion)
     {
-        error = handlerOperation->Serialize(partitionResult, bufferUPtr);
+        error = handlerOperation->SerializeChunked(partitionResult, chunks);
     }
     else
     {
@@ -1379,7 +1379,7 @@ void ApplicationsHandler::OnGetAllPartitionsComplete(
         }
 
         list.Items = move(partitionResult);
-        error = handlerOperation->Serialize(list, bufferUPtr);
+        error = handlerOperation->SerializeChunked(list, chunks);
     }
 
     if (!error.IsSuccess())
@@ -1388,7 +1388,7 @@ void ApplicationsHandler::OnGetAllPartitionsComplete(
         return;
     }
 
-    handlerOperation->OnSuccess(operation->Parent, move(bufferUPtr));
+    handlerOperation->OnSuccess(operation->Parent, move(chunks));
     return;
 }
 
@@ -1574,10 +1574,10 @@ void ApplicationsHandler::OnGetAllReplicasComplete(
         return;
     }
 
-    ByteBufferUPtr bufferUPtr;
+    ByteBufferChunkList chunks;
     if (handlerOperation->Uri.ApiVersion == Constants::V1ApiVersion)
     {
-        error = handlerOperation->Serialize(serviceReplicasQueryResult, bufferUPtr);
+        error = handlerOperation->SerializeChunked(serviceReplicasQueryResult, chunks);
     }
     else
     {
@@ -1589,7 +1589,7 @@ void ApplicationsHandler::OnGetAllReplicasComplete(
 
         list.Items = move(serviceReplicasQueryResult);
 
-        error = handlerOperation->Serialize(list, bufferUPtr);
+        error = handlerOperation->SerializeChunked(list, chunks);
     }
 
     if (!error.IsSuccess())
@@ -1598,7 +1598,7 @@ void ApplicationsHandler::OnGetAllReplicasComplete(
         return;
     }
 
-    handlerOperation->OnSuccess(operation->Parent, move(bufferUPtr));
+    handlerOperation->OnSuccess(operation->Parent, move(chunks));
     return;
 }
 
@@ -385,6 +385,7 @@ GlobalWString Constants::HttpPostVerb                = make_global<wstring>(L"PO
 GlobalWString Constants::HttpDeleteVerb              = make_global<wstring>(L"DELETE");
 GlobalWString Constants::HttpPutVerb                 = make_global<wstring>(L"PUT");
 
+USHORT Constants::StatusOk                           = 200;
 USHORT Constants::StatusCreated                      = 201;
 USHORT Constants::StatusAccepted                     = 202;
 USHORT Constants::StatusNoContent                    = 204;
@@ -395,6 +396,7 @@ USHORT Constants::StatusConflict                     = 409;
 USHORT Constants::StatusPreconditionFailed           = 412;
 USHORT Constants::StatusRangeNotSatisfiable          = 416;
 USHORT Constants::StatusMovedPermanently             = 301;
+GlobalWString Constants::StatusDescriptionOk         = make_global<wstring>(L"OK");
 GlobalWString Constants::StatusDecsriptionCreated    = make_global<wstring>(L"Created");
 GlobalWString Constants::StatusDescriptionNoContent  = make_global<wstring>(L"No Content");
 GlobalWString Constants::StatusDescriptionAccepted   = make_global<wstring>(L"Accepted");
@@ -408,6 +408,7 @@ namespace HttpGateway
         //
         // Http status codes
         //
+        static USHORT StatusOk;
         static USHORT StatusCreated;
         static USHORT StatusNoContent;
         static USHORT StatusAccepted;
@@ -418,6 +419,7 @@ namespace HttpGateway
         static USHORT StatusConflict;
         static USHORT StatusPreconditionFailed;
         static USHORT StatusRangeNotSatisfiable;
+        static Common::GlobalWString StatusDescriptionOk;
         static Common::GlobalWString StatusDecsriptionCreated;
         static Common::GlobalWString StatusDescriptionNoContent;
         static Common::GlobalWString StatusDescriptionAccepted;
@@ -40,6 +40,22 @@ namespace HttpGateway
         //
         PUBLIC_CONFIG_ENTRY(Common::TimeSpan, L"HttpGateway", HttpGatewayHealthReportSendInterval, Common::TimeSpan::FromSeconds(30), Common::ConfigEntryUpgradePolicy::Static);
 
+#if defined (PLATFORM_UNIX)
+        //
+        // Serves plain text listeners with the native epoll based http server instead of the casablanca listener.
+        // Secure listeners are always served by the casablanca listener. Off by default.
+        //
+        INTERNAL_CONFIG_ENTRY(bool, L"HttpGateway", UseNativeHttpServer, false, Common::ConfigEntryUpgradePolicy::Static);
+        //
+        // Connections to the native http server with no request in progress are closed after this long.
+        //
+        INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"HttpGateway", NativeHttpServerKeepAliveTimeout, Common::TimeSpan::FromSeconds(120), Common::ConfigEntryUpgradePolicy::Static);
+        //
+        // Size of the pooled buffers that the native http server receives requests into.
+        //
+        INTERNAL_CONFIG_ENTRY(uint, L"HttpGateway", NativeHttpServerReceiveBufferSize, 65536, Common::ConfigEntryUpgradePolicy::Static);
+#endif
+
 #if !defined (PLATFORM_UNIX)
         // HttpApplicationGateway settings
         //
@@ -67,6 +83,11 @@ namespace HttpGateway
         // Gives the default max timeout used for resolve calls.
         //
         INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"HttpGateway", ResolveTimeout, Common::TimeSpan::FromSeconds(10), Common::ConfigEntryUpgradePolicy::Dynamic);
+        //
+        // Query responses are serialized directly into pooled UTF-8 chunks and sent using chunked transfer encoding
+        // where the transport supports it. When disabled, responses are serialized into a single contiguous buffer.
+        //
+        INTERNAL_CONFIG_ENTRY(bool, L"HttpGateway", EnableChunkedQueryResponses, true, Common::ConfigEntryUpgradePolicy::Dynamic);
 
         // This controls the allocation block size in KB. For better perf, this should be tuned based on tests or looking at the perf counters so that all allocations for
         // a single request fit in this block size.
@@ -52,11 +52,29 @@ ErrorCode HttpGatewayImpl::InitializeServer()
     error = InitializeSecurity();
     if (!error.IsSuccess()) { return error; }
 
-    httpServer_ = make_shared<HttpServerImpl>(
-        *this, 
-        listenUrl_,
-        HttpGatewayConfig::GetConfig().ActiveListeners,
-        securitySettings_.SecurityProvider());
+#if defined(PLATFORM_UNIX)
+    if (HttpGatewayConfig::GetConfig().UseNativeHttpServer)
+    {
+        httpServer_ = make_shared<HttpServerImpl>(
+            *this,
+            listenUrl_,
+            HttpGatewayConfig::GetConfig().ActiveListeners,
+            securitySettings_.SecurityProvider(),
+            NativeHttpServerSettings(
+                HttpCommon::HttpConstants::DefaultHeaderBufferSize,
+                HttpGatewayConfig::GetConfig().MaxEntityBodySize,
+                HttpGatewayConfig::GetConfig().NativeHttpServerReceiveBufferSize,
+                HttpGatewayConfig::GetConfig().NativeHttpServerKeepAliveTimeout));
+    }
+    else
+#endif
+    {
+        httpServer_ = make_shared<HttpServerImpl>(
+            *this, 
+            listenUrl_,
+            HttpGatewayConfig::GetConfig().ActiveListeners,
+            securitySettings_.SecurityProvider());
+    }
 
 #if !defined(PLATFORM_UNIX)
     error = HttpClientImpl::CreateHttpClient(
@@ -271,10 +271,10 @@ void NodesHandler::OnGetAllNodesComplete(
         return;
     }
 
-    ByteBufferUPtr bufferUPtr = make_unique<ByteBuffer>();
+    ByteBufferChunkList chunks;
     if (handlerOperation->Uri.ApiVersion == Constants::V1ApiVersion)
     {
-        error = handlerOperation->Serialize(nodesResult, bufferUPtr);
+        error = handlerOperation->SerializeChunked(nodesResult, chunks);
     }
     else
     {
@@ -286,7 +286,7 @@ void NodesHandler::OnGetAllNodesComplete(
 
         list.Items = move(nodesResult);
 
-        error = handlerOperation->Serialize(list, bufferUPtr);
+        error = handlerOperation->SerializeChunked(list, chunks);
     }
 
     if (!error.IsSuccess())
@@ -295,7 +295,7 @@ void NodesHandler::OnGetAllNodesComplete(
         return;
     }
 
-    handlerOperation->OnSuccess(operation->Parent, move(bufferUPtr));
+    handlerOperation->OnSuccess(operation->Parent, move(chunks));
 }
 
 void NodesHandler::GetNodeByName(__in AsyncOperationSPtr const& thisSPtr)
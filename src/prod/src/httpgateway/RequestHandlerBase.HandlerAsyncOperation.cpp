@@ -276,6 +276,146 @@ void RequestHandlerBase::HandlerAsyncOperation::OnSuccess(AsyncOperationSPtr con
         thisSPtr);
 }
 
+void RequestHandlerBase::HandlerAsyncOperation::OnSuccess(AsyncOperationSPtr const& thisSPtr, __in ByteBufferChunkList && chunks)
+{
+    if (chunks.size() == 1)
+    {
+        //
+        // Small responses fit in a single chunk, so there is no benefit from chunked transfer encoding.
+        //
+        ByteBufferUPtr bufferUPtr = move(chunks.front());
+        chunks.clear();
+
+        OnSuccess(thisSPtr, move(bufferUPtr), *Constants::JsonContentType);
+        return;
+    }
+
+#if !defined(PLATFORM_UNIX)
+    auto error = SetContentTypeResponseHeaders(Constants::JsonContentType);
+    if (!error.IsSuccess())
+    {
+        JsonChunkPool::GetDefault().ReturnChunks(move(chunks));
+        TryComplete(thisSPtr, error);
+        return;
+    }
+
+    responseChunks_ = move(chunks);
+    nextResponseChunk_ = 0;
+
+    AsyncOperationSPtr operation = messageContext_->BeginSendResponseHeaders(
+        Constants::StatusOk,
+        *Constants::StatusDescriptionOk,
+        !responseChunks_.empty(),
+        [this](AsyncOperationSPtr const& operation)
+        {
+            this->OnSendResponseHeadersComplete(operation, false);
+        },
+        thisSPtr);
+
+    OnSendResponseHeadersComplete(operation, true);
+#else
+    auto error = SetContentTypeResponseHeaders(Constants::JsonContentType);
+    if (!error.IsSuccess())
+    {
+        JsonChunkPool::GetDefault().ReturnChunks(move(chunks));
+        TryComplete(thisSPtr, error);
+        return;
+    }
+
+    //
+    // The chunks are written to the socket as they are; they go back to the pool when this
+    // operation is destroyed.
+    //
+    responseChunks_ = move(chunks);
+
+    AsyncOperationSPtr operation = messageContext_->BeginSendResponseChunks(
+        Constants::StatusOk,
+        *Constants::StatusDescriptionOk,
+        responseChunks_,
+        [this](AsyncOperationSPtr const& operation)
+    {
+        auto error = this->messageContext_->EndSendResponse(operation);
+        this->TryComplete(operation->Parent, error);
+    },
+        thisSPtr);
+#endif
+}
+
+#if !defined(PLATFORM_UNIX)
+void RequestHandlerBase::HandlerAsyncOperation::OnSendResponseHeadersComplete(
+    AsyncOperationSPtr const& operation,
+    __in bool expectedCompletedSynchronously)
+{
+    if (operation->CompletedSynchronously != expectedCompletedSynchronously) { return; }
+
+    auto error = messageContext_->EndSendResponseHeaders(operation);
+    if (!error.IsSuccess())
+    {
+        TryComplete(operation->Parent, error);
+        return;
+    }
+
+    SendNextResponseChunk(operation->Parent);
+}
+
+void RequestHandlerBase::HandlerAsyncOperation::SendNextResponseChunk(AsyncOperationSPtr const& thisSPtr)
+{
+    //
+    // Loop instead of recursing when the transport completes sends synchronously, so that
+    // large responses with many chunks do not grow the stack.
+    //
+    while (nextResponseChunk_ < responseChunks_.size())
+    {
+        auto & chunk = responseChunks_[nextResponseChunk_];
+        bool isLastSegment = (nextResponseChunk_ + 1 == responseChunks_.size());
+
+        KMemRef memRef;
+        memRef._Address = chunk->data();
+        memRef._Size = static_cast<ULONG>(chunk->size());
+        memRef._Param = static_cast<ULONG>(chunk->size());
+
+        AsyncOperationSPtr operation = messageContext_->BeginSendResponseChunk(
+            memRef,
+            isLastSegment,
+            false,
+            [this](AsyncOperationSPtr const& operation)
+            {
+                if (!operation->CompletedSynchronously && this->OnSendResponseChunkComplete(operation))
+                {
+                    this->SendNextResponseChunk(operation->Parent);
+                }
+            },
+            thisSPtr);
+
+        if (!operation->CompletedSynchronously || !OnSendResponseChunkComplete(operation))
+        {
+            return;
+        }
+    }
+
+    TryComplete(thisSPtr, ErrorCode::Success());
+}
+
+bool RequestHandlerBase::HandlerAsyncOperation::OnSendResponseChunkComplete(AsyncOperationSPtr const& operation)
+{
+    auto error = messageContext_->EndSendResponseChunk(operation);
+
+    //
+    // The chunk has been handed to the transport, so it can be reused by the next response.
+    //
+    JsonChunkPool::GetDefault().ReturnChunk(move(responseChunks_[nextResponseChunk_]));
+    ++nextResponseChunk_;
+
+    if (!error.IsSuccess())
+    {
+        TryComplete(operation->Parent, error);
+        return false;
+    }
+
+    return true;
+}
+#endif
+
 ErrorCode RequestHandlerBase::HandlerAsyncOperation::End(__in AsyncOperationSPtr const& operation)
 {
     auto thisPtr = AsyncOperation::End<HandlerAsyncOperation>(operation);
@@ -18,6 +18,11 @@ namespace HttpGateway
 
     public:
 
+        virtual ~HandlerAsyncOperation()
+        {
+            Common::JsonChunkPool::GetDefault().ReturnChunks(std::move(responseChunks_));
+        }
+
         HandlerAsyncOperation(
             RequestHandlerBase & owner,
             HttpServer::IRequestMessageContextUPtr messageContext,
@@ -27,6 +32,8 @@ namespace HttpGateway
             , messageContext_(std::move(messageContext))
             , owner_(owner)
             , timeout_(Common::TimeSpan::FromMinutes(Constants::DefaultFabricTimeoutMin))
+            , responseChunks_()
+            , nextResponseChunk_(0)
         {
         }
 
@@ -38,6 +45,13 @@ namespace HttpGateway
         void OnSuccess(Common::AsyncOperationSPtr const& thisSPtr, __in Common::ByteBufferUPtr body, __in std::wstring const& contentType);
         void OnSuccess(Common::AsyncOperationSPtr const& thisSPtr, __in Common::ByteBufferUPtr body, __in USHORT statusCode, __in std::wstring const& statusDesc);
 
+        //
+        // Sends a json body that was serialized into pooled chunks by SerializeChunked. Where the transport
+        // supports it the chunks are sent using chunked transfer encoding and returned to the pool as they
+        // are sent, otherwise they are coalesced into a single buffer.
+        //
+        void OnSuccess(Common::AsyncOperationSPtr const& thisSPtr, __in Common::ByteBufferChunkList && chunks);
+
         __declspec(property(get = get_MessageContext)) HttpServer::IRequestMessageContext &MessageContext;
         __declspec(property(get = get_MessageContextUPtr)) HttpServer::IRequestMessageContextUPtr &MessageContextUPtr;
         __declspec(property(get = get_MessageBody)) Common::ByteBufferUPtr const& Body;
@@ -86,6 +100,24 @@ namespace HttpGateway
             return Common::JsonHelper::Serialize(object, bytesUPtr, GetSerializerFlags());
         }
 
+        template<typename T>
+        inline Common::ErrorCode SerializeChunked(T &object, __out Common::ByteBufferChunkList &chunks)
+        {
+            if (HttpGatewayConfig::GetConfig().EnableChunkedQueryResponses)
+            {
+                return Common::JsonHelper::SerializeChunked(object, chunks, GetSerializerFlags());
+            }
+
+            Common::ByteBufferUPtr bufferUPtr;
+            auto error = Common::JsonHelper::Serialize(object, bufferUPtr, GetSerializerFlags());
+            if (error.IsSuccess())
+            {
+                chunks.push_back(std::move(bufferUPtr));
+            }
+
+            return error;
+        }
+
         template<typename T>
         inline Common::ErrorCode Deserialize(T &object, __in Common::ByteBufferUPtr const &bytesUPtr)
         {
@@ -110,6 +142,12 @@ namespace HttpGateway
 
         void UpdateRequestTimeout();
 
+#if !defined(PLATFORM_UNIX)
+        void OnSendResponseHeadersComplete(Common::AsyncOperationSPtr const& operation, __in bool expectedCompletedSynchronously);
+        void SendNextResponseChunk(Common::AsyncOperationSPtr const& thisSPtr);
+        bool OnSendResponseChunkComplete(Common::AsyncOperationSPtr const& operation);
+#endif
+
         // Set Content-Type and X-Content-Type-Options headers on the response
         Common::ErrorCode SetContentTypeResponseHeaders(__in std::wstring const& contentType);
 
@@ -125,6 +163,9 @@ namespace HttpGateway
         RequestHandlerBase & owner_;
         FabricClientWrapperSPtr client_;
 
+        Common::ByteBufferChunkList responseChunks_;
+        size_t nextResponseChunk_;
+
 #if !defined (PLATFORM_UNIX)
         std::unordered_map<std::wstring, std::wstring> additionalHeaders_;
         std::wstring serviceName_;
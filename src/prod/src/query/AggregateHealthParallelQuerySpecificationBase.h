@@ -92,25 +92,32 @@ namespace Query
          // Parameter queryResults:
          //     For each parallel query, an entry is placed inside this map
          // Remarks:
-         //     First adds all the results
+         //     First adds the result list of each entity query and the health of the health query
          //     Then it sees what the min continuation token is
-         //     Add the things that respect the continuation token and try to add health to it.
+         //     The lists are merged in key order until the page is full or the continuation token is passed;
+         //     only the entries that are returned have health added to them.
         virtual Common::ErrorCode OnParallelQueryExecutionComplete(
             Common::ActivityId const & activityId,
             std::map<Query::QuerySpecificationSPtr, ServiceModel::QueryResult> & queryResults,
             __out Transport::MessageUPtr & replyMessage)
         {
-            std::vector<TEntityResult> entityQueryResult;
+            size_t entityResultCount = 0;
             std::map<TEntityKey, FABRIC_HEALTH_STATE> healthStateMap;
             ServiceModel::MergedQueryListPager<TEntityKey, TEntityResult> resultsPager;
 
+            auto keySelector = [this](TEntityResult const & entityInformation)
+            {
+                return this->GetEntityKeyFromEntityResult(entityInformation);
+            };
+
             // For each parallel query, merge together the results.
             for(auto itResult = queryResults.begin(); itResult != queryResults.end(); ++itResult)
             {
                 Common::ErrorCode error;
                 if (IsEntityInformationQuery(itResult->first) )
                 {
-                    error = MergeEntityInformationQueryResults(entityQueryResult, itResult->second);
+                    std::vector<TEntityResult> entityQueryResult;
+                    error = itResult->second.MoveList(entityQueryResult);
                     if (!error.IsSuccess())
                     {
                         WriteInfo(
@@ -121,6 +128,9 @@ namespace Query
                             itResult->first->AddressString);
                         return error;
                     }
+
+                    entityResultCount += entityQueryResult.size();
+                    resultsPager.AddSortedList(std::move(entityQueryResult), keySelector);
                 }
                 else
                 {
@@ -152,19 +162,11 @@ namespace Query
                 AggregateHealthParallelQueryTraceType,
                 "{0}: entity query returned {1} results, HM {2}",
                 activityId,
-                entityQueryResult.size(),
+                entityResultCount,
                 healthStateMap.size());
 
-            // The continuation token was correctly set; now we can add all items that respect it
-            for (auto & itItem : entityQueryResult)
-            {
-                TEntityKey key = GetEntityKeyFromEntityResult(itItem);
-                resultsPager.Add(std::move(key), std::move(itItem));
-            }
-
-            resultsPager.UpdateHealthStates(activityId, healthStateMap);
-
-            replyMessage = Common::make_unique<Transport::Message>(ServiceModel::QueryResult(std::move(resultsPager.TakePager(activityId))));
+            // The continuation token was correctly set; now we can merge the items that respect it
+            replyMessage = Common::make_unique<Transport::Message>(ServiceModel::QueryResult(std::move(resultsPager.TakeMergedPager(activityId, healthStateMap))));
             return Common::ErrorCode::Success();
         }
 
@@ -186,36 +188,6 @@ namespace Query
         }
 
     protected:
-        virtual Common::ErrorCode MergeEntityInformationQueryResults(
-            __inout std::vector<TEntityResult> & mergedQueryResult,
-            __in ServiceModel::QueryResult & results)
-        {
-            if (mergedQueryResult.size() == 0)
-            {
-                auto error = results.MoveList(mergedQueryResult);
-                if (!error.IsSuccess())
-                {
-                    return error;
-                }
-            }
-            else
-            {
-                std::vector<TEntityResult> entryQueryResult;
-                auto error = results.MoveList(entryQueryResult);
-                if (!error.IsSuccess())
-                {
-                    return error;
-                }
-
-                mergedQueryResult.insert(
-                    mergedQueryResult.end(),
-                    std::make_move_iterator(entryQueryResult.begin()),
-                    std::make_move_iterator(entryQueryResult.end()));
-            }
-
-            return Common::ErrorCode::Success();
-        }
-
         virtual bool IsEntityInformationQuery(Query::QuerySpecificationSPtr const & querySpecification) = 0;
         virtual Common::ErrorCode AddEntityKeyFromHealthResult(__in ServiceModel::QueryResult & healthQueryResult, __inout std::map<TEntityKey, FABRIC_HEALTH_STATE> & healthStateMap) = 0;
         virtual TEntityKey GetEntityKeyFromEntityResult(TEntityResult const & entityInformation) = 0;
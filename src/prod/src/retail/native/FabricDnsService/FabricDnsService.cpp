@@ -266,6 +266,7 @@ void FabricDnsService::LoadConfig(
     params.NumberOfConcurrentQueries = DnsServiceConfig::GetConfig().NumberOfConcurrentQueries;
     params.MaxMessageSizeInKB = DnsServiceConfig::GetConfig().MaxMessageSizeInKB;
     params.MaxCacheSize = DnsServiceConfig::GetConfig().MaxCacheSize;
+    params.IsAnswerCacheEnabled = DnsServiceConfig::GetConfig().IsAnswerCacheEnabled;
     params.IsRecursiveQueryEnabled = DnsServiceConfig::GetConfig().IsRecursiveQueryEnabled;
     params.NDots = (ULONG)DnsServiceConfig::GetConfig().NDots;
     params.SetAsPreferredDns = DnsServiceConfig::GetConfig().SetAsPreferredDns;